@@ -0,0 +1,379 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "moment_accumulator.hpp"
+#include "aoclda.h"
+#include "da_error.hpp"
+#include "macros.h"
+#include "options.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace ARCH {
+
+namespace da_basic_statistics {
+
+using namespace da_model_persistence;
+
+template <typename T>
+moment_accumulator<T>::moment_accumulator(da_errors::da_error_t &err)
+    : basic_handle<T>(err) {
+    register_moment_accumulator_options<T>(this->opts, *this->err);
+}
+
+/*
+ * Combine the statistics of a block of n_b rows with the running state. For each
+ * column the central sums are updated from the highest order down, so that the
+ * lower-order sums of the running state are still unchanged when they are needed.
+ */
+template <typename T>
+void moment_accumulator<T>::merge_sums(da_int n_b, const T *mean_b, const T *msums_b) {
+    da_int ld = max_order - 1;
+
+    if (n_samples == 0) {
+        std::copy(mean_b, mean_b + n_cols, mean.begin());
+        std::copy(msums_b, msums_b + n_cols * ld, msums.begin());
+        return;
+    }
+
+    T n_a = (T)n_samples;
+    T n = n_a + (T)n_b;
+    T r_a = n_a / n;
+    T r_b = (T)n_b / n;
+
+    for (da_int j = 0; j < n_cols; j++) {
+        T delta = mean_b[j] - mean[j];
+        T s_a = -r_b * delta;
+        T s_b = r_a * delta;
+        T *m_a = &msums[j * ld];
+        const T *m_b = &msums_b[j * ld];
+
+        for (da_int p = max_order; p >= 2; p--) {
+            T m_p = m_a[p - 2] + m_b[p - 2];
+            T binom = (T)1;
+            T pow_a = (T)1;
+            T pow_b = (T)1;
+            for (da_int k = 1; k <= p - 2; k++) {
+                binom = binom * (T)(p - k + 1) / (T)k;
+                pow_a *= s_a;
+                pow_b *= s_b;
+                m_p += binom * (pow_a * m_a[p - k - 2] + pow_b * m_b[p - k - 2]);
+            }
+            pow_a *= s_a * s_a;
+            pow_b *= s_b * s_b;
+            m_a[p - 2] = m_p + (T)n_b * pow_b + n_a * pow_a;
+        }
+        mean[j] += r_b * delta;
+    }
+}
+
+template <typename T>
+da_status moment_accumulator<T>::update(da_int n_rows, da_int n_cols, const T *X,
+                                        da_int ldx) {
+    std::string opt_order;
+    da_int iorder;
+    this->opts.get("storage order", opt_order, iorder);
+    this->order = da_order(iorder);
+
+    da_status status = this->check_2D_array(this->order, n_rows, n_cols, X, ldx,
+                                            "n_rows", "n_cols", "X", "ldx");
+    if (status != da_status_success)
+        return status;
+
+    da_int order_opt;
+    this->opts.get("moment order", order_opt);
+    if (n_samples == 0) {
+        max_order = order_opt;
+        this->n_cols = n_cols;
+    } else {
+        if (order_opt != max_order)
+            return da_error(this->err, da_status_incompatible_options,
+                            "The moment order option cannot be changed once data has "
+                            "been added to the accumulator.");
+        if (n_cols != this->n_cols)
+            return da_error(this->err, da_status_invalid_input,
+                            "n_cols = " + std::to_string(n_cols) +
+                                " does not match the number of columns previously "
+                                "added, " +
+                                std::to_string(this->n_cols) + ".");
+    }
+
+    da_int ld = max_order - 1;
+    try {
+        mean.resize(n_cols);
+        msums.resize(n_cols * ld);
+        block_mean.assign(n_cols, (T)0);
+        block_msums.assign(n_cols * ld, (T)0);
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    // Exact two-pass statistics of the new block
+    T inv_rows = (T)1 / (T)n_rows;
+    if (this->order == column_major) {
+#pragma omp parallel for schedule(static) if (n_cols > 1 && n_rows * n_cols > 100000)
+        for (da_int j = 0; j < n_cols; j++) {
+            const T *x = &X[j * ldx];
+            T sum = (T)0;
+            for (da_int i = 0; i < n_rows; i++)
+                sum += x[i];
+            T mu = sum * inv_rows;
+            T acc[max_moment_order] = {};
+            for (da_int i = 0; i < n_rows; i++) {
+                T d = x[i] - mu;
+                T pw = d;
+                for (da_int q = 0; q < ld; q++) {
+                    pw *= d;
+                    acc[q] += pw;
+                }
+            }
+            block_mean[j] = mu;
+            std::copy(acc, acc + ld, &block_msums[j * ld]);
+        }
+    } else {
+        for (da_int i = 0; i < n_rows; i++) {
+#pragma omp simd
+            for (da_int j = 0; j < n_cols; j++)
+                block_mean[j] += X[i * ldx + j];
+        }
+        for (da_int j = 0; j < n_cols; j++)
+            block_mean[j] *= inv_rows;
+        for (da_int i = 0; i < n_rows; i++) {
+            for (da_int j = 0; j < n_cols; j++) {
+                T d = X[i * ldx + j] - block_mean[j];
+                T pw = d;
+                T *acc = &block_msums[j * ld];
+                for (da_int q = 0; q < ld; q++) {
+                    pw *= d;
+                    acc[q] += pw;
+                }
+            }
+        }
+    }
+
+    merge_sums(n_rows, block_mean.data(), block_msums.data());
+    n_samples += n_rows;
+    this->model_trained = true;
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status moment_accumulator<T>::merge(const moment_accumulator<T> &other) {
+    if (other.n_samples == 0)
+        return da_status_success;
+
+    if (n_samples == 0) {
+        // Adopt the layout of the other accumulator, provided the options agree
+        da_int order_opt;
+        this->opts.get("moment order", order_opt);
+        if (order_opt != other.max_order)
+            return da_error(this->err, da_status_incompatible_options,
+                            "Both accumulators must use the same moment order.");
+        max_order = other.max_order;
+        n_cols = other.n_cols;
+        try {
+            mean.resize(n_cols);
+            msums.resize(n_cols * (max_order - 1));
+        } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+    } else {
+        if (other.max_order != max_order)
+            return da_error(this->err, da_status_incompatible_options,
+                            "Both accumulators must use the same moment order.");
+        if (other.n_cols != n_cols)
+            return da_error(this->err, da_status_invalid_input,
+                            "Both accumulators must hold the same number of columns.");
+    }
+
+    merge_sums(other.n_samples, other.mean.data(), other.msums.data());
+    n_samples += other.n_samples;
+    this->model_trained = true;
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status moment_accumulator<T>::get_result(da_result query, da_int *dim, T *result) {
+    if (n_samples == 0)
+        return da_warn(this->err, da_status_no_data,
+                       "No data has been added to the accumulator. Please call "
+                       "da_moments_update_s or da_moments_update_d before extracting "
+                       "results.");
+
+    da_int ld = max_order - 1;
+    da_int required = n_cols;
+    switch (query) {
+    case da_result::da_rinfo:
+        required = 3;
+        break;
+    case da_result::da_moments_central_moments:
+        required = n_cols * max_order;
+        break;
+    case da_result::da_moments_skewness:
+    case da_result::da_moments_kurtosis: {
+        da_int needed = query == da_result::da_moments_skewness ? 3 : 4;
+        if (max_order < needed)
+            return da_warn(this->err, da_status_unknown_query,
+                           "The moment order option must be at least " +
+                               std::to_string(needed) +
+                               " to compute the requested result.");
+        break;
+    }
+    case da_result::da_moments_mean:
+    case da_result::da_moments_variance:
+        break;
+    default:
+        return da_warn(this->err, da_status_unknown_query,
+                       "The requested result could not be found.");
+    }
+
+    if (*dim < required) {
+        *dim = required;
+        return da_warn(this->err, da_status_invalid_array_dimension,
+                       "The array is too small. Please provide an array of at "
+                       "least size: " +
+                           std::to_string(required) + ".");
+    }
+
+    T n = (T)n_samples;
+    T zero = (T)0;
+    T three = (T)3;
+    switch (query) {
+    case da_result::da_rinfo:
+        result[0] = (T)n_samples;
+        result[1] = (T)n_cols;
+        result[2] = (T)max_order;
+        break;
+    case da_result::da_moments_mean:
+        std::copy(mean.begin(), mean.end(), result);
+        break;
+    case da_result::da_moments_variance: {
+        std::string opt_dof;
+        da_int dof;
+        this->opts.get("degrees of freedom", opt_dof, dof);
+        da_int scale_factor = dof < 0 ? n_samples : n_samples - 1;
+        for (da_int j = 0; j < n_cols; j++) {
+            result[j] = msums[j * ld];
+            if (scale_factor > 1)
+                result[j] /= (T)scale_factor;
+        }
+        break;
+    }
+    case da_result::da_moments_skewness:
+        for (da_int j = 0; j < n_cols; j++) {
+            T m2 = msums[j * ld];
+            result[j] = (m2 == zero)
+                            ? zero
+                            : msums[j * ld + 1] * std::sqrt(n) / std::pow(m2, (T)1.5);
+        }
+        break;
+    case da_result::da_moments_kurtosis:
+        for (da_int j = 0; j < n_cols; j++) {
+            T m2 = msums[j * ld];
+            result[j] = (m2 == zero) ? -three : msums[j * ld + 2] * n / (m2 * m2) - three;
+        }
+        break;
+    case da_result::da_moments_central_moments: {
+        // Column k - 1 holds the central moments of order k, the first one being zero
+        std::vector<T> moments;
+        try {
+            moments.resize(n_cols * max_order, zero);
+        } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+        for (da_int k = 1; k < max_order; k++)
+            for (da_int j = 0; j < n_cols; j++)
+                moments[k * n_cols + j] = msums[j * ld + k - 1] / n;
+        this->copy_2D_results_array(n_cols, max_order, moments.data(), n_cols, result);
+        break;
+    }
+    default:
+        break; // LCOV_EXCL_LINE
+    }
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status moment_accumulator<T>::get_result(da_result query, da_int *dim,
+                                            da_int *result) {
+    return this->get_result_common(query, dim, result);
+}
+
+template <typename T>
+da_status moment_accumulator<T>::serialize(serialization_buffer &buffer) {
+
+    da_status status = da_status_success;
+    auto io_dispatch = [&buffer, &status](auto &data) -> void {
+        if (status != da_status_success) {
+            return;
+        }
+        status = buffer.dispatch_buffer_io(data);
+        return;
+    };
+
+    io_dispatch(this->model_trained);
+    io_dispatch(this->order);
+    io_dispatch(this->n_samples);
+    io_dispatch(this->n_cols);
+    io_dispatch(this->max_order);
+    io_dispatch(this->mean);
+    io_dispatch(this->msums);
+
+    return status;
+}
+
+template <typename T>
+da_status moment_accumulator<T>::save_model(serialization_buffer &buffer) {
+    da_status status = basic_handle<T>::save_model(buffer);
+    if (status != da_status_success)
+        return da_error_trace(this->err, status, "Failure serializing model.");
+
+    return status;
+}
+
+template <typename T>
+da_status moment_accumulator<T>::load_model(serialization_buffer &buffer) {
+    da_status status = basic_handle<T>::load_model(buffer);
+    if (status != da_status_success)
+        return da_error_trace(this->err, status, "Failure deserializing model.");
+
+    return status;
+}
+
+template class moment_accumulator<double>;
+template class moment_accumulator<float>;
+
+} // namespace da_basic_statistics
+
+} // namespace ARCH
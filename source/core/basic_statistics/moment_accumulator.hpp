@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef MOMENT_ACCUMULATOR_HPP
+#define MOMENT_ACCUMULATOR_HPP
+
+#include "aoclda.h"
+#include "basic_handle.hpp"
+#include "da_error.hpp"
+#include "macros.h"
+#include "moment_accumulator_options.hpp"
+#include <vector>
+
+namespace ARCH {
+
+namespace da_basic_statistics {
+
+/*
+ * One-pass accumulator for the column-wise mean and central moments of a data matrix
+ * that is supplied as a sequence of row blocks. Each block is reduced with an exact
+ * two-pass sweep and then combined with the running state using the pairwise update
+ * formulae of Chan et al. (generalised to arbitrary order by Pebay), so the result
+ * does not depend on how the rows were split and two accumulators can be merged.
+ */
+template <typename T> class moment_accumulator : public basic_handle<T> {
+  private:
+    // Number of observations seen so far, number of variables and highest moment order
+    da_int n_samples = 0;
+    da_int n_cols = 0;
+    da_int max_order = 0;
+
+    // Running means, size n_cols
+    std::vector<T> mean;
+    // Running sums of powers of deviations from the mean, M_2, ..., M_{max_order}.
+    // Stored contiguously for each column with leading dimension max_order - 1
+    std::vector<T> msums;
+
+    // Statistics of the block currently being added
+    std::vector<T> block_mean, block_msums;
+
+    void merge_sums(da_int n_b, const T *mean_b, const T *msums_b);
+
+  public:
+    moment_accumulator(da_errors::da_error_t &err);
+
+    da_status update(da_int n_rows, da_int n_cols, const T *X, da_int ldx);
+    da_status merge(const moment_accumulator<T> &other);
+
+    da_status get_result(da_result query, da_int *dim, T *result);
+    da_status get_result(da_result query, da_int *dim, da_int *result);
+
+    da_status serialize(da_model_persistence::serialization_buffer &buffer);
+    da_status save_model(da_model_persistence::serialization_buffer &buffer);
+    da_status load_model(da_model_persistence::serialization_buffer &buffer);
+};
+
+} // namespace da_basic_statistics
+
+} // namespace ARCH
+
+#endif // MOMENT_ACCUMULATOR_HPP
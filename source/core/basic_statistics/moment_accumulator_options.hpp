@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef MOMENT_ACCUMULATOR_OPTIONS_HPP
+#define MOMENT_ACCUMULATOR_OPTIONS_HPP
+
+#include "aoclda_types.h"
+#include "da_error.hpp"
+#include "macros.h"
+#include "options.hpp"
+
+namespace ARCH {
+
+namespace da_basic_statistics {
+
+// Highest central moment that can be accumulated
+constexpr da_int max_moment_order = 16;
+
+template <class T>
+inline da_status register_moment_accumulator_options(da_options::OptionRegistry &opts,
+                                                     da_errors::da_error_t &err) {
+    using namespace da_options;
+
+    try {
+        std::shared_ptr<OptionString> os;
+        os = std::make_shared<OptionString>(
+            OptionString("degrees of freedom",
+                         "Whether to use biased or unbiased estimators for the "
+                         "variance.",
+                         {{"biased", -1}, {"unbiased", 0}}, "unbiased"));
+        opts.register_opt(os);
+
+        std::shared_ptr<OptionNumeric<da_int>> oi;
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "moment order",
+            "Highest order of central moment to accumulate. Cannot be changed once "
+            "data has been added.",
+            2, da_options::lbound_t::greaterequal, max_moment_order,
+            da_options::ubound_t::lessequal, 4));
+        opts.register_opt(oi);
+
+    } catch (std::bad_alloc &) {
+        return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    } catch (...) { // LCOV_EXCL_LINE
+        // Invalid use of the constructor, shouldn't happen (invalid_argument)
+        return da_error(&err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "Unexpected error while registering options");
+    }
+
+    return da_status_success;
+}
+
+} // namespace da_basic_statistics
+} // namespace ARCH
+
+#endif // MOMENT_ACCUMULATOR_OPTIONS_HPP
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "aoclda.h"
+#include "da_handle.hpp"
+#include "dynamic_dispatch.hpp"
+#include "macros.h"
+#include "moment_accumulator.hpp"
+
+#ifndef MOMENT_ACCUMULATOR_PUBLIC_HPP
+#define MOMENT_ACCUMULATOR_PUBLIC_HPP
+
+namespace moment_accumulator_public {
+template <typename acc_class, typename T>
+da_status moments_update(da_handle handle, da_int n_rows, da_int n_cols, const T *X,
+                         da_int ldx) {
+    acc_class *acc = dynamic_cast<acc_class *>(handle->get_alg_handle<T>());
+    if (acc == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_moments "
+                        "or handle is invalid.");
+
+    return acc->update(n_rows, n_cols, X, ldx);
+}
+
+template <typename acc_class, typename T>
+da_status moments_merge(da_handle handle, da_handle handle_other) {
+    acc_class *acc = dynamic_cast<acc_class *>(handle->get_alg_handle<T>());
+    acc_class *acc_other = dynamic_cast<acc_class *>(handle_other->get_alg_handle<T>());
+    if (acc == nullptr || acc_other == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handles were not initialized with handle_type=da_handle_moments "
+                        "or are invalid.");
+
+    return acc->merge(*acc_other);
+}
+
+} // namespace moment_accumulator_public
+
+#endif // MOMENT_ACCUMULATOR_PUBLIC_HPP
@@ -159,6 +159,77 @@ inline da_status get_quantile_indices(const T *q, da_int n_q, da_int length,
     return da_status_success;
 }
 
+// Minimum amount of data before the statistics are computed in parallel
+constexpr da_int quantile_parallel_threshold = 10000;
+
+/* Compute the n_q quantiles of work[0:length), which is partially sorted in place. The
+   quantile of (unsorted) index j is stored in quantiles[offset + j * q_stride] */
+template <typename T>
+da_status select_quantiles(T *work, da_int length, da_int n_q,
+                           const std::vector<double> &h,
+                           const std::vector<da_int> &sorted_h_idx,
+                           da_quantile_type quantile_type, T *quantiles, da_int offset,
+                           da_int q_stride) {
+    da_int last_ceil = 0;
+    da_int last_floor = 0;
+    da_int h1, h2;
+    da_int izero = 0;
+    T tmp1 = 0;
+    T tmp2 = 0;
+
+    for (da_int j = 0; j < n_q; ++j) {
+
+        da_int orig_h_idx = sorted_h_idx[j];
+
+        switch (quantile_type) {
+        case da_quantile_type_1: {
+            h1 = std::clamp((da_int)std::ceil(h[orig_h_idx]), izero, length - 1);
+            h2 = h1;
+            break;
+        }
+        case da_quantile_type_2: {
+            h1 = std::clamp((da_int)std::ceil(h[orig_h_idx] - 0.5), izero, length - 1);
+            h2 = std::clamp((da_int)std::floor(h[orig_h_idx] + 0.5), izero, length - 1);
+            break;
+        }
+        case da_quantile_type_3: {
+            h1 = std::clamp((da_int)std::nearbyint(h[orig_h_idx]), izero, length - 1);
+            h2 = h1;
+            break;
+        }
+        default: {
+            h1 = std::clamp((da_int)std::floor(h[orig_h_idx]), izero, length - 1);
+            h2 = std::clamp((da_int)std::ceil(h[orig_h_idx]), izero, length - 1);
+            break;
+        }
+        }
+
+        // j == 0 make sure it runs on the first iterration when h1 and h2 are both 0.
+        if (j == 0 || h1 != last_floor || h2 != last_ceil) {
+            da_status status =
+                quick_selection(work + last_ceil, length - last_ceil, h1 - last_ceil,
+                                h2 - last_ceil, tmp1, tmp2);
+            if (status != da_status_success)
+                return status;
+        }
+
+        da_int idx = offset + orig_h_idx * q_stride;
+        if (h1 == h2) {
+            quantiles[idx] = tmp1;
+        } else if (quantile_type == da_quantile_type_2) {
+            quantiles[idx] = (T)0.5 * (tmp1 + tmp2);
+        } else if (quantile_type != da_quantile_type_1 &&
+                   quantile_type != da_quantile_type_3) {
+            quantiles[idx] = tmp1 + (h[orig_h_idx] - h1) * (tmp2 - tmp1);
+        }
+
+        last_floor = h1;
+        last_ceil = h2;
+    }
+
+    return da_status_success;
+}
+
 /* Compute the qth quantile of x along the specified axis */
 template <typename T>
 da_status quantile(da_order order, da_axis axis, da_int n, da_int p, const T *x,
@@ -228,105 +299,64 @@ da_status quantile(da_order order, da_axis axis, da_int n, da_int p, const T *x,
         return da_status_success;
     }
 
-    // Create a copy of x (either partial (for axes col and row) or full (for axis all))
-    // to work on in the selection step
-    std::vector<T> copy_x;
-    try {
-        da_int copy_size = axis == da_axis_all ? (n * p) : length;
-        copy_x.resize(copy_size);
-    } catch (std::bad_alloc const &) {
-        return da_status_memory_error; // LCOV_EXCL_LINE
-    }
-
-    da_int ldx_internal = ldx;
+    // Quantile j of statistic i is stored at quantiles[offset(i) + j * q_stride]
+    da_int q_stride = order == row_major ? num_stats : 1;
 
     if (axis == da_axis_all) {
+        // Create a full copy of x to work on in the selection step
+        std::vector<T> copy_x;
+        try {
+            copy_x.resize(n * p);
+        } catch (std::bad_alloc const &) {
+            return da_status_memory_error; // LCOV_EXCL_LINE
+        }
         da_int dim1 = order == column_major ? n : p;
         da_int dim2 = order == column_major ? p : n;
         for (da_int i = 0; i < dim2; ++i) {
             std::copy(x + i * ldx, x + i * ldx + dim1, copy_x.begin() + i * dim1);
         }
-        // Since copying only usable data, equal ldx to the proper dimension.
-        ldx_internal = order == column_major ? n : p;
+        return select_quantiles(copy_x.data(), length, n_q, h, sorted_h_idx,
+                                quantile_type, quantiles, 0, q_stride);
     }
 
-    // Initial pointer to copy_x
-    T *work = copy_x.data();
-    da_int izero = 0;
-
-    for (da_int i = 0; i < num_stats; ++i) {
-        da_int last_ceil = 0;
-        da_int last_floor = 0;
-        da_int h1, h2;
-        T tmp1 = 0;
-        T tmp2 = 0;
+    // Statistics are independent, so spread them over the threads, each of which works
+    // on its own partial copy of x
+    bool use_parallel = num_stats > 1 && num_stats * length > quantile_parallel_threshold;
+#pragma omp parallel default(none) if (use_parallel)                                     \
+    shared(x, ldx, length, num_stats, transpose_x, n_q, h, sorted_h_idx, quantile_type,  \
+               quantiles, q_stride, order, status)
+    {
+        std::vector<T> work;
+        da_status local_status = da_status_success;
+        try {
+            work.resize(length);
+        } catch (std::bad_alloc const &) {
+            local_status = da_status_memory_error; // LCOV_EXCL_LINE
+        }
 
-        if (axis == da_axis_all) {
-            work = copy_x.data() + i * ldx_internal;
-        } else {
+#pragma omp for schedule(dynamic)
+        for (da_int i = 0; i < num_stats; ++i) {
+            if (local_status != da_status_success)
+                continue;
             if (!transpose_x) {
-                std::copy(x + i * ldx_internal, x + i * ldx_internal + length, work);
+                std::copy(x + i * ldx, x + i * ldx + length, work.data());
             } else {
                 for (da_int j = 0; j < length; ++j) {
-                    work[j] = x[i + j * ldx_internal];
+                    work[j] = x[i + j * ldx];
                 }
             }
+            da_int offset = order == row_major ? i : i * n_q;
+            local_status = select_quantiles(work.data(), length, n_q, h, sorted_h_idx,
+                                            quantile_type, quantiles, offset, q_stride);
         }
 
-        for (da_int j = 0; j < n_q; ++j) {
-
-            da_int orig_h_idx = sorted_h_idx[j];
-
-            switch (quantile_type) {
-            case da_quantile_type_1: {
-                h1 = std::clamp((da_int)std::ceil(h[orig_h_idx]), izero, length - 1);
-                h2 = h1;
-                break;
-            }
-            case da_quantile_type_2: {
-                h1 =
-                    std::clamp((da_int)std::ceil(h[orig_h_idx] - 0.5), izero, length - 1);
-                h2 = std::clamp((da_int)std::floor(h[orig_h_idx] + 0.5), izero,
-                                length - 1);
-                break;
-            }
-            case da_quantile_type_3: {
-                h1 = std::clamp((da_int)std::nearbyint(h[orig_h_idx]), izero, length - 1);
-                h2 = h1;
-                break;
-            }
-            default: {
-                h1 = std::clamp((da_int)std::floor(h[orig_h_idx]), izero, length - 1);
-                h2 = std::clamp((da_int)std::ceil(h[orig_h_idx]), izero, length - 1);
-                break;
-            }
-            }
-
-            // j == 0 make sure it runs on the first iterration when h1 and h2 are both 0.
-            if (j == 0 || h1 != last_floor || h2 != last_ceil) {
-                status = quick_selection(work + last_ceil, length - last_ceil,
-                                         h1 - last_ceil, h2 - last_ceil, tmp1, tmp2);
-                if (status != da_status_success)
-                    return status;
-            }
-
-            da_int idx =
-                order == row_major ? orig_h_idx * num_stats + i : i * n_q + orig_h_idx;
-            if (h1 == h2) {
-                quantiles[idx] = tmp1;
-            } else if (quantile_type == da_quantile_type_2) {
-                quantiles[idx] = (T)0.5 * (tmp1 + tmp2);
-            } else if (quantile_type != da_quantile_type_1 &&
-                       quantile_type != da_quantile_type_3) {
-                quantiles[idx] = tmp1 + (h[orig_h_idx] - h1) * (tmp2 - tmp1);
-            }
-
-            last_floor = h1;
-            last_ceil = h2;
+        if (local_status != da_status_success) {
+#pragma omp critical
+            status = local_status;
         }
     }
 
-    return da_status_success;
+    return status;
 }
 
 /* Compute min/max, hinges and median along specified axis */
@@ -0,0 +1,497 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "quantile_sketch.hpp"
+#include "aoclda.h"
+#include "da_error.hpp"
+#include "macros.h"
+#include "options.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace ARCH {
+
+namespace da_basic_statistics {
+
+using namespace da_model_persistence;
+
+// Minimum amount of data before the columns are processed in parallel
+constexpr da_int sketch_parallel_threshold = 10000;
+
+template <typename T>
+quantile_sketch<T>::quantile_sketch(da_errors::da_error_t &err) : basic_handle<T>(err) {
+    register_quantile_sketch_options<T>(this->opts, *this->err);
+}
+
+/* Capacity of a compactor level: the top level holds k items and the capacities decay
+   geometrically towards the bottom of the hierarchy */
+template <typename T>
+da_int quantile_sketch<T>::level_capacity(da_int level, da_int n_levels) {
+    double scale = std::pow(2.0 / 3.0, (double)(n_levels - 1 - level));
+    return std::max((da_int)2, (da_int)std::ceil((double)k * scale));
+}
+
+/* Draw the offset (0 or 1) of the next compaction of a column. A counter-based
+   generator is used so that the state of the sketch can be serialized */
+template <typename T>
+bool quantile_sketch<T>::random_offset(kll_column<T> &col, da_int icol) {
+    uint64_t z = (uint64_t)seed * 0x9E3779B97F4A7C15ULL +
+                 (uint64_t)icol * 0xD1B54A32D192ED03ULL + (uint64_t)col.n_compactions++;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return (z & 1) != 0;
+}
+
+/* Compact the lowest full levels until the sketch fits within its capacity. Compacting
+   a level sorts it and promotes every other item (starting from a random offset) to
+   the next level, so that the total weight is preserved */
+template <typename T>
+void quantile_sketch<T>::compress(kll_column<T> &col, da_int icol) {
+    while (true) {
+        da_int n_levels = (da_int)col.levels.size();
+        da_int size = 0, capacity = 0;
+        for (da_int h = 0; h < n_levels; h++) {
+            size += (da_int)col.levels[h].size();
+            capacity += level_capacity(h, n_levels);
+        }
+        if (size <= capacity)
+            break;
+
+        da_int h = 0;
+        while ((da_int)col.levels[h].size() < level_capacity(h, n_levels))
+            h++;
+        if (h + 1 == n_levels)
+            col.levels.emplace_back();
+
+        std::vector<T> &src = col.levels[h];
+        std::vector<T> &dst = col.levels[h + 1];
+        std::sort(src.begin(), src.end());
+        da_int n_src = (da_int)src.size();
+        da_int n_even = n_src - n_src % 2;
+        for (da_int i = random_offset(col, icol) ? 1 : 0; i < n_even; i += 2)
+            dst.push_back(src[i]);
+        // An odd item out stays on this level
+        src.erase(src.begin(), src.begin() + n_even);
+    }
+}
+
+template <typename T> da_status quantile_sketch<T>::check_layout(da_int n_cols) {
+    da_int k_opt, seed_opt;
+    this->opts.get("sketch size", k_opt);
+    this->opts.get("seed", seed_opt);
+
+    if (n_samples == 0) {
+        k = k_opt;
+        if (seed_opt == -1) {
+            std::random_device r;
+            seed_opt = std::abs((da_int)r());
+        }
+        seed = seed_opt;
+        this->n_cols = n_cols;
+        try {
+            columns.assign(n_cols, kll_column<T>());
+        } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+        return da_status_success;
+    }
+
+    if (k_opt != k)
+        return da_error(this->err, da_status_incompatible_options,
+                        "The sketch size option cannot be changed once data has been "
+                        "added to the sketch.");
+    if (n_cols != this->n_cols)
+        return da_error(this->err, da_status_invalid_input,
+                        "n_cols = " + std::to_string(n_cols) +
+                            " does not match the number of columns previously added, " +
+                            std::to_string(this->n_cols) + ".");
+    return da_status_success;
+}
+
+template <typename T>
+da_status quantile_sketch<T>::update(da_int n_rows, da_int n_cols, const T *X,
+                                     da_int ldx) {
+    std::string opt_order;
+    da_int iorder;
+    this->opts.get("storage order", opt_order, iorder);
+    this->order = da_order(iorder);
+
+    da_status status = this->check_2D_array(this->order, n_rows, n_cols, X, ldx,
+                                            "n_rows", "n_cols", "X", "ldx");
+    if (status != da_status_success)
+        return status;
+
+    status = check_layout(n_cols);
+    if (status != da_status_success)
+        return status;
+
+    da_int row_stride = this->order == column_major ? 1 : ldx;
+    da_int col_stride = this->order == column_major ? ldx : 1;
+    bool first_block = n_samples == 0;
+    bool alloc_failed = false;
+
+#pragma omp parallel for schedule(dynamic)                                               \
+    if (n_cols > 1 && n_rows * n_cols > sketch_parallel_threshold)
+    for (da_int j = 0; j < n_cols; j++) {
+        kll_column<T> &col = columns[j];
+        const T *x = &X[j * col_stride];
+        try {
+            if (col.levels.empty())
+                col.levels.emplace_back();
+            if (first_block) {
+                col.min_val = x[0];
+                col.max_val = x[0];
+            }
+            // Add the rows in chunks so that the memory used stays bounded by O(k)
+            for (da_int r = 0; r < n_rows; r += k) {
+                da_int nb = std::min(k, n_rows - r);
+                std::vector<T> &level0 = col.levels[0];
+                for (da_int i = r; i < r + nb; i++) {
+                    T xi = x[i * row_stride];
+                    col.min_val = std::min(col.min_val, xi);
+                    col.max_val = std::max(col.max_val, xi);
+                    level0.push_back(xi);
+                }
+                compress(col, j);
+            }
+        } catch (std::bad_alloc &) { // LCOV_EXCL_LINE
+#pragma omp atomic write
+            alloc_failed = true; // LCOV_EXCL_LINE
+        }
+    }
+    if (alloc_failed)
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+
+    n_samples += n_rows;
+    this->model_trained = true;
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status quantile_sketch<T>::merge(const quantile_sketch<T> &other) {
+    if (other.n_samples == 0)
+        return da_status_success;
+
+    if (n_samples == 0) {
+        da_int k_opt;
+        this->opts.get("sketch size", k_opt);
+        if (k_opt != other.k)
+            return da_error(this->err, da_status_incompatible_options,
+                            "Both sketches must use the same sketch size.");
+        k = other.k;
+        seed = other.seed;
+        n_cols = other.n_cols;
+        try {
+            columns = other.columns;
+        } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+        n_samples = other.n_samples;
+        this->model_trained = true;
+        return da_status_success;
+    }
+
+    if (other.k != k)
+        return da_error(this->err, da_status_incompatible_options,
+                        "Both sketches must use the same sketch size.");
+    if (other.n_cols != n_cols)
+        return da_error(this->err, da_status_invalid_input,
+                        "Both sketches must hold the same number of columns.");
+
+    bool alloc_failed = false;
+#pragma omp parallel for schedule(dynamic)                                               \
+    if (n_cols > 1 && n_samples + other.n_samples > sketch_parallel_threshold)
+    for (da_int j = 0; j < n_cols; j++) {
+        kll_column<T> &col = columns[j];
+        const kll_column<T> &col_other = other.columns[j];
+        try {
+            if (col.levels.size() < col_other.levels.size())
+                col.levels.resize(col_other.levels.size());
+            for (size_t h = 0; h < col_other.levels.size(); h++)
+                col.levels[h].insert(col.levels[h].end(), col_other.levels[h].begin(),
+                                     col_other.levels[h].end());
+            col.min_val = std::min(col.min_val, col_other.min_val);
+            col.max_val = std::max(col.max_val, col_other.max_val);
+            compress(col, j);
+        } catch (std::bad_alloc &) { // LCOV_EXCL_LINE
+#pragma omp atomic write
+            alloc_failed = true; // LCOV_EXCL_LINE
+        }
+    }
+    if (alloc_failed)
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+
+    n_samples += other.n_samples;
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status quantile_sketch<T>::query(da_int n_q, const T *q, T *quantiles) {
+    if (n_samples == 0)
+        return da_error(this->err, da_status_no_data,
+                        "No data has been added to the sketch. Please call "
+                        "da_quantile_sketch_update_s or da_quantile_sketch_update_d "
+                        "first.");
+    if (q == nullptr || quantiles == nullptr)
+        return da_error(this->err, da_status_invalid_pointer,
+                        "The arrays q and quantiles must not be null.");
+    if (n_q < 1)
+        return da_error(this->err, da_status_invalid_input,
+                        "n_q = " + std::to_string(n_q) + ", it must be at least 1.");
+    for (da_int i = 0; i < n_q; i++) {
+        if (!(q[i] >= (T)0 && q[i] <= (T)1))
+            return da_error(this->err, da_status_invalid_input,
+                            "q[" + std::to_string(i) +
+                                "] must lie in the interval [0, 1].");
+    }
+
+    // The quantiles are returned in the same layout as da_quantile with axis = da_axis_col
+    std::string opt_order;
+    da_int iorder;
+    this->opts.get("storage order", opt_order, iorder);
+    this->order = da_order(iorder);
+    da_int q_stride = this->order == column_major ? 1 : n_cols;
+    da_int c_stride = this->order == column_major ? n_q : 1;
+    bool alloc_failed = false;
+
+#pragma omp parallel if (n_cols > 1 && n_cols * k > sketch_parallel_threshold)
+    {
+        std::vector<std::pair<T, int64_t>> items;
+        std::vector<int64_t> cum_weight;
+
+#pragma omp for schedule(dynamic)
+        for (da_int j = 0; j < n_cols; j++) {
+            const kll_column<T> &col = columns[j];
+            try {
+                items.clear();
+                for (size_t h = 0; h < col.levels.size(); h++)
+                    for (T v : col.levels[h])
+                        items.emplace_back(v, (int64_t)1 << h);
+                cum_weight.resize(items.size());
+            } catch (std::bad_alloc &) { // LCOV_EXCL_LINE
+#pragma omp atomic write
+                alloc_failed = true; // LCOV_EXCL_LINE
+                continue;            // LCOV_EXCL_LINE
+            }
+            std::sort(items.begin(), items.end(),
+                      [](const std::pair<T, int64_t> &a, const std::pair<T, int64_t> &b) {
+                          return a.first < b.first;
+                      });
+            int64_t total = 0;
+            for (size_t i = 0; i < items.size(); i++) {
+                total += items[i].second;
+                cum_weight[i] = total;
+            }
+
+            for (da_int iq = 0; iq < n_q; iq++) {
+                T val;
+                if (q[iq] == (T)0) {
+                    val = col.min_val;
+                } else if (q[iq] == (T)1) {
+                    val = col.max_val;
+                } else {
+                    // Smallest retained item whose estimated rank reaches q * n
+                    int64_t target = (int64_t)std::ceil((double)q[iq] * (double)total);
+                    size_t pos = std::lower_bound(cum_weight.begin(), cum_weight.end(),
+                                                  target) -
+                                 cum_weight.begin();
+                    val = items[std::min(pos, items.size() - 1)].first;
+                }
+                quantiles[j * c_stride + iq * q_stride] = val;
+            }
+        }
+    }
+    if (alloc_failed)
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status quantile_sketch<T>::get_result(da_result query, da_int *dim, T *result) {
+    if (n_samples == 0)
+        return da_warn(this->err, da_status_no_data,
+                       "No data has been added to the sketch. Please call "
+                       "da_quantile_sketch_update_s or da_quantile_sketch_update_d "
+                       "before extracting results.");
+
+    da_int rinfo_size = 5;
+    switch (query) {
+    case da_result::da_rinfo: {
+        if (*dim < rinfo_size) {
+            *dim = rinfo_size;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The array is too small. Please provide an array of at "
+                           "least size: " +
+                               std::to_string(rinfo_size) + ".");
+        }
+        size_t retained = 0;
+        for (const kll_column<T> &col : columns) {
+            size_t size = 0;
+            for (const std::vector<T> &level : col.levels)
+                size += level.size();
+            retained = std::max(retained, size);
+        }
+        result[0] = (T)n_samples;
+        result[1] = (T)n_cols;
+        result[2] = (T)k;
+        result[3] = (T)retained;
+        // Empirical normalized rank error of KLL sketches at 99% confidence
+        result[4] = (T)(2.296 / std::pow((double)k, 0.9723));
+        break;
+    }
+    default:
+        return da_warn(this->err, da_status_unknown_query,
+                       "The requested result could not be found.");
+    }
+    return da_status_success;
+}
+
+template <typename T>
+da_status quantile_sketch<T>::get_result(da_result query, da_int *dim, da_int *result) {
+    return this->get_result_common(query, dim, result);
+}
+
+template <typename T>
+da_status quantile_sketch<T>::serialize(serialization_buffer &buffer) {
+
+    da_status status = da_status_success;
+    auto io_dispatch = [&buffer, &status](auto &data) -> void {
+        if (status != da_status_success) {
+            return;
+        }
+        status = buffer.dispatch_buffer_io(data);
+        return;
+    };
+
+    // The columns are stored as flat arrays: for each column the number of levels
+    // followed by the size of each level, and all the retained items
+    std::vector<da_int> layout, n_compactions;
+    std::vector<T> items, min_vals, max_vals;
+    bool loading = buffer.get_mode() == buffer_mode::deserialize;
+    try {
+        if (!loading) {
+            for (const kll_column<T> &col : columns) {
+                layout.push_back((da_int)col.levels.size());
+                for (const std::vector<T> &level : col.levels) {
+                    layout.push_back((da_int)level.size());
+                    items.insert(items.end(), level.begin(), level.end());
+                }
+                min_vals.push_back(col.min_val);
+                max_vals.push_back(col.max_val);
+                n_compactions.push_back(col.n_compactions);
+            }
+        }
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    io_dispatch(this->model_trained);
+    io_dispatch(this->order);
+    io_dispatch(this->n_samples);
+    io_dispatch(this->n_cols);
+    io_dispatch(this->k);
+    io_dispatch(this->seed);
+    io_dispatch(layout);
+    io_dispatch(items);
+    io_dispatch(min_vals);
+    io_dispatch(max_vals);
+    io_dispatch(n_compactions);
+
+    if (status != da_status_success || !loading)
+        return status;
+
+    if ((da_int)min_vals.size() != n_cols || (da_int)max_vals.size() != n_cols ||
+        (da_int)n_compactions.size() != n_cols)
+        return da_status_invalid_file_data;
+    try {
+        columns.assign(n_cols, kll_column<T>());
+        size_t pos = 0, item_pos = 0;
+        for (da_int j = 0; j < n_cols; j++) {
+            if (pos >= layout.size())
+                return da_status_invalid_file_data;
+            da_int n_levels = layout[pos++];
+            if (n_levels < 0 || pos + n_levels > layout.size())
+                return da_status_invalid_file_data;
+            columns[j].levels.resize(n_levels);
+            for (da_int h = 0; h < n_levels; h++) {
+                da_int size = layout[pos++];
+                if (size < 0 || item_pos + size > items.size())
+                    return da_status_invalid_file_data;
+                columns[j].levels[h].assign(items.begin() + item_pos,
+                                            items.begin() + item_pos + size);
+                item_pos += size;
+            }
+            columns[j].min_val = min_vals[j];
+            columns[j].max_val = max_vals[j];
+            columns[j].n_compactions = n_compactions[j];
+        }
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    return status;
+}
+
+template <typename T>
+da_status quantile_sketch<T>::save_model(serialization_buffer &buffer) {
+    da_status status = basic_handle<T>::save_model(buffer);
+    if (status != da_status_success)
+        return da_error_trace(this->err, status, "Failure serializing model.");
+
+    return status;
+}
+
+template <typename T>
+da_status quantile_sketch<T>::load_model(serialization_buffer &buffer) {
+    da_status status = basic_handle<T>::load_model(buffer);
+    if (status != da_status_success)
+        return da_error_trace(this->err, status, "Failure deserializing model.");
+
+    return status;
+}
+
+template class quantile_sketch<double>;
+template class quantile_sketch<float>;
+
+} // namespace da_basic_statistics
+
+} // namespace ARCH
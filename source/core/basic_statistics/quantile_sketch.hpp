@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef QUANTILE_SKETCH_HPP
+#define QUANTILE_SKETCH_HPP
+
+#include "aoclda.h"
+#include "basic_handle.hpp"
+#include "da_error.hpp"
+#include "macros.h"
+#include "quantile_sketch_options.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace ARCH {
+
+namespace da_basic_statistics {
+
+// KLL sketch of a single column: a hierarchy of compactors where the items held in level
+// h each stand for 2^h items of the original stream
+template <typename T> struct kll_column {
+    std::vector<std::vector<T>> levels;
+    T min_val = 0;
+    T max_val = 0;
+    // Number of compactions performed, used to draw the random offsets reproducibly
+    da_int n_compactions = 0;
+};
+
+/*
+ * Mergeable column-wise quantile sketch with bounded memory (Karnin, Lang and Liberty,
+ * 2016). Each column keeps O(k) items, where k is the "sketch size" option, and the
+ * rank of any returned quantile differs from the requested one by a small multiple of
+ * n / k with high probability. Columns are processed independently and in parallel.
+ */
+template <typename T> class quantile_sketch : public basic_handle<T> {
+  private:
+    // 64-bit so that the total weight of a long stream does not overflow with LP64
+    int64_t n_samples = 0;
+    da_int n_cols = 0;
+    da_int k = 0;
+    da_int seed = 0;
+    std::vector<kll_column<T>> columns;
+
+    da_int level_capacity(da_int level, da_int n_levels);
+    bool random_offset(kll_column<T> &col, da_int icol);
+    void compress(kll_column<T> &col, da_int icol);
+    da_status check_layout(da_int n_cols);
+
+  public:
+    quantile_sketch(da_errors::da_error_t &err);
+
+    da_status update(da_int n_rows, da_int n_cols, const T *X, da_int ldx);
+    da_status merge(const quantile_sketch<T> &other);
+    da_status query(da_int n_q, const T *q, T *quantiles);
+
+    da_status get_result(da_result query, da_int *dim, T *result);
+    da_status get_result(da_result query, da_int *dim, da_int *result);
+
+    da_status serialize(da_model_persistence::serialization_buffer &buffer);
+    da_status save_model(da_model_persistence::serialization_buffer &buffer);
+    da_status load_model(da_model_persistence::serialization_buffer &buffer);
+};
+
+} // namespace da_basic_statistics
+
+} // namespace ARCH
+
+#endif // QUANTILE_SKETCH_HPP
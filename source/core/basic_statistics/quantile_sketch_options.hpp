@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef QUANTILE_SKETCH_OPTIONS_HPP
+#define QUANTILE_SKETCH_OPTIONS_HPP
+
+#include "aoclda_types.h"
+#include "da_error.hpp"
+#include "macros.h"
+#include "options.hpp"
+#include <limits>
+
+namespace ARCH {
+
+namespace da_basic_statistics {
+
+template <class T>
+inline da_status register_quantile_sketch_options(da_options::OptionRegistry &opts,
+                                                  da_errors::da_error_t &err) {
+    using namespace da_options;
+    da_int imax = std::numeric_limits<da_int>::max();
+
+    try {
+        std::shared_ptr<OptionNumeric<da_int>> oi;
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "sketch size",
+            "Accuracy parameter of the sketch. Larger values reduce the rank error at "
+            "the cost of memory. Cannot be changed once data has been added.",
+            8, da_options::lbound_t::greaterequal, 65536, da_options::ubound_t::lessequal,
+            200));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "seed",
+            "Seed for random number generation; set to -1 for non-deterministic "
+            "results. Cannot be changed once data has been added.",
+            -1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            0));
+        opts.register_opt(oi);
+
+    } catch (std::bad_alloc &) {
+        return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    } catch (...) { // LCOV_EXCL_LINE
+        // Invalid use of the constructor, shouldn't happen (invalid_argument)
+        return da_error(&err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "Unexpected error while registering options");
+    }
+
+    return da_status_success;
+}
+
+} // namespace da_basic_statistics
+} // namespace ARCH
+
+#endif // QUANTILE_SKETCH_OPTIONS_HPP
@@ -264,6 +264,9 @@ da_status kmeans<T>::set_data(da_int n_samples, da_int n_features, const T *A_in
     if (status != da_status_success)
         return status;
 
+    // Sample weights refer to the previous data set
+    sample_weights.clear();
+
     // Store dimensions of A and pointer to user's data
     this->lda_usr = lda_in;
     this->A_usr = A_in;
@@ -347,6 +350,50 @@ da_status kmeans<T>::set_init_centres(const T *C_in, da_int ldc_in) {
     return da_status_success;
 }
 
+/* Store a copy of the sample weights. n_weights = 0 removes them */
+template <typename T>
+da_status kmeans<T>::set_sample_weights(da_int n_weights, const T *weights) {
+
+    if (initdone == false)
+        return da_error(this->err, da_status_no_data,
+                        "No data has been passed to the handle. Please call "
+                        "da_kmeans_set_data_s or da_kmeans_set_data_d.");
+
+    this->model_trained = false;
+    if (n_weights == 0) {
+        sample_weights.clear();
+        return da_status_success;
+    }
+    if (n_weights != n_samples)
+        return da_error(this->err, da_status_invalid_input,
+                        "n_weights = " + std::to_string(n_weights) +
+                            ", it must be equal to n_samples = " +
+                            std::to_string(n_samples) + ".");
+    da_status status = this->check_1D_array(n_weights, weights, "n_weights", "weights");
+    if (status != da_status_success)
+        return status;
+
+    T sum = (T)0.0;
+    for (da_int i = 0; i < n_weights; i++) {
+        if (!da_std::isfinite(weights[i]) || weights[i] < (T)0.0)
+            return da_error(this->err, da_status_invalid_input,
+                            "weights[" + std::to_string(i) +
+                                "] must be finite and non-negative.");
+        sum += weights[i];
+    }
+    if (!(sum > (T)0.0))
+        return da_error(this->err, da_status_invalid_input,
+                        "The sum of the weights must be positive.");
+
+    try {
+        sample_weights.assign(weights, weights + n_weights);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    return da_status_success;
+}
+
 /* Compute the k-means clusters */
 template <typename T> da_status kmeans<T>::compute() {
 
@@ -431,6 +478,13 @@ template <typename T> da_status kmeans<T>::compute() {
                         "algorithm. Please use Lloyd, Elkan, or MacQueen.");
     }
 
+    // Weighted centre updates are only implemented for the batch algorithms
+    if (!sample_weights.empty() && algorithm != lloyd && algorithm != elkan) {
+        return da_error(this->err, da_status_incompatible_options,
+                        "Sample weights are only supported by the Lloyd and Elkan "
+                        "algorithms.");
+    }
+
     // Hartigan-Wong does not support empty cluster recovery, so force error mode
     if (algorithm == hartigan_wong && empty_cluster_handling != error) {
         std::string buff = "The selected empty cluster handling mode is not supported "
@@ -596,6 +650,8 @@ template <typename T> da_status kmeans<T>::compute() {
         }
 
         cluster_count.resize(n_clusters, 0);
+        if (!sample_weights.empty())
+            cluster_weights.resize(n_clusters, (T)0.0);
         work_int1.resize(n_clusters, 0);
         work_int2.resize(n_samples, 0);
         // Extra bit on workc1 just to enable some padding to be done for vectorization
@@ -785,38 +841,52 @@ template <typename T> da_status kmeans<T>::compute() {
 template <typename T>
 da_status kmeans<T>::transform(da_int m_samples, da_int m_features, const T *X,
                                da_int ldx, T *X_transform, da_int ldx_transform) {
+    _da_inference_context ctx;
+    ctx.err = this->err;
+    return transform(ctx, m_samples, m_features, X, ldx, X_transform, ldx_transform);
+}
+
+template <typename T>
+da_status kmeans<T>::transform(_da_inference_context &ctx, da_int m_samples,
+                               da_int m_features, const T *X, da_int ldx, T *X_transform,
+                               da_int ldx_transform) {
+    da_errors::da_error_t *err = ctx.err;
     if (!this->model_trained) {
         return da_warn(
-            this->err, da_status_no_data,
+            err, da_status_no_data,
             "The k-means has not been computed. Please call da_kmeans_compute_s or "
             "da_kmeans_compute_d.");
     }
 
     if (m_features != n_features)
         return da_error(
-            this->err, da_status_invalid_input,
+            err, da_status_invalid_input,
             "The function was called with m_features = " + std::to_string(m_features) +
                 " but the k-means has been computed with " + std::to_string(n_features) +
                 " features.");
     // Check the arguments
-    da_status status = this->check_2D_array(this->order, m_samples, m_features, X, ldx,
-                                            "m_samples", "m_features", "X", "ldx", 1, 1);
+    da_status status = this->check_2D_array(err, this->order, m_samples, m_features, X,
+                                            ldx, "m_samples", "m_features", "X", "ldx",
+                                            1, 1);
     if (status != da_status_success)
         return status;
-    status = this->check_2D_array(this->order, m_samples, n_clusters, X_transform,
+    status = this->check_2D_array(err, this->order, m_samples, n_clusters, X_transform,
                                   ldx_transform, "m_samples", "n_clusters", "X_transform",
                                   "ldx_transform", 1, 1);
     if (status != da_status_success)
         return status;
 
-    std::vector<T> x_work;
-
+    // Workspace: norms of the samples, then the cluster centres in row-major order if
+    // needed
+    std::vector<T> &work = ctx.workspace<T>();
+    size_t n_centres = this->order == row_major ? (size_t)n_clusters * n_features : 0;
     try {
-        x_work.resize(m_samples);
+        work.resize((size_t)m_samples + n_centres);
     } catch (std::bad_alloc const &) {
-        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
                         "Memory allocation failed.");
     }
+    T *x_work = work.data();
 
     if (do_spherical) {
         // Cosine distance: D_{ij} = 1 - (X_i · C_j) / ||X_i||  (centres are unit-norm)
@@ -843,48 +913,43 @@ da_status kmeans<T>::transform(da_int m_samples, da_int m_features, const T *X,
         // Compute inverse norms for normalization, or set to 1.0 if data is pre-normalized
         if (normalize_data) {
             da_utils::compute_squared_row_norms(this->order, m_samples, n_features, X,
-                                                ldx, x_work.data());
+                                                ldx, x_work);
             for (da_int i = 0; i < m_samples; i++) {
                 x_work[i] = safe_inv_sqrt(x_work[i]);
             }
         } else {
-            da_std::fill(x_work.begin(), x_work.begin() + m_samples, (T)1.0);
+            da_std::fill(x_work, x_work + m_samples, (T)1.0);
         }
 
         // Convert dot products to cosine distances
         if (this->order == column_major) {
             dot_to_cosine_distance_colmaj(m_samples, n_clusters, X_transform,
-                                          ldx_transform, x_work.data());
+                                          ldx_transform, x_work);
         } else {
             dot_to_cosine_distance_rowmaj(m_samples, n_clusters, X_transform,
-                                          ldx_transform, x_work.data());
+                                          ldx_transform, x_work);
         }
         return da_status_success;
     }
 
+    // The squared norms of the centres in workc1 are only read
     if (this->order == column_major) {
         // Compute m_samples x n_clusters matrix of distances to cluster centres
         ARCH::euclidean_gemm_distance(column_major, m_samples, n_clusters, n_features, X,
                                       ldx, (*best_cluster_centres).data(), n_clusters,
-                                      X_transform, ldx_transform, x_work.data(), 2,
+                                      X_transform, ldx_transform, x_work, 2,
                                       workc1.data(), 1, false, false);
     } else {
         // For row-major, we will transpose the cluster centres to row-major format
-        std::vector<T> C_row_major;
-        try {
-            C_row_major.resize((size_t)n_clusters * (size_t)n_features);
-        } catch (std::bad_alloc const &) {
-            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
-                            "Memory allocation failed.");
-        }
+        T *C_row_major = x_work + m_samples;
         da_utils::copy_transpose_2D_array_column_to_row_major(
             n_clusters, n_features, (*best_cluster_centres).data(), n_clusters,
-            C_row_major.data(), n_features);
+            C_row_major, n_features);
         // Compute m_samples x n_clusters matrix of distances to cluster centres
         ARCH::euclidean_gemm_distance(row_major, m_samples, n_clusters, n_features, X,
-                                      ldx, C_row_major.data(), n_features, X_transform,
-                                      ldx_transform, x_work.data(), 2, workc1.data(), 1,
-                                      false, false);
+                                      ldx, C_row_major, n_features, X_transform,
+                                      ldx_transform, x_work, 2, workc1.data(), 1, false,
+                                      false);
     }
 
     return da_status_success;
@@ -893,81 +958,91 @@ da_status kmeans<T>::transform(da_int m_samples, da_int m_features, const T *X,
 template <typename T>
 da_status kmeans<T>::predict(da_int k_samples, da_int k_features, const T *Y, da_int ldy,
                              da_int *Y_labels) {
+    _da_inference_context ctx;
+    ctx.err = this->err;
+    return predict(ctx, k_samples, k_features, Y, ldy, Y_labels);
+}
 
+template <typename T>
+da_status kmeans<T>::predict(_da_inference_context &ctx, da_int k_samples,
+                             da_int k_features, const T *Y, da_int ldy,
+                             da_int *Y_labels) {
+    da_errors::da_error_t *err = ctx.err;
     if (!this->model_trained) {
         return da_warn(
-            this->err, da_status_no_data,
+            err, da_status_no_data,
             "The k-means has not been computed. Please call da_kmeans_compute_s or "
             "da_kmeans_compute_d.");
     }
 
     if (k_features != n_features)
         return da_error(
-            this->err, da_status_invalid_input,
+            err, da_status_invalid_input,
             "The function was called with k_features = " + std::to_string(k_features) +
                 " but the k-means has been computed with " + std::to_string(n_features) +
                 " features.");
 
     // Check the arguments
-    da_status status = this->check_2D_array(this->order, k_samples, k_features, Y, ldy,
-                                            "k_samples", "k_features", "Y", "ldy", 1, 1);
+    da_status status = this->check_2D_array(err, this->order, k_samples, k_features, Y,
+                                            ldy, "k_samples", "k_features", "Y", "ldy",
+                                            1, 1);
     if (status != da_status_success)
         return status;
 
     // Check for illegal output arguments
     if (Y_labels == nullptr)
-        return da_error(this->err, da_status_invalid_pointer,
-                        "The array Y_labels is null.");
+        return da_error(err, da_status_invalid_pointer, "The array Y_labels is null.");
 
     // Compute nearest cluster centre for each sample in Y; essentially a single blocked step of the Lloyd iteration.
-    std::vector<T> y_work;
-
-    max_block_size = std::min(KMEANS_LLOYD_BLOCK_SIZE<T>, k_samples);
+    // The blocking and the kernel are local so that the model is only read.
+    da_int pred_block_size = std::min(KMEANS_LLOYD_BLOCK_SIZE<T>, k_samples);
+    da_int pred_n_blocks, pred_block_rem;
+    da_utils::blocking_scheme(k_samples, pred_block_size, pred_n_blocks, pred_block_rem);
 
-    da_utils::blocking_scheme(k_samples, max_block_size, n_blocks, block_rem);
+    da_int n_threads = da_utils::get_n_threads_loop(pred_n_blocks);
 
-    da_int n_threads = da_utils::get_n_threads_loop(n_blocks);
-
-    da_int ldy_work;
-    // Assign predict_kernel to the correct lloyd kernel and get the required padding
+    // Assign the kernel to the correct lloyd kernel and get the required padding
+    std::function<void(bool, da_int, T *, da_int *, da_int *, T *, da_int, da_int)>
+        kernel;
     da_int padding = 0;
-    assign_lloyd_kernel(predict_kernel, padding, n_clusters);
+    assign_lloyd_kernel(kernel, padding, n_clusters);
+    da_int ldy_work = n_clusters + padding;
 
+    // Workspace: squared norms of the centres padded with infinity, then one block of
+    // distances per thread
+    std::vector<T> &work = ctx.workspace<T>();
     try {
-        y_work.resize((size_t)max_block_size * (size_t)(n_clusters + padding) *
-                      (size_t)n_threads);
-        // Add padding to workc1 if needed but don't overwrite existing values
-        workc1.resize(n_clusters + padding);
+        work.resize((size_t)ldy_work * (1 + (size_t)pred_block_size * (size_t)n_threads));
     } catch (std::bad_alloc const &) {
-        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
                         "Memory allocation failed.");
     }
-    da_std::fill(workc1.end() - padding, workc1.end(),
+    T *centre_norms = work.data();
+    T *y_work = work.data() + ldy_work;
+    da_std::copy(workc1.begin(), workc1.begin() + n_clusters, centre_norms);
+    da_std::fill(centre_norms + n_clusters, centre_norms + ldy_work,
                  da_std::numeric_limits<T>::infinity());
 
-    ldy_work = n_clusters + padding;
-
     da_int *dummy_int = nullptr;
     da_int block_index;
-    da_int block_size = max_block_size;
+    da_int block_size = pred_block_size;
 
     // For Y row-major we treat it as column-major storage of Y^T in GEMM calls
     auto Y_blas_trans = (this->order == column_major) ? CblasTrans : CblasNoTrans;
 
 #pragma omp parallel firstprivate(block_size) private(block_index)                       \
-    shared(n_blocks, block_rem, k_samples, max_block_size, best_cluster_centres, workc1, \
-               dummy_int, Y_labels, y_work, padding, ldy_work, ldy, Y,                   \
-               Y_blas_trans) default(none) num_threads(n_threads)
+    shared(pred_n_blocks, pred_block_rem, k_samples, pred_block_size,                    \
+               best_cluster_centres, centre_norms, kernel, dummy_int, Y_labels, y_work,  \
+               ldy_work, ldy, Y, Y_blas_trans) default(none) num_threads(n_threads)
     {
-        da_int y_work_index =
-            ((da_int)omp_get_thread_num()) * max_block_size * (n_clusters + padding);
+        da_int y_work_index = ((da_int)omp_get_thread_num()) * pred_block_size * ldy_work;
 #pragma omp for schedule(dynamic)
-        for (da_int i = 0; i < n_blocks; i++) {
-            if (i == n_blocks - 1 && block_rem > 0) {
-                block_index = k_samples - block_rem;
-                block_size = block_rem;
+        for (da_int i = 0; i < pred_n_blocks; i++) {
+            if (i == pred_n_blocks - 1 && pred_block_rem > 0) {
+                block_index = k_samples - pred_block_rem;
+                block_size = pred_block_rem;
             } else {
-                block_index = i * max_block_size;
+                block_index = i * pred_block_size;
             }
             da_int Y_index =
                 (this->order == column_major) ? block_index : block_index * ldy;
@@ -983,9 +1058,8 @@ da_status kmeans<T>::predict(da_int k_samples, da_int k_features, const T *Y, da
                                 ldy, (T)0.0, &y_work[y_work_index], ldy_work);
 
             // Loop through the samples and find the closest cluster centre and its label
-            predict_kernel(false, block_size, workc1.data(), dummy_int,
-                           &Y_labels[block_index], &y_work[y_work_index], ldy_work,
-                           n_clusters);
+            kernel(false, block_size, centre_norms, dummy_int, &Y_labels[block_index],
+                   &y_work[y_work_index], ldy_work, n_clusters);
         }
     }
 
@@ -1061,6 +1135,9 @@ template <typename T> void kmeans<T>::perform_kmeans() {
 template <typename T> void kmeans<T>::compute_current_inertia() {
     current_inertia = 0;
     T tmp;
+    // With sample weights, the inertia is the weighted sum of the squared distances
+    const T *w = sample_weights.empty() ? nullptr : sample_weights.data();
+    auto inertia_weight = [w](da_int i) { return w ? w[i] : (T)1.0; };
 
     if (do_spherical) {
         // For spherical k-means, inertia = sum of (1 - cosine_similarity)
@@ -1079,7 +1156,7 @@ template <typename T> void kmeans<T>::compute_current_inertia() {
                 else
                     cos_sim = dot;
 
-                current_inertia += (T)1.0 - cos_sim;
+                current_inertia += inertia_weight(i) * ((T)1.0 - cos_sim);
             }
         } else {
             for (da_int i = 0; i < n_samples; i++) {
@@ -1094,7 +1171,7 @@ template <typename T> void kmeans<T>::compute_current_inertia() {
                 else
                     cos_sim = dot;
 
-                current_inertia += (T)1.0 - cos_sim;
+                current_inertia += inertia_weight(i) * ((T)1.0 - cos_sim);
             }
         }
         return;
@@ -1107,7 +1184,7 @@ template <typename T> void kmeans<T>::compute_current_inertia() {
             for (da_int i = 0; i < n_samples; i++) {
                 da_int label = (*current_labels)[i];
                 tmp = A[i + idx] - (*current_cluster_centres)[label + cidx];
-                current_inertia += tmp * tmp;
+                current_inertia += inertia_weight(i) * tmp * tmp;
             }
         }
     } else {
@@ -1117,7 +1194,7 @@ template <typename T> void kmeans<T>::compute_current_inertia() {
             da_int idx = i * lda;
             for (da_int j = 0; j < n_features; j++) {
                 tmp = A[idx + j] - (*current_cluster_centres)[label + j * n_clusters];
-                current_inertia += tmp * tmp;
+                current_inertia += inertia_weight(i) * tmp * tmp;
             }
         }
     }
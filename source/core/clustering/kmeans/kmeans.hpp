@@ -28,6 +28,7 @@
 #include "approximate_neighbors.hpp"
 #include "basic_handle.hpp"
 #include "da_error.hpp"
+#include "da_inference_context.hpp"
 #include "da_kernel_utils.hpp"
 #include "kmeans_types.hpp"
 #include "macros.h"
@@ -163,6 +164,8 @@ template <typename T> class kmeans : public basic_handle<T> {
     T best_inertia = (T)0.0, current_inertia = (T)0.0; // Inertia
     std::vector<T> workcc1, workcs1, works1, works2, works3, works4, works5, workc1,
         workc2, workc3;
+    std::vector<T> sample_weights;  // Optional sample weights, empty if unweighted
+    std::vector<T> cluster_weights; // Sum of the sample weights in each cluster
     std::vector<T> data_norms;     // Precomputed ||x_i|| for spherical k-means
     std::vector<T> data_inv_norms; // Precomputed 1/||x_i|| for spherical k-means
     std::vector<std::vector<T>> thd_cluster_centres, thd_work1, thd_work2, thd_work3,
@@ -194,7 +197,8 @@ template <typename T> class kmeans : public basic_handle<T> {
                                         T *new_cluster_centres, da_int *labels,
                                         T *work1 = nullptr, T *work2 = nullptr,
                                         T *work3 = nullptr, T *work4 = nullptr,
-                                        const T *block_data_inv_norms = nullptr);
+                                        const T *block_data_inv_norms = nullptr,
+                                        const T *block_weights = nullptr);
 
     // Elkan algorithm functions, including various unrolled versions of the blocked part of the iteration
 
@@ -209,7 +213,8 @@ template <typename T> class kmeans : public basic_handle<T> {
                                       da_int *old_labels, da_int *new_labels,
                                       T *centre_half_distances, T *next_centre_distances,
                                       da_int *cluster_counts,
-                                      const T *block_data_inv_norms);
+                                      const T *block_data_inv_norms,
+                                      const T *block_weights = nullptr);
 
     // Function pointers which will be set when the algorithm has been chosen
 
@@ -220,9 +225,6 @@ template <typename T> class kmeans : public basic_handle<T> {
     std::function<void(bool, da_int, T *, da_int *, da_int *, T *, da_int, da_int)>
         lloyd_kernel;
 
-    std::function<void(bool, da_int, T *, da_int *, da_int *, T *, da_int, da_int)>
-        predict_kernel;
-
     std::function<void(da_int, T *, da_int, T *, T *, da_int *, da_int)>
         elkan_update_kernel;
 
@@ -295,6 +297,9 @@ template <typename T> class kmeans : public basic_handle<T> {
 
     da_status set_init_centres(const T *C_in, da_int ldc_in);
 
+    /* Store optional sample weights used in the centre updates and the inertia */
+    da_status set_sample_weights(da_int n_weights, const T *weights);
+
     /* Compute the k-means clusters */
     da_status compute();
 
@@ -304,6 +309,15 @@ template <typename T> class kmeans : public basic_handle<T> {
     da_status predict(da_int k_samples, da_int k_features, const T *Y, da_int ldy,
                       da_int *Y_labels);
 
+    /* Versions of transform and predict which only read the trained model: errors and
+     * temporary arrays go to ctx, so they can be called concurrently on the same handle
+     */
+    da_status transform(_da_inference_context &ctx, da_int m_samples, da_int m_features,
+                        const T *X, da_int ldx, T *X_transform, da_int ldx_transform);
+
+    da_status predict(_da_inference_context &ctx, da_int k_samples, da_int k_features,
+                      const T *Y, da_int ldy, da_int *Y_labels);
+
     da_status serialize(da_model_persistence::serialization_buffer &buffer) override;
     da_status save_model(da_model_persistence::serialization_buffer &buffer) override;
     da_status load_model(da_model_persistence::serialization_buffer &buffer) override;
@@ -125,8 +125,10 @@ void kmeans<T>::assign_elkan_kernels(
     using namespace ::da_kmeans; // External ns
     vectorization_type u_isa{undefined}, r_isa{undefined};
 
-    u_isa = Oracle<KernelSelection>(elkan_update, tid<T>(), n_clusters, "kmeans.isa");
-    r_isa = Oracle<KernelSelection>(elkan_reduce, tid<T>(), n_features, "kmeans.isa");
+    u_isa = Oracle<KernelSelection>(elkan_update, tid<T>(), n_clusters, "kmeans.isa",
+                                    "kmeans.elkan_update");
+    r_isa = Oracle<KernelSelection>(elkan_reduce, tid<T>(), n_features, "kmeans.isa",
+                                    "kmeans.elkan_reduce");
 
     update_kernel = elkan_update_implementations().get<T>(u_isa);
     reduce_kernel = elkan_reduction_implementations().get<T>(r_isa);
@@ -284,7 +286,8 @@ void kmeans<T>::elkan_iteration(bool update_centres, da_int n_threads) {
         thd_cluster_centres, thd_work_int, n_blocks, block_rem, update_centres, A, lda,  \
             previous_cluster_centres, current_cluster_centres, cluster_count, workc1,    \
             workcc1, ldworkcs1, max_block_size, current_labels, previous_labels, works1, \
-            workcs1, cluster_count_lock, cluster_centres_lock, data_inv_norms)           \
+            workcs1, cluster_count_lock, cluster_centres_lock, data_inv_norms,           \
+            sample_weights)                                                              \
     firstprivate(block_size) private(block_index) default(none) num_threads(n_threads)
         {
             da_int this_thread = omp_get_thread_num();
@@ -304,7 +307,8 @@ void kmeans<T>::elkan_iteration(bool update_centres, da_int n_threads) {
                     &works1[block_index], &workcs1[block_index * ldworkcs1], ldworkcs1,
                     &(*previous_labels)[block_index], &(*current_labels)[block_index],
                     workcc1.data(), workc1.data(), &local_work_int[0],
-                    normalize_data ? data_inv_norms.data() + block_index : nullptr);
+                    normalize_data ? data_inv_norms.data() + block_index : nullptr,
+                    sample_weights.empty() ? nullptr : &sample_weights[block_index]);
             }
             // Now aggregate local_work_int into cluster_count and local_cluster_centres into current_cluster_centres
             // The while loop is used because we don't mind what order each thread executes the two critical regions
@@ -347,7 +351,8 @@ void kmeans<T>::elkan_iteration(bool update_centres, da_int n_threads) {
                 &works1[block_index], &workcs1[block_index * ldworkcs1], ldworkcs1,
                 &(*previous_labels)[block_index], &(*current_labels)[block_index],
                 workcc1.data(), workc1.data(), cluster_count.data(),
-                normalize_data ? data_inv_norms.data() + block_index : nullptr);
+                normalize_data ? data_inv_norms.data() + block_index : nullptr,
+                sample_weights.empty() ? nullptr : &sample_weights[block_index]);
         }
     }
 
@@ -417,7 +422,8 @@ void kmeans<T>::elkan_iteration_assign_block(
     bool update_centres, da_int block_size, const T *data, da_int lddata,
     T *old_cluster_centres, T *new_cluster_centres, T *u_bounds, T *l_bounds,
     da_int ldl_bounds, da_int *old_labels, da_int *new_labels, T *centre_half_distances,
-    T *next_centre_distances, da_int *cluster_counts, const T *block_data_inv_norms) {
+    T *next_centre_distances, da_int *cluster_counts, const T *block_data_inv_norms,
+    const T *block_weights) {
 
     // Recall that for Elkan, data is stored row-major and cluster centres are stored row-major
 
@@ -500,9 +506,16 @@ void kmeans<T>::elkan_iteration_assign_block(
             cluster_counts[label] += 1;
             // Add this sample to the cluster mean
             if (do_spherical && normalize_data) {
+                T scale = block_weights ? data_inv_norm_i * block_weights[i]
+                                        : data_inv_norm_i;
                 for (da_int j = 0; j < n_features; j++) {
                     new_cluster_centres[label * n_features + j] +=
-                        data[i * lddata + j] * data_inv_norm_i;
+                        data[i * lddata + j] * scale;
+                }
+            } else if (block_weights) {
+                for (da_int j = 0; j < n_features; j++) {
+                    new_cluster_centres[label * n_features + j] +=
+                        data[i * lddata + j] * block_weights[i];
                 }
             } else {
                 for (da_int j = 0; j < n_features; j++) {
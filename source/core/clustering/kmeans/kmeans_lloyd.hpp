@@ -90,7 +90,8 @@ void kmeans<T>::assign_lloyd_kernel(
     vectorization_type isa{undefined};
     using namespace ::da_kmeans; // External ns
 
-    isa = Oracle<KernelSelection>(lloyd_tuning, tid<T>(), n_clusters, "kmeans.isa");
+    isa = Oracle<KernelSelection>(lloyd_tuning, tid<T>(), n_clusters, "kmeans.isa",
+                                  "kmeans.lloyd");
 
     kernel = lloyd_implementations().get<T>(isa);
     padding = get_padding<T>(isa);
@@ -148,6 +149,7 @@ void kmeans<T>::lloyd_iteration(bool update_centres, da_int n_threads) {
     // Precompute pointer to inverse data norms for normalized spherical k-means centre updates
     const T *inv_norm_ptr =
         (do_spherical && normalize_data) ? data_inv_norms.data() : nullptr;
+    const T *weights_ptr = sample_weights.empty() ? nullptr : sample_weights.data();
 
     if (n_threads > 1) {
 
@@ -160,7 +162,8 @@ void kmeans<T>::lloyd_iteration(bool update_centres, da_int n_threads) {
             previous_cluster_centres, current_cluster_centres, cluster_count,            \
             current_labels, workc1, workcs1, ldworkcs1, max_block_size,                  \
             thd_cluster_centres, thd_work_int, cluster_centres_lock, cluster_count_lock, \
-            A_blas_trans, thd_work1, thd_work2, thd_work3, thd_work4, inv_norm_ptr)      \
+            A_blas_trans, thd_work1, thd_work2, thd_work3, thd_work4, inv_norm_ptr,      \
+            weights_ptr)                                                                 \
     firstprivate(block_size) private(block_index) default(none) num_threads(n_threads)
         {
             da_int this_thread = (da_int)omp_get_thread_num();
@@ -202,7 +205,8 @@ void kmeans<T>::lloyd_iteration(bool update_centres, da_int n_threads) {
                         block_size, &A[A_index], lda, &local_cluster_centres[0],
                         &(*current_labels)[block_index], &local_work1[0], &local_work2[0],
                         &local_work3[0], &local_work4[0],
-                        inv_norm_ptr ? inv_norm_ptr + block_index : nullptr);
+                        inv_norm_ptr ? inv_norm_ptr + block_index : nullptr,
+                        weights_ptr ? weights_ptr + block_index : nullptr);
             }
             // Now aggregate local_work_int into cluster_count and local_cluster_centres into current_cluster_centres
             // The while loop is used because we don't mind what order each thread executes the two critical regions
@@ -259,7 +263,8 @@ void kmeans<T>::lloyd_iteration(bool update_centres, da_int n_threads) {
                     block_size, &A[A_index], lda, (*current_cluster_centres).data(),
                     &(*current_labels)[block_index], thd_work1[0].data(),
                     thd_work2[0].data(), thd_work3[0].data(), thd_work4[0].data(),
-                    inv_norm_ptr ? inv_norm_ptr + block_index : nullptr);
+                    inv_norm_ptr ? inv_norm_ptr + block_index : nullptr,
+                    weights_ptr ? weights_ptr + block_index : nullptr);
         }
     }
 
@@ -276,7 +281,27 @@ void kmeans<T>::lloyd_iteration_update_centres(da_int block_size, const T *data,
                                                da_int lddata, T *new_cluster_centres,
                                                da_int *labels, T *work1, T *work2,
                                                T *work3, T *work4,
-                                               const T *block_data_inv_norms) {
+                                               const T *block_data_inv_norms,
+                                               const T *block_weights) {
+
+    // Weighted samples: accumulate w_i * x_i (scaled by 1/||x_i|| for normalized spherical)
+    if (block_weights != nullptr) {
+        bool scale_norms = do_spherical && normalize_data && block_data_inv_norms;
+        for (da_int i = 0; i < block_size; i++) {
+            T wi = scale_norms ? block_weights[i] * block_data_inv_norms[i]
+                               : block_weights[i];
+            T *dst = new_cluster_centres + labels[i];
+            if (this->A_order == column_major) {
+                for (da_int j = 0; j < n_features; j++)
+                    dst[j * n_clusters] += wi * data[i + j * lddata];
+            } else {
+                const T *src = data + i * lddata;
+                for (da_int j = 0; j < n_features; j++)
+                    dst[j * n_clusters] += wi * src[j];
+            }
+        }
+        return;
+    }
 
     // Spherical k-means with normalized data: accumulate normalized data points
     if (do_spherical && normalize_data && block_data_inv_norms != nullptr) {
@@ -369,6 +394,38 @@ template <typename T> void kmeans<T>::scale_current_cluster_centres() {
             cluster_count[i] = 1;
     }
 
+    // With sample weights, divide by the total weight of each cluster instead
+    if (!sample_weights.empty() && !do_spherical) {
+        da_std::fill(cluster_weights.begin(), cluster_weights.end(), (T)0.0);
+        for (da_int i = 0; i < n_samples; i++)
+            cluster_weights[(*current_labels)[i]] += sample_weights[i];
+        // A cluster with no total weight is treated as empty: its accumulated sum is zero,
+        // so keep the centre from the previous iteration, still held in
+        // previous_cluster_centres, rather than collapsing it to the origin
+        T *centres = (*current_cluster_centres).data();
+        const T *old_centres = (*previous_cluster_centres).data();
+        if (this->algorithm == lloyd) {
+            for (da_int j = 0; j < n_features; j++) {
+                for (da_int i = 0; i < n_clusters; i++) {
+                    if (cluster_weights[i] > (T)0.0)
+                        centres[i + j * n_clusters] /= cluster_weights[i];
+                    else
+                        centres[i + j * n_clusters] = old_centres[i + j * n_clusters];
+                }
+            }
+        } else {
+            for (da_int i = 0; i < n_clusters; i++) {
+                for (da_int j = 0; j < n_features; j++) {
+                    if (cluster_weights[i] > (T)0.0)
+                        centres[i * n_features + j] /= cluster_weights[i];
+                    else
+                        centres[i * n_features + j] = old_centres[i * n_features + j];
+                }
+            }
+        }
+        return;
+    }
+
     // Scale to get proper column means (cluster_count contains the number of data points in each cluster)
     if (!do_spherical) {
         if (this->algorithm == lloyd) {
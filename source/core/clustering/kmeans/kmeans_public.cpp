@@ -58,6 +58,21 @@ da_status da_kmeans_set_init_centres(da_handle handle, const T *C, da_int ldc) {
                return (kmeans_set_init_centres<da_kmeans::kmeans<T>, T>(handle, C, ldc)));
 }
 
+template <typename T>
+da_status da_kmeans_set_sample_weights(da_handle handle, da_int n_weights,
+                                       const T *weights) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err, return (kmeans_set_sample_weights<da_kmeans::kmeans<T>, T>(
+                                handle, n_weights, weights)));
+}
+
 template <typename T> da_status da_kmeans_compute(da_handle handle) {
     if (!handle)
         return da_status_handle_not_initialized;
@@ -102,12 +117,52 @@ da_status da_kmeans_predict(da_handle handle, da_int k_samples, da_int k_feature
                                 handle, k_samples, k_features, Y, ldy, Y_labels)));
 }
 
+template <typename T>
+da_status da_kmeans_transform(da_handle handle, da_inference_context ctx,
+                              da_int m_samples, da_int m_features, const T *X, da_int ldx,
+                              T *X_transform, da_int ldx_transform) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    if (!ctx)
+        return da_status_invalid_pointer;
+    ctx->clear(); // Clean up context logs, the handle is only read
+
+    da_status status = handle->check_precision<T>(ctx->err);
+    if (status != da_status_success)
+        return da_error_trace(ctx->err, status, "Wrong precision type.");
+
+    DISPATCHER(ctx->err, return (kmeans_transform<da_kmeans::kmeans<T>, T>(
+                             handle, ctx, m_samples, m_features, X, ldx, X_transform,
+                             ldx_transform)));
+}
+
+template <typename T>
+da_status da_kmeans_predict(da_handle handle, da_inference_context ctx, da_int k_samples,
+                            da_int k_features, const T *Y, da_int ldy, da_int *Y_labels) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    if (!ctx)
+        return da_status_invalid_pointer;
+    ctx->clear(); // Clean up context logs, the handle is only read
+
+    da_status status = handle->check_precision<T>(ctx->err);
+    if (status != da_status_success)
+        return da_error_trace(ctx->err, status, "Wrong precision type.");
+
+    DISPATCHER(ctx->err, return (kmeans_predict<da_kmeans::kmeans<T>, T>(
+                             handle, ctx, k_samples, k_features, Y, ldy, Y_labels)));
+}
+
 template da_status da_kmeans_set_data<float>(da_handle, da_int, da_int, const float *,
                                              da_int);
 template da_status da_kmeans_set_data<double>(da_handle, da_int, da_int, const double *,
                                               da_int);
 template da_status da_kmeans_set_init_centres<float>(da_handle, const float *, da_int);
 template da_status da_kmeans_set_init_centres<double>(da_handle, const double *, da_int);
+template da_status da_kmeans_set_sample_weights<float>(da_handle, da_int,
+                                                      const float *);
+template da_status da_kmeans_set_sample_weights<double>(da_handle, da_int,
+                                                       const double *);
 template da_status da_kmeans_compute<float>(da_handle);
 template da_status da_kmeans_compute<double>(da_handle);
 template da_status da_kmeans_transform<float>(da_handle, da_int, da_int, const float *,
@@ -117,4 +172,14 @@ template da_status da_kmeans_transform<double>(da_handle, da_int, da_int, const
 template da_status da_kmeans_predict<float>(da_handle, da_int, da_int, const float *,
                                             da_int, da_int *);
 template da_status da_kmeans_predict<double>(da_handle, da_int, da_int, const double *,
-                                             da_int, da_int *);
\ No newline at end of file
+                                             da_int, da_int *);
+template da_status da_kmeans_transform<float>(da_handle, da_inference_context, da_int,
+                                              da_int, const float *, da_int, float *,
+                                              da_int);
+template da_status da_kmeans_transform<double>(da_handle, da_inference_context, da_int,
+                                               da_int, const double *, da_int, double *,
+                                               da_int);
+template da_status da_kmeans_predict<float>(da_handle, da_inference_context, da_int,
+                                            da_int, const float *, da_int, da_int *);
+template da_status da_kmeans_predict<double>(da_handle, da_inference_context, da_int,
+                                             da_int, const double *, da_int, da_int *);
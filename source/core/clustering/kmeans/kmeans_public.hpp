@@ -23,6 +23,7 @@
 
 #include "aoclda.h"
 #include "da_handle.hpp"
+#include "da_inference_context.hpp"
 #include "dynamic_dispatch.hpp"
 #include "macros.h"
 
@@ -37,7 +38,10 @@ da_status kmeans_set_data(da_handle handle, da_int n_samples, da_int n_features,
                         "handle was not initialized with handle_type=da_handle_kmeans or "
                         "handle is invalid.");
 
-    return kmeans->set_data(n_samples, n_features, A, lda);
+    da_status status = kmeans->set_data(n_samples, n_features, A, lda);
+    if (status == da_status_success)
+        kmeans->release_datastore_data();
+    return status;
 }
 
 template <typename kmeans_class, typename T>
@@ -51,6 +55,18 @@ da_status kmeans_set_init_centres(da_handle handle, const T *C, da_int ldc) {
     return kmeans->set_init_centres(C, ldc);
 }
 
+template <typename kmeans_class, typename T>
+da_status kmeans_set_sample_weights(da_handle handle, da_int n_weights,
+                                    const T *weights) {
+    kmeans_class *kmeans = dynamic_cast<kmeans_class *>(handle->get_alg_handle<T>());
+    if (kmeans == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_kmeans or "
+                        "handle is invalid.");
+
+    return kmeans->set_sample_weights(n_weights, weights);
+}
+
 template <typename kmeans_class, typename T> da_status kmeans_compute(da_handle handle) {
     kmeans_class *kmeans = dynamic_cast<kmeans_class *>(handle->get_alg_handle<T>());
     if (kmeans == nullptr)
@@ -85,4 +101,30 @@ da_status kmeans_predict(da_handle handle, da_int k_samples, da_int k_features,
     return kmeans->predict(k_samples, k_features, Y, ldy, Y_labels);
 }
 
+template <typename kmeans_class, typename T>
+da_status kmeans_transform(da_handle handle, da_inference_context ctx, da_int m_samples,
+                           da_int m_features, const T *X, da_int ldx, T *X_transform,
+                           da_int ldx_transform) {
+    kmeans_class *kmeans = dynamic_cast<kmeans_class *>(handle->get_alg_handle<T>());
+    if (kmeans == nullptr)
+        return da_error(ctx->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_kmeans or "
+                        "handle is invalid.");
+
+    return kmeans->transform(*ctx, m_samples, m_features, X, ldx, X_transform,
+                             ldx_transform);
+}
+
+template <typename kmeans_class, typename T>
+da_status kmeans_predict(da_handle handle, da_inference_context ctx, da_int k_samples,
+                         da_int k_features, const T *Y, da_int ldy, da_int *Y_labels) {
+    kmeans_class *kmeans = dynamic_cast<kmeans_class *>(handle->get_alg_handle<T>());
+    if (kmeans == nullptr)
+        return da_error(ctx->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_kmeans or "
+                        "handle is invalid.");
+
+    return kmeans->predict(*ctx, k_samples, k_features, Y, ldy, Y_labels);
+}
+
 } // namespace kmeans_public
\ No newline at end of file
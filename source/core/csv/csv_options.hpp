@@ -179,6 +179,13 @@ inline da_status register_csv_options(da_options::OptionRegistry &opts) {
         0, da_options::lbound_t::greaterequal, 1, da_options::ubound_t::lessequal, 0));
     opts.register_opt(oi);
 
+    oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+        "categorical strings",
+        "Whether or not to store the string columns of CSV files read into a datastore "
+        "as dictionary-encoded categorical columns.",
+        0, da_options::lbound_t::greaterequal, 1, da_options::ubound_t::lessequal, 0));
+    opts.register_opt(oi);
+
     return da_status_success;
 }
 
@@ -48,6 +48,7 @@ class csv_reader {
     da_int precision;
     da_int integers_as_fp;
     da_int first_row_header;
+    da_int categorical_strings;
     csv_datatype datatype;
 
     da_order order;
@@ -162,6 +163,9 @@ class csv_reader {
         opts->get("use header row", iopt);
         first_row_header = iopt;
 
+        opts->get("categorical strings", iopt);
+        categorical_strings = iopt;
+
         return da_status_success;
     }
 };
@@ -34,12 +34,15 @@
 #include "interval.hpp"
 #include "interval_map.hpp"
 #include "interval_set.hpp"
+#include "da_omp.hpp"
 #include "read_csv.hpp"
+#include <algorithm>
 #include <ciso646> // Fixes an MSVC issue
 #include <iostream>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <typeinfo>
 #include <unordered_map>
 #include <vector>
@@ -61,7 +64,8 @@ enum block_type {
     block_real_d,
     block_char,
     block_str,
-    block_bool // Primarily intended for uint8_t data obtained from true/false values in a CSV file
+    block_bool, // Primarily intended for uint8_t data obtained from true/false values in a CSV file
+    block_cat   // Dictionary-encoded categorical strings, stored as da_int codes
 };
 
 template <typename T> struct get_block_type {
@@ -101,6 +105,12 @@ template <> struct get_block_type<uint8_t *> {
     constexpr operator block_type() const { return block_bool; }
 };
 
+/* Categorical columns store their codes as da_int and can be read as integer columns */
+template <class T> bool block_matches(block_type btype) {
+    return btype == get_block_type<T>() ||
+           (btype == block_cat && std::is_same_v<T, da_int>);
+}
+
 /* Missing values for each type:
  * - real numbers: missing if value = NaN
  * - integral types: missing if value >= max int
@@ -214,6 +224,26 @@ template <class T> class block_dense : public block_base<T> {
 
     void set_own_data(bool own) { own_data = own; }
 
+    /* Get a pointer to the subset of the block defined by the intervals rows and cols,
+     * without copying it. Only possible if the block is stored in the requested order.
+     * On output, data points to the first element and ld is the leading dimension.
+     * exit status:
+     * - not_implemented: the block is stored in the other order
+     */
+    da_status get_dense_view(interval rows, interval cols, da_order order,
+                             const T *&data, da_int &ld) {
+        if (order != this->order)
+            return da_status_not_implemented;
+        if (order == column_major) {
+            data = &bl[cols.lower * this->m + rows.lower];
+            ld = this->m;
+        } else {
+            data = &bl[rows.lower * this->n + cols.lower];
+            ld = this->n;
+        }
+        return da_status_success;
+    }
+
     da_status get_col(da_int idx, T **col, da_int &stride) {
 
         if (idx < 0 || idx >= this->n) {
@@ -356,6 +386,158 @@ template <class T> class block_dense : public block_base<T> {
     }
 };
 
+/* Encode the m strings col[0], col[stride], ... as integer codes numbered in order of
+ * first appearance. New categories are appended to dict, NULL strings are missing.
+ * Can throw bad_alloc.
+ */
+inline void encode_categories(da_int m, const char *const *col, da_int stride,
+                              da_int *codes, std::vector<std::string> &dict) {
+    std::unordered_map<std::string_view, da_int> index;
+    for (da_int i = 0; i < m; i++) {
+        if (col[i * stride] == nullptr) {
+            codes[i] = std::numeric_limits<da_int>::max();
+            continue;
+        }
+        std::string_view str(col[i * stride]);
+        auto it = index.find(str);
+        if (it == index.end()) {
+            it = index.emplace(str, (da_int)dict.size()).first;
+            dict.emplace_back(str);
+        }
+        codes[i] = it->second;
+    }
+}
+
+/* Missing values never satisfy a predicate */
+template <class T> inline bool not_missing(T x) {
+    if constexpr (std::is_floating_point_v<T>)
+        return x == x;
+    else
+        return x != std::numeric_limits<T>::max();
+}
+
+/* Combine the row mask sel with the predicate evaluated on x[0], x[stride], ...
+ * using a logical AND or OR. The unit stride loops are vectorized into compare and mask
+ * instructions.
+ */
+template <class T, class Pred>
+inline void mark_rows(da_int len, const T *x, da_int stride, bool and_op, Pred pred,
+                      uint8_t *sel) {
+    if (stride == 1) {
+        if (and_op) {
+#pragma omp simd
+            for (da_int i = 0; i < len; i++)
+                sel[i] &= (uint8_t)(pred(x[i]) & not_missing(x[i]));
+        } else {
+#pragma omp simd
+            for (da_int i = 0; i < len; i++)
+                sel[i] |= (uint8_t)(pred(x[i]) & not_missing(x[i]));
+        }
+    } else {
+        for (da_int i = 0; i < len; i++) {
+            T v = x[i * stride];
+            uint8_t match = (uint8_t)(pred(v) & not_missing(v));
+            sel[i] = and_op ? sel[i] & match : sel[i] | match;
+        }
+    }
+}
+
+/* Evaluate the predicate op with operands values on len elements of a column.
+ * For da_pred_in, values must be sorted.
+ */
+template <class T>
+inline void filter_rows(da_predicate op, const std::vector<T> &values, da_int len,
+                        const T *x, da_int stride, bool and_op, uint8_t *sel) {
+    if (values.empty()) {
+        // Empty IN-set: no row matches
+        if (and_op)
+            std::fill(sel, sel + len, 0);
+        return;
+    }
+    T a = values[0], b = values.back();
+    switch (op) {
+    case da_pred_equal:
+        mark_rows(len, x, stride, and_op, [a](T v) { return v == a; }, sel);
+        break;
+    case da_pred_not_equal:
+        mark_rows(len, x, stride, and_op, [a](T v) { return v != a; }, sel);
+        break;
+    case da_pred_less:
+        mark_rows(len, x, stride, and_op, [a](T v) { return v < a; }, sel);
+        break;
+    case da_pred_less_equal:
+        mark_rows(len, x, stride, and_op, [a](T v) { return v <= a; }, sel);
+        break;
+    case da_pred_greater:
+        mark_rows(len, x, stride, and_op, [a](T v) { return v > a; }, sel);
+        break;
+    case da_pred_greater_equal:
+        mark_rows(len, x, stride, and_op, [a](T v) { return v >= a; }, sel);
+        break;
+    case da_pred_between:
+        mark_rows(len, x, stride, and_op, [a, b](T v) { return (v >= a) & (v <= b); },
+                  sel);
+        break;
+    case da_pred_in: {
+        const T *vals = values.data();
+        size_t nv = values.size();
+        if (nv <= 16) {
+            auto pred = [vals, nv](T v) {
+                bool match = false;
+                for (size_t k = 0; k < nv; k++)
+                    match |= v == vals[k];
+                return match;
+            };
+            mark_rows(len, x, stride, and_op, pred, sel);
+        } else {
+            auto pred = [vals, nv](T v) {
+                return std::binary_search(vals, vals + nv, v);
+            };
+            mark_rows(len, x, stride, and_op, pred, sel);
+        }
+        break;
+    }
+    }
+}
+
+/* Dictionary-encoded categorical column.
+ * The codes are stored in a dense m x 1 da_int block owned by the block, and refer to the
+ * entries of a dictionary of labels shared by all the copies of the column.
+ * Missing entries are marked with the missing value of da_int.
+ */
+class block_dict : public block_dense<da_int> {
+    std::shared_ptr<std::vector<std::string>> dictionary;
+
+  public:
+    /* Constructor can throw bad_alloc exception */
+    block_dict(da_int m, da_int *codes, da_errors::da_error_t &err,
+               std::shared_ptr<std::vector<std::string>> dict)
+        : block_dense<da_int>(m, 1, codes, err, column_major, false) {
+        set_own_data(true);
+        dictionary = dict;
+        this->btype = block_cat;
+    }
+
+    da_int n_categories() { return (da_int)dictionary->size(); }
+    const std::vector<std::string> &get_dictionary() { return *dictionary; }
+    std::shared_ptr<std::vector<std::string>> shared_dictionary() { return dictionary; }
+
+    /* Code of a given label, -1 if it is not in the dictionary */
+    da_int find_category(const std::string &label) {
+        for (size_t k = 0; k < dictionary->size(); k++) {
+            if ((*dictionary)[k] == label)
+                return (da_int)k;
+        }
+        return -1;
+    }
+
+    const da_int *codes() {
+        da_int *c, stride;
+        get_col(0, &c, stride);
+        return c;
+    }
+};
+
 /* Wrapper structure containing a pointer to a block and meta-data around the block */
 class block_id {
   public:
@@ -384,6 +566,9 @@ using idx_slice = interval_map<da_int>;
 struct coord_slice {
     std::unique_ptr<interval_set> col_slice;
     std::unique_ptr<interval_set> row_slice;
+    // Set when a predicate matched no rows: the empty row_slice then selects no rows
+    // instead of all of them, until rows are added to the selection again
+    bool no_rows = false;
     coord_slice() {
         col_slice = std::make_unique<interval_set>();
         row_slice = std::make_unique<interval_set>();
@@ -423,6 +608,11 @@ class data_store {
     /* Error structure pointing to the main handle */
     da_errors::da_error_t *err;
 
+    /* Owners of external memory referenced by blocks that do not own their data
+     * (e.g. imported Arrow arrays). They are released with the data_store.
+     */
+    std::vector<std::shared_ptr<void>> external_owners;
+
   public:
     data_store(da_errors::da_error_t &err) { this->err = &err; }
     ~data_store() {
@@ -441,6 +631,18 @@ class data_store {
     da_int get_num_cols() { return this->n; }
 
     bool empty() { return m == 0 && n == 0 && cmap.empty(); }
+    bool has_missing_block() { return missing_block; }
+
+    /* Keep owner alive as long as the data_store, for blocks referencing its memory */
+    da_status keep_alive(std::shared_ptr<void> owner) {
+        try {
+            external_owners.push_back(owner);
+        } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        return da_status_success;
+    }
 
     /* Concatenate dense blocks of columns or rows to the data_store.
      * takes user's dense data block of size m*n stored in *data and add it as a block to the datastore
@@ -610,7 +812,7 @@ class data_store {
      * in output, 'this' will contain the concatenation and store will be destroyed.
      */
     da_status horizontal_concat(data_store &store) {
-        if (m != store.m)
+        if (n > 0 && m != store.m)
             return da_error(err, da_status_invalid_input,
                             "The number of rows in both stores must match (" +
                                 std::to_string(m) + " vs " + std::to_string(store.m) +
@@ -622,6 +824,16 @@ class data_store {
 
         columns_map::iterator it1 = store.cmap.begin(), it2;
         da_int n_orig = n;
+        try {
+            index_to_name.resize(n + store.n, nullptr);
+            external_owners.insert(external_owners.end(), store.external_owners.begin(),
+                                   store.external_owners.end());
+        } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        if (n == 0)
+            m = store.m;
         std::shared_ptr<block_id> store_block, next, current_block;
         while (it1 != store.cmap.end()) {
             da_int nc = it1->first.upper - it1->first.lower + 1;
@@ -641,8 +853,13 @@ class data_store {
             it1++;
             store.cmap.erase(it2);
         }
+        for (sz_t j = 0; j < store.index_to_name.size(); j++) {
+            if (store.index_to_name[j] != nullptr)
+                label_column(*store.index_to_name[j], n_orig + (da_int)j);
+        }
         store.m = 0;
         store.n = 0;
+        store.external_owners.clear();
 
         return da_status_success;
     }
@@ -679,7 +896,7 @@ class data_store {
         block_base<T> *bb;
         std::shared_ptr<block_id> id;
         cmap.find(idx, id, lb, ub);
-        if (id->b->btype != get_block_type<T>())
+        if (!block_matches<T>(id->b->btype))
             return da_error(
                 err, da_status_invalid_input,
                 "Incompatible types between the datastore and the input data");
@@ -738,7 +955,7 @@ class data_store {
         while (ucol - lcol >= 0) {
             it = cmap.find(lcol);
             std::shared_ptr<block_id> bid = it->second;
-            if (bid->b->btype != get_block_type<T>())
+            if (!block_matches<T>(bid->b->btype))
                 return da_error(err, da_status_invalid_input,
                                 "Incompatible type in the slice");
             da_int uc = std::min(ucol, it->first.upper);
@@ -772,6 +989,83 @@ class data_store {
         return da_status_success;
     }
 
+    /* Type of the block holding column idx, block_none if idx is out of range */
+    block_type column_type(da_int idx) {
+        if (idx < 0 || idx >= n)
+            return block_none;
+        return cmap.find(idx)->second->b->btype;
+    }
+
+    /* Access the rows of column idx without copying them.
+     * On output, col points to the first element and the following ones are contiguous.
+     * exit status:
+     * - invalid_input: wrong type or indices
+     * - not_implemented: the rows are not contiguous in memory (several row blocks or
+     *                    a row major block with more than one column)
+     */
+    template <class T> da_status column_view(da_int idx, interval rows, const T *&col) {
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot extract columns at this point");
+        if (idx < 0 || idx >= n || !rows.is_valid_idx(m))
+            return da_error(err, da_status_invalid_input, "Column view out of range");
+        da_int lb, ub;
+        std::shared_ptr<block_id> bid;
+        cmap.find(idx, bid, lb, ub);
+        if (!block_matches<T>(bid->b->btype))
+            return da_error(err, da_status_invalid_input, "Incompatible type");
+        da_int first_row_idx = 0;
+        while (first_row_idx + bid->b->m <= rows.lower) {
+            first_row_idx += bid->b->m;
+            bid = bid->next;
+        }
+        if (rows.upper >= first_row_idx + bid->b->m)
+            return da_status_not_implemented;
+        T *c;
+        da_int stride;
+        block_base<T> *bb = static_cast<block_base<T> *>(bid->b);
+        da_status status = bb->get_col(idx - bid->offset, &c, stride);
+        if (status != da_status_success)
+            return da_error_trace( // LCOV_EXCL_LINE
+                err, da_status_internal_error,
+                "Unexpected error occurred. Possible memory corruption.");
+        if (stride != 1 && rows.upper > rows.lower)
+            return da_status_not_implemented;
+        col = &c[(rows.lower - first_row_idx) * stride];
+        return da_status_success;
+    }
+
+    /* Get the row and column intervals of the selection key.
+     * Empty row or column sets are expanded to all the rows or columns of the store,
+     * unless the rows were filtered down to none by a predicate.
+     */
+    da_status selection_intervals(std::string key, std::vector<interval> &row_slices,
+                                  std::vector<interval> &col_slices) {
+        auto it = selections.find(key);
+        if (it == selections.end())
+            return da_error(err, da_status_invalid_input,
+                            "Selection " + key + " was not found");
+        try {
+            row_slices.clear();
+            col_slices.clear();
+            for (auto it_row = it->second.row_slice->begin();
+                 it_row != it->second.row_slice->end(); ++it_row)
+                row_slices.push_back(*it_row);
+            for (auto it_col = it->second.col_slice->begin();
+                 it_col != it->second.col_slice->end(); ++it_col)
+                col_slices.push_back(*it_col);
+            if (row_slices.empty() && !it->second.no_rows)
+                row_slices.push_back({0, m - 1});
+            if (col_slices.empty())
+                col_slices.push_back({0, n - 1});
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        return da_status_success;
+    }
+
     void remove_selection(std::string key) { selections.erase(key); }
 
     /* select_[slice|columns|rows]; add an interval to the selection 'key' in the data_store
@@ -821,6 +1115,7 @@ class data_store {
         if (exit_status != da_status_success)
             return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
                             "Unexpected failure in row selection.");
+        it->second.no_rows = false;
         exit_status = it->second.col_slice->insert(cols);
         if (exit_status != da_status_success) {
             it->second.row_slice->erase(rows);             // LCOV_EXCL_LINE
@@ -888,6 +1183,8 @@ class data_store {
         }
 
         exit_status = it->second.row_slice->insert(rows);
+        if (exit_status == da_status_success)
+            it->second.no_rows = false;
 
         return exit_status;
     }
@@ -979,7 +1276,7 @@ class data_store {
             goto exit;
         }
 
-        if (it->second.row_slice->empty()) {
+        if (it->second.row_slice->empty() && !it->second.no_rows) {
             // No rows in the current selection, create a temporary one containing all
             status = select_rows(key, {0, m - 1});
             if (status != da_status_success) {
@@ -1080,6 +1377,217 @@ class data_store {
         return exit_status;
     }
 
+    /* Expose the selection key as a dense matrix of type T stored in the given order,
+     * e.g. to pass it to an algorithm handle.
+     * Rows containing missing values in the selected columns are skipped.
+     * If the remaining rows and columns form a contiguous part of a single block stored
+     * in the requested order, data points directly into the block and buffer is left
+     * empty. Otherwise, the selection is gathered slice by slice into buffer and data
+     * points to buffer.
+     * If response_col is not negative, rows with a missing value in that column are
+     * skipped as well. It must not be part of the selected columns.
+     * On output:
+     * - n_rows, n_cols: dimensions of the matrix
+     * - data, ld: pointer to the matrix and its leading dimension
+     * - rows_used (optional): row slices of the data store forming the matrix
+     * exit status:
+     * - missing_block, invalid_input, memory_error
+     */
+    template <class T>
+    da_status selection_view(std::string key, da_order order, da_int &n_rows,
+                             da_int &n_cols, const T *&data, da_int &ld,
+                             std::vector<T> &buffer, da_int response_col = -1,
+                             std::vector<interval> *rows_used = nullptr) {
+        da_status status;
+        buffer = std::vector<T>{};
+
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot extract data at this point");
+        // Empty row or column slices select everything
+        std::vector<interval> row_slices, col_slices;
+        status = selection_intervals(key, row_slices, col_slices);
+        if (status != da_status_success)
+            return status;
+
+        // All the selected columns must be of type T
+        n_cols = 0;
+        for (auto &cols : col_slices) {
+            da_int lcol = cols.lower;
+            while (lcol <= cols.upper) {
+                auto it_map = cmap.find(lcol);
+                if (!block_matches<T>(it_map->second->b->btype))
+                    return da_error(err, da_status_invalid_input,
+                                    "Incompatible type in the selection");
+                lcol = it_map->first.upper + 1;
+            }
+            n_cols += cols.upper - cols.lower + 1;
+            if (cols.lower <= response_col && response_col <= cols.upper)
+                return da_error(err, da_status_invalid_input,
+                                "The response column " + std::to_string(response_col) +
+                                    " is part of the selected columns");
+        }
+        if (response_col >= n)
+            return da_error(err, da_status_invalid_input,
+                            "The response column " + std::to_string(response_col) +
+                                " is out of range");
+
+        // Split the row slices around the rows containing missing values
+        std::vector<interval> valid_slices;
+        try {
+            std::vector<bool> valid_rows(m, true);
+            if (!non_missing_types<T>::value) {
+                for (auto &cols : col_slices) {
+                    for (auto &rows : row_slices) {
+                        status = mark_missing_slice(rows, cols, valid_rows);
+                        if (status != da_status_success)
+                            return da_error_trace( // LCOV_EXCL_LINE
+                                err, da_status_internal_error,
+                                "Unexpected error. Possible memory corruption.");
+                    }
+                }
+            }
+            if (response_col >= 0) {
+                for (auto &rows : row_slices) {
+                    status = mark_missing_slice(rows, {response_col, response_col},
+                                                valid_rows);
+                    if (status != da_status_success)
+                        return da_error_trace( // LCOV_EXCL_LINE
+                            err, da_status_internal_error,
+                            "Unexpected error. Possible memory corruption.");
+                }
+            }
+            for (auto &rows : row_slices) {
+                da_int i = rows.lower;
+                while (i <= rows.upper) {
+                    if (!valid_rows[i]) {
+                        i++;
+                        continue;
+                    }
+                    da_int i_start = i;
+                    while (i <= rows.upper && valid_rows[i])
+                        i++;
+                    valid_slices.push_back({i_start, i - 1});
+                }
+            }
+            if (rows_used)
+                *rows_used = valid_slices;
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        n_rows = 0;
+        for (auto &rows : valid_slices)
+            n_rows += rows.upper - rows.lower + 1;
+        if (n_rows == 0)
+            return da_error(err, da_status_invalid_input,
+                            "The selection " + key +
+                                " does not contain any row without missing values");
+
+        // Try to borrow the storage of a single block
+        if (valid_slices.size() == 1 && col_slices.size() == 1) {
+            interval rows = valid_slices[0], cols = col_slices[0];
+            auto it_map = cmap.find(cols.lower);
+            if (cols.upper <= it_map->first.upper) {
+                std::shared_ptr<block_id> bid = it_map->second;
+                da_int first_row_idx = 0;
+                while (first_row_idx + bid->b->m <= rows.lower) {
+                    first_row_idx += bid->b->m;
+                    bid = bid->next;
+                }
+                if (rows.upper < first_row_idx + bid->b->m) {
+                    auto bd = dynamic_cast<block_dense<T> *>(bid->b);
+                    interval block_rows = {rows.lower - first_row_idx,
+                                           rows.upper - first_row_idx};
+                    interval block_cols = {cols.lower - bid->offset,
+                                           cols.upper - bid->offset};
+                    if (bd != nullptr &&
+                        bd->get_dense_view(block_rows, block_cols, order, data, ld) ==
+                            da_status_success)
+                        return da_status_success;
+                }
+            }
+        }
+
+        // Gather the selection, one slice of a block at a time
+        try {
+            buffer.resize(n_rows * n_cols);
+        } catch (std::bad_alloc const &) {
+            return da_error(err, da_status_memory_error, "Memory allocation error");
+        }
+        da_int idx_col = 0;
+        for (auto &cols : col_slices) {
+            da_int idx = idx_col * n_rows;
+            for (auto &rows : valid_slices) {
+                status = extract_slice(rows, cols, n_rows, idx, buffer.data());
+                if (status != da_status_success)
+                    return status; // LCOV_EXCL_LINE
+                idx += rows.upper - rows.lower + 1;
+            }
+            idx_col += cols.upper - cols.lower + 1;
+        }
+        if (order == row_major) {
+            std::vector<T> col_major;
+            try {
+                col_major = buffer;
+            } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+                return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                                "Memory allocation error");
+            }
+            for (da_int i = 0; i < n_rows; i++)
+                for (da_int j = 0; j < n_cols; j++)
+                    buffer[j + i * n_cols] = col_major[i + j * n_rows];
+            ld = n_cols;
+        } else {
+            ld = n_rows;
+        }
+        data = buffer.data();
+        return da_status_success;
+    }
+
+    /* Gather column idx over the given row slices into col, converting the values to T.
+     * Columns of type T, da_int and categorical columns (their codes) are accepted.
+     * exit status:
+     * - invalid_input, memory_error
+     */
+    template <class T>
+    da_status extract_rows_column(da_int idx, const std::vector<interval> &row_slices,
+                                  std::vector<T> &col) {
+        block_type btype = column_type(idx);
+        bool as_int = !block_matches<T>(btype) && block_matches<da_int>(btype);
+        if (!block_matches<T>(btype) && !as_int)
+            return da_error(err, da_status_invalid_input,
+                            "Column " + std::to_string(idx) +
+                                " does not have a compatible type");
+        da_int n_rows = 0;
+        for (auto &rows : row_slices)
+            n_rows += rows.upper - rows.lower + 1;
+        std::vector<da_int> icol;
+        try {
+            col.resize(n_rows);
+            if (as_int)
+                icol.resize(n_rows);
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        da_int i = 0;
+        for (auto &rows : row_slices) {
+            da_status status =
+                as_int ? extract_slice(rows, {idx, idx}, n_rows, i, icol.data())
+                       : extract_slice(rows, {idx, idx}, n_rows, i, col.data());
+            if (status != da_status_success)
+                return status; // LCOV_EXCL_LINE
+            i += rows.upper - rows.lower + 1;
+        }
+        if (as_int) {
+            for (i = 0; i < n_rows; i++)
+                col[i] = (T)icol[i];
+        }
+        return da_status_success;
+    }
+
     /* From a given selection remove all rows that have missing data in it.
      * Input:
      * - key: name of the selection. If the key is not already present in the map, all rows will be considered
@@ -1108,7 +1616,7 @@ class data_store {
 
         std::unique_ptr<interval_set> &col_slice = it->second.col_slice;
         std::unique_ptr<interval_set> &row_slice = it->second.row_slice;
-        if (row_slice->empty()) {
+        if (row_slice->empty() && !it->second.no_rows) {
             select_rows(key, {0, m - 1});
         }
 
@@ -1273,7 +1781,7 @@ class data_store {
                             "Couldn't find the element");
 
         std::shared_ptr<block_id> bid = it->second;
-        if (bid->b->btype != get_block_type<T>())
+        if (!block_matches<T>(bid->b->btype))
             return da_error(err, da_status_invalid_input, "Incompatible types");
 
         da_int offset = 0;
@@ -1312,8 +1820,17 @@ class data_store {
                             "Couldn't find the element");
 
         std::shared_ptr<block_id> bid = it->second;
-        if (bid->b->btype != get_block_type<T>())
+        if (!block_matches<T>(bid->b->btype))
             return da_error(err, da_status_invalid_input, "Incompatible types");
+        if constexpr (std::is_same_v<T, da_int>) {
+            if (bid->b->btype == block_cat) {
+                da_int n_cat = static_cast<block_dict *>(bid->b)->n_categories();
+                if ((elem < 0 || elem >= n_cat) && !is_missing_value(elem))
+                    return da_error(err, da_status_invalid_input,
+                                    "Invalid code for a categorical column: " +
+                                        std::to_string(elem));
+            }
+        }
 
         da_int offset = 0;
         while (i >= bid->b->m + offset) {
@@ -1332,6 +1849,450 @@ class data_store {
         return da_status_success;
     }
 
+    /* Predicate selection methods */
+
+    /* Combine the rows of the selection key with the rows where column idx satisfies the
+     * predicate op, using a logical AND (intersection) or OR (union). Missing values
+     * never satisfy a predicate.
+     * If key does not exist, it is created with all the rows for an AND and with no rows
+     * for an OR. An existing but empty row set is also treated as all the rows for an AND
+     * and as no rows for an OR.
+     * exit status:
+     * - invalid_input: wrong column index, type, operator or number of values
+     * - missing_block, memory_error
+     */
+    template <class T>
+    da_status select_where(std::string key, da_int idx, da_predicate op,
+                           da_int n_values, const T *values,
+                           da_selection_combine combine) {
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot select elements at this time");
+        if (idx < 0 || idx >= n)
+            return da_error(err, da_status_invalid_input,
+                            "idx = " + std::to_string(idx) +
+                                ". It must be set between 0 and " +
+                                std::to_string(n - 1) + ".");
+        if (!block_matches<T>(column_type(idx)))
+            return da_error(err, da_status_invalid_input,
+                            "Column " + std::to_string(idx) +
+                                " is not of the type of the predicate values");
+        da_int n_expected = op == da_pred_between ? 2 : 1;
+        if (op < da_pred_equal || op > da_pred_in)
+            return da_error(err, da_status_invalid_input, "Unknown predicate operator");
+        if (op == da_pred_in ? n_values < 1 : n_values != n_expected)
+            return da_error(err, da_status_invalid_input,
+                            "n_values = " + std::to_string(n_values) + ". It must be " +
+                                (op == da_pred_in ? std::string("at least 1")
+                                                  : std::to_string(n_expected)) +
+                                " for this predicate.");
+        if (combine != da_select_and && combine != da_select_or)
+            return da_error(err, da_status_invalid_input, "Unknown combine operator");
+
+        std::vector<T> vals;
+        try {
+            vals.assign(values, values + n_values);
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        if (op == da_pred_in)
+            std::sort(vals.begin(), vals.end());
+        return apply_predicate(key, idx, op, vals, combine);
+    }
+
+    /* Predicates on the string values of the categorical column idx: only equality,
+     * inequality and IN-sets are supported. The values are looked up once in the
+     * dictionary and the rows are filtered by comparing the integer codes.
+     */
+    da_status select_where_categorical(std::string key, da_int idx, da_predicate op,
+                                       da_int n_values, const char *const *values,
+                                       da_selection_combine combine) {
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot select elements at this time");
+        block_dict *bd;
+        da_status status = get_categorical_column(idx, bd);
+        if (status != da_status_success)
+            return status;
+        if (op != da_pred_equal && op != da_pred_not_equal && op != da_pred_in)
+            return da_error(err, da_status_invalid_input,
+                            "Only equality, inequality and IN-set predicates are "
+                            "supported on categorical columns");
+        if (op == da_pred_in ? n_values < 1 : n_values != 1)
+            return da_error(err, da_status_invalid_input,
+                            "n_values = " + std::to_string(n_values) + ". It must be " +
+                                (op == da_pred_in ? "at least 1" : "1") +
+                                " for this predicate.");
+        if (combine != da_select_and && combine != da_select_or)
+            return da_error(err, da_status_invalid_input, "Unknown combine operator");
+
+        // Labels missing from the dictionary are given the code -1, which no row holds
+        std::vector<da_int> codes;
+        try {
+            for (da_int k = 0; k < n_values; k++) {
+                if (values[k] == nullptr)
+                    return da_error(err, da_status_invalid_input,
+                                    "The predicate values have to be defined");
+                da_int code = bd->find_category(values[k]);
+                if (op != da_pred_in || code >= 0)
+                    codes.push_back(code);
+            }
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        std::sort(codes.begin(), codes.end());
+        return apply_predicate(key, idx, op, codes, combine);
+    }
+
+    /* Contiguous or strided piece of a column on which a predicate is evaluated */
+    template <class T> struct column_chunk {
+        da_int first_row, len;
+        const T *data;
+        da_int stride;
+    };
+
+    template <class T>
+    da_status apply_predicate(std::string &key, da_int idx, da_predicate op,
+                              std::vector<T> &vals, da_selection_combine combine) {
+        // Chunks of rows evaluated independently by the threads
+        const da_int chunk_size = 16384;
+        bool and_op = combine == da_select_and;
+        std::vector<uint8_t> sel;
+        std::vector<column_chunk<T>> chunks;
+        auto it = selections.find(key);
+        try {
+            sel.resize(m, 0);
+            if (it != selections.end() &&
+                (!it->second.row_slice->empty() || it->second.no_rows)) {
+                for (auto it_row = it->second.row_slice->begin();
+                     it_row != it->second.row_slice->end(); ++it_row)
+                    std::fill(&sel[it_row->lower], &sel[it_row->upper] + 1, 1);
+            } else if (and_op) {
+                std::fill(sel.begin(), sel.end(), 1);
+            }
+
+            // Split every row block of the column into chunks
+            da_int lb, ub, first_row = 0;
+            std::shared_ptr<block_id> bid;
+            cmap.find(idx, bid, lb, ub);
+            while (bid != nullptr && first_row < m) {
+                T *c;
+                da_int stride;
+                block_base<T> *bb = static_cast<block_base<T> *>(bid->b);
+                if (bb->get_col(idx - bid->offset, &c, stride) != da_status_success)
+                    return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
+                                    "Unexpected error. Possible memory corruption.");
+                for (da_int i = 0; i < bid->b->m; i += chunk_size)
+                    chunks.push_back({first_row + i, std::min(chunk_size, bid->b->m - i),
+                                      &c[i * stride], stride});
+                first_row += bid->b->m;
+                bid = bid->next;
+            }
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+
+        da_int n_chunks = (da_int)chunks.size();
+#pragma omp parallel for schedule(dynamic) default(none)                                 \
+    shared(n_chunks, chunks, op, vals, and_op, sel) if (n_chunks > 1)
+        for (da_int k = 0; k < n_chunks; k++) {
+            const column_chunk<T> &ch = chunks[k];
+            filter_rows(op, vals, ch.len, ch.data, ch.stride, and_op, &sel[ch.first_row]);
+        }
+
+        // Store the matching rows as intervals
+        if (it == selections.end()) {
+            da_status status = select_rows(key, {0, m - 1});
+            if (status != da_status_success)
+                return status; // LCOV_EXCL_LINE
+            it = selections.find(key);
+        }
+        interval_set &row_slice = *it->second.row_slice;
+        row_slice.clear();
+        try {
+            da_int i = 0;
+            while (i < m) {
+                if (!sel[i]) {
+                    i++;
+                    continue;
+                }
+                da_int i_start = i;
+                while (i < m && sel[i])
+                    i++;
+                row_slice.append({i_start, i - 1});
+            }
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        it->second.no_rows = row_slice.empty();
+        return da_status_success;
+    }
+
+    /* Categorical columns methods */
+
+    /* Add nc dictionary-encoded columns of mc C strings to the right of the data_store.
+     * Each column gets its own dictionary, the columns are encoded in parallel.
+     * exit status:
+     * - invalid_input, missing_block, memory_error
+     */
+    da_status concatenate_categorical(da_int mc, da_int nc, const char *const *data,
+                                      da_order order) {
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot concatenate columns at this point");
+        if (mc <= 0)
+            return da_error(err, da_status_invalid_input,
+                            "Number of rows must be positive");
+        if (nc <= 0)
+            return da_error(err, da_status_invalid_input,
+                            "Number of columns must be positive");
+        if (m > 0 && m != mc)
+            return da_error(err, da_status_invalid_input,
+                            "Number of rows must match " + std::to_string(m) +
+                                " (input: " + std::to_string(mc) + ")");
+
+        std::vector<da_int *> codes;
+        std::vector<std::shared_ptr<std::vector<std::string>>> dicts;
+        da_int threading_error = 0;
+        try {
+            codes.resize(nc, nullptr);
+            dicts.resize(nc);
+            for (da_int j = 0; j < nc; j++) {
+                codes[j] = new da_int[mc];
+                dicts[j] = std::make_shared<std::vector<std::string>>();
+            }
+        } catch (std::bad_alloc &) { // LCOV_EXCL_LINE
+            threading_error = 1;     // LCOV_EXCL_LINE
+        }
+
+        if (threading_error == 0) {
+#pragma omp parallel for schedule(dynamic) default(none)                                 \
+    shared(mc, nc, data, order, codes, dicts, threading_error) if (nc > 1)
+            for (da_int j = 0; j < nc; j++) {
+                const char *const *col = order == column_major ? &data[j * mc] : &data[j];
+                da_int stride = order == column_major ? 1 : nc;
+                try {
+                    encode_categories(mc, col, stride, codes[j], *dicts[j]);
+                } catch (std::bad_alloc &) { // LCOV_EXCL_LINE
+#pragma omp atomic write
+                    threading_error = 1; // LCOV_EXCL_LINE
+                }
+            }
+        }
+
+        da_int j = 0;
+        try {
+            for (; j < nc && threading_error == 0; j++) {
+                auto new_block = std::make_shared<block_id>(block_id());
+                new_block->b = new block_dict(mc, codes[j], *this->err, dicts[j]);
+                new_block->offset = n;
+                index_to_name.resize(n + 1, nullptr);
+                cmap.insert(interval(n, n), new_block);
+                if (m == 0)
+                    m = mc;
+                n++;
+            }
+        } catch (std::bad_alloc &) { // LCOV_EXCL_LINE
+            threading_error = 1;     // LCOV_EXCL_LINE
+        }
+        if (threading_error != 0) {
+            // LCOV_EXCL_START
+            for (; j < nc; j++)
+                delete[] codes[j];
+            return da_error(err, da_status_memory_error, "Memory allocation error");
+            // LCOV_EXCL_STOP
+        }
+        return da_status_success;
+    }
+
+    /* Add a categorical column from existing codes and dictionary; codes is owned by the
+     * data_store on success.
+     */
+    da_status concatenate_categorical(da_int mc, da_int *codes,
+                                      std::shared_ptr<std::vector<std::string>> dict) {
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot concatenate columns at this point");
+        if (mc <= 0 || (m > 0 && m != mc))
+            return da_error(err, da_status_invalid_input,
+                            "Number of rows must match " + std::to_string(m) +
+                                " (input: " + std::to_string(mc) + ")");
+        try {
+            auto new_block = std::make_shared<block_id>(block_id());
+            new_block->b = new block_dict(mc, codes, *this->err, dict);
+            new_block->offset = n;
+            index_to_name.resize(n + 1, nullptr);
+            cmap.insert(interval(n, n), new_block);
+        } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        if (m == 0)
+            m = mc;
+        n++;
+        return da_status_success;
+    }
+
+    /* Get the dictionary-encoded block of column idx
+     * exit status:
+     * - invalid_input: idx is out of range or the column is not categorical
+     */
+    da_status get_categorical_column(da_int idx, block_dict *&bd) {
+        if (idx < 0 || idx >= n)
+            return da_error(err, da_status_invalid_input,
+                            "idx = " + std::to_string(idx) +
+                                ". It must be set between 0 and " +
+                                std::to_string(n - 1) + ".");
+        block *b = cmap.find(idx)->second->b;
+        if (b->btype != block_cat)
+            return da_error(err, da_status_invalid_input,
+                            "Column " + std::to_string(idx) + " is not categorical");
+        bd = static_cast<block_dict *>(b);
+        return da_status_success;
+    }
+
+    /* Remove from the selection key all the rows where the categorical column idx is not
+     * equal to label. If key does not exist, it is created with all the matching rows.
+     */
+    da_status select_category(std::string key, da_int idx, std::string label) {
+        const char *value = label.c_str();
+        return select_where_categorical(key, idx, da_pred_equal, 1, &value,
+                                        da_select_and);
+    }
+
+    /* Extract the selection key (all the data if key is empty) as a feature matrix of
+     * type T, where the columns of type T are copied and the categorical columns are
+     * replaced by their codes, as expected by the decision trees and forests.
+     * On output, categorical_features[j] contains the number of categories of column j
+     * of the selection, or 0 if it is not categorical. Missing codes are set to NaN.
+     */
+    template <class T>
+    da_status extract_categorical_features(std::string key, da_order order, da_int ld,
+                                           T *data, da_int *categorical_features) {
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot extract data at this point");
+        da_status status;
+        std::vector<interval> row_slices, col_slices;
+        if (key.empty()) {
+            row_slices.push_back({0, m - 1});
+            col_slices.push_back({0, n - 1});
+        } else {
+            status = selection_intervals(key, row_slices, col_slices);
+            if (status != da_status_success)
+                return status;
+        }
+        da_int n_rows = 0, n_cols = 0;
+        for (auto &rows : row_slices)
+            n_rows += rows.upper - rows.lower + 1;
+        for (auto &cols : col_slices)
+            n_cols += cols.upper - cols.lower + 1;
+        if (ld < (order == column_major ? n_rows : n_cols))
+            return da_error(err, da_status_invalid_leading_dimension,
+                            "The leading dimension is too small for the selection");
+
+        std::vector<T> values;
+        try {
+            values.resize(n_rows);
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        da_int j = 0;
+        for (auto &cols : col_slices) {
+            for (da_int col = cols.lower; col <= cols.upper; col++, j++) {
+                block_type btype = column_type(col);
+                if (btype != block_cat && btype != get_block_type<T>())
+                    return da_error(err, da_status_invalid_input,
+                                    "Column " + std::to_string(col) +
+                                        " is neither categorical nor of the requested "
+                                        "floating point type");
+                da_int stride_i = order == column_major ? 1 : ld;
+                T *dcol = order == column_major ? &data[j * ld] : &data[j];
+                da_int i = 0;
+                if (btype == block_cat) {
+                    block_dict *bd = static_cast<block_dict *>(cmap.find(col)->second->b);
+                    const da_int *codes = bd->codes();
+                    categorical_features[j] = bd->n_categories();
+                    for (auto &rows : row_slices) {
+                        for (da_int r = rows.lower; r <= rows.upper; r++, i++) {
+                            da_int c = codes[r];
+                            dcol[i * stride_i] = is_missing_value(c)
+                                                     ? std::numeric_limits<T>::quiet_NaN()
+                                                     : (T)c;
+                        }
+                    }
+                } else {
+                    categorical_features[j] = 0;
+                    for (auto &rows : row_slices) {
+                        status =
+                            extract_slice(rows, {col, col}, n_rows, i, values.data());
+                        if (status != da_status_success)
+                            return status; // LCOV_EXCL_LINE
+                        i += rows.upper - rows.lower + 1;
+                    }
+                    for (i = 0; i < n_rows; i++)
+                        dcol[i * stride_i] = values[i];
+                }
+            }
+        }
+        return da_status_success;
+    }
+
+    /* One-hot encode the categorical column idx over the rows of the selection key (all
+     * the rows if key is empty) into the n_rows x n_categories matrix data.
+     * Rows with a missing code are set to 0.
+     */
+    template <class T>
+    da_status extract_one_hot(std::string key, da_int idx, da_order order, da_int ld,
+                              T *data) {
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot extract data at this point");
+        block_dict *bd;
+        da_status status = get_categorical_column(idx, bd);
+        if (status != da_status_success)
+            return status;
+        std::vector<interval> row_slices, col_slices;
+        if (key.empty()) {
+            row_slices.push_back({0, m - 1});
+        } else {
+            status = selection_intervals(key, row_slices, col_slices);
+            if (status != da_status_success)
+                return status;
+        }
+        da_int n_rows = 0, n_cat = bd->n_categories();
+        for (auto &rows : row_slices)
+            n_rows += rows.upper - rows.lower + 1;
+        if (ld < (order == column_major ? n_rows : n_cat))
+            return da_error(err, da_status_invalid_leading_dimension,
+                            "The leading dimension is too small for the one-hot matrix");
+
+        const da_int *codes = bd->codes();
+        da_int stride_i = order == column_major ? 1 : ld;
+        da_int stride_j = order == column_major ? ld : 1;
+        da_int i = 0;
+        for (auto &rows : row_slices) {
+            for (da_int r = rows.lower; r <= rows.upper; r++, i++) {
+                for (da_int k = 0; k < n_cat; k++)
+                    data[i * stride_i + k * stride_j] = (T)0;
+                if (codes[r] >= 0 && codes[r] < n_cat)
+                    data[i * stride_i + codes[r] * stride_j] = (T)1;
+            }
+        }
+        return da_status_success;
+    }
+
     /* Column tags methods */
     da_status label_column(std::string label, da_int idx) {
         if (idx < 0 || idx >= n)
@@ -1425,6 +2386,20 @@ class data_store {
         }
 
         ncols = end_column - start_column + 1;
+        if constexpr (std::is_same_v<T, char **>) {
+            if (csv->categorical_strings) {
+                // Dictionary-encode the string columns instead of storing each cell
+                char **strings = *bl;
+                free(bl);
+                bl = nullptr;
+                status = concatenate_categorical(nrows, ncols, strings, column_major);
+                da_csv::free_data(&strings, nrows * ncols);
+                if (status != da_status_success)
+                    return da_error_trace(err, status, // LCOV_EXCL_LINE
+                                          "Unexpected error in encoding columns");
+                return da_status_success;
+            }
+        }
         status = concatenate_cols_csv(nrows, ncols, bl, column_major, false, C_data);
         if (status != da_status_success) {
             // LCOV_EXCL_START
@@ -1555,8 +2530,18 @@ class data_store {
                 err, exit_status,
                 "Parsing error, Consult error trace for further details");
         }
-        status = concatenate_columns(nrows, ncols, data, csv->order, copy_data, own_data,
-                                     C_data);
+        if constexpr (std::is_same_v<T, char *>) {
+            if (csv->categorical_strings) {
+                status = concatenate_categorical(nrows, ncols, data, csv->order);
+                free_data(&data, nrows * ncols);
+            } else {
+                status = concatenate_columns(nrows, ncols, data, csv->order, copy_data,
+                                             own_data, C_data);
+            }
+        } else {
+            status = concatenate_columns(nrows, ncols, data, csv->order, copy_data,
+                                         own_data, C_data);
+        }
         if (status != da_status_success)
             return da_error_trace(err, da_status_internal_error, // LCOV_EXCL_LINE
                                   "Failed concatenation.");
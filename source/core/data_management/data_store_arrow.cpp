@@ -0,0 +1,812 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/* Import and export of data store columns through the Apache Arrow C data interface.
+ * The interface only consists of the two C structures ArrowSchema and ArrowArray
+ * defined in aoclda_datastore.h, no Arrow library is needed.
+ */
+
+#include "aoclda.h"
+#include "da_datastore.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace da_data {
+
+namespace arrow {
+
+/* Check if the element k (physical index, offset included) of an array is valid */
+inline bool is_valid(const ArrowArray *array, int64_t k) {
+    if (array->null_count == 0 || array->n_buffers < 1 || array->buffers[0] == nullptr)
+        return true;
+    const uint8_t *validity = static_cast<const uint8_t *>(array->buffers[0]);
+    return (validity[k / 8] >> (k % 8)) & 1;
+}
+
+/* Check if any of the elements [k0, k0+len-1] of an array are null */
+inline bool has_nulls(const ArrowArray *array, int64_t k0, int64_t len) {
+    if (array->null_count == 0 || array->n_buffers < 1 || array->buffers[0] == nullptr)
+        return false;
+    for (int64_t k = k0; k < k0 + len; k++) {
+        if (!is_valid(array, k))
+            return true;
+    }
+    return false;
+}
+
+inline bool is_integer_format(const char *fmt) {
+    return fmt != nullptr && std::strlen(fmt) == 1 && std::strchr("cCsSiIlL", fmt[0]);
+}
+
+/* Read the element k of an integer buffer described by the Arrow format character.
+ * Returns false if the value does not fit into a da_int.
+ */
+inline bool read_integer(char fmt, const void *buf, int64_t k, da_int &val) {
+    int64_t v = 0;
+    switch (fmt) {
+    case 'c':
+        v = static_cast<const int8_t *>(buf)[k];
+        break;
+    case 'C':
+        v = static_cast<const uint8_t *>(buf)[k];
+        break;
+    case 's':
+        v = static_cast<const int16_t *>(buf)[k];
+        break;
+    case 'S':
+        v = static_cast<const uint16_t *>(buf)[k];
+        break;
+    case 'i':
+        v = static_cast<const int32_t *>(buf)[k];
+        break;
+    case 'I':
+        v = static_cast<const uint32_t *>(buf)[k];
+        break;
+    case 'l':
+        v = static_cast<const int64_t *>(buf)[k];
+        break;
+    case 'L': {
+        uint64_t u = static_cast<const uint64_t *>(buf)[k];
+        if (u > (uint64_t)std::numeric_limits<int64_t>::max())
+            return false;
+        v = (int64_t)u;
+        break;
+    }
+    default:
+        return false; // LCOV_EXCL_LINE
+    }
+    if (v < (int64_t)std::numeric_limits<da_int>::min() ||
+        v > (int64_t)std::numeric_limits<da_int>::max())
+        return false;
+    val = (da_int)v;
+    return true;
+}
+
+/* Get the element k of a utf8 ("u") or large utf8 ("U") array */
+inline void read_string(const ArrowArray *array, bool large, int64_t k, const char *&str,
+                        int64_t &len) {
+    const char *chars = static_cast<const char *>(array->buffers[2]);
+    int64_t start, end;
+    if (large) {
+        const int64_t *offsets = static_cast<const int64_t *>(array->buffers[1]);
+        start = offsets[k];
+        end = offsets[k + 1];
+    } else {
+        const int32_t *offsets = static_cast<const int32_t *>(array->buffers[1]);
+        start = offsets[k];
+        end = offsets[k + 1];
+    }
+    str = chars + start;
+    len = end - start;
+}
+
+template <class T> T missing_value() {
+    if constexpr (std::is_floating_point_v<T>)
+        return std::numeric_limits<T>::quiet_NaN();
+    else
+        return std::numeric_limits<T>::max();
+}
+
+/* Add a column of m elements to ds, data is released on failure if it is owned */
+template <class T>
+da_status add_column(data_store &ds, da_int m, T *data, bool owned, bool C_data = false) {
+    da_status status =
+        ds.concatenate_columns(m, 1, data, column_major, false, owned, C_data);
+    if (status != da_status_success && owned) {
+        // LCOV_EXCL_START
+        if (C_data)
+            da_csv::free_data(&data, m);
+        else
+            delete[] data;
+        // LCOV_EXCL_STOP
+    }
+    return status;
+}
+
+/* Primitive column matching a data store type: used in place if it has no null entry */
+template <class T>
+da_status import_primitive(data_store &ds, da_errors::da_error_t *err,
+                           const ArrowArray *array, int64_t k0, da_int m,
+                           bool &borrowed) {
+    const T *values = static_cast<const T *>(array->buffers[1]);
+    if (values == nullptr)
+        return da_error(err, da_status_invalid_input, "Arrow data buffer is missing");
+    if (!has_nulls(array, k0, m)) {
+        borrowed = true;
+        return add_column(ds, m, const_cast<T *>(values + k0), false);
+    }
+    T *data;
+    try {
+        data = new T[m];
+    } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    for (da_int i = 0; i < m; i++)
+        data[i] = is_valid(array, k0 + i) ? values[k0 + i] : missing_value<T>();
+    return add_column(ds, m, data, true);
+}
+
+/* Integer column of another width or signedness than da_int: converted */
+inline da_status import_integer(data_store &ds, da_errors::da_error_t *err,
+                                const ArrowArray *array, char fmt, int64_t k0,
+                                da_int m) {
+    if (array->buffers[1] == nullptr)
+        return da_error(err, da_status_invalid_input, "Arrow data buffer is missing");
+    da_int *data;
+    try {
+        data = new da_int[m];
+    } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    for (da_int i = 0; i < m; i++) {
+        if (!is_valid(array, k0 + i)) {
+            data[i] = missing_value<da_int>();
+        } else if (!read_integer(fmt, array->buffers[1], k0 + i, data[i])) {
+            delete[] data;
+            return da_error(err, da_status_invalid_input,
+                            "Arrow integer value out of the range of da_int");
+        }
+    }
+    return add_column(ds, m, data, true);
+}
+
+/* Bit-packed boolean column: converted to uint8 */
+inline da_status import_boolean(data_store &ds, da_errors::da_error_t *err,
+                                const ArrowArray *array, int64_t k0, da_int m) {
+    const uint8_t *bits = static_cast<const uint8_t *>(array->buffers[1]);
+    if (bits == nullptr)
+        return da_error(err, da_status_invalid_input, "Arrow data buffer is missing");
+    uint8_t *data;
+    try {
+        data = new uint8_t[m];
+    } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    for (da_int i = 0; i < m; i++) {
+        int64_t k = k0 + i;
+        data[i] = is_valid(array, k) ? (bits[k / 8] >> (k % 8)) & 1
+                                     : missing_value<uint8_t>();
+    }
+    return add_column(ds, m, data, true);
+}
+
+/* Plain string column: converted to C strings */
+inline da_status import_strings(data_store &ds, da_errors::da_error_t *err,
+                                const ArrowArray *array, bool large, int64_t k0,
+                                da_int m) {
+    if (array->n_buffers < 3 || array->buffers[1] == nullptr ||
+        (array->buffers[2] == nullptr && array->length > 0))
+        return da_error(err, da_status_invalid_input, "Arrow string buffers are missing");
+
+    char **data = static_cast<char **>(calloc(m, sizeof(char *)));
+    if (data == nullptr)
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    for (da_int i = 0; i < m; i++) {
+        const char *str = "";
+        int64_t len = 0;
+        if (is_valid(array, k0 + i))
+            read_string(array, large, k0 + i, str, len);
+        data[i] = static_cast<char *>(malloc(len + 1));
+        if (data[i] == nullptr) {
+            da_csv::free_data(&data, m);                 // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        std::memcpy(data[i], str, len);
+        data[i][len] = '\0';
+    }
+    return add_column(ds, m, data, true, true);
+}
+
+/* Dictionary-encoded string column: array holds the indices (of format fmt) and dict
+ * the string values. It is imported as a categorical column whose dictionary is a copy
+ * of dict and whose codes are the Arrow indices; null entries get the missing code.
+ */
+inline da_status import_dictionary(data_store &ds, da_errors::da_error_t *err,
+                                   const ArrowArray *array, const ArrowArray *dict,
+                                   char fmt, bool large, int64_t k0, da_int m) {
+    if (dict->n_buffers < 3 || dict->buffers[1] == nullptr ||
+        (dict->buffers[2] == nullptr && dict->length > 0))
+        return da_error(err, da_status_invalid_input, "Arrow string buffers are missing");
+    if (array->buffers[1] == nullptr)
+        return da_error(err, da_status_invalid_input, "Arrow index buffer is missing");
+
+    std::shared_ptr<std::vector<std::string>> dictionary;
+    da_int *codes;
+    try {
+        dictionary = std::make_shared<std::vector<std::string>>();
+        dictionary->reserve(dict->length);
+        for (int64_t k = dict->offset; k < dict->offset + dict->length; k++) {
+            const char *str = "";
+            int64_t len = 0;
+            if (is_valid(dict, k))
+                read_string(dict, large, k, str, len);
+            dictionary->emplace_back(str, len);
+        }
+        codes = new da_int[m];
+    } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    for (da_int i = 0; i < m; i++) {
+        if (!is_valid(array, k0 + i)) {
+            codes[i] = missing_value<da_int>();
+            continue;
+        }
+        if (!read_integer(fmt, array->buffers[1], k0 + i, codes[i]) || codes[i] < 0 ||
+            codes[i] >= dict->length) {
+            delete[] codes;
+            return da_error(err, da_status_invalid_input,
+                            "Arrow dictionary index out of range");
+        }
+    }
+    da_status status = ds.concatenate_categorical(m, codes, dictionary);
+    if (status != da_status_success)
+        delete[] codes; // LCOV_EXCL_LINE
+    return status;
+}
+
+/* Add the m elements of array starting at the logical index start as a new column of ds.
+ * borrowed is set to true if the column uses the Arrow memory in place.
+ */
+inline da_status import_column(data_store &ds, da_errors::da_error_t *err,
+                               const ArrowSchema *schema, const ArrowArray *array,
+                               int64_t start, da_int m, bool &borrowed) {
+    const char *fmt = schema->format;
+    if (fmt == nullptr || array->length < start + m)
+        return da_error(err, da_status_invalid_input,
+                        "Arrow column schema and array do not match");
+    int64_t k0 = array->offset + start;
+
+    if (schema->dictionary != nullptr) {
+        const char *dict_fmt = schema->dictionary->format;
+        if (array->dictionary == nullptr || !is_integer_format(fmt) ||
+            dict_fmt == nullptr ||
+            (std::strcmp(dict_fmt, "u") != 0 && std::strcmp(dict_fmt, "U") != 0))
+            return da_error(err, da_status_invalid_input,
+                            "Only dictionary-encoded utf8 string columns with integer "
+                            "indices are supported");
+        return import_dictionary(ds, err, array, array->dictionary, fmt[0],
+                                 dict_fmt[0] == 'U', k0, m);
+    }
+
+    if (std::strlen(fmt) != 1 || array->n_buffers < 2)
+        return da_error(err, da_status_invalid_input,
+                        "Unsupported Arrow format: " + std::string(fmt));
+    switch (fmt[0]) {
+    case 'g':
+        return import_primitive<double>(ds, err, array, k0, m, borrowed);
+    case 'f':
+        return import_primitive<float>(ds, err, array, k0, m, borrowed);
+    case 'C':
+        return import_primitive<uint8_t>(ds, err, array, k0, m, borrowed);
+    case 'i':
+    case 'l':
+        if ((fmt[0] == 'i' && sizeof(da_int) == 4) ||
+            (fmt[0] == 'l' && sizeof(da_int) == 8))
+            return import_primitive<da_int>(ds, err, array, k0, m, borrowed);
+        return import_integer(ds, err, array, fmt[0], k0, m);
+    case 'c':
+    case 's':
+    case 'S':
+    case 'I':
+    case 'L':
+        return import_integer(ds, err, array, fmt[0], k0, m);
+    case 'b':
+        return import_boolean(ds, err, array, k0, m);
+    case 'u':
+    case 'U':
+        return import_strings(ds, err, array, fmt[0] == 'U', k0, m);
+    default:
+        return da_error(err, da_status_invalid_input,
+                        "Unsupported Arrow format: " + std::string(fmt));
+    }
+}
+
+/* Memory owned by an exported array: its buffers, its children and its dictionary */
+struct export_array_data {
+    std::vector<std::vector<uint8_t>> owned;
+    std::vector<const void *> buffers;
+    std::vector<ArrowArray> children;
+    std::vector<ArrowArray *> children_ptr;
+    ArrowArray dictionary{};
+};
+
+struct export_schema_data {
+    std::string format, name;
+    std::vector<ArrowSchema> children;
+    std::vector<ArrowSchema *> children_ptr;
+    ArrowSchema dictionary{};
+};
+
+inline void release_array(ArrowArray *array) {
+    if (array == nullptr || array->release == nullptr)
+        return;
+    for (int64_t i = 0; i < array->n_children; i++) {
+        ArrowArray *child = array->children[i];
+        if (child->release != nullptr)
+            child->release(child);
+    }
+    if (array->dictionary != nullptr && array->dictionary->release != nullptr)
+        array->dictionary->release(array->dictionary);
+    delete static_cast<export_array_data *>(array->private_data);
+    array->release = nullptr;
+}
+
+inline void release_schema(ArrowSchema *schema) {
+    if (schema == nullptr || schema->release == nullptr)
+        return;
+    for (int64_t i = 0; i < schema->n_children; i++) {
+        ArrowSchema *child = schema->children[i];
+        if (child->release != nullptr)
+            child->release(child);
+    }
+    if (schema->dictionary != nullptr && schema->dictionary->release != nullptr)
+        schema->dictionary->release(schema->dictionary);
+    delete static_cast<export_schema_data *>(schema->private_data);
+    schema->release = nullptr;
+}
+
+inline void init_array(ArrowArray &array, int64_t length, export_array_data *data) {
+    array.length = length;
+    array.null_count = 0;
+    array.offset = 0;
+    array.n_buffers = (int64_t)data->buffers.size();
+    array.n_children = 0;
+    array.buffers = data->buffers.data();
+    array.children = nullptr;
+    array.dictionary = nullptr;
+    array.release = release_array;
+    array.private_data = data;
+}
+
+inline void init_schema(ArrowSchema &schema, export_schema_data *data, int64_t flags) {
+    schema.format = data->format.c_str();
+    schema.name = data->name.c_str();
+    schema.metadata = nullptr;
+    schema.flags = flags;
+    schema.n_children = 0;
+    schema.children = nullptr;
+    schema.dictionary = nullptr;
+    schema.release = release_schema;
+    schema.private_data = data;
+}
+
+template <class T> const char *export_format() {
+    if constexpr (std::is_same_v<T, double>)
+        return "g";
+    else if constexpr (std::is_same_v<T, float>)
+        return "f";
+    else if constexpr (std::is_same_v<T, uint8_t>)
+        return "C";
+    else
+        return sizeof(da_int) == 8 ? "l" : "i";
+}
+
+/* Export the rows of column col of ds as a primitive Arrow array, in place when the
+ * rows are contiguous in memory. Missing values are marked as null.
+ */
+template <class T>
+da_status export_primitive(data_store &ds, da_int col, std::vector<interval> &rows,
+                           da_int n_rows, export_array_data &data, int64_t &null_count) {
+    da_status status;
+    const T *values = nullptr;
+    if (rows.size() == 1) {
+        status = ds.column_view(col, rows[0], values);
+        if (status != da_status_success && status != da_status_not_implemented)
+            return status; // LCOV_EXCL_LINE
+        if (status != da_status_success)
+            values = nullptr;
+    }
+    if (values == nullptr) {
+        data.owned.emplace_back(n_rows * sizeof(T));
+        T *buffer = reinterpret_cast<T *>(data.owned.back().data());
+        da_int idx = 0;
+        for (auto &r : rows) {
+            status = ds.extract_slice(r, {col, col}, n_rows, idx, buffer);
+            if (status != da_status_success)
+                return status; // LCOV_EXCL_LINE
+            idx += r.upper - r.lower + 1;
+        }
+        values = buffer;
+    }
+
+    null_count = 0;
+    for (da_int i = 0; i < n_rows; i++) {
+        T val = values[i];
+        if (is_missing_value(val))
+            null_count++;
+    }
+    const void *validity = nullptr;
+    if (null_count > 0) {
+        data.owned.emplace_back((n_rows + 7) / 8, 0);
+        uint8_t *bits = data.owned.back().data();
+        for (da_int i = 0; i < n_rows; i++) {
+            T val = values[i];
+            if (!is_missing_value(val))
+                bits[i / 8] |= (uint8_t)(1 << (i % 8));
+        }
+        validity = bits;
+    }
+    data.buffers = {validity, values};
+    return da_status_success;
+}
+
+/* Copy n C strings into the offsets and characters buffers of a utf8 Arrow array */
+inline da_status pack_strings(da_errors::da_error_t *err, const char *const *strings,
+                              da_int n_rows, export_array_data &data) {
+    int64_t total = 0;
+    for (da_int i = 0; i < n_rows; i++)
+        total += (int64_t)std::strlen(strings[i]);
+    if (total > std::numeric_limits<int32_t>::max())
+        return da_error(err, da_status_invalid_input, // LCOV_EXCL_LINE
+                        "String column too large to be exported");
+
+    data.owned.emplace_back((n_rows + 1) * sizeof(int32_t));
+    int32_t *offsets = reinterpret_cast<int32_t *>(data.owned.back().data());
+    data.owned.emplace_back(std::max(total, (int64_t)1));
+    char *chars = reinterpret_cast<char *>(data.owned.back().data());
+    offsets[0] = 0;
+    for (da_int i = 0; i < n_rows; i++) {
+        size_t len = std::strlen(strings[i]);
+        std::memcpy(chars + offsets[i], strings[i], len);
+        offsets[i + 1] = offsets[i] + (int32_t)len;
+    }
+    data.buffers = {nullptr, offsets, chars};
+    return da_status_success;
+}
+
+/* Export the rows of a string column of ds as a utf8 Arrow array (always copied) */
+inline da_status export_strings(data_store &ds, da_errors::da_error_t *err, da_int col,
+                                std::vector<interval> &rows, da_int n_rows,
+                                export_array_data &data) {
+    da_status status;
+    std::vector<char *> strings(n_rows);
+    da_int idx = 0;
+    for (auto &r : rows) {
+        status = ds.extract_slice(r, {col, col}, n_rows, idx, strings.data());
+        if (status != da_status_success)
+            return status; // LCOV_EXCL_LINE
+        idx += r.upper - r.lower + 1;
+    }
+    return pack_strings(err, strings.data(), n_rows, data);
+}
+
+/* Export the rows of a categorical column of ds as a dictionary-encoded utf8 Arrow
+ * array: the codes are exported as the indices and the dictionary is always copied.
+ */
+inline da_status export_categorical(data_store &ds, da_errors::da_error_t *err,
+                                    da_int col, std::vector<interval> &rows,
+                                    da_int n_rows, export_array_data &array_data,
+                                    export_schema_data &schema_data,
+                                    int64_t &null_count) {
+    block_dict *bd;
+    da_status status = ds.get_categorical_column(col, bd);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+    status = export_primitive<da_int>(ds, col, rows, n_rows, array_data, null_count);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+
+    const std::vector<std::string> &dict = bd->get_dictionary();
+    da_int n_cat = (da_int)dict.size();
+    std::vector<const char *> strings(n_cat);
+    for (da_int k = 0; k < n_cat; k++)
+        strings[k] = dict[k].c_str();
+    auto dict_array = std::make_unique<export_array_data>();
+    auto dict_schema = std::make_unique<export_schema_data>();
+    status = pack_strings(err, strings.data(), n_cat, *dict_array);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+    dict_schema->format = "u";
+    init_array(array_data.dictionary, n_cat, dict_array.release());
+    init_schema(schema_data.dictionary, dict_schema.release(), ARROW_FLAG_NULLABLE);
+    return da_status_success;
+}
+
+inline da_status export_column(data_store &ds, da_errors::da_error_t *err, da_int col,
+                               std::vector<interval> &rows, da_int n_rows,
+                               ArrowArray &array, ArrowSchema &schema) {
+    da_status status;
+    auto array_data = std::make_unique<export_array_data>();
+    auto schema_data = std::make_unique<export_schema_data>();
+    int64_t null_count = 0;
+    switch (ds.column_type(col)) {
+    case block_real_d:
+        status = export_primitive<double>(ds, col, rows, n_rows, *array_data, null_count);
+        schema_data->format = export_format<double>();
+        break;
+    case block_real_s:
+        status = export_primitive<float>(ds, col, rows, n_rows, *array_data, null_count);
+        schema_data->format = export_format<float>();
+        break;
+    case block_int:
+        status = export_primitive<da_int>(ds, col, rows, n_rows, *array_data, null_count);
+        schema_data->format = export_format<da_int>();
+        break;
+    case block_bool:
+        status =
+            export_primitive<uint8_t>(ds, col, rows, n_rows, *array_data, null_count);
+        schema_data->format = export_format<uint8_t>();
+        break;
+    case block_char:
+        status = export_strings(ds, err, col, rows, n_rows, *array_data);
+        schema_data->format = "u";
+        break;
+    case block_cat:
+        status = export_categorical(ds, err, col, rows, n_rows, *array_data,
+                                    *schema_data, null_count);
+        schema_data->format = export_format<da_int>();
+        break;
+    default:
+        status = da_error(err, da_status_invalid_input, // LCOV_EXCL_LINE
+                          "Column type cannot be exported to Arrow");
+    }
+    if (status != da_status_success)
+        return status;
+    status = ds.get_col_label(col, schema_data->name);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+
+    bool has_dictionary = array_data->dictionary.release != nullptr;
+    export_array_data *array_ptr = array_data.release();
+    export_schema_data *schema_ptr = schema_data.release();
+    init_array(array, n_rows, array_ptr);
+    array.null_count = null_count;
+    init_schema(schema, schema_ptr, ARROW_FLAG_NULLABLE);
+    if (has_dictionary) {
+        array.dictionary = &array_ptr->dictionary;
+        schema.dictionary = &schema_ptr->dictionary;
+    }
+    return da_status_success;
+}
+
+} // namespace arrow
+
+} // namespace da_data
+
+da_status da_data_load_arrow(da_datastore store, const ArrowSchema *schema,
+                             ArrowArray *array) {
+    using namespace da_data::arrow;
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (!schema || !array)
+        return da_error(store->err, da_status_invalid_input,
+                        "schema and array have to be defined");
+    if (array->release == nullptr)
+        return da_error(store->err, da_status_invalid_input,
+                        "array has already been released");
+    if (schema->format == nullptr)
+        return da_error(store->err, da_status_invalid_input,
+                        "schema format has to be defined");
+
+    // A record batch is loaded column by column, any other array as a single column
+    std::vector<const ArrowSchema *> col_schemas;
+    std::vector<const ArrowArray *> col_arrays;
+    int64_t start = 0;
+    if (std::strcmp(schema->format, "+s") == 0) {
+        if (schema->n_children != array->n_children || array->n_children <= 0)
+            return da_error(store->err, da_status_invalid_input,
+                            "schema and array children do not match");
+        if (has_nulls(array, array->offset, array->length))
+            return da_error(store->err, da_status_invalid_input,
+                            "Null entries in the record batch itself are not supported");
+        start = array->offset;
+        for (int64_t j = 0; j < array->n_children; j++) {
+            col_schemas.push_back(schema->children[j]);
+            col_arrays.push_back(array->children[j]);
+        }
+    } else {
+        col_schemas.push_back(schema);
+        col_arrays.push_back(array);
+    }
+    if (array->length <= 0 || array->length > std::numeric_limits<da_int>::max())
+        return da_error(store->err, da_status_invalid_input,
+                        "Invalid number of rows in the Arrow array: " +
+                            std::to_string(array->length));
+    da_int m = (da_int)array->length;
+    da_data::data_store &ds = *store->store;
+    if (ds.get_num_cols() > 0 && ds.get_num_rows() != m)
+        return da_error(store->err, da_status_invalid_input,
+                        "Number of rows must match " + std::to_string(ds.get_num_rows()) +
+                            " (input: " + std::to_string(m) + ")");
+
+    // Build the new columns in a temporary store so that a failure leaves store unchanged
+    da_status status;
+    da_data::data_store new_cols(*store->err);
+    bool borrowed = false;
+    for (size_t j = 0; j < col_arrays.size(); j++) {
+        status = import_column(new_cols, store->err, col_schemas[j], col_arrays[j], start,
+                               m, borrowed);
+        if (status != da_status_success)
+            return status;
+        if (col_schemas[j]->name != nullptr && col_schemas[j]->name[0] != '\0') {
+            status = new_cols.label_column(col_schemas[j]->name, (da_int)j);
+            if (status != da_status_success)
+                return status; // LCOV_EXCL_LINE
+        }
+    }
+    status = ds.horizontal_concat(new_cols);
+    if (status != da_status_success)
+        return status;
+
+    // Move the array into the store if its memory is used in place, release it otherwise
+    if (borrowed) {
+        std::shared_ptr<void> owner;
+        try {
+            auto release_owner = [](ArrowArray *a) {
+                if (a->release != nullptr)
+                    a->release(a);
+                delete a;
+            };
+            owner = std::shared_ptr<ArrowArray>(new ArrowArray(*array), release_owner);
+        } catch (std::bad_alloc &) {                            // LCOV_EXCL_LINE
+            return da_error(store->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        array->release = nullptr;
+        return ds.keep_alive(owner);
+    }
+    array->release(array);
+    array->release = nullptr;
+    return da_status_success;
+}
+
+da_status da_data_export_arrow(da_datastore store, const char *key, ArrowSchema *schema,
+                               ArrowArray *array) {
+    using namespace da_data::arrow;
+    using da_interval::interval;
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (!schema || !array)
+        return da_error(store->err, da_status_invalid_input,
+                        "schema and array have to be defined");
+
+    da_data::data_store &ds = *store->store;
+    if (ds.has_missing_block())
+        return da_error(store->err, da_status_missing_block,
+                        "Row blocks are not complete, cannot export data at this point");
+    if (ds.get_num_rows() <= 0 || ds.get_num_cols() <= 0)
+        return da_error(store->err, da_status_invalid_input, "The store is empty");
+
+    da_status status;
+    std::vector<interval> rows, cols;
+    try {
+        if (key == nullptr) {
+            rows.push_back({0, ds.get_num_rows() - 1});
+            cols.push_back({0, ds.get_num_cols() - 1});
+        } else {
+            std::string key_str(key);
+            status = ds.selection_intervals(key_str, rows, cols);
+            if (status != da_status_success)
+                return status;
+        }
+    } catch (std::bad_alloc &) {                            // LCOV_EXCL_LINE
+        return da_error(store->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    da_int n_rows = 0, n_cols = 0;
+    for (auto &r : rows)
+        n_rows += r.upper - r.lower + 1;
+    for (auto &c : cols)
+        n_cols += c.upper - c.lower + 1;
+
+    // The parent struct array and schema own their children
+    ArrowArray out_array;
+    ArrowSchema out_schema;
+    try {
+        auto array_data = std::make_unique<export_array_data>();
+        auto schema_data = std::make_unique<export_schema_data>();
+        array_data->buffers = {nullptr};
+        array_data->children.resize(n_cols);
+        array_data->children_ptr.resize(n_cols);
+        schema_data->format = "+s";
+        schema_data->children.resize(n_cols);
+        schema_data->children_ptr.resize(n_cols);
+        for (da_int j = 0; j < n_cols; j++) {
+            array_data->children_ptr[j] = &array_data->children[j];
+            schema_data->children_ptr[j] = &schema_data->children[j];
+        }
+        init_array(out_array, n_rows, array_data.release());
+        init_schema(out_schema, schema_data.release(), 0);
+    } catch (std::bad_alloc &) {                            // LCOV_EXCL_LINE
+        return da_error(store->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    auto array_data = static_cast<export_array_data *>(out_array.private_data);
+    auto schema_data = static_cast<export_schema_data *>(out_schema.private_data);
+    out_array.children = array_data->children_ptr.data();
+    out_schema.children = schema_data->children_ptr.data();
+
+    da_int idx = 0;
+    status = da_status_success;
+    try {
+        for (auto &c : cols) {
+            for (da_int col = c.lower; col <= c.upper; col++) {
+                status = export_column(ds, store->err, col, rows, n_rows,
+                                       array_data->children[idx],
+                                       schema_data->children[idx]);
+                if (status != da_status_success)
+                    break;
+                idx++;
+                out_array.n_children = idx;
+                out_schema.n_children = idx;
+            }
+            if (status != da_status_success)
+                break;
+        }
+    } catch (std::bad_alloc &) {                                // LCOV_EXCL_LINE
+        status = da_error(store->err, da_status_memory_error, // LCOV_EXCL_LINE
+                          "Memory allocation error");
+    }
+    if (status != da_status_success) {
+        release_array(&out_array);
+        release_schema(&out_schema);
+        return status;
+    }
+
+    *array = out_array;
+    *schema = out_schema;
+    return da_status_success;
+}
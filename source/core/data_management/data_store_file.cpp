@@ -0,0 +1,964 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/* Native columnar file format of the data store, written by da_data_save and read by
+ * da_data_load.
+ *
+ * Layout (native byte order):
+ * - header: magic, version, byte order mark, number of rows and columns, number of rows
+ *   per page, offset and size of the directory
+ * - pages: each column is split into pages of at most page_rows rows, stored one column
+ *   after the other; pages start at 8-byte aligned offsets
+ * - directory: for each column its type, label, page descriptors (offset, size, number
+ *   of rows, number of missing values, encoding, min and max of the non-missing values)
+ *   and, for categorical columns, the dictionary
+ *
+ * Pages of fixed width types are either plain or run-length encoded; string pages hold
+ * n+1 offsets followed by the characters. Integers and categorical codes are always
+ * stored on 64 bits so that files can be exchanged between LP64 and ILP64 builds.
+ *
+ * On POSIX systems the file is memory mapped and only the pages of the requested
+ * columns are touched. Plain contiguous pages matching the in-memory representation
+ * are not copied: the data store columns point directly into the mapping, which is kept
+ * alive with the store and materialized lazily by the operating system.
+ */
+
+#include "aoclda.h"
+#include "da_datastore.hpp"
+#include "da_omp.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace da_data {
+
+namespace columnar {
+
+constexpr char magic[8] = {'A', 'O', 'C', 'L', 'D', 'A', 'C', 'F'};
+constexpr uint32_t format_version = 1;
+constexpr uint32_t byte_order_mark = 0x01020304;
+constexpr int64_t default_page_rows = 65536;
+
+/* Column types as stored in the file, independent of the block_type enum */
+enum col_code : int32_t {
+    col_real_d = 0,
+    col_real_s = 1,
+    col_int = 2,
+    col_uint8 = 3,
+    col_string = 4,
+    col_categorical = 5
+};
+
+enum page_encoding : int32_t { encoding_plain = 0, encoding_rle = 1 };
+
+struct file_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    int64_t n_rows;
+    int64_t n_cols;
+    int64_t page_rows;
+    uint64_t dir_offset;
+    uint64_t dir_size;
+};
+
+/* Page statistics are stored as double for real columns and as int64 otherwise */
+union page_stat {
+    double real;
+    int64_t integer;
+};
+
+struct page_info {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    int64_t n_rows = 0;
+    int64_t null_count = 0;
+    int32_t encoding = encoding_plain;
+    page_stat min{0}, max{0};
+};
+
+struct column_info {
+    int32_t type = col_real_d;
+    std::string label;
+    std::vector<page_info> pages;
+    std::shared_ptr<std::vector<std::string>> dictionary;
+};
+
+/* Storage type of the values of each column type */
+template <class T> struct storage {
+    using type = T;
+};
+template <> struct storage<da_int> {
+    using type = int64_t;
+};
+template <class T> using storage_t = typename storage<T>::type;
+
+/* Convert between in-memory and stored values, missing integers map to the maximum of
+ * the destination type
+ */
+template <class S, class T> inline S convert_value(T val) {
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<S, T>) {
+        if (val == std::numeric_limits<T>::max())
+            return std::numeric_limits<S>::max();
+    }
+    return static_cast<S>(val);
+}
+
+/* Buffered writer keeping track of the current file offset */
+class file_writer {
+    std::ofstream file;
+    uint64_t offset = 0;
+
+  public:
+    bool open(const char *filename) {
+        file.open(filename, std::ios::binary | std::ios::trunc);
+        return file.is_open();
+    }
+    uint64_t tell() { return offset; }
+    bool good() { return (bool)file; }
+    void write(const void *data, size_t size) {
+        file.write(static_cast<const char *>(data), size);
+        offset += size;
+    }
+    template <class V> void write_value(V val) { write(&val, sizeof(V)); }
+    void write_string(const std::string &str) {
+        write_value<int64_t>((int64_t)str.size());
+        write(str.data(), str.size());
+    }
+    void align(uint64_t alignment) {
+        const char zeros[8] = {0};
+        while (offset % alignment != 0)
+            write(zeros, 1);
+    }
+    void rewrite_header(const file_header &header) {
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(file_header));
+    }
+};
+
+/* Read-only access to the byte ranges of a file: memory mapped when available, read on
+ * demand otherwise
+ */
+class file_source {
+    std::ifstream file;
+    char *base = nullptr;
+    uint64_t size = 0;
+
+  public:
+    ~file_source() {
+#if !defined(_WIN32)
+        if (base != nullptr)
+            munmap(base, size);
+#endif
+    }
+
+    bool open(const char *filename) {
+#if !defined(_WIN32)
+        int fd = ::open(filename, O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            size = (uint64_t)st.st_size;
+            // Private writable mapping: changes made through the store are not written
+            // back to the file
+            void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED)
+                base = static_cast<char *>(ptr);
+        }
+        ::close(fd);
+        if (base != nullptr)
+            return true;
+#endif
+        file.open(filename, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+            return false;
+        size = (uint64_t)file.tellg();
+        return true;
+    }
+
+    bool mapped() { return base != nullptr; }
+    uint64_t file_size() { return size; }
+
+    /* Pointer to the bytes [offset, offset+len) of the file; they are either mapped or
+     * read into buf. Returns nullptr if the range is out of the file or cannot be read.
+     */
+    const char *bytes(uint64_t offset, uint64_t len, std::vector<char> &buf) {
+        if (offset > size || len > size - offset)
+            return nullptr;
+        if (base != nullptr)
+            return base + offset;
+        buf.resize(len);
+        file.seekg(offset);
+        if (!file.read(buf.data(), len))
+            return nullptr;
+        return buf.data();
+    }
+};
+
+/* Bounds-checked reader of the directory bytes */
+class dir_reader {
+    const char *ptr;
+    uint64_t remaining;
+
+  public:
+    dir_reader(const char *ptr, uint64_t size) : ptr(ptr), remaining(size) {}
+    bool read(void *dst, uint64_t len) {
+        if (len > remaining)
+            return false;
+        std::memcpy(dst, ptr, len);
+        ptr += len;
+        remaining -= len;
+        return true;
+    }
+    template <class V> bool read_value(V &val) { return read(&val, sizeof(V)); }
+    bool read_string(std::string &str) {
+        int64_t len;
+        if (!read_value(len) || len < 0 || (uint64_t)len > remaining)
+            return false;
+        str.assign(ptr, len);
+        ptr += len;
+        remaining -= len;
+        return true;
+    }
+};
+
+/* Number of runs of identical values, compared bitwise so that NaNs form runs too */
+template <class S> int64_t count_runs(const S *vals, int64_t n) {
+    int64_t runs = n > 0 ? 1 : 0;
+    for (int64_t i = 1; i < n; i++) {
+        if (std::memcmp(&vals[i], &vals[i - 1], sizeof(S)) != 0)
+            runs++;
+    }
+    return runs;
+}
+
+/* Write a page of n stored values, run-length encoded (number of runs, run lengths
+ * then run values) if compress is set and it is smaller than the plain encoding
+ */
+template <class S>
+void write_page(file_writer &out, const S *vals, int64_t n, bool compress,
+                page_info &page) {
+    out.align(8);
+    page.offset = out.tell();
+    page.n_rows = n;
+    page.encoding = encoding_plain;
+    int64_t runs = compress ? count_runs(vals, n) : n;
+    if (compress && 8 + runs * (8 + (int64_t)sizeof(S)) < n * (int64_t)sizeof(S)) {
+        page.encoding = encoding_rle;
+        out.write_value<int64_t>(runs);
+        int64_t len = 1;
+        for (int64_t i = 1; i <= n; i++) {
+            if (i == n || std::memcmp(&vals[i], &vals[i - 1], sizeof(S)) != 0) {
+                out.write_value<int64_t>(len);
+                len = 1;
+            } else {
+                len++;
+            }
+        }
+        for (int64_t i = 0; i < n; i++) {
+            if (i == 0 || std::memcmp(&vals[i], &vals[i - 1], sizeof(S)) != 0)
+                out.write_value<S>(vals[i]);
+        }
+    } else {
+        out.write(vals, n * sizeof(S));
+    }
+    page.size = out.tell() - page.offset;
+}
+
+/* Decode a page of n stored values into dst, returns false if the page is corrupted */
+template <class S>
+bool read_page(const char *src, const page_info &page, int64_t n, S *dst) {
+    if (page.encoding == encoding_plain) {
+        if (page.size != (uint64_t)n * sizeof(S))
+            return false;
+        std::memcpy(dst, src, n * sizeof(S));
+        return true;
+    }
+    if (page.encoding != encoding_rle || page.size < sizeof(int64_t))
+        return false;
+    int64_t runs;
+    std::memcpy(&runs, src, sizeof(int64_t));
+    if (runs < 0 || runs > n || page.size != 8 + (uint64_t)runs * (8 + sizeof(S)))
+        return false;
+    const char *lengths = src + 8;
+    const char *values = lengths + runs * 8;
+    int64_t i = 0;
+    for (int64_t r = 0; r < runs; r++) {
+        int64_t len;
+        S val;
+        std::memcpy(&len, lengths + r * 8, sizeof(int64_t));
+        std::memcpy(&val, values + r * sizeof(S), sizeof(S));
+        if (len <= 0 || len > n - i)
+            return false;
+        std::fill(dst + i, dst + i + len, val);
+        i += len;
+    }
+    return i == n;
+}
+
+/* Number of missing values and min/max of the others in a page of stored values */
+template <class S> void page_statistics(const S *vals, int64_t n, page_info &page) {
+    page.null_count = 0;
+    bool first = true;
+    for (int64_t i = 0; i < n; i++) {
+        S val = vals[i];
+        if (is_missing_value(val)) {
+            page.null_count++;
+            continue;
+        }
+        if constexpr (std::is_floating_point_v<S>) {
+            if (first || val < page.min.real)
+                page.min.real = val;
+            if (first || val > page.max.real)
+                page.max.real = val;
+        } else {
+            if (first || (int64_t)val < page.min.integer)
+                page.min.integer = val;
+            if (first || (int64_t)val > page.max.integer)
+                page.max.integer = val;
+        }
+        first = false;
+    }
+}
+
+/* Gather the selected rows of column col of type T into a contiguous buffer; values
+ * points directly into the store when the rows are contiguous in memory
+ */
+template <class T>
+da_status gather_rows(data_store &ds, da_int col, std::vector<interval> &rows,
+                      da_int n_rows, std::vector<T> &buf, const T *&values) {
+    da_status status;
+    values = nullptr;
+    if (rows.size() == 1) {
+        status = ds.column_view(col, rows[0], values);
+        if (status != da_status_success && status != da_status_not_implemented)
+            return status; // LCOV_EXCL_LINE
+        if (status == da_status_success)
+            return status;
+        values = nullptr;
+    }
+    buf.resize(n_rows);
+    da_int idx = 0;
+    for (auto &r : rows) {
+        status = ds.extract_slice(r, {col, col}, n_rows, idx, buf.data());
+        if (status != da_status_success)
+            return status; // LCOV_EXCL_LINE
+        idx += r.upper - r.lower + 1;
+    }
+    values = buf.data();
+    return da_status_success;
+}
+
+/* Write the pages of a fixed width column */
+template <class T>
+da_status write_column(data_store &ds, da_int col, std::vector<interval> &rows,
+                       da_int n_rows, bool compress, file_writer &out,
+                       column_info &info) {
+    using S = storage_t<T>;
+    std::vector<T> buf;
+    const T *values;
+    da_status status = gather_rows(ds, col, rows, n_rows, buf, values);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+    std::vector<S> converted;
+    if constexpr (!std::is_same_v<S, T>) {
+        converted.resize(n_rows);
+        for (da_int i = 0; i < n_rows; i++)
+            converted[i] = convert_value<S>(values[i]);
+    }
+    const S *stored;
+    if constexpr (std::is_same_v<S, T>)
+        stored = values;
+    else
+        stored = converted.data();
+
+    for (int64_t i0 = 0; i0 < n_rows; i0 += default_page_rows) {
+        int64_t n = std::min(default_page_rows, (int64_t)n_rows - i0);
+        page_info page;
+        page_statistics(stored + i0, n, page);
+        write_page(out, stored + i0, n, compress, page);
+        info.pages.push_back(page);
+    }
+    return da_status_success;
+}
+
+/* Write the pages of a string column: n+1 offsets followed by the characters */
+inline da_status write_strings(data_store &ds, da_int col, std::vector<interval> &rows,
+                               da_int n_rows, file_writer &out, column_info &info) {
+    std::vector<char *> buf;
+    char *const *strings;
+    da_status status = gather_rows(ds, col, rows, n_rows, buf, strings);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+    std::vector<uint64_t> offsets;
+    for (int64_t i0 = 0; i0 < n_rows; i0 += default_page_rows) {
+        int64_t n = std::min(default_page_rows, (int64_t)n_rows - i0);
+        offsets.assign(n + 1, 0);
+        for (int64_t i = 0; i < n; i++) {
+            const char *str = strings[i0 + i];
+            offsets[i + 1] = offsets[i] + (str == nullptr ? 0 : std::strlen(str));
+        }
+        page_info page;
+        out.align(8);
+        page.offset = out.tell();
+        page.n_rows = n;
+        out.write(offsets.data(), (n + 1) * sizeof(uint64_t));
+        for (int64_t i = 0; i < n; i++) {
+            if (strings[i0 + i] != nullptr)
+                out.write(strings[i0 + i], offsets[i + 1] - offsets[i]);
+        }
+        page.size = out.tell() - page.offset;
+        info.pages.push_back(page);
+    }
+    return da_status_success;
+}
+
+inline void write_directory(file_writer &out, std::vector<column_info> &columns) {
+    for (auto &info : columns) {
+        out.write_value<int32_t>(info.type);
+        out.write_string(info.label);
+        out.write_value<int64_t>((int64_t)info.pages.size());
+        for (auto &page : info.pages) {
+            out.write_value(page.offset);
+            out.write_value(page.size);
+            out.write_value(page.n_rows);
+            out.write_value(page.null_count);
+            out.write_value(page.encoding);
+            out.write_value(page.min);
+            out.write_value(page.max);
+        }
+        if (info.type == col_categorical) {
+            out.write_value<int64_t>((int64_t)info.dictionary->size());
+            for (auto &str : *info.dictionary)
+                out.write_string(str);
+        }
+    }
+}
+
+/* Parse the directory, checking that the pages of each column cover n_rows rows and
+ * lie within the file
+ */
+inline bool read_directory(dir_reader &dir, int64_t n_rows, int64_t n_cols,
+                           uint64_t file_size, std::vector<column_info> &columns) {
+    columns.resize(n_cols);
+    for (auto &info : columns) {
+        int64_t n_pages;
+        if (!dir.read_value(info.type) || info.type < col_real_d ||
+            info.type > col_categorical || !dir.read_string(info.label) ||
+            !dir.read_value(n_pages) || n_pages < 0 || n_pages > n_rows)
+            return false;
+        info.pages.resize(n_pages);
+        int64_t rows = 0;
+        for (auto &page : info.pages) {
+            if (!dir.read_value(page.offset) || !dir.read_value(page.size) ||
+                !dir.read_value(page.n_rows) || !dir.read_value(page.null_count) ||
+                !dir.read_value(page.encoding) || !dir.read_value(page.min) ||
+                !dir.read_value(page.max))
+                return false;
+            if (page.n_rows <= 0 || page.offset > file_size ||
+                page.size > file_size - page.offset)
+                return false;
+            rows += page.n_rows;
+        }
+        if (rows != n_rows)
+            return false;
+        if (info.type == col_categorical) {
+            int64_t n_cat;
+            if (!dir.read_value(n_cat) || n_cat < 0)
+                return false;
+            info.dictionary = std::make_shared<std::vector<std::string>>();
+            for (int64_t k = 0; k < n_cat; k++) {
+                std::string str;
+                if (!dir.read_string(str))
+                    return false;
+                info.dictionary->push_back(str);
+            }
+        }
+    }
+    return true;
+}
+
+/* A column decoded from the file, ready to be added to a data store */
+struct loaded_column {
+    void *data = nullptr; // owned buffer, nullptr if the column points into the mapping
+    const void *view = nullptr;
+};
+
+/* The pages of a column can be used in place if they are plain, contiguous, aligned and
+ * have the in-memory representation
+ */
+template <class T> bool in_place(file_source &src, const column_info &info) {
+    if (!src.mapped() || !std::is_same_v<storage_t<T>, T>)
+        return false;
+    for (size_t k = 0; k < info.pages.size(); k++) {
+        const page_info &page = info.pages[k];
+        if (page.encoding != encoding_plain || page.offset % alignof(T) != 0 ||
+            page.size != (uint64_t)page.n_rows * sizeof(T))
+            return false;
+        if (k > 0 && page.offset != info.pages[k - 1].offset + info.pages[k - 1].size)
+            return false;
+    }
+    return true;
+}
+
+/* Decode a fixed width column; returns false if the file is corrupted */
+template <class T>
+bool read_column(file_source &src, const column_info &info, int64_t n_rows,
+                 loaded_column &col) {
+    using S = storage_t<T>;
+    std::vector<char> buf;
+    if (in_place<T>(src, info)) {
+        const char *ptr = src.bytes(info.pages[0].offset, n_rows * sizeof(T), buf);
+        if (ptr == nullptr)
+            return false;
+        col.view = ptr;
+        return true;
+    }
+    T *data = new T[n_rows];
+    col.data = data;
+    std::vector<S> stored;
+    int64_t i0 = 0;
+    for (auto &page : info.pages) {
+        const char *ptr = src.bytes(page.offset, page.size, buf);
+        if (ptr == nullptr)
+            return false;
+        if constexpr (std::is_same_v<S, T>) {
+            if (!read_page(ptr, page, page.n_rows, data + i0))
+                return false;
+        } else {
+            stored.resize(page.n_rows);
+            if (!read_page(ptr, page, page.n_rows, stored.data()))
+                return false;
+            for (int64_t i = 0; i < page.n_rows; i++) {
+                if (stored[i] != std::numeric_limits<S>::max() &&
+                    (stored[i] < std::numeric_limits<T>::min() ||
+                     stored[i] >= std::numeric_limits<T>::max()))
+                    return false;
+                data[i0 + i] = convert_value<T>(stored[i]);
+            }
+        }
+        i0 += page.n_rows;
+    }
+    return true;
+}
+
+/* Decode a string column into malloc'ed C strings */
+inline bool read_strings(file_source &src, const column_info &info, int64_t n_rows,
+                         loaded_column &col) {
+    char **data = static_cast<char **>(calloc(n_rows, sizeof(char *)));
+    if (data == nullptr)
+        throw std::bad_alloc(); // LCOV_EXCL_LINE
+    col.data = data;
+    std::vector<char> buf;
+    int64_t i0 = 0;
+    for (auto &page : info.pages) {
+        const char *ptr = src.bytes(page.offset, page.size, buf);
+        uint64_t header_size = (page.n_rows + 1) * sizeof(uint64_t);
+        if (ptr == nullptr || page.size < header_size)
+            return false;
+        std::vector<uint64_t> offsets(page.n_rows + 1);
+        std::memcpy(offsets.data(), ptr, header_size);
+        if (offsets[0] != 0 || offsets[page.n_rows] != page.size - header_size)
+            return false;
+        for (int64_t i = 0; i < page.n_rows; i++) {
+            if (offsets[i + 1] < offsets[i])
+                return false;
+            uint64_t len = offsets[i + 1] - offsets[i];
+            data[i0 + i] = static_cast<char *>(malloc(len + 1));
+            if (data[i0 + i] == nullptr)
+                throw std::bad_alloc(); // LCOV_EXCL_LINE
+            std::memcpy(data[i0 + i], ptr + header_size + offsets[i], len);
+            data[i0 + i][len] = '\0';
+        }
+        i0 += page.n_rows;
+    }
+    return true;
+}
+
+inline void free_column(const column_info &info, int64_t n_rows, loaded_column &col) {
+    if (col.data == nullptr)
+        return;
+    switch (info.type) {
+    case col_real_d:
+        delete[] static_cast<double *>(col.data);
+        break;
+    case col_real_s:
+        delete[] static_cast<float *>(col.data);
+        break;
+    case col_uint8:
+        delete[] static_cast<uint8_t *>(col.data);
+        break;
+    case col_string: {
+        char **data = static_cast<char **>(col.data);
+        da_csv::free_data(&data, n_rows);
+        break;
+    }
+    default:
+        delete[] static_cast<da_int *>(col.data);
+    }
+    col.data = nullptr;
+}
+
+/* Add a decoded column to ds; ownership of the buffer is transferred on success */
+inline da_status add_loaded_column(data_store &ds, const column_info &info, da_int m,
+                                   loaded_column &col) {
+    da_status status;
+    switch (info.type) {
+    case col_real_d:
+    case col_real_s:
+    case col_uint8:
+    case col_int: {
+        bool owned = col.data != nullptr;
+        void *ptr = owned ? col.data : const_cast<void *>(col.view);
+        if (info.type == col_real_d)
+            status = ds.concatenate_columns(m, 1, static_cast<double *>(ptr),
+                                            column_major, false, owned);
+        else if (info.type == col_real_s)
+            status = ds.concatenate_columns(m, 1, static_cast<float *>(ptr),
+                                            column_major, false, owned);
+        else if (info.type == col_uint8)
+            status = ds.concatenate_columns(m, 1, static_cast<uint8_t *>(ptr),
+                                            column_major, false, owned);
+        else
+            status = ds.concatenate_columns(m, 1, static_cast<da_int *>(ptr),
+                                            column_major, false, owned);
+        break;
+    }
+    case col_string:
+        status = ds.concatenate_columns(m, 1, static_cast<char **>(col.data),
+                                        column_major, false, true, true);
+        break;
+    default: {
+        // The codes are always copied: the dictionary block owns them
+        da_int *codes = static_cast<da_int *>(col.data);
+        if (codes == nullptr) {
+            codes = new da_int[m];
+            std::memcpy(codes, col.view, m * sizeof(da_int));
+        }
+        status = ds.concatenate_categorical(m, codes, info.dictionary);
+        if (status != da_status_success && col.data == nullptr)
+            delete[] codes; // LCOV_EXCL_LINE
+    }
+    }
+    if (status == da_status_success)
+        col.data = nullptr;
+    return status;
+}
+
+} // namespace columnar
+
+} // namespace da_data
+
+da_status da_data_save(da_datastore store, const char *filename, const char *key,
+                       da_int compress) {
+    using namespace da_data::columnar;
+    using da_interval::interval;
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (filename == nullptr)
+        return da_error(store->err, da_status_invalid_input,
+                        "filename has to be defined");
+    if (compress != 0 && compress != 1)
+        return da_error(store->err, da_status_invalid_input,
+                        "compress must be 0 or 1, got " + std::to_string(compress));
+
+    da_data::data_store &ds = *store->store;
+    if (ds.has_missing_block())
+        return da_error(store->err, da_status_missing_block,
+                        "Row blocks are not complete, cannot save data at this point");
+    if (ds.get_num_rows() <= 0 || ds.get_num_cols() <= 0)
+        return da_error(store->err, da_status_invalid_input, "The store is empty");
+
+    da_status status;
+    std::vector<interval> rows, cols;
+    std::vector<column_info> columns;
+    file_writer out;
+    if (!out.open(filename))
+        return da_error(store->err, da_status_io_error,
+                        "Could not open the file " + std::string(filename));
+    try {
+        if (key == nullptr) {
+            rows.push_back({0, ds.get_num_rows() - 1});
+            cols.push_back({0, ds.get_num_cols() - 1});
+        } else {
+            std::string key_str(key);
+            status = ds.selection_intervals(key_str, rows, cols);
+            if (status != da_status_success)
+                return status;
+        }
+        da_int n_rows = 0;
+        for (auto &r : rows)
+            n_rows += r.upper - r.lower + 1;
+
+        file_header header;
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = format_version;
+        header.byte_order = byte_order_mark;
+        header.n_rows = n_rows;
+        header.n_cols = 0;
+        header.page_rows = default_page_rows;
+        header.dir_offset = 0;
+        header.dir_size = 0;
+        out.write(&header, sizeof(file_header));
+
+        for (auto &c : cols) {
+            for (da_int col = c.lower; col <= c.upper; col++) {
+                columns.emplace_back();
+                column_info &info = columns.back();
+                status = ds.get_col_label(col, info.label);
+                if (status != da_status_success)
+                    return status; // LCOV_EXCL_LINE
+                switch (ds.column_type(col)) {
+                case da_data::block_real_d:
+                    info.type = col_real_d;
+                    status = write_column<double>(ds, col, rows, n_rows, compress, out,
+                                                  info);
+                    break;
+                case da_data::block_real_s:
+                    info.type = col_real_s;
+                    status = write_column<float>(ds, col, rows, n_rows, compress, out,
+                                                 info);
+                    break;
+                case da_data::block_int:
+                    info.type = col_int;
+                    status = write_column<da_int>(ds, col, rows, n_rows, compress, out,
+                                                  info);
+                    break;
+                case da_data::block_bool:
+                    info.type = col_uint8;
+                    status = write_column<uint8_t>(ds, col, rows, n_rows, compress, out,
+                                                   info);
+                    break;
+                case da_data::block_char:
+                    info.type = col_string;
+                    status = write_strings(ds, col, rows, n_rows, out, info);
+                    break;
+                case da_data::block_cat: {
+                    da_data::block_dict *bd;
+                    status = ds.get_categorical_column(col, bd);
+                    if (status != da_status_success)
+                        return status; // LCOV_EXCL_LINE
+                    info.type = col_categorical;
+                    info.dictionary = bd->shared_dictionary();
+                    status = write_column<da_int>(ds, col, rows, n_rows, compress, out,
+                                                  info);
+                    break;
+                }
+                default:
+                    // LCOV_EXCL_START
+                    status = da_error(store->err, da_status_invalid_input,
+                                      "Column type cannot be saved");
+                    // LCOV_EXCL_STOP
+                }
+                if (status != da_status_success)
+                    return status;
+            }
+        }
+
+        out.align(8);
+        header.n_cols = (int64_t)columns.size();
+        header.dir_offset = out.tell();
+        write_directory(out, columns);
+        header.dir_size = out.tell() - header.dir_offset;
+        out.rewrite_header(header);
+    } catch (std::bad_alloc &) {                            // LCOV_EXCL_LINE
+        return da_error(store->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    if (!out.good())
+        return da_error(store->err, da_status_io_error, // LCOV_EXCL_LINE
+                        "Failed to write to the file " + std::string(filename));
+    return da_status_success;
+}
+
+da_status da_data_load(da_datastore store, const char *filename, da_int n_cols,
+                       const da_int *cols) {
+    using namespace da_data::columnar;
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (filename == nullptr)
+        return da_error(store->err, da_status_invalid_input,
+                        "filename has to be defined");
+    if (n_cols < 0 || (n_cols > 0 && cols == nullptr))
+        return da_error(store->err, da_status_invalid_input,
+                        "cols has to be defined when n_cols is positive");
+
+    std::shared_ptr<file_source> src;
+    std::vector<column_info> columns;
+    file_header header;
+    try {
+        src = std::make_shared<file_source>();
+        if (!src->open(filename))
+            return da_error(store->err, da_status_io_error,
+                            "Could not open the file " + std::string(filename));
+        std::vector<char> buf;
+        const char *ptr = src->bytes(0, sizeof(file_header), buf);
+        if (ptr == nullptr)
+            return da_error(store->err, da_status_invalid_file_data,
+                            "The file is too small to be a data store file");
+        std::memcpy(&header, ptr, sizeof(file_header));
+        if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+            return da_error(store->err, da_status_invalid_file_data,
+                            "The file is not a data store file");
+        if (header.version != format_version || header.byte_order != byte_order_mark)
+            return da_error(store->err, da_status_version_mismatch,
+                            "Unsupported file version or byte order");
+        if (header.n_rows <= 0 || header.n_rows > std::numeric_limits<da_int>::max() ||
+            header.n_cols <= 0 || header.n_cols > std::numeric_limits<da_int>::max())
+            return da_error(store->err, da_status_invalid_file_data,
+                            "Invalid dimensions in the file header");
+        ptr = src->bytes(header.dir_offset, header.dir_size, buf);
+        dir_reader dir(ptr, ptr == nullptr ? 0 : header.dir_size);
+        if (ptr == nullptr || !read_directory(dir, header.n_rows, header.n_cols,
+                                              src->file_size(), columns))
+            return da_error(store->err, da_status_invalid_file_data,
+                            "The file directory is corrupted");
+    } catch (std::bad_alloc &) {                            // LCOV_EXCL_LINE
+        return da_error(store->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+
+    da_int m = (da_int)header.n_rows;
+    for (da_int j = 0; j < n_cols; j++) {
+        if (cols[j] < 0 || cols[j] >= (da_int)header.n_cols)
+            return da_error(store->err, da_status_invalid_input,
+                            "Column index " + std::to_string(cols[j]) +
+                                " is out of range");
+    }
+    da_data::data_store &ds = *store->store;
+    if (ds.get_num_cols() > 0 && ds.get_num_rows() != m)
+        return da_error(store->err, da_status_invalid_input,
+                        "Number of rows must match " + std::to_string(ds.get_num_rows()) +
+                            " (input: " + std::to_string(m) + ")");
+    std::vector<da_int> proj;
+    try {
+        if (n_cols == 0) {
+            proj.resize(header.n_cols);
+            for (da_int j = 0; j < (da_int)header.n_cols; j++)
+                proj[j] = j;
+        } else {
+            proj.assign(cols, cols + n_cols);
+        }
+    } catch (std::bad_alloc &) {                            // LCOV_EXCL_LINE
+        return da_error(store->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+
+    // Decode the requested columns in parallel: only their pages are read
+    da_int n_proj = (da_int)proj.size();
+    std::vector<loaded_column> loaded(n_proj);
+    da_int threading_error = 0, corrupted = 0;
+#pragma omp parallel for schedule(dynamic) default(none)                                 \
+    shared(n_proj, proj, columns, src, m, loaded, threading_error, corrupted)            \
+    if (n_proj > 1)
+    for (da_int j = 0; j < n_proj; j++) {
+        const column_info &info = columns[proj[j]];
+        bool valid = true;
+        try {
+            switch (info.type) {
+            case col_real_d:
+                valid = read_column<double>(*src, info, m, loaded[j]);
+                break;
+            case col_real_s:
+                valid = read_column<float>(*src, info, m, loaded[j]);
+                break;
+            case col_uint8:
+                valid = read_column<uint8_t>(*src, info, m, loaded[j]);
+                break;
+            case col_string:
+                valid = read_strings(*src, info, m, loaded[j]);
+                break;
+            default:
+                valid = read_column<da_int>(*src, info, m, loaded[j]);
+            }
+        } catch (std::bad_alloc &) { // LCOV_EXCL_LINE
+#pragma omp atomic write
+            threading_error = 1; // LCOV_EXCL_LINE
+        }
+        if (!valid) {
+#pragma omp atomic write
+            corrupted = 1;
+        }
+    }
+
+    // Build the new columns in a temporary store so that a failure leaves store unchanged
+    da_status status = da_status_success;
+    if (threading_error != 0)
+        status = da_error(store->err, da_status_memory_error, // LCOV_EXCL_LINE
+                          "Memory allocation error");
+    else if (corrupted != 0)
+        status = da_error(store->err, da_status_invalid_file_data,
+                          "The file pages are corrupted");
+    da_data::data_store new_cols(*store->err);
+    bool borrowed = false;
+    try {
+        for (da_int j = 0; j < n_proj && status == da_status_success; j++) {
+            const column_info &info = columns[proj[j]];
+            borrowed = borrowed || (loaded[j].data == nullptr &&
+                                    info.type != col_categorical);
+            status = add_loaded_column(new_cols, info, m, loaded[j]);
+            if (status == da_status_success && !info.label.empty())
+                status = new_cols.label_column(info.label, j);
+        }
+    } catch (std::bad_alloc &) {                              // LCOV_EXCL_LINE
+        status = da_error(store->err, da_status_memory_error, // LCOV_EXCL_LINE
+                          "Memory allocation error");
+    }
+    for (da_int j = 0; j < n_proj; j++)
+        free_column(columns[proj[j]], m, loaded[j]);
+    if (status != da_status_success)
+        return status;
+
+    status = ds.horizontal_concat(new_cols);
+    if (status != da_status_success)
+        return status;
+    // Columns used in place keep the mapping alive
+    if (borrowed)
+        return ds.keep_alive(src);
+    return da_status_success;
+}
@@ -0,0 +1,546 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/* Group-by aggregation of data store columns.
+ * Rows are grouped on the values of integer, boolean or categorical columns with
+ * thread-local hash tables that are merged at the end, then sorted by group with a
+ * counting sort so that every group is contiguous. The aggregations of each group are
+ * computed in parallel with the internal basic statistics kernels, which use pairwise
+ * summation, dispatched to the architecture in use.
+ */
+
+#include "aoclda.h"
+#include "context.hpp"
+#include "da_datastore.hpp"
+#include "da_error.hpp"
+#include "da_omp.hpp"
+#include "dynamic_dispatch.hpp"
+#include "macros.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace da_data {
+
+namespace group_by {
+
+/* Hash and equality of key tuples. A tuple is referenced by its row r in the row-major
+ * matrix keys with n_by columns.
+ */
+struct key_hash {
+    const da_int *keys;
+    da_int n_by;
+    size_t operator()(da_int r) const {
+        size_t h = 0;
+        for (da_int j = 0; j < n_by; j++)
+            h ^= std::hash<da_int>{}(keys[r * n_by + j]) + 0x9e3779b9 + (h << 6) +
+                 (h >> 2);
+        return h;
+    }
+};
+
+struct key_equal {
+    const da_int *keys;
+    da_int n_by;
+    bool operator()(da_int r1, da_int r2) const {
+        return std::equal(&keys[r1 * n_by], &keys[r1 * n_by] + n_by, &keys[r2 * n_by]);
+    }
+};
+
+using key_map = std::unordered_map<da_int, da_int, key_hash, key_equal>;
+
+inline key_map make_key_map(const std::vector<da_int> &keys, da_int n_by) {
+    return key_map(16, key_hash{keys.data(), n_by}, key_equal{keys.data(), n_by});
+}
+
+/* Gather the selected rows of column col of ds into x */
+template <class T>
+da_status gather_column(data_store &ds, da_int col, std::vector<interval> &rows,
+                        da_int n_rows, T *x) {
+    da_int idx = 0;
+    for (auto &r : rows) {
+        da_status status = ds.extract_slice(r, {col, col}, n_rows, idx, x);
+        if (status != da_status_success)
+            return status; // LCOV_EXCL_LINE
+        idx += r.upper - r.lower + 1;
+    }
+    return da_status_success;
+}
+
+/* Gather the selected rows of the grouping column col into column j of the row-major
+ * n_rows x n_by matrix keys. Missing values keep the missing value of da_int.
+ */
+inline da_status gather_keys(data_store &ds, da_errors::da_error_t *err, da_int col,
+                             std::vector<interval> &rows, da_int n_rows, da_int n_by,
+                             da_int j, std::vector<da_int> &keys) {
+    block_type btype = ds.column_type(col);
+    da_status status;
+    try {
+        if (btype == block_int || btype == block_cat) {
+            std::vector<da_int> x(n_rows);
+            status = gather_column(ds, col, rows, n_rows, x.data());
+            for (da_int i = 0; i < n_rows; i++)
+                keys[i * n_by + j] = x[i];
+        } else if (btype == block_bool) {
+            std::vector<uint8_t> x(n_rows);
+            status = gather_column(ds, col, rows, n_rows, x.data());
+            for (da_int i = 0; i < n_rows; i++)
+                keys[i * n_by + j] = is_missing_value(x[i])
+                                         ? std::numeric_limits<da_int>::max()
+                                         : (da_int)x[i];
+        } else {
+            return da_error(err, da_status_invalid_input,
+                            "Column " + std::to_string(col) +
+                                " cannot be used for grouping: only integer, boolean "
+                                "and categorical columns are supported");
+        }
+    } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    return status;
+}
+
+/* Assign a group index to each of the n_rows key tuples. Each thread hashes a contiguous
+ * range of rows into its own table, the tables are then merged and the groups are
+ * numbered in increasing lexicographic order of their keys.
+ * On output, reps contains the row of a representative tuple of each group.
+ */
+inline da_status assign_groups(const std::vector<da_int> &keys, da_int n_by,
+                               da_int n_rows, std::vector<da_int> &group,
+                               std::vector<da_int> &reps) {
+    da_int n_threads = std::max((da_int)1, std::min((da_int)omp_get_max_threads(),
+                                                    n_rows / (da_int)4096));
+    std::vector<std::vector<da_int>> local_reps;
+    std::vector<std::vector<da_int>> local_to_global;
+    da_int threading_error = 0;
+    try {
+        group.resize(n_rows);
+        local_reps.resize(n_threads);
+        local_to_global.resize(n_threads);
+    } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+        return da_status_memory_error; // LCOV_EXCL_LINE
+    }
+
+#pragma omp parallel num_threads(n_threads) default(none)                                \
+    shared(keys, n_by, n_rows, n_threads, group, local_reps, threading_error)
+    {
+        da_int t = omp_get_thread_num();
+        da_int lo = n_rows * t / n_threads, hi = n_rows * (t + 1) / n_threads;
+        try {
+            key_map local = make_key_map(keys, n_by);
+            for (da_int r = lo; r < hi; r++) {
+                auto it = local.try_emplace(r, (da_int)local_reps[t].size());
+                if (it.second)
+                    local_reps[t].push_back(r);
+                group[r] = it.first->second;
+            }
+        } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+#pragma omp atomic write
+            threading_error = 1; // LCOV_EXCL_LINE
+        }
+    }
+    if (threading_error)
+        return da_status_memory_error; // LCOV_EXCL_LINE
+
+    // Merge the local tables and sort the groups by key
+    std::vector<da_int> order, rank;
+    try {
+        key_map global = make_key_map(keys, n_by);
+        reps.clear();
+        for (da_int t = 0; t < n_threads; t++) {
+            local_to_global[t].resize(local_reps[t].size());
+            for (size_t l = 0; l < local_reps[t].size(); l++) {
+                auto it = global.try_emplace(local_reps[t][l], (da_int)reps.size());
+                if (it.second)
+                    reps.push_back(local_reps[t][l]);
+                local_to_global[t][l] = it.first->second;
+            }
+        }
+        order.resize(reps.size());
+        rank.resize(reps.size());
+    } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+        return da_status_memory_error; // LCOV_EXCL_LINE
+    }
+    std::iota(order.begin(), order.end(), 0);
+    const da_int *k = keys.data();
+    std::sort(order.begin(), order.end(), [k, n_by, &reps](da_int g1, da_int g2) {
+        const da_int *k1 = &k[reps[g1] * n_by], *k2 = &k[reps[g2] * n_by];
+        return std::lexicographical_compare(k1, k1 + n_by, k2, k2 + n_by);
+    });
+    std::vector<da_int> sorted_reps(reps.size());
+    for (size_t g = 0; g < order.size(); g++) {
+        rank[order[g]] = (da_int)g;
+        sorted_reps[g] = reps[order[g]];
+    }
+    reps.swap(sorted_reps);
+
+#pragma omp parallel num_threads(n_threads) default(none)                                \
+    shared(n_rows, n_threads, group, local_to_global, rank)
+    {
+        da_int t = omp_get_thread_num();
+        da_int lo = n_rows * t / n_threads, hi = n_rows * (t + 1) / n_threads;
+        for (da_int r = lo; r < hi; r++)
+            group[r] = rank[local_to_global[t][group[r]]];
+    }
+    return da_status_success;
+}
+
+da_errors::error_bypass_t *nosave_group_by(nullptr);
+
+/* Basic statistics of the n contiguous values x of a group */
+template <class T> da_status group_mean(da_int n, const T *x, T *mean) {
+    DISPATCHER(nosave_group_by,
+               return (da_basic_statistics::mean(column_major, da_axis_all, n,
+                                                 (da_int)1, x, n, mean)));
+}
+
+template <class T> da_status group_variance(da_int n, const T *x, T *mean, T *var) {
+    DISPATCHER(nosave_group_by,
+               return (da_basic_statistics::variance(column_major, da_axis_all, n,
+                                                     (da_int)1, x, n, (da_int)0, mean,
+                                                     var)));
+}
+
+template <class T> da_status group_quantile(da_int n, const T *x, const T *q, T *res) {
+    DISPATCHER(nosave_group_by,
+               return (da_basic_statistics::quantile(column_major, da_axis_all, n,
+                                                     (da_int)1, x, n, q, (da_int)1, res,
+                                                     da_quantile_type_7)));
+}
+
+/* Aggregate the non-missing values among the cnt values x of a group (x is reordered) */
+template <class T>
+da_status aggregate(da_aggregation agg, T q, da_int cnt, T *x, T &res, da_int &count) {
+    T *last = std::remove_if(x, x + cnt, [](T v) { return std::isnan(v); });
+    da_int nv = (da_int)(last - x);
+    count = nv;
+    res = std::numeric_limits<T>::quiet_NaN();
+    if (nv == 0)
+        return da_status_success;
+    T mean;
+    switch (agg) {
+    case da_agg_count:
+        return da_status_success;
+    case da_agg_sum:
+        // Pairwise mean scaled back to a sum
+        res = (T)0;
+        if (group_mean(nv, x, &mean) == da_status_success)
+            res = mean * (T)nv;
+        return da_status_success;
+    case da_agg_mean:
+        return group_mean(nv, x, &res);
+    case da_agg_variance:
+        return group_variance(nv, x, &mean, &res);
+    case da_agg_min:
+        res = *std::min_element(x, x + nv);
+        return da_status_success;
+    case da_agg_max:
+        res = *std::max_element(x, x + nv);
+        return da_status_success;
+    case da_agg_median:
+        q = (T)0.5;
+        [[fallthrough]];
+    case da_agg_quantile:
+        return group_quantile(nv, x, &q, &res);
+    }
+    return da_status_internal_error; // LCOV_EXCL_LINE
+}
+
+inline std::string aggregation_suffix(da_aggregation agg, double q) {
+    switch (agg) {
+    case da_agg_count:
+        return "_count";
+    case da_agg_sum:
+        return "_sum";
+    case da_agg_mean:
+        return "_mean";
+    case da_agg_variance:
+        return "_variance";
+    case da_agg_min:
+        return "_min";
+    case da_agg_max:
+        return "_max";
+    case da_agg_median:
+        return "_median";
+    case da_agg_quantile: {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "_q%g", q);
+        return buf;
+    }
+    }
+    return ""; // LCOV_EXCL_LINE
+}
+
+template <class T> struct owned_column {
+    std::unique_ptr<T[]> data;
+    da_status add_to(data_store &ds, da_int m) {
+        da_status status =
+            ds.concatenate_columns(m, 1, data.get(), column_major, false, true);
+        if (status == da_status_success)
+            data.release();
+        return status;
+    }
+};
+
+template <class T>
+da_status group_by(da_datastore store, const char *key, da_int n_by, const da_int *by,
+                   da_int n_aggs, const da_int *agg_cols, const da_aggregation *aggs,
+                   const T *q, da_datastore result) {
+    if (!store || !result)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr || result->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (result == store)
+        return da_error(store->err, da_status_invalid_input,
+                        "The result must be stored in a different datastore");
+    if (n_by < 1 || by == nullptr)
+        return da_error(store->err, da_status_invalid_input,
+                        "At least one grouping column has to be defined");
+    if (n_aggs < 0 || (n_aggs > 0 && (agg_cols == nullptr || aggs == nullptr)))
+        return da_error(store->err, da_status_invalid_input,
+                        "agg_cols and aggs have to be defined");
+
+    data_store &ds = *store->store;
+    da_errors::da_error_t *err = store->err;
+    if (ds.has_missing_block())
+        return da_error(err, da_status_missing_block,
+                        "Row blocks are not complete, cannot group rows at this point");
+    da_int n_cols = ds.get_num_cols();
+    for (da_int j = 0; j < n_by; j++) {
+        if (by[j] < 0 || by[j] >= n_cols)
+            return da_error(err, da_status_invalid_input,
+                            "Grouping column index " + std::to_string(by[j]) +
+                                " is out of range");
+    }
+    for (da_int a = 0; a < n_aggs; a++) {
+        if (agg_cols[a] < 0 || agg_cols[a] >= n_cols)
+            return da_error(err, da_status_invalid_input,
+                            "Aggregation column index " + std::to_string(agg_cols[a]) +
+                                " is out of range");
+        if (ds.column_type(agg_cols[a]) != get_block_type<T>())
+            return da_error(err, da_status_invalid_input,
+                            "Aggregation column " + std::to_string(agg_cols[a]) +
+                                " is not of the floating point type of the function");
+        if (aggs[a] < da_agg_count || aggs[a] > da_agg_quantile)
+            return da_error(err, da_status_invalid_input, "Unknown aggregation");
+        if (aggs[a] == da_agg_quantile &&
+            (q == nullptr || !(q[a] >= (T)0 && q[a] <= (T)1)))
+            return da_error(err, da_status_invalid_input,
+                            "Quantile aggregations need q between 0 and 1");
+    }
+
+    // Rows of the selection
+    da_status status;
+    std::vector<interval> rows, cols;
+    if (key == nullptr) {
+        rows.push_back({0, ds.get_num_rows() - 1});
+    } else {
+        status = ds.selection_intervals(key, rows, cols);
+        if (status != da_status_success)
+            return status;
+    }
+    da_int n_sel = 0;
+    for (auto &r : rows)
+        n_sel += r.upper - r.lower + 1;
+
+    // Key tuples, without the rows where one of the keys is missing
+    std::vector<da_int> keys, pos, group, reps, offset, perm;
+    try {
+        keys.resize(n_sel * n_by);
+        pos.reserve(n_sel);
+    } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    for (da_int j = 0; j < n_by; j++) {
+        status = gather_keys(ds, err, by[j], rows, n_sel, n_by, j, keys);
+        if (status != da_status_success)
+            return status;
+    }
+    da_int n_valid = 0;
+    for (da_int i = 0; i < n_sel; i++) {
+        bool valid = true;
+        for (da_int j = 0; j < n_by; j++)
+            valid = valid && !is_missing_value(keys[i * n_by + j]);
+        if (valid) {
+            std::copy(&keys[i * n_by], &keys[i * n_by] + n_by, &keys[n_valid * n_by]);
+            pos.push_back(i);
+            n_valid++;
+        }
+    }
+    if (n_valid == 0)
+        return da_error(err, da_status_invalid_input,
+                        "No rows to group: the selection is empty or all the keys "
+                        "are missing");
+    keys.resize(n_valid * n_by);
+
+    status = assign_groups(keys, n_by, n_valid, group, reps);
+    if (status != da_status_success)
+        return da_error(err, status, "Memory allocation error"); // LCOV_EXCL_LINE
+    da_int n_groups = (da_int)reps.size();
+
+    // Counting sort of the rows by group
+    try {
+        offset.resize(n_groups + 1, 0);
+        perm.resize(n_valid);
+    } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    for (da_int r = 0; r < n_valid; r++)
+        offset[group[r] + 1]++;
+    std::partial_sum(offset.begin(), offset.end(), offset.begin());
+    {
+        std::vector<da_int> next(offset.begin(), offset.end() - 1);
+        for (da_int r = 0; r < n_valid; r++)
+            perm[next[group[r]]++] = pos[r];
+    }
+
+    // Build the result columns in a temporary store so that a failure leaves result
+    // unchanged
+    data_store new_cols(*result->err);
+    std::string label;
+    for (da_int j = 0; j < n_by; j++) {
+        owned_column<da_int> col;
+        try {
+            col.data.reset(new da_int[n_groups]);
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        for (da_int g = 0; g < n_groups; g++)
+            col.data[g] = keys[reps[g] * n_by + j];
+        block_dict *bd;
+        if (ds.column_type(by[j]) == block_cat) {
+            ds.get_categorical_column(by[j], bd);
+            status = new_cols.concatenate_categorical(n_groups, col.data.get(),
+                                                      bd->shared_dictionary());
+            if (status == da_status_success)
+                col.data.release();
+        } else {
+            status = col.add_to(new_cols, n_groups);
+        }
+        if (status != da_status_success)
+            return da_error_trace(err, status, "Could not add a grouping column");
+        ds.get_col_label(by[j], label);
+        if (!label.empty())
+            new_cols.label_column(label, j);
+    }
+
+    std::vector<T> values, grouped;
+    try {
+        values.resize(n_sel);
+        grouped.resize(n_valid);
+    } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    for (da_int a = 0; a < n_aggs; a++) {
+        status = gather_column(ds, agg_cols[a], rows, n_sel, values.data());
+        if (status != da_status_success)
+            return status; // LCOV_EXCL_LINE
+        for (da_int k = 0; k < n_valid; k++)
+            grouped[k] = values[perm[k]];
+
+        owned_column<T> res;
+        owned_column<da_int> counts;
+        try {
+            res.data.reset(new T[n_groups]);
+            counts.data.reset(new da_int[n_groups]);
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        da_aggregation agg = aggs[a];
+        T qa = q == nullptr ? (T)0 : q[a];
+        da_int agg_error = 0;
+        T *res_data = res.data.get(), *grouped_data = grouped.data();
+        da_int *counts_data = counts.data.get();
+        const da_int *offset_data = offset.data();
+#pragma omp parallel for schedule(dynamic) default(none)                                 \
+    shared(n_groups, agg, qa, grouped_data, offset_data, res_data, counts_data, agg_error)
+        for (da_int g = 0; g < n_groups; g++) {
+            da_int cnt = offset_data[g + 1] - offset_data[g];
+            if (aggregate(agg, qa, cnt, &grouped_data[offset_data[g]], res_data[g],
+                          counts_data[g]) != da_status_success) {
+#pragma omp atomic write
+                agg_error = 1; // LCOV_EXCL_LINE
+            }
+        }
+        if (agg_error)
+            return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
+                            "Unexpected error in the aggregation");
+
+        da_int idx = new_cols.get_num_cols();
+        if (agg == da_agg_count)
+            status = counts.add_to(new_cols, n_groups);
+        else
+            status = res.add_to(new_cols, n_groups);
+        if (status != da_status_success)
+            return da_error_trace(err, status, "Could not add an aggregation column");
+        ds.get_col_label(agg_cols[a], label);
+        if (label.empty())
+            label = "col" + std::to_string(agg_cols[a]);
+        new_cols.label_column(label + aggregation_suffix(agg, (double)qa), idx);
+    }
+
+    status = result->store->horizontal_concat(new_cols);
+    if (status != da_status_success)
+        return da_error_trace(err, status, "Could not add the columns to the result");
+    return da_status_success;
+}
+
+} // namespace group_by
+
+} // namespace da_data
+
+template <typename T>
+da_status da_data_group_by(da_datastore store, const char *key, da_int n_by,
+                           const da_int *by_cols, da_int n_aggs, const da_int *agg_cols,
+                           const da_aggregation *aggs, const T *q, da_datastore result) {
+    return da_data::group_by::group_by<T>(store, key, n_by, by_cols, n_aggs, agg_cols,
+                                          aggs, q, result);
+}
+
+template da_status da_data_group_by<double>(da_datastore, const char *, da_int,
+                                            const da_int *, da_int, const da_int *,
+                                            const da_aggregation *, const double *,
+                                            da_datastore);
+template da_status da_data_group_by<float>(da_datastore, const char *, da_int,
+                                           const da_int *, da_int, const da_int *,
+                                           const da_aggregation *, const float *,
+                                           da_datastore);
@@ -26,7 +26,18 @@
  */
 
 #include "aoclda.h"
+#include "aoclda.hpp"
 #include "da_datastore.hpp"
+#include "da_handle.hpp"
+#include "decision_forest_public.hpp"
+#include "decision_tree_public.hpp"
+#include "dynamic_dispatch.hpp"
+#include "kmeans/kmeans_public.hpp"
+#include "linmod_public.hpp"
+#include "macros.h"
+#include "nearest_neighbors_public.hpp"
+#include "pca_public.hpp"
+#include "svm_public.hpp"
 #include <cstring>
 #include <vector>
 
@@ -373,6 +384,193 @@ da_status da_data_extract_selection(da_datastore store, const char *key, da_orde
     return store->store->extract_selection(key, order, lddata, data);
 }
 
+/* ******************************* feed algorithm handles **************************** */
+/* *********************************************************************************** */
+/* Pass the selection key to the handle through its internal data setting entry point.
+ * For supervised handles, the column response_col of the store, restricted to the rows
+ * of the selection without missing values, is passed as the response.
+ */
+template <typename T>
+static da_status set_handle_data(da_handle handle, da_datastore store, const char *key,
+                                 bool supervised, da_int response_col) {
+    if (!store)
+        return da_status_store_not_initialized;
+    if (!handle)
+        return da_status_handle_not_initialized;
+    store->clear(); // Clean up store logs
+    handle->clear();
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return status;
+    basic_handle<T> *alg = handle->get_alg_handle<T>();
+    if (alg == nullptr)
+        return da_error(handle->err, da_status_handle_not_initialized,
+                        "The handle was not initialized.");
+    if (!supervised)
+        response_col = -1;
+    else if (response_col < 0)
+        return da_error(store->err, da_status_invalid_input,
+                        "response_col must be a column index of the store");
+    switch (handle->handle_type) {
+    case da_handle_kmeans:
+    case da_handle_pca:
+        if (supervised)
+            return da_error(handle->err, da_status_invalid_handle_type,
+                            "k-means and PCA handles do not take a response, use "
+                            "da_handle_set_data_from_datastore.");
+        break;
+    case da_handle_nn:
+        break;
+    case da_handle_linmod:
+    case da_handle_svm:
+    case da_handle_decision_tree:
+    case da_handle_decision_forest:
+        if (!supervised)
+            return da_error(handle->err, da_status_invalid_handle_type,
+                            "This handle needs a response, use "
+                            "da_handle_set_supervised_data_from_datastore.");
+        break;
+    default:
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "Setting the data from a data store is not supported for this "
+                        "handle type.");
+    }
+
+    // Provide the selection in the storage order the handle expects
+    std::string opt_order;
+    da_int iorder = column_major;
+    alg->opts.get("storage order", opt_order, iorder);
+    da_order order = da_order(iorder);
+
+    da_int n_rows, n_cols, ld;
+    const T *data = nullptr;
+    std::vector<T> buffer, response;
+    std::vector<da_int> labels;
+    std::vector<da_interval::interval> rows_used;
+    status = store->store->selection_view(std::string(key), order, n_rows, n_cols, data,
+                                          ld, buffer, response_col, &rows_used);
+    if (status != da_status_success)
+        return status;
+    if (!buffer.empty())
+        data = buffer.data();
+
+    // Integer responses are class labels for the trees and nearest neighbors
+    bool use_labels = handle->handle_type == da_handle_decision_tree ||
+                      handle->handle_type == da_handle_decision_forest ||
+                      (handle->handle_type == da_handle_nn &&
+                       da_data::block_matches<da_int>(
+                           store->store->column_type(response_col)));
+    if (supervised) {
+        if (use_labels)
+            status = store->store->extract_rows_column(response_col, rows_used, labels);
+        else
+            status = store->store->extract_rows_column(response_col, rows_used, response);
+        if (status != da_status_success)
+            return status;
+    }
+
+    switch (handle->handle_type) {
+    case da_handle_kmeans:
+        DISPATCHER(handle->err,
+                   status = (kmeans_public::kmeans_set_data<da_kmeans::kmeans<T>, T>(
+                       handle, n_rows, n_cols, data, ld)));
+        break;
+    case da_handle_pca:
+        DISPATCHER(handle->err, status = (pca_public::pca_init<da_pca::pca<T>, T>(
+                                    handle, n_rows, n_cols, data, ld)));
+        break;
+    case da_handle_nn:
+        DISPATCHER(handle->err,
+                   status = (neighbors_public::nn_set_data<da_neighbors::neighbors<T>, T>(
+                       handle, n_rows, n_cols, data, ld)));
+        if (status != da_status_success)
+            break;
+        // The handle now points at the gathered copy, it must own it even if the
+        // response is rejected below
+        alg->datastore_data = std::move(buffer);
+        if (!supervised)
+            break;
+        if (use_labels) {
+            DISPATCHER(
+                handle->err,
+                status = (neighbors_public::nn_set_labels<da_neighbors::neighbors<T>, T>(
+                    handle, n_rows, labels.data())));
+        } else {
+            DISPATCHER(
+                handle->err,
+                status = (neighbors_public::nn_set_targets<da_neighbors::neighbors<T>, T>(
+                    handle, n_rows, response.data())));
+        }
+        break;
+    case da_handle_linmod:
+        DISPATCHER(handle->err,
+                   status = (linmod_public::linmod_define_features<
+                             da_linmod::linear_model<T>, T>(handle, n_rows, n_cols, data,
+                                                            ld, response.data())));
+        break;
+    case da_handle_svm:
+        DISPATCHER(handle->err, status = (svm_public::svm_set_data<da_svm::svm<T>, T>(
+                                    handle, n_rows, n_cols, data, ld, response.data())));
+        break;
+    case da_handle_decision_tree:
+        DISPATCHER(handle->err,
+                   status = (decision_tree_public::decision_tree_set_data<
+                             da_decision_forest::decision_tree<T>, T>(
+                       handle, n_rows, n_cols, 0, data, ld, labels.data(), nullptr)));
+        break;
+    default:
+        DISPATCHER(handle->err,
+                   status = (decision_forest_public::decision_forest_set_data<
+                             da_decision_forest::decision_forest<T>, T>(
+                       handle, n_rows, n_cols, 0, data, ld, labels.data(), nullptr)));
+        break;
+    }
+    if (status != da_status_success)
+        return status;
+
+    // Handles can keep pointers to the gathered copies, which therefore live in the
+    // handle until it is given other data. Moving a vector keeps its data in place.
+    if (handle->handle_type != da_handle_nn)
+        alg->datastore_data = std::move(buffer);
+    if (!labels.empty())
+        alg->datastore_labels = std::move(labels);
+    if (!response.empty())
+        alg->datastore_response = std::move(response);
+    return da_status_success;
+}
+
+template <typename T>
+da_status da_handle_set_data_from_datastore(da_handle handle, da_datastore store,
+                                            const char *key) {
+    return set_handle_data<T>(handle, store, key, false, -1);
+}
+
+template <typename T>
+da_status da_handle_set_supervised_data_from_datastore(da_handle handle,
+                                                       da_datastore store,
+                                                       const char *key,
+                                                       da_int response_col) {
+    return set_handle_data<T>(handle, store, key, true, response_col);
+}
+
+template da_status da_handle_set_data_from_datastore<float>(da_handle, da_datastore,
+                                                            const char *);
+template da_status da_handle_set_data_from_datastore<double>(da_handle, da_datastore,
+                                                             const char *);
+template da_status da_handle_set_supervised_data_from_datastore<float>(da_handle,
+                                                                       da_datastore,
+                                                                       const char *,
+                                                                       da_int);
+template da_status da_handle_set_supervised_data_from_datastore<double>(da_handle,
+                                                                        da_datastore,
+                                                                        const char *,
+                                                                        da_int);
+
 /* ************************************* headings ************************************ */
 /* *********************************************************************************** */
 da_status da_data_label_column(da_datastore store, const char *label, da_int col_idx) {
@@ -438,6 +636,185 @@ da_status da_data_get_col_label(da_datastore store, da_int col_idx, da_int *labe
 
     return da_status_success;
 }
+
+template <typename T>
+da_status da_data_select_where(da_datastore store, const char *key, da_int col_idx,
+                               da_predicate op, da_int n_values, const T *values,
+                               da_selection_combine combine) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+    if (!values)
+        return da_error(store->err, da_status_invalid_input, "values has to be defined");
+
+    std::string key_str(key);
+    if (!da_data::check_internal_string(key_str)) {
+        std::string errmsg = "key cannot contain the prefix: ";
+        errmsg += DA_STRINTERNAL;
+        return da_error(store->err, da_status_invalid_input, errmsg);
+    }
+    return store->store->select_where(key_str, col_idx, op, n_values, values, combine);
+}
+
+da_status da_data_select_where(da_datastore store, const char *key, da_int col_idx,
+                               da_predicate op, da_int n_values, const char **values,
+                               da_selection_combine combine) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+    if (!values)
+        return da_error(store->err, da_status_invalid_input, "values has to be defined");
+
+    std::string key_str(key);
+    if (!da_data::check_internal_string(key_str)) {
+        std::string errmsg = "key cannot contain the prefix: ";
+        errmsg += DA_STRINTERNAL;
+        return da_error(store->err, da_status_invalid_input, errmsg);
+    }
+    return store->store->select_where_categorical(key_str, col_idx, op, n_values, values,
+                                                  combine);
+}
+
+/* ******************************* categorical columns ******************************* */
+/* *********************************************************************************** */
+da_status da_data_load_col_categorical(da_datastore store, da_int n_rows, da_int n_cols,
+                                       const char **block, da_order order) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (!block)
+        return da_error(store->err, da_status_invalid_input, "block has to be defined");
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+
+    return store->store->concatenate_categorical(n_rows, n_cols, block, order);
+}
+
+da_status da_data_get_n_categories(da_datastore store, da_int col_idx,
+                                   da_int *n_categories) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (!n_categories)
+        return da_error(store->err, da_status_invalid_input,
+                        "n_categories has to be defined");
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+
+    da_data::block_dict *bd;
+    da_status status = store->store->get_categorical_column(col_idx, bd);
+    if (status != da_status_success)
+        return status; // Error message already loaded
+    *n_categories = bd->n_categories();
+    return da_status_success;
+}
+
+da_status da_data_get_category_label(da_datastore store, da_int col_idx, da_int code,
+                                     da_int *label_sz, char *label) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (!label)
+        return da_error(store->err, da_status_invalid_input, "label has to be defined");
+    if (!label_sz)
+        return da_error(store->err, da_status_invalid_input,
+                        "label_sz has to be defined");
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+
+    da_data::block_dict *bd;
+    da_status status = store->store->get_categorical_column(col_idx, bd);
+    if (status != da_status_success)
+        return status; // Error message already loaded
+    if (code < 0 || code >= bd->n_categories())
+        return da_error(store->err, da_status_invalid_input,
+                        "code = " + std::to_string(code) +
+                            ". It must be set between 0 and " +
+                            std::to_string(bd->n_categories() - 1) + ".");
+    const std::string &label_str = bd->get_dictionary()[code];
+    da_int size = (da_int)label_str.size() + 1;
+    if (*label_sz < size) {
+        *label_sz = size;
+        return da_error(store->err, da_status_invalid_input,
+                        "label_sz must be at least " + std::to_string(size));
+    }
+    std::memcpy(label, label_str.c_str(), size);
+    return da_status_success;
+}
+
+da_status da_data_select_category(da_datastore store, const char *key, da_int col_idx,
+                                  const char *category) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+    if (!category)
+        return da_error(store->err, da_status_invalid_input,
+                        "category has to be defined");
+
+    std::string key_str(key);
+    if (!da_data::check_internal_string(key_str)) {
+        std::string errmsg = "key cannot contain the prefix: ";
+        errmsg += DA_STRINTERNAL;
+        return da_error(store->err, da_status_invalid_input, errmsg);
+    }
+    return store->store->select_category(key_str, col_idx, std::string(category));
+}
+
+template <typename T>
+da_status da_data_extract_categorical_features(da_datastore store, const char *key,
+                                               da_order order, T *data, da_int lddata,
+                                               da_int *categorical_features) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (!data)
+        return da_error(store->err, da_status_invalid_input, "data has to be defined");
+    if (!categorical_features)
+        return da_error(store->err, da_status_invalid_input,
+                        "categorical_features has to be defined");
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+
+    std::string key_str = key ? key : "";
+    return store->store->extract_categorical_features(key_str, order, lddata, data,
+                                                      categorical_features);
+}
+
+template <typename T>
+da_status da_data_extract_one_hot(da_datastore store, const char *key, da_int col_idx,
+                                  da_order order, T *data, da_int lddata) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (!data)
+        return da_error(store->err, da_status_invalid_input, "data has to be defined");
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+
+    std::string key_str = key ? key : "";
+    return store->store->extract_one_hot(key_str, col_idx, order, lddata, data);
+}
+
 /* **************************************** csv ************************************** */
 /* *********************************************************************************** */
 da_status da_data_load_from_csv(da_datastore store, const char *filename) {
@@ -543,6 +920,29 @@ template da_status da_data_extract_selection<da_int>(da_datastore, const char *,
                                                      da_int *, da_int);
 template da_status da_data_extract_selection<uint8_t>(da_datastore, const char *,
                                                       da_order, uint8_t *, da_int);
+template da_status da_data_select_where<da_int>(da_datastore, const char *, da_int,
+                                                da_predicate, da_int, const da_int *,
+                                                da_selection_combine);
+template da_status da_data_select_where<double>(da_datastore, const char *, da_int,
+                                                da_predicate, da_int, const double *,
+                                                da_selection_combine);
+template da_status da_data_select_where<float>(da_datastore, const char *, da_int,
+                                               da_predicate, da_int, const float *,
+                                               da_selection_combine);
+template da_status da_data_select_where<uint8_t>(da_datastore, const char *, da_int,
+                                                 da_predicate, da_int, const uint8_t *,
+                                                 da_selection_combine);
+template da_status da_data_extract_categorical_features<float>(da_datastore, const char *,
+                                                               da_order, float *, da_int,
+                                                               da_int *);
+template da_status da_data_extract_categorical_features<double>(da_datastore,
+                                                                const char *, da_order,
+                                                                double *, da_int,
+                                                                da_int *);
+template da_status da_data_extract_one_hot<float>(da_datastore, const char *, da_int,
+                                                  da_order, float *, da_int);
+template da_status da_data_extract_one_hot<double>(da_datastore, const char *, da_int,
+                                                   da_order, double *, da_int);
 template da_status da_data_get_element<float>(da_datastore, da_int, da_int, float *);
 template da_status da_data_get_element<double>(da_datastore, da_int, da_int, double *);
 template da_status da_data_get_element<da_int>(da_datastore, da_int, da_int, da_int *);
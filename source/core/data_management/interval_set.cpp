@@ -28,6 +28,7 @@
 #include "interval_set.hpp"
 #include "aoclda.h"
 #include "interval.hpp"
+#include <iterator>
 #include <set>
 
 namespace da_interval {
@@ -168,6 +169,26 @@ da_status interval_set::erase(interval bounds) {
     return da_status_success;
 }
 
+da_status interval_set::append(interval bounds) {
+    da_int lb = bounds.lower, ub = bounds.upper;
+    if (ub < lb)
+        return da_status_invalid_input;
+    if (iset.empty()) {
+        iset.insert({lb, ub});
+        return da_status_success;
+    }
+
+    inter_set::iterator last = std::prev(iset.end());
+    if (lb <= last->upper)
+        return da_status_invalid_input;
+    if (lb == last->upper + 1) {
+        lb = last->lower;
+        iset.erase(last);
+    }
+    iset.emplace_hint(iset.end(), interval{lb, ub});
+    return da_status_success;
+}
+
 void interval_set::clear() { iset.clear(); }
 
 } // namespace da_interval
\ No newline at end of file
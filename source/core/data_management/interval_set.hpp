@@ -93,6 +93,10 @@ class interval_set {
     bool empty() { return iset.empty(); }
 
     da_status insert(interval bounds);
+    /* Insert an interval located after all the intervals of the set in constant time,
+     * merging it with the last interval if they are adjacent
+     */
+    da_status append(interval bounds);
 
     bool find(da_int key, interval &inc);
     iterator find(da_int key);
@@ -51,6 +51,23 @@ da_status da_forest_set_training_data(da_handle handle, da_int n_samples,
             handle, n_samples, n_features, n_class, X, ldx, y, categorical_features)));
 }
 
+template <typename T>
+da_status da_forest_set_sample_weights(da_handle handle, da_int n_weights,
+                                       const T *weights) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(
+        handle->err,
+        return (decision_forest_set_sample_weights<
+                da_decision_forest::decision_forest<T>, T>(handle, n_weights, weights)));
+}
+
 template <typename T> da_status da_forest_fit(da_handle handle) {
     if (!handle)
         return da_status_handle_not_initialized;
@@ -142,6 +159,9 @@ template da_status da_forest_set_training_data<float>(da_handle, da_int, da_int,
 template da_status da_forest_set_training_data<double>(da_handle, da_int, da_int, da_int,
                                                        const double *, da_int,
                                                        const da_int *, const da_int *);
+template da_status da_forest_set_sample_weights<float>(da_handle, da_int, const float *);
+template da_status da_forest_set_sample_weights<double>(da_handle, da_int,
+                                                        const double *);
 template da_status da_forest_fit<float>(da_handle);
 template da_status da_forest_fit<double>(da_handle);
 template da_status da_forest_predict<float>(da_handle, da_int, da_int, const float *,
@@ -40,8 +40,25 @@ da_status decision_forest_set_data(da_handle handle, da_int n_samples, da_int n_
             "handle was not initialized with handle_type=da_handle_decision_forest or "
             "handle is invalid.");
 
-    return decision_forest->set_training_data(n_samples, n_features, X, ldx, y, n_class,
-                                              categorical_features);
+    da_status status = decision_forest->set_training_data(
+        n_samples, n_features, X, ldx, y, n_class, categorical_features);
+    if (status == da_status_success)
+        decision_forest->release_datastore_data();
+    return status;
+}
+
+template <typename decision_forest_class, typename T>
+da_status decision_forest_set_sample_weights(da_handle handle, da_int n_weights,
+                                             const T *weights) {
+    decision_forest_class *decision_forest =
+        dynamic_cast<decision_forest_class *>(handle->get_alg_handle<T>());
+    if (decision_forest == nullptr)
+        return da_error(
+            handle->err, da_status_invalid_handle_type,
+            "handle was not initialized with handle_type=da_handle_decision_forest or "
+            "handle is invalid.");
+
+    return decision_forest->set_sample_weights(n_weights, weights);
 }
 
 template <typename decision_forest_class, typename T>
@@ -50,6 +50,23 @@ da_status da_tree_set_training_data(da_handle handle, da_int n_samples, da_int n
             handle, n_samples, n_features, n_class, X, ldx, y, categorical_features)));
 }
 
+template <typename T>
+da_status da_tree_set_sample_weights(da_handle handle, da_int n_weights,
+                                     const T *weights) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(
+        handle->err,
+        return (decision_tree_set_sample_weights<da_decision_forest::decision_tree<T>, T>(
+            handle, n_weights, weights)));
+}
+
 template <typename T> da_status da_tree_fit(da_handle handle) {
     if (!handle)
         return da_status_handle_not_initialized;
@@ -80,6 +97,25 @@ da_status da_tree_predict(da_handle handle, da_int n_obs, da_int n_features,
                    handle, n_obs, n_features, X_test, ldx_test, y_pred)));
 }
 
+template <typename T>
+da_status da_tree_predict(da_handle handle, da_inference_context ctx, da_int n_obs,
+                          da_int n_features, const T *X_test, da_int ldx_test,
+                          da_int *y_pred) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    if (!ctx)
+        return da_status_invalid_pointer;
+    ctx->clear(); // Clean up context logs, the handle is only read
+
+    da_status status = handle->check_precision<T>(ctx->err);
+    if (status != da_status_success)
+        return da_error_trace(ctx->err, status, "Wrong precision type.");
+
+    DISPATCHER(ctx->err,
+               return (decision_tree_predict<da_decision_forest::decision_tree<T>, T>(
+                   handle, ctx, n_obs, n_features, X_test, ldx_test, y_pred)));
+}
+
 template <typename T>
 da_status da_tree_predict_proba(da_handle handle, da_int n_obs, da_int n_features,
                                 const T *X_test, da_int ldx_test, T *y_pred,
@@ -140,12 +176,19 @@ template da_status da_tree_set_training_data<float>(da_handle, da_int, da_int, d
 template da_status da_tree_set_training_data<double>(da_handle, da_int, da_int, da_int,
                                                      const double *, da_int,
                                                      const da_int *, const da_int *);
+template da_status da_tree_set_sample_weights<float>(da_handle, da_int, const float *);
+template da_status da_tree_set_sample_weights<double>(da_handle, da_int,
+                                                      const double *);
 template da_status da_tree_fit<float>(da_handle);
 template da_status da_tree_fit<double>(da_handle);
 template da_status da_tree_predict<float>(da_handle, da_int, da_int, const float *,
                                           da_int, da_int *);
 template da_status da_tree_predict<double>(da_handle, da_int, da_int, const double *,
                                            da_int, da_int *);
+template da_status da_tree_predict<float>(da_handle, da_inference_context, da_int,
+                                          da_int, const float *, da_int, da_int *);
+template da_status da_tree_predict<double>(da_handle, da_inference_context, da_int,
+                                           da_int, const double *, da_int, da_int *);
 template da_status da_tree_predict_proba<float>(da_handle, da_int, da_int, const float *,
                                                 da_int, float *, da_int, da_int);
 template da_status da_tree_predict_proba<double>(da_handle, da_int, da_int,
@@ -23,6 +23,7 @@
 
 #include "aoclda.h"
 #include "da_handle.hpp"
+#include "da_inference_context.hpp"
 #include "dynamic_dispatch.hpp"
 #include "macros.h"
 
@@ -40,8 +41,25 @@ da_status decision_tree_set_data(da_handle handle, da_int n_samples, da_int n_fe
             "handle was not initialized with handle_type=da_handle_decision_tree or "
             "handle is invalid.");
 
-    return decision_tree->set_training_data(n_samples, n_features, X, ldx, y, n_class, 0,
-                                            nullptr, categorical_features);
+    da_status status = decision_tree->set_training_data(
+        n_samples, n_features, X, ldx, y, n_class, 0, nullptr, categorical_features);
+    if (status == da_status_success)
+        decision_tree->release_datastore_data();
+    return status;
+}
+
+template <typename decision_tree_class, typename T>
+da_status decision_tree_set_sample_weights(da_handle handle, da_int n_weights,
+                                           const T *weights) {
+    decision_tree_class *decision_tree =
+        dynamic_cast<decision_tree_class *>(handle->get_alg_handle<T>());
+    if (decision_tree == nullptr)
+        return da_error(
+            handle->err, da_status_invalid_handle_type,
+            "handle was not initialized with handle_type=da_handle_decision_tree or "
+            "handle is invalid.");
+
+    return decision_tree->set_sample_weights(n_weights, weights);
 }
 
 template <typename decision_tree_class, typename T>
@@ -71,6 +89,21 @@ da_status decision_tree_predict(da_handle handle, da_int n_obs, da_int n_feature
     return decision_tree->predict(n_obs, n_features, X_test, ldx_test, y_pred);
 }
 
+template <typename decision_tree_class, typename T>
+da_status decision_tree_predict(da_handle handle, da_inference_context ctx, da_int n_obs,
+                                da_int n_features, const T *X_test, da_int ldx_test,
+                                da_int *y_pred) {
+    decision_tree_class *decision_tree =
+        dynamic_cast<decision_tree_class *>(handle->get_alg_handle<T>());
+    if (decision_tree == nullptr)
+        return da_error(
+            ctx->err, da_status_invalid_handle_type,
+            "handle was not initialized with handle_type=da_handle_decision_tree or "
+            "handle is invalid.");
+
+    return decision_tree->predict(*ctx, n_obs, n_features, X_test, ldx_test, y_pred);
+}
+
 template <typename decision_tree_class, typename T>
 da_status decision_tree_predict_proba(da_handle handle, da_int n_obs, da_int n_features,
                                       const T *X_test, da_int ldx_test, T *y_pred,
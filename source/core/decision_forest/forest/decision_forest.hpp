@@ -69,6 +69,9 @@ template <typename T> class decision_forest : public basic_handle<T> {
     da_int n_features = 0;
     da_int n_class = 0;
     const da_int *usr_categorical_feat = nullptr;
+    // sample_weights[n_samples]: optional user weights, NOT copied. Used by the trees to
+    //                            draw the bootstrap samples
+    const T *sample_weights = nullptr;
 
     //Utility pointer to column major allocated copy of user's data
     T *X_temp = nullptr;
@@ -102,6 +105,7 @@ template <typename T> class decision_forest : public basic_handle<T> {
     da_status set_training_data(da_int n_samples, da_int n_features, const T *X,
                                 da_int ldx, const da_int *y, da_int n_class = 0,
                                 const da_int *usr_cat_feat = nullptr);
+    da_status set_sample_weights(da_int n_weights, const T *weights);
     da_status fit();
     void parallel_count_classes(const T *X_test, da_int ldx_test, const da_int &n_blocks,
                                 const da_int &block_size, const da_int &block_rem,
@@ -131,11 +131,32 @@ da_status decision_forest<T>::set_training_data(da_int n_samples, da_int n_featu
         this->n_class = *std::max_element(y, y + n_samples) + 1;
 
     usr_categorical_feat = usr_cat_feat;
+    sample_weights = nullptr;
     this->init_done = true;
 
     return da_status_success;
 }
 
+template <typename T>
+da_status decision_forest<T>::set_sample_weights(da_int n_weights, const T *weights) {
+    if (!this->init_done)
+        return da_error(this->err, da_status_no_data,
+                        "No data has been passed to the handle.");
+
+    this->refresh();
+    if (n_weights == 0) {
+        sample_weights = nullptr;
+        return da_status_success;
+    }
+    // Whole numbers are only required when bootstrap is off, checked in fit()
+    da_status status =
+        check_sample_weights(this->err, n_samples, n_weights, weights, false);
+    if (status != da_status_success)
+        return status;
+    sample_weights = weights;
+    return da_status_success;
+}
+
 } // namespace da_decision_forest
 } // namespace ARCH
 
@@ -166,6 +166,13 @@ template <typename T> da_status decision_forest<T>::fit() {
         break;
     }
     bootstrap = bootstrap_opt == 1;
+    if (sample_weights != nullptr && !bootstrap) {
+        // Without bootstrap, the weights are used as sample frequencies by the trees
+        da_status status =
+            check_sample_weights(this->err, n_samples, n_samples, sample_weights, true);
+        if (status != da_status_success)
+            return status;
+    }
 
     n_obs = n_samples;
     if (bootstrap) {
@@ -186,7 +193,8 @@ template <typename T> da_status decision_forest<T>::fit() {
     shared(n_failed_tree, forest, n_tree, max_depth, min_node_sample, method, seed_tree, \
                min_split_score, feat_thresh, min_improvement, n_samples, n_features, X,  \
                ldx, y, n_class, n_obs, nfeat_split, bootstrap, use_hist, usr_max_bins,   \
-               X_binned, cat_split_strat, tree_threads) default(none) schedule(dynamic)
+               X_binned, cat_split_strat, tree_threads, sample_weights) default(none)    \
+    schedule(dynamic)
     for (da_int i = 0; i < n_tree; i++) {
         // Set tree optional parameters
         bool check_categorical_data = false;
@@ -207,6 +215,8 @@ template <typename T> da_status decision_forest<T>::fit() {
         tree_status =
             forest[i]->set_training_data(n_samples, n_features, X, ldx, y, n_class, n_obs,
                                          nullptr, usr_categorical_feat);
+        if (sample_weights != nullptr)
+            tree_status = forest[i]->set_sample_weights(n_samples, sample_weights);
         tree_status = forest[i]->fit();
         forest[i]->clear_working_memory();
         if (tree_status != da_status_success) {
@@ -42,6 +42,14 @@ namespace da_decision_forest {
 
 template class decision_tree<double>;
 template class decision_tree<float>;
+template da_status check_sample_weights<double>(da_errors::da_error_t *err,
+                                                da_int n_samples, da_int n_weights,
+                                                const double *weights,
+                                                bool integer_weights);
+template da_status check_sample_weights<float>(da_errors::da_error_t *err,
+                                               da_int n_samples, da_int n_weights,
+                                               const float *weights,
+                                               bool integer_weights);
 } // namespace da_decision_forest
 
 } // namespace ARCH
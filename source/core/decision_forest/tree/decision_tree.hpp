@@ -33,6 +33,7 @@
 #include "common/histogram.hpp"
 #include "common/scoring.hpp"
 #include "common/tree_options_types.hpp"
+#include "da_inference_context.hpp"
 #include "da_omp.hpp"
 #include "da_utils.hpp"
 #include "macros.h"
@@ -146,6 +147,12 @@ template <typename T> struct split_workspace {
 template <class T>
 using score_fun_t = typename std::function<T(da_int, da_int, std::vector<da_int> &)>;
 
+/* Validate a sample weights array of size n_weights, shared by trees and forests.
+ * integer_weights: also require whole numbers (weights used as frequencies). */
+template <typename T>
+da_status check_sample_weights(da_errors::da_error_t *err, da_int n_samples,
+                               da_int n_weights, const T *weights, bool integer_weights);
+
 template <typename T> class decision_tree : public basic_handle<T> {
 
     bool init_done = false;
@@ -194,11 +201,16 @@ template <typename T> class decision_tree : public basic_handle<T> {
     // count_classes: size n_class. Used to count the number of occurrences of all classes in a set
     //                of samples
     // bootstrap_sample_frequency: size n_samples. Used to store the frequency of each sample if bootstrap
-    //                             is selected.
+    //                             is selected or if sample weights were provided.
+    // sample_weights: optional user array of size n_samples, NOT copied. Used as integer
+    //                 frequencies without bootstrap and as sampling probabilities with it
+    // use_frequency: true if the counts need to be weighted by bootstrap_sample_frequency
     std::vector<da_int> samples_idx;
     da_int *samples_subset = nullptr;
     std::vector<da_int> count_classes;
     std::vector<da_int> bootstrap_sample_frequency;
+    const T *sample_weights = nullptr;
+    bool use_frequency = false;
 
     // Used when splits are computed on raw data (no histograms)
     // max_cat: The maximum number of different categories if categorical variables are present in X
@@ -273,6 +285,7 @@ template <typename T> class decision_tree : public basic_handle<T> {
                                 da_int ldx, const da_int *y, da_int n_class = 0,
                                 da_int n_obs = 0, da_int *samples_subset = nullptr,
                                 const da_int *usr_cat_feat = nullptr);
+    da_status set_sample_weights(da_int n_weights, const T *weights);
     da_status fit();
 
     // Scoring utilities
@@ -341,6 +354,13 @@ template <typename T> class decision_tree : public basic_handle<T> {
     // Inference
     da_status predict(da_int nsamp, da_int n_features, const T *X_test, da_int ldx,
                       da_int *y_pred, da_int mode = 0);
+    /* Version of predict which only reads the trained tree: errors go to ctx, so it
+     * can be called concurrently on the same handle
+     */
+    da_status predict(_da_inference_context &ctx, da_int nsamp, da_int n_features,
+                      const T *X_test, da_int ldx, da_int *y_pred);
+    // Leaf reached by the sample whose first feature is at x, features being ldx apart
+    const node<T> &find_leaf(const T *x, da_int ldx) const;
     da_status predict_proba(da_int nsamp, da_int n_features, const T *X_test, da_int ldx,
                             T *y_pred, da_int n_class, da_int ldy, da_int mode = 0);
     da_status predict_log_proba(da_int nsamp, da_int n_features, const T *X_test,
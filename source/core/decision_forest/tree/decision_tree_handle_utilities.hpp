@@ -30,6 +30,7 @@
 
 #include "aoclda.h"
 #include "da_std.hpp"
+#include <cmath>
 #include "decision_tree_options.hpp"
 #include "macros.h"
 
@@ -81,6 +82,7 @@ da_status decision_tree<T>::set_training_data(da_int n_samples, da_int n_feature
     if (this->n_obs == 0)
         this->n_obs = this->n_samples;
     this->samples_subset = samples_subset;
+    this->sample_weights = nullptr;
 
     // Store pointer to the user defined categorical features array
     usr_categorical_feat = usr_cat_feat;
@@ -89,6 +91,62 @@ da_status decision_tree<T>::set_training_data(da_int n_samples, da_int n_feature
     return da_status_success;
 }
 
+/* Check a sample weights array for trees and forests.
+ * Weights need to be finite, non-negative and have a positive sum. If integer_weights
+ * is true, they also need to be whole numbers since they are used as frequencies.
+ * err can be nullptr for the trees created internally by a forest. */
+template <typename T>
+da_status check_sample_weights(da_errors::da_error_t *err, da_int n_samples,
+                               da_int n_weights, const T *weights, bool integer_weights) {
+    if (n_weights != n_samples)
+        return da_error_bypass(err, da_status_invalid_input,
+                               "n_weights = " + std::to_string(n_weights) +
+                                   ", it must be equal to n_samples = " +
+                                   std::to_string(n_samples));
+    if (weights == nullptr)
+        return da_error_bypass(err, da_status_invalid_pointer,
+                               "weights is not a valid pointer.");
+
+    T sum = (T)0;
+    for (da_int i = 0; i < n_weights; i++) {
+        T w = weights[i];
+        if (!std::isfinite(w) || w < (T)0)
+            return da_error_bypass(err, da_status_invalid_input,
+                                   "weights[" + std::to_string(i) +
+                                       "] must be finite and non-negative.");
+        if (integer_weights && w != std::round(w))
+            return da_error_bypass(err, da_status_invalid_input,
+                                   "weights[" + std::to_string(i) +
+                                       "] is not a whole number. Sample weights are "
+                                       "used as frequencies when bootstrap is off.");
+        sum += w;
+    }
+    if (!(sum > (T)0))
+        return da_error_bypass(err, da_status_invalid_input,
+                               "The sum of the weights must be positive.");
+    return da_status_success;
+}
+
+template <typename T>
+da_status decision_tree<T>::set_sample_weights(da_int n_weights, const T *weights) {
+    if (!this->init_done)
+        return da_error_bypass(this->err, da_status_no_data,
+                               "No data has been passed to the handle.");
+
+    this->refresh();
+    if (n_weights == 0) {
+        sample_weights = nullptr;
+        return da_status_success;
+    }
+    // Non-integer weights are only usable when the samples are drawn with bootstrap
+    da_status status = check_sample_weights(this->err, n_samples, n_weights, weights,
+                                            !bootstrap);
+    if (status != da_status_success)
+        return status;
+    sample_weights = weights;
+    return da_status_success;
+}
+
 template <typename T>
 decision_tree<T>::decision_tree(da_errors::da_error_t &err) : basic_handle<T>(err) {
     // Initialize the options registry
@@ -35,6 +35,28 @@
 namespace ARCH {
 namespace da_decision_forest {
 
+template <typename T>
+const node<T> &decision_tree<T>::find_leaf(const T *x, da_int ldx) const {
+    const node<T> *current_node = &tree[0];
+    while (!current_node->is_leaf) {
+        if (current_node->prop == continuous ||
+            current_node->prop == categorical_ordered) {
+            T feat_val = x[ldx * current_node->feature];
+            if (feat_val < current_node->x_threshold)
+                current_node = &tree[current_node->left_child_idx];
+            else
+                current_node = &tree[current_node->right_child_idx];
+        } else {
+            da_int cat_val = std::round(x[ldx * current_node->feature]);
+            if (cat_val == current_node->category)
+                current_node = &tree[current_node->left_child_idx];
+            else
+                current_node = &tree[current_node->right_child_idx];
+        }
+    }
+    return *current_node;
+}
+
 template <typename T>
 da_status decision_tree<T>::predict(da_int nsamp, da_int nfeat, const T *X_test,
                                     da_int ldx_test, da_int *y_pred, da_int mode) {
@@ -67,33 +89,48 @@ da_status decision_tree<T>::predict(da_int nsamp, da_int nfeat, const T *X_test,
         return status;
 
     // Fill y_pred with the values of all the requested samples
-    node<T> *current_node;
-    for (da_int i = 0; i < nsamp; i++) {
-        current_node = &tree[0];
-        while (!current_node->is_leaf) {
-            if (current_node->prop == continuous ||
-                current_node->prop == categorical_ordered) {
-                T feat_val = X_test_temp[ldx_test_temp * current_node->feature + i];
-                if (feat_val < current_node->x_threshold)
-                    current_node = &tree[current_node->left_child_idx];
-                else
-                    current_node = &tree[current_node->right_child_idx];
-            } else {
-                da_int cat_val =
-                    std::round(X_test_temp[ldx_test_temp * current_node->feature + i]);
-                if (cat_val == current_node->category)
-                    current_node = &tree[current_node->left_child_idx];
-                else
-                    current_node = &tree[current_node->right_child_idx];
-            }
-        }
-        y_pred[i] = current_node->y_pred;
-    }
+    for (da_int i = 0; i < nsamp; i++)
+        y_pred[i] = find_leaf(X_test_temp + i, ldx_test_temp).y_pred;
     if (utility_ptr1)
         delete[] (utility_ptr1);
     return da_status_success;
 }
 
+template <typename T>
+da_status decision_tree<T>::predict(_da_inference_context &ctx, da_int nsamp,
+                                    da_int nfeat, const T *X_test, da_int ldx_test,
+                                    da_int *y_pred) {
+    da_errors::da_error_t *err = ctx.err;
+    if (y_pred == nullptr)
+        return da_error(err, da_status_invalid_pointer, "y_pred is not a valid pointer.");
+
+    if (nfeat != n_features) {
+        return da_error(err, da_status_invalid_input,
+                        "n_features = " + std::to_string(nfeat) +
+                            " doesn't match the expected value " +
+                            std::to_string(n_features) + ".");
+    }
+
+    if (!this->model_trained) {
+        return da_error(err, da_status_out_of_date,
+                        "The model has not yet been trained or the data it is "
+                        "associated with is out of date.");
+    }
+
+    da_status status =
+        this->check_2D_array(err, this->order, nsamp, nfeat, X_test, ldx_test,
+                             "n_samples", "n_features", "X_test", "ldx_test");
+    if (status != da_status_success)
+        return status;
+
+    // Row-major data is read in place instead of being transposed
+    const da_int inc_i = this->order == column_major ? 1 : ldx_test;
+    const da_int ldx = this->order == column_major ? ldx_test : 1;
+    for (da_int i = 0; i < nsamp; i++)
+        y_pred[i] = find_leaf(X_test + i * inc_i, ldx).y_pred;
+    return da_status_success;
+}
+
 template <typename T>
 da_status decision_tree<T>::predict_proba(da_int nsamp, da_int nfeat, const T *X_test,
                                           da_int ldx_test, T *y_proba_pred, da_int nclass,
@@ -239,29 +276,9 @@ da_status decision_tree<T>::score(da_int nsamp, da_int nfeat, const T *X_test,
     if (status != da_status_success)
         return status;
 
-    node<T> *current_node;
     *accuracy = 0.;
     for (da_int i = 0; i < nsamp; i++) {
-        current_node = &tree[0];
-        while (!current_node->is_leaf) {
-            if (current_node->prop == continuous ||
-                current_node->prop == categorical_ordered) {
-                T feat_val = X_test_temp[ldx_test_temp * current_node->feature + i];
-                if (feat_val < current_node->x_threshold)
-                    current_node = &tree[current_node->left_child_idx];
-                else
-                    current_node = &tree[current_node->right_child_idx];
-            } else {
-                da_int cat_val =
-                    std::round(X_test_temp[ldx_test_temp * current_node->feature + i]);
-                if (cat_val == current_node->category)
-                    current_node = &tree[current_node->left_child_idx];
-                else
-                    current_node = &tree[current_node->right_child_idx];
-            }
-        }
-
-        if (current_node->y_pred == y_test[i])
+        if (find_leaf(X_test_temp + i, ldx_test_temp).y_pred == y_test[i])
             *accuracy += (T)1.0;
     }
     *accuracy = *accuracy / (T)nsamp;
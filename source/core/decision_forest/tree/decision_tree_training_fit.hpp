@@ -133,7 +133,7 @@ da_status decision_tree<T>::add_node(da_int parent_idx, bool is_left, T score,
     new_node.score = score;
     new_node.n_samples = 0;
     // Prediction: most represented class in the samples subset
-    if (bootstrap) {
+    if (use_frequency) {
         count_class_occurences(count_classes, new_node.start_idx, new_node.end_idx,
                                bootstrap_sample_frequency);
         for (da_int c = 0; c < n_class; c++) {
@@ -248,7 +248,7 @@ template <typename T> da_status decision_tree<T>::fit_serial() {
         best_split.score = current_node.score;
         best_split.feat_idx = -1;
         if (node_idx > 0) {
-            if (bootstrap)
+            if (use_frequency)
                 count_class_occurences(count_classes, current_node.start_idx,
                                        current_node.end_idx, bootstrap_sample_frequency);
             else
@@ -330,7 +330,7 @@ template <typename T> da_status decision_tree<T>::fit_parallel() {
                     best_split.score = current_node.score;
                     best_split.feat_idx = -1;
                     if (node_idx > 0) {
-                        if (bootstrap)
+                        if (use_frequency)
                             count_class_occurences(count_classes, current_node.start_idx,
                                                    current_node.end_idx,
                                                    bootstrap_sample_frequency);
@@ -456,6 +456,7 @@ template <typename T> da_status decision_tree<T>::fit() {
         nfeat_split = n_features;
     }
 
+    use_frequency = bootstrap || sample_weights != nullptr;
     status = init_working_memory();
     if (status != da_status_success)
         return status; // Error message already filled
@@ -494,22 +495,47 @@ template <typename T> da_status decision_tree<T>::fit() {
         return status;
 
     n_obs_total = n_obs;
-    if (!bootstrap) {
+    if (!bootstrap && sample_weights == nullptr) {
         // Take all the samples
+        // n_obs may have been reduced by a previous weighted fit
+        n_obs = n_samples;
+        n_obs_total = n_obs;
+        samples_idx.resize(n_obs);
         da_std::iota(samples_idx.begin(), samples_idx.end(), 0);
+    } else if (!bootstrap) {
+        // Integer sample weights are used directly as frequencies, zero weights
+        // remove the sample from the training set
+        n_obs_total = 0;
+        samples_idx.clear();
+        for (da_int i = 0; i < n_samples; i++) {
+            bootstrap_sample_frequency[i] = (da_int)std::round(sample_weights[i]);
+            if (bootstrap_sample_frequency[i] > 0) {
+                samples_idx.push_back(i);
+                n_obs_total += bootstrap_sample_frequency[i];
+            }
+        }
+        n_obs = samples_idx.size();
     } else {
-        if (samples_subset == nullptr) {
+        if (samples_subset != nullptr) {
+            // Copy the input from the samples_subset array.
+            // As it is intended mainly for testing, samples_subset is NOT validated.
+            for (da_int i = 0; i < n_obs; i++)
+                samples_idx[i] = samples_subset[i];
+        } else if (sample_weights != nullptr) {
+            // Random selection with replacement, proportional to the sample weights
+            std::discrete_distribution<da_int> weighted_dist(
+                sample_weights, sample_weights + n_samples);
+            std::generate(samples_idx.begin(), samples_idx.end(),
+                          [&weighted_dist, &mt_engine = this->mt_engine]() {
+                              return weighted_dist(mt_engine);
+                          });
+        } else {
             // Fill the index vector with a random selection with replacement
             std::uniform_int_distribution<da_int> uniform_dist(0, n_samples - 1);
             std::generate(samples_idx.begin(), samples_idx.end(),
                           [&uniform_dist, &mt_engine = this->mt_engine]() {
                               return uniform_dist(mt_engine);
                           });
-        } else {
-            // Copy the input from the samples_subset array.
-            // As it is intended mainly for testing, samples_subset is NOT validated.
-            for (da_int i = 0; i < n_obs; i++)
-                samples_idx[i] = samples_subset[i];
         }
         status = compress_count_occurences(samples_idx, bootstrap_sample_frequency);
         // only memory error can be raised
@@ -528,7 +554,7 @@ template <typename T> da_status decision_tree<T>::fit() {
     tree[0].end_idx = n_obs - 1;
     tree[0].depth = 0;
     tree[0].n_samples = n_obs_total;
-    if (bootstrap)
+    if (use_frequency)
         count_class_occurences(count_classes, 0, n_obs - 1, bootstrap_sample_frequency);
     else
         count_class_occurences(count_classes, 0, n_obs - 1);
@@ -123,7 +123,7 @@ template <typename T> da_status decision_tree<T>::init_working_memory() {
     }
     da_std::iota(features_idx.begin(), features_idx.end(), 0);
 
-    if (bootstrap) {
+    if (use_frequency) {
         try {
             bootstrap_sample_frequency.resize(this->n_samples);
         } catch (std::bad_alloc &) {                                  // LCOV_EXCL_LINE
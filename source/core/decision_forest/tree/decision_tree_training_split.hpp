@@ -116,7 +116,7 @@ bool decision_tree<T>::update_split_sorted(da_int sidx, da_int &next_idx, da_int
     // update from the left or right based on which side has fewer samples
     // The right side would typically be used for features with unbalanced data
     if (next_idx - sidx + 1 <= end_idx - next_idx + 1) {
-        if (bootstrap)
+        if (use_frequency)
             update_count_left(sidx, next_idx, ns_left, bootstrap_sample_frequency, ws,
                               samp);
         else
@@ -127,7 +127,7 @@ bool decision_tree<T>::update_split_sorted(da_int sidx, da_int &next_idx, da_int
     } else {
         da_std::fill(ws.count_right_classes.begin(), ws.count_right_classes.end(), 0);
         ns_right = 0;
-        if (bootstrap)
+        if (use_frequency)
             update_count_right(next_idx, end_idx, ns_right, bootstrap_sample_frequency,
                                ws, samp);
         else
@@ -249,7 +249,7 @@ bool decision_tree<T>::compute_best_split_hist(const node<T> &nd, da_int feat_id
      * loop through all the bin values of feature feat_idx and update the split properties of sp
      * if a good split is found. */
     bool const_feat = false;
-    if (bootstrap)
+    if (use_frequency)
         const_feat = update_node_histogram(nd, feat_idx, bootstrap_sample_frequency, ws);
     else
         const_feat = update_node_histogram(nd, feat_idx, ws);
@@ -327,7 +327,8 @@ void decision_tree<T>::split_raw_onevall(const node<T> &current_node, da_int fea
         da_int idx = samp[i];
         da_int c = y[idx];
         da_int cat = std::round(ws.feature_values[i]);
-        ws.cat_feat_table[cat * n_class + c]++;
+        ws.cat_feat_table[cat * n_class + c] +=
+            use_frequency ? bootstrap_sample_frequency[idx] : 1;
     }
 
     for (da_int cat = 0; cat < cat_feat[feat_idx]; cat++) {
@@ -426,6 +426,75 @@ void BarnesHutTree<T, D>::compute_repulsive_batch4(const da_int pt_idx[4],
     }
 }
 
+template <typename T, int8_t D>
+void BarnesHutTree<T, D>::compute_repulsive_query(const T *query, T force_out[D],
+                                                  T &sum_q_out, int32_t *node_stack,
+                                                  int32_t *depth_stack) const {
+    T f[D] = {};
+    T sq = (T)0;
+
+    auto accum_force = [&](const T *pos, T weight) {
+        T delta[D];
+        T dist2 = (T)0;
+        for (da_int d = 0; d < D; ++d) {
+            delta[d] = query[d] - pos[d];
+            dist2 += delta[d] * delta[d];
+        }
+        const T dxy1 = dist2 + EPS_INC;
+        const T scale = weight / (dxy1 * dxy1);
+        sq += scale * dxy1;
+        for (da_int d = 0; d < D; ++d)
+            f[d] += delta[d] * scale;
+    };
+
+    da_int stack_top = 0;
+    if (num_nodes > 0) {
+        node_stack[stack_top] = 0;
+        depth_stack[stack_top++] = 0;
+    }
+
+    while (stack_top > 0) {
+        --stack_top;
+        const da_int node = node_stack[stack_top];
+        const da_int level = depth_stack[stack_top];
+        const TreeNode<T, D> &nd = nodes[node];
+        if (nd.cnt == 0)
+            continue;
+
+        if (nd.num_children == 0) {
+            if (nd.cnt == 1) {
+                accum_force(nd.com, (T)1);
+            } else {
+                const T *leaf_points = sorted_pos.data() + (da_int)nd.point_start * D;
+                for (da_int c = 0; c < nd.cnt; ++c)
+                    accum_force(leaf_points + c * D, (T)1);
+            }
+            continue;
+        }
+
+        T dist2 = (T)0;
+        for (da_int d = 0; d < D; ++d) {
+            const T delta = query[d] - nd.com[d];
+            dist2 += delta * delta;
+        }
+        const T thresh =
+            (level < MAX_DEPTH) ? dist2_thresh[level] : dist2_thresh[MAX_DEPTH - 1];
+        // The query is never one of the cell's points, so far cells are always summarized
+        if (dist2 >= thresh || stack_top + nd.num_children > STACK_SIZE) {
+            accum_force(nd.com, (T)nd.cnt);
+            continue;
+        }
+        for (da_int c = nd.num_children - 1; c >= 0; --c) {
+            node_stack[stack_top] = nd.first_child + c;
+            depth_stack[stack_top++] = level + 1;
+        }
+    }
+
+    sum_q_out = sq;
+    for (da_int d = 0; d < D; ++d)
+        force_out[d] = f[d];
+}
+
 // Explicit template instantiations
 template struct BarnesHutTree<float, 1>;
 template struct BarnesHutTree<float, 2>;
@@ -0,0 +1,402 @@
+/* ************************************************************************
+ * Copyright (c) 2026 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "da_omp.hpp"
+#include "da_std.hpp"
+#include "tsne.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ARCH {
+
+namespace da_tsne {
+
+namespace {
+
+// Avoids the NaN-recovery path of std::complex multiplication in the hot loops
+template <typename C> inline C cmul(const C &a, const C &b) {
+    return C(a.real() * b.real() - a.imag() * b.imag(),
+             a.real() * b.imag() + a.imag() * b.real());
+}
+
+// In-place iterative radix-2 transform of a contiguous line whose length is a power
+// of two. The inverse transform is not normalized.
+template <typename C>
+void fft_line(C *a, da_int len, const C *twiddle, const da_int *bit_reverse,
+              bool inverse) {
+    for (da_int i = 0; i < len; ++i) {
+        const da_int j = bit_reverse[i];
+        if (i < j)
+            std::swap(a[i], a[j]);
+    }
+    for (da_int half = 1; half < len; half <<= 1) {
+        const da_int stride = len / (2 * half);
+        for (da_int start = 0; start < len; start += 2 * half) {
+            for (da_int k = 0; k < half; ++k) {
+                const C tw = twiddle[k * stride];
+                const C w = inverse ? std::conj(tw) : tw;
+                const C u = a[start + k];
+                const C v = cmul(a[start + k + half], w);
+                a[start + k] = u + v;
+                a[start + k + half] = u - v;
+            }
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// FFTInterpolationGrid method definitions
+// ============================================================================
+
+template <typename T, int8_t D> void FFTInterpolationGrid<T, D>::setup_geometry() {
+    grid_t lo = std::numeric_limits<grid_t>::max();
+    grid_t hi = std::numeric_limits<grid_t>::lowest();
+    const da_int nd = n * D;
+#pragma omp parallel for reduction(min : lo) reduction(max : hi)
+    for (da_int i = 0; i < nd; ++i) {
+        const grid_t y = (grid_t)points[i];
+        lo = std::min(lo, y);
+        hi = std::max(hi, y);
+    }
+    grid_t span = hi - lo;
+    if (!(span > (grid_t)0)) {
+        // Empty or collapsed embedding: any unit box holds all the points
+        lo = (n > 0) ? lo - (grid_t)0.5 : (grid_t)0;
+        span = (grid_t)1;
+    }
+
+    // The same intervals are used in every dimension so that the grid is isotropic
+    const da_int boxes = (da_int)std::ceil(span * (grid_t)intervals_per_unit);
+    n_boxes = std::max(min_intervals, boxes);
+    n_nodes = n_boxes * n_interp;
+    coord_min = lo;
+    box_width = span / (grid_t)n_boxes;
+
+    // Zero padding to at least 2 * n_nodes turns the circular convolution into the
+    // required Toeplitz product
+    da_int len = 2;
+    while (len < 2 * n_nodes)
+        len *= 2;
+    grid_size = (D == 1) ? len : len * len;
+    const da_int n_grid_nodes = (D == 1) ? n_nodes : n_nodes * n_nodes;
+
+    point_box.resize(n * D);
+    sorted_indices.resize(n);
+    box_start.resize(n_boxes + 1);
+    charges_hat.resize(N_CHARGES * grid_size);
+    kernel_hat.resize(2 * grid_size);
+    work.resize(grid_size);
+    potentials.resize(N_POTENTIALS * n_grid_nodes);
+    if (D == 2)
+        line_work.resize(omp_get_max_threads() * len);
+
+    if ((da_int)lagrange_denom.size() != n_interp) {
+        lagrange_denom.resize(n_interp);
+        for (da_int k = 0; k < n_interp; ++k) {
+            grid_t denom = (grid_t)1;
+            for (da_int l = 0; l < n_interp; ++l)
+                if (l != k)
+                    denom *= (grid_t)(k - l) / (grid_t)n_interp;
+            lagrange_denom[k] = denom;
+        }
+    }
+
+    if (fft_len != len) {
+        fft_len = len;
+        twiddle.resize(len / 2);
+        bit_reverse.resize(len);
+        const double two_pi = 2.0 * std::acos(-1.0);
+        for (da_int k = 0; k < len / 2; ++k) {
+            const double angle = -two_pi * (double)k / (double)len;
+            twiddle[k] = cplx_t((grid_t)std::cos(angle), (grid_t)std::sin(angle));
+        }
+        da_int log_len = 0;
+        while ((da_int(1) << log_len) < len)
+            ++log_len;
+        for (da_int i = 0; i < len; ++i) {
+            da_int rev = 0;
+            for (da_int b = 0; b < log_len; ++b)
+                if (i & (da_int(1) << b))
+                    rev |= da_int(1) << (log_len - 1 - b);
+            bit_reverse[i] = rev;
+        }
+    }
+}
+
+template <typename T, int8_t D>
+void FFTInterpolationGrid<T, D>::lagrange_weights(grid_t y, da_int box, grid_t *w) const {
+    // Local coordinate in [0, 1] with nodes at (l + 1/2) / n_interp
+    const grid_t u = (y - coord_min) / box_width - (grid_t)box;
+    for (da_int k = 0; k < n_interp; ++k) {
+        grid_t num = (grid_t)1;
+        for (da_int l = 0; l < n_interp; ++l)
+            if (l != k)
+                num *= u - ((grid_t)l + (grid_t)0.5) / (grid_t)n_interp;
+        w[k] = num / lagrange_denom[k];
+    }
+}
+
+template <typename T, int8_t D> void FFTInterpolationGrid<T, D>::spread_charges() {
+    const da_int last = D - 1;
+#pragma omp parallel for schedule(static)
+    for (da_int i = 0; i < n; ++i) {
+        for (da_int d = 0; d < D; ++d) {
+            const grid_t y = (grid_t)points[i * D + d];
+            da_int box = (da_int)std::floor((y - coord_min) / box_width);
+            point_box[i * D + d] = std::clamp(box, da_int(0), n_boxes - 1);
+        }
+    }
+
+    // Bucket the points by their box in the last dimension. Points from different
+    // buckets write to disjoint grid lines, so the buckets can be spread in parallel
+    // without atomics or per-thread grids and the result does not depend on the
+    // number of threads.
+    da_std::fill(box_start.begin(), box_start.end(), da_int(0));
+    for (da_int i = 0; i < n; ++i)
+        ++box_start[point_box[i * D + last] + 1];
+    for (da_int b = 0; b < n_boxes; ++b)
+        box_start[b + 1] += box_start[b];
+    std::vector<da_int> cursor(box_start.begin(), box_start.end() - 1);
+    for (da_int i = 0; i < n; ++i)
+        sorted_indices[cursor[point_box[i * D + last]]++] = i;
+
+    da_std::fill(charges_hat.begin(), charges_hat.end(), cplx_t(0));
+    const da_int p = n_interp;
+#pragma omp parallel for schedule(dynamic)
+    for (da_int b = 0; b < n_boxes; ++b) {
+        grid_t w[D][MAX_INTERP];
+        grid_t charge[N_CHARGES];
+        for (da_int idx = box_start[b]; idx < box_start[b + 1]; ++idx) {
+            const da_int i = sorted_indices[idx];
+            charge[0] = (grid_t)1;
+            for (da_int d = 0; d < D; ++d) {
+                charge[d + 1] = (grid_t)points[i * D + d];
+                lagrange_weights(charge[d + 1], point_box[i * D + d], w[d]);
+            }
+            if constexpr (D == 1) {
+                for (da_int l = 0; l < p; ++l) {
+                    const da_int node = b * p + l;
+                    for (da_int c = 0; c < N_CHARGES; ++c)
+                        charges_hat[c * grid_size + node] += w[0][l] * charge[c];
+                }
+            } else {
+                const da_int col0 = point_box[i * D] * p;
+                for (da_int ly = 0; ly < p; ++ly) {
+                    const da_int row = (b * p + ly) * fft_len;
+                    for (da_int lx = 0; lx < p; ++lx) {
+                        const grid_t wt = w[1][ly] * w[0][lx];
+                        const da_int node = row + col0 + lx;
+                        for (da_int c = 0; c < N_CHARGES; ++c)
+                            charges_hat[c * grid_size + node] += wt * charge[c];
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T, int8_t D>
+void FFTInterpolationGrid<T, D>::fft(cplx_t *a, bool inverse, da_int active_lines) {
+    const da_int len = fft_len;
+    const cplx_t *tw = twiddle.data();
+    const da_int *rev = bit_reverse.data();
+    if constexpr (D == 1) {
+        (void)active_lines;
+        fft_line(a, len, tw, rev, inverse);
+    } else {
+        // Only the first active_lines rows hold nonzero input (forward) or are
+        // needed in the output (inverse), so the remaining row passes are skipped
+        auto row_pass = [&]() {
+#pragma omp parallel for schedule(static)
+            for (da_int r = 0; r < active_lines; ++r)
+                fft_line(a + r * len, len, tw, rev, inverse);
+        };
+        auto column_pass = [&]() {
+#pragma omp parallel
+            {
+                cplx_t *line = line_work.data() + omp_get_thread_num() * len;
+#pragma omp for schedule(static)
+                for (da_int c = 0; c < len; ++c) {
+                    for (da_int r = 0; r < len; ++r)
+                        line[r] = a[r * len + c];
+                    fft_line(line, len, tw, rev, inverse);
+                    for (da_int r = 0; r < len; ++r)
+                        a[r * len + c] = line[r];
+                }
+            }
+        };
+        if (!inverse) {
+            row_pass();
+            column_pass();
+        } else {
+            column_pass();
+            row_pass();
+        }
+    }
+}
+
+template <typename T, int8_t D> void FFTInterpolationGrid<T, D>::build() {
+    setup_geometry();
+    spread_charges();
+
+    // Kernels 1/(1+r^2) and 1/(1+r^2)^2 sampled at the node offsets, wrapped
+    // around for negative offsets
+    const grid_t h = box_width / (grid_t)n_interp;
+    const da_int len = fft_len;
+    const da_int n_rows = (D == 1) ? 1 : len;
+    auto offset = [&](da_int idx, grid_t &dist) {
+        if (idx < n_nodes) {
+            dist = (grid_t)idx * h;
+            return true;
+        }
+        if (idx > len - n_nodes) {
+            dist = (grid_t)(idx - len) * h;
+            return true;
+        }
+        return false;
+    };
+    cplx_t *k1 = kernel_hat.data();
+    cplx_t *k2 = kernel_hat.data() + grid_size;
+#pragma omp parallel for schedule(static)
+    for (da_int r = 0; r < n_rows; ++r) {
+        grid_t dy = (grid_t)0;
+        const bool row_ok = (D == 1) || offset(r, dy);
+        for (da_int c = 0; c < len; ++c) {
+            grid_t dx = (grid_t)0;
+            grid_t q1 = (grid_t)0;
+            if (row_ok && offset(c, dx))
+                q1 = (grid_t)1 / ((grid_t)1 + dx * dx + dy * dy);
+            k1[r * len + c] = cplx_t(q1);
+            k2[r * len + c] = cplx_t(q1 * q1);
+        }
+    }
+    fft(k1, false, len);
+    fft(k2, false, len);
+
+    for (da_int c = 0; c < N_CHARGES; ++c)
+        fft(charges_hat.data() + c * grid_size, false, n_nodes);
+
+    // Potentials on the nodes: K1 * 1, then K2 * each charge
+    const da_int n_grid_nodes = (D == 1) ? n_nodes : n_nodes * n_nodes;
+    const grid_t scale = (grid_t)1 / (grid_t)grid_size;
+    for (da_int t = 0; t < N_POTENTIALS; ++t) {
+        const cplx_t *kh = (t == 0) ? k1 : k2;
+        const cplx_t *ch = charges_hat.data() + std::max(t - 1, da_int(0)) * grid_size;
+        cplx_t *wk = work.data();
+#pragma omp parallel for schedule(static)
+        for (da_int idx = 0; idx < grid_size; ++idx)
+            wk[idx] = cmul(kh[idx], ch[idx]);
+        fft(wk, true, n_nodes);
+        grid_t *pot = potentials.data() + t * n_grid_nodes;
+        const da_int n_out_rows = (D == 1) ? 1 : n_nodes;
+        for (da_int r = 0; r < n_out_rows; ++r)
+            for (da_int c = 0; c < n_nodes; ++c)
+                pot[r * n_nodes + c] = wk[r * len + c].real() * scale;
+    }
+}
+
+template <typename T, int8_t D>
+void FFTInterpolationGrid<T, D>::interpolate(da_int i, grid_t *phi) const {
+    grid_t w[D][MAX_INTERP];
+    for (da_int d = 0; d < D; ++d)
+        lagrange_weights((grid_t)points[i * D + d], point_box[i * D + d], w[d]);
+    const da_int p = n_interp;
+    const da_int n_grid_nodes = (D == 1) ? n_nodes : n_nodes * n_nodes;
+    for (da_int t = 0; t < N_POTENTIALS; ++t)
+        phi[t] = (grid_t)0;
+    const da_int col0 = point_box[i * D] * p;
+    const da_int n_ly = (D == 1) ? 1 : p;
+    for (da_int ly = 0; ly < n_ly; ++ly) {
+        const da_int row = (D == 1) ? 0 : (point_box[i * D + 1] * p + ly) * n_nodes;
+        const grid_t wy = (D == 1) ? (grid_t)1 : w[D - 1][ly];
+        for (da_int lx = 0; lx < p; ++lx) {
+            const grid_t wt = wy * w[0][lx];
+            const da_int node = row + col0 + lx;
+            for (da_int t = 0; t < N_POTENTIALS; ++t)
+                phi[t] += wt * potentials[t * n_grid_nodes + node];
+        }
+    }
+}
+
+// sum_j q_ij^2 (y_i - y_j) = y_i * sum_j q_ij^2 - sum_j q_ij^2 y_j, where the
+// self-interactions cancel; sum_j q_ij includes the self term q_ii = 1.
+template <typename T, int8_t D>
+void compute_repulsive_forces(const FFTInterpolationGrid<T, D> &grid, da_int n,
+                              T *repulsive, T &sum_q_total,
+                              std::vector<T> &thread_sum_q) {
+    using grid_t = typename FFTInterpolationGrid<T, D>::grid_t;
+    if ((da_int)thread_sum_q.size() < n)
+        thread_sum_q.resize(n);
+
+#pragma omp parallel for schedule(static)
+    for (da_int i = 0; i < n; ++i) {
+        grid_t phi[FFTInterpolationGrid<T, D>::N_POTENTIALS];
+        grid.interpolate(i, phi);
+        for (da_int d = 0; d < D; ++d) {
+            const grid_t y = (grid_t)grid.points[i * D + d];
+            repulsive[i * D + d] = (T)(y * phi[1] - phi[2 + d]);
+        }
+        thread_sum_q[i] = (T)(phi[0] - (grid_t)1);
+    }
+    sum_q_total = (T)0;
+    for (da_int i = 0; i < n; ++i)
+        sum_q_total += thread_sum_q[i];
+
+    if (sum_q_total <= (T)0)
+        sum_q_total = (T)1;
+}
+
+// Explicit template instantiations
+template struct FFTInterpolationGrid<float, 1>;
+template struct FFTInterpolationGrid<float, 2>;
+template struct FFTInterpolationGrid<double, 1>;
+template struct FFTInterpolationGrid<double, 2>;
+template void compute_repulsive_forces<float, 1>(const FFTInterpolationGrid<float, 1> &,
+                                                 da_int, float *, float &,
+                                                 std::vector<float> &);
+template void compute_repulsive_forces<float, 2>(const FFTInterpolationGrid<float, 2> &,
+                                                 da_int, float *, float &,
+                                                 std::vector<float> &);
+template void compute_repulsive_forces<double, 1>(const FFTInterpolationGrid<double, 1> &,
+                                                  da_int, double *, double &,
+                                                  std::vector<double> &);
+template void compute_repulsive_forces<double, 2>(const FFTInterpolationGrid<double, 2> &,
+                                                  da_int, double *, double &,
+                                                  std::vector<double> &);
+#ifdef __AVX512FP16__
+template struct FFTInterpolationGrid<_Float16, 1>;
+template struct FFTInterpolationGrid<_Float16, 2>;
+template void
+compute_repulsive_forces<_Float16, 1>(const FFTInterpolationGrid<_Float16, 1> &, da_int,
+                                      _Float16 *, _Float16 &, std::vector<_Float16> &);
+template void
+compute_repulsive_forces<_Float16, 2>(const FFTInterpolationGrid<_Float16, 2> &, da_int,
+                                      _Float16 *, _Float16 &, std::vector<_Float16> &);
+#endif
+
+} // namespace da_tsne
+
+} // namespace ARCH
@@ -22,6 +22,7 @@
  * ************************************************************************ */
 
 #include "tsne.hpp"
+#include "approximate_neighbors.hpp"
 #include "basic_statistics.hpp"
 #include "da_omp.hpp"
 #include "da_std.hpp"
@@ -161,6 +162,7 @@ template <typename T> void tsne<T>::refresh() {
     embedding.clear();
     iY.clear();
     gains.clear();
+    transform_nn.reset();
     P_row_ptr.clear();
     P_col_idx.clear();
     P_values.clear();
@@ -191,6 +193,10 @@ da_status tsne<T>::set_data(da_int n_samples_in, da_int n_features_in, const T *
     supplied_embedding.clear();
     supplied_n_components = 0;
     has_supplied_embedding = false;
+    supplied_nbr_indices.clear();
+    supplied_nbr_sq_dist.clear();
+    supplied_nbr_k = 0;
+    has_supplied_neighbors = false;
 
     std::string opt_order;
     da_int iorder;
@@ -305,6 +311,81 @@ da_status tsne<T>::set_init_embedding(const T *Y_in, da_int ldy_in) {
     return da_status_success;
 }
 
+template <typename T>
+da_status tsne<T>::set_neighbors(da_int n_samples_in, const da_int *row_ptr,
+                                 const da_int *col_idx, const T *distances) {
+    if (!initdone)
+        return da_error(this->err, da_status_no_data,
+                        "No data has been passed to the handle. Please call "
+                        "da_tsne_set_data_s or da_tsne_set_data_d.");
+    if (n_samples_in != n_samples)
+        return da_error(this->err, da_status_invalid_input,
+                        "n_samples = " + std::to_string(n_samples_in) +
+                            " does not match the number of samples passed to "
+                            "da_tsne_set_data, " +
+                            std::to_string(n_samples) + ".");
+    if (row_ptr == nullptr || col_idx == nullptr || distances == nullptr)
+        return da_error(this->err, da_status_invalid_pointer,
+                        "row_ptr, col_idx and distances must not be null.");
+    if (row_ptr[0] != 0)
+        return da_error(this->err, da_status_invalid_input, "row_ptr[0] must be 0.");
+
+    // Validate the graph and find the widest row, not counting self-loops
+    da_int k = 0;
+    for (da_int i = 0; i < n_samples; ++i) {
+        if (row_ptr[i + 1] < row_ptr[i])
+            return da_error(this->err, da_status_invalid_input,
+                            "row_ptr must be non-decreasing.");
+        da_int row_k = 0;
+        for (da_int idx = row_ptr[i]; idx < row_ptr[i + 1]; ++idx) {
+            const da_int j = col_idx[idx];
+            if (j < 0 || j >= n_samples)
+                return da_error(this->err, da_status_invalid_input,
+                                "col_idx[" + std::to_string(idx) +
+                                    "] is not a valid sample index.");
+            if (!(distances[idx] >= (T)0) || da_std::isinf(distances[idx]))
+                return da_error(this->err, da_status_invalid_input,
+                                "distances[" + std::to_string(idx) +
+                                    "] must be finite and non-negative.");
+            if (j != i)
+                ++row_k;
+        }
+        k = std::max(k, row_k);
+    }
+    if (k == 0)
+        return da_error(this->err, da_status_invalid_input,
+                        "The neighbor graph does not contain any edges.");
+
+    // Store as n-by-k row-major arrays of squared distances, padding short rows
+    // with self-references which receive zero probability
+    try {
+        supplied_nbr_indices.resize(n_samples * k);
+        supplied_nbr_sq_dist.resize(n_samples * k);
+    } catch (std::bad_alloc &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error.");
+    }
+    for (da_int i = 0; i < n_samples; ++i) {
+        da_int filled = 0;
+        for (da_int idx = row_ptr[i]; idx < row_ptr[i + 1]; ++idx) {
+            const da_int j = col_idx[idx];
+            if (j == i)
+                continue;
+            supplied_nbr_indices[i * k + filled] = j;
+            supplied_nbr_sq_dist[i * k + filled] = distances[idx] * distances[idx];
+            ++filled;
+        }
+        for (; filled < k; ++filled) {
+            supplied_nbr_indices[i * k + filled] = i;
+            supplied_nbr_sq_dist[i * k + filled] = (T)0;
+        }
+    }
+    supplied_nbr_k = k;
+    has_supplied_neighbors = true;
+    model_trained = false;
+    return da_status_success;
+}
+
 // Binary search for bandwidth (beta = 1/(2*sigma^2)) to match target perplexity.
 // H(p_i) = log(sum_j exp(-beta*d_ij)) + beta * sum_j d_ij * p_ij = log_perplexity
 template <typename T>
@@ -530,26 +611,96 @@ static da_status compute_distances_knn(da_int k, da_int n, da_int n_features, co
     }
 }
 
+// Compute squared distances using an inverted file index (approximate method).
+// Outputs flat n-by-k row-major arrays, excluding the self-neighbor. Rows for which
+// the probed lists hold fewer than k other points are padded with self-references.
 template <typename T>
-da_status compute_affinities(T perplexity, bool use_exact, da_int n, da_int n_features,
-                             const T *X, da_errors::da_error_t *err,
-                             std::vector<da_int> &P_row_ptr,
-                             std::vector<da_int> &P_col_idx, std::vector<T> &P_values) {
-    const da_int k =
-        use_exact ? (n - 1) : std::min<da_int>(n - 1, (da_int)(3 * perplexity + 1));
+static da_status compute_distances_ivf(da_int k, da_int n, da_int n_features, const T *X,
+                                       da_int n_list, da_int n_probe, da_int seed,
+                                       da_errors::da_error_t *err,
+                                       da_vector::da_vector<da_int> &neighbor_indices,
+                                       da_vector::da_vector<T> &sq_distances) {
 
-    const T log_perplexity = da_std::log(perplexity);
+    if constexpr (std::is_same_v<T, _Float16>) {
+        return da_error(
+            err, da_status_incompatible_options,
+            "The use of mixed precision iterative refinement with float32 data "
+            "is not supported with neighbor algorithm = ivfflat.");
+    } else {
+        da_int k_query = k + 1;
+        n_list = std::min(n_list, n);
+        n_probe = std::min(n_probe, n_list);
+
+        da_approx_nn::approximate_neighbors<T> ann(*err);
+        da_options::OptionRegistry &opts = ann.get_opts();
+        da_status status = opts.set("storage order", "row-major");
+        if (status == da_status_success)
+            status = opts.set("algorithm", "ivfflat");
+        if (status == da_status_success)
+            status = opts.set("metric", "sqeuclidean");
+        if (status == da_status_success)
+            status = opts.set("n_list", n_list);
+        if (status == da_status_success)
+            status = opts.set("n_probe", n_probe);
+        if (status == da_status_success)
+            status = opts.set("seed", seed);
+        if (status != da_status_success)
+            return status; // LCOV_EXCL_LINE
 
-    // Compute squared distances into flat n-by-k arrays
-    da_vector::da_vector<da_int> neighbor_indices;
-    da_vector::da_vector<T> sq_distances;
+        da_vector::da_vector<da_int> n_ind;
+        da_vector::da_vector<T> n_dist;
+        try {
+            n_ind.resize(n * k_query);
+            n_dist.resize(n * k_query);
+            neighbor_indices.resize(n * k);
+            sq_distances.resize(n * k);
+        } catch (std::bad_alloc &) {
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error.");
+        }
 
-    da_status status = use_exact ? compute_distances_exact(n, n_features, X, err,
-                                                           neighbor_indices, sq_distances)
-                                 : compute_distances_knn(k, n, n_features, X, err,
-                                                         neighbor_indices, sq_distances);
-    if (status != da_status_success)
-        return status; // LCOV_EXCL_LINE
+        status = ann.set_training_data(n, n_features, X, n_features);
+        if (status == da_status_success)
+            status = ann.train_and_add();
+        if (status == da_status_success)
+            status = ann.kneighbors(n, n_features, X, n_features, n_ind.data(),
+                                    n_dist.data(), k_query, true);
+        if (status != da_status_success)
+            return da_error_bypass(
+                err, status, "Failed to compute approximate neighbors for affinities.");
+
+        for (da_int i = 0; i < n; ++i) {
+            const da_int in_base = i * k_query;
+            const da_int out_base = i * k;
+            da_int filled = 0;
+            for (da_int t = 0; t < k_query && filled < k; ++t) {
+                const da_int j = n_ind[in_base + t];
+                if (j == i || j < 0)
+                    continue;
+                neighbor_indices[out_base + filled] = j;
+                sq_distances[out_base + filled] = std::max(n_dist[in_base + t], (T)0);
+                ++filled;
+            }
+            for (; filled < k; ++filled) {
+                neighbor_indices[out_base + filled] = i;
+                sq_distances[out_base + filled] = (T)0;
+            }
+        }
+
+        return da_status_success;
+    }
+}
+
+// Trailing entries of a row that reference the row itself are padding and are
+// assigned zero probability.
+template <typename T>
+da_status affinities_from_neighbors(T perplexity, da_int n, da_int k,
+                                    const da_int *neighbor_indices, const T *sq_distances,
+                                    da_errors::da_error_t *err,
+                                    std::vector<da_int> &P_row_ptr,
+                                    std::vector<da_int> &P_col_idx,
+                                    std::vector<T> &P_values) {
+    const T log_perplexity = da_std::log(perplexity);
 
     // Compute conditional probabilities for each row
     da_vector::da_vector<T> neighbor_probs;
@@ -560,14 +711,20 @@ da_status compute_affinities(T perplexity, bool use_exact, da_int n, da_int n_fe
                         "Memory allocation error.");
     }
 #pragma omp parallel for schedule(static) default(none)                                  \
-    shared(sq_distances, neighbor_probs, n, k, log_perplexity)
-    for (da_int i = 0; i < n; ++i)
-        compute_row_probabilities(&sq_distances[i * k], k, log_perplexity,
+    shared(sq_distances, neighbor_indices, neighbor_probs, n, k, log_perplexity)
+    for (da_int i = 0; i < n; ++i) {
+        da_int k_i = k;
+        while (k_i > 0 && neighbor_indices[i * k + k_i - 1] == i)
+            --k_i;
+        compute_row_probabilities(&sq_distances[i * k], k_i, log_perplexity,
                                   &neighbor_probs[i * k]);
+        for (da_int t = k_i; t < k; ++t)
+            neighbor_probs[i * k + t] = (T)0;
+    }
 
     // Symmetrize and convert to CSR
-    status = symmetrize_to_csr(n, k, neighbor_indices.data(), neighbor_probs.data(),
-                               P_row_ptr, P_col_idx, P_values);
+    da_status status = symmetrize_to_csr(n, k, neighbor_indices, neighbor_probs.data(),
+                                         P_row_ptr, P_col_idx, P_values);
     if (status != da_status_success)
         return da_error( // LCOV_EXCL_LINE
             err, status, "Memory allocation error during symmetrization.");
@@ -575,6 +732,37 @@ da_status compute_affinities(T perplexity, bool use_exact, da_int n, da_int n_fe
     return da_status_success;
 }
 
+template <typename T>
+da_status compute_affinities(T perplexity, bool use_exact, da_int n, da_int n_features,
+                             const T *X, da_errors::da_error_t *err,
+                             std::vector<da_int> &P_row_ptr,
+                             std::vector<da_int> &P_col_idx, std::vector<T> &P_values,
+                             da_int n_list, da_int n_probe, da_int seed) {
+    const da_int k =
+        use_exact ? (n - 1) : std::min<da_int>(n - 1, (da_int)(3 * perplexity + 1));
+
+    // Compute squared distances into flat n-by-k arrays
+    da_vector::da_vector<da_int> neighbor_indices;
+    da_vector::da_vector<T> sq_distances;
+
+    da_status status;
+    if (use_exact)
+        status = compute_distances_exact(n, n_features, X, err, neighbor_indices,
+                                         sq_distances);
+    else if (n_list > 0)
+        status = compute_distances_ivf(k, n, n_features, X, n_list, n_probe, seed, err,
+                                       neighbor_indices, sq_distances);
+    else
+        status = compute_distances_knn(k, n, n_features, X, err, neighbor_indices,
+                                       sq_distances);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+
+    return affinities_from_neighbors(perplexity, n, k, neighbor_indices.data(),
+                                     sq_distances.data(), err, P_row_ptr, P_col_idx,
+                                     P_values);
+}
+
 template <typename T>
 da_status tsne<T>::initialize_embedding(const std::string &init_method, da_int seed) {
     if (init_method == "supplied") {
@@ -600,7 +788,7 @@ da_status tsne<T>::initialize_embedding(const std::string &init_method, da_int s
     }
 
     if constexpr (std::is_same_v<T, _Float16>) {
-        if (theta > (T)0) {
+        if (theta > (T)0 || use_fft) {
             return da_error(
                 this->err, da_status_incompatible_options,
                 "The use of mixed precision iterative refinement with float32 data "
@@ -856,15 +1044,25 @@ da_status tsne<T>::gradient_descent_impl(T learning_rate, T early_exaggeration,
                         "Memory allocation error.");
     }
 
-    // Barnes-Hut tree (memory reused across iterations)
+    // Barnes-Hut tree or FFT interpolation grid (memory reused across iterations).
+    // The FFT method is restricted to 1-2D embeddings, which compute() checks.
+    constexpr int8_t D_fft = (D <= 2) ? D : 2;
     std::unique_ptr<BarnesHutTree<T, D>> tree;
-    if (theta > (T)0)
+    std::unique_ptr<FFTInterpolationGrid<T, D_fft>> grid;
+    if constexpr (D <= 2) {
+        if (use_fft)
+            grid = std::make_unique<FFTInterpolationGrid<T, D>>(
+                embedding.data(), n, fft_n_interp, fft_min_intervals,
+                fft_intervals_per_unit);
+    }
+    if (theta > (T)0 && !use_fft)
         tree = std::make_unique<BarnesHutTree<T, D>>(embedding.data(), n, theta);
+    const bool exact = !tree && !grid;
 
     // For exact mode: dense P avoids CSR indirection in the O(n²) gradient loop.
     // P_dense[i*n+i] == 0, so the j-loop is branch-free (j==i contributes 0).
     std::vector<T> P_dense;
-    if (theta == (T)0) {
+    if (exact) {
         try {
             P_dense.resize(n * n, (T)0);
         } catch (std::bad_alloc &) {
@@ -895,16 +1093,24 @@ da_status tsne<T>::gradient_descent_impl(T learning_rate, T early_exaggeration,
             (((iter + 1) % check_interval) == 0) || (iter == max_iter - 1);
         const bool in_early_phase = (effective_iter < early_iters);
 
-        if (theta > 0) {
-            // Barnes-Hut approximation: O(n log n)
+        if (!exact) {
+            // Barnes-Hut approximation, O(n log n), or FFT-accelerated interpolation,
+            // O(n) plus the FFTs on the grid
             try {
-                tree->build();
+                if (grid)
+                    grid->build();
+                else
+                    tree->build();
             } catch (std::bad_alloc &) {
                 return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
                                 "Memory allocation error.");
             }
-            da_tsne::compute_repulsive_forces(*tree, n, repulsive.data(), sum_q_total,
-                                              thread_work);
+            if (grid)
+                da_tsne::compute_repulsive_forces(*grid, n, repulsive.data(),
+                                                  sum_q_total, thread_work);
+            else
+                da_tsne::compute_repulsive_forces(*tree, n, repulsive.data(),
+                                                  sum_q_total, thread_work);
 
             da_tsne::compute_attractive_forces(
                 n, d, exaggeration, P_row_ptr, P_col_idx, P_values, embedding, repulsive,
@@ -1065,6 +1271,10 @@ template <typename T> da_status tsne<T>::lower_precision_init() {
             static_cast<lp_type>(theta), static_cast<lp_type>(lp_min_grad_norm),
             n_iter_without_progress, std::move(P_row_ptr_copy), std::move(P_col_idx_copy),
             std::move(P_values_lp), std::move(embedding_lp), init_method, seed);
+        lp_tsne.use_fft = use_fft;
+        lp_tsne.fft_n_interp = fft_n_interp;
+        lp_tsne.fft_min_intervals = fft_min_intervals;
+        lp_tsne.fft_intervals_per_unit = static_cast<lp_type>(fft_intervals_per_unit);
 
         // If no user-supplied embedding, the LP instance needs X data
         // so that it can initialize its own embedding (PCA or random).
@@ -1138,6 +1348,17 @@ template <typename T> da_status tsne<T>::compute() {
         this->opts.get("learning rate", learning_rate);
         this->opts.get("early exaggeration", early_exaggeration);
         this->opts.get("theta", theta);
+        std::string opt_method;
+        da_int int_method;
+        this->opts.get("gradient method", opt_method, int_method);
+        use_fft = (int_method == 1);
+        this->opts.get("fft interpolation points", fft_n_interp);
+        this->opts.get("fft min intervals", fft_min_intervals);
+        this->opts.get("fft intervals per unit", fft_intervals_per_unit);
+        std::string opt_nbr;
+        this->opts.get("neighbor algorithm", opt_nbr, neighbor_method);
+        this->opts.get("n_list", n_list);
+        this->opts.get("n_probe", n_probe);
         this->opts.get("init", init_method);
         this->opts.get("min_grad_norm", min_grad_norm);
         this->opts.get("n_iter_without_progress", n_iter_without_progress);
@@ -1156,6 +1377,24 @@ template <typename T> da_status tsne<T>::compute() {
         max_iter = max_iter_opt;
     }
 
+    if (use_fft && n_components > 2)
+        return da_error(this->err, da_status_incompatible_options,
+                        "The FFT gradient method is only available for embeddings with "
+                        "1 or 2 components.");
+
+    if (neighbor_method == 1 && theta == (T)0 && !use_fft)
+        return da_error(this->err, da_status_incompatible_options,
+                        "The ivfflat neighbor algorithm cannot be used with theta = 0 "
+                        "and the Barnes-Hut gradient method, which use all pairs of "
+                        "samples. Set theta to a positive value or use the FFT gradient "
+                        "method.");
+
+    if (neighbor_method == 2 && !has_supplied_neighbors && P_row_ptr.empty())
+        return da_error(this->err, da_status_no_data,
+                        "The neighbor algorithm option is set to supplied but no "
+                        "neighbor graph has been passed. Please call "
+                        "da_tsne_set_neighbors_s or da_tsne_set_neighbors_d.");
+
     // At least 4 samples per thread: parallelism needs to be more thoroughly checked
     da_int n_threads = omp_get_max_threads();
     da_int thread_limit = std::min(n_threads, std::max<da_int>(1, n_samples / 4));
@@ -1168,10 +1407,27 @@ template <typename T> da_status tsne<T>::compute() {
     // Execute t-SNE pipeline
     // Skip affinity computation if P matrix is already populated (bypass constructor)
     if (P_row_ptr.empty()) {
-        bool use_exact = (theta == (T)0);
-        da_status status =
-            da_tsne::compute_affinities(perplexity, use_exact, n_samples, n_features, X,
-                                        this->err, P_row_ptr, P_col_idx, P_values);
+        da_status status;
+        if (neighbor_method == 2) {
+            status = da_tsne::affinities_from_neighbors(
+                perplexity, n_samples, supplied_nbr_k, supplied_nbr_indices.data(),
+                supplied_nbr_sq_dist.data(), this->err, P_row_ptr, P_col_idx, P_values);
+        } else {
+            bool use_exact = (theta == (T)0) && !use_fft;
+            // Inverted file index sizes: 0 selects sqrt(n_samples) lists, 1/8 probed
+            da_int n_list_ivf = 0, n_probe_ivf = 0;
+            if (neighbor_method == 1) {
+                n_list_ivf = n_list > 0 ? n_list
+                                        : std::max<da_int>(
+                                              1, (da_int)std::round(std::sqrt(
+                                                     (double)n_samples)));
+                n_probe_ivf = n_probe > 0 ? n_probe : std::max<da_int>(1, n_list_ivf / 8);
+            }
+            status = da_tsne::compute_affinities(perplexity, use_exact, n_samples,
+                                                 n_features, X, this->err, P_row_ptr,
+                                                 P_col_idx, P_values, n_list_ivf,
+                                                 n_probe_ivf, seed);
+        }
         if (status != da_status_success) {
             omp_set_num_threads(n_threads); // LCOV_EXCL_LINE
             return status;                  // LCOV_EXCL_LINE
@@ -1205,11 +1461,208 @@ template <typename T> da_status tsne<T>::compute() {
         return status;                  // LCOV_EXCL_LINE
     }
 
+    fit_perplexity = perplexity;
     model_trained = true;
     omp_set_num_threads(n_threads);
     return da_status_success;
 }
 
+// Each new sample is placed independently: its conditional probabilities over its
+// nearest training samples are fixed and only its own coordinates are optimized
+// against the trained embedding, whose repulsion is approximated by a Barnes-Hut tree.
+template <typename T>
+template <int8_t D>
+da_status tsne<T>::transform_impl(da_int m, const T *X_new, da_int n_iter, T lr,
+                                  T *Y_new) {
+    const da_int k = std::min<da_int>(n_samples, (da_int)(3 * fit_perplexity + 1));
+    const T log_perplexity = da_std::log(fit_perplexity);
+
+    da_vector::da_vector<da_int> nbr_ind;
+    da_vector::da_vector<T> nbr_dist, nbr_prob;
+    try {
+        nbr_ind.resize(m * k);
+        nbr_dist.resize(m * k);
+        nbr_prob.resize(m * k);
+    } catch (std::bad_alloc &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error.");
+    }
+
+    // Build the index over the training data once and reuse it on subsequent calls
+    da_status status = da_status_success;
+    if (!transform_nn) {
+        try {
+            transform_nn = std::make_shared<da_neighbors::neighbors<T>>(*this->err);
+        } catch (std::bad_alloc &) {
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error.");
+        }
+        status = transform_nn->get_opts().set("storage order", "row-major");
+        if (status == da_status_success)
+            status = transform_nn->get_opts().set("algorithm", "auto");
+        if (status == da_status_success)
+            status = transform_nn->get_opts().set("metric", "euclidean");
+        if (status == da_status_success)
+            status = transform_nn->set_data(n_samples, n_features, X, n_features);
+        if (status != da_status_success)
+            transform_nn.reset();
+    }
+    if (status == da_status_success)
+        status = transform_nn->kneighbors(m, n_features, X_new, n_features,
+                                          nbr_ind.data(), nbr_dist.data(), k, true);
+    if (status != da_status_success)
+        return da_error_bypass(this->err, status,
+                               "Failed to compute the nearest training samples.");
+
+#pragma omp parallel for schedule(static) default(none)                                  \
+    shared(m, k, nbr_dist, nbr_prob, log_perplexity)
+    for (da_int i = 0; i < m; ++i) {
+        T *dist = &nbr_dist[i * k];
+        for (da_int t = 0; t < k; ++t)
+            dist[t] *= dist[t];
+        compute_row_probabilities(dist, k, log_perplexity, &nbr_prob[i * k]);
+    }
+
+    BarnesHutTree<T, D> tree(embedding.data(), n_samples, theta);
+    tree.build();
+
+    const T *emb = embedding.data();
+    const da_int mom_switch_iter = n_iter / 4;
+#pragma omp parallel for schedule(dynamic, 16) default(none)                             \
+    shared(m, k, nbr_ind, nbr_prob, tree, emb, n_iter, lr, mom_switch_iter, Y_new,       \
+               min_grad_norm)
+    for (da_int i = 0; i < m; ++i) {
+        int32_t node_stack[BarnesHutTree<T, D>::STACK_SIZE];
+        int32_t depth_stack[BarnesHutTree<T, D>::STACK_SIZE];
+        const da_int *ind = &nbr_ind[i * k];
+        const T *prob = &nbr_prob[i * k];
+
+        // Start from the probability-weighted mean of the neighbors' positions
+        T y[D] = {}, iy[D] = {}, gain[D], grad[D], rep[D], attr[D];
+        for (da_int t = 0; t < k; ++t)
+            for (da_int d = 0; d < D; ++d)
+                y[d] += prob[t] * emb[ind[t] * D + d];
+        for (da_int d = 0; d < D; ++d)
+            gain[d] = (T)1;
+
+        for (da_int iter = 0; iter < n_iter; ++iter) {
+            for (da_int d = 0; d < D; ++d)
+                attr[d] = (T)0;
+            for (da_int t = 0; t < k; ++t) {
+                T delta[D], dist2 = (T)0;
+                for (da_int d = 0; d < D; ++d) {
+                    delta[d] = y[d] - emb[ind[t] * D + d];
+                    dist2 += delta[d] * delta[d];
+                }
+                const T w = prob[t] / ((T)1 + dist2);
+                for (da_int d = 0; d < D; ++d)
+                    attr[d] += w * delta[d];
+            }
+            T sum_q;
+            tree.compute_repulsive_query(y, rep, sum_q, node_stack, depth_stack);
+            const T inv_sum_q = sum_q > (T)0 ? (T)1 / sum_q : (T)0;
+
+            const T momentum = (iter < mom_switch_iter) ? (T)0.5 : (T)0.8;
+            T grad_norm2 = (T)0;
+            for (da_int d = 0; d < D; ++d) {
+                grad[d] = (T)4 * (attr[d] - rep[d] * inv_sum_q);
+                grad_norm2 += grad[d] * grad[d];
+                if (iy[d] * grad[d] < (T)0)
+                    gain[d] += (T)0.2;
+                else
+                    gain[d] *= (T)0.8;
+                gain[d] = std::max(gain[d], (T)0.01);
+                iy[d] = momentum * iy[d] - lr * gain[d] * grad[d];
+                y[d] += iy[d];
+            }
+            if (grad_norm2 < min_grad_norm * min_grad_norm)
+                break;
+        }
+        for (da_int d = 0; d < D; ++d)
+            Y_new[i * D + d] = y[d];
+    }
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status tsne<T>::transform(da_int m_samples, da_int m_features, const T *X_new,
+                             da_int ldx, T *X_transform, da_int ldx_transform) {
+    if (!model_trained)
+        return da_warn(this->err, da_status_no_data,
+                       "t-SNE has not yet been computed. Please call da_tsne_compute_s "
+                       "or da_tsne_compute_d before transforming new data.");
+    if (m_features != n_features)
+        return da_error(this->err, da_status_invalid_input,
+                        "The function was called with m_features = " +
+                            std::to_string(m_features) +
+                            " but t-SNE has been computed with " +
+                            std::to_string(n_features) + " features.");
+
+    da_status status = this->check_2D_array(this->order, m_samples, m_features, X_new,
+                                            ldx, "m_samples", "m_features", "X", "ldx");
+    if (status != da_status_success)
+        return status;
+    status = this->check_2D_array(this->order, m_samples, n_components, X_transform,
+                                  ldx_transform, "m_samples", "n_components",
+                                  "X_transform", "ldx_transform");
+    if (status != da_status_success)
+        return status;
+
+    if constexpr (std::is_same_v<T, _Float16>) {
+        return da_error(this->err, da_status_not_implemented, // LCOV_EXCL_LINE
+                        "Transform is not available in half precision.");
+    } else {
+        da_int n_iter = 250;
+        T lr = (T)1;
+        this->opts.get("transform max_iter", n_iter);
+        this->opts.get("transform learning rate", lr);
+
+        // Contiguous row-major copies of the new data and the new embedding
+        std::vector<T> X_rm, Y_rm;
+        try {
+            Y_rm.resize(m_samples * n_components);
+            if (this->order == column_major || ldx != m_features)
+                X_rm.resize(m_samples * m_features);
+        } catch (std::bad_alloc &) {
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error.");
+        }
+        const T *X_query = X_new;
+        if (!X_rm.empty()) {
+            if (this->order == row_major) {
+                for (da_int i = 0; i < m_samples; ++i)
+                    for (da_int j = 0; j < m_features; ++j)
+                        X_rm[i * m_features + j] = X_new[i * ldx + j];
+            } else {
+                da_utils::copy_transpose_2D_array_column_to_row_major(
+                    m_samples, m_features, X_new, ldx, X_rm.data(), m_features);
+            }
+            X_query = X_rm.data();
+        }
+
+        if (n_components == 1)
+            status = transform_impl<1>(m_samples, X_query, n_iter, lr, Y_rm.data());
+        else if (n_components == 2)
+            status = transform_impl<2>(m_samples, X_query, n_iter, lr, Y_rm.data());
+        else
+            status = transform_impl<3>(m_samples, X_query, n_iter, lr, Y_rm.data());
+        if (status != da_status_success)
+            return status;
+
+        if (this->order == row_major) {
+            for (da_int i = 0; i < m_samples; ++i)
+                for (da_int j = 0; j < n_components; ++j)
+                    X_transform[i * ldx_transform + j] = Y_rm[i * n_components + j];
+        } else {
+            da_utils::copy_transpose_2D_array_row_to_column_major(
+                m_samples, n_components, Y_rm.data(), n_components, X_transform,
+                ldx_transform);
+        }
+        return da_status_success;
+    }
+}
+
 template <typename T>
 da_status tsne<T>::get_result(da_result query, da_int *dim, T *result) {
     if (!model_trained)
@@ -1269,12 +1722,26 @@ template void compute_row_probabilities<float>(const float *, da_int, float, flo
 template da_status compute_affinities<float>(float, bool, da_int, da_int, const float *,
                                              da_errors::da_error_t *,
                                              std::vector<da_int> &, std::vector<da_int> &,
-                                             std::vector<float> &);
+                                             std::vector<float> &, da_int, da_int,
+                                             da_int);
 template da_status compute_affinities<double>(double, bool, da_int, da_int,
                                               const double *, da_errors::da_error_t *,
                                               std::vector<da_int> &,
                                               std::vector<da_int> &,
-                                              std::vector<double> &);
+                                              std::vector<double> &, da_int, da_int,
+                                              da_int);
+template da_status affinities_from_neighbors<float>(float, da_int, da_int, const da_int *,
+                                                    const float *,
+                                                    da_errors::da_error_t *,
+                                                    std::vector<da_int> &,
+                                                    std::vector<da_int> &,
+                                                    std::vector<float> &);
+template da_status affinities_from_neighbors<double>(double, da_int, da_int,
+                                                     const da_int *, const double *,
+                                                     da_errors::da_error_t *,
+                                                     std::vector<da_int> &,
+                                                     std::vector<da_int> &,
+                                                     std::vector<double> &);
 template float compute_kl_divergence<float>(da_int, da_int, const std::vector<da_int> &,
                                             const std::vector<da_int> &,
                                             const std::vector<float> &,
@@ -1332,7 +1799,8 @@ template da_status compute_affinities<_Float16>(_Float16, bool, da_int, da_int,
                                                 const _Float16 *, da_errors::da_error_t *,
                                                 std::vector<da_int> &,
                                                 std::vector<da_int> &,
-                                                std::vector<_Float16> &);
+                                                std::vector<_Float16> &, da_int, da_int,
+                                                da_int);
 template _Float16 compute_kl_divergence<_Float16>(da_int, da_int,
                                                   const std::vector<da_int> &,
                                                   const std::vector<da_int> &,
@@ -28,7 +28,10 @@
 #include "da_error.hpp"
 #include "da_kernel_utils.hpp"
 #include "macros.h"
+#include "nearest_neighbors.hpp"
+#include <complex>
 #include <cstdint>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
@@ -96,6 +99,68 @@ template <typename T, int8_t D> struct BarnesHutTree {
     void compute_repulsive_batch4(const da_int pt_idx[4], T force_out[4][D],
                                   T sum_q_out[4], int32_t *node_stack,
                                   int32_t *depth_stack) const;
+    // Repulsion on a point that is not part of the tree, e.g. a new sample being placed
+    // against a fixed embedding
+    void compute_repulsive_query(const T *query, T force_out[D], T &sum_q_out,
+                                 int32_t *node_stack, int32_t *depth_stack) const;
+};
+
+// ============================================================================
+// FFT-accelerated interpolation (FIt-SNE) grid
+// ============================================================================
+
+// The bounding box of the embedding is split into n_boxes equal intervals per
+// dimension, each holding n_interp equispaced Lagrange nodes, giving a uniform
+// grid with n_nodes = n_boxes * n_interp points per dimension. Charges are spread
+// onto the grid, the kernels 1/(1+r^2) and 1/(1+r^2)^2 are applied to them as
+// zero-padded circular convolutions via FFT and the potentials are interpolated
+// back to the points. Grid quantities use at least single precision.
+template <typename T, int8_t D> struct FFTInterpolationGrid {
+    static_assert(D >= 1 && D <= 2);
+
+    using grid_t = std::conditional_t<std::is_same_v<T, double>, double, float>;
+    using cplx_t = std::complex<grid_t>;
+
+    // Upper bound of the "fft interpolation points" option
+    static constexpr da_int MAX_INTERP = 10;
+    // Charges spread onto the grid: 1, y_1, ..., y_D
+    static constexpr da_int N_CHARGES = D + 1;
+    // Potentials: K1 * 1, K2 * 1, K2 * y_1, ..., K2 * y_D
+    static constexpr da_int N_POTENTIALS = D + 2;
+
+    const T *points = nullptr;
+    da_int n = 0;
+    da_int n_interp = 3;
+    da_int min_intervals = 50;
+    T intervals_per_unit = (T)1;
+
+    // Grid geometry of the last build
+    da_int n_boxes = 0, n_nodes = 0, fft_len = 0, grid_size = 0;
+    grid_t coord_min = (grid_t)0, box_width = (grid_t)1;
+
+    std::vector<grid_t> lagrange_denom; // n_interp
+    std::vector<da_int> point_box;      // n * D box indices
+    std::vector<da_int> box_start;      // n_boxes + 1, buckets of the last dimension
+    std::vector<da_int> sorted_indices; // n, points ordered by bucket
+    std::vector<cplx_t> charges_hat;    // N_CHARGES * grid_size
+    std::vector<cplx_t> kernel_hat;     // 2 * grid_size
+    std::vector<cplx_t> work;           // grid_size
+    std::vector<cplx_t> line_work;      // n_threads * fft_len (2D column passes)
+    std::vector<grid_t> potentials;     // N_POTENTIALS * n_nodes^D
+    std::vector<cplx_t> twiddle;        // fft_len / 2
+    std::vector<da_int> bit_reverse;    // fft_len
+
+    FFTInterpolationGrid(const T *pts, da_int n_in, da_int n_interp_in = 3,
+                         da_int min_intervals_in = 50, T intervals_per_unit_in = (T)1)
+        : points(pts), n(n_in), n_interp(n_interp_in), min_intervals(min_intervals_in),
+          intervals_per_unit(intervals_per_unit_in) {}
+
+    void setup_geometry();
+    void spread_charges();
+    void fft(cplx_t *a, bool inverse, da_int active_lines);
+    void build();
+    void lagrange_weights(grid_t y, da_int box, grid_t *w) const;
+    void interpolate(da_int i, grid_t *phi) const;
 };
 
 // ============================================================================
@@ -138,6 +203,11 @@ template <typename T> class tsne : public basic_handle<T> {
     std::vector<T> supplied_embedding;
     da_int supplied_n_components = 0;
     bool has_supplied_embedding = false;
+    // User-supplied neighbor graph, stored as n_samples-by-supplied_nbr_k arrays
+    std::vector<da_int> supplied_nbr_indices;
+    std::vector<T> supplied_nbr_sq_dist;
+    da_int supplied_nbr_k = 0;
+    bool has_supplied_neighbors = false;
     // Sparse P matrix in CSR format
     std::vector<da_int> P_row_ptr; // Size: n_samples + 1
     std::vector<da_int> P_col_idx; // Size: nnz (number of non-zeros)
@@ -145,13 +215,24 @@ template <typename T> class tsne : public basic_handle<T> {
     T kl_divergence = 0;
     std::vector<T> iY;
     std::vector<T> gains;
+    // Index over the training data used by transform, built on its first call and kept
+    // until the model is refitted. It references X, so the user's data must stay valid.
+    std::shared_ptr<da_neighbors::neighbors<T>> transform_nn;
 
     // Options stored as members (set by option reading or bypass constructor)
     T learning_rate = (T)-1;
     T early_exaggeration = (T)12;
     T theta = (T)0.5;
+    bool use_fft = false;
+    da_int fft_n_interp = 3;
+    da_int fft_min_intervals = 50;
+    T fft_intervals_per_unit = (T)1;
     T min_grad_norm = (T)1e-7;
     da_int n_iter_without_progress = 300;
+    da_int neighbor_method = 0; // 0: exact kNN, 1: IVF index, 2: supplied graph
+    da_int n_list = 0;
+    da_int n_probe = 0;
+    T fit_perplexity = (T)30;
     std::string init_method = "random";
     da_int seed = 0;
 
@@ -164,6 +245,8 @@ template <typename T> class tsne : public basic_handle<T> {
                                     da_int n_iter_without_progress, T min_grad_norm);
 
     da_status lower_precision_init();
+    template <int8_t D>
+    da_status transform_impl(da_int m, const T *X_new, da_int n_iter, T lr, T *Y_new);
 
     attractive_forces_kernel_fn<T> attractive_force_kernel_fn = nullptr;
     void assign_attractive_force_kernel();
@@ -186,7 +269,11 @@ template <typename T> class tsne : public basic_handle<T> {
 
     da_status set_data(da_int n_samples, da_int n_features, const T *X_in, da_int ldx_in);
     da_status set_init_embedding(const T *Y_in, da_int ldy_in);
+    da_status set_neighbors(da_int n_samples_in, const da_int *row_ptr,
+                            const da_int *col_idx, const T *distances);
     da_status compute();
+    da_status transform(da_int m_samples, da_int m_features, const T *X_new, da_int ldx,
+                        T *X_transform, da_int ldx_transform);
 };
 
 // Binary search for bandwidth (precision) to match target perplexity for one row.
@@ -194,16 +281,33 @@ template <typename T>
 void compute_row_probabilities(const T *sq_distances, da_int k, T log_perplexity,
                                T *row_prob);
 
+// n_list > 0 selects an inverted file index with n_list lists, n_probe of which are
+// searched per point, for the approximate (use_exact = false) neighbor graph.
 template <typename T>
 da_status compute_affinities(T perplexity, bool use_exact, da_int n_samples,
                              da_int n_features, const T *X, da_errors::da_error_t *err,
                              std::vector<da_int> &P_row_ptr,
-                             std::vector<da_int> &P_col_idx, std::vector<T> &P_values);
+                             std::vector<da_int> &P_col_idx, std::vector<T> &P_values,
+                             da_int n_list = 0, da_int n_probe = 0, da_int seed = 0);
+
+// Affinities from flat n-by-k row-major neighbor arrays of squared distances.
+template <typename T>
+da_status affinities_from_neighbors(T perplexity, da_int n, da_int k,
+                                    const da_int *neighbor_indices, const T *sq_distances,
+                                    da_errors::da_error_t *err,
+                                    std::vector<da_int> &P_row_ptr,
+                                    std::vector<da_int> &P_col_idx,
+                                    std::vector<T> &P_values);
 
 template <typename T, int8_t D>
 void compute_repulsive_forces(BarnesHutTree<T, D> &tree, da_int n, T *repulsive,
                               T &sum_q_total, std::vector<T> &thread_sum_q);
 
+// Same contract as the Barnes-Hut overload; grid.build() must have been called.
+template <typename T, int8_t D>
+void compute_repulsive_forces(const FFTInterpolationGrid<T, D> &grid, da_int n,
+                              T *repulsive, T &sum_q_total, std::vector<T> &thread_sum_q);
+
 template <typename T>
 T compute_kl_divergence(da_int n, da_int d, const std::vector<da_int> &row_ptr,
                         const std::vector<da_int> &col_idx, const std::vector<T> &p_vals,
@@ -85,11 +85,40 @@ inline da_status register_tsne_options(da_options::OptionRegistry &opts,
             (opt_T)0, da_options::lbound_t::greaterequal, (opt_T)0,
             da_options::ubound_t::p_inf, static_cast<opt_T>(1e-7)));
         opts.register_opt(oT);
+        oT = std::make_shared<OptionNumeric<opt_T>>(OptionNumeric<opt_T>(
+            "transform learning rate",
+            "Gradient descent learning rate used to place each new sample when "
+            "transforming data.",
+            (opt_T)0, da_options::lbound_t::greaterthan, (opt_T)0,
+            da_options::ubound_t::p_inf, static_cast<opt_T>(1)));
+        opts.register_opt(oT);
         oT = std::make_shared<OptionNumeric<opt_T>>(OptionNumeric<opt_T>(
             "theta", "Barnes-Hut approximation parameter (0 for exact).", (opt_T)0,
             da_options::lbound_t::greaterequal, (opt_T)1, da_options::ubound_t::lessequal,
             static_cast<opt_T>(0.5)));
         opts.register_opt(oT);
+        oT = std::make_shared<OptionNumeric<opt_T>>(OptionNumeric<opt_T>(
+            "fft intervals per unit",
+            "Number of grid intervals per unit length of the embedding used by the FFT "
+            "gradient method.",
+            (opt_T)0, da_options::lbound_t::greaterthan, (opt_T)0,
+            da_options::ubound_t::p_inf, static_cast<opt_T>(1)));
+        opts.register_opt(oT);
+
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "fft min intervals",
+            "Minimum number of grid intervals per dimension used by the FFT gradient "
+            "method.",
+            1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            50));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "fft interpolation points",
+            "Number of interpolation points per grid interval and dimension used by the "
+            "FFT gradient method.",
+            1, da_options::lbound_t::greaterequal, 10, da_options::ubound_t::lessequal,
+            3));
+        opts.register_opt(oi);
 
         oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
             "low precision max_iter",
@@ -107,7 +136,45 @@ inline da_status register_tsne_options(da_options::OptionRegistry &opts,
             da_options::ubound_t::p_inf, static_cast<opt_T>(1e-4)));
         opts.register_opt(oT);
 
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "n_list",
+            "Number of lists of the inverted file index used when the neighbor "
+            "algorithm is ivfflat; 0 selects the square root of the number of samples.",
+            0, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            0));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "n_probe",
+            "Number of lists of the inverted file index searched for each sample when "
+            "the neighbor algorithm is ivfflat; 0 selects max(1, n_list / 8).",
+            0, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            0));
+        opts.register_opt(oi);
+
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "transform max_iter",
+            "Maximum number of gradient descent iterations used to place each new sample "
+            "when transforming data.",
+            1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            250));
+        opts.register_opt(oi);
+
         std::shared_ptr<OptionString> os;
+        os = std::make_shared<OptionString>(OptionString(
+            "neighbor algorithm",
+            "Source of the nearest neighbor graph used for the affinities: exact "
+            "k-nearest neighbors, an approximate inverted file index, or a graph passed "
+            "with da_tsne_set_neighbors. Unless a graph is supplied, all pairs are used "
+            "when theta is 0 with the Barnes-Hut gradient method.",
+            {{"exact", 0}, {"ivfflat", 1}, {"supplied", 2}}, "exact"));
+        opts.register_opt(os);
+        os = std::make_shared<OptionString>(OptionString(
+            "gradient method",
+            "Method used to compute the repulsive forces of the gradient: a Barnes-Hut "
+            "tree (exact when theta is 0) or FFT-accelerated interpolation onto a "
+            "uniform grid (1 or 2 embedding dimensions only).",
+            {{"barnes-hut", 0}, {"fft", 1}}, "barnes-hut"));
+        opts.register_opt(os);
         os = std::make_shared<OptionString>(
             OptionString("init", "Initialization method for the embedding.",
                          {{"pca", 0}, {"random", 1}, {"supplied", 2}}, "pca"));
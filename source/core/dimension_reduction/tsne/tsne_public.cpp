@@ -58,6 +58,21 @@ da_status da_tsne_set_init_embedding(da_handle handle, const T *Y, da_int ldy) {
                return (tsne_set_init_embedding<da_tsne::tsne<T>, T>(handle, Y, ldy)));
 }
 
+template <typename T>
+da_status da_tsne_set_neighbors(da_handle handle, da_int n_samples, const da_int *row_ptr,
+                                const da_int *col_idx, const T *distances) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear();
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err, return (tsne_set_neighbors<da_tsne::tsne<T>, T>(
+                                handle, n_samples, row_ptr, col_idx, distances)));
+}
+
 template <typename T> da_status da_tsne_compute(da_handle handle) {
     if (!handle)
         return da_status_handle_not_initialized;
@@ -70,11 +85,36 @@ template <typename T> da_status da_tsne_compute(da_handle handle) {
     DISPATCHER(handle->err, return (tsne_compute<da_tsne::tsne<T>, T>(handle)));
 }
 
+template <typename T>
+da_status da_tsne_transform(da_handle handle, da_int m_samples, da_int m_features,
+                            const T *X, da_int ldx, T *X_transform,
+                            da_int ldx_transform) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear();
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err,
+               return (tsne_transform<da_tsne::tsne<T>, T>(
+                   handle, m_samples, m_features, X, ldx, X_transform, ldx_transform)));
+}
+
 template da_status da_tsne_set_data<float>(da_handle, da_int, da_int, const float *,
                                            da_int);
 template da_status da_tsne_set_data<double>(da_handle, da_int, da_int, const double *,
                                             da_int);
 template da_status da_tsne_set_init_embedding<float>(da_handle, const float *, da_int);
 template da_status da_tsne_set_init_embedding<double>(da_handle, const double *, da_int);
+template da_status da_tsne_set_neighbors<float>(da_handle, da_int, const da_int *,
+                                                const da_int *, const float *);
+template da_status da_tsne_set_neighbors<double>(da_handle, da_int, const da_int *,
+                                                 const da_int *, const double *);
 template da_status da_tsne_compute<float>(da_handle);
-template da_status da_tsne_compute<double>(da_handle);
\ No newline at end of file
+template da_status da_tsne_compute<double>(da_handle);
+template da_status da_tsne_transform<float>(da_handle, da_int, da_int, const float *,
+                                            da_int, float *, da_int);
+template da_status da_tsne_transform<double>(da_handle, da_int, da_int, const double *,
+                                             da_int, double *, da_int);
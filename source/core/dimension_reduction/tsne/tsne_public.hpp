@@ -49,6 +49,17 @@ da_status tsne_set_init_embedding(da_handle handle, const T *Y, da_int ldy) {
     return tsne->set_init_embedding(Y, ldy);
 }
 
+template <typename tsne_class, typename T>
+da_status tsne_set_neighbors(da_handle handle, da_int n_samples, const da_int *row_ptr,
+                             const da_int *col_idx, const T *distances) {
+    tsne_class *tsne = dynamic_cast<tsne_class *>(handle->get_alg_handle<T>());
+    if (tsne == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_tsne or "
+                        "handle is invalid.");
+    return tsne->set_neighbors(n_samples, row_ptr, col_idx, distances);
+}
+
 template <typename tsne_class, typename T> da_status tsne_compute(da_handle handle) {
     tsne_class *tsne = dynamic_cast<tsne_class *>(handle->get_alg_handle<T>());
     if (tsne == nullptr)
@@ -58,4 +69,15 @@ template <typename tsne_class, typename T> da_status tsne_compute(da_handle hand
     return tsne->compute();
 }
 
+template <typename tsne_class, typename T>
+da_status tsne_transform(da_handle handle, da_int m_samples, da_int m_features,
+                         const T *X, da_int ldx, T *X_transform, da_int ldx_transform) {
+    tsne_class *tsne = dynamic_cast<tsne_class *>(handle->get_alg_handle<T>());
+    if (tsne == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_tsne or "
+                        "handle is invalid.");
+    return tsne->transform(m_samples, m_features, X, ldx, X_transform, ldx_transform);
+}
+
 } // namespace tsne_public
@@ -0,0 +1,1061 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "umap.hpp"
+#include "approximate_neighbors.hpp"
+#include "da_omp.hpp"
+#include "da_std.hpp"
+#include "da_utils.hpp"
+#include "nearest_neighbors.hpp"
+#include "pca/pca.hpp"
+#include "umap_options.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+
+namespace ARCH {
+
+namespace da_umap {
+
+using namespace da_model_persistence;
+
+// Number of consecutive edges processed by one task of the layout optimization; each
+// block draws its negative samples from its own random stream
+constexpr da_int edge_block_size = 4096;
+
+template <typename T> umap<T>::umap(da_errors::da_error_t &err) : basic_handle<T>(err) {
+    register_umap_options<T>(this->opts, *this->err);
+}
+
+template <typename T> void umap<T>::refresh() {
+    this->model_trained = false;
+    a = (T)0;
+    b = (T)0;
+    embedding.clear();
+    graph_row_ptr.clear();
+    graph_col_idx.clear();
+    graph_values.clear();
+    nn_index.reset();
+    ann_index.reset();
+}
+
+template <typename T>
+da_status umap<T>::set_data(da_int n_samples_in, da_int n_features_in, const T *X_in,
+                            da_int ldx_in) {
+    refresh();
+
+    X = nullptr;
+    X_copy.clear();
+    initdone = false;
+
+    std::string opt_order;
+    da_int iorder;
+    da_status status = this->opts.get("storage order", opt_order, iorder);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+    this->order = da_order(iorder);
+
+    status = this->check_2D_array(this->order, n_samples_in, n_features_in, X_in, ldx_in,
+                                  "n_samples", "n_features", "X", "ldx", 2, 1);
+    if (status != da_status_success)
+        return status;
+
+    n_samples = n_samples_in;
+    n_features = n_features_in;
+
+    // Copy if not compact row-major format
+    if (this->order == row_major && ldx_in == n_features) {
+        X = X_in;
+    } else {
+        try {
+            X_copy.resize(n_samples * n_features);
+        } catch (std::bad_alloc &) {
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error.");
+        }
+        if (this->order == row_major) {
+            for (da_int i = 0; i < n_samples; ++i)
+                for (da_int j = 0; j < n_features; ++j)
+                    X_copy[i * n_features + j] = X_in[i * ldx_in + j];
+        } else {
+            da_utils::copy_transpose_2D_array_column_to_row_major(
+                n_samples, n_features, X_in, ldx_in, X_copy.data(), n_features);
+        }
+        X = X_copy.data();
+    }
+
+    initdone = true;
+    return da_status_success;
+}
+
+template <typename T> da_status umap<T>::read_options() {
+    std::string opt;
+    this->opts.get("n_components", n_components);
+    this->opts.get("n_neighbors", n_neighbors);
+    this->opts.get("n_epochs", n_epochs);
+    this->opts.get("negative sample rate", negative_sample_rate);
+    this->opts.get("seed", seed);
+    this->opts.get("n_list", n_list);
+    this->opts.get("n_probe", n_probe);
+    this->opts.get("min_dist", min_dist);
+    this->opts.get("spread", spread);
+    this->opts.get("learning rate", learning_rate);
+    this->opts.get("repulsion strength", repulsion_strength);
+    this->opts.get("init", opt, init_method);
+    this->opts.get("neighbor algorithm", opt, neighbor_method);
+
+    if (n_components >= n_samples)
+        return da_error(this->err, da_status_incompatible_options,
+                        "n_components = " + std::to_string(n_components) +
+                            " must be smaller than the number of samples, n_samples = " +
+                            std::to_string(n_samples) + ".");
+    if (init_method == 0 && n_components > n_features)
+        return da_error(this->err, da_status_incompatible_options,
+                        "PCA initialization requires n_components to be at most "
+                        "n_features = " +
+                            std::to_string(n_features) +
+                            ". Set the option init to random instead.");
+    return da_status_success;
+}
+
+/* Build the exact or inverted file index over the training data used by
+   nearest_neighbors. */
+template <typename T> da_status umap<T>::build_neighbor_index() {
+    nn_index.reset();
+    ann_index.reset();
+    da_status status;
+    if (neighbor_method == 0) {
+        try {
+            nn_index = std::make_shared<da_neighbors::neighbors<T>>(*this->err);
+        } catch (std::bad_alloc &) {
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error.");
+        }
+        da_options::OptionRegistry &opts = nn_index->get_opts();
+        status = opts.set("storage order", "row-major");
+        if (status == da_status_success)
+            status = opts.set("algorithm", "auto");
+        if (status == da_status_success)
+            status = opts.set("metric", "euclidean");
+        if (status == da_status_success)
+            status = nn_index->set_data(n_samples, n_features, X, n_features);
+        if (status != da_status_success) {
+            nn_index.reset();
+            return da_error_bypass( // LCOV_EXCL_LINE
+                this->err, status, "Failed to build the nearest neighbor index.");
+        }
+    } else {
+        da_int nl = n_list > 0 ? n_list
+                               : std::max<da_int>(1, (da_int)std::sqrt((T)n_samples));
+        nl = std::min(nl, n_samples);
+        da_int np = n_probe > 0 ? n_probe : std::max<da_int>(1, nl / 8);
+        np = std::min(np, nl);
+
+        try {
+            ann_index =
+                std::make_shared<da_approx_nn::approximate_neighbors<T>>(*this->err);
+        } catch (std::bad_alloc &) {
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error.");
+        }
+        da_options::OptionRegistry &opts = ann_index->get_opts();
+        status = opts.set("storage order", "row-major");
+        if (status == da_status_success)
+            status = opts.set("algorithm", "ivfflat");
+        if (status == da_status_success)
+            status = opts.set("metric", "sqeuclidean");
+        if (status == da_status_success)
+            status = opts.set("n_list", nl);
+        if (status == da_status_success)
+            status = opts.set("n_probe", np);
+        if (status == da_status_success)
+            status = opts.set("seed", seed);
+        if (status == da_status_success)
+            status = ann_index->set_training_data(n_samples, n_features, X, n_features);
+        if (status == da_status_success)
+            status = ann_index->train_and_add();
+        if (status != da_status_success) {
+            ann_index.reset();
+            return da_error_bypass(this->err, status,
+                                   "Failed to build the approximate neighbor index.");
+        }
+    }
+    return da_status_success;
+}
+
+/* Neighbors of the m rows of X_query among the training data, in increasing order of
+   Euclidean distance. The output arrays are m-by-k, row-major. When exclude_self is
+   true the queries are the training data and each sample is removed from its own list.
+   Rows for which an approximate search returns fewer than k points are padded with
+   index -1 and infinite distance. The index must have been built by
+   build_neighbor_index; it is only queried here. */
+template <typename T>
+da_status umap<T>::nearest_neighbors(da_errors::da_error_t *err, da_int m,
+                                     const T *X_query, da_int k, bool exclude_self,
+                                     std::vector<da_int> &nbr_ind,
+                                     std::vector<T> &nbr_dist) {
+    if (!nn_index && !ann_index)
+        return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "The neighbor index has not been built.");
+    da_int k_query = exclude_self ? std::min(k + 1, n_samples) : k;
+
+    std::vector<da_int> n_ind;
+    std::vector<T> n_dist;
+    try {
+        n_ind.resize(m * k_query);
+        n_dist.resize(m * k_query);
+        nbr_ind.resize(m * k);
+        nbr_dist.resize(m * k);
+    } catch (std::bad_alloc &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error.");
+    }
+
+    da_status status;
+    std::lock_guard<std::mutex> lock(index_mutex);
+    if (nn_index) {
+        status = nn_index->kneighbors(m, n_features, X_query, n_features, n_ind.data(),
+                                      n_dist.data(), k_query, true);
+        if (status != da_status_success)
+            return da_error_bypass( // LCOV_EXCL_LINE
+                err, status, "Failed to compute the nearest neighbors.");
+    } else {
+        status = ann_index->kneighbors(m, n_features, X_query, n_features, n_ind.data(),
+                                       n_dist.data(), k_query, true);
+        if (status != da_status_success)
+            return da_error_bypass(err, status,
+                                   "Failed to compute the approximate neighbors.");
+        for (T &d : n_dist)
+            d = std::sqrt(std::max(d, (T)0));
+    }
+
+    for (da_int i = 0; i < m; ++i) {
+        da_int filled = 0;
+        for (da_int t = 0; t < k_query && filled < k; ++t) {
+            const da_int j = n_ind[i * k_query + t];
+            if (j < 0 || (exclude_self && j == i))
+                continue;
+            nbr_ind[i * k + filled] = j;
+            nbr_dist[i * k + filled] = n_dist[i * k_query + t];
+            ++filled;
+        }
+        for (; filled < k; ++filled) {
+            nbr_ind[i * k + filled] = -1;
+            nbr_dist[i * k + filled] = std::numeric_limits<T>::infinity();
+        }
+    }
+
+    return da_status_success;
+}
+
+/* PCA initialization is scaled so that the largest coordinate has magnitude 10 and is
+   perturbed slightly to separate duplicate samples; random initialization is uniform
+   in [-10, 10]. Each coordinate is then rescaled to [0, 10]. */
+template <typename T> da_status umap<T>::initialize_embedding(std::mt19937_64 &rng) {
+    try {
+        embedding.resize(n_samples * n_components);
+    } catch (std::bad_alloc &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error.");
+    }
+
+    if (init_method == 0) {
+        da_pca::pca<T> pca(*this->err);
+        auto &opts = pca.get_opts();
+        opts.set("storage order", "row-major");
+        opts.set("n_components", n_components);
+        opts.set("pca method", "covariance");
+        opts.set("seed", seed);
+
+        da_status status = pca.init(n_samples, n_features, X, n_features);
+        if (status == da_status_success)
+            status = pca.compute();
+        if (status == da_status_success)
+            status = pca.transform(n_samples, n_features, X, n_features, embedding.data(),
+                                   n_components);
+        if (status != da_status_success)
+            return da_error_bypass(this->err, status, // LCOV_EXCL_LINE
+                                   "PCA initialization of the embedding failed.");
+
+        T max_abs = (T)0;
+        for (const T &v : embedding)
+            max_abs = std::max(max_abs, std::abs(v));
+        T scale = max_abs > (T)0 ? (T)10 / max_abs : (T)1;
+        std::normal_distribution<T> noise((T)0, (T)1e-4);
+        for (T &v : embedding)
+            v = v * scale + noise(rng);
+    } else {
+        std::uniform_real_distribution<T> uniform((T)-10, (T)10);
+        for (T &v : embedding)
+            v = uniform(rng);
+    }
+
+    for (da_int c = 0; c < n_components; ++c) {
+        T lo = std::numeric_limits<T>::max(), hi = std::numeric_limits<T>::lowest();
+        for (da_int i = 0; i < n_samples; ++i) {
+            lo = std::min(lo, embedding[i * n_components + c]);
+            hi = std::max(hi, embedding[i * n_components + c]);
+        }
+        if (hi - lo <= (T)0)
+            continue;
+        T scale = (T)10 / (hi - lo);
+        for (da_int i = 0; i < n_samples; ++i) {
+            T &v = embedding[i * n_components + c];
+            v = (v - lo) * scale;
+        }
+    }
+
+    return da_status_success;
+}
+
+template <typename T> da_status umap<T>::compute() {
+    if (!initdone)
+        return da_warn(this->err, da_status_no_data,
+                       "No data has been passed to the handle. Please call "
+                       "da_umap_set_data_s or da_umap_set_data_d.");
+
+    refresh();
+    da_status status = read_options();
+    if (status != da_status_success)
+        return status;
+
+    // Neighbors of each sample, not counting the sample itself
+    da_int k_total = std::min(n_neighbors, n_samples);
+    da_int k = k_total - 1;
+    std::vector<da_int> nbr_ind;
+    std::vector<T> nbr_dist, weights;
+    status = build_neighbor_index();
+    if (status == da_status_success)
+        status = nearest_neighbors(this->err, n_samples, X, k, true, nbr_ind, nbr_dist);
+    if (status != da_status_success)
+        return status;
+    try {
+        weights.resize(n_samples * k);
+    } catch (std::bad_alloc &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error.");
+    }
+
+    T mean_dist = (T)0;
+    da_int n_finite = 0;
+    for (const T &d : nbr_dist) {
+        if (std::isfinite(d)) {
+            mean_dist += d;
+            ++n_finite;
+        }
+    }
+    mean_dist = n_finite > 0 ? mean_dist / n_finite : (T)0;
+
+    const T log2_neighbors = std::log2((T)k_total);
+    const da_int n = n_samples;
+#pragma omp parallel for schedule(static) default(none)                                  \
+    shared(n, k, log2_neighbors, mean_dist, nbr_dist, weights)
+    for (da_int i = 0; i < n; ++i)
+        smooth_knn_row(&nbr_dist[i * k], k, log2_neighbors, true, mean_dist,
+                       &weights[i * k]);
+
+    status = fuzzy_union_to_csr(n_samples, k, nbr_ind.data(), weights.data(),
+                                graph_row_ptr, graph_col_idx, graph_values);
+    if (status != da_status_success)
+        return da_error(this->err, status, // LCOV_EXCL_LINE
+                        "Memory allocation error.");
+
+    find_ab_params(spread, min_dist, a, b);
+    if (n_epochs == 0)
+        n_epochs = n_samples <= 10000 ? 500 : 200;
+
+    std::mt19937_64 rng;
+    if (seed == -1) {
+        std::random_device rd;
+        rng.seed(rd());
+    } else {
+        rng.seed(seed);
+    }
+
+    status = initialize_embedding(rng);
+    if (status != da_status_success)
+        return status;
+
+    da_int n_edges = graph_row_ptr[n_samples];
+    std::vector<da_int> head;
+    try {
+        head.resize(n_edges);
+    } catch (std::bad_alloc &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error.");
+    }
+    for (da_int i = 0; i < n_samples; ++i)
+        for (da_int e = graph_row_ptr[i]; e < graph_row_ptr[i + 1]; ++e)
+            head[e] = i;
+
+    optimize_layout(n_components, n_edges, head.data(), graph_col_idx.data(),
+                    graph_values.data(), embedding.data(), embedding.data(), n_samples,
+                    n_epochs, a, b, repulsion_strength, learning_rate,
+                    negative_sample_rate, true, (uint64_t)rng());
+
+    this->model_trained = true;
+    return da_status_success;
+}
+
+/* New samples are attached to their nearest neighbors in the training data and placed
+   at the weighted mean of the neighbors' positions, then optimized against the fixed
+   training embedding for a third of the training epochs. */
+template <typename T>
+da_status umap<T>::transform(da_int m_samples, da_int m_features, const T *X_new,
+                             da_int ldx, T *X_transform, da_int ldx_transform) {
+    _da_inference_context ctx;
+    ctx.err = this->err;
+    return transform(ctx, m_samples, m_features, X_new, ldx, X_transform, ldx_transform);
+}
+
+template <typename T>
+da_status umap<T>::transform(_da_inference_context &ctx, da_int m_samples,
+                             da_int m_features, const T *X_new, da_int ldx,
+                             T *X_transform, da_int ldx_transform) {
+    da_errors::da_error_t *err = ctx.err;
+    if (!this->model_trained)
+        return da_warn(err, da_status_no_data,
+                       "UMAP has not yet been computed. Please call da_umap_compute_s "
+                       "or da_umap_compute_d before transforming new data.");
+    if (m_features != n_features)
+        return da_error(err, da_status_invalid_input,
+                        "The function was called with m_features = " +
+                            std::to_string(m_features) +
+                            " but UMAP has been computed with " +
+                            std::to_string(n_features) + " features.");
+
+    da_status status =
+        this->check_2D_array(err, this->order, m_samples, m_features, X_new, ldx,
+                             "m_samples", "m_features", "X", "ldx");
+    if (status != da_status_success)
+        return status;
+    status = this->check_2D_array(err, this->order, m_samples, n_components,
+                                  X_transform, ldx_transform, "m_samples",
+                                  "n_components", "X_transform", "ldx_transform");
+    if (status != da_status_success)
+        return status;
+
+    // Contiguous row-major copies of the new data and the new embedding
+    std::vector<T> X_rm, Y_rm;
+    try {
+        Y_rm.resize(m_samples * n_components, (T)0);
+        if (this->order == column_major || ldx != m_features)
+            X_rm.resize(m_samples * m_features);
+    } catch (std::bad_alloc &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error.");
+    }
+    const T *X_query = X_new;
+    if (!X_rm.empty()) {
+        if (this->order == row_major) {
+            for (da_int i = 0; i < m_samples; ++i)
+                for (da_int j = 0; j < m_features; ++j)
+                    X_rm[i * m_features + j] = X_new[i * ldx + j];
+        } else {
+            da_utils::copy_transpose_2D_array_column_to_row_major(
+                m_samples, m_features, X_new, ldx, X_rm.data(), m_features);
+        }
+        X_query = X_rm.data();
+    }
+
+    da_int k = std::min(n_neighbors, n_samples);
+    std::vector<da_int> nbr_ind;
+    std::vector<T> nbr_dist, weights;
+    status = nearest_neighbors(err, m_samples, X_query, k, false, nbr_ind, nbr_dist);
+    if (status != da_status_success)
+        return status;
+    try {
+        weights.resize(m_samples * k);
+    } catch (std::bad_alloc &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error.");
+    }
+
+    T mean_dist = (T)0;
+    da_int n_finite = 0;
+    for (const T &d : nbr_dist) {
+        if (std::isfinite(d)) {
+            mean_dist += d;
+            ++n_finite;
+        }
+    }
+    mean_dist = n_finite > 0 ? mean_dist / n_finite : (T)0;
+
+    const T log2_neighbors = std::log2((T)k);
+    const da_int d = n_components;
+    const T *emb = embedding.data();
+    T *Y = Y_rm.data();
+#pragma omp parallel for schedule(static) default(none)                                  \
+    shared(m_samples, k, d, log2_neighbors, mean_dist, nbr_ind, nbr_dist, weights, emb, Y)
+    for (da_int i = 0; i < m_samples; ++i) {
+        smooth_knn_row(&nbr_dist[i * k], k, log2_neighbors, false, mean_dist,
+                       &weights[i * k]);
+        T w_sum = (T)0;
+        da_int n_valid = 0;
+        for (da_int t = 0; t < k; ++t) {
+            if (nbr_ind[i * k + t] >= 0) {
+                w_sum += weights[i * k + t];
+                ++n_valid;
+            }
+        }
+        for (da_int t = 0; t < k; ++t) {
+            const da_int j = nbr_ind[i * k + t];
+            if (j < 0)
+                continue;
+            T w = w_sum > (T)0 ? weights[i * k + t] / w_sum : (T)1 / n_valid;
+            for (da_int c = 0; c < d; ++c)
+                Y[i * d + c] += w * emb[j * d + c];
+        }
+    }
+
+    std::vector<da_int> head, tail;
+    std::vector<T> edge_weights;
+    try {
+        head.reserve(m_samples * k);
+        tail.reserve(m_samples * k);
+        edge_weights.reserve(m_samples * k);
+    } catch (std::bad_alloc &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error.");
+    }
+    for (da_int i = 0; i < m_samples; ++i) {
+        for (da_int t = 0; t < k; ++t) {
+            if (nbr_ind[i * k + t] >= 0 && weights[i * k + t] > (T)0) {
+                head.push_back(i);
+                tail.push_back(nbr_ind[i * k + t]);
+                edge_weights.push_back(weights[i * k + t]);
+            }
+        }
+    }
+
+    std::mt19937_64 rng;
+    if (seed == -1) {
+        std::random_device rd;
+        rng.seed(rd());
+    } else {
+        rng.seed(seed);
+    }
+    da_int n_epochs_transform = std::max<da_int>(1, n_epochs / 3);
+    optimize_layout(n_components, (da_int)head.size(), head.data(), tail.data(),
+                    edge_weights.data(), Y_rm.data(), embedding.data(), n_samples,
+                    n_epochs_transform, a, b, repulsion_strength, learning_rate / (T)4,
+                    negative_sample_rate, false, (uint64_t)rng());
+
+    if (this->order == row_major) {
+        for (da_int i = 0; i < m_samples; ++i)
+            for (da_int j = 0; j < n_components; ++j)
+                X_transform[i * ldx_transform + j] = Y_rm[i * n_components + j];
+    } else {
+        da_utils::copy_transpose_2D_array_row_to_column_major(
+            m_samples, n_components, Y_rm.data(), n_components, X_transform,
+            ldx_transform);
+    }
+    return da_status_success;
+}
+
+template <typename T>
+da_status umap<T>::get_result(da_result query, da_int *dim, T *result) {
+    if (!this->model_trained)
+        return da_warn(this->err, da_status_no_data,
+                       "UMAP has not yet been computed. Please call da_umap_compute_s "
+                       "or da_umap_compute_d before extracting results.");
+    switch (query) {
+    case da_rinfo: {
+        da_int rinfo_size = 6;
+        if (*dim < rinfo_size) {
+            *dim = rinfo_size;
+            return da_status_invalid_array_dimension;
+        }
+        result[0] = (T)n_samples;
+        result[1] = (T)n_features;
+        result[2] = (T)n_components;
+        result[3] = (T)n_epochs;
+        result[4] = a;
+        result[5] = b;
+        return da_status_success;
+    }
+    case da_umap_embedding: {
+        da_int required = n_samples * n_components;
+        if (*dim < required) {
+            *dim = required;
+            return da_status_invalid_array_dimension;
+        }
+        if (this->order == row_major) {
+            da_std::copy(embedding.begin(), embedding.end(), result);
+        } else {
+            da_utils::copy_transpose_2D_array_row_to_column_major(
+                n_samples, n_components, embedding.data(), n_components, result,
+                n_samples);
+        }
+        return da_status_success;
+    }
+    default:
+        return da_error(this->err, da_status_unknown_query,
+                        "The requested result is not available for UMAP.");
+    }
+}
+
+template <typename T>
+da_status umap<T>::get_result(da_result query, da_int *dim, da_int *result) {
+    (void)query;
+    (void)dim;
+    (void)result;
+    return da_error(this->err, da_status_unknown_query,
+                    "There are no integer results available for this API.");
+}
+
+template <typename T> da_status umap<T>::serialize(serialization_buffer &buffer) {
+
+    da_status status = da_status_success;
+    auto io_dispatch = [&buffer, &status](auto &data) -> void {
+        if (status != da_status_success) {
+            return;
+        }
+        status = buffer.dispatch_buffer_io(data);
+        return;
+    };
+
+    io_dispatch(this->order);
+    io_dispatch(this->model_trained);
+    io_dispatch(initdone);
+    io_dispatch(n_samples);
+    io_dispatch(n_features);
+    io_dispatch(n_components);
+    io_dispatch(n_neighbors);
+    io_dispatch(n_epochs);
+    io_dispatch(a);
+    io_dispatch(b);
+    io_dispatch(min_dist);
+    io_dispatch(spread);
+    io_dispatch(learning_rate);
+    io_dispatch(repulsion_strength);
+    io_dispatch(negative_sample_rate);
+    io_dispatch(neighbor_method);
+    io_dispatch(n_list);
+    io_dispatch(n_probe);
+    io_dispatch(init_method);
+    io_dispatch(seed);
+    io_dispatch(embedding);
+    io_dispatch(graph_row_ptr);
+    io_dispatch(graph_col_idx);
+    io_dispatch(graph_values);
+    if (status != da_status_success)
+        return status;
+
+    // The training data are needed to find the neighbors of new samples
+    if (buffer.get_mode() != deserialize) {
+        status = buffer.serialize_user_data(X, row_major, n_samples, n_features,
+                                            n_features);
+    } else {
+        io_dispatch(X_copy);
+        X = X_copy.data();
+    }
+
+    return status;
+}
+
+template <typename T> da_status umap<T>::save_model(serialization_buffer &buffer) {
+    if (!this->model_trained)
+        return da_error(this->err, da_status_no_data,
+                        "UMAP has not yet been computed. Please call da_umap_compute_s "
+                        "or da_umap_compute_d before saving the model.");
+
+    da_status status = basic_handle<T>::save_model(buffer);
+    if (status != da_status_success)
+        return da_error_trace(this->err, status, "Failure serializing model.");
+
+    return status;
+}
+
+template <typename T> da_status umap<T>::load_model(serialization_buffer &buffer) {
+    da_status status = basic_handle<T>::load_model(buffer);
+    if (status != da_status_success)
+        return da_error_trace(this->err, status, "Failure deserializing model.");
+
+    // Rebuild the index used by transform over the stored training data
+    if (this->model_trained)
+        status = build_neighbor_index();
+    return status;
+}
+
+template class umap<double>;
+template class umap<float>;
+
+/* Levenberg-Marquardt fit of the two curve parameters on a regular grid of 300 points
+   in [0, 3 * spread], starting from a = b = 1. */
+template <typename T> void find_ab_params(T spread, T min_dist, T &a, T &b) {
+    constexpr da_int n_points = 300;
+    constexpr da_int max_iter = 200;
+    std::vector<double> x(n_points), y(n_points);
+    for (da_int i = 0; i < n_points; ++i) {
+        x[i] = 3.0 * (double)spread * (double)i / (double)(n_points - 1);
+        y[i] = x[i] < (double)min_dist ? 1.0
+                                       : std::exp(-(x[i] - (double)min_dist) / spread);
+    }
+
+    auto residual_norm = [&x, &y](double pa, double pb) {
+        double sum = 0.0;
+        for (da_int i = 0; i < n_points; ++i) {
+            double f = x[i] > 0.0 ? 1.0 / (1.0 + pa * std::pow(x[i], 2.0 * pb)) : 1.0;
+            sum += (f - y[i]) * (f - y[i]);
+        }
+        return sum;
+    };
+
+    double pa = 1.0, pb = 1.0, lambda = 1e-3;
+    double fval = residual_norm(pa, pb);
+    for (da_int iter = 0; iter < max_iter; ++iter) {
+        // Normal equations of the Gauss-Newton step
+        double jaa = 0.0, jab = 0.0, jbb = 0.0, ga = 0.0, gb = 0.0;
+        for (da_int i = 0; i < n_points; ++i) {
+            if (x[i] <= 0.0)
+                continue;
+            double u = std::pow(x[i], 2.0 * pb);
+            double f = 1.0 / (1.0 + pa * u);
+            double r = f - y[i];
+            double da = -u * f * f;
+            double db = -2.0 * pa * u * std::log(x[i]) * f * f;
+            jaa += da * da;
+            jab += da * db;
+            jbb += db * db;
+            ga += da * r;
+            gb += db * r;
+        }
+
+        bool accepted = false;
+        double fnew = fval;
+        while (!accepted && lambda < 1e12) {
+            double maa = jaa * (1.0 + lambda), mbb = jbb * (1.0 + lambda);
+            double det = maa * mbb - jab * jab;
+            if (det > 0.0) {
+                double step_a = -(mbb * ga - jab * gb) / det;
+                double step_b = -(maa * gb - jab * ga) / det;
+                double na = pa + step_a, nb = pb + step_b;
+                if (na > 0.0 && nb > 0.0) {
+                    fnew = residual_norm(na, nb);
+                    if (fnew <= fval) {
+                        pa = na;
+                        pb = nb;
+                        accepted = true;
+                    }
+                }
+            }
+            lambda = accepted ? std::max(lambda / 10.0, 1e-12) : lambda * 10.0;
+        }
+        if (!accepted || fval - fnew <= 1e-14 * fval)
+            break;
+        fval = fnew;
+    }
+
+    a = (T)pa;
+    b = (T)pb;
+}
+
+/* The bandwidth sigma is found by bisection so that the sum of exp(-(d_j - rho) / sigma)
+   over the neighbors equals log2(n_neighbors), with a lower bound relative to the mean
+   distance to avoid degenerate weights. */
+template <typename T>
+void smooth_knn_row(const T *dist, da_int k, T log2_neighbors, bool use_rho,
+                    T mean_dist, T *weights) {
+    constexpr da_int max_iter = 64;
+    constexpr T tol = (T)1e-5;
+    constexpr T min_scale = (T)1e-3;
+
+    T rho = (T)0;
+    if (use_rho) {
+        for (da_int j = 0; j < k; ++j) {
+            if (dist[j] > (T)0) {
+                rho = dist[j];
+                break;
+            }
+        }
+    }
+
+    T lo = (T)0, hi = std::numeric_limits<T>::infinity(), sigma = (T)1;
+    for (da_int iter = 0; iter < max_iter; ++iter) {
+        T psum = (T)0;
+        for (da_int j = 0; j < k; ++j) {
+            T d = dist[j] - rho;
+            psum += d > (T)0 ? std::exp(-d / sigma) : (T)1;
+        }
+        if (std::abs(psum - log2_neighbors) < tol)
+            break;
+        if (psum > log2_neighbors) {
+            hi = sigma;
+            sigma = (lo + hi) / (T)2;
+        } else {
+            lo = sigma;
+            sigma = std::isinf(hi) ? sigma * (T)2 : (lo + hi) / (T)2;
+        }
+    }
+
+    T row_mean = (T)0;
+    da_int n_finite = 0;
+    for (da_int j = 0; j < k; ++j) {
+        if (std::isfinite(dist[j])) {
+            row_mean += dist[j];
+            ++n_finite;
+        }
+    }
+    row_mean = n_finite > 0 ? row_mean / n_finite : (T)0;
+    sigma = std::max(sigma, min_scale * (rho > (T)0 ? row_mean : mean_dist));
+
+    for (da_int j = 0; j < k; ++j) {
+        T d = dist[j] - rho;
+        weights[j] = d > (T)0 && sigma > (T)0 ? std::exp(-d / sigma) : (T)1;
+    }
+}
+
+template <typename T>
+da_status fuzzy_union_to_csr(da_int n, da_int k, const da_int *nbr_ind,
+                             const T *weights, std::vector<da_int> &row_ptr,
+                             std::vector<da_int> &col_idx, std::vector<T> &values) {
+    // Scatter each directed edge into the rows of both of its end points
+    std::vector<da_int> count, fill;
+    std::vector<std::pair<da_int, T>> entries;
+    try {
+        count.resize(n + 1, 0);
+        row_ptr.assign(n + 1, 0);
+        for (da_int i = 0; i < n; ++i) {
+            for (da_int t = 0; t < k; ++t) {
+                const da_int j = nbr_ind[i * k + t];
+                if (j < 0 || j == i || weights[i * k + t] <= (T)0)
+                    continue;
+                count[i + 1]++;
+                count[j + 1]++;
+            }
+        }
+        for (da_int i = 0; i < n; ++i)
+            count[i + 1] += count[i];
+        entries.resize(count[n]);
+        fill.assign(count.begin(), count.end() - 1);
+    } catch (std::bad_alloc &) {
+        return da_status_memory_error; // LCOV_EXCL_LINE
+    }
+    for (da_int i = 0; i < n; ++i) {
+        for (da_int t = 0; t < k; ++t) {
+            const da_int j = nbr_ind[i * k + t];
+            const T w = weights[i * k + t];
+            if (j < 0 || j == i || w <= (T)0)
+                continue;
+            entries[fill[i]++] = {j, w};
+            entries[fill[j]++] = {i, w};
+        }
+    }
+
+    // Sort each row by column and combine the duplicates as a probabilistic union
+    std::vector<da_int> row_len(n, 0);
+#pragma omp parallel for schedule(dynamic, 64) default(none)                             \
+    shared(n, count, entries, row_len)
+    for (da_int i = 0; i < n; ++i) {
+        auto first = entries.begin() + count[i];
+        auto last = entries.begin() + count[i + 1];
+        std::sort(first, last, [](const std::pair<da_int, T> &lhs,
+                                  const std::pair<da_int, T> &rhs) {
+            return lhs.first < rhs.first;
+        });
+        da_int len = 0;
+        for (auto it = first; it != last; ++it) {
+            if (len > 0 && (first + len - 1)->first == it->first) {
+                T &v = (first + len - 1)->second;
+                v = v + it->second - v * it->second;
+            } else {
+                *(first + len) = *it;
+                ++len;
+            }
+        }
+        row_len[i] = len;
+    }
+
+    for (da_int i = 0; i < n; ++i)
+        row_ptr[i + 1] = row_ptr[i] + row_len[i];
+    try {
+        col_idx.resize(row_ptr[n]);
+        values.resize(row_ptr[n]);
+    } catch (std::bad_alloc &) {
+        return da_status_memory_error; // LCOV_EXCL_LINE
+    }
+    for (da_int i = 0; i < n; ++i) {
+        for (da_int t = 0; t < row_len[i]; ++t) {
+            col_idx[row_ptr[i] + t] = entries[count[i] + t].first;
+            values[row_ptr[i] + t] = entries[count[i] + t].second;
+        }
+    }
+    return da_status_success;
+}
+
+// SplitMix64 generator: cheap, stateless apart from a 64-bit counter, and good enough
+// to draw negative samples
+static inline uint64_t splitmix64(uint64_t &state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Gradient components are clipped to [-4, 4], as in umap-learn
+constexpr double gradient_clip = 4.0;
+template <typename T> static inline T clip_gradient(T v) {
+    return std::max((T)-gradient_clip, std::min((T)gradient_clip, v));
+}
+
+/* Each edge is sampled with a frequency proportional to its weight, and each sample is
+   followed by negative_sample_rate repulsive moves away from uniformly drawn points.
+   The edges are split into fixed blocks processed in parallel; every block and epoch
+   has its own random stream, so the samples drawn do not depend on the number of
+   threads. Updates to the embedding are lock-free, as conflicting writes are rare and
+   do not affect convergence. Blocks running concurrently may however update the same
+   points, so the result is only reproducible for a fixed seed when there is a single
+   block of edges or a single thread. */
+template <typename T>
+void optimize_layout(da_int d, da_int n_edges, const da_int *head, const da_int *tail,
+                     const T *weights, T *head_emb, T *tail_emb, da_int n_tail,
+                     da_int n_epochs, T a, T b, T gamma, T initial_alpha,
+                     da_int negative_sample_rate, bool move_tail, uint64_t seed) {
+    if (n_edges == 0 || n_epochs == 0)
+        return;
+
+    // Edges too weak to be sampled at least once are skipped
+    T w_max = (T)0;
+    for (da_int e = 0; e < n_edges; ++e)
+        w_max = std::max(w_max, weights[e]);
+    std::vector<T> epochs_per_sample(n_edges), next_sample(n_edges),
+        epochs_per_negative(n_edges), next_negative(n_edges);
+    for (da_int e = 0; e < n_edges; ++e) {
+        T n_samples = (T)n_epochs * weights[e] / w_max;
+        epochs_per_sample[e] = n_samples >= (T)1 ? (T)n_epochs / n_samples : (T)-1;
+        epochs_per_negative[e] =
+            negative_sample_rate > 0 ? epochs_per_sample[e] / (T)negative_sample_rate
+                                     : (T)-1;
+        next_sample[e] = epochs_per_sample[e];
+        next_negative[e] = epochs_per_negative[e];
+    }
+
+    const da_int n_blocks = (n_edges + edge_block_size - 1) / edge_block_size;
+    const T b_minus_one = b - (T)1;
+    for (da_int epoch = 0; epoch < n_epochs; ++epoch) {
+        const T alpha = initial_alpha * ((T)1 - (T)epoch / (T)n_epochs);
+        const T current_epoch = (T)(epoch + 1);
+#pragma omp parallel for schedule(static) default(none)                                  \
+    shared(d, n_edges, head, tail, head_emb, tail_emb, n_tail, a, b, gamma, move_tail,   \
+               seed, epoch, n_blocks, b_minus_one, alpha, current_epoch,                 \
+               epochs_per_sample, next_sample, epochs_per_negative, next_negative)
+        for (da_int blk = 0; blk < n_blocks; ++blk) {
+            uint64_t state =
+                seed ^ (((uint64_t)epoch * (uint64_t)n_blocks + (uint64_t)blk) *
+                        0xD1B54A32D192ED03ULL);
+            const da_int e_end = std::min(n_edges, (blk + 1) * edge_block_size);
+            for (da_int e = blk * edge_block_size; e < e_end; ++e) {
+                if (epochs_per_sample[e] <= (T)0 || next_sample[e] > current_epoch)
+                    continue;
+
+                T *current = head_emb + head[e] * d;
+                T *other = tail_emb + tail[e] * d;
+                T dist2 = (T)0;
+                for (da_int c = 0; c < d; ++c)
+                    dist2 += (current[c] - other[c]) * (current[c] - other[c]);
+                T coeff = (T)0;
+                if (dist2 > (T)0)
+                    coeff = (T)-2 * a * b * std::pow(dist2, b_minus_one) /
+                            (a * std::pow(dist2, b) + (T)1);
+                for (da_int c = 0; c < d; ++c) {
+                    T grad = clip_gradient(coeff * (current[c] - other[c]));
+                    current[c] += grad * alpha;
+                    if (move_tail)
+                        other[c] -= grad * alpha;
+                }
+                next_sample[e] += epochs_per_sample[e];
+
+                if (epochs_per_negative[e] <= (T)0)
+                    continue;
+                da_int n_neg =
+                    (da_int)((current_epoch - next_negative[e]) / epochs_per_negative[e]);
+                for (da_int p = 0; p < n_neg; ++p) {
+                    da_int j = (da_int)(splitmix64(state) % (uint64_t)n_tail);
+                    other = tail_emb + j * d;
+                    dist2 = (T)0;
+                    for (da_int c = 0; c < d; ++c)
+                        dist2 += (current[c] - other[c]) * (current[c] - other[c]);
+                    if (dist2 > (T)0)
+                        coeff = (T)2 * gamma * b /
+                                (((T)0.001 + dist2) * (a * std::pow(dist2, b) + (T)1));
+                    else if (move_tail && j == head[e])
+                        continue;
+                    else
+                        coeff = (T)0;
+                    // Coincident points are pushed apart by the clipped gradient, as in
+                    // umap-learn, instead of staying on top of each other
+                    for (da_int c = 0; c < d; ++c) {
+                        T grad = coeff > (T)0
+                                     ? clip_gradient(coeff * (current[c] - other[c]))
+                                     : (T)gradient_clip;
+                        current[c] += grad * alpha;
+                    }
+                }
+                next_negative[e] += (T)n_neg * epochs_per_negative[e];
+            }
+        }
+    }
+}
+
+template void find_ab_params<float>(float spread, float min_dist, float &a, float &b);
+template void find_ab_params<double>(double spread, double min_dist, double &a,
+                                     double &b);
+template void smooth_knn_row<float>(const float *dist, da_int k, float log2_neighbors,
+                                    bool use_rho, float mean_dist, float *weights);
+template void smooth_knn_row<double>(const double *dist, da_int k,
+                                     double log2_neighbors, bool use_rho,
+                                     double mean_dist, double *weights);
+template da_status fuzzy_union_to_csr<float>(da_int n, da_int k, const da_int *nbr_ind,
+                                             const float *weights,
+                                             std::vector<da_int> &row_ptr,
+                                             std::vector<da_int> &col_idx,
+                                             std::vector<float> &values);
+template da_status fuzzy_union_to_csr<double>(da_int n, da_int k, const da_int *nbr_ind,
+                                              const double *weights,
+                                              std::vector<da_int> &row_ptr,
+                                              std::vector<da_int> &col_idx,
+                                              std::vector<double> &values);
+template void optimize_layout<float>(da_int d, da_int n_edges, const da_int *head,
+                                     const da_int *tail, const float *weights,
+                                     float *head_emb, float *tail_emb, da_int n_tail,
+                                     da_int n_epochs, float a, float b, float gamma,
+                                     float initial_alpha, da_int negative_sample_rate,
+                                     bool move_tail, uint64_t seed);
+template void optimize_layout<double>(da_int d, da_int n_edges, const da_int *head,
+                                      const da_int *tail, const double *weights,
+                                      double *head_emb, double *tail_emb, da_int n_tail,
+                                      da_int n_epochs, double a, double b, double gamma,
+                                      double initial_alpha, da_int negative_sample_rate,
+                                      bool move_tail, uint64_t seed);
+
+} // namespace da_umap
+
+} // namespace ARCH
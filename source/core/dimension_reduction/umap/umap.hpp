@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef UMAP_HPP
+#define UMAP_HPP
+
+#include "aoclda.h"
+#include "approximate_neighbors.hpp"
+#include "basic_handle.hpp"
+#include "da_error.hpp"
+#include "da_inference_context.hpp"
+#include "macros.h"
+#include "model_persistence.hpp"
+#include "nearest_neighbors.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ARCH {
+
+namespace da_umap {
+
+/*
+ * Uniform Manifold Approximation and Projection (UMAP).
+ *
+ * The data is summarized by a fuzzy graph built from the nearest neighbors of each
+ * sample, and a low-dimensional embedding is fitted to it by stochastic gradient
+ * descent over the graph edges with negative sampling.
+ */
+template <typename T> class umap : public basic_handle<T> {
+  private:
+    da_int n_samples = 0;
+    da_int n_features = 0;
+    da_int n_components = 2;
+    da_int n_neighbors = 15;
+    da_int n_epochs = 0;
+
+    bool initdone = false;
+
+    const T *X = nullptr;  // contiguous row-major view of the training data
+    std::vector<T> X_copy; // owned storage (used when a copy is needed or when loaded)
+    std::vector<T> embedding;
+
+    // Symmetric fuzzy neighbor graph in CSR format
+    std::vector<da_int> graph_row_ptr;
+    std::vector<da_int> graph_col_idx;
+    std::vector<T> graph_values;
+
+    // Parameters of the low-dimensional similarity 1 / (1 + a * d^(2b))
+    T a = (T)0;
+    T b = (T)0;
+
+    // Options stored as members
+    T min_dist = (T)0.1;
+    T spread = (T)1;
+    T learning_rate = (T)1;
+    T repulsion_strength = (T)1;
+    da_int negative_sample_rate = 5;
+    da_int neighbor_method = 0; // 0: exact kNN, 1: IVF index
+    da_int n_list = 0;
+    da_int n_probe = 0;
+    da_int init_method = 0; // 0: PCA, 1: random
+    da_int seed = 0;
+
+    // Index over the training data, built by compute() or when a model is loaded and
+    // only queried afterwards, so transform calls share it without rebuilding it.
+    // It references X, so the user's data must stay valid.
+    std::shared_ptr<da_neighbors::neighbors<T>> nn_index;
+    std::shared_ptr<da_approx_nn::approximate_neighbors<T>> ann_index;
+    // The index handles refresh their options and record errors on each query, so
+    // concurrent transform calls take turns to query it
+    std::mutex index_mutex;
+
+    da_status read_options();
+    da_status build_neighbor_index();
+    da_status nearest_neighbors(da_errors::da_error_t *err, da_int m, const T *X_query,
+                                da_int k, bool exclude_self, std::vector<da_int> &nbr_ind,
+                                std::vector<T> &nbr_dist);
+    da_status initialize_embedding(std::mt19937_64 &rng);
+
+  public:
+    umap(da_errors::da_error_t &err);
+    ~umap() = default;
+
+    da_status set_data(da_int n_samples, da_int n_features, const T *X_in, da_int ldx_in);
+    da_status compute();
+    da_status transform(da_int m_samples, da_int m_features, const T *X_new, da_int ldx,
+                        T *X_transform, da_int ldx_transform);
+    /* Version of transform which only reads the computed embedding: errors go to ctx,
+     * so it can be called concurrently on the same handle
+     */
+    da_status transform(_da_inference_context &ctx, da_int m_samples, da_int m_features,
+                        const T *X_new, da_int ldx, T *X_transform, da_int ldx_transform);
+
+    da_status get_result(da_result query, da_int *dim, T *result) override;
+    da_status get_result(da_result query, da_int *dim, da_int *result) override;
+
+    da_status serialize(da_model_persistence::serialization_buffer &buffer) override;
+    da_status save_model(da_model_persistence::serialization_buffer &buffer) override;
+    da_status load_model(da_model_persistence::serialization_buffer &buffer) override;
+
+    void refresh() override;
+};
+
+// Fit a and b so that 1 / (1 + a * x^(2b)) approximates 1 for x < min_dist and
+// exp(-(x - min_dist) / spread) beyond it, in the least-squares sense.
+template <typename T> void find_ab_params(T spread, T min_dist, T &a, T &b);
+
+// Membership strengths of the k neighbors of one sample, given their distances in
+// increasing order. rho is the distance to the nearest neighbor (0 when not used) and
+// sigma is found by bisection so that the strengths sum to log2(n_neighbors).
+template <typename T>
+void smooth_knn_row(const T *dist, da_int k, T log2_neighbors, bool use_rho,
+                    T mean_dist, T *weights);
+
+// Fuzzy union A + A^T - A o A^T of the directed n-by-k membership graph, in CSR format
+// with sorted column indices.
+template <typename T>
+da_status fuzzy_union_to_csr(da_int n, da_int k, const da_int *nbr_ind,
+                             const T *weights, std::vector<da_int> &row_ptr,
+                             std::vector<da_int> &col_idx, std::vector<T> &values);
+
+// Stochastic gradient descent over the edges (head[e], tail[e]) of a graph: head
+// points are moved towards their tails and away from random points of tail_emb.
+// When move_tail is true, head_emb and tail_emb must be the same array.
+template <typename T>
+void optimize_layout(da_int d, da_int n_edges, const da_int *head, const da_int *tail,
+                     const T *weights, T *head_emb, T *tail_emb, da_int n_tail,
+                     da_int n_epochs, T a, T b, T gamma, T initial_alpha,
+                     da_int negative_sample_rate, bool move_tail, uint64_t seed);
+
+} // namespace da_umap
+
+} // namespace ARCH
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef UMAP_OPTIONS_HPP
+#define UMAP_OPTIONS_HPP
+
+#include "aoclda_types.h"
+#include "da_error.hpp"
+#include "macros.h"
+#include "options.hpp"
+#include <limits>
+
+namespace ARCH {
+
+namespace da_umap {
+
+template <class T>
+inline da_status register_umap_options(da_options::OptionRegistry &opts,
+                                       da_errors::da_error_t &err) {
+    using namespace da_options;
+    da_int imax = std::numeric_limits<da_int>::max();
+    T rmax = std::numeric_limits<T>::max();
+
+    try {
+        std::shared_ptr<OptionNumeric<da_int>> oi;
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "n_components", "Number of embedding dimensions.", 1,
+            da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf, 2));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "n_neighbors",
+            "Number of nearest neighbors, including the sample itself, used to build the "
+            "fuzzy neighbor graph.",
+            2, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            15));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "n_epochs",
+            "Number of stochastic gradient descent epochs; 0 selects 500 for up to 10000 "
+            "samples and 200 otherwise.",
+            0, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf, 0));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "negative sample rate",
+            "Number of negative samples drawn for each positive edge sample.", 0,
+            da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf, 5));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "seed",
+            "Seed for random number generation; set to -1 for non-deterministic results.",
+            -1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            0));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "n_list",
+            "Number of lists of the inverted file index used when the neighbor "
+            "algorithm is ivfflat; 0 selects the square root of the number of samples.",
+            0, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            0));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "n_probe",
+            "Number of lists of the inverted file index searched for each sample when "
+            "the neighbor algorithm is ivfflat; 0 selects max(1, n_list / 8).",
+            0, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            0));
+        opts.register_opt(oi);
+
+        std::shared_ptr<OptionNumeric<T>> oT;
+        oT = std::make_shared<OptionNumeric<T>>(OptionNumeric<T>(
+            "min_dist", "Minimum distance between points in the embedding.", (T)0,
+            da_options::lbound_t::greaterequal, rmax, da_options::ubound_t::p_inf,
+            (T)0.1));
+        opts.register_opt(oT);
+        oT = std::make_shared<OptionNumeric<T>>(OptionNumeric<T>(
+            "spread",
+            "Scale of the embedding; together with min_dist it determines how clustered "
+            "the embedded points are.",
+            (T)0, da_options::lbound_t::greaterthan, rmax, da_options::ubound_t::p_inf,
+            (T)1));
+        opts.register_opt(oT);
+        oT = std::make_shared<OptionNumeric<T>>(OptionNumeric<T>(
+            "learning rate", "Initial learning rate of the stochastic gradient descent.",
+            (T)0, da_options::lbound_t::greaterthan, rmax, da_options::ubound_t::p_inf,
+            (T)1));
+        opts.register_opt(oT);
+        oT = std::make_shared<OptionNumeric<T>>(OptionNumeric<T>(
+            "repulsion strength", "Weight applied to the negative samples.", (T)0,
+            da_options::lbound_t::greaterequal, rmax, da_options::ubound_t::p_inf, (T)1));
+        opts.register_opt(oT);
+
+        std::shared_ptr<OptionString> os;
+        os = std::make_shared<OptionString>(OptionString(
+            "init", "Initialization method for the embedding.",
+            {{"pca", 0}, {"random", 1}}, "pca"));
+        opts.register_opt(os);
+        os = std::make_shared<OptionString>(OptionString(
+            "neighbor algorithm",
+            "Method used to find the nearest neighbors: exact search or an approximate "
+            "inverted file index.",
+            {{"exact", 0}, {"ivfflat", 1}}, "exact"));
+        opts.register_opt(os);
+
+    } catch (std::bad_alloc &) {
+        return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    } catch (...) {                                     // LCOV_EXCL_LINE
+        return da_error(&err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "Unexpected error while registering options");
+    }
+
+    return da_status_success;
+}
+
+} // namespace da_umap
+
+} // namespace ARCH
+
+#endif
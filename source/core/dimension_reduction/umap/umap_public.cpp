@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "umap_public.hpp"
+#include "aoclda.h"
+#include "da_handle.hpp"
+#include "dynamic_dispatch.hpp"
+#include "macros.h"
+
+using namespace umap_public;
+
+template <typename T>
+da_status da_umap_set_data(da_handle handle, da_int n_samples, da_int n_features,
+                           const T *X, da_int ldx) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear();
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err, return (umap_set_data<da_umap::umap<T>, T>(
+                                handle, n_samples, n_features, X, ldx)));
+}
+
+template <typename T> da_status da_umap_compute(da_handle handle) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear();
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err, return (umap_compute<da_umap::umap<T>, T>(handle)));
+}
+
+template <typename T>
+da_status da_umap_transform(da_handle handle, da_int m_samples, da_int m_features,
+                            const T *X, da_int ldx, T *X_transform,
+                            da_int ldx_transform) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear();
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err,
+               return (umap_transform<da_umap::umap<T>, T>(
+                   handle, m_samples, m_features, X, ldx, X_transform, ldx_transform)));
+}
+
+template <typename T>
+da_status da_umap_transform(da_handle handle, da_inference_context ctx, da_int m_samples,
+                            da_int m_features, const T *X, da_int ldx, T *X_transform,
+                            da_int ldx_transform) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    if (!ctx)
+        return da_status_invalid_pointer;
+    ctx->clear(); // Clean up context logs, the handle is only read
+
+    da_status status = handle->check_precision<T>(ctx->err);
+    if (status != da_status_success)
+        return da_error_trace(ctx->err, status, "Wrong precision type.");
+
+    DISPATCHER(ctx->err,
+               return (umap_transform<da_umap::umap<T>, T>(handle, ctx, m_samples,
+                                                           m_features, X, ldx,
+                                                           X_transform, ldx_transform)));
+}
+
+template da_status da_umap_set_data<float>(da_handle, da_int, da_int, const float *,
+                                           da_int);
+template da_status da_umap_set_data<double>(da_handle, da_int, da_int, const double *,
+                                            da_int);
+template da_status da_umap_compute<float>(da_handle);
+template da_status da_umap_compute<double>(da_handle);
+template da_status da_umap_transform<float>(da_handle, da_int, da_int, const float *,
+                                            da_int, float *, da_int);
+template da_status da_umap_transform<double>(da_handle, da_int, da_int, const double *,
+                                             da_int, double *, da_int);
+template da_status da_umap_transform<float>(da_handle, da_inference_context, da_int,
+                                            da_int, const float *, da_int, float *,
+                                            da_int);
+template da_status da_umap_transform<double>(da_handle, da_inference_context, da_int,
+                                             da_int, const double *, da_int, double *,
+                                             da_int);
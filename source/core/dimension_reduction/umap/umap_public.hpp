@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "aoclda.h"
+#include "da_handle.hpp"
+#include "da_inference_context.hpp"
+#include "dynamic_dispatch.hpp"
+#include "macros.h"
+
+namespace umap_public {
+
+template <typename umap_class, typename T>
+da_status umap_set_data(da_handle handle, da_int n_samples, da_int n_features, const T *X,
+                        da_int ldx) {
+    umap_class *umap = dynamic_cast<umap_class *>(handle->get_alg_handle<T>());
+    if (umap == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_umap or "
+                        "handle is invalid.");
+    return umap->set_data(n_samples, n_features, X, ldx);
+}
+
+template <typename umap_class, typename T> da_status umap_compute(da_handle handle) {
+    umap_class *umap = dynamic_cast<umap_class *>(handle->get_alg_handle<T>());
+    if (umap == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_umap or "
+                        "handle is invalid.");
+    return umap->compute();
+}
+
+template <typename umap_class, typename T>
+da_status umap_transform(da_handle handle, da_int m_samples, da_int m_features,
+                         const T *X, da_int ldx, T *X_transform, da_int ldx_transform) {
+    umap_class *umap = dynamic_cast<umap_class *>(handle->get_alg_handle<T>());
+    if (umap == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_umap or "
+                        "handle is invalid.");
+    return umap->transform(m_samples, m_features, X, ldx, X_transform, ldx_transform);
+}
+
+template <typename umap_class, typename T>
+da_status umap_transform(da_handle handle, da_inference_context ctx, da_int m_samples,
+                         da_int m_features, const T *X, da_int ldx, T *X_transform,
+                         da_int ldx_transform) {
+    umap_class *umap = dynamic_cast<umap_class *>(handle->get_alg_handle<T>());
+    if (umap == nullptr)
+        return da_error(ctx->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_umap or "
+                        "handle is invalid.");
+    return umap->transform(*ctx, m_samples, m_features, X, ldx, X_transform,
+                           ldx_transform);
+}
+
+} // namespace umap_public
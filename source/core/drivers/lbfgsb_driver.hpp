@@ -28,6 +28,7 @@
 #include "aoclda_error.h"
 #include "coord.hpp"
 #include "da_error.hpp"
+#include "finite_differences.hpp"
 #include "lbfgsb.hpp"
 #include "macros.h"
 #include "options.hpp"
@@ -188,10 +189,6 @@ da_status lbfgsb_fcomm(da_options::OptionRegistry &opts, da_int nvar, std::vecto
         return da_error(
             &err, da_status_invalid_pointer,
             "NLP solver requires a valid pointer to the objective function call-back");
-    if (!objgrd)
-        return da_error(&err, da_status_not_implemented,
-                        "NLP solver requires a valid pointer to the objective gradient "
-                        "function call-back");
     da_int m;
     if (opts.get("lbfgsb memory limit", m))
         return da_error(&err, da_status_internal_error,
@@ -220,6 +217,16 @@ da_status lbfgsb_fcomm(da_options::OptionRegistry &opts, da_int nvar, std::vecto
     if (opts.get("lbfgsb iteration limit", maxit))
         return da_error(&err, da_status_internal_error,
                         "expected option not found: lbfgsb iteration limit");
+    T fd_step;
+    if (opts.get("finite differences step", fd_step))
+        return da_error(&err, da_status_internal_error,
+                        "expected option not found: finite differences step");
+    da_int fd_threads;
+    if (opts.get("finite differences threads", fd_threads))
+        return da_error(&err, da_status_internal_error,
+                        "expected option not found: finite differences threads");
+    if (fd_threads == 0)
+        fd_threads = omp_get_max_threads();
     da_int mon = 0;
     if (monit) // Monitor provided
         if (opts.get("monitoring frequency", mon))
@@ -249,6 +256,23 @@ da_status lbfgsb_fcomm(da_options::OptionRegistry &opts, da_int nvar, std::vecto
     da_int lsavei[4], isave[44];
     T dsave[29];
 
+    // Without a gradient call-back, estimate it by finite-differences of objfun at x,
+    // where objfun has just been evaluated
+    da_int nevalfd{0};
+    objgrd_t<T> grad = objgrd;
+    const T *lower = l.empty() ? nullptr : l.data();
+    const T *upper = u.empty() ? nullptr : u.data();
+    if (!objgrd) {
+        grad = [&](da_int nv, T *xk, T *gk, void *data, da_int xnew) -> da_int {
+            T fx = *f;
+            if (xnew && objfun(nv, xk, &fx, data) != 0)
+                return 1;
+            auto eval = [&](T *xp, T *fp) { return objfun(nv, xp, fp, data); };
+            return da_optim::fd_jacobian(nv, da_int(1), xk, &fx, gk, true, fd_step, lower,
+                                         upper, fd_threads, eval, nevalfd);
+        };
+    }
+
     switch (prnlvl) {
     case 0:
         // No output
@@ -316,7 +340,7 @@ da_status lbfgsb_fcomm(da_options::OptionRegistry &opts, da_int nvar, std::vecto
                 // This solver does not have recovery, stop
                 itask = 120;
             }
-            if (objgrd(n, &x[0], &g[0], usrdata, 0)) {
+            if (grad(n, &x[0], &g[0], usrdata, 0)) {
                 // This solver does not have recovery, stop
                 itask = 121;
             }
@@ -324,6 +348,7 @@ da_status lbfgsb_fcomm(da_options::OptionRegistry &opts, da_int nvar, std::vecto
     }
 
     delete w;
+    info[da_linmod_info_t::linmod_info_nevalf] += static_cast<T>(nevalfd);
 
     // Select correct exit status
     switch (itask) {
@@ -59,12 +59,15 @@
 #undef ral_nlls_free_workspace
 #undef PREC
 
+#include "finite_differences.hpp"
 #include "macros.h"
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <sstream>
 #include <type_traits>
+#include <vector>
 
 namespace ARCH {
 
@@ -118,6 +121,61 @@ da_int da_nlls_eval_hf_dummy([[maybe_unused]] da_int n, [[maybe_unused]] da_int
     return RAL_NLLS_CB_DUMMY;
 }
 
+/* Finite-difference Jacobian computed by the driver instead of RALFit, so that the
+ * perturbed points can be evaluated concurrently or with the multi-point call-back.
+ * It is passed to RALFit as the user data of the wrappers below, which forward the
+ * user's own data to the residual call-backs.
+ */
+template <typename T> struct fd_data {
+    ral_nlls_eval_r_type_t<T> eval_r{nullptr};
+    const resfun_multi_t<T> *eval_r_multi{nullptr};
+    void *usrdata{nullptr};
+    da_int n_threads{1};
+    T fd_step{0};
+    bool col_major{true};
+    const T *lower{nullptr}, *upper{nullptr};
+    // Residuals at the last point evaluated by RALFit
+    std::vector<T> x, f;
+    bool valid{false};
+    da_int nevalf{0}, nevalfd{0};
+};
+
+template <typename T>
+da_int fd_eval_r(da_int n, da_int m, void *params, const T *x, T *f) {
+    fd_data<T> *fd = static_cast<fd_data<T> *>(params);
+    da_int status = fd->eval_r(n, m, fd->usrdata, x, f);
+    fd->valid = status == 0;
+    if (fd->valid) {
+        std::copy(x, x + n, fd->x.begin());
+        if (f != fd->f.data())
+            std::copy(f, f + m, fd->f.begin());
+    }
+    return status;
+}
+
+template <typename T>
+da_int fd_eval_J(da_int n, da_int m, void *params, const T *x, T *J) {
+    fd_data<T> *fd = static_cast<fd_data<T> *>(params);
+    // RALFit evaluates the residuals at x before the Jacobian, check just in case
+    if (!fd->valid || !std::equal(x, x + n, fd->x.begin())) {
+        fd->nevalf++;
+        da_int status = fd_eval_r<T>(n, m, params, x, fd->f.data());
+        if (status != 0)
+            return status;
+    }
+    if (fd->eval_r_multi) {
+        auto eval = [&](da_int npts, const T *xp, T *fp) {
+            return (*fd->eval_r_multi)(n, m, npts, fd->usrdata, xp, fp);
+        };
+        return da_optim::fd_jacobian_multi(n, m, x, fd->f.data(), J, fd->col_major,
+                                           fd->fd_step, fd->lower, fd->upper, eval,
+                                           fd->nevalfd);
+    }
+    auto eval = [&](const T *xp, T *fp) { return fd->eval_r(n, m, fd->usrdata, xp, fp); };
+    return da_optim::fd_jacobian(n, m, x, fd->f.data(), J, fd->col_major, fd->fd_step,
+                                 fd->lower, fd->upper, fd->n_threads, eval, fd->nevalfd);
+}
+
 // Copy RALFit's inform into DA's info array
 template <typename T>
 void copy_inform(ral_nlls_inform_t<T> &inform, std::vector<T> &info) {
@@ -438,7 +496,8 @@ da_status ralfit_driver(da_options::OptionRegistry &opts, [[maybe_unused]] da_in
                         [[maybe_unused]] T *lower_bounds,
                         [[maybe_unused]] T *upper_bounds, [[maybe_unused]] T *weights,
                         [[maybe_unused]] void *usrdata, std::vector<T> &info,
-                        da_errors::da_error_t &err) {
+                        da_errors::da_error_t &err,
+                        [[maybe_unused]] resfun_multi_t<T> eval_r_multi = nullptr) {
     ral_nlls_options_t<T> options;
     ral_nlls_inform_t<T> inform;
 
@@ -514,10 +573,41 @@ da_status ralfit_driver(da_options::OptionRegistry &opts, [[maybe_unused]] da_in
         ral_nlls_eval_HP = *(eval_HP.template target<ral_nlls_eval_hp_type_t<T>>());
     }
 
+    da_int fd_threads;
+    if (opts.get("finite differences threads", fd_threads) != da_status_success)
+        return da_error(&err, da_status_option_not_found, // LCOV_EXCL_LINE
+                        "<finite differences threads> option not found in the registry?");
+#ifndef NO_FORTRAN
+    // Estimate the Jacobian in the driver if the perturbed points are to be evaluated
+    // concurrently or in one call, otherwise RALFit does it serially
+    void *params = usrdata;
+    fd_data<T> fd;
+    if (!eval_J && !eval_HF && !eval_HP && (fd_threads != 1 || eval_r_multi)) {
+        try {
+            fd.x.resize(nvar);
+            fd.f.resize(nres);
+        } catch (std::bad_alloc &) {                       // LCOV_EXCL_LINE
+            return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        fd.eval_r = ral_nlls_eval_r;
+        fd.eval_r_multi = eval_r_multi ? &eval_r_multi : nullptr;
+        fd.usrdata = usrdata;
+        fd.n_threads = fd_threads == 0 ? omp_get_max_threads() : fd_threads;
+        fd.fd_step = options.fd_step;
+        fd.col_major = options.Fortran_Jacobian;
+        fd.lower = lower_bounds;
+        fd.upper = upper_bounds;
+        ral_nlls_eval_r = fd_eval_r<T>;
+        ral_nlls_eval_J = fd_eval_J<T>;
+        params = &fd;
+    }
+#endif
+
     if constexpr (std::is_same_v<T, double>) {
 #ifndef NO_FORTRAN
         nlls_solve_d(nvar, nres, x, ral_nlls_eval_r, ral_nlls_eval_J, ral_nlls_eval_HF,
-                     usrdata, &options, &inform, weights, ral_nlls_eval_HP, lower_bounds,
+                     params, &options, &inform, weights, ral_nlls_eval_HP, lower_bounds,
                      upper_bounds);
         ral_nlls_free_workspace_d(&workspace);
         ral_nlls_free_workspace_d(&inner_workspace);
@@ -525,7 +615,7 @@ da_status ralfit_driver(da_options::OptionRegistry &opts, [[maybe_unused]] da_in
     } else {
 #ifndef NO_FORTRAN
         nlls_solve_s(nvar, nres, x, ral_nlls_eval_r, ral_nlls_eval_J, ral_nlls_eval_HF,
-                     usrdata, &options, &inform, weights, ral_nlls_eval_HP, lower_bounds,
+                     params, &options, &inform, weights, ral_nlls_eval_HP, lower_bounds,
                      upper_bounds);
         ral_nlls_free_workspace_s(&workspace);
         ral_nlls_free_workspace_s(&inner_workspace);
@@ -533,6 +623,10 @@ da_status ralfit_driver(da_options::OptionRegistry &opts, [[maybe_unused]] da_in
     }
 
     copy_inform(inform, info);
+#ifndef NO_FORTRAN
+    info[da_optim_info_t::info_nevalf] += T(fd.nevalf + fd.nevalfd);
+    info[da_optim_info_t::info_nevalfd] += T(fd.nevalfd);
+#endif
 
     // Translate exit status -> severity
     da_status status = get_exit_status<T>(inform, err);
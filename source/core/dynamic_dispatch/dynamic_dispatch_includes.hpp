@@ -27,19 +27,23 @@
 #include "dbscan/dbscan.hpp"
 #include "forest/decision_forest.hpp"
 #include "interpolation.hpp"
+#include "kernel_approximation/kernel_approximation.hpp"
 #include "kernel_functions.hpp"
 #include "kernel_pca/kernel_pca.hpp"
 #include "kmeans/kmeans.hpp"
 #include "linear_model.hpp"
+#include "moment_accumulator.hpp"
 #include "nearest_neighbors.hpp"
 #include "nlls.hpp"
 #include "pairwise_distances.hpp"
 #include "pca/pca.hpp"
+#include "quantile_sketch.hpp"
 #include "radius_neighbors.hpp"
 #include "svm.hpp"
 #include "train_test_split.hpp"
 #include "tree/decision_tree.hpp"
 #include "tsne/tsne.hpp"
+#include "umap/umap.hpp"
 
 //clang-format off
 #include "undef_macros.h"
@@ -40,8 +40,11 @@
 #undef KMEANS_MACQUEEN_HPP
 #undef KMEANS_HARTIGAN_WONG_HPP
 #undef NN_UTILS_HPP
+#undef NN_STORAGE_HPP
+#undef NEAREST_NEIGHBORS_HPP
 #undef PCA_HPP
 #undef KERNEL_PCA_HPP
+#undef KERNEL_APPROXIMATION_HPP
 #undef TSNE_HPP
 #undef TTS_INTERNAL_HPP
 #undef TTS_HPP
@@ -52,6 +55,11 @@
 #undef DA_RANDSVD_HPP
 #undef DA_QR_HPP
 #undef BINARY_TREE_HPP
+#undef FINITE_DIFFERENCES_HPP
+#undef LINMOD_SOFTMAX_HPP
+#undef MOMENT_ACCUMULATOR_HPP
+#undef QUANTILE_SKETCH_HPP
+#undef UMAP_HPP
 
 // Decision forest headers
 #undef DECISION_TREE_HPP
@@ -40,6 +40,7 @@
 #include <cmath>
 #include <cstring>
 #include <limits>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -53,6 +54,8 @@ using namespace da_model_persistence;
 template <typename T>
 kernel_pca<T>::kernel_pca(da_errors::da_error_t &err) : basic_handle<T>(err) {
     register_kernel_pca_options<T>(this->opts, err);
+    // v5.3.2: the solver, Nystroem state and feature means are serialized
+    this->set_serialization_version(50302);
 }
 
 template <typename T>
@@ -250,6 +253,8 @@ da_status kernel_pca<T>::init(da_int n_samples_in, da_int n_features_in, const T
     eigenvalues.resize(0);
     eigenvectors.resize(0);
     dual_coef.resize(0);
+    feature_means.resize(0);
+    approx_components.resize(0);
 
     this->model_trained = false;
     inverse_fitted = false;
@@ -378,6 +383,18 @@ template <typename T> da_status kernel_pca<T>::compute() {
         this->gamma = static_cast<T>(1.0) / static_cast<T>(n_features);
     }
 
+    if (this->solver == solver_approx) {
+        if (this->kernel_type == pca_kernel::precomputed)
+            return da_error(this->err, da_status_invalid_input,
+                            "The approximate eigensolver cannot be used with a "
+                            "precomputed kernel.");
+        if (this->fit_inverse)
+            return da_error(this->err, da_status_incompatible_options,
+                            "The 'fit inverse transform' option cannot be used with the "
+                            "approximate eigensolver.");
+        return compute_approximate(n_components_opt);
+    }
+
     // Solver selection
     if (this->solver == solver_auto) {
         this->solver =
@@ -710,6 +727,202 @@ template <typename T> da_status kernel_pca<T>::compute() {
     return da_status_success;
 }
 
+template <typename T>
+da_status kernel_pca<T>::compute_approximate(da_int n_components_opt) {
+    /* The kernel matrix is approximated by Z Z^T, where Z is the n_samples x n_landmarks
+     * matrix of Nystroem features of the training data, so that only O(n_samples x
+     * n_landmarks) memory is needed. Centering the kernel matrix is equivalent to
+     * centering the columns of Z, and if Z_c = U S V^T then the eigenvectors of the
+     * centered kernel matrix are the columns of U with eigenvalues S^2. */
+    da_int n_landmarks, sampling_int, seed;
+    std::string sampling_str;
+    this->opts.get("n_landmarks", n_landmarks);
+    this->opts.get("landmark sampling", sampling_str, sampling_int);
+    this->opts.get("seed", seed);
+    if (seed == -1) {
+        std::random_device r;
+        seed = std::abs((da_int)r());
+    }
+
+    const da_int nl = std::min(n_landmarks, n_samples);
+    nystroem.order = this->order;
+    nystroem.kernel = this->kernel_type;
+    nystroem.gamma = this->gamma;
+    nystroem.coef0 = this->coef0;
+    nystroem.degree = this->degree;
+    nystroem.n_features = n_features;
+    nystroem.n_landmarks = nl;
+    da_status status = nystroem.fit(
+        this->err, n_samples, A_ptr, this->lda,
+        static_cast<da_kernel_approx_types::landmark_sampling>(sampling_int), seed);
+    if (status != da_status_success)
+        return status;
+
+    std::vector<T> Z, Zc, U, VT, work;
+    std::vector<da_int> iwork;
+    try {
+        Z.resize(n_samples * nl);
+        U.resize(n_samples * nl);
+        VT.resize(nl * nl);
+        iwork.resize(8 * nl);
+        feature_means.resize(nl);
+        eigenvalues.resize(nl);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    da_int ldz = (this->order == da_order::column_major) ? n_samples : nl;
+    status = nystroem.transform(this->err, n_samples, A_ptr, this->lda, Z.data(), ldz);
+    if (status != da_status_success)
+        return status;
+
+    // Center the features in column-major storage, as required by gesdd
+    if (this->order == da_order::row_major) {
+        try {
+            Zc.resize(n_samples * nl);
+        } catch (std::bad_alloc const &) {
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+        da_blas::omatcopy('T', nl, n_samples, static_cast<T>(1), Z.data(), nl, Zc.data(),
+                          n_samples);
+        Z.swap(Zc);
+        Zc.resize(0);
+    }
+    da_basic_statistics::mean(column_major, da_axis_col, n_samples, nl, Z.data(),
+                              n_samples, feature_means.data());
+    for (da_int j = 0; j < nl; j++) {
+        T mean_j = feature_means[j];
+#pragma omp simd
+        for (da_int i = 0; i < n_samples; i++)
+            Z[i + j * n_samples] -= mean_j;
+    }
+
+    char JOBZ = 'S';
+    da_int lwork = -1, INFO = 0, m = n_samples, n = nl;
+    T estworkspace[1];
+    da::gesdd(&JOBZ, &m, &n, Z.data(), &m, eigenvalues.data(), U.data(), &m, VT.data(),
+              &n, estworkspace, &lwork, iwork.data(), &INFO);
+    if (INFO == 0) {
+        lwork = static_cast<da_int>(estworkspace[0]);
+        try {
+            work.resize(lwork);
+        } catch (std::bad_alloc const &) {
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+        da::gesdd(&JOBZ, &m, &n, Z.data(), &m, eigenvalues.data(), U.data(), &m,
+                  VT.data(), &n, work.data(), &lwork, iwork.data(), &INFO);
+    }
+    if (INFO != 0)
+        return da_error(
+            this->err, da_status_internal_error,
+            "An internal error occurred while computing the kernel PCA. Please check "
+            "the input data for undefined values.");
+
+    for (T &ev : eigenvalues)
+        ev *= ev;
+
+    status = clamp_near_zero_eigenvalues(eigenvalues, n_components_opt);
+    if (status != da_status_success)
+        return status;
+
+    // At most n_landmarks components can be found
+    da_int nc = std::min(n_components_opt, nl);
+    if (nc == 0 || remove_zero) {
+        auto it = std::lower_bound(eigenvalues.begin(), eigenvalues.end(), 0,
+                                   std::greater<T>());
+        da_int nnz = std::distance(eigenvalues.begin(), it);
+        nc = (nc == 0) ? nnz : std::min(nnz, nc);
+    }
+    this->n_components = nc;
+    eigenvalues.resize(nc);
+
+    try {
+        eigenvectors.resize(n_samples * nc);
+        approx_components.resize(nl * nc);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    // Sign-normalize the columns of U, flipping the matching right singular vectors
+    for (da_int j = 0; j < nc; j++) {
+        T *u = U.data() + j * n_samples;
+        T sign = (u[da_blas::cblas_iamax(n_samples, u, 1)] < static_cast<T>(0))
+                     ? static_cast<T>(-1)
+                     : static_cast<T>(1);
+        if (this->order == da_order::column_major) {
+            for (da_int i = 0; i < n_samples; i++)
+                eigenvectors[i + j * n_samples] = sign * u[i];
+        } else {
+            for (da_int i = 0; i < n_samples; i++)
+                eigenvectors[i * nc + j] = sign * u[i];
+        }
+        for (da_int i = 0; i < nl; i++)
+            approx_components[i + j * nl] = sign * VT[j + i * nl];
+    }
+
+    row_means.resize(0);
+    grand_mean = static_cast<T>(0.0);
+    dual_coef.resize(0);
+    inverse_fitted = false;
+    this->model_trained = true;
+
+    if (n_components_opt > nl)
+        return da_warn(
+            this->err, da_status_incompatible_options,
+            "The number of principal components has been decreased from " +
+                std::to_string(n_components_opt) + " to the number of landmarks, " +
+                std::to_string(nl) + ".");
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status kernel_pca<T>::transform_approximate(da_int m, const T *X, da_int ldx,
+                                               T *X_transform, da_int ldx_transform) {
+    // X_transform = (Z_new - feature_means) * approx_components
+    const da_int nl = nystroem.n_landmarks;
+    da_int ldz = (this->order == da_order::column_major) ? m : nl;
+    std::vector<T> Z_new;
+    try {
+        Z_new.resize(m * nl);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    da_status status = nystroem.transform(this->err, m, X, ldx, Z_new.data(), ldz);
+    if (status != da_status_success)
+        return status;
+
+    if (this->order == da_order::column_major) {
+        for (da_int j = 0; j < nl; j++) {
+            T mean_j = feature_means[j];
+#pragma omp simd
+            for (da_int i = 0; i < m; i++)
+                Z_new[i + j * m] -= mean_j;
+        }
+        da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m, n_components,
+                            nl, static_cast<T>(1), Z_new.data(), ldz,
+                            approx_components.data(), nl, static_cast<T>(0), X_transform,
+                            ldx_transform);
+    } else {
+        for (da_int i = 0; i < m; i++) {
+            T *z = Z_new.data() + i * nl;
+#pragma omp simd
+            for (da_int j = 0; j < nl; j++)
+                z[j] -= feature_means[j];
+        }
+        da_blas::cblas_gemm(CblasRowMajor, CblasNoTrans, CblasTrans, m, n_components, nl,
+                            static_cast<T>(1), Z_new.data(), ldz,
+                            approx_components.data(), nl, static_cast<T>(0), X_transform,
+                            ldx_transform);
+    }
+
+    return da_status_success;
+}
+
 template <typename T> da_status kernel_pca<T>::check_options_update() {
     da_int kernel_int_check, degree_check;
     T gamma_check, coef0_check;
@@ -779,6 +992,9 @@ da_status kernel_pca<T>::transform(da_int m_samples, da_int m_features, const T
     if (status != da_status_success)
         return status;
 
+    if (this->solver == solver_approx)
+        return transform_approximate(m_samples, X, ldx, X_transform, ldx_transform);
+
     const da_int m = m_samples;
     // Build cross-kernel K_new (m x n_samples) in this->order layout
     // K_new[i,j] = k(x_new_i, x_train_j)
@@ -1073,6 +1289,14 @@ template <typename T> da_status kernel_pca<T>::serialize(serialization_buffer &b
     io_dispatch(this->fit_inverse);
     io_dispatch(this->remove_zero);
 
+    da_int solver_int = static_cast<da_int>(this->solver);
+    io_dispatch(solver_int);
+    this->solver = static_cast<da_kernel_pca_types::solver_type>(solver_int);
+    if (status == da_status_success)
+        status = nystroem.serialize(buffer);
+    io_dispatch(this->feature_means);
+    io_dispatch(this->approx_components);
+
     if (status != da_status_success)
         return status;
 
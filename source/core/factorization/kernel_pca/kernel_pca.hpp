@@ -29,6 +29,7 @@
 #include "basic_handle.hpp"
 #include "da_cblas.hh"
 #include "da_error.hpp"
+#include "kernel_approximation/kernel_approximation.hpp"
 #include "kernel_pca/kernel_pca_options.hpp"
 #include "kernel_pca/kernel_pca_types.hpp"
 #include "macros.h"
@@ -138,6 +139,15 @@ template <typename T> class kernel_pca : public basic_handle<T> {
     std::vector<T> eigenvalues;
     std::vector<T> eigenvectors; // V, shape n_samples x n_components
 
+    /* Approximate solver -- the kernel matrix is replaced by Z Z^T, where Z holds the
+     * Nystroem features of the training data. feature_means are the column means of Z
+     * and approx_components (n_landmarks x n_components, column-major) are the right
+     * singular vectors of the centered Z, which project new features on to the
+     * components. */
+    da_kernel_approx::nystroem_map<T> nystroem;
+    std::vector<T> feature_means;
+    std::vector<T> approx_components;
+
     // For inverse transform -- populated only when fit_inverse_transform = 1
     std::vector<T>
         dual_coef; // W: solution to (K_t + alpha*I)W = A, shape n_samples x n_features
@@ -160,6 +170,11 @@ template <typename T> class kernel_pca : public basic_handle<T> {
     // Check that kernel options have not been changed since compute()
     da_status check_options_update();
 
+    // compute() and transform() for the Nystroem-based approximate solver
+    da_status compute_approximate(da_int n_components_opt);
+    da_status transform_approximate(da_int m, const T *X, da_int ldx, T *X_transform,
+                                    da_int ldx_transform);
+
   public:
     kernel_pca(da_errors::da_error_t &err);
 
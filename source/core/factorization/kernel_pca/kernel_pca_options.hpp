@@ -26,6 +26,7 @@
 
 #include "aoclda_types.h"
 #include "da_error.hpp"
+#include "kernel_approximation/kernel_approximation_types.hpp"
 #include "kernel_pca/kernel_pca_types.hpp"
 #include "macros.h"
 #include "options.hpp"
@@ -77,7 +78,8 @@ inline da_status register_kernel_pca_options(da_options::OptionRegistry &opts,
                          "the kernel matrix",
                          {{"auto", solver_auto},
                           {"syevd", solver_syevd},
-                          {"randomized", solver_rand_syevd}},
+                          {"randomized", solver_rand_syevd},
+                          {"approximate", solver_approx}},
                          "auto"));
         opts.register_opt(os);
         oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
@@ -100,10 +102,25 @@ inline da_status register_kernel_pca_options(da_options::OptionRegistry &opts,
         oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
             "seed",
             "Seed for random number generation; set to -1 for non-deterministic results. "
-            "This option is only used in the randomized solver.",
+            "This option is only used in the randomized and approximate solvers.",
             -1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
             0));
         opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "n_landmarks",
+            "Number of Nystroem landmarks used to approximate the kernel matrix. This "
+            "option is only used in the approximate solver.",
+            1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            100));
+        opts.register_opt(oi);
+        os = std::make_shared<OptionString>(OptionString(
+            "landmark sampling",
+            "How the Nystroem landmarks are chosen in the approximate solver: a uniform "
+            "random sample of the training data or the cluster centres found by k-means.",
+            {{"uniform", da_kernel_approx_types::sampling_uniform},
+             {"kmeans", da_kernel_approx_types::sampling_kmeans}},
+            "uniform"));
+        opts.register_opt(os);
 
         std::shared_ptr<OptionNumeric<T>> oT;
         T tmax = std::numeric_limits<T>::max();
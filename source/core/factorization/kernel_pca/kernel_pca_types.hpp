@@ -30,7 +30,7 @@ namespace da_kernel_pca_types {
 
 using pca_kernel = da_kernel_functions_types::kernel_type;
 
-enum solver_type { solver_auto = 0, solver_syevd, solver_rand_syevd };
+enum solver_type { solver_auto = 0, solver_syevd, solver_rand_syevd, solver_approx };
 
 } // namespace da_kernel_pca_types
 
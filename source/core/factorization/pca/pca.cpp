@@ -53,6 +53,8 @@ template <typename T> pca<T>::pca(da_errors::da_error_t &err) : basic_handle<T>(
     // Any error is stored err->status[.] and this NEEDS to be checked
     // by the caller.
     register_pca_options<T>(this->opts, *this->err);
+    // v5.3.2: the incremental fit state and the column sums of squares are serialized
+    this->set_serialization_version(50302);
 }
 
 template <typename T> pca<T>::~pca() {
@@ -279,7 +281,55 @@ da_status pca<T>::init(da_int n, da_int p, const T *A_in, da_int lda_in) {
         A = A_in;
         this->lda = lda_in;
     }
+    read_block = nullptr;
+    read_block_data = nullptr;
 
+    return setup_dimensions(n, p);
+}
+
+/* Store a call-back supplying the user's data in row blocks, for data sets too large to be
+   held in memory */
+template <typename T>
+da_status pca<T>::init_callback(
+    da_int n, da_int p,
+    std::function<da_int(da_int, da_int, da_int, void *, T *, da_int)> read_block_in,
+    void *data) {
+
+    if (A_temp) {
+        delete[] (A_temp);
+        A_temp = nullptr;
+    }
+    A = nullptr;
+    lda = 0;
+    read_block = nullptr;
+    read_block_data = nullptr;
+    initdone = false;
+
+    std::string opt_order;
+    da_int iorder;
+    this->opts.get("storage order", opt_order, iorder);
+    this->order = da_order(iorder);
+
+    if (n < 1)
+        return da_error(this->err, da_status_invalid_input,
+                        "n_samples = " + std::to_string(n) +
+                            ", it must be greater than 0.");
+    if (p < 1)
+        return da_error(this->err, da_status_invalid_input,
+                        "n_features = " + std::to_string(p) +
+                            ", it must be greater than 0.");
+    if (!read_block_in)
+        return da_error(this->err, da_status_invalid_pointer,
+                        "The row block call-back has not been provided.");
+
+    read_block = read_block_in;
+    read_block_data = data;
+
+    return setup_dimensions(n, p);
+}
+
+/* Reset the model for a new data matrix of size n x p */
+template <typename T> da_status pca<T>::setup_dimensions(da_int n, da_int p) {
     // Store dimensions of A
     this->n = n;
     this->p = p;
@@ -293,6 +343,8 @@ da_status pca<T>::init(da_int n, da_int p, const T *A_in, da_int lda_in) {
     column_means.resize(0);
     column_sdevs.resize(0);
     column_sdevs_nonzero.resize(0);
+    column_ssq.resize(0);
+    incremental = false;
 
     // Record that initialization is complete but computation has not yet been performed
     initdone = true;
@@ -324,6 +376,9 @@ template <typename T> da_status pca<T>::compute() {
                         "No data has been passed to the handle. Please call "
                         "da_pca_set_data_s or da_pca_set_data_d.");
 
+    // Any previous incremental fit is discarded
+    incremental = false;
+
     // Read in options and store in class together with associated variables
     this->opts.get("n_components", npc);
 
@@ -348,6 +403,19 @@ template <typename T> da_status pca<T>::compute() {
     std::string svd_routine;
     this->opts.get("svd solver", svd_routine, solver);
 
+    if (read_block) {
+        // Data supplied in row blocks can only be processed by the randomized solver
+        if (solver != solver_auto && solver != solver_rand_svd)
+            return da_error(this->err, da_status_incompatible_options,
+                            "The 'svd solver' option must be set to 'auto' or "
+                            "'randomized' when the data is supplied in row blocks.");
+        if (store_U)
+            return da_error(this->err, da_status_incompatible_options,
+                            "The 'store u' option cannot be used when the data is "
+                            "supplied in row blocks.");
+        solver = solver_rand_svd;
+    }
+
     // If few components are requested, and the problem is reasonably large, use the randomized solver
     if (solver == solver_auto) {
         if (npc < std::min(n, p) / 5 && std::max(n, p) > 500) {
@@ -380,6 +448,9 @@ template <typename T> da_status pca<T>::compute() {
     power_normalizer_t normalizer_type =
         static_cast<power_normalizer_t>(rand_normalizer_int);
 
+    if (read_block)
+        return compute_streamed(p_oversample, q_iter, rand_normalizer_int);
+
     // Initialize some workspace arrays
     da_int iwork_size = 0, sigma_size = 0, A_copy_size = 0;
     ldu = n;
@@ -796,43 +867,412 @@ template <typename T> da_status pca<T>::compute() {
     return da_status_success;
 }
 
+/* Compute the PCA of data supplied in row blocks by the user's call-back. A first pass
+   over the data accumulates the column statistics with the Chan et al. update, then
+   da_random_svd_blocked computes the leading components of the standardized data in a
+   fixed number of further passes, so only a few blocks of rows are held in memory. */
+template <typename T>
+da_status pca<T>::compute_streamed(da_int p_oversample, da_int q_iter,
+                                   da_int normalizer) {
+    da_int block_size, seed;
+    this->opts.get("block size", block_size);
+    this->opts.get("seed", seed);
+    block_size = std::min(block_size, n);
+
+    bool centering = (method != pca_method_svd);
+    std::vector<T> block_user, ssq;
+    try {
+        if (this->order == row_major)
+            block_user.resize(block_size * p);
+        ssq.assign(p, (T)0.0);
+        column_means.assign(centering ? p : 0, (T)0.0);
+        column_sdevs.assign(method == pca_method_corr ? p : 0, (T)0.0);
+        column_sdevs_nonzero.assign(method == pca_method_corr ? p : 0, (T)1.0);
+        sigma.resize(npc);
+        vt.resize(npc * p);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    u.resize(0);
+    u_size = 0;
+    ldu = 0;
+    ldvt = npc;
+
+    // Read rows [first_row, first_row + n_rows) into the column-major array block,
+    // standardizing them once the column statistics are known
+    bool standardize = false;
+    auto read_rows = [&](da_int first_row, da_int n_rows, T *block,
+                         da_int ldb) -> da_status {
+        T *dest = (this->order == row_major) ? block_user.data() : block;
+        da_int ld_dest = (this->order == row_major) ? p : ldb;
+        if (read_block(first_row, n_rows, p, read_block_data, dest, ld_dest) != 0)
+            return da_error(this->err, da_status_io_error,
+                            "The row block call-back returned a nonzero value when "
+                            "reading rows " +
+                                std::to_string(first_row) + " to " +
+                                std::to_string(first_row + n_rows - 1) + ".");
+        if (this->order == row_major)
+            ARCH::da_utils::copy_transpose_2D_array_row_to_column_major<T>(
+                n_rows, p, block_user.data(), p, block, ldb);
+        if (standardize && centering) {
+            for (da_int j = 0; j < p; j++) {
+                T mean_j = column_means[j];
+                T scale_j = (method == pca_method_corr) ? column_sdevs_nonzero[j] : 1;
+#pragma omp simd
+                for (da_int i = 0; i < n_rows; i++)
+                    block[i + ldb * j] = (block[i + ldb * j] - mean_j) / scale_j;
+            }
+        }
+        return da_status_success;
+    };
+
+    // First pass: column means and sums of squared deviations
+    std::vector<T> block;
+    try {
+        block.resize(block_size * p);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    for (da_int first_row = 0; first_row < n; first_row += block_size) {
+        da_int m = std::min(block_size, n - first_row);
+        da_status status = read_rows(first_row, m, block.data(), m);
+        if (status != da_status_success)
+            return status;
+        for (da_int j = 0; j < p; j++) {
+            const T *Bj = &block[m * j];
+            if (centering) {
+                T mean_j = 0.0, ssq_j = 0.0;
+#pragma omp simd reduction(+ : mean_j)
+                for (da_int i = 0; i < m; i++)
+                    mean_j += Bj[i];
+                mean_j /= m;
+#pragma omp simd reduction(+ : ssq_j)
+                for (da_int i = 0; i < m; i++)
+                    ssq_j += (Bj[i] - mean_j) * (Bj[i] - mean_j);
+                T delta = mean_j - column_means[j];
+                column_means[j] += delta * (T)m / (T)(first_row + m);
+                ssq[j] +=
+                    ssq_j + delta * delta * (T)first_row * (T)m / (T)(first_row + m);
+            } else {
+                T ssq_j = 0.0;
+#pragma omp simd reduction(+ : ssq_j)
+                for (da_int i = 0; i < m; i++)
+                    ssq_j += Bj[i] * Bj[i];
+                ssq[j] += ssq_j;
+            }
+        }
+    }
+    block.clear();
+    block.shrink_to_fit();
+
+    total_variance = 0.0;
+    for (da_int j = 0; j < p; j++) {
+        if (method == pca_method_corr) {
+            column_sdevs[j] = sqrt(ssq[j] / div);
+            column_sdevs_nonzero[j] =
+                (column_sdevs[j] == (T)0.0) ? (T)1.0 : column_sdevs[j];
+            total_variance +=
+                ssq[j] / (column_sdevs_nonzero[j] * column_sdevs_nonzero[j]);
+        } else {
+            total_variance += ssq[j];
+        }
+    }
+    total_variance /= div;
+
+    // Further passes: randomized SVD of the standardized data
+    standardize = true;
+    da_status status =
+        da_random_svd_blocked<T>(n, p, read_rows, block_size, sigma.data(), vt.data(),
+                                 ldvt, npc, p_oversample, q_iter, seed,
+                                 static_cast<power_normalizer_t>(normalizer), *this->err);
+    if (status != da_status_success)
+        return status;
+
+    // Choose the sign of each component so that its largest absolute entry is positive
+    for (da_int i = 0; i < npc; i++) {
+        T rowmax = (T)0.0;
+        for (da_int j = 0; j < p; j++) {
+            T v = vt[i + ldvt * j];
+            rowmax = std::abs(v) > std::abs(rowmax) ? v : rowmax;
+        }
+        if (rowmax < 0) {
+            for (da_int j = 0; j < p; j++)
+                vt[i + ldvt * j] = -vt[i + ldvt * j];
+        }
+    }
+
+    ns = npc;
+    n_components = ns;
+    this->model_trained = true;
+    return da_status_success;
+}
+
+/* Update the PCA with a batch of samples, following the incremental algorithm of Ross et
+   al. as used in scikit-learn's IncrementalPCA. The current model is summarized by the
+   rank-k sketch diag(sigma) * V^T, which is stacked on top of the centered batch and a
+   row correcting for the shift in the column means. A thin SVD of this small matrix gives
+   the updated principal components, so only O(batch * p + k * p) memory is required. */
+template <typename T>
+da_status pca<T>::partial_fit(da_int m, da_int p_in, const T *X, da_int ldx) {
+
+    // Read in data storage option
+    std::string opt_order;
+    da_int iorder;
+    this->opts.get("storage order", opt_order, iorder);
+    da_order batch_order = da_order(iorder);
+
+    da_status status = this->check_2D_array(batch_order, m, p_in, X, ldx, "n_samples",
+                                            "n_features", "A", "lda", 1, 1);
+    if (status != da_status_success)
+        return status;
+
+    if (!incremental) {
+        // First batch: read in the options and reset the running state
+        da_int npc_in;
+        this->opts.get("n_components", npc_in);
+        if (npc_in == 0)
+            npc_in = std::min(m, p_in);
+        if (npc_in > std::min(m, p_in))
+            return da_error(
+                this->err, da_status_invalid_input,
+                "The first batch must contain at least n_components samples and "
+                "n_components must not exceed the number of features, but "
+                "n_components = " +
+                    std::to_string(npc_in) + " for a batch of size " + std::to_string(m) +
+                    " x " + std::to_string(p_in) + ".");
+
+        std::string opt_method;
+        da_int method_in;
+        this->opts.get("pca method", opt_method, method_in);
+        if (method_in == pca_method_corr)
+            return da_error(this->err, da_status_incompatible_options,
+                            "The 'pca method' option cannot be set to 'correlation' when "
+                            "fitting the PCA incrementally.");
+
+        da_int u_tmp;
+        this->opts.get("store u", u_tmp);
+        if (u_tmp > 0)
+            return da_error(this->err, da_status_incompatible_options,
+                            "The 'store u' option cannot be used when fitting the PCA "
+                            "incrementally.");
+
+        da_int whiten_tmp;
+        this->opts.get("whiten", whiten_tmp);
+        whiten = (whiten_tmp > 0) ? true : false;
+
+        std::string degrees_of_freedom;
+        this->opts.get("degrees of freedom", degrees_of_freedom);
+        dof = (degrees_of_freedom == "biased") ? -1 : 0;
+
+        try {
+            column_means.assign(p_in, (T)0.0);
+            column_ssq.assign(p_in, (T)0.0);
+        } catch (std::bad_alloc const &) {
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+        column_sdevs.resize(0);
+        column_sdevs_nonzero.resize(0);
+        u.resize(0);
+        sigma.resize(0);
+        vt.resize(0);
+        u_size = 0;
+        ldu = 0;
+        ldvt = 0;
+        ns = 0;
+        n = 0;
+        p = p_in;
+        npc = npc_in;
+        method = method_in;
+        store_U = false;
+        qr = false;
+        this->model_trained = false;
+        incremental = true;
+    } else if (p_in != p) {
+        return da_error(this->err, da_status_invalid_input,
+                        "The function was called with n_features = " +
+                            std::to_string(p_in) + " but the previous batches had " +
+                            std::to_string(p) + " features.");
+    }
+    this->order = batch_order;
+
+    bool centering = (method == pca_method_cov);
+    bool correct_mean = centering && n > 0;
+
+    // Stack diag(sigma) * V^T, the (centered) batch and the mean correction into B
+    da_int ldb = ns + m + (correct_mean ? 1 : 0);
+    std::vector<T> B, batch_mean, s, vt_new;
+    try {
+        B.resize(ldb * p);
+        batch_mean.resize(p, (T)0.0);
+        s.resize(std::min(ldb, p));
+        vt_new.resize(std::min(ldb, p) * p);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    da_int n_total = n + m;
+    for (da_int j = 0; j < p; j++) {
+        for (da_int i = 0; i < ns; i++) {
+            B[i + ldb * j] = sigma[i] * vt[i + ldvt * j];
+        }
+        T *Bj = &B[ns + ldb * j];
+        if (batch_order == column_major) {
+#pragma omp simd
+            for (da_int i = 0; i < m; i++) {
+                Bj[i] = X[i + ldx * j];
+            }
+        } else {
+            for (da_int i = 0; i < m; i++) {
+                Bj[i] = X[i * ldx + j];
+            }
+        }
+        if (centering) {
+            T mean_j = 0.0, ssq_j = 0.0;
+#pragma omp simd reduction(+ : mean_j)
+            for (da_int i = 0; i < m; i++) {
+                mean_j += Bj[i];
+            }
+            mean_j /= m;
+#pragma omp simd reduction(+ : ssq_j)
+            for (da_int i = 0; i < m; i++) {
+                Bj[i] -= mean_j;
+                ssq_j += Bj[i] * Bj[i];
+            }
+            batch_mean[j] = mean_j;
+            // Chan et al. update of the running mean and sum of squared deviations
+            T delta = mean_j - column_means[j];
+            if (correct_mean)
+                Bj[m] = std::sqrt((T)n * (T)m / (T)n_total) * (column_means[j] - mean_j);
+            column_means[j] += delta * (T)m / (T)n_total;
+            column_ssq[j] += ssq_j + delta * delta * (T)n * (T)m / (T)n_total;
+        } else {
+            T ssq_j = 0.0;
+#pragma omp simd reduction(+ : ssq_j)
+            for (da_int i = 0; i < m; i++) {
+                ssq_j += Bj[i] * Bj[i];
+            }
+            column_ssq[j] += ssq_j;
+        }
+    }
+
+    // Thin SVD of B; U is not required
+    char JOBU = 'N';
+    char JOBVT = 'S';
+    da_int ldvt_new = std::min(ldb, p), ldu_dummy = 1, lwork = -1, INFO = 0;
+    T estworkspace[1], u_dummy[1];
+    da::gesvd(&JOBU, &JOBVT, &ldb, &p, B.data(), &ldb, s.data(), u_dummy, &ldu_dummy,
+              vt_new.data(), &ldvt_new, estworkspace, &lwork, &INFO);
+    if (INFO != 0) {
+        return da_error(this->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "An internal error occurred while computing the PCA. Please "
+                        "check the input data for undefined values.");
+    }
+    lwork = (da_int)estworkspace[0];
+    try {
+        work.resize(lwork);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    da::gesvd(&JOBU, &JOBVT, &ldb, &p, B.data(), &ldb, s.data(), u_dummy, &ldu_dummy,
+              vt_new.data(), &ldvt_new, work.data(), &lwork, &INFO);
+    if (INFO != 0) {
+        return da_error(this->err, da_status_internal_error,
+                        "An internal error occurred while computing the PCA. Please "
+                        "check the input data for undefined values.");
+    }
+
+    // Keep the leading npc singular triplets, with the sign of each row of V^T chosen so
+    // that its largest absolute entry is positive, so that the components do not flip
+    // between batches
+    ns = npc;
+    ldvt = npc;
+    try {
+        sigma.resize(ns);
+        vt.resize(ldvt * p);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    for (da_int i = 0; i < ns; i++) {
+        T rowmax = (T)0.0;
+        for (da_int j = 0; j < p; j++) {
+            T v = vt_new[i + ldvt_new * j];
+            rowmax = std::abs(v) > std::abs(rowmax) ? v : rowmax;
+        }
+        T sign = (rowmax < 0) ? (T)-1.0 : (T)1.0;
+        for (da_int j = 0; j < p; j++) {
+            vt[i + ldvt * j] = sign * vt_new[i + ldvt_new * j];
+        }
+        sigma[i] = s[i];
+    }
+
+    n = n_total;
+    div = (dof == -1 || n == 1) ? n : n - 1;
+    sqrt_div = sqrt(div);
+
+    total_variance = 0.0;
+    for (da_int j = 0; j < p; j++) {
+        total_variance += column_ssq[j];
+    }
+    total_variance /= div;
+
+    n_components = ns;
+    this->model_trained = true;
+    return da_status_success;
+}
+
 template <typename T>
 da_status pca<T>::transform(da_int m, da_int p, const T *X, da_int ldx, T *X_transform,
                             da_int ldx_transform) {
+    _da_inference_context ctx;
+    ctx.err = this->err;
+    return transform(ctx, m, p, X, ldx, X_transform, ldx_transform);
+}
+
+template <typename T>
+da_status pca<T>::transform(_da_inference_context &ctx, da_int m, da_int p, const T *X,
+                            da_int ldx, T *X_transform, da_int ldx_transform) {
+    da_errors::da_error_t *err = ctx.err;
     if (!this->model_trained) {
-        return da_warn(this->err, da_status_no_data,
+        return da_warn(err, da_status_no_data,
                        "The PCA has not been computed. Please call da_pca_compute_s or "
                        "da_pca_compute_d.");
     }
 
     if (p != this->p)
-        return da_error(this->err, da_status_invalid_input,
+        return da_error(err, da_status_invalid_input,
                         "The function was called with m_features = " + std::to_string(p) +
                             " but the PCA has been computed with " +
                             std::to_string(this->p) + " features.");
 
     // Check for illegal arguments
 
-    da_status status = this->check_2D_array(this->order, m, p, X, ldx, "m_samples",
-                                            "m_features", "X", "ldx");
+    da_status status = this->check_2D_array(err, this->order, m, p, X, ldx,
+                                            "m_samples", "m_features", "X", "ldx");
     if (status != da_status_success)
         return status;
 
-    status =
-        this->check_2D_array(this->order, m, ns, X_transform, ldx_transform, "m_samples",
-                             "n_components", "X_transform", "ldx_transform");
+    status = this->check_2D_array(err, this->order, m, ns, X_transform, ldx_transform,
+                                  "m_samples", "n_components", "X_transform",
+                                  "ldx_transform");
     if (status != da_status_success)
         return status;
 
-    std::vector<T> v;
-    da_int ldv;
+    // Workspace: the scaled loadings V, then the mean correction
+    std::vector<T> &work = ctx.workspace<T>();
+    da_int ldv = (this->order == column_major) ? p : npc;
     try {
-        v.resize(p * npc);
-        ldv = (this->order == column_major) ? p : npc;
+        work.resize((size_t)p * npc + npc);
     } catch (std::bad_alloc const &) {
-        return da_error(this->err, da_status_memory_error,
+        return da_error(err, da_status_memory_error,
                         "Memory allocation failed."); // LCOV_EXCL_LINE
     }
+    T *v = work.data();
 
     T sdev_factor;
     // If whitening, transform V -> V * S^-1 * sqrt(div)
@@ -906,21 +1346,15 @@ da_status pca<T>::transform(da_int m, da_int p, const T *X, da_int ldx, T *X_tra
 
     auto cblas_storage = (this->order == column_major) ? CblasColMajor : CblasRowMajor;
     da_blas::cblas_gemm(cblas_storage, CblasNoTrans, CblasNoTrans, m, npc, p, 1.0, X, ldx,
-                        v.data(), ldv, 0.0, X_transform, ldx_transform);
+                        v, ldv, 0.0, X_transform, ldx_transform);
 
     if (method == pca_method_cov || method == pca_method_corr) {
         // Get mean correction \mu
         // \mu is rank 1 matrix where each row is column_means
-        std::vector<T> mean_correction;
-        try {
-            mean_correction.resize(npc);
-        } catch (std::bad_alloc const &) {
-            return da_error(this->err, da_status_memory_error,
-                            "Memory allocation failed."); // LCOV_EXCL_LINE
-        }
+        T *mean_correction = v + (size_t)p * npc;
 
-        da_blas::cblas_gemv(cblas_storage, CblasTrans, p, npc, (T)1.0, v.data(), ldv,
-                            column_means.data(), 1, (T)0.0, mean_correction.data(), 1);
+        da_blas::cblas_gemv(cblas_storage, CblasTrans, p, npc, (T)1.0, v, ldv,
+                            column_means.data(), 1, (T)0.0, mean_correction, 1);
 
         if (this->order == column_major) {
 #pragma omp parallel for collapse(2)                                                     \
@@ -1084,6 +1518,8 @@ template <typename T> da_status pca<T>::serialize(serialization_buffer &buffer)
     io_dispatch(this->sigma);
     io_dispatch(this->vt);
     io_dispatch(this->total_variance);
+    io_dispatch(this->incremental);
+    io_dispatch(this->column_ssq);
 
     return status;
 }
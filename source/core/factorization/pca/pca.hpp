@@ -25,9 +25,11 @@
 #include "aoclda_pca.h"
 #include "basic_handle.hpp"
 #include "da_error.hpp"
+#include "da_inference_context.hpp"
 #include "macros.h"
 #include "model_persistence.hpp"
 #include "pca_types.hpp"
+#include <functional>
 #include <vector>
 
 #ifndef PCA_HPP
@@ -94,6 +96,20 @@ template <typename T> class pca : public basic_handle<T> {
     std::vector<T> u, sigma, vt, work, A_copy;
     std::vector<da_int> iwork;
 
+    /* Set true when the model is being built batch by batch using partial_fit */
+    bool incremental = false;
+    /* Running sum of squared deviations from the column means (or sum of squares if not centering) */
+    std::vector<T> column_ssq;
+
+    /* Call-back supplying row blocks of the data when it is not held in memory */
+    std::function<da_int(da_int, da_int, da_int, void *, T *, da_int)> read_block =
+        nullptr;
+    void *read_block_data = nullptr;
+
+    da_status setup_dimensions(da_int n, da_int p);
+
+    da_status compute_streamed(da_int p_oversample, da_int q_iter, da_int normalizer);
+
   public:
     pca(da_errors::da_error_t &err);
 
@@ -105,11 +121,24 @@ template <typename T> class pca : public basic_handle<T> {
 
     da_status init(da_int n, da_int p, const T *A, da_int lda);
 
+    da_status init_callback(
+        da_int n, da_int p,
+        std::function<da_int(da_int, da_int, da_int, void *, T *, da_int)> read_block,
+        void *data);
+
     da_status compute();
 
+    da_status partial_fit(da_int m, da_int p, const T *X, da_int ldx);
+
     da_status transform(da_int m, da_int p, const T *X, da_int ldx, T *X_transform,
                         da_int ldx_transform);
 
+    /* Version of transform which only reads the computed model: errors and temporary
+     * arrays go to ctx, so it can be called concurrently on the same handle
+     */
+    da_status transform(_da_inference_context &ctx, da_int m, da_int p, const T *X,
+                        da_int ldx, T *X_transform, da_int ldx_transform);
+
     da_status inverse_transform(da_int k, da_int r, const T *X, da_int ldx,
                                 T *X_inv_transform, da_int ldx_inv_transform);
 
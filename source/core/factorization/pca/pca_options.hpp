@@ -109,6 +109,13 @@ inline da_status register_pca_options(da_options::OptionRegistry &opts,
             -1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
             0));
         opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "block size",
+            "Number of rows requested from the call-back at a time when the data is "
+            "supplied in row blocks.",
+            1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            4096));
+        opts.register_opt(oi);
 
     } catch (std::bad_alloc &) {
         return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
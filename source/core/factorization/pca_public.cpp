@@ -23,6 +23,7 @@
 
 #include "pca_public.hpp"
 #include "aoclda.h"
+#include "aoclda_cpp_overloads.hpp"
 #include "da_handle.hpp"
 #include "dynamic_dispatch.hpp"
 #include "macros.h"
@@ -46,6 +47,24 @@ da_status da_pca_set_data(da_handle handle, da_int n_samples, da_int n_features,
     return da_status_success;
 }
 
+template <typename T>
+da_status da_pca_set_data_callback(da_handle handle, da_int n_samples, da_int n_features,
+                                   da_pca_block_t<T> *read_block, void *data) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err,
+               return (pca_init_callback<da_pca::pca<T>, T, da_pca_block_t<T>>(
+                   handle, n_samples, n_features, read_block, data)))
+
+    return da_status_success;
+}
+
 template <typename T> da_status da_pca_compute(da_handle handle) {
     if (!handle)
         return da_status_handle_not_initialized;
@@ -60,6 +79,23 @@ template <typename T> da_status da_pca_compute(da_handle handle) {
     return da_status_success;
 }
 
+template <typename T>
+da_status da_pca_partial_fit(da_handle handle, da_int n_samples, da_int n_features,
+                             const T *A, da_int lda) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err, return (pca_partial_fit<da_pca::pca<T>, T>(
+                                handle, n_samples, n_features, A, lda)))
+
+    return da_status_success;
+}
+
 template <typename T>
 da_status da_pca_transform(da_handle handle, da_int m_samples, da_int m_features,
                            const T *X, da_int ldx, T *X_transform, da_int ldx_transform) {
@@ -78,6 +114,28 @@ da_status da_pca_transform(da_handle handle, da_int m_samples, da_int m_features
     return da_status_success;
 }
 
+template <typename T>
+da_status da_pca_transform(da_handle handle, da_inference_context ctx, da_int m_samples,
+                           da_int m_features, const T *X, da_int ldx, T *X_transform,
+                           da_int ldx_transform) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    if (!ctx)
+        return da_status_invalid_pointer;
+    ctx->clear(); // Clean up context logs, the handle is only read
+
+    da_status status = handle->check_precision<T>(ctx->err);
+    if (status != da_status_success)
+        return da_error_trace(ctx->err, status, "Wrong precision type.");
+
+    DISPATCHER(ctx->err,
+               return (pca_transform<da_pca::pca<T>, T>(handle, ctx, m_samples,
+                                                        m_features, X, ldx, X_transform,
+                                                        ldx_transform)))
+
+    return da_status_success;
+}
+
 template <typename T>
 da_status da_pca_inverse_transform(da_handle handle, da_int k_samples, da_int k_features,
                                    const T *X, da_int ldx, T *X_inv_transform,
@@ -101,12 +159,26 @@ template da_status da_pca_set_data<float>(da_handle, da_int, da_int, const float
                                           da_int);
 template da_status da_pca_set_data<double>(da_handle, da_int, da_int, const double *,
                                            da_int);
+template da_status da_pca_set_data_callback<float>(da_handle, da_int, da_int,
+                                                   da_pca_block_t<float> *, void *);
+template da_status da_pca_set_data_callback<double>(da_handle, da_int, da_int,
+                                                    da_pca_block_t<double> *, void *);
 template da_status da_pca_compute<float>(da_handle);
 template da_status da_pca_compute<double>(da_handle);
+template da_status da_pca_partial_fit<float>(da_handle, da_int, da_int, const float *,
+                                             da_int);
+template da_status da_pca_partial_fit<double>(da_handle, da_int, da_int, const double *,
+                                              da_int);
 template da_status da_pca_transform<float>(da_handle, da_int, da_int, const float *,
                                            da_int, float *, da_int);
 template da_status da_pca_transform<double>(da_handle, da_int, da_int, const double *,
                                             da_int, double *, da_int);
+template da_status da_pca_transform<float>(da_handle, da_inference_context, da_int,
+                                           da_int, const float *, da_int, float *,
+                                           da_int);
+template da_status da_pca_transform<double>(da_handle, da_inference_context, da_int,
+                                            da_int, const double *, da_int, double *,
+                                            da_int);
 template da_status da_pca_inverse_transform<float>(da_handle, da_int, da_int,
                                                    const float *, da_int, float *,
                                                    da_int);
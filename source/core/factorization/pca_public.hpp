@@ -23,6 +23,7 @@
 
 #include "aoclda.h"
 #include "da_handle.hpp"
+#include "da_inference_context.hpp"
 #include "dynamic_dispatch.hpp"
 #include "macros.h"
 
@@ -37,7 +38,25 @@ da_status pca_init(da_handle handle, da_int n_samples, da_int n_features, const
                         "handle was not initialized with handle_type=da_handle_pca or "
                         "handle is invalid.");
 
-    return pca->init(n_samples, n_features, A, lda);
+    da_status status = pca->init(n_samples, n_features, A, lda);
+    if (status == da_status_success)
+        pca->release_datastore_data();
+    return status;
+}
+
+template <typename pca_class, typename T, typename block_fun>
+da_status pca_init_callback(da_handle handle, da_int n_samples, da_int n_features,
+                            block_fun *read_block, void *data) {
+    pca_class *pca = dynamic_cast<pca_class *>(handle->get_alg_handle<T>());
+    if (pca == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_pca or "
+                        "handle is invalid.");
+
+    da_status status = pca->init_callback(n_samples, n_features, read_block, data);
+    if (status == da_status_success)
+        pca->release_datastore_data();
+    return status;
 }
 
 template <typename pca_class, typename T> da_status pca_compute(da_handle handle) {
@@ -50,6 +69,18 @@ template <typename pca_class, typename T> da_status pca_compute(da_handle handle
     return pca->compute();
 }
 
+template <typename pca_class, typename T>
+da_status pca_partial_fit(da_handle handle, da_int n_samples, da_int n_features,
+                          const T *A, da_int lda) {
+    pca_class *pca = dynamic_cast<pca_class *>(handle->get_alg_handle<T>());
+    if (pca == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_pca or "
+                        "handle is invalid.");
+
+    return pca->partial_fit(n_samples, n_features, A, lda);
+}
+
 template <typename pca_class, typename T>
 da_status pca_transform(da_handle handle, da_int m_samples, da_int m_features, const T *X,
                         da_int ldx, T *X_transform, da_int ldx_transform) {
@@ -62,6 +93,20 @@ da_status pca_transform(da_handle handle, da_int m_samples, da_int m_features, c
     return pca->transform(m_samples, m_features, X, ldx, X_transform, ldx_transform);
 }
 
+template <typename pca_class, typename T>
+da_status pca_transform(da_handle handle, da_inference_context ctx, da_int m_samples,
+                        da_int m_features, const T *X, da_int ldx, T *X_transform,
+                        da_int ldx_transform) {
+    pca_class *pca = dynamic_cast<pca_class *>(handle->get_alg_handle<T>());
+    if (pca == nullptr)
+        return da_error(ctx->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_pca or "
+                        "handle is invalid.");
+
+    return pca->transform(*ctx, m_samples, m_features, X, ldx, X_transform,
+                          ldx_transform);
+}
+
 template <typename pca_class, typename T>
 da_status pca_inverse_transform(da_handle handle, da_int k_samples, da_int k_features,
                                 const T *X, da_int ldx, T *X_inv_transform,
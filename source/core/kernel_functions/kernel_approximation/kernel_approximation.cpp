@@ -0,0 +1,667 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "kernel_approximation.hpp"
+#include "aoclda.h"
+#include "da_cblas.hh"
+#include "da_error.hpp"
+#include "kernel_approximation_options.hpp"
+#include "kernel_approximation_types.hpp"
+#include "kernel_functions.hpp"
+#include "kmeans/kmeans.hpp"
+#include "lapack_templates.hpp"
+#include "macros.h"
+#include "options.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ARCH {
+
+namespace da_kernel_approx {
+
+using namespace da_kernel_approx_types;
+using namespace da_model_persistence;
+
+// Number of rows of the cross kernel matrix formed at once by the Nystroem transform
+constexpr da_int nystroem_block_size = 2048;
+
+template <typename T>
+da_status evaluate_kernel(approx_kernel kernel, da_order order, da_int m, da_int n,
+                          da_int k, const T *X, da_int ldx, const T *Y, da_int ldy, T *D,
+                          da_int ldd, T gamma, da_int degree, T coef0) {
+    switch (kernel) {
+    case approx_kernel::linear:
+        return da_kernel_functions::linear_kernel<T>(order, m, n, k, X, ldx, Y, ldy, D,
+                                                     ldd);
+    case approx_kernel::polynomial:
+        return da_kernel_functions::polynomial_kernel<T>(order, m, n, k, X, ldx, Y, ldy,
+                                                         D, ldd, gamma, degree, coef0);
+    case approx_kernel::rbf:
+        return da_kernel_functions::rbf_kernel<T>(order, m, n, k, X, ldx, Y, ldy, D, ldd,
+                                                  gamma);
+    case approx_kernel::sigmoid:
+        return da_kernel_functions::sigmoid_kernel<T>(order, m, n, k, X, ldx, Y, ldy, D,
+                                                      ldd, gamma, coef0);
+    default:
+        return da_status_internal_error; // LCOV_EXCL_LINE
+    }
+}
+
+template <typename T>
+da_status nystroem_map<T>::fit(da_errors::da_error_t *err, da_int n_samples, const T *X,
+                               da_int ldx, landmark_sampling sampling, da_int seed) {
+    /*
+    C. K. I. Williams and M. Seeger, "Using the Nystroem method to speed up kernel
+    machines," in Advances in Neural Information Processing Systems 13, 2001.
+    */
+    const da_int m = n_landmarks;
+    const da_int ldl = ld_landmarks();
+    std::vector<T> eigenvalues, scaled_vectors;
+    try {
+        landmarks.resize(m * n_features);
+        normalization.resize(m * m);
+        eigenvalues.resize(m);
+        scaled_vectors.resize(m * m);
+    } catch (std::bad_alloc const &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    da_status status;
+    if (sampling == sampling_kmeans) {
+        // Use the k-means cluster centres as landmarks, which usually gives a more
+        // accurate approximation than a uniform sample for the same number of landmarks
+        da_kmeans::kmeans<T> km(*err);
+        da_options::OptionRegistry &opts = km.get_opts();
+        da_int n_init = 1;
+        opts.set("storage order", order == column_major ? "column-major" : "row-major");
+        opts.set("n_clusters", m);
+        opts.set("n_init", n_init);
+        opts.set("seed", seed);
+        status = km.set_data(n_samples, n_features, X, ldx);
+        if (status == da_status_success) {
+            status = km.compute();
+            if (status == da_status_maxit)
+                status = da_status_success;
+        }
+        if (status == da_status_success) {
+            da_int dim = m * n_features;
+            status = km.get_result(da_kmeans_cluster_centres, &dim, landmarks.data());
+        }
+        if (status != da_status_success)
+            return da_error_bypass(err, status,
+                                   "k-means selection of the Nystroem landmarks failed.");
+    } else {
+        // Uniform sample without replacement, kept in the original row order
+        std::vector<da_int> index;
+        try {
+            index.resize(n_samples);
+        } catch (std::bad_alloc const &) {
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+        std::iota(index.begin(), index.end(), 0);
+        std::mt19937_64 mt_gen(seed);
+        for (da_int i = 0; i < m; i++) {
+            std::uniform_int_distribution<da_int> pick(i, n_samples - 1);
+            std::swap(index[i], index[pick(mt_gen)]);
+        }
+        std::sort(index.begin(), index.begin() + m);
+
+        if (order == column_major) {
+            for (da_int j = 0; j < n_features; j++)
+                for (da_int i = 0; i < m; i++)
+                    landmarks[i + j * ldl] = X[index[i] + j * ldx];
+        } else {
+            for (da_int i = 0; i < m; i++)
+                memcpy(landmarks.data() + i * ldl, X + index[i] * ldx,
+                       n_features * sizeof(T));
+        }
+    }
+
+    // Kernel matrix of the landmarks, which is symmetric so the layout does not matter
+    status = evaluate_kernel(kernel, order, m, m, n_features, landmarks.data(), ldl,
+                             static_cast<const T *>(nullptr), m, normalization.data(), m,
+                             gamma, degree, coef0);
+    if (status != da_status_success)
+        return da_error(err, status, "Kernel computation for the landmarks failed.");
+
+    // K_mm = Q diag(lambda) Q^T
+    char JOB = 'V', UPLO = 'U';
+    da_int lwork = -1, liwork = -1, INFO = 0, n = m;
+    T estworkspace[1];
+    da_int estiworkspace[1];
+    da::syevd(&JOB, &UPLO, &n, normalization.data(), &n, eigenvalues.data(), estworkspace,
+              &lwork, estiworkspace, &liwork, &INFO);
+    if (INFO != 0)
+        return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "An internal error occurred while computing the Nystroem "
+                        "normalization.");
+    lwork = static_cast<da_int>(estworkspace[0]);
+    liwork = estiworkspace[0];
+    std::vector<T> work;
+    std::vector<da_int> iwork;
+    try {
+        work.resize(lwork);
+        iwork.resize(liwork);
+    } catch (std::bad_alloc const &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    da::syevd(&JOB, &UPLO, &n, normalization.data(), &n, eigenvalues.data(), work.data(),
+              &lwork, iwork.data(), &liwork, &INFO);
+    if (INFO != 0)
+        return da_error(err, da_status_numerical_difficulties,
+                        "The eigendecomposition of the landmark kernel matrix failed. "
+                        "Please check the input data for undefined values.");
+
+    /* K_mm^{-1/2} = Q diag(w) Q^T with w_i = sign(lambda_i) / sqrt(|lambda_i|). K_mm is
+     * often numerically singular (duplicated landmarks, linear kernel with fewer
+     * features than landmarks), so tiny eigenvalues are dropped as in a pseudo-inverse.
+     * Indefinite kernels such as sigmoid keep the sign, matching an SVD-based inverse
+     * square root. */
+    T lambda_max = std::max(std::abs(eigenvalues[0]), std::abs(eigenvalues[m - 1]));
+    T tol = static_cast<T>(m) * std::numeric_limits<T>::epsilon() * lambda_max;
+    for (da_int j = 0; j < m; j++) {
+        T lambda = eigenvalues[j];
+        T w = (std::abs(lambda) > tol) ? static_cast<T>(1) / std::sqrt(std::abs(lambda))
+                                       : static_cast<T>(0);
+        if (lambda < 0)
+            w = -w;
+#pragma omp simd
+        for (da_int i = 0; i < m; i++)
+            scaled_vectors[i + j * m] = normalization[i + j * m] * w;
+    }
+    std::vector<T> Q;
+    Q.swap(normalization);
+    try {
+        normalization.resize(m * m);
+    } catch (std::bad_alloc const &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasTrans, m, m, m,
+                        static_cast<T>(1), scaled_vectors.data(), m, Q.data(), m,
+                        static_cast<T>(0), normalization.data(), m);
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status nystroem_map<T>::transform(da_errors::da_error_t *err, da_int m, const T *X,
+                                     da_int ldx, T *Z, da_int ldz) const {
+    /* Z = K(X, L) K_mm^{-1/2}, formed in blocks of rows so that the cross kernel
+     * matrix never needs more than nystroem_block_size x n_landmarks storage */
+    const da_int block = std::min(m, nystroem_block_size);
+    const da_int ldl = ld_landmarks();
+    std::vector<T> K_block;
+    try {
+        K_block.resize(block * n_landmarks);
+    } catch (std::bad_alloc const &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    CBLAS_ORDER cblas_order = (order == column_major) ? CblasColMajor : CblasRowMajor;
+    for (da_int start = 0; start < m; start += block) {
+        da_int nb = std::min(block, m - start);
+        da_int ldk = (order == column_major) ? nb : n_landmarks;
+        const T *X_block = (order == column_major) ? X + start : X + start * ldx;
+        T *Z_block = (order == column_major) ? Z + start : Z + start * ldz;
+
+        da_status status = evaluate_kernel(kernel, order, nb, n_landmarks, n_features,
+                                           X_block, ldx, landmarks.data(), ldl,
+                                           K_block.data(), ldk, gamma, degree, coef0);
+        if (status != da_status_success)
+            return da_error(err, status, "Cross-kernel computation failed.");
+
+        // The normalization matrix is symmetric so it can be used in either layout
+        da_blas::cblas_gemm(cblas_order, CblasNoTrans, CblasNoTrans, nb, n_landmarks,
+                            n_landmarks, static_cast<T>(1), K_block.data(), ldk,
+                            normalization.data(), n_landmarks, static_cast<T>(0),
+                            Z_block, ldz);
+    }
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status nystroem_map<T>::serialize(serialization_buffer &buffer) {
+    da_status status = da_status_success;
+    auto io_dispatch = [&buffer, &status](auto &data) -> void {
+        if (status != da_status_success) {
+            return;
+        }
+        status = buffer.dispatch_buffer_io(data);
+        return;
+    };
+
+    io_dispatch(this->order);
+    da_int kernel_int = static_cast<da_int>(this->kernel);
+    io_dispatch(kernel_int);
+    this->kernel = static_cast<approx_kernel>(kernel_int);
+    io_dispatch(this->gamma);
+    io_dispatch(this->coef0);
+    io_dispatch(this->degree);
+    io_dispatch(this->n_features);
+    io_dispatch(this->n_landmarks);
+    io_dispatch(this->landmarks);
+    io_dispatch(this->normalization);
+
+    return status;
+}
+
+template <typename T> da_status rff_map<T>::fit(da_errors::da_error_t *err, da_int seed) {
+    /*
+    A. Rahimi and B. Recht, "Random features for large-scale kernel machines," in
+    Advances in Neural Information Processing Systems 20, 2007.
+    */
+    try {
+        weights.resize(n_features * n_components);
+        offsets.resize(n_components);
+    } catch (std::bad_alloc const &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    // The Fourier transform of exp(-gamma ||d||^2) is a Gaussian of variance 2 gamma
+    std::mt19937_64 mt_gen(seed);
+    std::normal_distribution<T> normal(static_cast<T>(0), std::sqrt(2 * gamma));
+    const T two_pi = static_cast<T>(6.283185307179586476925286766559);
+    std::uniform_real_distribution<T> uniform(static_cast<T>(0), two_pi);
+    for (T &w : weights)
+        w = normal(mt_gen);
+    for (T &b : offsets)
+        b = uniform(mt_gen);
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status rff_map<T>::transform([[maybe_unused]] da_errors::da_error_t *err, da_int m,
+                                const T *X, da_int ldx, T *Z, da_int ldz) const {
+    // Z = X W, then each entry is replaced by sqrt(2 / n_components) cos(z + b)
+    if (order == column_major)
+        da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m, n_components,
+                            n_features, static_cast<T>(1), X, ldx, weights.data(),
+                            n_features, static_cast<T>(0), Z, ldz);
+    else
+        da_blas::cblas_gemm(CblasRowMajor, CblasNoTrans, CblasTrans, m, n_components,
+                            n_features, static_cast<T>(1), X, ldx, weights.data(),
+                            n_features, static_cast<T>(0), Z, ldz);
+
+    const T scale = std::sqrt(static_cast<T>(2) / static_cast<T>(n_components));
+    const T *b = offsets.data();
+    if (order == column_major) {
+#pragma omp parallel for schedule(static)
+        for (da_int j = 0; j < n_components; j++) {
+            T *Zj = Z + j * ldz;
+            for (da_int i = 0; i < m; i++)
+                Zj[i] = scale * std::cos(Zj[i] + b[j]);
+        }
+    } else {
+#pragma omp parallel for schedule(static)
+        for (da_int i = 0; i < m; i++) {
+            T *Zi = Z + i * ldz;
+            for (da_int j = 0; j < n_components; j++)
+                Zi[j] = scale * std::cos(Zi[j] + b[j]);
+        }
+    }
+
+    return da_status_success;
+}
+
+template <typename T> da_status rff_map<T>::serialize(serialization_buffer &buffer) {
+    da_status status = da_status_success;
+    auto io_dispatch = [&buffer, &status](auto &data) -> void {
+        if (status != da_status_success) {
+            return;
+        }
+        status = buffer.dispatch_buffer_io(data);
+        return;
+    };
+
+    io_dispatch(this->order);
+    io_dispatch(this->gamma);
+    io_dispatch(this->n_features);
+    io_dispatch(this->n_components);
+    io_dispatch(this->weights);
+    io_dispatch(this->offsets);
+
+    return status;
+}
+
+template <typename T>
+kernel_approximation<T>::kernel_approximation(da_errors::da_error_t &err)
+    : basic_handle<T>(err) {
+    register_kernel_approx_options<T>(this->opts, err);
+}
+
+template <typename T>
+da_status kernel_approximation<T>::set_data(da_int n_samples_in, da_int n_features_in,
+                                            const T *X_in, da_int ldx_in) {
+    std::string opt_order;
+    da_int iorder;
+    this->opts.get("storage order", opt_order, iorder);
+    this->order = da_order(iorder);
+
+    da_status status =
+        this->check_2D_array(this->order, n_samples_in, n_features_in, X_in, ldx_in,
+                             "n_samples", "n_features", "X", "ldx");
+    if (status != da_status_success)
+        return status;
+
+    this->model_trained = false;
+    n_samples = n_samples_in;
+    n_features = n_features_in;
+    X = X_in;
+    ldx = ldx_in;
+    initdone = true;
+
+    return da_status_success;
+}
+
+template <typename T> da_status kernel_approximation<T>::compute() {
+    if (!initdone)
+        return da_error(this->err, da_status_no_data,
+                        "No data has been provided. Please call "
+                        "da_kernel_approx_set_data_? before da_kernel_approx_compute_?.");
+
+    da_int nc_opt, method_int, kernel_int, sampling_int, degree, seed;
+    std::string method_str, kernel_str, sampling_str;
+    T coef0;
+    this->opts.get("n_components", nc_opt);
+    this->opts.get("method", method_str, method_int);
+    this->opts.get("kernel", kernel_str, kernel_int);
+    this->opts.get("landmark sampling", sampling_str, sampling_int);
+    this->opts.get("gamma", gamma);
+    this->opts.get("degree", degree);
+    this->opts.get("coef0", coef0);
+    this->opts.get("seed", seed);
+
+    method = static_cast<approx_method>(method_int);
+    approx_kernel kernel = static_cast<approx_kernel>(kernel_int);
+    if (method == random_fourier && kernel != approx_kernel::rbf)
+        return da_error(this->err, da_status_incompatible_options,
+                        "Random Fourier features are only available for the rbf kernel. "
+                        "Use the Nystroem method for other kernels.");
+
+    if (gamma < 0)
+        gamma = static_cast<T>(1.0) / static_cast<T>(n_features);
+    if (method == random_fourier && gamma == 0)
+        return da_error(this->err, da_status_invalid_input,
+                        "gamma must be positive to use random Fourier features.");
+
+    if (seed == -1) {
+        std::random_device r;
+        seed = std::abs((da_int)r());
+    }
+
+    this->model_trained = false;
+    da_status status;
+    bool reduced = false;
+    if (method == nystroem) {
+        // There cannot be more landmarks than training samples
+        reduced = nc_opt > n_samples;
+        n_components = std::min(nc_opt, n_samples);
+        nys.order = this->order;
+        nys.kernel = kernel;
+        nys.gamma = gamma;
+        nys.coef0 = coef0;
+        nys.degree = degree;
+        nys.n_features = n_features;
+        nys.n_landmarks = n_components;
+        status = nys.fit(this->err, n_samples, X, ldx,
+                         static_cast<landmark_sampling>(sampling_int), seed);
+        rff = rff_map<T>();
+    } else {
+        n_components = nc_opt;
+        rff.order = this->order;
+        rff.gamma = gamma;
+        rff.n_features = n_features;
+        rff.n_components = n_components;
+        status = rff.fit(this->err, seed);
+        nys = nystroem_map<T>();
+    }
+    if (status != da_status_success)
+        return status;
+
+    this->model_trained = true;
+
+    if (reduced)
+        return da_warn(this->err, da_status_incompatible_options,
+                       "The number of Nystroem landmarks has been decreased from " +
+                           std::to_string(nc_opt) + " to the number of samples, " +
+                           std::to_string(n_samples) + ".");
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status kernel_approximation<T>::transform(da_int m_samples, da_int m_features,
+                                             const T *X_new, da_int ldx_new,
+                                             T *X_transform, da_int ldx_transform) {
+    if (!this->model_trained)
+        return da_error(this->err, da_status_no_data,
+                        "The kernel approximation has not been computed. Please call "
+                        "da_kernel_approx_compute_? before da_kernel_approx_transform_?.");
+
+    if (m_features != n_features)
+        return da_error(this->err, da_status_invalid_input,
+                        "da_kernel_approx_transform_? was called with m_features = " +
+                            std::to_string(m_features) +
+                            " but the model was computed with " +
+                            std::to_string(n_features) + " features.");
+
+    da_status status = this->check_2D_array(this->order, m_samples, m_features, X_new,
+                                            ldx_new, "m_samples", "m_features", "X",
+                                            "ldx");
+    if (status != da_status_success)
+        return status;
+
+    status = this->check_2D_array(this->order, m_samples, n_components, X_transform,
+                                  ldx_transform, "m_samples", "n_components",
+                                  "X_transform", "ldx_transform");
+    if (status != da_status_success)
+        return status;
+
+    if (method == nystroem)
+        return nys.transform(this->err, m_samples, X_new, ldx_new, X_transform,
+                             ldx_transform);
+    return rff.transform(this->err, m_samples, X_new, ldx_new, X_transform,
+                         ldx_transform);
+}
+
+template <typename T>
+da_status kernel_approximation<T>::get_result(da_result query, da_int *dim, T *result) {
+    if (!this->model_trained)
+        return da_warn(this->err, da_status_no_data,
+                       "The kernel approximation has not been computed. Please call "
+                       "da_kernel_approx_compute_? before querying results.");
+
+    da_int required;
+    switch (query) {
+    case da_rinfo:
+        required = 4;
+        if (*dim < required)
+            break;
+        result[0] = static_cast<T>(n_samples);
+        result[1] = static_cast<T>(n_features);
+        result[2] = static_cast<T>(n_components);
+        result[3] = gamma;
+        return da_status_success;
+
+    case da_kernel_approx_components:
+        required = n_components * n_features;
+        if (*dim < required)
+            break;
+        if (method == nystroem)
+            // Landmarks are already stored in the order of the handle
+            std::copy(nys.landmarks.begin(), nys.landmarks.end(), result);
+        else
+            this->copy_2D_results_array(n_features, n_components, rff.weights.data(),
+                                        n_features, result);
+        return da_status_success;
+
+    case da_kernel_approx_normalization:
+        if (method != nystroem)
+            return da_warn(this->err, da_status_unknown_query,
+                           "The normalization matrix is only available for the Nystroem "
+                           "method.");
+        required = n_components * n_components;
+        if (*dim < required)
+            break;
+        std::copy(nys.normalization.begin(), nys.normalization.end(), result);
+        return da_status_success;
+
+    case da_kernel_approx_offsets:
+        if (method != random_fourier)
+            return da_warn(this->err, da_status_unknown_query,
+                           "The random offsets are only available for random Fourier "
+                           "features.");
+        required = n_components;
+        if (*dim < required)
+            break;
+        std::copy(rff.offsets.begin(), rff.offsets.end(), result);
+        return da_status_success;
+
+    default:
+        return da_warn(this->err, da_status_unknown_query,
+                       "The requested result is not available for kernel approximation.");
+    }
+
+    *dim = required;
+    return da_warn(this->err, da_status_invalid_array_dimension,
+                   "The results array is too small. Please provide an array of size at "
+                   "least " +
+                       std::to_string(required) + ".");
+}
+
+template <typename T>
+da_status kernel_approximation<T>::get_result(da_result query, da_int *dim,
+                                              da_int *result) {
+    da_status status = this->get_result_common(query, dim, result);
+    if (status != da_status_unknown_query)
+        return status;
+
+    if (!this->model_trained)
+        return da_warn(this->err, da_status_no_data,
+                       "The kernel approximation has not been computed. Please call "
+                       "da_kernel_approx_compute_? before querying results.");
+
+    switch (query) {
+    case da_kernel_approx_n_components:
+        if (*dim < 1) {
+            *dim = 1;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The results array is too small. Please provide an array of "
+                           "size at least 1.");
+        }
+        result[0] = n_components;
+        return da_status_success;
+    default:
+        return da_warn(this->err, da_status_unknown_query,
+                       "The requested result is not available for kernel approximation.");
+    }
+}
+
+template <typename T>
+da_status kernel_approximation<T>::serialize(serialization_buffer &buffer) {
+    da_status status = da_status_success;
+    auto io_dispatch = [&buffer, &status](auto &data) -> void {
+        if (status != da_status_success) {
+            return;
+        }
+        status = buffer.dispatch_buffer_io(data);
+        return;
+    };
+
+    io_dispatch(this->model_trained);
+    io_dispatch(this->order);
+    io_dispatch(this->n_samples);
+    io_dispatch(this->n_features);
+    da_int method_int = static_cast<da_int>(this->method);
+    io_dispatch(method_int);
+    this->method = static_cast<approx_method>(method_int);
+    io_dispatch(this->n_components);
+    io_dispatch(this->gamma);
+    if (status != da_status_success)
+        return status;
+
+    status = nys.serialize(buffer);
+    if (status != da_status_success)
+        return status;
+    return rff.serialize(buffer);
+}
+
+template <typename T>
+da_status kernel_approximation<T>::save_model(serialization_buffer &buffer) {
+    if (!this->model_trained)
+        return da_error(this->err, da_status_no_data,
+                        "The kernel approximation has not been computed. Please call "
+                        "da_kernel_approx_compute_s or da_kernel_approx_compute_d.");
+    da_status status = basic_handle<T>::save_model(buffer);
+    if (status != da_status_success)
+        return da_error_trace(this->err, status, "Failure serializing model.");
+    return status;
+}
+
+template <typename T>
+da_status kernel_approximation<T>::load_model(serialization_buffer &buffer) {
+    da_status status = basic_handle<T>::load_model(buffer);
+    if (status != da_status_success)
+        return da_error_trace(this->err, status, "Failure deserializing model.");
+    // The training data is not needed once the feature map has been fitted
+    X = nullptr;
+    ldx = 0;
+    initdone = false;
+    return da_status_success;
+}
+
+/* Explicit instantiations */
+template da_status evaluate_kernel<float>(approx_kernel, da_order, da_int, da_int, da_int,
+                                          const float *, da_int, const float *, da_int,
+                                          float *, da_int, float, da_int, float);
+template da_status evaluate_kernel<double>(approx_kernel, da_order, da_int, da_int,
+                                           da_int, const double *, da_int,
+                                           const double *, da_int, double *, da_int,
+                                           double, da_int, double);
+template class nystroem_map<double>;
+template class nystroem_map<float>;
+template class rff_map<double>;
+template class rff_map<float>;
+template class kernel_approximation<double>;
+template class kernel_approximation<float>;
+
+} // namespace da_kernel_approx
+} // namespace ARCH
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef KERNEL_APPROXIMATION_HPP
+#define KERNEL_APPROXIMATION_HPP
+
+#include "aoclda.h"
+#include "basic_handle.hpp"
+#include "da_error.hpp"
+#include "kernel_approximation/kernel_approximation_options.hpp"
+#include "kernel_approximation/kernel_approximation_types.hpp"
+#include "macros.h"
+#include "model_persistence.hpp"
+#include <vector>
+
+namespace ARCH {
+
+namespace da_kernel_approx {
+
+using namespace da_kernel_approx_types;
+
+/* Evaluate the m x n kernel matrix between the rows of X and the rows of Y (or the
+ * m x m kernel matrix of X with itself if Y is null), stored in the given order. */
+template <typename T>
+da_status evaluate_kernel(approx_kernel kernel, da_order order, da_int m, da_int n,
+                          da_int k, const T *X, da_int ldx, const T *Y, da_int ldy, T *D,
+                          da_int ldd, T gamma, da_int degree, T coef0);
+
+/* Nystroem feature map z(x) = K(x, L) K(L, L)^{-1/2}, where L is a set of landmarks
+ * taken from the training data. The inner products of the features approximate the
+ * kernel, so that an n x n kernel matrix is replaced by an n x n_landmarks feature
+ * matrix. The kernel parameters, order, n_features and n_landmarks must be set before
+ * calling fit. */
+template <typename T> class nystroem_map {
+  public:
+    da_order order = column_major;
+    approx_kernel kernel = approx_kernel::rbf;
+    T gamma = 1.0;
+    T coef0 = 1.0;
+    da_int degree = 3;
+    da_int n_features = 0;
+    da_int n_landmarks = 0;
+
+    // n_landmarks x n_features, stored in the same order as the data
+    std::vector<T> landmarks;
+    // Symmetric n_landmarks x n_landmarks matrix K(L, L)^{-1/2}
+    std::vector<T> normalization;
+
+    da_int ld_landmarks() const {
+        return (order == column_major) ? n_landmarks : n_features;
+    }
+
+    da_status fit(da_errors::da_error_t *err, da_int n_samples, const T *X, da_int ldx,
+                  landmark_sampling sampling, da_int seed);
+
+    // Compute the m x n_landmarks feature matrix Z of the rows of X
+    da_status transform(da_errors::da_error_t *err, da_int m, const T *X, da_int ldx,
+                        T *Z, da_int ldz) const;
+
+    da_status serialize(da_model_persistence::serialization_buffer &buffer);
+};
+
+/* Random Fourier feature map z(x) = sqrt(2 / n_components) cos(W^T x + b) for the rbf
+ * kernel exp(-gamma ||x - y||^2), with the columns of W drawn from N(0, 2 gamma I) and
+ * the offsets b uniformly from [0, 2 pi). */
+template <typename T> class rff_map {
+  public:
+    da_order order = column_major;
+    T gamma = 1.0;
+    da_int n_features = 0;
+    da_int n_components = 0;
+
+    // n_features x n_components, column-major
+    std::vector<T> weights;
+    std::vector<T> offsets;
+
+    da_status fit(da_errors::da_error_t *err, da_int seed);
+
+    // Compute the m x n_components feature matrix Z of the rows of X
+    da_status transform(da_errors::da_error_t *err, da_int m, const T *X, da_int ldx,
+                        T *Z, da_int ldz) const;
+
+    da_status serialize(da_model_persistence::serialization_buffer &buffer);
+};
+
+/* Kernel approximation transformer, mapping data to an explicit feature space in which
+ * inner products approximate a kernel function. */
+template <typename T> class kernel_approximation : public basic_handle<T> {
+  private:
+    da_int n_samples = 0;
+    da_int n_features = 0;
+    const T *X = nullptr;
+    da_int ldx = 0;
+
+    bool initdone = false;
+
+    approx_method method = nystroem;
+    da_int n_components = 0;
+    T gamma = -1.0;
+
+    nystroem_map<T> nys;
+    rff_map<T> rff;
+
+  public:
+    kernel_approximation(da_errors::da_error_t &err);
+    ~kernel_approximation() = default;
+
+    da_status set_data(da_int n_samples, da_int n_features, const T *X_in, da_int ldx_in);
+    da_status compute();
+    da_status transform(da_int m_samples, da_int m_features, const T *X_new,
+                        da_int ldx_new, T *X_transform, da_int ldx_transform);
+
+    da_status get_result(da_result query, da_int *dim, T *result) override;
+    da_status get_result(da_result query, da_int *dim, da_int *result) override;
+
+    da_status serialize(da_model_persistence::serialization_buffer &buffer) override;
+    da_status save_model(da_model_persistence::serialization_buffer &buffer) override;
+    da_status load_model(da_model_persistence::serialization_buffer &buffer) override;
+};
+
+} // namespace da_kernel_approx
+} // namespace ARCH
+
+#endif // KERNEL_APPROXIMATION_HPP
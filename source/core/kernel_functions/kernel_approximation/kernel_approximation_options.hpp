@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef KERNEL_APPROXIMATION_OPTIONS_HPP
+#define KERNEL_APPROXIMATION_OPTIONS_HPP
+
+#include "aoclda_types.h"
+#include "da_error.hpp"
+#include "kernel_approximation/kernel_approximation_types.hpp"
+#include "macros.h"
+#include "options.hpp"
+#include <limits>
+
+namespace ARCH {
+
+namespace da_kernel_approx {
+
+using namespace da_kernel_approx_types;
+
+template <class T>
+inline da_status register_kernel_approx_options(da_options::OptionRegistry &opts,
+                                                da_errors::da_error_t &err) {
+    using namespace da_options;
+    da_int imax = std::numeric_limits<da_int>::max();
+    T tmax = std::numeric_limits<T>::max();
+
+    try {
+        std::shared_ptr<OptionNumeric<da_int>> oi;
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "n_components",
+            "Number of features of the approximate feature map: the number of landmarks "
+            "for the Nystroem method or of random features for random Fourier features.",
+            1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            100));
+        opts.register_opt(oi);
+
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "degree", "Degree for the polynomial kernel.", 1,
+            da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf, 3));
+        opts.register_opt(oi);
+
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "seed",
+            "Seed for random number generation; set to -1 for non-deterministic results.",
+            -1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            0));
+        opts.register_opt(oi);
+
+        std::shared_ptr<OptionNumeric<T>> oT;
+        oT = std::make_shared<OptionNumeric<T>>(OptionNumeric<T>(
+            "gamma",
+            "Kernel coefficient for rbf, poly, and sigmoid kernels. Use any negative "
+            "value for 1 / n_features.",
+            -tmax, da_options::lbound_t::m_inf, tmax, da_options::ubound_t::p_inf,
+            static_cast<T>(-1.0)));
+        opts.register_opt(oT);
+
+        oT = std::make_shared<OptionNumeric<T>>(OptionNumeric<T>(
+            "coef0", "Independent term for polynomial and sigmoid kernels.", -tmax,
+            da_options::lbound_t::m_inf, tmax, da_options::ubound_t::p_inf,
+            static_cast<T>(1.0)));
+        opts.register_opt(oT);
+
+        std::shared_ptr<OptionString> os;
+        os = std::make_shared<OptionString>(OptionString(
+            "method",
+            "Kernel approximation method: Nystroem landmarks or random Fourier features "
+            "(rbf kernel only).",
+            {{"nystroem", nystroem}, {"rff", random_fourier}}, "nystroem"));
+        opts.register_opt(os);
+
+        os = std::make_shared<OptionString>(
+            OptionString("kernel", "Kernel function to approximate.",
+                         {{"linear", approx_kernel::linear},
+                          {"poly", approx_kernel::polynomial},
+                          {"rbf", approx_kernel::rbf},
+                          {"sigmoid", approx_kernel::sigmoid}},
+                         "rbf"));
+        opts.register_opt(os);
+
+        os = std::make_shared<OptionString>(OptionString(
+            "landmark sampling",
+            "How the Nystroem landmarks are chosen: a uniform random sample of the "
+            "training data or the cluster centres found by k-means.",
+            {{"uniform", sampling_uniform}, {"kmeans", sampling_kmeans}}, "uniform"));
+        opts.register_opt(os);
+
+    } catch (std::bad_alloc &) {
+        return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    } catch (...) {                                     // LCOV_EXCL_LINE
+        return da_error(&err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "Unexpected error while registering options");
+    }
+
+    return da_status_success;
+}
+
+} // namespace da_kernel_approx
+} // namespace ARCH
+
+#endif // KERNEL_APPROXIMATION_OPTIONS_HPP
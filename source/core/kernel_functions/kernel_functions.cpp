@@ -30,6 +30,7 @@
 #include "aoclda_types.h"
 #include "da_cblas.hh"
 #include "da_error.hpp"
+#include "da_omp.hpp"
 #include "da_syrk.hpp"
 #include "da_utils.hpp"
 #include "fp16_helpers.hpp"
@@ -249,7 +250,7 @@ da_status rbf_kernel(da_order order, da_int m, da_int n, da_int k, const T *X, d
     da_int first_dim = (order == column_major) ? m : n;
     vectorization_type vectorisation =
         Oracle<KernelSelection>(::da_kernel_functions::kf_tuning, tid<T>(), first_dim,
-                                oracle_lt<da_int>, "kf.isa");
+                                oracle_lt<da_int>, "kf.isa", "kf");
     // Add telemetry
     context_set_hidden_settings("kf.setup"s,
                                 "kernel.type="s + std::to_string(vectorisation));
@@ -301,7 +302,7 @@ da_status polynomial_kernel(da_order order, da_int m, da_int n, da_int k, const
     da_int first_dim = (order == column_major) ? m : n;
     vectorization_type vectorisation =
         Oracle<KernelSelection>(::da_kernel_functions::kf_tuning, tid<T>(), first_dim,
-                                oracle_lt<da_int>, "kf.isa");
+                                oracle_lt<da_int>, "kf.isa", "kf");
     // Add telemetry
     context_set_hidden_settings("kf.setup"s,
                                 "kernel.type="s + std::to_string(vectorisation));
@@ -333,7 +334,7 @@ da_status sigmoid_kernel(da_order order, da_int m, da_int n, da_int k, const T *
     da_int first_dim = (order == column_major) ? m : n;
     vectorization_type vectorisation =
         Oracle<KernelSelection>(::da_kernel_functions::kf_tuning, tid<T>(), first_dim,
-                                oracle_lt<da_int>, "kf.isa");
+                                oracle_lt<da_int>, "kf.isa", "kf");
     // Add telemetry
     context_set_hidden_settings("kf.setup"s,
                                 "kernel.type="s + std::to_string(vectorisation));
@@ -342,6 +343,83 @@ da_status sigmoid_kernel(da_order order, da_int m, da_int n, da_int k, const T *
     return status;
 }
 
+/*
+Auxiliary function to check the dimensions of the matrix-free kernel operator: X and Y as
+for the dense kernels, V is n by n_rhs (m by n_rhs when Y is null) and U is m by n_rhs
+*/
+template <typename T>
+static da_status check_apply_input(da_order order, da_int m, da_int n, da_int k,
+                                   const T *X, da_int ldx, const T *Y, da_int ldy,
+                                   da_int n_rhs, const T *V, da_int ldv, const T *U,
+                                   da_int ldu) {
+    if (m < 1 || k < 1 || n_rhs < 1)
+        return da_status_invalid_array_dimension;
+    if (Y != nullptr && n < 1)
+        return da_status_invalid_array_dimension;
+    if (X == nullptr || V == nullptr || U == nullptr)
+        return da_status_invalid_pointer;
+    da_int n_rows_V = (Y != nullptr) ? n : m;
+    if (order == column_major) {
+        if (ldx < m || (Y != nullptr && ldy < n) || ldv < n_rows_V || ldu < m)
+            return da_status_invalid_leading_dimension;
+    } else {
+        if (ldx < k || (Y != nullptr && ldy < k) || ldv < n_rhs || ldu < n_rhs)
+            return da_status_invalid_leading_dimension;
+    }
+    return da_status_success;
+}
+
+/*
+Matrix-free kernel operator
+Given an m by k matrix X, an n by k matrix Y and an n by n_rhs matrix V, computes the m by
+n_rhs matrix U = K(X, Y) V without forming K
+*/
+template <typename T>
+da_status kernel_apply(da_order order, kernel_type kernel, da_int m, da_int n, da_int k,
+                       const T *X, da_int ldx, const T *Y, da_int ldy, da_int n_rhs,
+                       const T *V, da_int ldv, T *U, da_int ldu, T gamma, da_int degree,
+                       T coef0) {
+    da_status status = check_apply_input(order, m, n, k, X, ldx, Y, ldy, n_rhs, V, ldv,
+                                         U, ldu);
+    if (status != da_status_success)
+        return status;
+    if (kernel != linear && gamma < 0)
+        return da_status_invalid_input;
+    if (kernel == polynomial && degree < 1)
+        return da_status_invalid_input;
+    if (Y == nullptr) {
+        Y = X;
+        ldy = ldx;
+        n = m;
+    }
+    // Only the RBF kernel needs the squared row norms of X and Y
+    std::vector<T> x_work, y_work;
+    if (kernel == rbf) {
+        try {
+            x_work.resize(m + SIMD_PADDING);
+            if (Y != X)
+                y_work.resize(n + SIMD_PADDING);
+        } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+            return da_status_memory_error; // LCOV_EXCL_LINE
+        }
+        squared_row_norms(order, m, k, X, ldx, x_work.data());
+        if (Y != X)
+            squared_row_norms(order, n, k, Y, ldy, y_work.data());
+    }
+    const T *Y_norms = (Y == X) ? x_work.data() : y_work.data();
+    // Get vectorisation
+    da_int first_dim = (order == column_major) ? m : n;
+    vectorization_type vectorisation =
+        Oracle<KernelSelection>(::da_kernel_functions::kf_tuning, tid<T>(), first_dim,
+                                oracle_lt<da_int>, "kf.isa", "kf");
+    // Add telemetry
+    context_set_hidden_settings("kf.setup"s,
+                                "kernel.type="s + std::to_string(vectorisation));
+    return kernel_apply_internal(order, kernel, m, n, k, X, x_work.data(), ldx, Y,
+                                 Y_norms, ldy, n_rhs, V, ldv, U, ldu, gamma, degree,
+                                 coef0, (da_int)vectorisation);
+}
+
 /*
 Internal functions that avoid input checking
 Also for RBF we can avoid repeatable creation of work arrays
@@ -689,6 +767,187 @@ void sigmoid_kernel_internal(da_order order, da_int m, da_int n, da_int k, const
                  math_type::tanh, vectorisation);
 }
 
+/*
+Squared Euclidean norms of the rows of an m by k matrix X
+*/
+template <typename T>
+void squared_row_norms(da_order order, da_int m, da_int k, const T *X, da_int ldx,
+                       T *X_norms) {
+    for (da_int i = 0; i < m; i++) {
+        X_norms[i] = (T)0.0;
+    }
+    if (order == column_major) {
+        for (da_int j = 0; j < k; j++) {
+            for (da_int i = 0; i < m; i++) {
+                X_norms[i] += X[i + j * ldx] * X[i + j * ldx];
+            }
+        }
+    } else {
+        for (da_int i = 0; i < m; i++) {
+            for (da_int j = 0; j < k; j++) {
+                X_norms[i] += X[i * ldx + j] * X[i * ldx + j];
+            }
+        }
+    }
+}
+
+/*
+Matrix-free kernel operator, U = K(X, Y) V
+K is never stored: each thread owns a block of rows of X and U, and for every block of
+rows of Y it computes one tile of K with gemm, applies the kernel function to the tile
+while it is still in cache and accumulates the tile times the matching rows of V into U.
+Peak workspace is one KERNEL_FUNCTIONS_MAX_BLOCK_SIZE squared tile per thread.
+The tile is held in the same storage order as the data so it can be passed to gemm as is.
+X_norms and Y_norms are only referenced by the RBF kernel.
+*/
+template <typename T>
+da_status kernel_apply_internal(da_order order, kernel_type kernel, da_int m, da_int n,
+                                da_int k, const T *X, const T *X_norms, da_int ldx,
+                                const T *Y, const T *Y_norms, da_int ldy, da_int n_rhs,
+                                const T *V, da_int ldv, T *U, da_int ldu, T gamma,
+                                da_int degree, T coef0, da_int vectorisation) {
+    CBLAS_ORDER cblas_order = da_utils::da_order_to_cblas_order(order);
+    da_int n_blocks_X, block_rem_X;
+    da_int n_blocks_Y, block_rem_Y;
+    da_int block_size_X = std::min(m, KERNEL_FUNCTIONS_MAX_BLOCK_SIZE);
+    da_int block_size_Y = std::min(n, KERNEL_FUNCTIONS_MAX_BLOCK_SIZE);
+    da_utils::blocking_scheme(m, block_size_X, n_blocks_X, block_rem_X);
+    da_utils::blocking_scheme(n, block_size_Y, n_blocks_Y, block_rem_Y);
+    vectorization_type vec_enum = (vectorization_type)vectorisation;
+
+    exp_kernel_func_t<T> exp_kernel_func = nullptr;
+    pow_kernel_func_t<T> pow_kernel_func = nullptr;
+    tanh_kernel_func_t<T> tanh_kernel_func = nullptr;
+    // Scaling of the X * Y^T product computed by gemm
+    T alpha = gamma;
+    switch (kernel) {
+    case rbf:
+        exp_kernel_func = select_exp_kernel_function<T>(vec_enum);
+        alpha = (T)-2.0;
+        break;
+    case polynomial:
+        pow_kernel_func = select_pow_kernel_function<T>(vec_enum);
+        break;
+    case sigmoid:
+        tanh_kernel_func = select_tanh_kernel_function<T>(vec_enum);
+        break;
+    default:
+        alpha = (T)1.0;
+        break;
+    }
+    T multiplier = -gamma;
+
+    // Each block of rows of X gives an independent block of rows of U. When there are fewer
+    // of them than threads, the blocks of Y are also split into n_split_Y slices: slice 0
+    // accumulates into U directly and the others into partial results summed afterwards.
+    da_int ldt = (order == column_major) ? block_size_X : block_size_Y;
+    da_int tile_size = block_size_X * block_size_Y;
+    da_int max_threads = da_utils::get_n_threads_loop(n_blocks_X * n_blocks_Y);
+    da_int n_split_Y =
+        std::min(n_blocks_Y, std::max((da_int)1, max_threads / n_blocks_X));
+    da_int n_tasks = n_blocks_X * n_split_Y;
+    da_int n_threads = std::min(max_threads, n_tasks);
+    da_int ldp = (order == column_major) ? block_size_X : n_rhs;
+    da_int partial_size = block_size_X * n_rhs;
+    std::vector<T> tiles, partials;
+    try {
+        tiles.resize(n_threads * tile_size);
+        partials.resize(n_blocks_X * (n_split_Y - 1) * partial_size);
+    } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+        return da_status_memory_error; // LCOV_EXCL_LINE
+    }
+    T *tiles_ptr = tiles.data();
+    T *partials_ptr = partials.data();
+
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads) default(none)         \
+    shared(block_size_X, block_size_Y, n_blocks_X, block_rem_X, block_rem_Y, n_blocks_Y, \
+               X, ldx, Y, ldy, V, ldv, U, ldu, X_norms, Y_norms, k, n_rhs, order,        \
+               kernel, alpha, multiplier, coef0, degree, cblas_order, ldt, tile_size,    \
+               tiles_ptr, exp_kernel_func, pow_kernel_func, tanh_kernel_func, n_tasks,   \
+               n_split_Y, partials_ptr, partial_size, ldp)
+    for (da_int task = 0; task < n_tasks; task++) {
+        T *tile = tiles_ptr + omp_get_thread_num() * tile_size;
+        da_int i = task / n_split_Y;
+        da_int slice = task % n_split_Y;
+        da_int m_in =
+            (i == n_blocks_X - 1 && block_rem_X > 0) ? block_rem_X : block_size_X;
+        da_int X_row = i * block_size_X;
+        const T *X_block = (order == column_major) ? X + X_row : X + X_row * ldx;
+        T *U_block = (order == column_major) ? U + X_row : U + X_row * ldu;
+        da_int ld_out = ldu;
+        if (slice > 0) {
+            U_block = partials_ptr + (i * (n_split_Y - 1) + slice - 1) * partial_size;
+            ld_out = ldp;
+        }
+        // Contiguous range of blocks of Y handled by this slice
+        da_int j_start = slice * n_blocks_Y / n_split_Y;
+        da_int j_end = (slice + 1) * n_blocks_Y / n_split_Y;
+        for (da_int j = j_start; j < j_end; j++) {
+            da_int n_in =
+                (j == n_blocks_Y - 1 && block_rem_Y > 0) ? block_rem_Y : block_size_Y;
+            da_int Y_row = j * block_size_Y;
+            const T *Y_block = (order == column_major) ? Y + Y_row : Y + Y_row * ldy;
+            const T *V_block = (order == column_major) ? V + Y_row : V + Y_row * ldv;
+            da_blas::cblas_gemm(cblas_order, CblasNoTrans, CblasTrans, m_in, n_in, k,
+                                alpha, X_block, ldx, Y_block, ldy, (T)0.0, tile, ldt);
+            // The kernel functions run along the contiguous dimension of the tile
+            da_int first_dim = (order == column_major) ? m_in : n_in;
+            da_int second_dim = (order == column_major) ? n_in : m_in;
+            switch (kernel) {
+            case rbf:
+                if (order == column_major) {
+                    exp_kernel_func(m_in, n_in, tile, ldt, multiplier, X_norms + X_row,
+                                    Y_norms + Y_row);
+                } else {
+                    exp_kernel_func(n_in, m_in, tile, ldt, multiplier, Y_norms + Y_row,
+                                    X_norms + X_row);
+                }
+                break;
+            case polynomial:
+                pow_kernel_func(first_dim, second_dim, tile, ldt, coef0, degree);
+                break;
+            case sigmoid:
+                tanh_kernel_func(first_dim, second_dim, tile, ldt, coef0);
+                break;
+            default:
+                // Linear kernel, do nothing
+                break;
+            }
+            T beta = (j == j_start) ? (T)0.0 : (T)1.0;
+            da_blas::cblas_gemm(cblas_order, CblasNoTrans, CblasNoTrans, m_in, n_rhs,
+                                n_in, (T)1.0, tile, ldt, V_block, ldv, beta, U_block,
+                                ld_out);
+        }
+    }
+
+    // Sum the partial results of the other slices into U
+    if (n_split_Y > 1) {
+#pragma omp parallel for num_threads(n_threads) default(none)                            \
+    shared(n_blocks_X, block_size_X, block_rem_X, n_split_Y, partials_ptr, partial_size, \
+               U, ldu, ldp, n_rhs, order)
+        for (da_int i = 0; i < n_blocks_X; i++) {
+            da_int m_in =
+                (i == n_blocks_X - 1 && block_rem_X > 0) ? block_rem_X : block_size_X;
+            da_int X_row = i * block_size_X;
+            T *U_block = (order == column_major) ? U + X_row : U + X_row * ldu;
+            for (da_int slice = 1; slice < n_split_Y; slice++) {
+                const T *P =
+                    partials_ptr + (i * (n_split_Y - 1) + slice - 1) * partial_size;
+                if (order == column_major) {
+                    for (da_int c = 0; c < n_rhs; c++)
+                        for (da_int r = 0; r < m_in; r++)
+                            U_block[r + c * ldu] += P[r + c * ldp];
+                } else {
+                    for (da_int r = 0; r < m_in; r++)
+                        for (da_int c = 0; c < n_rhs; c++)
+                            U_block[r * ldu + c] += P[r * ldp + c];
+                }
+            }
+        }
+    }
+    return da_status_success;
+}
+
 template da_status check_input<float>(da_order order, da_int m, da_int n, da_int k,
                                       const float *X, da_int ldx, const float *Y,
                                       da_int ldy, float *D, da_int ldd);
@@ -736,6 +995,17 @@ template da_status sigmoid_kernel<double>(da_order order, da_int m, da_int n, da
                                           da_int ldy, double *D, da_int ldd, double gamma,
                                           double coef0);
 
+template da_status kernel_apply<float>(da_order order, kernel_type kernel, da_int m,
+                                      da_int n, da_int k, const float *X, da_int ldx,
+                                      const float *Y, da_int ldy, da_int n_rhs,
+                                      const float *V, da_int ldv, float *U, da_int ldu,
+                                      float gamma, da_int degree, float coef0);
+template da_status kernel_apply<double>(da_order order, kernel_type kernel, da_int m,
+                                       da_int n, da_int k, const double *X, da_int ldx,
+                                       const double *Y, da_int ldy, da_int n_rhs,
+                                       const double *V, da_int ldv, double *U, da_int ldu,
+                                       double gamma, da_int degree, double coef0);
+
 template void rbf_kernel_internal<float>(da_order order, da_int m, da_int n, da_int k,
                                          const float *X, float *X_norms,
                                          da_int compute_X_norms, da_int ldx,
@@ -784,6 +1054,22 @@ template void sigmoid_kernel_internal<double>(da_order order, da_int m, da_int n
                                               da_int ldd, double gamma, double coef0,
                                               bool X_is_Y, da_int vectorisation);
 
+template void squared_row_norms<float>(da_order order, da_int m, da_int k,
+                                      const float *X, da_int ldx, float *X_norms);
+template void squared_row_norms<double>(da_order order, da_int m, da_int k,
+                                       const double *X, da_int ldx, double *X_norms);
+
+template da_status kernel_apply_internal<float>(
+    da_order order, kernel_type kernel, da_int m, da_int n, da_int k, const float *X,
+    const float *X_norms, da_int ldx, const float *Y, const float *Y_norms, da_int ldy,
+    da_int n_rhs, const float *V, da_int ldv, float *U, da_int ldu, float gamma,
+    da_int degree, float coef0, da_int vectorisation);
+template da_status kernel_apply_internal<double>(
+    da_order order, kernel_type kernel, da_int m, da_int n, da_int k, const double *X,
+    const double *X_norms, da_int ldx, const double *Y, const double *Y_norms, da_int ldy,
+    da_int n_rhs, const double *V, da_int ldv, double *U, da_int ldu, double gamma,
+    da_int degree, double coef0, da_int vectorisation);
+
 template void fill_upper_triangular<float>(da_order order, da_int m, float *D,
                                            da_int ldd);
 template void fill_upper_triangular<double>(da_order order, da_int m, double *D,
@@ -79,6 +79,16 @@ da_status sigmoid_kernel(da_order order, da_int m, da_int n, da_int k, const T *
                          da_int ldx, const T *Y, da_int ldy, T *D, da_int ldd, T gamma,
                          T coef0);
 /*
+Matrix-free kernel operator
+Given an m by k matrix X, an n by k matrix Y and an n by n_rhs matrix V, computes the m by
+n_rhs matrix U = K(X, Y) V without forming K
+*/
+template <typename T>
+da_status kernel_apply(da_order order, da_kernel_functions_types::kernel_type kernel,
+                       da_int m, da_int n, da_int k, const T *X, da_int ldx, const T *Y,
+                       da_int ldy, da_int n_rhs, const T *V, da_int ldv, T *U, da_int ldu,
+                       T gamma, da_int degree, T coef0);
+/*
 RBF kernel
 Given an m by k matrix X and an n by k matrix Y (both column major), computes the m by n kernel matrix D
 */
@@ -110,6 +120,23 @@ void sigmoid_kernel_internal(da_order order, da_int m, da_int n, da_int k, const
                              da_int ldx, const T *Y, da_int ldy, T *D, da_int ldd,
                              T gamma, T coef0, bool X_is_Y, da_int vectorisation);
 /*
+Squared Euclidean norms of the rows of X
+*/
+template <typename T>
+void squared_row_norms(da_order order, da_int m, da_int k, const T *X, da_int ldx,
+                       T *X_norms);
+/*
+Matrix-free kernel operator, tiles K(X, Y) and accumulates K(X, Y) V into U
+X_norms and Y_norms must hold the squared row norms of X and Y for the RBF kernel
+*/
+template <typename T>
+da_status kernel_apply_internal(da_order order,
+                                da_kernel_functions_types::kernel_type kernel, da_int m,
+                                da_int n, da_int k, const T *X, const T *X_norms,
+                                da_int ldx, const T *Y, const T *Y_norms, da_int ldy,
+                                da_int n_rhs, const T *V, da_int ldv, T *U, da_int ldu,
+                                T gamma, da_int degree, T coef0, da_int vectorisation);
+/*
 Helper function to transpose upper triangular matrix to a symmetric
 */
 template <typename T>
@@ -64,6 +64,48 @@ da_status da_sigmoid_kernel(da_order order, da_int m, da_int n, da_int k, const
                                   order, m, n, k, X, ldx, Y, ldy, D, ldd, gamma, coef0)));
 }
 
+template <typename T>
+da_status da_rbf_kernel_apply(da_order order, da_int m, da_int n, da_int k, const T *X,
+                              da_int ldx, const T *Y, da_int ldy, da_int n_rhs,
+                              const T *V, da_int ldv, T *U, da_int ldu, T gamma) {
+    DISPATCHER(nosave_kernel,
+               return (da_kernel_functions::kernel_apply(
+                   order, da_kernel_functions_types::rbf, m, n, k, X, ldx, Y, ldy, n_rhs,
+                   V, ldv, U, ldu, gamma, (da_int)0, (T)0.0)));
+}
+
+template <typename T>
+da_status da_linear_kernel_apply(da_order order, da_int m, da_int n, da_int k, const T *X,
+                                 da_int ldx, const T *Y, da_int ldy, da_int n_rhs,
+                                 const T *V, da_int ldv, T *U, da_int ldu) {
+    DISPATCHER(nosave_kernel,
+               return (da_kernel_functions::kernel_apply(
+                   order, da_kernel_functions_types::linear, m, n, k, X, ldx, Y, ldy,
+                   n_rhs, V, ldv, U, ldu, (T)1.0, (da_int)0, (T)0.0)));
+}
+
+template <typename T>
+da_status da_polynomial_kernel_apply(da_order order, da_int m, da_int n, da_int k,
+                                     const T *X, da_int ldx, const T *Y, da_int ldy,
+                                     da_int n_rhs, const T *V, da_int ldv, T *U,
+                                     da_int ldu, T gamma, da_int degree, T coef0) {
+    DISPATCHER(nosave_kernel,
+               return (da_kernel_functions::kernel_apply(
+                   order, da_kernel_functions_types::polynomial, m, n, k, X, ldx, Y, ldy,
+                   n_rhs, V, ldv, U, ldu, gamma, degree, coef0)));
+}
+
+template <typename T>
+da_status da_sigmoid_kernel_apply(da_order order, da_int m, da_int n, da_int k,
+                                  const T *X, da_int ldx, const T *Y, da_int ldy,
+                                  da_int n_rhs, const T *V, da_int ldv, T *U, da_int ldu,
+                                  T gamma, T coef0) {
+    DISPATCHER(nosave_kernel,
+               return (da_kernel_functions::kernel_apply(
+                   order, da_kernel_functions_types::sigmoid, m, n, k, X, ldx, Y, ldy,
+                   n_rhs, V, ldv, U, ldu, gamma, (da_int)0, coef0)));
+}
+
 template da_status da_rbf_kernel<float>(da_order, da_int, da_int, da_int, const float *,
                                         da_int, const float *, da_int, float *, da_int,
                                         float);
@@ -89,4 +131,39 @@ template da_status da_sigmoid_kernel<float>(da_order, da_int, da_int, da_int,
                                             float *, da_int, float, float);
 template da_status da_sigmoid_kernel<double>(da_order, da_int, da_int, da_int,
                                              const double *, da_int, const double *,
-                                             da_int, double *, da_int, double, double);
\ No newline at end of file
+                                             da_int, double *, da_int, double, double);
+
+template da_status da_rbf_kernel_apply<float>(da_order, da_int, da_int, da_int,
+                                              const float *, da_int, const float *,
+                                              da_int, da_int, const float *, da_int,
+                                              float *, da_int, float);
+template da_status da_rbf_kernel_apply<double>(da_order, da_int, da_int, da_int,
+                                               const double *, da_int, const double *,
+                                               da_int, da_int, const double *, da_int,
+                                               double *, da_int, double);
+template da_status da_linear_kernel_apply<float>(da_order, da_int, da_int, da_int,
+                                                 const float *, da_int, const float *,
+                                                 da_int, da_int, const float *, da_int,
+                                                 float *, da_int);
+template da_status da_linear_kernel_apply<double>(da_order, da_int, da_int, da_int,
+                                                  const double *, da_int, const double *,
+                                                  da_int, da_int, const double *, da_int,
+                                                  double *, da_int);
+template da_status da_polynomial_kernel_apply<float>(da_order, da_int, da_int, da_int,
+                                                     const float *, da_int,
+                                                     const float *, da_int, da_int,
+                                                     const float *, da_int, float *,
+                                                     da_int, float, da_int, float);
+template da_status da_polynomial_kernel_apply<double>(da_order, da_int, da_int, da_int,
+                                                      const double *, da_int,
+                                                      const double *, da_int, da_int,
+                                                      const double *, da_int, double *,
+                                                      da_int, double, da_int, double);
+template da_status da_sigmoid_kernel_apply<float>(da_order, da_int, da_int, da_int,
+                                                  const float *, da_int, const float *,
+                                                  da_int, da_int, const float *, da_int,
+                                                  float *, da_int, float, float);
+template da_status da_sigmoid_kernel_apply<double>(da_order, da_int, da_int, da_int,
+                                                   const double *, da_int, const double *,
+                                                   da_int, da_int, const double *, da_int,
+                                                   double *, da_int, double, double);
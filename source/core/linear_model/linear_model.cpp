@@ -42,9 +42,11 @@
 #include "optimization.hpp"
 #include "options.hpp"
 #include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -221,6 +223,10 @@ template <typename T> void linear_model<T>::reset_solvers() {
 template <typename T> void linear_model<T>::refresh() {
     reset_data();
     reset_solvers();
+    Xw.clear();
+    Xw.shrink_to_fit();
+    yw.clear();
+    yw.shrink_to_fit();
     user_scaling = da_linmod_types::scaling_t::automatic;
 }
 
@@ -245,6 +251,19 @@ template <typename T> linear_model<T>::~linear_model() {
     this->err = nullptr;
 
     reset_solvers();
+    reset_stream();
+}
+
+// Discard the statistics accumulated by stream_block()
+template <typename T> void linear_model<T>::reset_stream() {
+    if constexpr (!std::is_same_v<T, _Float16>) {
+        if (stream) {
+            delete stream;
+            stream = nullptr;
+        }
+    }
+    fitted_from_stream = false;
+    stream_rss = T(0);
 }
 
 template <typename T>
@@ -276,6 +295,13 @@ da_status linear_model<T>::get_result(da_result query, da_int *dim, T *result) {
             if (status != da_status_success) {
                 return status;
             }
+        } else if (fitted_from_stream) {
+            // The streamed data is not available, use the residual of the streamed fit
+            const T l1reg = alpha * lambda;
+            const T l2reg = (T(1) - alpha) * lambda / T(2);
+            result[da_linmod_info_t::linmod_info_objective] =
+                stream_rss / T(2 * nsamples) + regfun(nfeat, coef.data(), l1reg, l2reg);
+            result[da_linmod_info_t::linmod_info_time] = time;
         } else if (!this->model_loaded) {
             // For the rest of the solvers find loss value via loss_mse function and set compute time
             // Save information about loss function
@@ -286,7 +312,8 @@ da_status linear_model<T>::get_result(da_result query, da_int *dim, T *result) {
             const T l2reg = (T(1) - alpha) * lambda / T(2);
             // Call loss_mse
             flag = loss_mse(this->order, nsamples, nfeat, XUSR, ldXUSR, intercept, l1reg,
-                            l2reg, coef.data(), y, &loss, pred.data());
+                            l2reg, coef.data(), y, &loss, pred.data(),
+                            sample_weights.empty() ? nullptr : sample_weights.data());
             if (flag != 0) {
                 return da_status_incorrect_output;
             }
@@ -403,6 +430,267 @@ da_status linear_model<T>::define_features(da_int nfeat, da_int nsamples, const
     this->nsamples = nsamples;
     this->is_well_determined = nsamples > nfeat;
 
+    // Weights refer to the previous data set
+    this->sample_weights.clear();
+    // In-memory data replaces any streamed blocks
+    reset_stream();
+
+    return da_status_success;
+}
+
+/* Accumulate a block of rows of [ X | y ] for the streaming least squares solver.
+ * Only the column means and the triangular factor of the centered data are kept, so
+ * the blocks can be released as soon as this function returns.
+ * Streamed data replaces the data defined by define_features().
+ */
+template <typename T>
+da_status linear_model<T>::stream_block(da_int nfeat, da_int nsamples, const T *X,
+                                        da_int ldX, const T *y) {
+    if constexpr (std::is_same_v<T, _Float16>) {
+        return da_error(this->err, da_status_not_implemented, // LCOV_EXCL_LINE
+                        "Streaming least squares is not available in half precision.");
+    } else {
+        if (mod != linmod_model_mse)
+            return da_error(this->err, da_status_incompatible_options,
+                            "Streaming data blocks is only supported for the mse "
+                            "linear model.");
+
+        if (nfeat <= 0 || nsamples <= 0) {
+            return da_error(this->err, da_status_invalid_input,
+                            "The number of features and samples must be positive.");
+        }
+
+        std::string opt_order;
+        da_int iorder;
+        this->opts.get("storage order", opt_order, iorder);
+        this->order = da_order(iorder);
+
+        da_status status = this->check_2D_array(this->order, nsamples, nfeat, X, ldX,
+                                                "n_samples", "n_features", "X", "ldX");
+        if (status != da_status_success)
+            return status;
+        status = this->check_1D_array(nsamples, y, "n_samples", "y", 1);
+        if (status != da_status_success)
+            return status;
+
+        if (stream && stream->nfeat != nfeat)
+            return da_error(this->err, da_status_invalid_input,
+                            "n_features = " + std::to_string(nfeat) +
+                                " does not match the number of features of the previous "
+                                "blocks, expecting n_features = " +
+                                std::to_string(stream->nfeat) + ".");
+
+        if (init_done) {
+            // Release the in-memory data, the model is now defined by the stream
+            reset_data();
+            reset_solvers();
+            XUSR = nullptr;
+            yusr = nullptr;
+            this->X = nullptr;
+            this->y = nullptr;
+            sample_weights.clear();
+            init_done = false;
+        }
+
+        if (!stream) {
+            try {
+                stream = new stream_data<T>(nfeat);
+            } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+                return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                                "Memory allocation error");
+            }
+        }
+        this->model_trained = false;
+        fitted_from_stream = false;
+
+        return stream->add_block(this->order, nsamples, X, ldX, y, this->err);
+    }
+}
+
+/* Fit a linear least squares (or ridge) model from the streamed statistics.
+ * With R the triangular factor of [ X | y ] (centered when an intercept is requested),
+ *   min ||X b - y||^2 + lambda ||b||^2 = min ||[ Rx; sqrt(lambda) I ] b - [ ry; 0 ]||^2
+ * which is solved with a QR factorization of the small (2 nfeat + 1) x (nfeat + 1)
+ * stacked matrix. The last diagonal entry of its factor gives the minimum value.
+ */
+template <typename T> da_status linear_model<T>::fit_stream() {
+    if constexpr (std::is_same_v<T, _Float16>) {
+        return da_error(this->err, da_status_not_implemented, // LCOV_EXCL_LINE
+                        "Streaming least squares is not available in half precision.");
+    } else {
+        if (!stream || stream->n == 0)
+            return da_error(this->err, da_status_no_data,
+                            "No data blocks have been passed to the handle.");
+
+        if (this->model_trained && fitted_from_stream)
+            return da_status_success;
+
+        if (mod != linmod_model_mse)
+            return da_error(this->err, da_status_incompatible_options,
+                            "Streaming data blocks is only supported for the mse "
+                            "linear model.");
+
+        da_status status;
+        if (read_public_options) {
+            status = read_options();
+            if (status != da_status_success)
+                return status;
+        }
+        if (alpha != T(0) && lambda != T(0))
+            return da_error(this->err, da_status_incompatible_options,
+                            "The streaming solver only supports L2 regularization, set "
+                            "alpha = 0.");
+        if (user_scaling == scaling_t::scale_only ||
+            user_scaling == scaling_t::standardize)
+            return da_error(this->err, da_status_incompatible_options,
+                            "The streaming solver only supports the scaling options "
+                            "none and centering.");
+
+        auto clock = std::chrono::system_clock::now();
+
+        nfeat = stream->nfeat;
+        nsamples = stream->n;
+        nclass = 0;
+        is_well_determined = nsamples > nfeat;
+        ncoef = intercept ? nfeat + 1 : nfeat;
+        nrow_coef = 1, ncol_coef = ncoef;
+
+        da_int p = nfeat, m = nfeat + 1;
+        std::vector<T> Rf, S, tau, work;
+        da_int ns = lambda > T(0) ? m + p : m;
+        try {
+            S.resize(ns * m, T(0));
+            tau.resize(m);
+            coef.resize(ncoef);
+        } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        status = stream->factor(intercept, Rf, this->err);
+        if (status != da_status_success)
+            return status; // LCOV_EXCL_LINE
+
+        for (da_int j = 0; j < m; j++)
+            for (da_int i = 0; i <= j; i++)
+                S[i + j * ns] = Rf[i + j * m];
+        if (lambda > T(0)) {
+            const T sl = std::sqrt(lambda);
+            for (da_int j = 0; j < p; j++)
+                S[m + j + j * ns] = sl;
+        }
+
+        da_int lwork = -1, info = 0;
+        T query[1];
+        da::geqrf(&ns, &m, S.data(), &ns, tau.data(), query, &lwork, &info);
+        lwork = std::max((da_int)query[0], da_int(1));
+        try {
+            work.resize(lwork);
+        } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        da::geqrf(&ns, &m, S.data(), &ns, tau.data(), work.data(), &lwork, &info);
+        if (info != 0)
+            return da_error(this->err, da_status_internal_error, // LCOV_EXCL_LINE
+                            "Unexpected error in the QR factorization (geqrf).");
+
+        // Rank check on the diagonal of the factor of the regularized matrix
+        T dmax{0};
+        for (da_int j = 0; j < p; j++)
+            dmax = std::max(dmax, std::abs(S[j + j * ns]));
+        const T dtol = dmax * T(m) * std::numeric_limits<T>::epsilon();
+        for (da_int j = 0; j < p; j++) {
+            if (!(std::abs(S[j + j * ns]) > dtol))
+                return da_error(this->err, da_status_numerical_difficulties,
+                                "The streamed data matrix is rank deficient. Consider "
+                                "adding L2 regularization (lambda > 0).");
+        }
+
+        // Solve Rx b = rhs, the right hand side is the last column of the factor
+        for (da_int j = 0; j < p; j++)
+            coef[j] = S[j + p * ns];
+        char uplo = 'U', trans = 'N', diag = 'N';
+        da_int nrhs = 1;
+        da::trtrs(&uplo, &trans, &diag, &p, &nrhs, S.data(), &ns, coef.data(), &p, &info);
+        if (info != 0)
+            return da_error(this->err, da_status_internal_error, // LCOV_EXCL_LINE
+                            "Unexpected error in the triangular solve (trtrs).");
+
+        // Residual sum of squares, excluding the penalty term
+        T bnorm2{0};
+        for (da_int j = 0; j < p; j++)
+            bnorm2 += coef[j] * coef[j];
+        stream_rss = std::max(S[p + p * ns] * S[p + p * ns] - lambda * bnorm2, T(0));
+
+        if (intercept) {
+            T b0 = stream->mean[p];
+            for (da_int j = 0; j < p; j++)
+                b0 -= stream->mean[j] * coef[j];
+            coef[p] = b0;
+        }
+
+        time = static_cast<T>(
+            std::chrono::duration<double>(std::chrono::system_clock::now() - clock)
+                .count());
+        fitted_from_stream = true;
+        this->model_trained = true;
+        return da_status_success;
+    }
+}
+
+/* Store a normalized copy of the sample weights, w[i] * nsamples / sum(w)
+ * so that the regularization terms keep the same meaning as in the unweighted problem.
+ * nsamples = 0 removes the weights.
+ */
+template <typename T>
+da_status linear_model<T>::define_sample_weights(da_int nsamples, const T *weights) {
+    if (!this->init_done)
+        return da_error(this->err, da_status_no_data,
+                        "No data has been passed to the handle. Define the features "
+                        "before the sample weights.");
+
+    // Any previous fit or preprocessing is out of date
+    reset_data();
+    reset_solvers();
+
+    if (nsamples == 0) {
+        sample_weights.clear();
+        return da_status_success;
+    }
+    if (nsamples != this->nsamples)
+        return da_error(this->err, da_status_invalid_input,
+                        "n_samples = " + std::to_string(nsamples) +
+                            " does not match the number of samples in the training "
+                            "data, expecting n_samples = " +
+                            std::to_string(this->nsamples) + ".");
+    da_status status = this->check_1D_array(nsamples, weights, "n_samples", "weights", 1);
+    if (status != da_status_success)
+        return status;
+
+    using W = da_fp16::wider_t<T>;
+    W wsum{0};
+    for (da_int i = 0; i < nsamples; i++) {
+        if (!(weights[i] >= T(0)))
+            return da_error(this->err, da_status_invalid_input,
+                            "weights[" + std::to_string(i) +
+                                "] is invalid, all weights must be non-negative.");
+        wsum += static_cast<W>(weights[i]);
+    }
+    if (!(wsum > W(0)))
+        return da_error(this->err, da_status_invalid_input,
+                        "At least one of the weights must be positive.");
+
+    try {
+        sample_weights.resize(nsamples);
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    const W wscale = static_cast<W>(nsamples) / wsum;
+    for (da_int i = 0; i < nsamples; i++)
+        sample_weights[i] = static_cast<T>(static_cast<W>(weights[i]) * wscale);
+    sample_weights_scale = static_cast<T>(wscale);
+
     return da_status_success;
 }
 
@@ -599,35 +887,50 @@ template <typename T>
 da_status linear_model<T>::evaluate_model(da_int nfeat, da_int nsamples, const T *Xeval,
                                           da_int ldXeval, T *predictions,
                                           const T *observations, T *loss) {
+    _da_inference_context ctx;
+    ctx.err = this->err;
+    return evaluate_model(ctx, nfeat, nsamples, Xeval, ldXeval, predictions,
+                          observations, loss);
+}
+
+/* Reentrant evaluation: the trained model is only read, errors and scratch space go to
+ * the caller's inference context so several threads can share one handle.
+ */
+template <typename T>
+da_status linear_model<T>::evaluate_model(_da_inference_context &ctx, da_int nfeat,
+                                          da_int nsamples, const T *Xeval,
+                                          da_int ldXeval, T *predictions,
+                                          const T *observations, T *loss) {
+    da_errors::da_error_t *err = ctx.err;
     if (!this->model_trained)
-        return da_error(this->err, da_status_out_of_date,
+        return da_error(err, da_status_out_of_date,
                         "The model has not been trained yet.");
 
     if (nfeat != this->nfeat)
-        return da_error(this->err, da_status_invalid_input,
+        return da_error(err, da_status_invalid_input,
                         "nfeat = " + std::to_string(nfeat) +
                             ". it must match the number of features of the computed "
                             "model: nfeat = " +
                             std::to_string(this->nfeat) + ".");
 
     if (predictions == nullptr)
-        return da_error(this->err, da_status_invalid_pointer,
+        return da_error(err, da_status_invalid_pointer,
                         "predictions is a null pointer.");
 
     if (nsamples <= 0) {
-        return da_error(this->err, da_status_invalid_input,
+        return da_error(err, da_status_invalid_input,
                         "The number of samples must be positive.");
     }
 
     if (!((this->order == column_major && ldXeval >= nsamples) ||
           (this->order == row_major && ldXeval >= nfeat))) {
-        return da_error(this->err, da_status_invalid_array_dimension,
+        return da_error(err, da_status_invalid_array_dimension,
                         "The leading dimension of the array X is invalid.");
     }
 
     da_status status;
 
-    status = this->check_2D_array(this->order, nsamples, nfeat, Xeval, ldXeval,
+    status = this->check_2D_array(err, this->order, nsamples, nfeat, Xeval, ldXeval,
                                   "n_samples", "n_features", "Xeval", "ldXeval");
     if (status != da_status_success) {
         return status;
@@ -639,7 +942,7 @@ da_status linear_model<T>::evaluate_model(da_int nfeat, da_int nsamples, const T
     T alpha = 1.0, beta = 0.0;
     T aux;
     da_int flag, nmod;
-    std::vector<T> log_proba(0), scores(0);
+    T *log_proba = nullptr, *scores = nullptr;
     enum CBLAS_ORDER storage =
         this->order == da_order::row_major ? CblasRowMajor : CblasColMajor;
     switch (mod) {
@@ -648,32 +951,32 @@ da_status linear_model<T>::evaluate_model(da_int nfeat, da_int nsamples, const T
         flag = loss_mse(this->order, nsamples, nfeat, Xeval, ldXeval, this->intercept,
                         l1reg, l2reg, this->coef.data(), observations, loss, predictions);
         if (flag != 0) {
-            return da_error(this->err, da_status_incorrect_output,
+            return da_error(err, da_status_incorrect_output,
                             "Unexpected error at evaluating model.");
         }
         break;
     case linmod_model_logistic:
         nmod = intercept ? nfeat + 1 : nfeat;
         try {
-            log_proba.resize(nsamples * nclass, 0);
-            if (nclass == 2)
-                scores.resize(nsamples, 0);
-            else
-                scores.resize(nsamples * nclass, 0);
-
+            // log_proba and scores are carved out of the context workspace
+            std::vector<T> &work = ctx.workspace<T>();
+            da_int n_scores = nclass == 2 ? nsamples : nsamples * nclass;
+            work.assign(nsamples * nclass + n_scores, T(0));
+            log_proba = work.data();
+            scores = log_proba + nsamples * nclass;
         } catch (std::bad_alloc const &) {
-            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
                             "Memory allocation failed.");
         }
         da_std::fill(predictions, predictions + nsamples, T(0));
         if (nclass == 2) {
             eval_feature_matrix(this->order, nmod, this->coef.data(), nsamples, Xeval,
-                                ldXeval, scores.data(), this->intercept, false);
+                                ldXeval, scores, this->intercept, false);
             for (da_int i = 0; i < nsamples; i++)
                 scores[i] > 0 ? predictions[i] = 1 : predictions[i] = 0;
         } else if (logistic_constraint_model == logistic_constraint::rsc) {
-            da_std::fill(log_proba.begin() + nsamples * (nclass - 1), log_proba.end(),
-                         T(1));
+            da_std::fill(log_proba + nsamples * (nclass - 1),
+                         log_proba + nsamples * nclass, T(1));
             for (da_int k = 0; k < nclass - 1; k++) {
                 // < -- -this is a GEMM operation
                 da_blas::cblas_gemv(storage, CblasNoTrans, nsamples, nfeat, alpha, Xeval,
@@ -708,8 +1011,7 @@ da_status linear_model<T>::evaluate_model(da_int nfeat, da_int nsamples, const T
             // coef and scores both in col-major
             if (intercept) {
                 for (da_int k = 0; k < nclass; k++) {
-                    da_std::fill(scores.begin() + k * nsamples,
-                                 scores.begin() + (k + 1) * nsamples,
+                    da_std::fill(scores + k * nsamples, scores + (k + 1) * nsamples,
                                  coef[ncoef - (nclass - k)]);
                 }
             }
@@ -726,7 +1028,7 @@ da_status linear_model<T>::evaluate_model(da_int nfeat, da_int nsamples, const T
             // scores stays always in col-major
             da_blas::cblas_gemm(CblasColMajor, transX, CblasTrans, nsamples, nclass,
                                 nfeat, 1.0, Xeval, ldXeval, this->coef.data(), nclass,
-                                1.0, scores.data(), nsamples);
+                                1.0, scores, nsamples);
             // Iterate over predictions to pick argmax between each class
             for (da_int i = 0; i < nsamples; i++) {
                 aux = 0.0;
@@ -752,7 +1054,7 @@ da_status linear_model<T>::evaluate_model(da_int nfeat, da_int nsamples, const T
         break;
 
     default:
-        return da_error(this->err, da_status_not_implemented, // LCOV_EXCL_LINE
+        return da_error(err, da_status_not_implemented, // LCOV_EXCL_LINE
                         "The requested model is not supported.");
         break;
     }
@@ -781,9 +1083,13 @@ linmod_method linear_model<T>::fallback_oracle(da_status status, bool &force_fal
 
 template <typename T> da_status linear_model<T>::fit(da_int usr_ncoefs, const T *coefs) {
 
-    if (!this->init_done)
+    if (!this->init_done) {
+        // Data passed in blocks, solve from the accumulated statistics
+        if (stream)
+            return fit_stream();
         return da_error(this->err, da_status_no_data,
                         "No data has been passed to the handle.");
+    }
 
     if (this->model_trained)
         return da_status_success;
@@ -796,6 +1102,10 @@ template <typename T> da_status linear_model<T>::fit(da_int usr_ncoefs, const T
             return status;
     }
 
+    // Weighted least squares are solved as an unweighted problem on transformed data
+    if (!sample_weights.empty() && mod == linmod_model_mse)
+        return fit_weighted_mse(usr_ncoefs, coefs);
+
     if (this->method_id == linmod_method::undefined) {
         status = choose_method();
         if (status != da_status_success) {
@@ -1241,6 +1551,129 @@ da_status linear_model<T>::fit_impl(da_int usr_ncoefs, const T *coefs, bool do_p
     return da_status_success;
 }
 
+/* Fit a weighted linear regression model
+ *
+ * The weighted problem
+ *     min 1/(2N) sum_i w_i (y_i - x_i^T beta - beta0)^2 + regularization,
+ * with sum_i w_i = N (see define_sample_weights), is equivalent to the unweighted
+ * problem without intercept on the transformed data
+ *     Xw = diag(sqrt(w)) (X - 1 mu_w^T), yw = diag(sqrt(w)) (y - 1 mu_w(y)),
+ * where mu_w are the weighted column means (only subtracted when an intercept is
+ * requested). The intercept is recovered as beta0 = mu_w(y) - mu_w^T beta.
+ * The transformed data temporarily replaces the user data so that every solver
+ * and scaling option can be used unchanged.
+ */
+template <typename T>
+da_status linear_model<T>::fit_weighted_mse(da_int usr_ncoefs, const T *coefs) {
+    const bool rowmajor = this->order == da_order::row_major;
+    const bool user_intercept = intercept;
+    std::vector<T> mu, sw;
+    try {
+        mu.assign(nfeat + 1, T(0));
+        sw.resize(nsamples);
+        Xw.resize(nsamples * nfeat);
+        yw.resize(nsamples);
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    const T *w = sample_weights.data();
+    const da_int xinc_i = rowmajor ? ldXUSR : 1;
+    const da_int xinc_j = rowmajor ? 1 : ldXUSR;
+
+    if (user_intercept) {
+        using W = da_fp16::wider_t<T>;
+#pragma omp parallel for
+        for (da_int j = 0; j < nfeat; j++) {
+            W acc{0};
+            for (da_int i = 0; i < nsamples; i++)
+                acc += static_cast<W>(w[i]) *
+                       static_cast<W>(XUSR[i * xinc_i + j * xinc_j]);
+            mu[j] = static_cast<T>(acc / static_cast<W>(nsamples));
+        }
+        W acc{0};
+        for (da_int i = 0; i < nsamples; i++)
+            acc += static_cast<W>(w[i]) * static_cast<W>(yusr[i]);
+        mu[nfeat] = static_cast<T>(acc / static_cast<W>(nsamples));
+    }
+
+    for (da_int i = 0; i < nsamples; i++) {
+        sw[i] = da_std::sqrt(w[i]);
+        yw[i] = sw[i] * (yusr[i] - mu[nfeat]);
+    }
+    const da_int ldw = rowmajor ? nfeat : nsamples;
+    const da_int winc_i = rowmajor ? ldw : 1;
+    const da_int winc_j = rowmajor ? 1 : ldw;
+#pragma omp parallel for
+    for (da_int j = 0; j < nfeat; j++) {
+        for (da_int i = 0; i < nsamples; i++)
+            Xw[i * winc_i + j * winc_j] = sw[i] * (XUSR[i * xinc_i + j * xinc_j] - mu[j]);
+    }
+
+    // Swap the user data for the transformed problem and solve it without intercept.
+    // The weights are moved out so the recursive call solves the unweighted problem.
+    const T *XUSR_save = XUSR, *yusr_save = yusr;
+    const da_int ldXUSR_save = ldXUSR;
+    const bool read_public_options_save = read_public_options;
+    std::vector<T> weights;
+    weights.swap(sample_weights);
+    reset_data();
+    X = nullptr; // points to XUSR after reset_data(), must not be released
+    y = nullptr;
+    XUSR = Xw.data();
+    yusr = yw.data();
+    ldXUSR = ldw;
+    reset_data();
+    intercept = false;
+    read_public_options = false;
+
+    // Without standardization the ridge loss is a plain sum of squares, so the
+    // normalized weights shrink it by nsamples / sum(w). Rescale lambda to keep the
+    // solution equal to the one on the data set with replicated rows.
+    const T lambda_save = lambda;
+    const scaling_t wscaling =
+        user_scaling == scaling_t::automatic ? scaling_t::none : user_scaling;
+    if (alpha == T(0) && (wscaling == scaling_t::none || wscaling == scaling_t::centering))
+        lambda *= sample_weights_scale;
+
+    da_status status = fit(usr_ncoefs, coefs);
+    lambda = lambda_save;
+
+    // Restore the user data, any internal copy of Xw is released here
+    const bool trained = this->model_trained;
+    reset_data();
+    X = nullptr;
+    y = nullptr;
+    XUSR = XUSR_save;
+    yusr = yusr_save;
+    ldXUSR = ldXUSR_save;
+    reset_data();
+    intercept = user_intercept;
+    read_public_options = read_public_options_save;
+    sample_weights.swap(weights);
+    is_well_determined = nsamples >= nfeat + (intercept ? 1 : 0);
+    this->model_trained = trained;
+
+    if (status != da_status_success || !user_intercept)
+        return status;
+
+    // Recover the intercept from the weighted means
+    try {
+        coef.resize(nfeat + 1);
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    T cum0{0};
+    for (da_int k = 0; k < nfeat; k++)
+        cum0 += mu[k] * coef[k];
+    coef[nfeat] = mu[nfeat] - cum0;
+    ncoef = nfeat + 1;
+    ncol_coef = ncoef;
+
+    return status;
+}
+
 /* Fit a linear regression model with the coordinate descent method */
 template <class T> da_status linear_model<T>::fit_linreg_coord() {
     da_status status = da_status_success;
@@ -1390,9 +1823,15 @@ template <class T> da_status linear_model<T>::fit_logreg_lbfgs() {
             this->err, da_status_internal_error, // LCOV_EXCL_LINE
             "Unexpectedly undefined logistic model constraint was requested.");
     }
+    // The log-loss is a plain sum, so the normalized weights shrink it by
+    // nsamples / sum(w). Rescale lambda to keep the solution equal to the one on the
+    // data set with replicated rows.
+    const T wlambda = sample_weights.empty() ? lambda : lambda * sample_weights_scale;
     try {
         udata = new cb_usrdata_logreg<T>(this->Xorder, X, ldX, y, nsamples, nfeat,
-                                         intercept, lambda, alpha, nclass, nparam);
+                                         intercept, wlambda, alpha, nclass, nparam);
+        if (!sample_weights.empty())
+            udata->w = sample_weights.data();
     } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
         return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
                         "Memory allocation error");
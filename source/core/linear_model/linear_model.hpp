@@ -30,9 +30,11 @@
 #include "basic_handle.hpp"
 #include "da_cblas.hh"
 #include "da_error.hpp"
+#include "da_inference_context.hpp"
 #include "da_std.hpp"
 #include "fp16_helpers.hpp"
 #include "lapack_templates.hpp"
+#include "linmod_softmax.hpp"
 #include "linmod_types.hpp"
 #include "macros.h"
 #include "model_persistence.hpp"
@@ -117,6 +119,35 @@ template <typename T> struct qr_data {
     qr_data(da_int nsamples, da_int nfeat);
 };
 
+/* Data for the streaming (out-of-core) least squares solver
+ * Rows of [ X | y ] are passed in blocks and only the running statistics are kept:
+ *   n: number of rows seen so far
+ *   mean[m]: column means of [ X | y ], m = nfeat + 1
+ *   R[m*m]: upper triangular factor (column-major) of the centered data,
+ *           [ X - 1 mean_x' | y - mean_y ] = Q R
+ * Each block is centered and reduced with the blocked TSQR of da_qr.hpp and then
+ * merged into R by a QR of the stacked factors plus a rank-one row correcting for the
+ * difference of the means.
+ */
+template <typename T> struct stream_data {
+    da_int nfeat, m;
+    da_int n = 0;
+    std::vector<T> mean, R;
+    // Work arrays
+    std::vector<T> block, block_mean, stack, tau, work;
+
+    // Constructors
+    stream_data(da_int nfeat);
+
+    da_status add_block(da_order order, da_int nrows, const T *X, da_int ldx, const T *y,
+                        da_errors::da_error_t *err);
+    da_status merge(da_int nb, const T *mean_b, da_int rb, const T *Rb, da_int ldrb,
+                    da_errors::da_error_t *err);
+    // m x m triangular factor of [ X | y ], centered or not
+    da_status factor(bool centered, std::vector<T> &Rout, da_errors::da_error_t *err);
+    da_status reduce_stack(da_int ns, T *Rdst, da_errors::da_error_t *err);
+};
+
 // Data for svd used in linear regression
 template <typename T> struct svd_data {
     std::vector<T> S, U, Vt, temp, work;
@@ -171,6 +202,17 @@ template <typename T> class linear_model : public basic_handle<T> {
     da_order Xorder;   // storage order of X
     T time = 0;        // Computation time
 
+    /* Optional per-sample (frequency) weights
+     * sample_weights[nsamples]: copy of the user weights rescaled to sum to nsamples,
+     *    empty when the problem is unweighted.
+     * sample_weights_scale: the rescaling factor nsamples / sum(weights).
+     * Xw, yw: weighted (and, with intercept, weighted-centered) copies of XUSR and yusr
+     *    used by fit_weighted_mse() to solve the problem with any of the mse solvers.
+     */
+    std::vector<T> sample_weights;
+    T sample_weights_scale = T(1);
+    std::vector<T> Xw, yw;
+
     /* save state of options that the API can change */
     da_linmod_types::scaling_t user_scaling = da_linmod_types::scaling_t::automatic;
 
@@ -224,6 +266,11 @@ template <typename T> class linear_model : public basic_handle<T> {
     cg_data<T> *cg = nullptr;
     cholesky_data<T> *cholesky = nullptr;
 
+    // Streaming data source, mutually exclusive with define_features
+    stream_data<T> *stream = nullptr;
+    bool fitted_from_stream = false;
+    T stream_rss = 0; // residual sum of squares of the streamed fit
+
     std::string method_str, scaling_str, logistic_constraint_str;
 
     // Private methods to allocate memory
@@ -284,6 +331,11 @@ template <typename T> class linear_model : public basic_handle<T> {
 
     da_status define_features(da_int nfeat, da_int nsamples, const T *X, da_int ldX,
                               const T *y);
+    da_status define_sample_weights(da_int nsamples, const T *weights);
+    da_status stream_block(da_int nfeat, da_int nsamples, const T *X, da_int ldX,
+                           const T *y);
+    da_status fit_stream();
+    void reset_stream();
     da_status select_model(linmod_model mod);
     da_status prep_matrix_x(da_int &nrow, da_int &ncol, da_axis &axis, bool &transpose);
     da_status preprocess_data(linmod_method method);
@@ -293,6 +345,7 @@ template <typename T> class linear_model : public basic_handle<T> {
     linmod_method fallback_oracle(da_status status, bool &force_fallback);
     da_status fit(da_int usr_ncoefs, const T *coefs);
     da_status fit_impl(da_int usr_ncoefs, const T *coefs, bool do_prep);
+    da_status fit_weighted_mse(da_int usr_ncoefs, const T *coefs);
     da_status fit_linreg_lbfgs();
     da_status fit_linreg_coord();
     da_status fit_linreg_svd();
@@ -304,6 +357,9 @@ template <typename T> class linear_model : public basic_handle<T> {
     da_status evaluate_model(da_int nfeat, da_int nsamples, const T *Xeval,
                              da_int ldXeval, T *predictions, const T *observations,
                              T *loss);
+    da_status evaluate_model(_da_inference_context &ctx, da_int nfeat, da_int nsamples,
+                             const T *Xeval, da_int ldXeval, T *predictions,
+                             const T *observations, T *loss);
 
     da_status get_result(da_result query, da_int *dim, T *result) override;
     da_status get_result(da_result query, da_int *dim, da_int *result) override;
@@ -27,6 +27,7 @@
 #include "da_std.hpp"
 #include "fp16_helpers.hpp"
 #include "linear_model.hpp"
+#include "linmod_softmax.hpp"
 #include "linmod_types.hpp"
 #include "macros.h"
 
@@ -93,7 +94,9 @@ cb_usrdata_logreg<T>::cb_usrdata_logreg(da_order order, const T *X, da_int ldX,
     maxexp.resize(nsamples);
     sumexp.resize(nsamples);
     lincomb.resize(nsamples * nparam);
-    gradients_p.resize(nsamples * nparam);
+    // The multinomial gradient is formed in place in lincomb
+    if (nparam < nclass)
+        gradients_p.resize(nsamples * nparam);
 }
 
 template <class T> cb_usrdata_logreg<T>::~cb_usrdata_logreg() {}
@@ -213,6 +216,7 @@ da_int objfun_logistic_rsc([[maybe_unused]] da_int n, T *x, T *f, void *udata) {
     da_int nfeat = data->nfeat;
     da_int nsamples = data->nsamples;
     da_int nmod = data->intercept ? nfeat + 1 : nfeat;
+    const T *w = data->w;
 
     // lincomb is of size nsamples*(nclass-1)
     // Store in lincomb[:,k] the Beta_k^T * x for the nsamples samples in the input matrix
@@ -228,7 +232,7 @@ da_int objfun_logistic_rsc([[maybe_unused]] da_int n, T *x, T *f, void *udata) {
                 maxexp[i] = lincomb[idx];
             // Indicator(i, k) * X * x[k*nmod:(k+1)*nmod-1] added to objective
             if (std::round(y[i]) == k)
-                *f -= lincomb[idx];
+                *f -= w ? w[i] * lincomb[idx] : lincomb[idx];
             idx += 1;
         }
     }
@@ -240,7 +244,7 @@ da_int objfun_logistic_rsc([[maybe_unused]] da_int n, T *x, T *f, void *udata) {
         for (da_int k = 0; k < nclass - 1; k++) {
             val += exp(lincomb[k * nsamples + i] - maxexp[i]);
         }
-        *f += maxexp[i] + log(val);
+        *f += w ? w[i] * (maxexp[i] + log(val)) : maxexp[i] + log(val);
     }
 
     // Add regularization (exclude intercept)
@@ -263,6 +267,7 @@ da_int objgrd_logistic_rsc(da_int n, T *x, T *grad, void *udata,
     da_int idc = data->intercept ? 1 : 0;
     da_int nclass = data->nclass;
     da_int nmod = data->intercept ? data->nfeat + 1 : data->nfeat;
+    const T *w = data->w;
 
     if (xnew) {
         // Store in lincomb[:,k] the Beta_k^T * x for the nsamples samples in the input matrix
@@ -294,6 +299,8 @@ da_int objgrd_logistic_rsc(da_int n, T *x, T *grad, void *udata,
             T val = -exp(lincomb[k * nsamples + i] - lnsumexp);
             if (std::round(y[i]) == k)
                 val += 1.;
+            if (w)
+                val *= w[i];
             for (da_int j = 0; j < nmod - idc; j++) {
                 grad[k * nmod + j] -= X[j * data->ldX + i] * val;
             }
@@ -337,11 +344,14 @@ da_int objfun_logistic_two_class([[maybe_unused]] da_int n, T *x, T *f, void *ud
     // If-else codepath to avoid overflow
     // ln(1+exp(b^Tx)) = ln(exp(b^TX)[exp(-b^TX) + 1]) = b^TX + ln(1+exp(-b^TX))
     // look at private and shared variables
+    const T *w = data->w;
     for (da_int i = 0; i < nsamples; i++) {
+        T fi;
         if (lincomb[i] < 0)
-            *f += log(1 + exp(lincomb[i])) - std::round(y[i]) * lincomb[i];
+            fi = log(1 + exp(lincomb[i])) - std::round(y[i]) * lincomb[i];
         else
-            *f += log(1 + exp(-lincomb[i])) + (1 - std::round(y[i])) * lincomb[i];
+            fi = log(1 + exp(-lincomb[i])) + (1 - std::round(y[i])) * lincomb[i];
+        *f += w ? w[i] * fi : fi;
     }
 
     // Add regularization (exclude intercept)
@@ -382,6 +392,8 @@ da_int objgrd_logistic_two_class(da_int n, T *x, T *grad, void *udata,
             gradients_p[i] = exp(lincomb[i]) / (1 + exp(lincomb[i])) - std::round(y[i]);
         else
             gradients_p[i] = 1 / (1 + exp(-lincomb[i])) - std::round(y[i]);
+        if (data->w)
+            gradients_p[i] *= data->w[i];
         sum_of_gradients += gradients_p[i];
     }
 
@@ -407,21 +419,14 @@ da_int objfun_logistic_ssc([[maybe_unused]] da_int n, T *x, T *f, void *udata) {
     // with nmod = (nfeat+itpt), the parameters corresponding to the class k (k in 0,..,K-1)
 
     cb_usrdata_logreg<T> *data = (cb_usrdata_logreg<T> *)udata;
-    std::vector<T> &maxexp = data->maxexp;
-    std::vector<T> &sumexp = data->sumexp;
     std::vector<T> &lincomb = data->lincomb;
     T *lincomb_ptr = data->lincomb.data();
-    const T *y = data->y;
     da_int nclass = data->nclass;
     da_int nfeat = data->nfeat;
     da_int nsamples = data->nsamples;
 
     // lincomb is of size nsamples*nclass
     // Store in lincomb[:,k] the Beta_k^T * x for the nsamples samples in the input matrix
-    // Store in maxexp the max of lincomb for each sample
-    *f = 0;
-    da_std::fill(maxexp.begin(), maxexp.end(), 0.);
-    da_std::fill(sumexp.begin(), sumexp.end(), 0.);
     if (data->intercept) {
         for (da_int k = 0; k < nclass; k++) {
             da_std::fill(lincomb.begin() + k * nsamples,
@@ -432,29 +437,13 @@ da_int objfun_logistic_ssc([[maybe_unused]] da_int n, T *x, T *f, void *udata) {
     }
 
     // Calculate licomb as X * Beta + Beta_0
-    // This needs to be replace with a call eval_feature_matrix
     da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasTrans, nsamples, nclass, nfeat,
                         1.0, data->X, data->ldX, x, nclass, 1.0, lincomb_ptr, nsamples);
 
-    // look at private and shared variables
-    for (da_int i = 0; i < nsamples; i++) {
-        for (da_int k = 0; k < nclass; k++) {
-            // Find maxexp
-            if (maxexp[i] < lincomb[k * nsamples + i]) {
-                maxexp[i] = lincomb[k * nsamples + i];
-            }
-            // Subtract the residual of correct class
-            if (std::round(y[i]) == k)
-                *f -= lincomb[k * nsamples + i];
-        }
-        // Compute for each sample i ln(sum_{k=0}^{K-1} exp(lincomb[i][k]))
-        // use logsumexp trick to avoid overflow
-        sumexp[i] = 0;
-        for (da_int k = 0; k < nclass; k++) {
-            sumexp[i] += exp(lincomb[k * nsamples + i] - maxexp[i]);
-        }
-        *f += maxexp[i] + log(sumexp[i]);
-    }
+    // Fused log-sum-exp and log-likelihood, maxexp and sumexp are kept for the gradient
+    *f = da_linmod::softmax_logloss(nsamples, nclass, lincomb_ptr, nsamples, data->y,
+                                    data->w, data->maxexp.data(), data->sumexp.data());
+    data->lincomb_residual = false;
 
     // Add regularization (exclude intercept)
     *f += regfun(nfeat * nclass, x, data->l1reg, data->l2reg);
@@ -467,65 +456,38 @@ da_int objgrd_logistic_ssc(da_int n, T *x, T *grad, void *udata,
                            [[maybe_unused]] da_int xnew) {
 
     cb_usrdata_logreg<T> *data = (cb_usrdata_logreg<T> *)udata;
-    std::vector<T> &maxexp = data->maxexp;
-    std::vector<T> &sumexp = data->sumexp;
-    std::vector<T> &gradients_p = data->gradients_p;
-    const T *y = data->y;
-    std::vector<T> &lincomb = data->lincomb;
     T *lincomb_ptr = data->lincomb.data();
     da_int nsamples = data->nsamples;
     da_int nclass = data->nclass;
     da_int nfeat = data->nfeat;
 
     if (xnew) {
-        da_std::fill(maxexp.begin(), maxexp.end(), 0.);
-        if (data->intercept) {
-            for (da_int k = 0; k < nclass; k++) {
-                da_std::fill(lincomb.begin() + k * nsamples,
-                             lincomb.begin() + (k + 1) * nsamples, x[n - (nclass - k)]);
-            }
-        } else {
-            da_std::fill(lincomb.begin(), lincomb.end(), 0.);
-        }
-        // Calculate licomb as X * Beta + Beta_0
-        da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasTrans, nsamples, nclass,
-                            nfeat, 1.0, data->X, data->ldX, x, nclass, 1.0, lincomb_ptr,
-                            nsamples);
-        for (da_int i = 0; i < nsamples; i++) {
-            for (da_int k = 0; k < nclass; k++) {
-                // Find maxexp
-                if (maxexp[i] < lincomb[k * nsamples + i]) {
-                    maxexp[i] = lincomb[k * nsamples + i];
-                }
-            }
-            // Compute sumexp
-            sumexp[i] = exp(-maxexp[i]);
-            for (da_int k = 0; k < nclass; k++) {
-                sumexp[i] += exp(lincomb[k * nsamples + i] - maxexp[i]);
-            }
-        }
+        // Recompute the logits and the log-sum-exp terms
+        T f;
+        objfun_logistic_ssc(n, x, &f, udata);
     }
 
     // Compute for all samples i and all variables j with k being the class of sample i:
     // A_ij * (prob(x_i=k|Beta) - indicator(i, k))
-    da_std::fill(grad, grad + n, 0);
-    for (da_int i = 0; i < nsamples; i++) {
-        for (da_int k = 0; k < nclass; k++) {
-            gradients_p[k * nsamples + i] =
-                exp(lincomb[k * nsamples + i] - maxexp[i]) / sumexp[i];
-            if (std::round(y[i]) == k)
-                gradients_p[k * nsamples + i] -= 1;
-        }
+    // The pointwise gradients overwrite the logits, so no other nsamples*nclass array is
+    // needed. They remain valid until the next objective evaluation.
+    if (!data->lincomb_residual) {
+        da_linmod::softmax_residual(nsamples, nclass, lincomb_ptr, nsamples, data->y,
+                                    data->w, data->maxexp.data(), data->sumexp.data());
+        data->lincomb_residual = true;
     }
+    da_std::fill(grad, grad + n, 0);
     da_blas::cblas_gemm(CblasColMajor, CblasTrans, CblasNoTrans, nclass, nfeat, nsamples,
-                        1.0, gradients_p.data(), nsamples, data->X, data->ldX, 0.0, grad,
+                        1.0, lincomb_ptr, nsamples, data->X, data->ldX, 0.0, grad,
                         nclass);
     if (data->intercept) {
-        for (da_int i = 0; i < nclass; i++) {
+        for (da_int k = 0; k < nclass; k++) {
+            const T *r = &lincomb_ptr[k * nsamples];
             T sum = 0;
-            for (da_int j = 0; j < nsamples; j++)
-                sum += gradients_p[j + i * nsamples];
-            grad[n - (nclass - i)] = sum;
+#pragma omp simd reduction(+ : sum)
+            for (da_int i = 0; i < nsamples; i++)
+                sum += r[i];
+            grad[n - (nclass - k)] = sum;
         }
     }
     // Add regularization (exclude intercept)
@@ -591,7 +553,7 @@ template <typename T> da_int objfun_mse(da_int n, T *x, T *loss, void *udata) {
 template <typename T>
 da_int loss_mse(da_order order, da_int nsamples, da_int nfeat, const T *X, da_int ldX,
                 bool intercept, T l1reg, T l2reg, const T *coef, const T *y, T *loss,
-                T *pred) {
+                T *pred, const T *w) {
 
     const da_int ncoef = intercept ? nfeat + 1 : nfeat;
 
@@ -602,7 +564,12 @@ da_int loss_mse(da_order order, da_int nsamples, da_int nfeat, const T *X, da_in
         // Observation vector provided, return also the loss function value
         // sum (X * coef (+intr) - y)^2
         T ls{0};
-        if constexpr (simd_ok<T>) {
+        if (w) {
+            for (da_int i = 0; i < nsamples; i++) {
+                T res = pred[i] - y[i];
+                ls += w[i] * res * res;
+            }
+        } else if constexpr (simd_ok<T>) {
 #pragma omp simd reduction(+ : ls)
             for (da_int i = 0; i < nsamples; i++) {
                 T res = pred[i] - y[i];
@@ -1101,16 +1068,18 @@ template da_int objgrd_mse<float>(da_int n, float *x, float *grad, void *udata,
 template da_int loss_mse<double>(da_order order, da_int nsamples, da_int nfeat,
                                  const double *X, da_int ldX, bool intercept,
                                  double l1reg, double l2reg, const double *coef,
-                                 const double *y, double *loss, double *pred);
+                                 const double *y, double *loss, double *pred,
+                                 const double *w);
 template da_int loss_mse<float>(da_order order, da_int nsamples, da_int nfeat,
                                 const float *X, da_int ldX, bool intercept, float l1reg,
                                 float l2reg, const float *coef, const float *y,
-                                float *loss, float *pred);
+                                float *loss, float *pred, const float *w);
 #ifdef __AVX512FP16__
 template da_int loss_mse<_Float16>(da_order order, da_int nsamples, da_int nfeat,
                                    const _Float16 *X, da_int ldX, bool intercept,
                                    _Float16 l1reg, _Float16 l2reg, const _Float16 *coef,
-                                   const _Float16 *y, _Float16 *loss, _Float16 *pred);
+                                   const _Float16 *y, _Float16 *loss, _Float16 *pred,
+                                   const _Float16 *w);
 #endif
 template da_int stepfun_linreg_glmnet<double>(da_int nfeat, double *coef, double *knew,
                                               da_int k, double *f, void *udata,
@@ -62,6 +62,37 @@ da_status da_linmod_define_features(da_handle handle, da_int n_samples, da_int n
                                 handle, n_samples, n_features, X, ldx, y)));
 }
 
+template <typename T>
+da_status da_linmod_define_sample_weights(da_handle handle, da_int n_samples,
+                                          const T *weights) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // clean up handle logs
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err,
+               return (linmod_define_sample_weights<da_linmod::linear_model<T>, T>(
+                   handle, n_samples, weights)));
+}
+
+template <typename T>
+da_status da_linmod_stream_features(da_handle handle, da_int n_samples, da_int n_features,
+                                    const T *X, da_int ldx, const T *y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // clean up handle logs
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err, return (linmod_stream_features<da_linmod::linear_model<T>, T>(
+                                handle, n_samples, n_features, X, ldx, y)));
+}
+
 template <typename T>
 da_status da_linmod_fit_start(da_handle handle, da_int ncoefs, const T *coefs) {
     if (!handle)
@@ -98,6 +129,26 @@ da_status da_linmod_evaluate_model(da_handle handle, da_int n_samples, da_int n_
                                 observations, loss)));
 }
 
+template <typename T>
+da_status da_linmod_evaluate_model(da_handle handle, da_inference_context ctx,
+                                   da_int n_samples, da_int n_features, const T *X,
+                                   da_int ldx, T *predictions, const T *observations,
+                                   T *loss) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    if (!ctx)
+        return da_status_invalid_pointer;
+    ctx->clear(); // Clean up context logs, the handle is only read
+
+    da_status status = handle->check_precision<T>(ctx->err);
+    if (status != da_status_success)
+        return da_error_trace(ctx->err, status, "Wrong precision type.");
+
+    DISPATCHER(ctx->err, return (linmod_evaluate_model<da_linmod::linear_model<T>, T>(
+                             handle, ctx, n_samples, n_features, X, ldx, predictions,
+                             observations, loss)));
+}
+
 template da_status da_linmod_select_model<float>(da_handle, linmod_model);
 template da_status da_linmod_select_model<double>(da_handle, linmod_model);
 template da_status da_linmod_define_features<float>(da_handle, da_int, da_int,
@@ -105,6 +156,15 @@ template da_status da_linmod_define_features<float>(da_handle, da_int, da_int,
 template da_status da_linmod_define_features<double>(da_handle, da_int, da_int,
                                                      const double *, da_int,
                                                      const double *);
+template da_status da_linmod_define_sample_weights<float>(da_handle, da_int,
+                                                          const float *);
+template da_status da_linmod_define_sample_weights<double>(da_handle, da_int,
+                                                           const double *);
+template da_status da_linmod_stream_features<float>(da_handle, da_int, da_int,
+                                                    const float *, da_int, const float *);
+template da_status da_linmod_stream_features<double>(da_handle, da_int, da_int,
+                                                     const double *, da_int,
+                                                     const double *);
 template da_status da_linmod_fit_start<float>(da_handle, da_int, const float *);
 template da_status da_linmod_fit_start<double>(da_handle, da_int, const double *);
 template da_status da_linmod_fit<float>(da_handle);
@@ -115,3 +175,10 @@ template da_status da_linmod_evaluate_model<float>(da_handle, da_int, da_int,
 template da_status da_linmod_evaluate_model<double>(da_handle, da_int, da_int,
                                                     const double *, da_int, double *,
                                                     const double *, double *);
+template da_status da_linmod_evaluate_model<float>(da_handle, da_inference_context,
+                                                   da_int, da_int, const float *, da_int,
+                                                   float *, const float *, float *);
+template da_status da_linmod_evaluate_model<double>(da_handle, da_inference_context,
+                                                    da_int, da_int, const double *,
+                                                    da_int, double *, const double *,
+                                                    double *);
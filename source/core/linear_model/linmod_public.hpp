@@ -23,6 +23,7 @@
 
 #include "aoclda.h"
 #include "da_handle.hpp"
+#include "da_inference_context.hpp"
 #include "dynamic_dispatch.hpp"
 #include "macros.h"
 
@@ -48,7 +49,34 @@ da_status linmod_define_features(da_handle handle, da_int nsamples, da_int nfeat
                         "handle was not initialized with handle_type=da_handle_linmod or "
                         "handle is invalid.");
 
-    return linmod->define_features(nfeat, nsamples, X, ldX, b);
+    da_status status = linmod->define_features(nfeat, nsamples, X, ldX, b);
+    if (status == da_status_success)
+        linmod->release_datastore_data();
+    return status;
+}
+
+template <typename linmod_class, typename T>
+da_status linmod_define_sample_weights(da_handle handle, da_int nsamples,
+                                       const T *weights) {
+    linmod_class *linmod = dynamic_cast<linmod_class *>(handle->get_alg_handle<T>());
+    if (linmod == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_linmod or "
+                        "handle is invalid.");
+
+    return linmod->define_sample_weights(nsamples, weights);
+}
+
+template <typename linmod_class, typename T>
+da_status linmod_stream_features(da_handle handle, da_int nsamples, da_int nfeat,
+                                 const T *X, da_int ldX, const T *b) {
+    linmod_class *linmod = dynamic_cast<linmod_class *>(handle->get_alg_handle<T>());
+    if (linmod == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_linmod or "
+                        "handle is invalid.");
+
+    return linmod->stream_block(nfeat, nsamples, X, ldX, b);
 }
 
 template <typename linmod_class, typename T>
@@ -84,4 +112,23 @@ da_status linmod_evaluate_model(da_handle handle, da_int nsamples, da_int nfeat,
                     "observation. Parameter `loss` should point to a valid address.");
 }
 
+template <typename linmod_class, typename T>
+da_status linmod_evaluate_model(da_handle handle, da_inference_context ctx,
+                                da_int nsamples, da_int nfeat, const T *Xeval,
+                                da_int ldXeval, T *predictions, const T *observations,
+                                T *loss) {
+    linmod_class *linmod = dynamic_cast<linmod_class *>(handle->get_alg_handle<T>());
+    if (linmod == nullptr)
+        return da_error(ctx->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_linmod or "
+                        "handle is invalid.");
+
+    if ((observations == nullptr) != (loss == nullptr))
+        return da_error(ctx->err, da_status_invalid_input,
+                        "Parameter `observations` should contain at least one single "
+                        "observation. Parameter `loss` should point to a valid address.");
+    return linmod->evaluate_model(*ctx, nfeat, nsamples, Xeval, ldXeval, predictions,
+                                  observations, loss);
+}
+
 } // namespace linmod_public
\ No newline at end of file
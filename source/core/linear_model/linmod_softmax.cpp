@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "linmod_softmax.hpp"
+#include "aoclda_types.h"
+#include "da_omp.hpp"
+#include "immintrin.h"
+#include "kt.hpp"
+#include "macros.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace ARCH {
+
+namespace da_linmod {
+
+using namespace kernel_templates;
+
+/* These functions contain performance-critical loops which must vectorize for
+ * performance. Each SIMD lane handles one sample, so the loads are contiguous in the
+ * column-major logits and the loop over the classes needs no horizontal reductions.
+ */
+
+// Parallelize over the samples only when there is enough work to amortize the threads
+constexpr da_int softmax_omp_min_size = 16384;
+
+#if !defined(USE_SCALAR_MATH) && (defined(__AVX512F__) || defined(__AVX2__))
+#define DA_SOFTMAX_KT
+#if defined(__AVX512F__)
+constexpr bsz softmax_bsz = bsz::b512;
+#else
+constexpr bsz softmax_bsz = bsz::b256;
+#endif
+
+template <bsz SZ, typename SUF>
+inline __attribute__((__always_inline__)) void
+logsumexp_kt(da_int nclass, const SUF *Z, da_int ldz, SUF *maxexp, SUF *sumexp) {
+    avxvector_t<SZ, SUF> v_max = kt_loadu_p<SZ, SUF>(Z);
+    for (da_int k = 1; k < nclass; k++)
+        v_max = kt_max_p<SZ, SUF>(v_max, kt_loadu_p<SZ, SUF>(&Z[k * ldz]));
+    avxvector_t<SZ, SUF> v_sum = kt_setzero_p<SZ, SUF>();
+    for (da_int k = 0; k < nclass; k++) {
+        avxvector_t<SZ, SUF> v_z = kt_loadu_p<SZ, SUF>(&Z[k * ldz]);
+        v_z = kt_sub_p<SZ, SUF>(v_z, v_max);
+        v_sum = kt_add_p<SZ, SUF>(v_sum, kt_exp_p<SZ, SUF>(v_z));
+    }
+    kt_storeu_p<SZ, SUF>(maxexp, v_max);
+    kt_storeu_p<SZ, SUF>(sumexp, v_sum);
+}
+
+template <bsz SZ, typename SUF>
+inline __attribute__((__always_inline__)) void
+softmax_scale_kt(da_int nclass, SUF *Z, da_int ldz, const SUF *w, const SUF *maxexp,
+                 const SUF *sumexp) {
+    avxvector_t<SZ, SUF> v_max = kt_loadu_p<SZ, SUF>(maxexp);
+    // Fold the sample weights into the normalization factor
+    avxvector_t<SZ, SUF> v_num =
+        w ? kt_loadu_p<SZ, SUF>(w) : kt_set1_p<SZ, SUF>(static_cast<SUF>(1.0));
+    avxvector_t<SZ, SUF> v_scale = kt_div_p<SZ, SUF>(v_num, kt_loadu_p<SZ, SUF>(sumexp));
+    for (da_int k = 0; k < nclass; k++) {
+        avxvector_t<SZ, SUF> v_z = kt_loadu_p<SZ, SUF>(&Z[k * ldz]);
+        v_z = kt_sub_p<SZ, SUF>(v_z, v_max);
+        v_z = kt_mul_p<SZ, SUF>(kt_exp_p<SZ, SUF>(v_z), v_scale);
+        kt_storeu_p<SZ, SUF>(&Z[k * ldz], v_z);
+    }
+}
+#endif
+
+template <typename T>
+inline void logsumexp_scalar(da_int nclass, const T *Z, da_int ldz, T &maxexp,
+                             T &sumexp) {
+    T zmax = Z[0];
+    for (da_int k = 1; k < nclass; k++)
+        zmax = std::max(zmax, Z[k * ldz]);
+    T zsum{0};
+    for (da_int k = 0; k < nclass; k++)
+        zsum += std::exp(Z[k * ldz] - zmax);
+    maxexp = zmax;
+    sumexp = zsum;
+}
+
+template <typename T>
+T softmax_logloss(da_int nsamples, da_int nclass, const T *Z, da_int ldz, const T *y,
+                  const T *w, T *maxexp, T *sumexp) {
+    da_int istart = 0;
+#ifdef DA_SOFTMAX_KT
+    constexpr da_int vlen = tsz_v<softmax_bsz, T>;
+    const da_int nblocks = nsamples / vlen;
+#pragma omp parallel for schedule(static) if (nsamples * nclass > softmax_omp_min_size)
+    for (da_int b = 0; b < nblocks; b++) {
+        logsumexp_kt<softmax_bsz, T>(nclass, &Z[b * vlen], ldz, &maxexp[b * vlen],
+                                     &sumexp[b * vlen]);
+    }
+    istart = nblocks * vlen;
+#endif
+    for (da_int i = istart; i < nsamples; i++)
+        logsumexp_scalar(nclass, &Z[i], ldz, maxexp[i], sumexp[i]);
+
+    // Negative log-likelihood, only nsamples logarithms are needed here
+    T loss{0};
+    for (da_int i = 0; i < nsamples; i++) {
+        const da_int k = static_cast<da_int>(std::round(y[i]));
+        const T fi = maxexp[i] + std::log(sumexp[i]) - Z[i + k * ldz];
+        loss += w ? w[i] * fi : fi;
+    }
+    return loss;
+}
+
+template <typename T>
+void softmax_residual(da_int nsamples, da_int nclass, T *Z, da_int ldz, const T *y,
+                      const T *w, const T *maxexp, const T *sumexp) {
+    da_int istart = 0;
+#ifdef DA_SOFTMAX_KT
+    constexpr da_int vlen = tsz_v<softmax_bsz, T>;
+    const da_int nblocks = nsamples / vlen;
+#pragma omp parallel for schedule(static) if (nsamples * nclass > softmax_omp_min_size)
+    for (da_int b = 0; b < nblocks; b++) {
+        softmax_scale_kt<softmax_bsz, T>(nclass, &Z[b * vlen], ldz,
+                                         w ? &w[b * vlen] : nullptr, &maxexp[b * vlen],
+                                         &sumexp[b * vlen]);
+    }
+    istart = nblocks * vlen;
+#endif
+    for (da_int i = istart; i < nsamples; i++) {
+        const T scale = (w ? w[i] : T(1)) / sumexp[i];
+        for (da_int k = 0; k < nclass; k++)
+            Z[i + k * ldz] = std::exp(Z[i + k * ldz] - maxexp[i]) * scale;
+    }
+
+    // Subtract the indicator of the observed class
+    for (da_int i = 0; i < nsamples; i++) {
+        const da_int k = static_cast<da_int>(std::round(y[i]));
+        Z[i + k * ldz] -= w ? w[i] : T(1);
+    }
+}
+
+template float softmax_logloss<float>(da_int nsamples, da_int nclass, const float *Z,
+                                      da_int ldz, const float *y, const float *w,
+                                      float *maxexp, float *sumexp);
+template double softmax_logloss<double>(da_int nsamples, da_int nclass, const double *Z,
+                                        da_int ldz, const double *y, const double *w,
+                                        double *maxexp, double *sumexp);
+template void softmax_residual<float>(da_int nsamples, da_int nclass, float *Z,
+                                      da_int ldz, const float *y, const float *w,
+                                      const float *maxexp, const float *sumexp);
+template void softmax_residual<double>(da_int nsamples, da_int nclass, double *Z,
+                                       da_int ldz, const double *y, const double *w,
+                                       const double *maxexp, const double *sumexp);
+
+} // namespace da_linmod
+
+} // namespace ARCH
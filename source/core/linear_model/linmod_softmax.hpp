@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef LINMOD_SOFTMAX_HPP
+#define LINMOD_SOFTMAX_HPP
+
+#include "aoclda_types.h"
+#include "macros.h"
+
+namespace ARCH {
+
+namespace da_linmod {
+
+/* Kernels of the multinomial logistic regression (symmetric side constraint).
+ * Z is the nsamples x nclass column-major matrix of logits X * B^T + b0 with leading
+ * dimension ldz, y holds the class labels and w the optional sample weights (nullptr
+ * if unweighted).
+ *
+ * softmax_logloss computes, for each sample, the row maximum and the sum of the shifted
+ * exponentials (log-sum-exp trick) into maxexp and sumexp, and returns the weighted
+ * negative log-likelihood sum_i w_i (maxexp_i + log(sumexp_i) - Z_{i,y_i}).
+ *
+ * softmax_residual overwrites Z in place with the pointwise gradients
+ * w_i (softmax(Z)_{ik} - [y_i == k]), using maxexp and sumexp from softmax_logloss, so
+ * that the gradient is X^T Z and no other nsamples x nclass array is needed.
+ *
+ * Both kernels are vectorized across samples with the kernel templates when the
+ * architecture supports AVX2 or AVX512.
+ */
+template <typename T>
+T softmax_logloss(da_int nsamples, da_int nclass, const T *Z, da_int ldz, const T *y,
+                  const T *w, T *maxexp, T *sumexp);
+
+template <typename T>
+void softmax_residual(da_int nsamples, da_int nclass, T *Z, da_int ldz, const T *y,
+                      const T *w, const T *maxexp, const T *sumexp);
+
+} // namespace da_linmod
+
+} // namespace ARCH
+
+#endif // LINMOD_SOFTMAX_HPP
@@ -0,0 +1,201 @@
+/* ************************************************************************
+ * Copyright (c) 2025 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "aoclda.h"
+#include "da_error.hpp"
+#include "da_qr.hpp"
+#include "lapack_templates.hpp"
+#include "linear_model.hpp"
+#include "macros.h"
+#include <cmath>
+#include <vector>
+
+namespace ARCH {
+
+namespace da_linmod {
+
+using namespace da_linmod_types;
+
+// Data for the streaming least squares solver
+template <typename T>
+stream_data<T>::stream_data(da_int nfeat) : nfeat(nfeat), m(nfeat + 1) {
+    mean.resize(m, T(0));
+    R.resize(m * m, T(0));
+}
+
+/* Center a block of rows of [ X | y ], reduce it to an m x m triangular factor and
+ * merge it into the running statistics.
+ */
+template <typename T>
+da_status stream_data<T>::add_block(da_order order, da_int nrows, const T *X, da_int ldx,
+                                    const T *y, da_errors::da_error_t *err) {
+    try {
+        block.resize(nrows * m);
+        block_mean.resize(m);
+    } catch (std::bad_alloc &) {                      // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+
+    // Copy into column-major storage, computing the block means in the same pass
+    const da_int rinc = order == column_major ? 1 : ldx;
+    const da_int cinc = order == column_major ? ldx : 1;
+    T *A = block.data();
+    T *mu = block_mean.data();
+    const da_int p = nfeat;
+#pragma omp parallel for schedule(static) default(none) shared(A, mu, X, y, nrows, p)   \
+    firstprivate(rinc, cinc)
+    for (da_int j = 0; j <= p; j++) {
+        T *col = &A[j * nrows];
+        T sum = T(0);
+        if (j < p) {
+            for (da_int i = 0; i < nrows; i++) {
+                col[i] = X[i * rinc + j * cinc];
+                sum += col[i];
+            }
+        } else {
+            for (da_int i = 0; i < nrows; i++) {
+                col[i] = y[i];
+                sum += col[i];
+            }
+        }
+        mu[j] = sum / T(nrows);
+#pragma omp simd
+        for (da_int i = 0; i < nrows; i++)
+            col[i] -= mu[j];
+    }
+
+    if (nrows <= m) {
+        // Short block, the centered rows are merged directly
+        return merge(nrows, mu, nrows, A, nrows, err);
+    }
+
+    // Tall block, reduce it with the blocked TSQR first
+    std::vector<T> tau_block, R_blocked, tau_R_blocked, Rb;
+    da_int n_blocks = 0, block_size = 0, final_block_size = 0;
+    da_status status = da_qr(nrows, m, block, nrows, tau_block, R_blocked, tau_R_blocked,
+                             Rb, n_blocks, block_size, final_block_size, false, err);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+
+    return merge(nrows, mu, m, Rb.data(), m, err);
+}
+
+/* Merge the statistics of nb rows (means mean_b and rb x m factor Rb of the centered
+ * rows) into the running statistics. The scatter matrix of the union is
+ *   R'R + Rb'Rb + n nb / (n + nb) (mean - mean_b)(mean - mean_b)'
+ * so the new factor is the triangular factor of the stacked matrix [ R; Rb; c' ].
+ */
+template <typename T>
+da_status stream_data<T>::merge(da_int nb, const T *mean_b, da_int rb, const T *Rb,
+                                da_int ldrb, da_errors::da_error_t *err) {
+    da_int ns = m + rb + 1;
+    try {
+        stack.assign(ns * m, T(0));
+        tau.resize(m);
+    } catch (std::bad_alloc &) {                      // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    const T total = T(n) + T(nb);
+    const T c = std::sqrt(T(n) * T(nb) / total);
+    for (da_int j = 0; j < m; j++) {
+        for (da_int i = 0; i <= j; i++)
+            stack[i + j * ns] = R[i + j * m];
+        for (da_int i = 0; i < rb; i++)
+            stack[m + i + j * ns] = Rb[i + j * ldrb];
+        stack[ns - 1 + j * ns] = c * (mean[j] - mean_b[j]);
+    }
+
+    da_status status = reduce_stack(ns, R.data(), err);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+
+    for (da_int j = 0; j < m; j++)
+        mean[j] = (T(n) * mean[j] + T(nb) * mean_b[j]) / total;
+    n += nb;
+    return da_status_success;
+}
+
+/* QR factorization of the ns x m matrix held in stack, the upper triangle of the
+ * factor is copied into Rdst (leading dimension m).
+ */
+template <typename T>
+da_status stream_data<T>::reduce_stack(da_int ns, T *Rdst, da_errors::da_error_t *err) {
+    da_int lwork = -1, info = 0;
+    T query[1];
+    da::geqrf(&ns, &m, stack.data(), &ns, tau.data(), query, &lwork, &info);
+    lwork = std::max((da_int)query[0], da_int(1));
+    try {
+        work.resize(lwork);
+    } catch (std::bad_alloc &) {                      // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    da::geqrf(&ns, &m, stack.data(), &ns, tau.data(), work.data(), &lwork, &info);
+    if (info != 0)
+        return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "An internal error occurred while merging a data block. Please "
+                        "check the input data for undefined values.");
+
+    for (da_int j = 0; j < m; j++)
+        for (da_int i = 0; i <= j; i++)
+            Rdst[i + j * m] = stack[i + j * ns];
+    return da_status_success;
+}
+
+/* Triangular factor of [ X | y ]. The uncentered factor is the triangular factor of
+ * [ R; sqrt(n) mean' ] since X'X = Xc'Xc + n mean mean'.
+ */
+template <typename T>
+da_status stream_data<T>::factor(bool centered, std::vector<T> &Rout,
+                                 da_errors::da_error_t *err) {
+    da_int ns = m + 1;
+    try {
+        Rout.assign(R.begin(), R.end());
+        if (!centered) {
+            stack.assign(ns * m, T(0));
+            tau.resize(m);
+        }
+    } catch (std::bad_alloc &) {                      // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    if (centered)
+        return da_status_success;
+
+    const T c = std::sqrt(T(n));
+    for (da_int j = 0; j < m; j++) {
+        for (da_int i = 0; i <= j; i++)
+            stack[i + j * ns] = R[i + j * m];
+        stack[m + j * ns] = c * mean[j];
+    }
+    return reduce_stack(ns, Rout.data(), err);
+}
+
+template struct stream_data<float>;
+template struct stream_data<double>;
+
+} // namespace da_linmod
+
+} // namespace ARCH
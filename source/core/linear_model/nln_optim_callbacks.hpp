@@ -58,6 +58,9 @@ template <class T> class usrdata_base {
     // Intercept
     bool intercept = false;
 
+    // Optional sample weights of size nsamples (nullptr if unweighted)
+    const T *w = nullptr;
+
     // Additional parameters that enhance the model
 
     // Regularization
@@ -89,9 +92,12 @@ template <class T> class cb_usrdata_logreg : public usrdata_base<T> {
      * maxexp[nsamples]: used to store the maximum values of each X_k beta_k (k as class index) for the logsumexp trick
      * sumexp[nsamples]: used to store the sum of the exponents of each X_k beta_k (k as class index) for the logsumexp trick
      * lincomb[nsamples*(nclass-1) OR nsamples*nclass]: used to store all the X_k beta_k values
-     * gradients_p[nsamples*(nclass-1) OR nsamples*nclass]: used to store all the pointwise gradients
+     * gradients_p[nsamples*(nclass-1)]: used to store all the pointwise gradients, not
+     *     allocated for the symmetric side constraint where they overwrite lincomb
      */
     std::vector<T> maxexp, sumexp, lincomb, gradients_p;
+    // lincomb holds the pointwise gradients instead of the logits (symmetric side)
+    bool lincomb_residual = false;
 
     cb_usrdata_logreg(da_order order, const T *X, da_int ldX, const T *y, da_int nsamples,
                       da_int nfeat, bool intercept, T lambda, T alpha, da_int nclass,
@@ -198,6 +204,7 @@ template <typename T> da_int objfun_mse(da_int n, T *x, T *loss, void *udata);
  *  * l2reg regularization penalty associated with L2
  *  * y[nsamples] nullptr is no observations provided, otherwise a vector of
  *    nsamples observations
+ *  * w[nsamples] optional sample weights used in the loss, nullptr if unweighted
  *
  * Output
  *  * loss value of the loss for the predictions given the y observations or
@@ -209,7 +216,7 @@ template <typename T> da_int objfun_mse(da_int n, T *x, T *loss, void *udata);
 template <typename T>
 da_int loss_mse(da_order order, da_int nsamples, da_int nfeat, const T *X, da_int ldX,
                 bool intercept, T l1reg, T l2reg, const T *coef, const T *y, T *loss,
-                T *pred);
+                T *pred, const T *w = nullptr);
 
 /* Mean square error callbacks (gradient)
  * The MSE loss objective gradient is
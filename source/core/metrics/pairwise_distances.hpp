@@ -83,6 +83,19 @@ template <typename T>
 da_status inner_product(da_order order, da_int m, da_int n, da_int k, const T *X,
                         da_int ldx, const T *Y, da_int ldy, T *D, da_int ldd);
 
+// Reductions of the distance matrix that never store it in full.
+// For each row of X, the indices and distances of the n_neigh nearest rows of Y.
+template <typename T>
+da_status pairwise_argkmin(da_order order, da_int m, da_int n, da_int k, const T *X,
+                           da_int ldx, const T *Y, da_int ldy, da_int n_neigh,
+                           da_int *ind, T *dist, T p, da_metric metric);
+
+// For each row of X, the number of rows of Y within distance radius.
+template <typename T>
+da_status pairwise_radius_count(da_order order, da_int m, da_int n, da_int k, const T *X,
+                                da_int ldx, const T *Y, da_int ldy, T radius,
+                                da_int *counts, T p, da_metric metric);
+
 } // namespace pairwise_distances
 } // namespace da_metrics
 } // namespace ARCH
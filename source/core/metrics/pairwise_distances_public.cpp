@@ -48,4 +48,61 @@ template da_status da_pairwise_distances<float>(da_order, da_int, da_int, da_int
 template da_status da_pairwise_distances<double>(da_order, da_int, da_int, da_int,
                                                  const double *, da_int, const double *,
                                                  da_int, double *, da_int, double,
-                                                 da_metric);
\ No newline at end of file
+                                                 da_metric);
+template <typename T>
+da_status da_pairwise_distances_argmin(da_order order, da_int m, da_int n, da_int k,
+                                       const T *X, da_int ldx, const T *Y, da_int ldy,
+                                       da_int *ind, T *dist, T p, da_metric metric) {
+    DISPATCHER(nosave_metric,
+               return (da_metrics::pairwise_distances::pairwise_argkmin(
+                   order, m, n, k, X, ldx, Y, ldy, (da_int)1, ind, dist, p, metric)));
+}
+
+template <typename T>
+da_status da_pairwise_distances_argkmin(da_order order, da_int m, da_int n, da_int k,
+                                        const T *X, da_int ldx, const T *Y, da_int ldy,
+                                        da_int n_neigh, da_int *ind, T *dist, T p,
+                                        da_metric metric) {
+    DISPATCHER(nosave_metric,
+               return (da_metrics::pairwise_distances::pairwise_argkmin(
+                   order, m, n, k, X, ldx, Y, ldy, n_neigh, ind, dist, p, metric)));
+}
+
+template <typename T>
+da_status da_pairwise_distances_radius_count(da_order order, da_int m, da_int n,
+                                             da_int k, const T *X, da_int ldx, const T *Y,
+                                             da_int ldy, T radius, da_int *counts, T p,
+                                             da_metric metric) {
+    DISPATCHER(nosave_metric,
+               return (da_metrics::pairwise_distances::pairwise_radius_count(
+                   order, m, n, k, X, ldx, Y, ldy, radius, counts, p, metric)));
+}
+
+template da_status da_pairwise_distances_argmin<float>(da_order, da_int, da_int, da_int,
+                                                       const float *, da_int,
+                                                       const float *, da_int, da_int *,
+                                                       float *, float, da_metric);
+template da_status da_pairwise_distances_argmin<double>(da_order, da_int, da_int, da_int,
+                                                        const double *, da_int,
+                                                        const double *, da_int, da_int *,
+                                                        double *, double, da_metric);
+template da_status da_pairwise_distances_argkmin<float>(da_order, da_int, da_int, da_int,
+                                                        const float *, da_int,
+                                                        const float *, da_int, da_int,
+                                                        da_int *, float *, float,
+                                                        da_metric);
+template da_status da_pairwise_distances_argkmin<double>(da_order, da_int, da_int, da_int,
+                                                         const double *, da_int,
+                                                         const double *, da_int, da_int,
+                                                         da_int *, double *, double,
+                                                         da_metric);
+template da_status da_pairwise_distances_radius_count<float>(da_order, da_int, da_int,
+                                                             da_int, const float *,
+                                                             da_int, const float *,
+                                                             da_int, float, da_int *,
+                                                             float, da_metric);
+template da_status da_pairwise_distances_radius_count<double>(da_order, da_int, da_int,
+                                                              da_int, const double *,
+                                                              da_int, const double *,
+                                                              da_int, double, da_int *,
+                                                              double, da_metric);
@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "aoclda.h"
+#include "da_omp.hpp"
+#include "da_simd_math.hpp"
+#include "da_utils.hpp"
+#include "nearest_neighbors_utils.hpp"
+#include "pairwise_distances.hpp"
+#include <type_traits>
+#include <vector>
+
+// Maximum number of rows of X and Y in one tile of the distance matrix
+#define PAIRWISE_REDUCTION_BLOCK_X 256
+#define PAIRWISE_REDUCTION_BLOCK_Y_FLOAT 512
+#define PAIRWISE_REDUCTION_BLOCK_Y_DOUBLE 256
+
+namespace ARCH {
+namespace da_metrics {
+namespace pairwise_distances {
+
+/*
+Checks shared by the pairwise distance reductions. If Y is null it is replaced by X.
+*/
+template <typename T>
+static da_status check_reduction_input(da_order order, da_int m, da_int &n, da_int k,
+                                       const T *X, da_int ldx, const T *&Y, da_int &ldy,
+                                       T p, da_metric metric) {
+    if (m < 1 || k < 1)
+        return da_status_invalid_array_dimension;
+    if (order == column_major && ldx < m)
+        return da_status_invalid_leading_dimension;
+    if (order == row_major && ldx < k)
+        return da_status_invalid_leading_dimension;
+    if (X == nullptr)
+        return da_status_invalid_pointer;
+    if (Y != nullptr) {
+        if (n < 1)
+            return da_status_invalid_array_dimension;
+        if ((order == column_major && ldy < n) || (order == row_major && ldy < k))
+            return da_status_invalid_leading_dimension;
+    } else {
+        Y = X;
+        ldy = ldx;
+        n = m;
+    }
+    switch (metric) {
+    case da_euclidean:
+    case da_sqeuclidean:
+    case da_manhattan:
+    case da_cosine:
+    case da_euclidean_gemm:
+    case da_sqeuclidean_gemm:
+    case da_inner_product:
+        break;
+    case da_minkowski:
+        if (p <= 0)
+            return da_status_invalid_input;
+        break;
+    default:
+        return da_status_not_implemented;
+    }
+    return da_status_success;
+}
+
+/*
+Blocked driver for the pairwise distance reductions.
+Blocks of rows of X are shared between the threads. For every block of rows of Y, the
+distances between the two blocks are computed into a thread-private tile, laid out so that
+the distances from one row of X are contiguous, and passed to reduce(i, j0, n_j, d), which
+folds the distances d[0:n_j] between row i of X and rows j0, ..., j0 + n_j - 1 of Y into
+the state of row i. Each row of X is only ever seen by one thread, so reduce needs no
+synchronization, and the full m x n distance matrix is never stored.
+*/
+template <typename T, typename Reduce>
+static da_status reduce_pairwise_distances(da_order order, da_int m, da_int n, da_int k,
+                                           const T *X, da_int ldx, const T *Y, da_int ldy,
+                                           T p, da_metric metric, Reduce &reduce) {
+    da_int y_block_max = std::is_same_v<T, float> ? PAIRWISE_REDUCTION_BLOCK_Y_FLOAT
+                                                  : PAIRWISE_REDUCTION_BLOCK_Y_DOUBLE;
+    // Use smaller blocks of X if needed so that every thread gets some work
+    da_int max_threads = da_utils::get_n_threads_loop(m);
+    da_int x_block_size = std::min((da_int)PAIRWISE_REDUCTION_BLOCK_X,
+                                   (m + max_threads - 1) / max_threads);
+    da_int y_block_size = std::min(y_block_max, n);
+    da_int x_n_blocks = 0, x_block_rem = 0, y_n_blocks = 0, y_block_rem = 0;
+    da_utils::blocking_scheme(m, x_block_size, x_n_blocks, x_block_rem);
+    da_utils::blocking_scheme(n, y_block_size, y_n_blocks, y_block_rem);
+    da_int n_threads = da_utils::get_n_threads_loop(x_n_blocks);
+
+    da_int ldd = y_block_size;
+    da_int tile_size = x_block_size * y_block_size;
+    std::vector<T> D;
+    try {
+        D.resize(n_threads * tile_size);
+    } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+        return da_status_memory_error; // LCOV_EXCL_LINE
+    }
+    T *D_ptr = D.data();
+    da_int threading_error = 0;
+    // GEMM-based distances are computed squared and clamped before the square root
+    // since cancellation can make them slightly negative, e.g. between a row and itself
+    da_metric tile_metric = (metric == da_euclidean_gemm) ? da_sqeuclidean_gemm : metric;
+
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads) default(none)          \
+    shared(order, k, X, ldx, Y, ldy, p, metric, tile_metric, reduce, x_block_size,       \
+               x_n_blocks, x_block_rem, y_block_size, y_n_blocks, y_block_rem, ldd,       \
+               tile_size, D_ptr, threading_error)
+    for (da_int i = 0; i < x_n_blocks; i++) {
+        da_int local_error;
+#pragma omp atomic read
+        local_error = threading_error;
+        if (local_error != 0)
+            continue;
+        T *this_D = D_ptr + omp_get_thread_num() * tile_size;
+        da_int x_start = i * x_block_size;
+        da_int x_size =
+            (i == x_n_blocks - 1 && x_block_rem > 0) ? x_block_rem : x_block_size;
+        const T *X_block = (order == column_major) ? X + x_start : X + x_start * ldx;
+        for (da_int j = 0; j < y_n_blocks; j++) {
+            da_int y_start = j * y_block_size;
+            da_int y_size =
+                (j == y_n_blocks - 1 && y_block_rem > 0) ? y_block_rem : y_block_size;
+            const T *Y_block = (order == column_major) ? Y + y_start : Y + y_start * ldy;
+            // Lay out the tile so that the distances from one row of X are contiguous
+            da_status thd_status;
+            if (order == column_major) {
+                thd_status = pairwise_distance_kernel(column_major, y_size, x_size, k,
+                                                      Y_block, ldy, X_block, ldx, this_D,
+                                                      ldd, p, tile_metric);
+            } else {
+                thd_status = pairwise_distance_kernel(row_major, x_size, y_size, k,
+                                                      X_block, ldx, Y_block, ldy, this_D,
+                                                      ldd, p, tile_metric);
+            }
+            if (thd_status != da_status_success) {
+#pragma omp atomic write
+                threading_error = 1;
+                break;
+            }
+            if (metric == da_sqeuclidean_gemm)
+                da_simd_math::clamp_nonneg_matrix(y_size, x_size, this_D, ldd);
+            else if (metric == da_euclidean_gemm)
+                da_simd_math::sqrt_clamp_matrix(y_size, x_size, this_D, ldd);
+            for (da_int ii = 0; ii < x_size; ii++)
+                reduce(x_start + ii, y_start, y_size, this_D + ii * ldd);
+        }
+    }
+    if (threading_error != 0)
+        return da_status_memory_error; // LCOV_EXCL_LINE
+    return da_status_success;
+}
+
+/*
+For each row of X, the indices and distances of its n_neigh nearest rows of Y (largest
+inner products for da_inner_product), sorted from nearest to furthest.
+*/
+template <typename T>
+da_status pairwise_argkmin(da_order order, da_int m, da_int n, da_int k, const T *X,
+                           da_int ldx, const T *Y, da_int ldy, da_int n_neigh,
+                           da_int *ind, T *dist, T p, da_metric metric) {
+    da_status status = check_reduction_input(order, m, n, k, X, ldx, Y, ldy, p, metric);
+    if (status != da_status_success)
+        return status;
+    if (n_neigh < 1 || n_neigh > n)
+        return da_status_invalid_input;
+    if (ind == nullptr)
+        return da_status_invalid_pointer;
+
+    bool largest = (metric == da_inner_product);
+    std::vector<da_int> k_ind, count, perm, row_ind;
+    std::vector<T> k_dist, row_dist;
+    try {
+        k_ind.resize(m * n_neigh);
+        k_dist.resize(m * n_neigh);
+        count.resize(m, 0);
+        perm.resize(n_neigh);
+        row_ind.resize(n_neigh);
+        row_dist.resize(n_neigh);
+    } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+        return da_status_memory_error; // LCOV_EXCL_LINE
+    }
+
+    // Keep the n_neigh best candidates of each row of X, unsorted
+    auto reduce = [&k_ind, &k_dist, &count, n_neigh, largest](da_int i, da_int j0,
+                                                               da_int n_j, const T *d) {
+        da_int *i_ind = k_ind.data() + i * n_neigh;
+        T *i_dist = k_dist.data() + i * n_neigh;
+        da_int &i_count = count[i];
+        da_int jj = 0;
+        for (; jj < n_j && i_count < n_neigh; jj++, i_count++) {
+            i_ind[i_count] = j0 + jj;
+            i_dist[i_count] = d[jj];
+        }
+        if (jj < n_j) {
+            if (largest)
+                da_neighbors::larger_values_and_indices_vectorized(
+                    n_j - jj, d + jj, n_neigh, i_ind, i_dist, j0 + jj);
+            else
+                da_neighbors::smaller_values_and_indices_vectorized(
+                    n_j - jj, d + jj, n_neigh, i_ind, i_dist, j0 + jj);
+        }
+    };
+    status = reduce_pairwise_distances(order, m, n, k, X, ldx, Y, ldy, p, metric, reduce);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+
+    for (da_int i = 0; i < m; i++) {
+        da_neighbors::sorted_n_dist_n_ind(n_neigh, k_dist.data() + i * n_neigh,
+                                          k_ind.data() + i * n_neigh, row_dist.data(),
+                                          row_ind.data(), perm.data(), true, false,
+                                          !largest);
+        for (da_int r = 0; r < n_neigh; r++) {
+            da_int idx = (order == column_major) ? i + r * m : i * n_neigh + r;
+            ind[idx] = row_ind[r];
+            if (dist != nullptr)
+                dist[idx] = row_dist[r];
+        }
+    }
+    return da_status_success;
+}
+
+/*
+For each row of X, the number of rows of Y within distance radius (with inner product at
+least radius for da_inner_product).
+*/
+template <typename T>
+da_status pairwise_radius_count(da_order order, da_int m, da_int n, da_int k, const T *X,
+                                da_int ldx, const T *Y, da_int ldy, T radius,
+                                da_int *counts, T p, da_metric metric) {
+    da_status status = check_reduction_input(order, m, n, k, X, ldx, Y, ldy, p, metric);
+    if (status != da_status_success)
+        return status;
+    if (counts == nullptr)
+        return da_status_invalid_pointer;
+
+    for (da_int i = 0; i < m; i++)
+        counts[i] = 0;
+    bool largest = (metric == da_inner_product);
+    auto reduce = [counts, radius, largest](da_int i, [[maybe_unused]] da_int j0,
+                                            da_int n_j, const T *d) {
+        da_int i_count = 0;
+        if (largest) {
+            for (da_int jj = 0; jj < n_j; jj++)
+                i_count += (d[jj] >= radius);
+        } else {
+            for (da_int jj = 0; jj < n_j; jj++)
+                i_count += (d[jj] <= radius);
+        }
+        counts[i] += i_count;
+    };
+    return reduce_pairwise_distances(order, m, n, k, X, ldx, Y, ldy, p, metric, reduce);
+}
+
+template da_status pairwise_argkmin<float>(da_order order, da_int m, da_int n, da_int k,
+                                           const float *X, da_int ldx, const float *Y,
+                                           da_int ldy, da_int n_neigh, da_int *ind,
+                                           float *dist, float p, da_metric metric);
+template da_status pairwise_argkmin<double>(da_order order, da_int m, da_int n, da_int k,
+                                            const double *X, da_int ldx, const double *Y,
+                                            da_int ldy, da_int n_neigh, da_int *ind,
+                                            double *dist, double p, da_metric metric);
+
+template da_status pairwise_radius_count<float>(da_order order, da_int m, da_int n,
+                                                da_int k, const float *X, da_int ldx,
+                                                const float *Y, da_int ldy, float radius,
+                                                da_int *counts, float p,
+                                                da_metric metric);
+template da_status pairwise_radius_count<double>(da_order order, da_int m, da_int n,
+                                                 da_int k, const double *X, da_int ldx,
+                                                 const double *Y, da_int ldy,
+                                                 double radius, da_int *counts, double p,
+                                                 da_metric metric);
+
+} // namespace pairwise_distances
+} // namespace da_metrics
+} // namespace ARCH
@@ -307,6 +307,9 @@ template <typename T> da_status neighbors<T>::set_params() {
     opt_pass &= this->opts.get("minkowski parameter", p) == da_status_success;
     opt_pass &= this->opts.get("leaf size", leaf_size) == da_status_success;
     opt_pass &= this->opts.get("radius", radius) == da_status_success;
+    opt_pass &= this->opts.get("storage precision", opt_val, storage_precision) ==
+                da_status_success;
+    opt_pass &= this->opts.get("rerank factor", rerank_factor) == da_status_success;
 
     if (!opt_pass)
         return da_error_bypass(this->err, da_status_internal_error, // LCOV_EXCL_LINE
@@ -331,6 +334,10 @@ template <typename T> da_status neighbors<T>::set_params() {
             return da_error(this->err, da_status_incompatible_options,
                             "Tree algorithms are not compatible with the Minkowski "
                             "metric when 0 < p < 1.");
+        } else if (storage_precision != da_neighbors_types::full_precision) {
+            return da_error(this->err, da_status_incompatible_options,
+                            "Reduced precision storage of the training data is only "
+                            "available with the brute-force algorithm.");
         }
     }
 
@@ -355,8 +362,9 @@ template <typename T> da_status neighbors<T>::set_params() {
 template <typename T> void neighbors<T>::set_neighbors_algorithm() {
     if ((this->metric == da_cosine) || (this->metric == da_sqeuclidean) ||
         (this->metric == da_minkowski && this->p < (T)1.0) ||
-        (this->metric == da_sqeuclidean_gemm) ||
-        (this->metric == da_inner_product)) { // LCOV_EXCL_LINE
+        (this->metric == da_sqeuclidean_gemm) || (this->metric == da_inner_product) ||
+        (this->storage_precision !=
+         da_neighbors_types::full_precision)) { // LCOV_EXCL_LINE
         this->working_algo = da_neighbors_types::nn_algorithm::brute;
     } else {
         // If the number of features is small and the number of samples is large, use k-d tree
@@ -406,6 +414,21 @@ template <typename T> da_status neighbors<T>::check_options_update() {
     opt_pass &= this->opts.get("radius", radius) == da_status_success;
     opt_pass &= this->opts.get("outlier handling", opt_val, outlier_handling) ==
                 da_status_success;
+    opt_pass &= this->opts.get("rerank factor", rerank_factor) == da_status_success;
+    da_int local_storage_precision;
+    opt_pass &= this->opts.get("storage precision", opt_val, local_storage_precision) ==
+                da_status_success;
+    if (local_storage_precision != this->storage_precision) {
+        if (local_storage_precision != da_neighbors_types::full_precision &&
+            this->working_algo != da_neighbors_types::nn_algorithm::brute)
+            return da_error_bypass(
+                this->err, da_status_incompatible_options,
+                "Reduced precision storage of the training data is only available with "
+                "the brute-force algorithm.");
+        // The compressed copy is rebuilt with the new precision on first use
+        this->storage_precision = local_storage_precision;
+        X_train_compressed.clear();
+    }
     if (outlier_handling == da_neighbors_types::nn_outlier_handling::manual) {
         da_int local_manual_label;
         T local_manual_target;
@@ -465,6 +488,27 @@ template <typename T> da_status neighbors<T>::check_options_update() {
     return da_status_success;
 }
 
+// With a rerank factor of 0 the k-nearest neighbors only read the reduced precision copy,
+// so the transposed or loaded copy of the training data can be dropped. Data stored by
+// the user in column-major order are not copied and are left untouched.
+template <typename T> void neighbors<T>::release_working_precision() {
+    if (X_train_temp == nullptr && X_int.empty())
+        return;
+    delete[] (X_train_temp);
+    X_train_temp = nullptr;
+    X_int = std::vector<T>{};
+    X_train = nullptr;
+}
+
+template <typename T> da_status neighbors<T>::check_working_precision() {
+    if (X_train == nullptr)
+        return da_error(this->err, da_status_no_data,
+                        "The training data in working precision were released when the "
+                        "reduced precision copy was built with a rerank factor of 0. "
+                        "Set the training data again.");
+    return da_status_success;
+}
+
 // Set the training data (features)
 template <typename T>
 da_status neighbors<T>::set_data(da_int n_samples, da_int n_features, const T *X_train,
@@ -492,6 +536,7 @@ da_status neighbors<T>::set_data(da_int n_samples, da_int n_features, const T *X
     // Set internal parameters
     this->n_samples = n_samples;
     this->n_features = n_features;
+    X_train_compressed.clear();
 
     // Check if the option for k-d tree is set, in which case we need to initialize the
     // internal kd_tree object.
@@ -596,13 +641,18 @@ da_status neighbors<T>::kneighbors_compute_brute_force(da_int n_queries,
     da_int ldd = xtrain_block_size;
     da_int threading_error = 0;
 
+    // Blocks of the reduced precision training data are expanded in thread_Xtrain
+    bool compressed = X_train_compressed.is_set();
+
     // Per-thread storage for D matrices, k-nearest indices/distances, and counts
     std::vector<std::vector<T>> thread_D;
+    std::vector<std::vector<T>> thread_Xtrain;
     std::vector<std::vector<da_int>> thread_k_ind;
     std::vector<std::vector<T>> thread_k_dist;
     std::vector<std::vector<da_int>> thread_query_count;
     try {
         thread_D.resize(n_threads);
+        thread_Xtrain.resize(n_threads);
         thread_k_ind.resize(n_threads);
         thread_k_dist.resize(n_threads);
         thread_query_count.resize(n_threads);
@@ -614,14 +664,18 @@ da_status neighbors<T>::kneighbors_compute_brute_force(da_int n_queries,
         threading_error, xtrain_block_size, xtrain_block_rem, xtrain_n_blocks,           \
             xtest_block_size, xtest_block_rem, xtest_n_blocks, n_samples, n_queries,     \
             ldd, n_features, X_test, ldx_test, n_ind, n_dist, n_neigh, return_distance,  \
-            n_threads, thread_D, thread_k_ind, thread_k_dist, thread_query_count)
+            n_threads, thread_D, thread_k_ind, thread_k_dist, thread_query_count,        \
+            compressed, thread_Xtrain)
     {
         da_int this_thread = omp_get_thread_num();
         da_int local_error = 0;
         auto &this_D = thread_D[this_thread];
+        auto &this_Xtrain = thread_Xtrain[this_thread];
 
         try {
             this_D.resize(xtrain_block_size * xtest_block_size);
+            if (compressed)
+                this_Xtrain.resize(xtrain_block_size * n_features);
             thread_k_ind[this_thread].resize(n_queries * n_neigh);
             thread_k_dist[this_thread].resize(n_queries * n_neigh);
             thread_query_count[this_thread].resize(n_queries, 0);
@@ -643,13 +697,22 @@ da_status neighbors<T>::kneighbors_compute_brute_force(da_int n_queries,
                     if (i == xtrain_n_blocks - 1 && xtrain_block_rem > 0)
                         local_xtrain_size = xtrain_block_rem;
 
+                    const T *xtrain_block = X_train + i * xtrain_block_size;
+                    da_int ldx_block = ldx_train;
+                    if (compressed) {
+                        X_train_compressed.decompress(
+                            i * xtrain_block_size, local_xtrain_size, this_Xtrain.data(),
+                            xtrain_block_size);
+                        xtrain_block = this_Xtrain.data();
+                        ldx_block = xtrain_block_size;
+                    }
+
                     // Compute pairwise distances for this block pair
                     da_status thd_status =
                         da_metrics::pairwise_distances::pairwise_distance_kernel(
                             column_major, local_xtrain_size, local_xtest_size, n_features,
-                            X_train + i * xtrain_block_size, ldx_train,
-                            X_test + j * xtest_block_size, ldx_test, this_D.data(), ldd,
-                            this->p, this->internal_metric);
+                            xtrain_block, ldx_block, X_test + j * xtest_block_size,
+                            ldx_test, this_D.data(), ldd, this->p, this->internal_metric);
                     if (thd_status != da_status_success) {
 #pragma omp atomic write
                         threading_error = 1;
@@ -701,6 +764,7 @@ da_status neighbors<T>::kneighbors_compute_brute_force(da_int n_queries,
         }             // End of xtest blocks
 
         this_D = std::vector<T>{};
+        this_Xtrain = std::vector<T>{};
 
         if (n_threads == 1) {
             // Single-thread fast path: no merge needed, sort directly from thread 0
@@ -815,6 +879,74 @@ da_status neighbors<T>::kneighbors_compute_brute_force(da_int n_queries,
     return da_status_success;
 }
 
+// Re-rank candidate neighbors in working precision
+template <typename T>
+da_status neighbors<T>::kneighbors_rerank(da_int n_queries, da_int n_features,
+                                          const T *X_test, da_int ldx_test,
+                                          da_int *cand_ind, da_int n_cand,
+                                          da_int *n_ind, T *n_dist, da_int n_neigh,
+                                          bool return_distance) {
+    da_int n_threads = da_utils::get_n_threads_loop(n_queries);
+    da_int threading_error = 0;
+
+#pragma omp parallel num_threads(n_threads) default(none)                                \
+    shared(threading_error, n_queries, n_features, X_test, ldx_test, cand_ind, n_cand,   \
+               n_ind, n_dist, n_neigh, return_distance)
+    {
+        // Candidate rows of X_train, their distances to the query and sorting workspace
+        std::vector<T> X_cand, d_cand, sorted_dist;
+        std::vector<da_int> perm_vector, sorted_ind;
+        try {
+            X_cand.resize(n_cand * n_features);
+            d_cand.resize(n_cand);
+            sorted_dist.resize(n_cand);
+            perm_vector.resize(n_cand);
+            sorted_ind.resize(n_cand);
+        } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+#pragma omp atomic write
+            threading_error = 1; // LCOV_EXCL_LINE
+        }
+        da_int local_error;
+#pragma omp atomic read
+        local_error = threading_error;
+
+#pragma omp for schedule(static)
+        for (da_int q = 0; q < n_queries; q++) {
+            if (local_error != 0)
+                continue;
+            da_int *q_cand = cand_ind + q * n_cand;
+            for (da_int f = 0; f < n_features; f++)
+                for (da_int c = 0; c < n_cand; c++)
+                    X_cand[c + f * n_cand] = X_train[q_cand[c] + f * ldx_train];
+            da_status thd_status =
+                da_metrics::pairwise_distances::pairwise_distance_kernel(
+                    column_major, n_cand, 1, n_features, X_cand.data(), n_cand,
+                    X_test + q, ldx_test, d_cand.data(), n_cand, this->p,
+                    this->internal_metric);
+            if (thd_status != da_status_success) {
+#pragma omp atomic write
+                threading_error = 1; // LCOV_EXCL_LINE
+                continue;            // LCOV_EXCL_LINE
+            }
+            if (this->internal_metric == da_sqeuclidean_gemm)
+                da_simd_math::clamp_nonneg_matrix(n_cand, 1, d_cand.data(), n_cand);
+            sorted_n_dist_n_ind(n_cand, d_cand.data(), q_cand, sorted_dist.data(),
+                                sorted_ind.data(), perm_vector.data(), return_distance,
+                                get_squares, this->metric != da_inner_product);
+            for (da_int r = 0; r < n_neigh; r++) {
+                n_ind[q * n_neigh + r] = sorted_ind[r];
+                if (return_distance)
+                    n_dist[q * n_neigh + r] = sorted_dist[r];
+            }
+        }
+    }
+
+    if (threading_error != 0)
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    return da_status_success;
+}
+
 // Compute kernel for kd-tree algorithm
 template <typename T>
 da_status neighbors<T>::kneighbors_compute_kd_tree(da_int n_queries, da_int n_features,
@@ -908,9 +1040,60 @@ neighbors<T>::kneighbors_compute(da_int n_queries, da_int n_features, const T *X
                                  da_int n_neigh, bool return_distance) {
 
     if (this->working_algo == da_neighbors_types::nn_algorithm::brute) {
-        return neighbors<T>::kneighbors_compute_brute_force(n_queries, n_features, X_test,
-                                                            ldx_test, n_ind, n_dist,
-                                                            n_neigh, return_distance);
+        da_status status = da_status_success;
+        if (storage_precision == da_neighbors_types::full_precision ||
+            !X_train_compressed.is_set() || rerank_factor > 0) {
+            status = neighbors<T>::check_working_precision();
+            if (status != da_status_success)
+                return status;
+        }
+        if (storage_precision == da_neighbors_types::full_precision)
+            return neighbors<T>::kneighbors_compute_brute_force(
+                n_queries, n_features, X_test, ldx_test, n_ind, n_dist, n_neigh,
+                return_distance);
+
+        if (!X_train_compressed.is_set()) {
+            bool in_range = true;
+            try {
+                in_range = X_train_compressed.compress(storage_precision, n_samples,
+                                                       n_features, X_train, ldx_train);
+            } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+                return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                                "Memory allocation failed.");
+            }
+            if (!in_range)
+                return da_error(
+                    this->err, da_status_incompatible_options,
+                    "The training data contain values larger in magnitude than the "
+                    "largest half precision number, 65504. Set the storage precision "
+                    "option to bfloat16, int8 or working instead.");
+            if (rerank_factor == 0)
+                neighbors<T>::release_working_precision();
+        }
+        if (rerank_factor == 0)
+            return neighbors<T>::kneighbors_compute_brute_force(
+                n_queries, n_features, X_test, ldx_test, n_ind, n_dist, n_neigh,
+                return_distance);
+
+        // Retrieve more candidates than requested using the reduced precision data and
+        // keep the nearest ones according to the working precision distances
+        da_int n_cand = (n_neigh > n_samples / rerank_factor) ? n_samples
+                                                              : n_neigh * rerank_factor;
+        std::vector<da_int> cand_ind;
+        try {
+            cand_ind.resize(n_queries * n_cand);
+        } catch (std::bad_alloc const &) {                    // LCOV_EXCL_LINE
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+        status = neighbors<T>::kneighbors_compute_brute_force(
+            n_queries, n_features, X_test, ldx_test, cand_ind.data(), nullptr, n_cand,
+            false);
+        if (status != da_status_success)
+            return status; // LCOV_EXCL_LINE
+        return neighbors<T>::kneighbors_rerank(n_queries, n_features, X_test, ldx_test,
+                                               cand_ind.data(), n_cand, n_ind, n_dist,
+                                               n_neigh, return_distance);
     } else if (this->working_algo == da_neighbors_types::nn_algorithm::kd_tree) {
         return neighbors<T>::kneighbors_compute_kd_tree(n_queries, n_features, X_test,
                                                         ldx_test, n_ind, n_dist, n_neigh,
@@ -2005,7 +2188,9 @@ da_status neighbors<T>::radius_neighbors_compute(
         return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
                         "Memory allocation failed.");
     }
-    da_status status = da_status_success;
+    da_status status = neighbors<T>::check_working_precision();
+    if (status != da_status_success)
+        return status;
     if (this->working_algo == da_neighbors_types::nn_algorithm::brute) {
         status = neighbors<T>::radius_neighbors_compute_brute_force(
             n_queries, n_features, X_test, ldx_test, radius, rnn_indices, rnn_distances,
@@ -2378,8 +2563,24 @@ template <typename T> da_status neighbors<T>::serialize(serialization_buffer &bu
 
     if (buffer.get_mode() != deserialize) {
         // Model always transposes data to use column major
-        status = buffer.serialize_user_data(this->X_train, column_major, this->n_samples,
-                                            this->n_features, this->ldx_train);
+        const T *X_save = this->X_train;
+        da_int ldx_save = this->ldx_train;
+        std::vector<T> X_expanded;
+        if (X_save == nullptr) {
+            // Only the reduced precision copy is left, save it expanded
+            try {
+                X_expanded.resize(this->n_samples * this->n_features);
+            } catch (std::bad_alloc const &) {                    // LCOV_EXCL_LINE
+                return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                                "Memory allocation failed.");
+            }
+            X_train_compressed.decompress(0, this->n_samples, X_expanded.data(),
+                                          this->n_samples);
+            X_save = X_expanded.data();
+            ldx_save = this->n_samples;
+        }
+        status = buffer.serialize_user_data(X_save, column_major, this->n_samples,
+                                            this->n_features, ldx_save);
         if (status != da_status_success)
             return status;
         status = buffer.serialize_user_data(this->y_train_class, this->order,
@@ -2396,6 +2597,7 @@ template <typename T> da_status neighbors<T>::serialize(serialization_buffer &bu
         // Set X_train here as it might be needed for tree
         // deserialization below
         this->X_train = this->X_int.data();
+        X_train_compressed.clear();
 
         io_dispatch(this->y_train_class_int);
         io_dispatch(this->y_train_reg_int);
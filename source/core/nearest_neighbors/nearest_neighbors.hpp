@@ -25,6 +25,9 @@
  *
  */
 
+#ifndef NEAREST_NEIGHBORS_HPP
+#define NEAREST_NEIGHBORS_HPP
+
 #include "aoclda.h"
 #include "basic_handle.hpp"
 #include "binary_tree.hpp"
@@ -33,6 +36,7 @@
 #include "macros.h"
 #include "model_persistence.hpp"
 #include "nearest_neighbors_options.hpp"
+#include "nearest_neighbors_storage.hpp"
 
 namespace ARCH {
 
@@ -83,6 +87,10 @@ template <typename T> class neighbors : public basic_handle<T> {
     da_int weights = ::da_neighbors_types::nn_weights::uniform;
     // Outlier label handling for radius neighbors with no neighbors
     da_int outlier_handling = ::da_neighbors_types::nn_outlier_handling::none;
+    // Precision of the copy of the training data used by the brute-force kNN
+    da_int storage_precision = ::da_neighbors_types::full_precision;
+    // Number of candidates per neighbor re-ranked in working precision
+    da_int rerank_factor = 2;
     // User's data
     da_int n_samples = 0, n_features = 0, ldx_train = 0;
     const T *X_train = nullptr /*n_samples-by-n_features*/;
@@ -90,6 +98,8 @@ template <typename T> class neighbors : public basic_handle<T> {
     const T *y_train_reg = nullptr /*n_samples*/;
     // Utility pointer to column major allocated copy of user's data
     T *X_train_temp = nullptr;
+    // Reduced precision copy of the training data, built on first use
+    compressed_matrix<T> X_train_compressed;
     // Internal tree objects to be initialized only when that options is requested
     std::unique_ptr<ARCH::da_binary_tree::kd_tree<T>> internal_kd_tree = nullptr;
     std::unique_ptr<ARCH::da_binary_tree::ball_tree<T>> internal_ball_tree = nullptr;
@@ -125,6 +135,11 @@ template <typename T> class neighbors : public basic_handle<T> {
     da_status init_ball_tree();
     // Check if the options have been updated between calls
     da_status check_options_update();
+    // Free the copy of the training data in working precision owned by the handle once
+    // only the reduced precision copy is read
+    void release_working_precision();
+    // Check that the training data in working precision are still available
+    da_status check_working_precision();
     // Set the training data (features)
     da_status set_data(da_int n_samples, da_int n_features, const T *X_train,
                        da_int ldx_train);
@@ -148,6 +163,12 @@ template <typename T> class neighbors : public basic_handle<T> {
                                              const T *X_test, da_int ldx_test,
                                              da_int *n_ind, T *n_dist, da_int n_neigh,
                                              bool return_distance);
+    // Recompute the distances to the candidate neighbors in cand_ind in working precision
+    // and keep the n_neigh nearest ones
+    da_status kneighbors_rerank(da_int n_queries, da_int n_features, const T *X_test,
+                                da_int ldx_test, da_int *cand_ind, da_int n_cand,
+                                da_int *n_ind, T *n_dist, da_int n_neigh,
+                                bool return_distance);
     // Compute kernel for k-d tree algorithm
     da_status kneighbors_compute_kd_tree(da_int n_queries, da_int n_features,
                                          const T *X_test, da_int ldx_test, da_int *n_ind,
@@ -243,4 +264,6 @@ template <typename T> class neighbors : public basic_handle<T> {
 };
 
 } // namespace da_neighbors
-} // namespace ARCH
\ No newline at end of file
+} // namespace ARCH
+
+#endif // NEAREST_NEIGHBORS_HPP
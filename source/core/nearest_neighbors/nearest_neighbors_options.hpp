@@ -58,6 +58,14 @@ inline da_status register_neighbors_options(da_options::OptionRegistry &opts,
             "leaf size", "Leaf size for k-d tree.", 1, da_options::lbound_t::greaterequal,
             imax, da_options::ubound_t::p_inf, 30));
         opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "rerank factor",
+            "If the training data are stored in reduced precision, number of "
+            "candidates per requested neighbor that are re-ranked using the training "
+            "data in working precision. Set to 0 to return the reduced precision "
+            "results directly.",
+            0, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf, 2));
+        opts.register_opt(oi);
         oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
             "outlier label",
             "Classification label for queries with no neighbors within the specified "
@@ -122,6 +130,17 @@ inline da_status register_neighbors_options(da_options::OptionRegistry &opts,
              {"most frequent", da_neighbors_types::most_frequent}},
             "none"));
         opts.register_opt(os);
+        os = std::make_shared<OptionString>(OptionString(
+            "storage precision",
+            "Precision in which the training data are stored for the brute-force "
+            "k-nearest neighbors computation. Lower precisions reduce the memory "
+            "traffic at the expense of accuracy.",
+            {{"working", da_neighbors_types::full_precision},
+             {"half", da_neighbors_types::half_precision},
+             {"bfloat16", da_neighbors_types::bfloat16_precision},
+             {"int8", da_neighbors_types::int8_precision}},
+            "working"));
+        opts.register_opt(os);
     } catch (std::bad_alloc &) {
         return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
                         "Memory allocation failed.");
@@ -37,7 +37,10 @@ da_status nn_set_data(da_handle handle, da_int n_samples, da_int n_features,
                         "handle was not initialized with handle_type=da_handle_nn or "
                         "handle is invalid.");
 
-    return nn->set_data(n_samples, n_features, X_train, ldx_train);
+    da_status status = nn->set_data(n_samples, n_features, X_train, ldx_train);
+    if (status == da_status_success)
+        nn->datastore_data = std::vector<T>{};
+    return status;
 }
 
 template <typename neighbors_class, typename T>
@@ -48,7 +51,10 @@ da_status nn_set_labels(da_handle handle, da_int n_samples, const da_int *y_trai
                         "handle was not initialized with handle_type=da_handle_nn or "
                         "handle is invalid.");
 
-    return nn->set_labels(n_samples, y_train);
+    da_status status = nn->set_labels(n_samples, y_train);
+    if (status == da_status_success)
+        nn->datastore_labels = std::vector<da_int>{};
+    return status;
 }
 
 template <typename neighbors_class, typename T>
@@ -59,7 +65,10 @@ da_status nn_set_targets(da_handle handle, da_int n_samples, const T *y_train) {
                         "handle was not initialized with handle_type=da_handle_nn or "
                         "handle is invalid.");
 
-    return nn->set_targets(n_samples, y_train);
+    da_status status = nn->set_targets(n_samples, y_train);
+    if (status == da_status_success)
+        nn->datastore_response = std::vector<T>{};
+    return status;
 }
 
 template <typename neighbors_class, typename T>
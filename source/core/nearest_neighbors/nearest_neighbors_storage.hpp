@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef NN_STORAGE_HPP
+#define NN_STORAGE_HPP
+
+#include "aoclda.h"
+#include "fp16_helpers.hpp"
+#include "nearest_neighbors_types.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+#include <type_traits>
+#include <vector>
+
+namespace ARCH {
+namespace da_neighbors {
+
+// float -> bfloat16 bit pattern, round-to-nearest-even
+inline uint16_t f32_to_bf16_bits(float a) {
+    uint32_t fbits;
+    std::memcpy(&fbits, &a, sizeof(fbits));
+    if ((fbits & 0x7FFFFFFFu) > 0x7F800000u) // NaN, keep it quiet
+        return static_cast<uint16_t>((fbits >> 16) | 0x0040u);
+    fbits += 0x7FFFu + ((fbits >> 16) & 1u);
+    return static_cast<uint16_t>(fbits >> 16);
+}
+
+// bfloat16 bit pattern -> float
+inline float bf16_bits_to_f32(uint16_t a) {
+    uint32_t fbits = static_cast<uint32_t>(a) << 16;
+    float result;
+    std::memcpy(&result, &fbits, sizeof(result));
+    return result;
+}
+
+// half (binary16) bit pattern -> float, using masks instead of branches so that the
+// loop in f16_to_real can be vectorized when the F16C instructions are not available
+inline float f16_bits_to_f32_nobranch(uint16_t a) {
+    constexpr uint32_t shifted_exp = 0x7C00u << 13;
+    constexpr uint32_t magic_bits = 113u << 23;
+    uint32_t fbits = static_cast<uint32_t>(a & 0x7FFFu) << 13;
+    uint32_t exp = fbits & shifted_exp;
+    uint32_t inf_nan = 0u - static_cast<uint32_t>(exp == shifted_exp);
+    uint32_t subnormal = 0u - static_cast<uint32_t>(exp == 0u);
+    // Rebias the exponent, Inf and NaN keep an all ones exponent
+    fbits += ((127u - 15u) << 23) + (inf_nan & ((128u - 16u) << 23));
+    // Subnormal halves (and zero) are renormalized by subtracting 2^-14
+    uint32_t sub_bits = fbits + (1u << 23);
+    float sub, magic, result;
+    std::memcpy(&sub, &sub_bits, sizeof(sub));
+    std::memcpy(&magic, &magic_bits, sizeof(magic));
+    sub -= magic;
+    std::memcpy(&sub_bits, &sub, sizeof(sub));
+    fbits = (sub_bits & subnormal) | (fbits & ~subnormal);
+    fbits |= static_cast<uint32_t>(a & 0x8000u) << 16;
+    std::memcpy(&result, &fbits, sizeof(result));
+    return result;
+}
+
+// y[i] = x[i], i = 0, ..., n - 1, for half precision bit patterns x
+template <typename T> inline void f16_to_real(da_int n, const uint16_t *x, T *y) {
+    da_int i = 0;
+#if defined(__AVX512F__)
+    for (; i + 16 <= n; i += 16) {
+        __m512 v = _mm512_cvtph_ps(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i)));
+        if constexpr (std::is_same_v<T, float>) {
+            _mm512_storeu_ps(y + i, v);
+        } else {
+            __m256 hi = _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1));
+            _mm512_storeu_pd(y + i, _mm512_cvtps_pd(_mm512_castps512_ps256(v)));
+            _mm512_storeu_pd(y + i + 8, _mm512_cvtps_pd(hi));
+        }
+    }
+#elif defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+        __m256 v =
+            _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i)));
+        if constexpr (std::is_same_v<T, float>) {
+            _mm256_storeu_ps(y + i, v);
+        } else {
+            _mm256_storeu_pd(y + i, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+            _mm256_storeu_pd(y + i + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+        }
+    }
+#endif
+#pragma omp simd
+    for (da_int k = i; k < n; k++)
+        y[k] = static_cast<T>(f16_bits_to_f32_nobranch(x[k]));
+}
+
+/*
+Reduced-precision copy of a column-major n_rows x n_cols matrix, used to cut the memory
+traffic of brute-force distance computations on large training sets.
+Values are stored as IEEE half precision, bfloat16, or int8 with one symmetric scale per
+column (x ~ scale[j] * q with q in [-127, 127]). Blocks of rows are expanded back to T
+on demand, into buffers small enough to remain in cache.
+*/
+template <typename T> class compressed_matrix {
+  private:
+    da_int precision = da_neighbors_types::nn_storage_precision::full_precision;
+    da_int n_rows = 0, n_cols = 0;
+    std::vector<uint16_t> data_16;
+    std::vector<int8_t> data_8;
+    std::vector<T> scales;
+
+  public:
+    // Largest finite value representable in IEEE half precision
+    static constexpr float half_max = 65504.0f;
+
+    bool is_set() const {
+        return precision != da_neighbors_types::nn_storage_precision::full_precision;
+    }
+
+    void clear() {
+        precision = da_neighbors_types::nn_storage_precision::full_precision;
+        n_rows = 0;
+        n_cols = 0;
+        data_16 = std::vector<uint16_t>{};
+        data_8 = std::vector<int8_t>{};
+        scales = std::vector<T>{};
+    }
+
+    // Store A in the requested precision. Throws std::bad_alloc
+    // Returns false and stores nothing if half precision is requested and a finite entry of
+    // A lies outside its range, since it would otherwise be silently turned into inf
+    bool compress(da_int precision, da_int n_rows, da_int n_cols, const T *A,
+                  da_int lda) {
+        using namespace da_neighbors_types;
+        clear();
+        switch (precision) {
+        case nn_storage_precision::half_precision:
+            for (da_int j = 0; j < n_cols; j++)
+                for (da_int i = 0; i < n_rows; i++) {
+                    T a = std::abs(A[i + j * lda]);
+                    if (std::isfinite(a) && a > T(half_max))
+                        return false;
+                }
+            data_16.resize(n_rows * n_cols);
+            for (da_int j = 0; j < n_cols; j++)
+                for (da_int i = 0; i < n_rows; i++)
+                    data_16[i + j * n_rows] =
+                        da_fp16::f32_to_f16_bits(static_cast<float>(A[i + j * lda]));
+            break;
+        case nn_storage_precision::bfloat16_precision:
+            data_16.resize(n_rows * n_cols);
+            for (da_int j = 0; j < n_cols; j++)
+                for (da_int i = 0; i < n_rows; i++)
+                    data_16[i + j * n_rows] =
+                        f32_to_bf16_bits(static_cast<float>(A[i + j * lda]));
+            break;
+        case nn_storage_precision::int8_precision:
+            data_8.resize(n_rows * n_cols);
+            scales.resize(n_cols);
+            for (da_int j = 0; j < n_cols; j++) {
+                T amax = 0;
+                for (da_int i = 0; i < n_rows; i++)
+                    amax = std::max(amax, std::abs(A[i + j * lda]));
+                T scale = (amax > 0) ? amax / T(127) : T(1);
+                scales[j] = scale;
+                for (da_int i = 0; i < n_rows; i++) {
+                    T q = std::round(A[i + j * lda] / scale);
+                    data_8[i + j * n_rows] =
+                        static_cast<int8_t>(std::clamp(q, T(-127), T(127)));
+                }
+            }
+            break;
+        default:
+            return true;
+        }
+        this->precision = precision;
+        this->n_rows = n_rows;
+        this->n_cols = n_cols;
+        return true;
+    }
+
+    // Expand rows row_start, ..., row_start + n_block - 1 into the column-major
+    // n_block x n_cols matrix B
+    void decompress(da_int row_start, da_int n_block, T *B, da_int ldb) const {
+        using namespace da_neighbors_types;
+        switch (precision) {
+        case nn_storage_precision::half_precision:
+            for (da_int j = 0; j < n_cols; j++)
+                f16_to_real(n_block, data_16.data() + row_start + j * n_rows,
+                            B + j * ldb);
+            break;
+        case nn_storage_precision::bfloat16_precision:
+            for (da_int j = 0; j < n_cols; j++) {
+                const uint16_t *col = data_16.data() + row_start + j * n_rows;
+#pragma omp simd
+                for (da_int i = 0; i < n_block; i++)
+                    B[i + j * ldb] = static_cast<T>(bf16_bits_to_f32(col[i]));
+            }
+            break;
+        case nn_storage_precision::int8_precision:
+            for (da_int j = 0; j < n_cols; j++) {
+                const int8_t *col = data_8.data() + row_start + j * n_rows;
+                T scale = scales[j];
+#pragma omp simd
+                for (da_int i = 0; i < n_block; i++)
+                    B[i + j * ldb] = scale * static_cast<T>(col[i]);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+};
+
+} // namespace da_neighbors
+} // namespace ARCH
+
+#endif // NN_STORAGE_HPP
@@ -34,6 +34,13 @@ enum nn_outlier_handling { none = 0, manual, most_frequent };
 
 enum nn_check_region { pt_outside_eps = 0, pt_within_eps, region_within_eps };
 
+enum nn_storage_precision {
+    full_precision = 0,
+    half_precision,
+    bfloat16_precision,
+    int8_precision
+};
+
 } // namespace da_neighbors_types
 
 #endif // NEAREST_NEIGHBOR_TYPES_HPP
@@ -28,11 +28,16 @@
 #include "nlls.hpp"
 #include "aoclda.h"
 #include "da_error.hpp"
+#include "da_omp.hpp"
 #include "da_std.hpp"
 #include "macros.h"
 #include "options.hpp"
+#include "ralfit_driver.hpp"
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <utility>
 #include <vector>
@@ -83,6 +88,34 @@ da_status nlls<T>::define_callbacks(resfun_t<T> resfun, resgrd_t<T> resgrd,
     this->resgrd = resgrd;
     this->reshes = reshes;
     this->reshp = reshp;
+    // A multi-point residual function belongs to the previous model
+    this->resfun_multi = nullptr;
+    this->model_trained = false;
+
+    return da_status_success;
+}
+
+/* Store the multi-point residual function used to estimate derivatives */
+template <typename T> da_status nlls<T>::define_multi_callback(resfun_multi_t<T> resfun) {
+    if (!this->resfun)
+        return da_error(this->err, da_status_invalid_input,
+                        "No residual function defined, call da_nlls_define_residuals "
+                        "before defining the multi-point residual function.");
+    this->resfun_multi = resfun;
+    this->model_trained = false;
+
+    return da_status_success;
+}
+
+/* Store the batched user callbacks */
+template <typename T>
+da_status nlls<T>::define_batch_callbacks(resfun_batch_t<T> resfun,
+                                          resgrd_batch_t<T> resgrd) {
+    if (!resfun)
+        return da_error(this->err, da_status_invalid_input,
+                        "resfun must point to the batched residual function.");
+    this->resfun_batch = resfun;
+    this->resgrd_batch = resgrd;
     this->model_trained = false;
 
     return da_status_success;
@@ -91,6 +124,10 @@ da_status nlls<T>::define_callbacks(resfun_t<T> resfun, resgrd_t<T> resgrd,
 template <typename T> da_status nlls<T>::fit(da_int n_coef, T *coef, void *udata) {
 
     da_status status;
+    if (!this->resfun)
+        return da_error(this->err, da_status_invalid_input,
+                        "No residual function defined, call da_nlls_define_residuals "
+                        "before fitting the model.");
     // Copy the starting point
     if (n_coef != 0 && n_coef != this->nvar)
         return da_error(this->err, da_status_invalid_array_dimension,
@@ -139,6 +176,486 @@ template <typename T> da_status nlls<T>::fit(da_int n_coef, T *coef, void *udata
     return status;
 }
 
+/* Per-problem state passed to RALFit as the user data pointer of the batched
+ * trampolines below. RALFit only accepts plain function pointers, so the problem
+ * index and the user callbacks travel with the data.
+ */
+template <typename T> struct batch_data {
+    da_int problem;
+    const resfun_batch_t<T> *resfun;
+    const resgrd_batch_t<T> *resgrd;
+    void *udata;
+};
+
+template <typename T>
+da_int batch_resfun(da_int n_coef, da_int n_res, void *data, T const *x, T *res) {
+    batch_data<T> *bd = static_cast<batch_data<T> *>(data);
+    return (*bd->resfun)(bd->problem, n_coef, n_res, bd->udata, x, res);
+}
+
+template <typename T>
+da_int batch_resgrd(da_int n_coef, da_int n_res, void *data, T const *x, T *jac) {
+    batch_data<T> *bd = static_cast<batch_data<T> *>(data);
+    return (*bd->resgrd)(bd->problem, n_coef, n_res, bd->udata, x, jac);
+}
+
+/* Settings of the built-in Levenberg-Marquardt solver, read once from the handle
+ * options and shared by all the problems of a batch
+ */
+template <typename T> struct lm_settings {
+    da_int maxit;
+    T atolf, rtolf, atolg, rtolg, stol;
+    T sigma; // quadratic regularization term
+    T fd_step;
+    T bigbnd;
+    bool col_major;
+};
+
+// Largest model that "nlls batch solver = auto" gives to the built-in solver
+constexpr da_int lm_max_coef = 8;
+
+/* In-place Cholesky factorization of the n x n matrix whose lower triangle is stored
+ * row-wise in L. Returns false if the matrix is not numerically positive definite.
+ */
+template <typename T> bool lm_cholesky(da_int n, T *L) {
+    for (da_int j = 0; j < n; j++) {
+        T d = L[j * n + j];
+        for (da_int k = 0; k < j; k++)
+            d -= L[j * n + k] * L[j * n + k];
+        if (!(d > T(0)))
+            return false;
+        d = std::sqrt(d);
+        L[j * n + j] = d;
+        for (da_int i = j + 1; i < n; i++) {
+            T v = L[i * n + j];
+            for (da_int k = 0; k < j; k++)
+                v -= L[i * n + k] * L[j * n + k];
+            L[i * n + j] = v / d;
+        }
+    }
+    return true;
+}
+
+/* Minimize 1/2 ||W r(x)||^2 + sigma/2 ||x||^2 subject to lower <= x <= upper with a
+ * projected Levenberg-Marquardt method. Coefficients on a bound whose gradient points
+ * out of the feasible region are held fixed for the step, and the gradient tests use
+ * the projected gradient. It is meant for models with a handful of
+ * coefficients: the damped normal equations are formed explicitly and solved by a
+ * small Cholesky factorization, while the loops over the residuals, the only long
+ * ones, are unit stride for column-major Jacobians and vectorize.
+ * eval_r(x, r) and eval_J(x, J) return nonzero on failure. If has_J is false the
+ * Jacobian is estimated by forward differences. The stopping tests are those of
+ * RALFit, see the "ralfit convergence" options.
+ * work must hold 2*m + m*n + 2*n*n + 4*n entries.
+ */
+template <typename T, typename EvalR, typename EvalJ>
+da_status lm_solve(const lm_settings<T> &s, da_int n, da_int m, T *x, const T *lower,
+                   const T *upper, const T *w, EvalR &&eval_r, EvalJ &&eval_J,
+                   bool has_J, T *work, T *info, da_errors::da_error_t &err) {
+    T *r = work, *rt = r + m, *J = rt + m, *A = J + (size_t)m * n, *L = A + n * n;
+    T *g = L + n * n, *d = g + n, *xt = d + n, *fixed = xt + n;
+    // Column j of the Jacobian is J[j*jcol + i*jrow], i = 0, ..., m-1
+    const size_t jcol = s.col_major ? m : 1, jrow = s.col_major ? 1 : n;
+    const T eps = std::numeric_limits<T>::epsilon();
+    da_int nevalf{0}, nevalg{0}, nevalfd{0}, iter{0};
+
+    auto project = [&](T *v) {
+        for (da_int j = 0; j < n; j++) {
+            if (lower && lower[j] > -s.bigbnd)
+                v[j] = std::max(v[j], lower[j]);
+            if (upper && upper[j] < s.bigbnd)
+                v[j] = std::min(v[j], upper[j]);
+        }
+    };
+    // Objective at v with residuals rv, also returns ||W rv||
+    auto objective = [&](const T *v, const T *rv, T &normF) {
+        T ss{0}, xx{0};
+        for (da_int i = 0; i < m; i++) {
+            const T wr = w ? w[i] * rv[i] : rv[i];
+            ss += wr * wr;
+        }
+        for (da_int j = 0; j < n; j++)
+            xx += v[j] * v[j];
+        normF = std::sqrt(ss);
+        return T(0.5) * ss + T(0.5) * s.sigma * xx;
+    };
+    auto finish = [&](T f, T normg, T sclg) {
+        info[info_objective] = f;
+        info[info_grad_norm] = normg;
+        info[info_scl_grad_norm] = sclg;
+        info[info_iter] = T(iter);
+        info[info_nevalf] = T(nevalf);
+        info[info_nevalg] = T(nevalg);
+        info[info_nevalfd] = T(nevalfd);
+    };
+
+    project(x);
+    nevalf++;
+    if (eval_r(x, r) != 0)
+        return da_error(&err, da_status_operation_failed,
+                        "The residual function returned an error at the starting point.");
+    T normF, f = objective(x, r, normF);
+    if (!std::isfinite(f))
+        return da_error(&err, da_status_operation_failed,
+                        "The objective is not finite at the starting point.");
+    const T normF0 = normF;
+    T sclg0{-1}, mu{-1}, nu{2}, normg{0}, sclg{0};
+
+    while (true) {
+        da_int jstat;
+        if (has_J) {
+            nevalg++;
+            jstat = eval_J(x, J);
+        } else {
+            jstat = fd_jacobian(n, m, x, r, J, s.col_major, s.fd_step, lower, upper,
+                                da_int(1), eval_r, nevalfd);
+        }
+        if (jstat != 0) {
+            finish(f, normg, sclg);
+            if (!has_J && jstat == FD_NAN_ESTIMATE)
+                return da_warn(&err, da_status_numerical_difficulties,
+                               "Finite differences produced a NaN estimate of the "
+                               "Jacobian.");
+            return da_warn(&err, da_status_optimization_usrstop,
+                           "The Jacobian function returned an error.");
+        }
+
+        // Normal equations of the weighted problem, A = J' W^2 J in the lower
+        // triangle and g = J' W^2 r + sigma x, with rt holding W r
+        for (da_int i = 0; i < m; i++)
+            rt[i] = w ? w[i] * r[i] : r[i];
+        if (w) {
+            for (da_int j = 0; j < n; j++)
+                for (da_int i = 0; i < m; i++)
+                    J[j * jcol + i * jrow] *= w[i];
+        }
+        for (da_int j = 0; j < n; j++) {
+            const T *Jj = J + j * jcol;
+            T gj{0};
+            for (da_int i = 0; i < m; i++)
+                gj += Jj[i * jrow] * rt[i];
+            g[j] = gj + s.sigma * x[j];
+            for (da_int k = 0; k <= j; k++) {
+                const T *Jk = J + k * jcol;
+                T a{0};
+                for (da_int i = 0; i < m; i++)
+                    a += Jj[i * jrow] * Jk[i * jrow];
+                A[j * n + k] = a;
+            }
+        }
+
+        // Projected gradient: drop the components blocked by an active bound
+        normg = 0;
+        for (da_int j = 0; j < n; j++) {
+            const bool at_lower = lower && lower[j] > -s.bigbnd && x[j] <= lower[j];
+            const bool at_upper = upper && upper[j] < s.bigbnd && x[j] >= upper[j];
+            fixed[j] = (at_lower && g[j] > T(0)) || (at_upper && g[j] < T(0)) ? T(1)
+                                                                             : T(0);
+            if (fixed[j] == T(0))
+                normg += g[j] * g[j];
+        }
+        normg = std::sqrt(normg);
+        sclg = normF > T(0) ? normg / normF : T(0);
+        if (sclg0 < T(0))
+            sclg0 = sclg;
+        if (normF <= std::max(s.atolf, s.rtolf * normF0) ||
+            sclg <= std::max(s.atolg, s.rtolg * sclg0))
+            break;
+        if (iter >= s.maxit) {
+            finish(f, normg, sclg);
+            return da_warn(&err, da_status_maxit,
+                           "Iteration limit reached without converging to the requested "
+                           "tolerances.");
+        }
+        iter++;
+
+        T dmax{0};
+        for (da_int j = 0; j < n; j++)
+            dmax = std::max(dmax, A[j * n + j]);
+        const T dfloor = eps * std::max(T(1), dmax);
+        if (mu < T(0))
+            mu = T(1.0e-3);
+
+        // Increase the damping until the step decreases the objective
+        bool accepted{false}, converged{false};
+        while (!accepted) {
+            // The fixed coefficients are decoupled from the free ones and get d = 0
+            for (da_int j = 0; j < n; j++) {
+                for (da_int k = 0; k < j; k++)
+                    L[j * n + k] =
+                        fixed[j] == T(0) && fixed[k] == T(0) ? A[j * n + k] : T(0);
+                L[j * n + j] =
+                    fixed[j] == T(0)
+                        ? A[j * n + j] + s.sigma + mu * std::max(A[j * n + j], dfloor)
+                        : T(1);
+            }
+            bool spd = lm_cholesky(n, L);
+            T ft{0}, normFt{0};
+            if (spd) {
+                // Solve L L' d = -g
+                for (da_int j = 0; j < n; j++) {
+                    T v = fixed[j] == T(0) ? -g[j] : T(0);
+                    for (da_int k = 0; k < j; k++)
+                        v -= L[j * n + k] * d[k];
+                    d[j] = v / L[j * n + j];
+                }
+                for (da_int j = n - 1; j >= 0; j--) {
+                    T v = d[j];
+                    for (da_int k = j + 1; k < n; k++)
+                        v -= L[k * n + j] * d[k];
+                    d[j] = v / L[j * n + j];
+                }
+                T norms{0}, normx{0};
+                for (da_int j = 0; j < n; j++) {
+                    xt[j] = x[j] + d[j];
+                    normx += x[j] * x[j];
+                }
+                project(xt);
+                for (da_int j = 0; j < n; j++) {
+                    d[j] = xt[j] - x[j];
+                    norms += d[j] * d[j];
+                }
+                if (std::sqrt(norms) <= s.stol * std::max(T(1), std::sqrt(normx))) {
+                    converged = true;
+                    break;
+                }
+                nevalf++;
+                if (eval_r(xt, rt) != 0) {
+                    finish(f, normg, sclg);
+                    return da_warn(&err, da_status_optimization_usrstop,
+                                   "The residual function returned an error.");
+                }
+                ft = objective(xt, rt, normFt);
+                accepted = std::isfinite(ft) && ft < f;
+            }
+            if (accepted) {
+                // Predicted decrease of the quadratic model, used to update mu
+                T pred{0};
+                for (da_int j = 0; j < n; j++) {
+                    T Ad{s.sigma * d[j]};
+                    for (da_int k = 0; k < n; k++)
+                        Ad += (k <= j ? A[j * n + k] : A[k * n + j]) * d[k];
+                    pred -= d[j] * (g[j] + T(0.5) * Ad);
+                }
+                const T rho = pred > T(0) ? (f - ft) / pred : T(0);
+                const T c = T(2) * rho - T(1);
+                mu *= std::max(T(1) / T(3), T(1) - c * c * c);
+                nu = T(2);
+                std::copy(xt, xt + n, x);
+                std::copy(rt, rt + m, r);
+                f = ft;
+                normF = normFt;
+            } else {
+                mu *= nu;
+                nu *= T(2);
+                if (!(mu < T(1) / eps)) {
+                    finish(f, normg, sclg);
+                    return da_warn(&err, da_status_numerical_difficulties,
+                                   "Could not find a step that decreases the objective.");
+                }
+            }
+        }
+        if (converged)
+            break;
+    }
+
+    finish(f, normg, sclg);
+    return da_status_success;
+}
+
+/* Fit n_problems independent models that share the residual structure, options,
+ * bounds and weights defined in the handle. Problem p starts from and returns its
+ * coefficients in coef[p*n_coef:(p+1)*n_coef-1]. Each problem is solved by its own
+ * RALFit instance, or by lm_solve() for small models, and the problems are
+ * distributed over the OpenMP team, so the batched callbacks are called concurrently
+ * for different problem indices.
+ */
+template <typename T>
+da_status nlls<T>::fit_batch(da_int n_problems, da_int n_coef, T *coef,
+                             da_status *problem_status, void *udata) {
+    if (!this->resfun_batch)
+        return da_error(this->err, da_status_invalid_input,
+                        "No batched residual function defined, call "
+                        "da_nlls_define_residuals_batch before fitting the models.");
+    if (n_problems < 1)
+        return da_error(this->err, da_status_invalid_input,
+                        "n_problems must be positive.");
+    if (n_coef != this->nvar)
+        return da_error(this->err, da_status_invalid_array_dimension,
+                        "n_coef must match the number of defined coefficients, " +
+                            std::to_string(this->nvar) + ".");
+    if (!coef)
+        return da_error(this->err, da_status_invalid_pointer,
+                        "Pointer coef must be valid.");
+    if (this->locked)
+        return da_error(this->err, da_status_internal_error,
+                        "method fit_batch() was called within itself");
+
+    da_int solver;
+    std::string solvname;
+    if (this->opts.get("optim method", solvname, solver) != da_status_success)
+        return da_error(this->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "expected option not found: optim method");
+    if (solver != solver_ralfit)
+        return da_error(this->err, da_status_incompatible_options,
+                        "batched fits are only available with the RALFit solver.");
+
+    // Small models go to the built-in Levenberg-Marquardt solver by default, it
+    // avoids the setup of a full RALFit solve for each problem
+    da_int batch_solver, ireg_power;
+    std::string batch_name, reg_power;
+    if (this->opts.get("nlls batch solver", batch_name, batch_solver) !=
+            da_status_success ||
+        this->opts.get("regularization power", reg_power, ireg_power) !=
+            da_status_success)
+        return da_error(this->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "expected option not found: nlls batch solver");
+    lm_settings<T> lm;
+    std::pair<std::string, T *> lm_opts[]{{"ralfit convergence abs tol fun", &lm.atolf},
+                                          {"ralfit convergence rel tol fun", &lm.rtolf},
+                                          {"ralfit convergence abs tol grd", &lm.atolg},
+                                          {"ralfit convergence rel tol grd", &lm.rtolg},
+                                          {"ralfit convergence step size", &lm.stol},
+                                          {"regularization term", &lm.sigma},
+                                          {"finite differences step", &lm.fd_step},
+                                          {"infinite bound size", &lm.bigbnd}};
+    for (auto &opt : lm_opts)
+        if (this->opts.get(opt.first, *opt.second) != da_status_success)
+            return da_error(this->err, da_status_internal_error, // LCOV_EXCL_LINE
+                            "expected option not found: " + opt.first);
+    da_int istorage;
+    std::string storage;
+    if (this->opts.get("ralfit iteration limit", lm.maxit) != da_status_success ||
+        this->opts.get("storage order", storage, istorage) != da_status_success)
+        return da_error(this->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "expected option not found: ralfit iteration limit");
+    lm.col_major = istorage == column_major;
+    const bool lm_capable = lm.sigma == T(0) || ireg_power == quadratic;
+    if (batch_solver == batch_lm && !lm_capable)
+        return da_error(this->err, da_status_incompatible_options,
+                        "The levenberg-marquardt batch solver only supports quadratic "
+                        "regularization.");
+    const bool use_lm =
+        batch_solver == batch_lm ||
+        (batch_solver == batch_auto && lm_capable && n_coef <= lm_max_coef);
+    const size_t m = (size_t)this->nres;
+    const size_t lm_size = use_lm ? 2 * m + m * n_coef + (2 * n_coef + 4) * n_coef : 0;
+
+    // Per-problem results are not stored: with millions of small problems only the
+    // per-thread solver buffers and information counters are allocated.
+    const size_t ninfo = this->info.size();
+    const size_t nc = (size_t)n_coef;
+    const da_int n_threads = omp_get_max_threads();
+    std::vector<T> thread_info;
+    try {
+        thread_info.assign(ninfo * n_threads, T(0));
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+
+    this->locked = true;
+    const resfun_t<T> eval_r = batch_resfun<T>;
+    resgrd_t<T> eval_J = nullptr;
+    if (this->resgrd_batch)
+        eval_J = batch_resgrd<T>;
+
+    da_int n_failed{0}, n_usable{0}, first_failed{n_problems};
+    da_status first_status{da_status_success};
+    std::string first_mesg;
+
+#pragma omp parallel num_threads(n_threads) if (n_problems > 1)                          \
+    reduction(+ : n_failed, n_usable)
+    {
+        T *tinfo = &thread_info[ninfo * omp_get_thread_num()];
+        std::vector<T> x, pinfo, lm_work;
+        bool allocated{true};
+        try {
+            x.resize(nc);
+            pinfo.resize(ninfo);
+            lm_work.resize(lm_size);
+        } catch (std::bad_alloc &) { // LCOV_EXCL_LINE
+            allocated = false;       // LCOV_EXCL_LINE
+        }
+        da_errors::da_error_t err(da_errors::action_t::DA_RECORD);
+
+#pragma omp for schedule(dynamic)
+        for (da_int p = 0; p < n_problems; p++) {
+            da_status status{da_status_memory_error};
+            bool usable{false};
+            if (allocated) {
+                err.clear();
+                da_std::fill(pinfo.begin(), pinfo.end(), T(0));
+                std::copy(coef + p * nc, coef + (p + 1) * nc, x.begin());
+                if (use_lm) {
+                    auto lm_r = [&](const T *xp, T *rp) {
+                        return this->resfun_batch(p, n_coef, this->nres, udata, xp, rp);
+                    };
+                    auto lm_J = [&](const T *xp, T *Jp) {
+                        return this->resgrd_batch(p, n_coef, this->nres, udata, xp, Jp);
+                    };
+                    status = lm_solve(lm, n_coef, this->nres, x.data(), this->l_usrptr,
+                                      this->u_usrptr, this->w_usrptr, lm_r, lm_J,
+                                      bool(this->resgrd_batch), lm_work.data(),
+                                      pinfo.data(), err);
+                } else {
+                    batch_data<T> bd{p, &this->resfun_batch, &this->resgrd_batch, udata};
+                    status = ralfit::ralfit_driver(
+                        this->opts, n_coef, this->nres, x.data(), eval_r, eval_J, nullptr,
+                        nullptr, this->l_usrptr, this->u_usrptr, this->w_usrptr, &bd,
+                        pinfo, err);
+                }
+                // Warnings come with a valid iterate
+                usable = err.get_severity() != DA_ERROR;
+                for (auto idx : {info_objective, info_iter, info_nevalf, info_nevalg,
+                                 info_nevalh, info_nevalhp, info_nevalfd})
+                    tinfo[idx] += pinfo[idx];
+                for (auto idx : {info_grad_norm, info_scl_grad_norm})
+                    tinfo[idx] = std::max(tinfo[idx], pinfo[idx]);
+            }
+            if (usable) {
+                n_usable++;
+                std::copy(x.begin(), x.end(), coef + p * nc);
+            }
+            if (problem_status)
+                problem_status[p] = status;
+            if (status != da_status_success) {
+                n_failed++;
+#pragma omp critical
+                if (p < first_failed) {
+                    first_failed = p;
+                    first_status = status;
+                    first_mesg = allocated ? err.get_mesg() : "Memory allocation error";
+                }
+            }
+        }
+    }
+    this->locked = false;
+
+    // Merge the counters of all the threads
+    da_std::fill(this->info.begin(), this->info.end(), T(0));
+    for (da_int t = 0; t < n_threads; t++) {
+        const T *tinfo = &thread_info[ninfo * t];
+        for (auto idx : {info_objective, info_iter, info_nevalf, info_nevalg, info_nevalh,
+                         info_nevalhp, info_nevalfd})
+            this->info[idx] += tinfo[idx];
+        for (auto idx : {info_grad_norm, info_scl_grad_norm})
+            this->info[idx] = std::max(this->info[idx], tinfo[idx]);
+    }
+
+    this->model_trained = n_usable > 0;
+    if (n_failed == 0)
+        return da_status_success;
+
+    std::string msg = std::to_string(n_failed) + " of " + std::to_string(n_problems) +
+                      " problems did not finish successfully, the first one is problem " +
+                      std::to_string(first_failed) + ": " + first_mesg;
+    if (n_usable == 0)
+        return da_error(this->err, first_status, msg);
+    // Other problems in the batch hold valid results, so only warn
+    return da_warn(this->err, first_status, msg);
+}
+
 template class nlls<float>;
 template class nlls<double>;
 
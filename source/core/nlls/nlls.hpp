@@ -59,6 +59,10 @@ using namespace da_optim;
 
 template <typename T> class nlls : public da_optimization<T> {
   private:
+    // Callbacks used by fit_batch()
+    resfun_batch_t<T> resfun_batch = nullptr;
+    resgrd_batch_t<T> resgrd_batch = nullptr;
+
   public:
     // Constructor
     nlls(da_status &status, da_errors::da_error_t &err);
@@ -66,7 +70,11 @@ template <typename T> class nlls : public da_optimization<T> {
     // da_status define_residuals(da_int n_coef, da_int n_res);
     da_status define_callbacks(resfun_t<T> resfun, resgrd_t<T> resgrd, reshes_t<T> reshes,
                                reshp_t<T> reshp);
+    da_status define_batch_callbacks(resfun_batch_t<T> resfun, resgrd_batch_t<T> resgrd);
+    da_status define_multi_callback(resfun_multi_t<T> resfun);
     da_status fit(da_int n_coef, T *coef, void *udata);
+    da_status fit_batch(da_int n_problems, da_int n_coef, T *coef,
+                        da_status *problem_status, void *udata);
     da_status get_result(da_result query, da_int *dim, T *result);
     da_status get_result(da_result query, da_int *dim, da_int *result);
 };
@@ -51,6 +51,39 @@ da_status da_nlls_define_residuals(da_handle handle, da_int n_coef, da_int n_res
             handle, n_coef, n_res, resfun, resgrd, reshes, reshp)));
 }
 
+template <typename T>
+da_status da_nlls_define_residuals_batch(da_handle handle, da_int n_coef, da_int n_res,
+                                         da_resfun_batch_t<T> *resfun,
+                                         da_resgrd_batch_t<T> *resgrd) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err,
+               return (nlls_define_residuals_batch<da_nlls::nlls<T>, da_resfun_batch_t<T>,
+                                                   da_resgrd_batch_t<T>, T>(
+                   handle, n_coef, n_res, resfun, resgrd)));
+}
+
+template <typename T>
+da_status da_nlls_define_residuals_multi(da_handle handle, da_resfun_multi_t<T> *resfun) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err,
+               return (nlls_define_residuals_multi<da_nlls::nlls<T>, da_resfun_multi_t<T>,
+                                                   T>(handle, resfun)));
+}
+
 template <typename T>
 da_status da_nlls_define_bounds(da_handle handle, da_int n_coef, T *lower, T *upper) {
     if (!handle)
@@ -93,6 +126,22 @@ da_status da_nlls_fit(da_handle handle, da_int n_coef, T *coef, void *udata) {
                return (nlls_fit<da_nlls::nlls<T>, T>(handle, n_coef, coef, udata)));
 }
 
+template <typename T>
+da_status da_nlls_fit_batch(da_handle handle, da_int n_problems, da_int n_coef, T *coef,
+                            da_status *problem_status, void *udata) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err,
+               return (nlls_fit_batch<da_nlls::nlls<T>, T>(handle, n_problems, n_coef,
+                                                           coef, problem_status, udata)));
+}
+
 template da_status da_nlls_define_residuals<float>(da_handle, da_int, da_int,
                                                    da_resfun_t_s *, da_resgrd_t_s *,
                                                    da_reshes_t_s *, da_reshp_t_s *);
@@ -105,3 +154,17 @@ template da_status da_nlls_define_weights<float>(da_handle, da_int, float *);
 template da_status da_nlls_define_weights<double>(da_handle, da_int, double *);
 template da_status da_nlls_fit<float>(da_handle, da_int, float *, void *);
 template da_status da_nlls_fit<double>(da_handle, da_int, double *, void *);
+template da_status da_nlls_define_residuals_multi<float>(da_handle,
+                                                         da_resfun_multi_t_s *);
+template da_status da_nlls_define_residuals_multi<double>(da_handle,
+                                                          da_resfun_multi_t_d *);
+template da_status da_nlls_define_residuals_batch<float>(da_handle, da_int, da_int,
+                                                         da_resfun_batch_t_s *,
+                                                         da_resgrd_batch_t_s *);
+template da_status da_nlls_define_residuals_batch<double>(da_handle, da_int, da_int,
+                                                          da_resfun_batch_t_d *,
+                                                          da_resgrd_batch_t_d *);
+template da_status da_nlls_fit_batch<float>(da_handle, da_int, da_int, float *,
+                                            da_status *, void *);
+template da_status da_nlls_fit_batch<double>(da_handle, da_int, da_int, double *,
+                                             da_status *, void *);
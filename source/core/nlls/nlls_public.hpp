@@ -51,6 +51,38 @@ da_status nlls_define_residuals(da_handle handle, da_int n_coef, da_int n_res,
     return nlls->define_callbacks(resfun, resgrd, reshes, reshp);
 }
 
+template <typename nlls_class, typename resfun_t, typename resgrd_t, typename T>
+da_status nlls_define_residuals_batch(da_handle handle, da_int n_coef, da_int n_res,
+                                      resfun_t *resfun, resgrd_t *resgrd) {
+    nlls_class *nlls = dynamic_cast<nlls_class *>(handle->get_alg_handle<T>());
+    if (nlls == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_nlls or "
+                        "handle is invalid.");
+
+    nlls->refresh();
+    da_status status;
+    status = nlls->add_vars(n_coef);
+    if (status != da_status_success)
+        return status; // Error message already loaded
+    status = nlls->add_res(n_res);
+    if (status != da_status_success)
+        return status; // Error message already loaded
+    return nlls->define_batch_callbacks(resfun, resgrd);
+}
+
+template <typename nlls_class, typename resfun_t, typename T>
+da_status nlls_define_residuals_multi(da_handle handle, resfun_t *resfun) {
+    nlls_class *nlls = dynamic_cast<nlls_class *>(handle->get_alg_handle<T>());
+    if (nlls == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_nlls or "
+                        "handle is invalid.");
+
+    nlls->refresh();
+    return nlls->define_multi_callback(resfun);
+}
+
 template <typename nlls_class, typename T>
 da_status nlls_define_bounds(da_handle handle, da_int n_coef, T *lower, T *upper) {
     nlls_class *nlls = dynamic_cast<nlls_class *>(handle->get_alg_handle<T>());
@@ -86,4 +118,16 @@ da_status nlls_fit(da_handle handle, da_int n_coef, T *coef, void *udata) {
     return nlls->fit(n_coef, coef, udata);
 }
 
-} // namespace nlls_public
\ No newline at end of file
+template <typename nlls_class, typename T>
+da_status nlls_fit_batch(da_handle handle, da_int n_problems, da_int n_coef, T *coef,
+                         da_status *problem_status, void *udata) {
+    nlls_class *nlls = dynamic_cast<nlls_class *>(handle->get_alg_handle<T>());
+    if (nlls == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_nlls or "
+                        "handle is invalid.");
+
+    return nlls->fit_batch(n_problems, n_coef, coef, problem_status, udata);
+}
+
+} // namespace nlls_public
@@ -156,4 +156,31 @@ template <typename T> struct meta_reshpcb {
 };
 template <typename T> using reshp_t = typename meta_reshpcb<T>::type;
 
+/* batched residual callbacks, same as resfun_t and resgrd_t with a leading
+ * problem index; signatures match with the public typedef da_res*_batch_t_*
+ */
+template <typename T> struct meta_resfunbatchcb {
+    static_assert(da_std::is_floating_point_v<T>,
+                  "Residual function arguments must be floating point");
+    using type = std::function<da_int(da_int, da_int, da_int, void *, T const *, T *)>;
+};
+template <typename T> using resfun_batch_t = typename meta_resfunbatchcb<T>::type;
+
+template <typename T> struct meta_resgrdbatchcb {
+    static_assert(da_std::is_floating_point_v<T>,
+                  "Residual gradient function arguments must be floating point");
+    using type = std::function<da_int(da_int, da_int, da_int, void *, T const *, T *)>;
+};
+template <typename T> using resgrd_batch_t = typename meta_resgrdbatchcb<T>::type;
+
+/* nonlinear residual function evaluated at several points in one call, used to
+ * estimate derivatives; signature matches with the public typedef da_resfun_multi_t_*
+ */
+template <typename T> struct meta_resfunmulticb {
+    static_assert(da_std::is_floating_point_v<T>,
+                  "Residual function arguments must be floating point");
+    using type = std::function<da_int(da_int, da_int, da_int, void *, T const *, T *)>;
+};
+template <typename T> using resfun_multi_t = typename meta_resfunmulticb<T>::type;
+
 } // namespace ARCH
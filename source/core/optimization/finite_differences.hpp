@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef FINITE_DIFFERENCES_HPP
+#define FINITE_DIFFERENCES_HPP
+
+#include "aoclda.h"
+#include "da_omp.hpp"
+#include "macros.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <vector>
+
+/* Finite-difference estimates of the Jacobian of a vector function r(x) of size m at
+ * a point x of size n, used by the solver drivers when derivatives are not provided.
+ * Same scheme as RALFit: forward step h_j = fd_step * max(1, |x_j|) on each
+ * coefficient, reversed when it would leave the bounds, and a zero column when the
+ * bounds are too tight for either. A gradient is the Jacobian with m = 1.
+ *
+ * The n perturbed points are independent. fd_jacobian() evaluates them with
+ * n_threads OpenMP threads (the call-back must then be thread-safe) and
+ * fd_jacobian_multi() evaluates them all in one call-back.
+ */
+
+namespace ARCH {
+
+namespace da_optim {
+
+// Returned when a finite-difference estimate is not a number (same code as RALFit)
+const da_int FD_NAN_ESTIMATE{-2031};
+
+/* Signed step for coefficient j, zero if it cannot be perturbed */
+template <typename T>
+T fd_perturbation(da_int j, const T *x, T fd_step, const T *lower, const T *upper) {
+    constexpr T inf = std::numeric_limits<T>::infinity();
+    const T h = fd_step * std::max(T(1), std::abs(x[j]));
+    const T lo = lower ? lower[j] : -inf;
+    const T up = upper ? upper[j] : inf;
+    const bool oklo = lo <= x[j] - h;
+    const bool okup = x[j] + h <= up;
+    if (!(lo < up) || !(oklo || okup))
+        return T(0);
+    return okup ? h : -h;
+}
+
+/* Store column j of the Jacobian from the residuals fp at the perturbed point */
+template <typename T>
+da_int fd_store_column(da_int j, da_int n, da_int m, const T *f, const T *fp, T h,
+                       bool col_major, T *J) {
+    for (da_int i = 0; i < m; i++) {
+        T d = h == T(0) ? T(0) : (fp[i] - f[i]) / h;
+        if (std::isnan(d))
+            return FD_NAN_ESTIMATE;
+        J[col_major ? j * m + i : i * n + j] = d;
+    }
+    return 0;
+}
+
+/* eval(xp, fp) stores in fp the function at xp and returns nonzero on failure. The
+ * first failure found is returned and J is then undefined. nevalf is incremented by the
+ * number of function evaluations.
+ */
+template <typename T, typename Eval>
+da_int fd_jacobian(da_int n, da_int m, const T *x, const T *f, T *J, bool col_major,
+                   T fd_step, const T *lower, const T *upper, da_int n_threads,
+                   Eval &&eval, da_int &nevalf) {
+    da_int status{0}, count{0};
+    // Nested calls, e.g. from batched fits, stay on the calling thread
+    n_threads = omp_get_level() == 0 ? std::min(n_threads, n) : 1;
+
+#pragma omp parallel num_threads(n_threads) if (n_threads > 1) reduction(+ : count)
+    {
+        std::vector<T> xp, fp;
+        bool allocated{true};
+        try {
+            xp.assign(x, x + n);
+            fp.resize(m);
+        } catch (std::bad_alloc &) { // LCOV_EXCL_LINE
+            allocated = false;       // LCOV_EXCL_LINE
+        }
+        if (!allocated) {
+#pragma omp atomic write
+            status = da_int(da_status_memory_error); // LCOV_EXCL_LINE
+        }
+
+#pragma omp for schedule(dynamic)
+        for (da_int j = 0; j < n; j++) {
+            da_int st;
+#pragma omp atomic read
+            st = status;
+            if (st != 0 || !allocated)
+                continue;
+            const T h = fd_perturbation(j, x, fd_step, lower, upper);
+            if (h != T(0)) {
+                xp[j] = x[j] + h;
+                st = eval(xp.data(), fp.data());
+                xp[j] = x[j];
+                count++;
+            }
+            if (st == 0)
+                st = fd_store_column(j, n, m, f, fp.data(), h, col_major, J);
+            if (st != 0) {
+#pragma omp atomic write
+                status = st;
+            }
+        }
+    }
+    nevalf += count;
+    return status;
+}
+
+/* eval_multi(npts, xp, fp) stores in fp[k*m:(k+1)*m-1] the function at the point
+ * xp[k*n:(k+1)*n-1], for k = 0, ..., npts-1, and returns nonzero on failure.
+ */
+template <typename T, typename EvalMulti>
+da_int fd_jacobian_multi(da_int n, da_int m, const T *x, const T *f, T *J,
+                         bool col_major, T fd_step, const T *lower, const T *upper,
+                         EvalMulti &&eval_multi, da_int &nevalf) {
+    std::vector<T> h, xp, fp;
+    try {
+        h.resize(n);
+        xp.reserve((size_t)n * n);
+    } catch (std::bad_alloc &) {       // LCOV_EXCL_LINE
+        return da_status_memory_error; // LCOV_EXCL_LINE
+    }
+    da_int npts{0};
+    for (da_int j = 0; j < n; j++) {
+        h[j] = fd_perturbation(j, x, fd_step, lower, upper);
+        if (h[j] != T(0)) {
+            xp.insert(xp.end(), x, x + n);
+            xp[(size_t)npts * n + j] += h[j];
+            npts++;
+        }
+    }
+    if (npts > 0) {
+        try {
+            fp.resize((size_t)npts * m);
+        } catch (std::bad_alloc &) {       // LCOV_EXCL_LINE
+            return da_status_memory_error; // LCOV_EXCL_LINE
+        }
+        da_int status = eval_multi(npts, xp.data(), fp.data());
+        nevalf += npts;
+        if (status != 0)
+            return status;
+    }
+    for (da_int j = 0, k = 0; j < n; j++) {
+        const T *fpj = h[j] != T(0) ? &fp[(size_t)(k++) * m] : f;
+        da_int status = fd_store_column(j, n, m, f, fpj, h[j], col_major, J);
+        if (status != 0)
+            return status;
+    }
+    return 0;
+}
+
+} // namespace da_optim
+
+} // namespace ARCH
+
+#endif
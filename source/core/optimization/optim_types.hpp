@@ -42,6 +42,9 @@ enum solvers {
 enum cons_type { cons_bounds = 0, cons_linear = 1 };
 
 enum regularization { quadratic = 2, cubic = 3 };
+
+// Solvers for batched nonlinear least-squares fits
+enum batch_solvers { batch_auto = 0, batch_ralfit = 1, batch_lm = 2 };
 } // namespace da_optim_types
 
 #endif
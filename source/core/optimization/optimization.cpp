@@ -298,6 +298,12 @@ template <typename T> da_status da_optimization<T>::add_reshp(reshp_t<T> reshp)
     return da_status_success;
 }
 
+template <typename T>
+da_status da_optimization<T>::add_resfun_multi(resfun_multi_t<T> resfun_multi) {
+    this->resfun_multi = resfun_multi;
+    return da_status_success;
+}
+
 template <typename T>
 da_status da_optimization<T>::solve(std::vector<T> &x, void *usrdata) {
 
@@ -408,7 +414,7 @@ da_status da_optimization<T>::solve(std::vector<T> &x, void *usrdata) {
             status = ralfit::ralfit_driver(
                 this->opts, this->nvar, this->nres, x.data(), this->resfun, this->resgrd,
                 this->reshes, this->reshp, this->l_usrptr, this->u_usrptr, this->w_usrptr,
-                usrdata, this->info, *this->err);
+                usrdata, this->info, *this->err, this->resfun_multi);
             break;
         }
     case solver_undefined:
@@ -81,6 +81,7 @@ template <typename T> class da_optimization : public basic_handle<T> {
     resgrd_t<T> resgrd = nullptr;
     reshes_t<T> reshes = nullptr;
     reshp_t<T> reshp = nullptr;
+    resfun_multi_t<T> resfun_multi = nullptr;
 
     // Last iterate information
     // Objective function value
@@ -118,6 +119,7 @@ template <typename T> class da_optimization : public basic_handle<T> {
     da_status add_resgrd(resgrd_t<T> resgrd);
     da_status add_reshes(reshes_t<T> reshes);
     da_status add_reshp(reshp_t<T> reshp);
+    da_status add_resfun_multi(resfun_multi_t<T> resfun_multi);
 
     // Solver interfaces (only lbfgsb for now)
     da_status solve(std::vector<T> &x, void *usrdata);
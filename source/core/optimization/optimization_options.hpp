@@ -104,6 +104,16 @@ inline da_status register_optimization_options(da_errors::da_error_t &err,
             da_options::lbound_t::greaterequal, 3, da_options::ubound_t::lessequal, 0));
         opts.register_opt(oi);
 
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "finite differences threads",
+            "Number of OpenMP threads used to evaluate the perturbed points when "
+            "estimating derivatives using finite-differences. A value of 0 uses the "
+            "maximum number of threads and 1 evaluates them serially. Call-backs must be "
+            "thread-safe if this value is not 1.",
+            0, da_options::lbound_t::greaterequal, max_da_int,
+            da_options::ubound_t::p_inf, 1));
+        opts.register_opt(oi);
+
         oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
             "ralfit iteration limit", "Maximum number of iterations to perform.", 1,
             da_options::lbound_t::greaterequal, max_da_int, da_options::ubound_t::p_inf,
@@ -296,6 +306,18 @@ inline da_status register_optimization_options(da_errors::da_error_t &err,
             "quadratic"));
         opts.register_opt(os);
 
+        os = std::make_shared<OptionString>(OptionString(
+            "nlls batch solver",
+            "Solver used by batched nonlinear data fitting. The built-in "
+            "levenberg-marquardt solver has a lower cost per problem than ralfit, auto "
+            "selects it for models with at most 8 coefficients.",
+            {{"auto", batch_auto},
+             {"ralfit", batch_ralfit},
+             {"levenberg-marquardt", batch_lm},
+             {"lm", batch_lm}},
+            "auto"));
+        opts.register_opt(os);
+
     } catch (std::bad_alloc &) {
         return da_error(&err, da_status_memory_error,
                         "Memory allocation failed"); // LCOV_EXCL_LINE
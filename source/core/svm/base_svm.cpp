@@ -191,9 +191,9 @@ da_status base_svm<T>::compute_impl(const std::vector<T> *initial_alpha) {
     compute_ws_size(ws_size, max_ws_size);
     vectorization_type simd_type_wssi, simd_type_wssj, isa;
     simd_type_wssi = Oracle<KernelSelection>(wssi_tuning, tid<T>(), ws_size,
-                                             oracle_lt<da_int>, "svm.isa");
+                                             oracle_lt<da_int>, "svm.isa", "svm.wssi");
     simd_type_wssj = Oracle<KernelSelection>(wssj_tuning, tid<T>(), ws_size,
-                                             oracle_lt<da_int>, "svm.isa");
+                                             oracle_lt<da_int>, "svm.isa", "svm.wssj");
     isa = (simd_type_wssi > simd_type_wssj) ? simd_type_wssi : simd_type_wssj;
     padding = get_padding<T>(isa);
     wssi_vec_type = simd_type_wssi;
@@ -275,6 +275,7 @@ da_status base_svm<T>::compute_impl(const std::vector<T> *initial_alpha) {
         local_alpha.resize(ws_size);
         local_gradient.resize(ws_size + padding);
         local_response.resize(ws_size);
+        local_bound.resize(ws_size);
         local_kernel_matrix_row_major.resize(ws_size * (ws_size + padding));
         kernel_diagonal.resize(ws_size + padding);
         real_indices.resize(ws_size);
@@ -381,10 +382,12 @@ da_status base_svm<T>::compute_impl(const std::vector<T> *initial_alpha) {
 /* Predict SVM */
 template <typename T>
 da_status base_svm<T>::predict(da_int nsamples, da_int nfeat, const T *X_test,
-                               da_int ldx_test, T *predictions) {
+                               da_int ldx_test, T *predictions,
+                               da_errors::da_error_t *err_trace) {
     da_status status = da_status_success;
     // Vector that will store decision values
-    status = decision_function(nsamples, nfeat, X_test, ldx_test, predictions);
+    status =
+        decision_function(nsamples, nfeat, X_test, ldx_test, predictions, err_trace);
     if (mod == da_svm_model::svc || mod == da_svm_model::nusvc) {
         for (da_int i = 0; i < nsamples; i++) {
             predictions[i] = predictions[i] > 0 ? 1 : 0;
@@ -430,7 +433,7 @@ void base_svm<T>::decision_function_loop(
         if (last_inner || last_outer) {
             vectorisation = Oracle<KernelSelection>(
                 ::da_kernel_functions::kf_tuning, tid<T>(),
-                std::max(cur_inner, cur_outer), oracle_lt<da_int>, "kf.isa");
+                std::max(cur_inner, cur_outer), oracle_lt<da_int>, "kf.isa", "kf");
         }
 
         da_int sample_start = outer_sample_block_idx * outer_block_size;
@@ -461,7 +464,10 @@ void base_svm<T>::decision_function_loop(
 /* Calculate decision function */
 template <typename T>
 da_status base_svm<T>::decision_function(da_int nsamples, da_int nfeat, const T *X_test,
-                                         da_int ldx_test, T *decision_values) {
+                                         da_int ldx_test, T *decision_values,
+                                         da_errors::da_error_t *err_trace) {
+    if (err_trace == nullptr)
+        err_trace = err;
     for (da_int i = 0; i < nsamples; i++)
         decision_values[i] = bias;
     if (n_support == 0 || nsamples == 0)
@@ -502,8 +508,8 @@ da_status base_svm<T>::decision_function(da_int nsamples, da_int nfeat, const T
             sv_norms.resize(n_support);
             test_norms.resize(nsamples);
         }
-    } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
-        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(err_trace, da_status_memory_error, // LCOV_EXCL_LINE
                         "Memory allocation error");
     }
     if (use_precomputed_norms) {
@@ -527,7 +533,8 @@ da_status base_svm<T>::decision_function(da_int nsamples, da_int nfeat, const T
     // Precompute SIMD type for the common (full-size) blocks
     vectorization_type vectorisation_full = Oracle<KernelSelection>(
         ::da_kernel_functions::kf_tuning, tid<T>(),
-        std::max(inner_block_size, outer_block_size), oracle_lt<da_int>, "kf.isa");
+        std::max(inner_block_size, outer_block_size), oracle_lt<da_int>, "kf.isa",
+        "kf");
 
     if (use_precomputed_norms)
         decision_function_loop<true>(
@@ -617,7 +624,8 @@ void base_svm<T>::kernel_compute(std::vector<da_int> &idx, da_int &idx_size,
 
         // Call to appropriate kernel function. Note that only idx_to_compute_count columns of kernel_temp will be filled.
         vectorization_type vectorisation = Oracle<KernelSelection>(
-            ::da_kernel_functions::kf_tuning, tid<T>(), n, oracle_lt<da_int>, "kf.isa");
+            ::da_kernel_functions::kf_tuning, tid<T>(), n, oracle_lt<da_int>, "kf.isa",
+            "kf");
 
         // Variables used in euclidean_distance interface, 1 means to use precomputed norms, 2 means to compute norms
         da_int compute_X_norms = 1;
@@ -114,7 +114,7 @@ void csvm<T>::outer_wss(da_int &size, std::vector<da_int> &selected_ws_idx,
             // and is in I_up set.
             while (selected_ws_indicator[current_index] == true ||
                    !is_upper(this->alpha[current_index], this->response[current_index],
-                             this->C)) {
+                             this->upper_bound(current_index))) {
                 pos_left++;
                 if (pos_left == size)
                     break;
@@ -134,7 +134,7 @@ void csvm<T>::outer_wss(da_int &size, std::vector<da_int> &selected_ws_idx,
             // and is in I_low set.
             while (selected_ws_indicator[current_index] == true ||
                    !is_lower(this->alpha[current_index], this->response[current_index],
-                             this->C)) {
+                             this->upper_bound(current_index))) {
                 pos_right--;
                 if (pos_right == -1)
                     break;
@@ -147,6 +147,15 @@ void csvm<T>::outer_wss(da_int &size, std::vector<da_int> &selected_ws_idx,
             }
         }
     }
+    // Observations with a zero upper bound (zero sample weight) are in neither I_up nor
+    // I_low and are never picked above. Complete the working set with them so it has no
+    // stale or repeated indexes, their alpha is pinned at zero by local SMO.
+    for (da_int k = 0; k < size && n_selected < this->ws_size; k++) {
+        if (!selected_ws_indicator[k]) {
+            selected_ws_idx[n_selected++] = k;
+            selected_ws_indicator[k] = true;
+        }
+    }
 }
 
 template <typename T>
@@ -159,6 +168,7 @@ void csvm<T>::local_smo(
     std::vector<da_int> &I_up_p, [[maybe_unused]] std::vector<da_int> &I_low_n,
     [[maybe_unused]] std::vector<da_int> &I_up_n, T &first_diff,
     std::vector<T> &alpha_diff, std::optional<T> tol) {
+    std::vector<T> &local_bound = this->local_bound;
     // Grab the values of alpha, gradient and response that are in the working set, so that we operate on smaller arrays
     // First loop: Copy alpha, gradient, response, and compute flags
     for (da_int iter = 0; iter < ws_size; iter++) {
@@ -166,8 +176,11 @@ void csvm<T>::local_smo(
         local_alpha[iter] = alpha[idx_iter];
         local_gradient[iter] = gradient[idx_iter];
         local_response[iter] = response[idx_iter];
-        I_low_p[iter] = is_lower(local_alpha[iter], local_response[iter], this->C);
-        I_up_p[iter] = is_upper(local_alpha[iter], local_response[iter], this->C);
+        local_bound[iter] = this->upper_bound(idx_iter);
+        I_low_p[iter] =
+            is_lower(local_alpha[iter], local_response[iter], local_bound[iter]);
+        I_up_p[iter] =
+            is_upper(local_alpha[iter], local_response[iter], local_bound[iter]);
         real_indices[iter] = idx[iter] % this->n;
     }
 
@@ -209,19 +222,21 @@ void csvm<T>::local_smo(
         if (diff < epsilon || i == -1 || j == -1)
             break;
         // Theory behind following formulas are in libsvm paper chapter 6 (page 28)
-        alpha_i_diff = local_response[i] > 0 ? this->C - local_alpha[i] : local_alpha[i];
+        alpha_i_diff =
+            local_response[i] > 0 ? local_bound[i] - local_alpha[i] : local_alpha[i];
         alpha_j_diff = std::min(
-            local_response[j] > 0 ? local_alpha[j] : this->C - local_alpha[j], delta);
+            local_response[j] > 0 ? local_alpha[j] : local_bound[j] - local_alpha[j],
+            delta);
         delta = std::min(alpha_i_diff, alpha_j_diff);
         // Update alpha
         local_alpha[i] += delta * local_response[i];
         local_alpha[j] -= delta * local_response[j];
 
         // Update I_low and I_up just for i and j
-        I_low_p[i] = is_lower(local_alpha[i], local_response[i], this->C);
-        I_up_p[i] = is_upper(local_alpha[i], local_response[i], this->C);
-        I_low_p[j] = is_lower(local_alpha[j], local_response[j], this->C);
-        I_up_p[j] = is_upper(local_alpha[j], local_response[j], this->C);
+        I_low_p[i] = is_lower(local_alpha[i], local_response[i], local_bound[i]);
+        I_up_p[i] = is_upper(local_alpha[i], local_response[i], local_bound[i]);
+        I_low_p[j] = is_lower(local_alpha[j], local_response[j], local_bound[j]);
+        I_up_p[j] = is_upper(local_alpha[j], local_response[j], local_bound[j]);
         // Update gradient (local_kernel_matrix_row_major is square at this point so row/column major does not matter here)
         // Formula: gradient[k] += delta * (Q_ki - Q_kj) (section 4.1.4 in libsvm paper)
         // We need to obtain two columns from kernel matrix
@@ -249,13 +264,14 @@ da_status csvm<T>::set_bias(std::vector<T> &alpha, std::vector<T> &gradient,
     T min_value = std::numeric_limits<T>::max();
     T max_value = -min_value;
     for (da_int i = 0; i < size; i++) {
-        if (alpha[i] > 0 && alpha[i] < this->C) {
+        T bound = this->upper_bound(i);
+        if (alpha[i] > 0 && alpha[i] < bound) {
             gradient_sum += gradient[i];
             n_free++;
         }
-        if (is_upper(alpha[i], response[i], this->C))
+        if (is_upper(alpha[i], response[i], bound))
             min_value = std::min(min_value, gradient[i]);
-        if (is_lower(alpha[i], response[i], this->C))
+        if (is_lower(alpha[i], response[i], bound))
             max_value = std::max(max_value, gradient[i]);
     }
     // If no free vectors then set bias to the middle of the two values, otherwise average of gradients of free vectors
@@ -445,7 +445,8 @@ da_status nusvm<T>::initialise_gradient(std::vector<T> &alpha_diff, da_int count
 
         // Call to appropriate kernel function. Note that only idx_to_compute_count columns of kernel_temp will be filled.
         vectorization_type vectorisation = Oracle<KernelSelection>(
-            ::da_kernel_functions::kf_tuning, tid<T>(), n, oracle_lt<da_int>, "kf.isa");
+            ::da_kernel_functions::kf_tuning, tid<T>(), n, oracle_lt<da_int>, "kf.isa",
+            "kf");
         // Variables used in euclidean_distance interface, 1 means to use precomputed norms, 2 means to compute norms
         da_int compute_X_norms = 1;
         da_int compute_y_norms = 2;
@@ -31,6 +31,7 @@
 #include "da_error.hpp"
 #include "da_omp.hpp"
 #include "da_std.hpp"
+#include "da_utils.hpp"
 #include "fp16_helpers.hpp"
 #include "macros.h"
 #include "options.hpp"
@@ -281,6 +282,8 @@ da_status svm<T>::set_data(da_int n_samples, da_int n_features, const T *X_in,
     nrow = n_samples;
     ncol = n_features;
     ismulticlass = false;
+    // Weights refer to the previous data set
+    sample_weights.clear();
     try {
         is_sv.resize(n_samples);
     } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
@@ -407,6 +410,42 @@ da_status svm<T>::set_data(da_int n_samples, da_int n_features, const T *X_in,
     return da_status_success;
 }
 
+template <typename T>
+da_status svm<T>::set_sample_weights(da_int n_weights, const T *weights) {
+    if (!loadingdone)
+        return da_error(this->err, da_status_no_data,
+                        "No data has been passed to the handle. Please call "
+                        "da_svm_set_data_s or da_svm_set_data_d.");
+
+    this->model_trained = false;
+    if (n_weights == 0) {
+        sample_weights.clear();
+        return da_status_success;
+    }
+    if (n_weights != nrow)
+        return da_error(this->err, da_status_invalid_input,
+                        "n_weights = " + std::to_string(n_weights) +
+                            ", it must be equal to n_samples = " + std::to_string(nrow) +
+                            ".");
+    da_status status = this->check_1D_array(n_weights, weights, "n_weights", "weights");
+    if (status != da_status_success)
+        return status;
+    for (da_int i = 0; i < n_weights; i++) {
+        if (!da_std::isfinite(weights[i]) || weights[i] < (T)0.0)
+            return da_error(this->err, da_status_invalid_input,
+                            "weights[" + std::to_string(i) +
+                                "] must be finite and non-negative.");
+    }
+
+    try {
+        sample_weights.assign(weights, weights + n_weights);
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    return da_status_success;
+}
+
 template <typename T> da_status svm<T>::select_model(da_svm_model mod) {
 
     // reset model_trained only if the model is changed
@@ -509,6 +548,13 @@ template <typename T> da_status svm<T>::compute() {
     }
     da_std::fill(n_sv_per_class.begin(), n_sv_per_class.end(), 0);
 
+    // Sample weights scale C for each sample, nu formulations have no per-sample bound
+    if (!sample_weights.empty() &&
+        (mod == da_svm_model::nusvc || mod == da_svm_model::nusvr))
+        return da_error(this->err, da_status_incompatible_options,
+                        "Sample weights are only supported for the C-SVC and epsilon-SVR "
+                        "models.");
+
     // Get the options set by user
     T C, epsilon, nu, tolerance, coef0, tau, cache_size, lp_tol;
     da_int degree, max_iter, n_fold, max_ws_size, lp_max_iter;
@@ -549,6 +595,17 @@ template <typename T> da_status svm<T>::compute() {
                                                    X_lp.data(), nrow);
             da_utils::copy_array_convert_precision(column_major, nrow, 1, y, nrow,
                                                    y_lp.data(), nrow);
+            if (!sample_weights.empty()) {
+                try {
+                    sample_weights_lp.resize(nrow);
+                } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+                    return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                                    "Memory allocation error");
+                }
+                da_utils::copy_array_convert_precision(column_major, nrow, 1,
+                                                       sample_weights.data(), nrow,
+                                                       sample_weights_lp.data(), nrow);
+            }
         }
     }
 
@@ -562,6 +619,8 @@ template <typename T> da_status svm<T>::compute() {
     // Compute each created classifier in the order 0v1, 0v2, ..., 0v(k-1), 1v2, 1v3, ... etc.
     for (da_int i = 0; i < n_classifiers; i++) {
         classifiers[i]->C = C;
+        classifiers[i]->sample_weights =
+            sample_weights.empty() ? nullptr : sample_weights.data();
         classifiers[i]->eps = epsilon;
         classifiers[i]->nu = nu;
         classifiers[i]->coef0 = coef0;
@@ -589,6 +648,8 @@ template <typename T> da_status svm<T>::compute() {
                     X_lp.data(), y_lp.data(), nrow, ncol, nrow);
                 copy_classifier_metadata(*classifiers[i], *lp_classifier);
                 lp_classifier->C = static_cast<lp_type>(C);
+                lp_classifier->sample_weights =
+                    sample_weights.empty() ? nullptr : sample_weights_lp.data();
                 lp_classifier->eps = static_cast<lp_type>(epsilon);
                 lp_classifier->nu = static_cast<lp_type>(nu);
                 lp_classifier->coef0 = static_cast<lp_type>(coef0);
@@ -836,6 +897,88 @@ da_status svm<T>::predict(da_int nsamples, da_int nfeat, const T *X_test, da_int
     return status;
 }
 
+template <typename T>
+da_status svm<T>::predict(_da_inference_context &ctx, da_int nsamples, da_int nfeat,
+                          const T *X_test, da_int ldx_test, T *predictions) {
+    da_errors::da_error_t *err = ctx.err;
+    if (predictions == nullptr)
+        return da_error(err, da_status_invalid_pointer,
+                        "predictions is not a valid pointer.");
+
+    if (nfeat != ncol) {
+        return da_error(err, da_status_invalid_input,
+                        "n_features = " + std::to_string(nfeat) +
+                            " doesn't match the expected value " + std::to_string(ncol) +
+                            ".");
+    }
+
+    if (!this->model_trained)
+        return da_error(err, da_status_out_of_date,
+                        "The model has not been trained yet.");
+
+    da_status status =
+        this->check_2D_array(err, this->order, nsamples, nfeat, X_test, ldx_test,
+                             "n_samples", "n_features", "X_test", "ldx_test");
+    if (status != da_status_success)
+        return status;
+
+    // Workspace: the predictions of one classifier for multiclass problems, then a
+    // column-major copy of row-major data, since the kernels only read column-major data
+    std::vector<T> &work = ctx.workspace<T>();
+    std::vector<da_int> &votes = ctx.workspace<da_int>();
+    const size_t n_pred = ismulticlass ? (size_t)nsamples : 0;
+    const size_t n_copy = this->order == row_major ? (size_t)nsamples * nfeat : 0;
+    try {
+        work.resize(n_pred + n_copy);
+        if (ismulticlass)
+            votes.resize((size_t)n_class * nsamples);
+    } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    const T *X = X_test;
+    da_int ldx = ldx_test;
+    if (this->order == row_major) {
+        da_utils::copy_transpose_2D_array_row_to_column_major(
+            nsamples, nfeat, X_test, ldx_test, work.data() + n_pred, nsamples);
+        X = work.data() + n_pred;
+        ldx = nsamples;
+    }
+
+    if (!ismulticlass)
+        return classifiers[0]->predict(nsamples, nfeat, X, ldx, predictions, err);
+
+    T *classifier_predictions = work.data();
+    da_std::fill(votes.begin(), votes.end(), 0);
+    for (da_int i = 0; i < n_classifiers; i++) {
+        status = classifiers[i]->predict(nsamples, nfeat, X, ldx, classifier_predictions,
+                                         err);
+        if (status != da_status_success)
+            return da_error(err, da_status_internal_error,
+                            "An unexpected error occurred during prediction.");
+        da_int pos_class = classifiers[i]->pos_class;
+        da_int neg_class = classifiers[i]->neg_class;
+        for (da_int j = 0; j < nsamples; j++) {
+            da_int vote_idx =
+                j * n_class + (classifier_predictions[j] == 1 ? pos_class : neg_class);
+            votes[vote_idx]++;
+        }
+    }
+    // Compute argmax from the votes
+    for (da_int i = 0; i < nsamples; i++) {
+        da_int max_votes = 0, max_idx = 0;
+        const da_int *sample_votes = votes.data() + i * n_class;
+        for (da_int j = 0; j < n_class; j++) {
+            if (sample_votes[j] > max_votes) {
+                max_votes = sample_votes[j];
+                max_idx = j;
+            }
+        }
+        predictions[i] = max_idx;
+    }
+    return da_status_success;
+}
+
 /* Decision function SVM */
 template <typename T>
 da_status svm<T>::decision_function(da_int nsamples, da_int nfeat, const T *X_test,
@@ -1279,16 +1422,19 @@ da_status svm<T>::compute_probabilities(base_svm<T> &classifier, da_int n_fold,
     }
     da_std::iota(rand_indices.begin(), rand_indices.end(), 0);
     da_std::shuffle(rand_indices.begin(), rand_indices.end(), mt_gen);
+    const T *weights = classifier.sample_weights;
 
     // Start cross-validation
     for (da_int i = 0; i < n_fold; i++) {
         da_int fold_start = i * n / n_fold;
         da_int fold_end = (i == n_fold - 1) ? n : (i + 1) * n / n_fold;
 
-        std::vector<T> X_train, y_train, X_val, y_val;
+        std::vector<T> X_train, y_train, X_val, y_val, w_train;
         try {
             X_train.resize((n - (fold_end - fold_start)) * p);
             y_train.resize(n - (fold_end - fold_start));
+            if (weights != nullptr)
+                w_train.resize(n - (fold_end - fold_start));
             X_val.resize((fold_end - fold_start) * p);
             y_val.resize(fold_end - fold_start);
         } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
@@ -1313,6 +1459,9 @@ da_status svm<T>::compute_probabilities(base_svm<T> &classifier, da_int n_fold,
                         X_class[j + k * ldx_class];
                 }
                 y_train[idx_train] = y_class[j];
+                if (weights != nullptr)
+                    w_train[idx_train] =
+                        weights[classifier.ismulticlass ? classifier.idx_class[j] : j];
                 idx_train++;
             }
         }
@@ -1355,6 +1504,8 @@ da_status svm<T>::compute_probabilities(base_svm<T> &classifier, da_int n_fold,
                                 "Unsupported SVM model.");
             }
             fold_classifier->C = classifier.C;
+            fold_classifier->sample_weights =
+                weights == nullptr ? nullptr : w_train.data();
             fold_classifier->eps = classifier.eps;
             fold_classifier->nu = classifier.nu;
             fold_classifier->coef0 = classifier.coef0;
@@ -29,6 +29,7 @@
 #include "basic_handle.hpp"
 #include "da_cache.hpp"
 #include "da_error.hpp"
+#include "da_inference_context.hpp"
 #include "da_kernel_utils.hpp"
 #include "da_vector.hpp"
 #include "macros.h"
@@ -157,6 +158,8 @@ template <typename T> class base_svm {
     T coef0 = (T)0.0;
     // Regularisation parameters
     T C = (T)1, eps = (T)0.1, nu = (T)0.5;
+    // Optional per-sample weights scaling C, indexed by the row of the user's data
+    const T *sample_weights = nullptr;
     // Working set parameter tau, value of the denominator if kernel is not positive semi definite (safe eps)
     T tau = 2 * std::numeric_limits<T>::epsilon();
     // Convergence tolerance
@@ -194,6 +197,7 @@ template <typename T> class base_svm {
     da_int ws_size = 0; // Size of working set
     T cache_size = 0;   // Size of cache for each classifier (in MB)
     std::vector<T> local_alpha, local_gradient, local_response;
+    std::vector<T> local_bound; // Box constraint upper bound of the working set
     std::vector<T> x_norm_aux, y_norm_aux; // Work array for kernel computation
     std::vector<da_int> I_low_p, I_up_p, I_low_n, I_up_n;
 
@@ -214,10 +218,12 @@ template <typename T> class base_svm {
     // Main functions
     da_status compute();
     da_status compute_warm_start(std::vector<T> &initial_alpha);
+    // Errors are recorded in err_trace when given, in err otherwise
     da_status predict(da_int nsamples, da_int nfeat, const T *X_test, da_int ldx_test,
-                      T *decision_values);
+                      T *decision_values, da_errors::da_error_t *err_trace = nullptr);
     da_status decision_function(da_int nsamples, da_int nfeat, const T *X_test,
-                                da_int ldx_test, T *decision_values);
+                                da_int ldx_test, T *decision_values,
+                                da_errors::da_error_t *err_trace = nullptr);
     template <bool PrecomputedNorms>
     void decision_function_loop(da_int nfeat, const T *X_test, da_int ldx_test,
                                 T *decision_values, da_int total_blocks,
@@ -257,6 +263,13 @@ template <typename T> class base_svm {
                                std::vector<T> &local_kernel_matrix_row_major,
                                std::vector<T> &kernel_diagonal,
                                std::vector<da_int> &real_indices);
+    // Upper bound of the box constraint on alpha[i], i in [0, actual_size)
+    T upper_bound(da_int i) const {
+        if (sample_weights == nullptr)
+            return C;
+        da_int k = i % n;
+        return C * sample_weights[idx_class.empty() ? k : idx_class[k]];
+    }
 
     // Functions that need specialisation
     virtual da_status initialisation(da_int &size, std::vector<T> &gradient,
@@ -325,6 +338,10 @@ template <typename T> class svm : public basic_handle<T> {
 
     da_svm_model mod = svm_undefined;
 
+    // Optional per-sample weights (copied from the user, optional)
+    std::vector<T> sample_weights;
+    std::vector<lp_type> sample_weights_lp;
+
     // Results
     std::vector<da_int> is_sv; // only used for multiclass (boolean type)
     da_int n_sv = 0;
@@ -338,12 +355,18 @@ template <typename T> class svm : public basic_handle<T> {
     // Main functions
     da_status set_data(da_int n_samples, da_int n_features, const T *X, da_int ldx_train,
                        const T *y);
+    da_status set_sample_weights(da_int n_weights, const T *weights);
     da_status select_model(da_svm_model mod);
     da_status compute();
     da_status compute_probabilities(base_svm<T> &classifier, da_int n_fold, T &probA,
                                     T &probB);
     da_status predict(da_int nsamples, da_int nfeat, const T *X_test, da_int ldx_test,
                       T *predictions);
+    /* Version of predict which only reads the trained model: errors and temporary
+     * arrays go to ctx, so it can be called concurrently on the same handle
+     */
+    da_status predict(_da_inference_context &ctx, da_int nsamples, da_int nfeat,
+                      const T *X_test, da_int ldx_test, T *predictions);
     da_status decision_function(da_int nsamples, da_int nfeat, const T *X_test,
                                 da_int ldx_test, da_svm_decision_function_shape shape,
                                 T *decision_values, da_int ldd);
@@ -56,6 +56,21 @@ da_status da_svm_set_data(da_handle handle, da_int n_samples, da_int n_features,
                                 handle, n_samples, n_features, X, ldx_train, y)));
 }
 
+template <typename T>
+da_status da_svm_set_sample_weights(da_handle handle, da_int n_weights,
+                                    const T *weights) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // clean up handle logs
+
+    da_status status = handle->check_precision<T>();
+    if (status != da_status_success)
+        return da_error_trace(handle->err, status, "Wrong precision type.");
+
+    DISPATCHER(handle->err, return (svm_set_sample_weights<da_svm::svm<T>, T>(
+                                handle, n_weights, weights)));
+}
+
 template <typename T> da_status da_svm_compute(da_handle handle) {
     if (!handle)
         return da_status_handle_not_initialized;
@@ -84,6 +99,25 @@ da_status da_svm_predict(da_handle handle, da_int n_samples, da_int n_features,
                                                       X_test, ldx_test, predictions)));
 }
 
+template <typename T>
+da_status da_svm_predict(da_handle handle, da_inference_context ctx, da_int n_samples,
+                         da_int n_features, const T *X_test, da_int ldx_test,
+                         T *predictions) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    if (!ctx)
+        return da_status_invalid_pointer;
+    ctx->clear(); // Clean up context logs, the handle is only read
+
+    da_status status = handle->check_precision<T>(ctx->err);
+    if (status != da_status_success)
+        return da_error_trace(ctx->err, status, "Wrong precision type.");
+
+    DISPATCHER(ctx->err, return (svm_predict<da_svm::svm<T>, T>(handle, ctx, n_samples,
+                                                                n_features, X_test,
+                                                                ldx_test, predictions)));
+}
+
 template <typename T>
 da_status da_svm_decision_function(da_handle handle, da_int n_samples, da_int n_features,
                                    const T *X_test, da_int ldx_test,
@@ -157,12 +191,18 @@ template da_status da_svm_set_data<float>(da_handle, da_int, da_int, const float
                                           da_int, const float *);
 template da_status da_svm_set_data<double>(da_handle, da_int, da_int, const double *,
                                            da_int, const double *);
+template da_status da_svm_set_sample_weights<float>(da_handle, da_int, const float *);
+template da_status da_svm_set_sample_weights<double>(da_handle, da_int, const double *);
 template da_status da_svm_compute<float>(da_handle);
 template da_status da_svm_compute<double>(da_handle);
 template da_status da_svm_predict<float>(da_handle, da_int, da_int, const float *, da_int,
                                          float *);
 template da_status da_svm_predict<double>(da_handle, da_int, da_int, const double *,
                                           da_int, double *);
+template da_status da_svm_predict<float>(da_handle, da_inference_context, da_int, da_int,
+                                         const float *, da_int, float *);
+template da_status da_svm_predict<double>(da_handle, da_inference_context, da_int, da_int,
+                                          const double *, da_int, double *);
 template da_status da_svm_decision_function<float>(da_handle, da_int, da_int,
                                                    const float *, da_int,
                                                    da_svm_decision_function_shape,
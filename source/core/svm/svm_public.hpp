@@ -23,6 +23,7 @@
 
 #include "aoclda.h"
 #include "da_handle.hpp"
+#include "da_inference_context.hpp"
 #include "dynamic_dispatch.hpp"
 #include "macros.h"
 
@@ -48,7 +49,21 @@ da_status svm_set_data(da_handle handle, da_int n_samples, da_int n_features, co
                         "handle was not initialized with handle_type=da_handle_svm or "
                         "handle is invalid.");
 
-    return svm->set_data(n_samples, n_features, X, ldx_train, y);
+    da_status status = svm->set_data(n_samples, n_features, X, ldx_train, y);
+    if (status == da_status_success)
+        svm->release_datastore_data();
+    return status;
+}
+
+template <typename svm_class, typename T>
+da_status svm_set_sample_weights(da_handle handle, da_int n_weights, const T *weights) {
+    svm_class *svm = dynamic_cast<svm_class *>(handle->get_alg_handle<T>());
+    if (svm == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_svm or "
+                        "handle is invalid.");
+
+    return svm->set_sample_weights(n_weights, weights);
 }
 
 template <typename svm_class, typename T> da_status svm_compute(da_handle handle) {
@@ -73,6 +88,19 @@ da_status svm_predict(da_handle handle, da_int n_samples, da_int n_features,
     return svm->predict(n_samples, n_features, X_test, ldx_test, predictions);
 }
 
+template <typename svm_class, typename T>
+da_status svm_predict(da_handle handle, da_inference_context ctx, da_int n_samples,
+                      da_int n_features, const T *X_test, da_int ldx_test,
+                      T *predictions) {
+    svm_class *svm = dynamic_cast<svm_class *>(handle->get_alg_handle<T>());
+    if (svm == nullptr)
+        return da_error(ctx->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_svm or "
+                        "handle is invalid.");
+
+    return svm->predict(*ctx, n_samples, n_features, X_test, ldx_test, predictions);
+}
+
 template <typename svm_class, typename T>
 da_status svm_decision_function(da_handle handle, da_int n_samples, da_int n_features,
                                 const T *X_test, da_int ldx_test,
@@ -235,6 +235,99 @@ da_status da_data_extract_selection_uint8(da_datastore store, const char *key,
                                           da_order order, uint8_t *data, da_int lddata) {
     return da_data_extract_selection<uint8_t>(store, key, order, data, lddata);
 }
+/* da_data_select_where */
+da_status da_data_select_where_int(da_datastore store, const char *key, da_int col_idx,
+                                   da_predicate op, da_int n_values, const da_int *values,
+                                   da_selection_combine combine) {
+    return da_data_select_where<da_int>(store, key, col_idx, op, n_values, values,
+                                        combine);
+}
+da_status da_data_select_where_real_d(da_datastore store, const char *key, da_int col_idx,
+                                      da_predicate op, da_int n_values,
+                                      const double *values,
+                                      da_selection_combine combine) {
+    return da_data_select_where<double>(store, key, col_idx, op, n_values, values,
+                                        combine);
+}
+da_status da_data_select_where_real_s(da_datastore store, const char *key, da_int col_idx,
+                                      da_predicate op, da_int n_values,
+                                      const float *values, da_selection_combine combine) {
+    return da_data_select_where<float>(store, key, col_idx, op, n_values, values,
+                                       combine);
+}
+da_status da_data_select_where_uint8(da_datastore store, const char *key, da_int col_idx,
+                                     da_predicate op, da_int n_values,
+                                     const uint8_t *values,
+                                     da_selection_combine combine) {
+    return da_data_select_where<uint8_t>(store, key, col_idx, op, n_values, values,
+                                         combine);
+}
+da_status da_data_select_where_str(da_datastore store, const char *key, da_int col_idx,
+                                   da_predicate op, da_int n_values, const char **values,
+                                   da_selection_combine combine) {
+    return da_data_select_where(store, key, col_idx, op, n_values, values, combine);
+}
+/* da_data_group_by */
+da_status da_data_group_by_real_d(da_datastore store, const char *key, da_int n_by,
+                                  const da_int *by_cols, da_int n_aggs,
+                                  const da_int *agg_cols, const da_aggregation *aggs,
+                                  const double *q, da_datastore result) {
+    return da_data_group_by<double>(store, key, n_by, by_cols, n_aggs, agg_cols, aggs, q,
+                                    result);
+}
+da_status da_data_group_by_real_s(da_datastore store, const char *key, da_int n_by,
+                                  const da_int *by_cols, da_int n_aggs,
+                                  const da_int *agg_cols, const da_aggregation *aggs,
+                                  const float *q, da_datastore result) {
+    return da_data_group_by<float>(store, key, n_by, by_cols, n_aggs, agg_cols, aggs, q,
+                                   result);
+}
+da_status da_data_extract_categorical_features_real_d(da_datastore store,
+                                                      const char *key, da_order order,
+                                                      double *data, da_int lddata,
+                                                      da_int *categorical_features) {
+    return da_data_extract_categorical_features<double>(store, key, order, data, lddata,
+                                                        categorical_features);
+}
+da_status da_data_extract_categorical_features_real_s(da_datastore store,
+                                                      const char *key, da_order order,
+                                                      float *data, da_int lddata,
+                                                      da_int *categorical_features) {
+    return da_data_extract_categorical_features<float>(store, key, order, data, lddata,
+                                                       categorical_features);
+}
+da_status da_data_extract_one_hot_real_d(da_datastore store, const char *key,
+                                         da_int col_idx, da_order order, double *data,
+                                         da_int lddata) {
+    return da_data_extract_one_hot<double>(store, key, col_idx, order, data, lddata);
+}
+da_status da_data_extract_one_hot_real_s(da_datastore store, const char *key,
+                                         da_int col_idx, da_order order, float *data,
+                                         da_int lddata) {
+    return da_data_extract_one_hot<float>(store, key, col_idx, order, data, lddata);
+}
+da_status da_handle_set_data_from_datastore_d(da_handle handle, da_datastore store,
+                                              const char *key) {
+    return da_handle_set_data_from_datastore<double>(handle, store, key);
+}
+da_status da_handle_set_data_from_datastore_s(da_handle handle, da_datastore store,
+                                              const char *key) {
+    return da_handle_set_data_from_datastore<float>(handle, store, key);
+}
+da_status da_handle_set_supervised_data_from_datastore_d(da_handle handle,
+                                                         da_datastore store,
+                                                         const char *key,
+                                                         da_int response_col) {
+    return da_handle_set_supervised_data_from_datastore<double>(handle, store, key,
+                                                                response_col);
+}
+da_status da_handle_set_supervised_data_from_datastore_s(da_handle handle,
+                                                         da_datastore store,
+                                                         const char *key,
+                                                         da_int response_col) {
+    return da_handle_set_supervised_data_from_datastore<float>(handle, store, key,
+                                                               response_col);
+}
 
 /* da_data_get_element */
 da_status da_data_get_element_real_d(da_datastore store, da_int i, da_int j,
@@ -413,6 +506,47 @@ da_status da_correlation_matrix_s(da_order order, da_int n_rows, da_int n_cols,
     return da_correlation_matrix<float>(order, n_rows, n_cols, X, ldx, corr, ldcorr);
 }
 
+da_status da_moments_update_d(da_handle handle, da_int n_rows, da_int n_cols,
+                              const double *X, da_int ldx) {
+    return da_moments_update<double>(handle, n_rows, n_cols, X, ldx);
+}
+da_status da_moments_update_s(da_handle handle, da_int n_rows, da_int n_cols,
+                              const float *X, da_int ldx) {
+    return da_moments_update<float>(handle, n_rows, n_cols, X, ldx);
+}
+
+da_status da_moments_merge_d(da_handle handle, da_handle handle_other) {
+    return da_moments_merge<double>(handle, handle_other);
+}
+da_status da_moments_merge_s(da_handle handle, da_handle handle_other) {
+    return da_moments_merge<float>(handle, handle_other);
+}
+
+da_status da_quantile_sketch_update_d(da_handle handle, da_int n_rows, da_int n_cols,
+                                      const double *X, da_int ldx) {
+    return da_quantile_sketch_update<double>(handle, n_rows, n_cols, X, ldx);
+}
+da_status da_quantile_sketch_update_s(da_handle handle, da_int n_rows, da_int n_cols,
+                                      const float *X, da_int ldx) {
+    return da_quantile_sketch_update<float>(handle, n_rows, n_cols, X, ldx);
+}
+
+da_status da_quantile_sketch_merge_d(da_handle handle, da_handle handle_other) {
+    return da_quantile_sketch_merge<double>(handle, handle_other);
+}
+da_status da_quantile_sketch_merge_s(da_handle handle, da_handle handle_other) {
+    return da_quantile_sketch_merge<float>(handle, handle_other);
+}
+
+da_status da_quantile_sketch_query_d(da_handle handle, da_int n_q, const double *q,
+                                     double *quantiles) {
+    return da_quantile_sketch_query<double>(handle, n_q, q, quantiles);
+}
+da_status da_quantile_sketch_query_s(da_handle handle, da_int n_q, const float *q,
+                                     float *quantiles) {
+    return da_quantile_sketch_query<float>(handle, n_q, q, quantiles);
+}
+
 /* ======================== Linear Model (aoclda_linmod.h) ======================== */
 
 da_status da_linmod_select_model_d(da_handle handle, linmod_model mod) {
@@ -433,6 +567,26 @@ da_status da_linmod_define_features_s(da_handle handle, da_int n_samples,
     return da_linmod_define_features<float>(handle, n_samples, n_features, X, ldx, y);
 }
 
+da_status da_linmod_define_sample_weights_d(da_handle handle, da_int n_samples,
+                                            const double *weights) {
+    return da_linmod_define_sample_weights<double>(handle, n_samples, weights);
+}
+da_status da_linmod_define_sample_weights_s(da_handle handle, da_int n_samples,
+                                            const float *weights) {
+    return da_linmod_define_sample_weights<float>(handle, n_samples, weights);
+}
+
+da_status da_linmod_stream_features_d(da_handle handle, da_int n_samples,
+                                      da_int n_features, const double *X, da_int ldx,
+                                      const double *y) {
+    return da_linmod_stream_features<double>(handle, n_samples, n_features, X, ldx, y);
+}
+da_status da_linmod_stream_features_s(da_handle handle, da_int n_samples,
+                                      da_int n_features, const float *X, da_int ldx,
+                                      const float *y) {
+    return da_linmod_stream_features<float>(handle, n_samples, n_features, X, ldx, y);
+}
+
 da_status da_linmod_fit_d(da_handle handle) { return da_linmod_fit<double>(handle); }
 da_status da_linmod_fit_s(da_handle handle) { return da_linmod_fit<float>(handle); }
 
@@ -457,6 +611,20 @@ da_status da_linmod_evaluate_model_s(da_handle handle, da_int n_samples,
     return da_linmod_evaluate_model<float>(handle, n_samples, n_features, X, ldx,
                                            predictions, observations, loss);
 }
+da_status da_linmod_evaluate_model_ctx_d(da_handle handle, da_inference_context ctx,
+                                         da_int n_samples, da_int n_features,
+                                         const double *X, da_int ldx, double *predictions,
+                                         const double *observations, double *loss) {
+    return da_linmod_evaluate_model<double>(handle, ctx, n_samples, n_features, X, ldx,
+                                            predictions, observations, loss);
+}
+da_status da_linmod_evaluate_model_ctx_s(da_handle handle, da_inference_context ctx,
+                                         da_int n_samples, da_int n_features,
+                                         const float *X, da_int ldx, float *predictions,
+                                         const float *observations, float *loss) {
+    return da_linmod_evaluate_model<float>(handle, ctx, n_samples, n_features, X, ldx,
+                                           predictions, observations, loss);
+}
 
 /* ======================== PCA (aoclda_pca.h) ======================== */
 
@@ -469,9 +637,31 @@ da_status da_pca_set_data_s(da_handle handle, da_int n_samples, da_int n_feature
     return da_pca_set_data<float>(handle, n_samples, n_features, A, lda);
 }
 
+da_status da_pca_set_data_callback_d(da_handle handle, da_int n_samples,
+                                     da_int n_features, da_pca_block_t_d *read_block,
+                                     void *data) {
+    return da_pca_set_data_callback<double>(handle, n_samples, n_features, read_block,
+                                            data);
+}
+da_status da_pca_set_data_callback_s(da_handle handle, da_int n_samples,
+                                     da_int n_features, da_pca_block_t_s *read_block,
+                                     void *data) {
+    return da_pca_set_data_callback<float>(handle, n_samples, n_features, read_block,
+                                           data);
+}
+
 da_status da_pca_compute_d(da_handle handle) { return da_pca_compute<double>(handle); }
 da_status da_pca_compute_s(da_handle handle) { return da_pca_compute<float>(handle); }
 
+da_status da_pca_partial_fit_d(da_handle handle, da_int n_samples, da_int n_features,
+                               const double *A, da_int lda) {
+    return da_pca_partial_fit<double>(handle, n_samples, n_features, A, lda);
+}
+da_status da_pca_partial_fit_s(da_handle handle, da_int n_samples, da_int n_features,
+                               const float *A, da_int lda) {
+    return da_pca_partial_fit<float>(handle, n_samples, n_features, A, lda);
+}
+
 da_status da_pca_transform_d(da_handle handle, da_int m_samples, da_int m_features,
                              const double *X, da_int ldx, double *X_transform,
                              da_int ldx_transform) {
@@ -484,6 +674,18 @@ da_status da_pca_transform_s(da_handle handle, da_int m_samples, da_int m_featur
     return da_pca_transform<float>(handle, m_samples, m_features, X, ldx, X_transform,
                                    ldx_transform);
 }
+da_status da_pca_transform_ctx_d(da_handle handle, da_inference_context ctx,
+                                 da_int m_samples, da_int m_features, const double *X,
+                                 da_int ldx, double *X_transform, da_int ldx_transform) {
+    return da_pca_transform<double>(handle, ctx, m_samples, m_features, X, ldx,
+                                    X_transform, ldx_transform);
+}
+da_status da_pca_transform_ctx_s(da_handle handle, da_inference_context ctx,
+                                 da_int m_samples, da_int m_features, const float *X,
+                                 da_int ldx, float *X_transform, da_int ldx_transform) {
+    return da_pca_transform<float>(handle, ctx, m_samples, m_features, X, ldx,
+                                   X_transform, ldx_transform);
+}
 
 da_status da_pca_inverse_transform_d(da_handle handle, da_int k_samples,
                                      da_int k_features, const double *Y, da_int ldy,
@@ -562,9 +764,103 @@ da_status da_tsne_set_init_embedding_s(da_handle handle, const float *Y, da_int
     return da_tsne_set_init_embedding<float>(handle, Y, ldy);
 }
 
+da_status da_tsne_set_neighbors_d(da_handle handle, da_int n_samples,
+                                  const da_int *row_ptr, const da_int *col_idx,
+                                  const double *distances) {
+    return da_tsne_set_neighbors<double>(handle, n_samples, row_ptr, col_idx, distances);
+}
+da_status da_tsne_set_neighbors_s(da_handle handle, da_int n_samples,
+                                  const da_int *row_ptr, const da_int *col_idx,
+                                  const float *distances) {
+    return da_tsne_set_neighbors<float>(handle, n_samples, row_ptr, col_idx, distances);
+}
+
 da_status da_tsne_compute_d(da_handle handle) { return da_tsne_compute<double>(handle); }
 da_status da_tsne_compute_s(da_handle handle) { return da_tsne_compute<float>(handle); }
 
+da_status da_tsne_transform_d(da_handle handle, da_int m_samples, da_int m_features,
+                              const double *X, da_int ldx, double *X_transform,
+                              da_int ldx_transform) {
+    return da_tsne_transform<double>(handle, m_samples, m_features, X, ldx, X_transform,
+                                     ldx_transform);
+}
+da_status da_tsne_transform_s(da_handle handle, da_int m_samples, da_int m_features,
+                              const float *X, da_int ldx, float *X_transform,
+                              da_int ldx_transform) {
+    return da_tsne_transform<float>(handle, m_samples, m_features, X, ldx, X_transform,
+                                    ldx_transform);
+}
+
+/* ======================== UMAP (aoclda_umap.h) ======================== */
+
+da_status da_umap_set_data_d(da_handle handle, da_int n_samples, da_int n_features,
+                             const double *X, da_int ldx) {
+    return da_umap_set_data<double>(handle, n_samples, n_features, X, ldx);
+}
+da_status da_umap_set_data_s(da_handle handle, da_int n_samples, da_int n_features,
+                             const float *X, da_int ldx) {
+    return da_umap_set_data<float>(handle, n_samples, n_features, X, ldx);
+}
+
+da_status da_umap_compute_d(da_handle handle) { return da_umap_compute<double>(handle); }
+da_status da_umap_compute_s(da_handle handle) { return da_umap_compute<float>(handle); }
+
+da_status da_umap_transform_d(da_handle handle, da_int m_samples, da_int m_features,
+                              const double *X, da_int ldx, double *X_transform,
+                              da_int ldx_transform) {
+    return da_umap_transform<double>(handle, m_samples, m_features, X, ldx, X_transform,
+                                     ldx_transform);
+}
+da_status da_umap_transform_s(da_handle handle, da_int m_samples, da_int m_features,
+                              const float *X, da_int ldx, float *X_transform,
+                              da_int ldx_transform) {
+    return da_umap_transform<float>(handle, m_samples, m_features, X, ldx, X_transform,
+                                    ldx_transform);
+}
+da_status da_umap_transform_ctx_d(da_handle handle, da_inference_context ctx,
+                                  da_int m_samples, da_int m_features, const double *X,
+                                  da_int ldx, double *X_transform, da_int ldx_transform) {
+    return da_umap_transform<double>(handle, ctx, m_samples, m_features, X, ldx,
+                                     X_transform, ldx_transform);
+}
+da_status da_umap_transform_ctx_s(da_handle handle, da_inference_context ctx,
+                                  da_int m_samples, da_int m_features, const float *X,
+                                  da_int ldx, float *X_transform, da_int ldx_transform) {
+    return da_umap_transform<float>(handle, ctx, m_samples, m_features, X, ldx,
+                                    X_transform, ldx_transform);
+}
+
+/* ============ Kernel approximation (aoclda_kernel_approximation.h) ============ */
+
+da_status da_kernel_approx_set_data_d(da_handle handle, da_int n_samples,
+                                      da_int n_features, const double *X, da_int ldx) {
+    return da_kernel_approx_set_data<double>(handle, n_samples, n_features, X, ldx);
+}
+da_status da_kernel_approx_set_data_s(da_handle handle, da_int n_samples,
+                                      da_int n_features, const float *X, da_int ldx) {
+    return da_kernel_approx_set_data<float>(handle, n_samples, n_features, X, ldx);
+}
+
+da_status da_kernel_approx_compute_d(da_handle handle) {
+    return da_kernel_approx_compute<double>(handle);
+}
+da_status da_kernel_approx_compute_s(da_handle handle) {
+    return da_kernel_approx_compute<float>(handle);
+}
+
+da_status da_kernel_approx_transform_d(da_handle handle, da_int m_samples,
+                                       da_int m_features, const double *X, da_int ldx,
+                                       double *X_transform, da_int ldx_transform) {
+    return da_kernel_approx_transform<double>(handle, m_samples, m_features, X, ldx,
+                                              X_transform, ldx_transform);
+}
+da_status da_kernel_approx_transform_s(da_handle handle, da_int m_samples,
+                                       da_int m_features, const float *X, da_int ldx,
+                                       float *X_transform, da_int ldx_transform) {
+    return da_kernel_approx_transform<float>(handle, m_samples, m_features, X, ldx,
+                                             X_transform, ldx_transform);
+}
+
 /* ======================== k-means (aoclda_kmeans.h) ======================== */
 
 da_status da_kmeans_set_data_d(da_handle handle, da_int n_samples, da_int n_features,
@@ -583,6 +879,15 @@ da_status da_kmeans_set_init_centres_s(da_handle handle, const float *C, da_int
     return da_kmeans_set_init_centres<float>(handle, C, ldc);
 }
 
+da_status da_kmeans_set_sample_weights_d(da_handle handle, da_int n_weights,
+                                         const double *weights) {
+    return da_kmeans_set_sample_weights<double>(handle, n_weights, weights);
+}
+da_status da_kmeans_set_sample_weights_s(da_handle handle, da_int n_weights,
+                                         const float *weights) {
+    return da_kmeans_set_sample_weights<float>(handle, n_weights, weights);
+}
+
 da_status da_kmeans_compute_d(da_handle handle) {
     return da_kmeans_compute<double>(handle);
 }
@@ -612,6 +917,33 @@ da_status da_kmeans_predict_s(da_handle handle, da_int k_samples, da_int k_featu
     return da_kmeans_predict<float>(handle, k_samples, k_features, Y, ldy, Y_labels);
 }
 
+da_status da_kmeans_transform_ctx_d(da_handle handle, da_inference_context ctx,
+                                    da_int m_samples, da_int m_features, const double *X,
+                                    da_int ldx, double *X_transform,
+                                    da_int ldx_transform) {
+    return da_kmeans_transform<double>(handle, ctx, m_samples, m_features, X, ldx,
+                                       X_transform, ldx_transform);
+}
+da_status da_kmeans_transform_ctx_s(da_handle handle, da_inference_context ctx,
+                                    da_int m_samples, da_int m_features, const float *X,
+                                    da_int ldx, float *X_transform,
+                                    da_int ldx_transform) {
+    return da_kmeans_transform<float>(handle, ctx, m_samples, m_features, X, ldx,
+                                      X_transform, ldx_transform);
+}
+
+da_status da_kmeans_predict_ctx_d(da_handle handle, da_inference_context ctx,
+                                  da_int k_samples, da_int k_features, const double *Y,
+                                  da_int ldy, da_int *Y_labels) {
+    return da_kmeans_predict<double>(handle, ctx, k_samples, k_features, Y, ldy,
+                                     Y_labels);
+}
+da_status da_kmeans_predict_ctx_s(da_handle handle, da_inference_context ctx,
+                                  da_int k_samples, da_int k_features, const float *Y,
+                                  da_int ldy, da_int *Y_labels) {
+    return da_kmeans_predict<float>(handle, ctx, k_samples, k_features, Y, ldy, Y_labels);
+}
+
 /* ======================== DBSCAN (aoclda_dbscan.h) ======================== */
 
 da_status da_dbscan_set_data_d(da_handle handle, da_int n_samples, da_int n_features,
@@ -647,6 +979,15 @@ da_status da_tree_set_training_data_s(da_handle handle, da_int n_samples,
                                             ldx, y, categorical_features);
 }
 
+da_status da_tree_set_sample_weights_d(da_handle handle, da_int n_weights,
+                                       const double *weights) {
+    return da_tree_set_sample_weights<double>(handle, n_weights, weights);
+}
+da_status da_tree_set_sample_weights_s(da_handle handle, da_int n_weights,
+                                       const float *weights) {
+    return da_tree_set_sample_weights<float>(handle, n_weights, weights);
+}
+
 da_status da_tree_fit_d(da_handle handle) { return da_tree_fit<double>(handle); }
 da_status da_tree_fit_s(da_handle handle) { return da_tree_fit<float>(handle); }
 
@@ -660,6 +1001,18 @@ da_status da_tree_predict_s(da_handle handle, da_int n_samples, da_int n_feature
     return da_tree_predict<float>(handle, n_samples, n_features, X_test, ldx_test,
                                   y_pred);
 }
+da_status da_tree_predict_ctx_d(da_handle handle, da_inference_context ctx,
+                                da_int n_samples, da_int n_features,
+                                const double *X_test, da_int ldx_test, da_int *y_pred) {
+    return da_tree_predict<double>(handle, ctx, n_samples, n_features, X_test, ldx_test,
+                                   y_pred);
+}
+da_status da_tree_predict_ctx_s(da_handle handle, da_inference_context ctx,
+                                da_int n_samples, da_int n_features, const float *X_test,
+                                da_int ldx_test, da_int *y_pred) {
+    return da_tree_predict<float>(handle, ctx, n_samples, n_features, X_test, ldx_test,
+                                  y_pred);
+}
 
 da_status da_tree_predict_proba_d(da_handle handle, da_int n_samples, da_int n_features,
                                   const double *X_test, da_int ldx_test, double *y_proba,
@@ -719,6 +1072,15 @@ da_status da_forest_set_training_data_s(da_handle handle, da_int n_samples,
                                               ldx, y, categorical_features);
 }
 
+da_status da_forest_set_sample_weights_d(da_handle handle, da_int n_weights,
+                                         const double *weights) {
+    return da_forest_set_sample_weights<double>(handle, n_weights, weights);
+}
+da_status da_forest_set_sample_weights_s(da_handle handle, da_int n_weights,
+                                         const float *weights) {
+    return da_forest_set_sample_weights<float>(handle, n_weights, weights);
+}
+
 da_status da_forest_fit_d(da_handle handle) { return da_forest_fit<double>(handle); }
 da_status da_forest_fit_s(da_handle handle) { return da_forest_fit<float>(handle); }
 
@@ -812,6 +1174,37 @@ da_status da_nlls_fit_s(da_handle handle, da_int n_coef, float *coef, void *udat
     return da_nlls_fit<float>(handle, n_coef, coef, udata);
 }
 
+da_status da_nlls_define_residuals_multi_d(da_handle handle,
+                                           da_resfun_multi_t_d *resfun) {
+    return da_nlls_define_residuals_multi<double>(handle, resfun);
+}
+da_status da_nlls_define_residuals_multi_s(da_handle handle,
+                                           da_resfun_multi_t_s *resfun) {
+    return da_nlls_define_residuals_multi<float>(handle, resfun);
+}
+
+da_status da_nlls_define_residuals_batch_d(da_handle handle, da_int n_coef, da_int n_res,
+                                           da_resfun_batch_t_d *resfun,
+                                           da_resgrd_batch_t_d *resgrd) {
+    return da_nlls_define_residuals_batch<double>(handle, n_coef, n_res, resfun, resgrd);
+}
+da_status da_nlls_define_residuals_batch_s(da_handle handle, da_int n_coef, da_int n_res,
+                                           da_resfun_batch_t_s *resfun,
+                                           da_resgrd_batch_t_s *resgrd) {
+    return da_nlls_define_residuals_batch<float>(handle, n_coef, n_res, resfun, resgrd);
+}
+
+da_status da_nlls_fit_batch_d(da_handle handle, da_int n_problems, da_int n_coef,
+                              double *coef, da_status *problem_status, void *udata) {
+    return da_nlls_fit_batch<double>(handle, n_problems, n_coef, coef, problem_status,
+                                     udata);
+}
+da_status da_nlls_fit_batch_s(da_handle handle, da_int n_problems, da_int n_coef,
+                              float *coef, da_status *problem_status, void *udata) {
+    return da_nlls_fit_batch<float>(handle, n_problems, n_coef, coef, problem_status,
+                                    udata);
+}
+
 /* ======================== Pairwise Distances (aoclda_metrics.h) ======================== */
 
 da_status da_pairwise_distances_d(da_order order, da_int m, da_int n, da_int k,
@@ -827,6 +1220,50 @@ da_status da_pairwise_distances_s(da_order order, da_int m, da_int n, da_int k,
     return da_pairwise_distances<float>(order, m, n, k, X, ldx, Y, ldy, D, ldd, p,
                                         metric);
 }
+da_status da_pairwise_distances_argmin_d(da_order order, da_int m, da_int n, da_int k,
+                                         const double *X, da_int ldx, const double *Y,
+                                         da_int ldy, da_int *ind, double *dist, double p,
+                                         da_metric metric) {
+    return da_pairwise_distances_argmin<double>(order, m, n, k, X, ldx, Y, ldy, ind, dist,
+                                                p, metric);
+}
+da_status da_pairwise_distances_argmin_s(da_order order, da_int m, da_int n, da_int k,
+                                         const float *X, da_int ldx, const float *Y,
+                                         da_int ldy, da_int *ind, float *dist, float p,
+                                         da_metric metric) {
+    return da_pairwise_distances_argmin<float>(order, m, n, k, X, ldx, Y, ldy, ind, dist,
+                                               p, metric);
+}
+da_status da_pairwise_distances_argkmin_d(da_order order, da_int m, da_int n, da_int k,
+                                          const double *X, da_int ldx, const double *Y,
+                                          da_int ldy, da_int n_neigh, da_int *ind,
+                                          double *dist, double p, da_metric metric) {
+    return da_pairwise_distances_argkmin<double>(order, m, n, k, X, ldx, Y, ldy, n_neigh,
+                                                 ind, dist, p, metric);
+}
+da_status da_pairwise_distances_argkmin_s(da_order order, da_int m, da_int n, da_int k,
+                                          const float *X, da_int ldx, const float *Y,
+                                          da_int ldy, da_int n_neigh, da_int *ind,
+                                          float *dist, float p, da_metric metric) {
+    return da_pairwise_distances_argkmin<float>(order, m, n, k, X, ldx, Y, ldy, n_neigh,
+                                                ind, dist, p, metric);
+}
+da_status da_pairwise_distances_radius_count_d(da_order order, da_int m, da_int n,
+                                               da_int k, const double *X, da_int ldx,
+                                               const double *Y, da_int ldy, double radius,
+                                               da_int *counts, double p,
+                                               da_metric metric) {
+    return da_pairwise_distances_radius_count<double>(order, m, n, k, X, ldx, Y, ldy,
+                                                      radius, counts, p, metric);
+}
+da_status da_pairwise_distances_radius_count_s(da_order order, da_int m, da_int n,
+                                               da_int k, const float *X, da_int ldx,
+                                               const float *Y, da_int ldy, float radius,
+                                               da_int *counts, float p,
+                                               da_metric metric) {
+    return da_pairwise_distances_radius_count<float>(order, m, n, k, X, ldx, Y, ldy,
+                                                     radius, counts, p, metric);
+}
 
 /* ======================== k-NN (aoclda_nearest_neighbors.h) ======================== */
 
@@ -1055,6 +1492,68 @@ da_status da_sigmoid_kernel_s(da_order order, da_int m, da_int n, da_int k,
     return da_sigmoid_kernel<float>(order, m, n, k, X, ldx, Y, ldy, D, ldd, gamma, coef0);
 }
 
+da_status da_rbf_kernel_apply_d(da_order order, da_int m, da_int n, da_int k,
+                                const double *X, da_int ldx, const double *Y, da_int ldy,
+                                da_int n_rhs, const double *V, da_int ldv, double *U,
+                                da_int ldu, double gamma) {
+    return da_rbf_kernel_apply<double>(order, m, n, k, X, ldx, Y, ldy, n_rhs, V, ldv, U,
+                                       ldu, gamma);
+}
+da_status da_rbf_kernel_apply_s(da_order order, da_int m, da_int n, da_int k,
+                                const float *X, da_int ldx, const float *Y, da_int ldy,
+                                da_int n_rhs, const float *V, da_int ldv, float *U,
+                                da_int ldu, float gamma) {
+    return da_rbf_kernel_apply<float>(order, m, n, k, X, ldx, Y, ldy, n_rhs, V, ldv, U,
+                                      ldu, gamma);
+}
+
+da_status da_linear_kernel_apply_d(da_order order, da_int m, da_int n, da_int k,
+                                   const double *X, da_int ldx, const double *Y,
+                                   da_int ldy, da_int n_rhs, const double *V, da_int ldv,
+                                   double *U, da_int ldu) {
+    return da_linear_kernel_apply<double>(order, m, n, k, X, ldx, Y, ldy, n_rhs, V, ldv,
+                                          U, ldu);
+}
+da_status da_linear_kernel_apply_s(da_order order, da_int m, da_int n, da_int k,
+                                   const float *X, da_int ldx, const float *Y, da_int ldy,
+                                   da_int n_rhs, const float *V, da_int ldv, float *U,
+                                   da_int ldu) {
+    return da_linear_kernel_apply<float>(order, m, n, k, X, ldx, Y, ldy, n_rhs, V, ldv, U,
+                                         ldu);
+}
+
+da_status da_polynomial_kernel_apply_d(da_order order, da_int m, da_int n, da_int k,
+                                       const double *X, da_int ldx, const double *Y,
+                                       da_int ldy, da_int n_rhs, const double *V,
+                                       da_int ldv, double *U, da_int ldu, double gamma,
+                                       da_int degree, double coef0) {
+    return da_polynomial_kernel_apply<double>(order, m, n, k, X, ldx, Y, ldy, n_rhs, V,
+                                              ldv, U, ldu, gamma, degree, coef0);
+}
+da_status da_polynomial_kernel_apply_s(da_order order, da_int m, da_int n, da_int k,
+                                       const float *X, da_int ldx, const float *Y,
+                                       da_int ldy, da_int n_rhs, const float *V,
+                                       da_int ldv, float *U, da_int ldu, float gamma,
+                                       da_int degree, float coef0) {
+    return da_polynomial_kernel_apply<float>(order, m, n, k, X, ldx, Y, ldy, n_rhs, V,
+                                             ldv, U, ldu, gamma, degree, coef0);
+}
+
+da_status da_sigmoid_kernel_apply_d(da_order order, da_int m, da_int n, da_int k,
+                                    const double *X, da_int ldx, const double *Y,
+                                    da_int ldy, da_int n_rhs, const double *V, da_int ldv,
+                                    double *U, da_int ldu, double gamma, double coef0) {
+    return da_sigmoid_kernel_apply<double>(order, m, n, k, X, ldx, Y, ldy, n_rhs, V, ldv,
+                                           U, ldu, gamma, coef0);
+}
+da_status da_sigmoid_kernel_apply_s(da_order order, da_int m, da_int n, da_int k,
+                                    const float *X, da_int ldx, const float *Y,
+                                    da_int ldy, da_int n_rhs, const float *V, da_int ldv,
+                                    float *U, da_int ldu, float gamma, float coef0) {
+    return da_sigmoid_kernel_apply<float>(order, m, n, k, X, ldx, Y, ldy, n_rhs, V, ldv,
+                                          U, ldu, gamma, coef0);
+}
+
 /* ======================== SVM (aoclda_svm.h) ======================== */
 
 da_status da_svm_select_model_d(da_handle handle, da_svm_model mod) {
@@ -1073,6 +1572,15 @@ da_status da_svm_set_data_s(da_handle handle, da_int n_samples, da_int n_feature
     return da_svm_set_data<float>(handle, n_samples, n_features, X, ldx, y);
 }
 
+da_status da_svm_set_sample_weights_d(da_handle handle, da_int n_weights,
+                                      const double *weights) {
+    return da_svm_set_sample_weights<double>(handle, n_weights, weights);
+}
+da_status da_svm_set_sample_weights_s(da_handle handle, da_int n_weights,
+                                      const float *weights) {
+    return da_svm_set_sample_weights<float>(handle, n_weights, weights);
+}
+
 da_status da_svm_compute_d(da_handle handle) { return da_svm_compute<double>(handle); }
 da_status da_svm_compute_s(da_handle handle) { return da_svm_compute<float>(handle); }
 
@@ -1086,6 +1594,18 @@ da_status da_svm_predict_s(da_handle handle, da_int n_samples, da_int n_features
     return da_svm_predict<float>(handle, n_samples, n_features, X_test, ldx_test,
                                  predictions);
 }
+da_status da_svm_predict_ctx_d(da_handle handle, da_inference_context ctx,
+                               da_int n_samples, da_int n_features, const double *X_test,
+                               da_int ldx_test, double *predictions) {
+    return da_svm_predict<double>(handle, ctx, n_samples, n_features, X_test, ldx_test,
+                                  predictions);
+}
+da_status da_svm_predict_ctx_s(da_handle handle, da_inference_context ctx,
+                               da_int n_samples, da_int n_features, const float *X_test,
+                               da_int ldx_test, float *predictions) {
+    return da_svm_predict<float>(handle, ctx, n_samples, n_features, X_test, ldx_test,
+                                 predictions);
+}
 
 da_status da_svm_decision_function_d(da_handle handle, da_int n_samples,
                                      da_int n_features, const double *X_test,
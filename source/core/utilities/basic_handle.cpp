@@ -97,12 +97,22 @@ da_status basic_handle<T>::check_2D_array(da_order order, da_int n_rows, da_int
                                           const std::string &data_name,
                                           const std::string &lddata_name,
                                           da_int n_rows_min, da_int n_cols_min) {
+    return check_2D_array(this->err, order, n_rows, n_cols, data, lddata, n_rows_name,
+                          n_cols_name, data_name, lddata_name, n_rows_min, n_cols_min);
+}
+
+template <typename T>
+da_status basic_handle<T>::check_2D_array(
+    da_errors::da_error_t *err, da_order order, da_int n_rows, da_int n_cols,
+    const T *data, da_int lddata, const std::string &n_rows_name,
+    const std::string &n_cols_name, const std::string &data_name,
+    const std::string &lddata_name, da_int n_rows_min, da_int n_cols_min) {
 
     da_int check_data = 0;
     std::string check_data_str;
     opts.get("check data", check_data_str, check_data);
-    return ARCH::da_utils::check_2D_array(check_data != 0, order, this->err, n_rows,
-                                          n_cols, data, lddata, n_rows_name, n_cols_name,
+    return ARCH::da_utils::check_2D_array(check_data != 0, order, err, n_rows, n_cols,
+                                          data, lddata, n_rows_name, n_cols_name,
                                           data_name, lddata_name, n_rows_min, n_cols_min);
 }
 
@@ -38,6 +38,7 @@
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <vector>
 
 /*
  * Base handle class (basic_handle) that contains members that
@@ -135,6 +136,20 @@ template <typename T> class basic_handle {
     // Whether model was loaded from memory
     bool model_loaded{false};
 
+    // Copies of a data store selection (and of its response column) gathered by
+    // da_handle_set_data_from_datastore, kept alive for as long as the handle may
+    // reference them
+    std::vector<T> datastore_data;
+    std::vector<T> datastore_response;
+    std::vector<da_int> datastore_labels;
+
+    // Free the data store copies once the handle was given other data
+    void release_datastore_data() {
+        datastore_data = std::vector<T>{};
+        datastore_response = std::vector<T>{};
+        datastore_labels = std::vector<da_int>{};
+    }
+
     // Argument checking for a 1D input array, including NaN check if option is set
     // @tparam T Type of the data array: float, double, da_int
     da_status check_1D_array(da_int n, const T *data, const std::string &n_name,
@@ -167,6 +182,13 @@ template <typename T> class basic_handle {
                              const std::string &n_cols_name, const std::string &data_name,
                              const std::string &lddata_name, da_int n_rows_min = 1,
                              da_int n_cols_min = 1);
+    // Same check, recording the error in err instead of the handle's error trace
+    da_status check_2D_array(da_errors::da_error_t *err, da_order order, da_int n_rows,
+                             da_int n_cols, const T *data, da_int lddata,
+                             const std::string &n_rows_name,
+                             const std::string &n_cols_name, const std::string &data_name,
+                             const std::string &lddata_name, da_int n_rows_min = 1,
+                             da_int n_cols_min = 1);
 
     /**
      * @brief Stores a 2D array into the handle, performing necessary checks and transformations.
@@ -186,11 +186,15 @@ da_status _da_handle::print_model_versions() {
 }
 
 template <typename T> da_status _da_handle::check_precision() {
+    return check_precision<T>(this->err);
+}
+
+template <typename T> da_status _da_handle::check_precision(da_errors::da_error_t *err) {
     constexpr da_precision data_prec = std::is_same_v<T, double> ? da_double : da_single;
     if (this->precision != data_prec) {
         std::string user_t_str = std::is_same_v<T, float> ? "float" : "double";
         return da_error(
-            this->err, da_status_wrong_type,
+            err, da_status_wrong_type,
             "The handle was initialized with a different precision type than " +
                 user_t_str + ".");
     }
@@ -199,6 +203,8 @@ template <typename T> da_status _da_handle::check_precision() {
 
 template da_status _da_handle::check_precision<float>();
 template da_status _da_handle::check_precision<double>();
+template da_status _da_handle::check_precision<float>(da_errors::da_error_t *err);
+template da_status _da_handle::check_precision<double>(da_errors::da_error_t *err);
 
 template <> basic_handle<double> *_da_handle::get_alg_handle<double>() {
     return alg_handle_d;
@@ -87,6 +87,8 @@ struct _da_handle {
     // Helper used to see if the supplied data type to the public API
     // is of the same type as the handle.
     template <typename T> da_status check_precision();
+    // Same check, recording the error in err (used by the inference contexts)
+    template <typename T> da_status check_precision(da_errors::da_error_t *err);
 };
 
 #endif
@@ -27,6 +27,7 @@
 
 #include "da_error.hpp"
 #include "da_handle.hpp"
+#include "da_inference_context.hpp"
 #include "macros.h"
 #include "parser.hpp"
 
@@ -179,6 +180,45 @@ da_status da_handle_init(da_handle *handle, da_handle_type handle_type) {
                 return status;
             }
             break;
+        case da_handle_moments:
+            DISPATCHER((*handle)->err,
+                       alg_handle = new da_basic_statistics::moment_accumulator<T>(
+                           *(*handle)->err));
+            status = (*handle)->err->get_status();
+            if (status != da_status_success) {
+                alg_handle = nullptr;
+                return status;
+            }
+            break;
+        case da_handle_quantile_sketch:
+            DISPATCHER((*handle)->err,
+                       alg_handle = new da_basic_statistics::quantile_sketch<T>(
+                           *(*handle)->err));
+            status = (*handle)->err->get_status();
+            if (status != da_status_success) {
+                alg_handle = nullptr;
+                return status;
+            }
+            break;
+        case da_handle_umap:
+            DISPATCHER((*handle)->err,
+                       alg_handle = new da_umap::umap<T>(*(*handle)->err));
+            status = (*handle)->err->get_status();
+            if (status != da_status_success) {
+                alg_handle = nullptr;
+                return status;
+            }
+            break;
+        case da_handle_kernel_approx:
+            DISPATCHER((*handle)->err,
+                       alg_handle = new da_kernel_approx::kernel_approximation<T>(
+                           *(*handle)->err));
+            status = (*handle)->err->get_status();
+            if (status != da_status_success) {
+                alg_handle = nullptr;
+                return status;
+            }
+            break;
         default:
             break;
         }
@@ -282,6 +322,44 @@ da_status da_handle_get_error_severity(da_handle handle, da_severity *severity)
     return da_status_invalid_input;
 }
 
+da_status da_inference_context_init(da_inference_context *ctx) {
+    if (ctx == nullptr)
+        return da_status_invalid_pointer;
+    // LCOV_EXCL_START
+    try {
+        *ctx = new _da_inference_context;
+        (*ctx)->err = new da_errors::da_error_t(da_errors::action_t::DA_RECORD);
+    } catch (std::bad_alloc &) {
+        da_inference_context_destroy(ctx);
+        return da_status_memory_error;
+    }
+    // LCOV_EXCL_STOP
+    return da_status_success;
+}
+
+da_status da_inference_context_print_error_message(da_inference_context ctx) {
+    if (ctx) {
+        if (ctx->err) {
+            ctx->err->print();
+            return da_status_success;
+        } else {
+            return da_status_internal_error; // LCOV_EXCL_LINE
+        }
+    }
+    return da_status_invalid_input;
+}
+
+void da_inference_context_destroy(da_inference_context *ctx) {
+    if (ctx) {
+        if (*ctx) {
+            if ((*ctx)->err)
+                delete (*ctx)->err;
+        }
+        delete (*ctx);
+        *ctx = nullptr;
+    }
+}
+
 void da_handle_refresh(da_handle handle) {
     if (handle) {
         if (handle->alg_handle_s != nullptr)
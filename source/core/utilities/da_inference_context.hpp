@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DA_INFERENCE_CONTEXT_HPP
+#define DA_INFERENCE_CONTEXT_HPP
+
+#include "aoclda.h"
+#include "da_error.hpp"
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Per-caller state used by the inference functions taking a da_inference_context.
+ *
+ * Errors are recorded in the context instead of the handle and temporary arrays are
+ * taken from the context's workspace, so that a trained handle is only read and can be
+ * shared by several threads, each using its own context. The workspace is kept between
+ * calls to avoid repeated allocations.
+ */
+struct _da_inference_context {
+  public:
+    da_errors::da_error_t *err = nullptr;
+    std::vector<double> work_d;
+    std::vector<float> work_s;
+    std::vector<da_int> work_i;
+
+    // Workspace of a given type, can be resized by the caller (may throw bad_alloc)
+    template <typename T> std::vector<T> &workspace() {
+        if constexpr (std::is_same_v<T, double>)
+            return work_d;
+        else if constexpr (std::is_same_v<T, float>)
+            return work_s;
+        else
+            return work_i;
+    }
+
+    // Clear telemetry, for now it only clears the error stack
+    void clear(void) {
+        if (err)
+            err->clear();
+    };
+};
+
+#endif
@@ -30,10 +30,15 @@
 #include "context.hpp"
 #include "da_utils.hpp"
 #include <array>
+#include <atomic>
 #include <immintrin.h>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <stdint.h>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 // ISA type definitions
 // Oracle aux tools expect to use these has index entries: scalar<=idx-1<=count
@@ -77,8 +82,14 @@ enum vectorization_type : da_int {
 //                             Call .get<T>(isa) with the vectorization_type returned
 //                             by Oracle to retrieve the callable kernel.
 //
+//  6. tuning_profile          Optional set of breakpoint rows measured on the host
+//                             (see da_tuning_profile_generate). A profile row that
+//                             matches the running architecture replaces the compiled
+//                             table row with the same key.
+//
 //  Typical call sequence:
-//    vectorization_type optimal_isa = Oracle(my_table, tid<T>(), my_param, "my.isa");
+//    vectorization_type optimal_isa = Oracle(my_table, tid<T>(), my_param, "my.isa",
+//                                            "my.table");
 //    auto kernel            = my_implementations.get<T>(optimal_isa);
 //
 // For usage example, see kmeans elkan kernel assignment.
@@ -174,6 +185,64 @@ template <typename T> bool oracle_lt(T param, T threshold) {
     return (threshold > T(0)) && (param < threshold);
 };
 
+// Tuning profile - host measured replacement rows for the kernel tuning tables
+//
+// Rows are keyed by the table name passed to Oracle as profile_key (e.g. "kmeans.lloyd")
+// and the data type, and are only used when the profile was measured on the
+// architecture currently selected by the context. The profile is read from the file
+// named by the environment variable AOCL_DA_TUNING_PROFILE on first use, and can be
+// replaced with da_tuning_profile_load or da_tuning_profile_generate.
+class tuning_profile {
+  public:
+    using row_t = std::array<KernelSelection, 4>;
+
+    // Rows of a profile, one map per data type keyed by table name. A published
+    // snapshot is never modified, changes publish a new one.
+    struct snapshot {
+        dispatch_architecture arch{generic};
+        std::array<std::map<std::string, row_t, std::less<>>, 3> rows;
+    };
+
+    tuning_profile(const tuning_profile &) = delete;
+    void operator=(const tuning_profile &) = delete;
+
+    // Returns a reference to the global profile
+    static tuning_profile *get_profile();
+
+    // Cheap check used by Oracle before looking up a row
+    bool active() const { return current.load() != nullptr; }
+
+    // Copy the row for (key, dtype) into row, returns false if there is none
+    bool find(const char *key, da_type dtype, dispatch_architecture arch, row_t &row);
+    void set_row(const std::string &key, da_type dtype, const row_t &row);
+    void erase_row(const std::string &key, da_type dtype);
+    // Start an empty profile for arch
+    void reset(dispatch_architecture arch);
+    void clear();
+    // Copy of the active profile (null if there is none) that can be given back to
+    // restore
+    std::unique_ptr<snapshot> copy();
+    void restore(std::unique_ptr<snapshot> snap);
+
+    da_status load(const std::string &filename);
+    da_status save(const std::string &filename);
+
+  private:
+    tuning_profile();
+    static da_int dtype_index(da_type dtype);
+    // Make snap the active profile (none if null), mtx must be held
+    void publish(std::unique_ptr<snapshot> snap);
+
+    // Writers are serialized by mtx and publish a new snapshot through current, so
+    // find() takes no lock. Replaced snapshots are kept in retired until a writer sees
+    // that no find() is running.
+    std::mutex mtx;
+    std::atomic<const snapshot *> current{nullptr};
+    std::atomic<da_int> readers{0};
+    std::unique_ptr<snapshot> owned;
+    std::vector<std::unique_ptr<snapshot>> retired;
+};
+
 // Helper for building tables. Size of array must match with
 // double the context::dispatch_architecture size!
 template <typename ROW> struct TBL {
@@ -202,6 +271,8 @@ template <typename ROW> struct TBL {
 //   oracle   - predicate that decides membership in a bucket (default is oracle_default).
 //   override - optional hidden-settings key (e.g. "kmeans.isa"); if present and set,
 //              bypasses the table and forces the named ISA.
+//   profile_key - optional table name (e.g. "kmeans.lloyd"); if the active tuning
+//              profile has a row for it, that row is used instead of tbl.
 //   The Oracle downgrades avx512 ISA if hardware support is absent or library was built without it.
 //
 // Returns the "optimal" vectorization_type (ISA); falls back to scalar if no row/bucket matches.
@@ -252,11 +323,38 @@ FORCE_INLINE bool get_overridden_isa(const char *override, vectorization_type &i
     return true;
 }
 
+// Downgrade a table ISA if it is not supported by the hardware or the build
+FORCE_INLINE vectorization_type downgrade_isa(vectorization_type isa, da_type dtype) {
+    using v = vectorization_type;
+    [[maybe_unused]] auto *ctx = context::get_context();
+
+    // Special case of half precision kernels where we require separate AVX512_FP16 ISA for all non-scalar kernels
+    if (dtype == da_type::_Float16_t) {
+#ifdef __AVX512FP16__
+        return (ctx->has_avx512_fp16) ? isa : v::scalar;
+#else
+        // This build does not have AVX512_FP16 kernels, downgrade to scalar
+        return v::scalar;
+#endif
+    }
+    if (isa == v::avx512) {
+#ifdef __AVX512F__
+        if (!ctx->has_avx512)
+            isa = v::avx2;
+#else
+        // This build does not have AVX512 kernels
+        isa = v::avx2;
+#endif
+    }
+    return isa;
+}
+
 template <typename ROW, typename P, typename O>
 FORCE_INLINE
     vectorization_type Oracle(const std::array<tblRow<ROW>, TBL<ROW>::nrows> &tbl,
                               da_type dtype, P param, O oracle,
-                              const char *override = nullptr) {
+                              const char *override = nullptr,
+                              const char *profile_key = nullptr) {
     using v = vectorization_type;
     auto *ctx = context::get_context();
 
@@ -267,36 +365,25 @@ FORCE_INLINE
 
     // Get optimal vector length
     const dispatch_architecture arch{ctx->arch};
+    if constexpr (std::is_same_v<ROW, KernelSelection>) {
+        // Rows measured on this machine take precedence over the compiled table
+        tuning_profile::row_t row;
+        auto *profile = profile_key ? tuning_profile::get_profile() : nullptr;
+        if (profile && profile->active() &&
+            profile->find(profile_key, dtype, arch, row)) {
+            for (const auto &t : row) {
+                if (oracle(param, t.threshold))
+                    return downgrade_isa(t.kernel, dtype);
+            }
+        }
+    }
     for (const auto &sel : tbl) {
         if (sel.arch != arch || sel.type != dtype)
             continue;
         for (const auto &t : sel.table) {
             if (oracle(param, t.threshold)) {
-                isa = t.kernel;
-                // Downgrade if ISA not supported
-
-                // Special case of half precision kernels where we require separate AVX512_FP16 ISA for all non-scalar kernels
-                if (dtype == da_type::_Float16_t) {
-#ifdef __AVX512FP16__
-                    isa = ((ctx->has_avx512_fp16) ? isa : v::scalar);
-#else
-                    // This build does not have AVX512_FP16 kernels, downgrade to scalar
-                    isa = v::scalar;
-#endif
-                } else {
-
-                    if (isa == v::avx512) {
-#ifdef __AVX512F__
-                        if (!ctx->has_avx512)
-                            isa = v::avx2;
-#else
-                        // This build does not have AVX512 kernels
-                        isa = v::avx2;
-#endif
-                    }
-                }
                 // Assume minimum ISA is AVX2
-                return isa;
+                return downgrade_isa(t.kernel, dtype);
             }
         }
     }
@@ -307,8 +394,8 @@ FORCE_INLINE
 template <typename ROW, typename P>
 FORCE_INLINE vectorization_type
 Oracle(const std::array<tblRow<ROW>, TBL<ROW>::nrows> &tbl, da_type dtype, P param,
-       const char *override = nullptr) {
-    return Oracle(tbl, dtype, param, oracle_default<P>, override);
+       const char *override = nullptr, const char *profile_key = nullptr) {
+    return Oracle(tbl, dtype, param, oracle_default<P>, override, profile_key);
 }
 
 // Convenience overload for simple ISA selection
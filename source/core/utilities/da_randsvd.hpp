@@ -32,12 +32,14 @@
 #include "boost/random/normal_distribution.hpp"
 #include "da_cblas.hh"
 #include "da_error.hpp"
+#include "da_omp.hpp"
 #include "da_qr.hpp"
 #include "da_std.hpp"
 #include "lapack_templates.hpp"
 #include "macros.h"
 #include <algorithm>
 #include <cstring>
+#include <functional>
 #include <random>
 #include <vector>
 
@@ -81,45 +83,37 @@ void sketch_matmul(bool is_symmetric, CBLAS_TRANSPOSE trans, da_int m, da_int n,
     }
 }
 
-// Computes an orthonormal basis Q for the range of A using a randomized sketch.
-// A: m-by-n, column-major, lda >= m.
-// Q: pre-allocated, ldq >= m, ldq*sketch_size elements; output is m-by-sketch_size.
-// q: No. of power iterations. Set to -1 auto-selects 7 iterations if sketch_size < 0.1*min(m,n), else 4.
-// seed: random seed. Set to -1 for non-deterministic.
-// is_symmetric: set true if A is symmetric.
-template <typename T>
-da_status da_random_rangefinder(da_int m, da_int n, const T *A, da_int lda, T *Q,
-                                da_int ldq, da_int sketch_size, da_int q, da_int seed,
-                                power_normalizer_t normalizer_type,
-                                da_errors::da_error_t &err, bool is_symmetric = false) {
-    da_int q_eff =
-        (q == -1) ? ((sketch_size < static_cast<da_int>(0.1 * std::min(m, n))) ? 7 : 4)
-                  : q;
-
+// Normalizes the columns of a sketch between power iterations of the randomized
+// rangefinder, keeping the workspace alive across iterations.
+template <typename T> class sketch_normalizer {
+    da_int sketch_size;
+    power_normalizer_t normalizer_type;
+    da_errors::da_error_t &err;
     // da_qr performs required allocations of tau(_blocked), R(_blocked)
-    std::vector<T> Omega, Y, Z, tau_blocked, R_blocked, tau, R, Q_buf;
+    std::vector<T> tau_blocked, R_blocked, tau, R, Q_buf;
     std::vector<da_int> ipiv;
     da_int n_blocks_qr = 0, block_sz_qr = 0, final_block_sz_qr = 0;
-    try {
-        Omega.resize(n * sketch_size);
-        Y.resize(m * sketch_size);
-        Z.resize(n * sketch_size);
-        Q_buf.resize(std::max(m, n) * sketch_size);
-        ipiv.resize(sketch_size);
-    } catch (std::bad_alloc &) {
-        return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
-                        "Memory allocation failed.");
-    }
-
-    generate_random_normal_matrix(Omega.data(), n, sketch_size, seed);
 
-    // Y = A * Omega  (initial sketch)
-    sketch_matmul(is_symmetric, CblasNoTrans, m, n, sketch_size, A, lda, Omega.data(), n,
-                  Y.data(), m);
+  public:
+    sketch_normalizer(da_int sketch_size, power_normalizer_t normalizer_type,
+                      da_errors::da_error_t &err)
+        : sketch_size(sketch_size), normalizer_type(normalizer_type), err(err) {}
+
+    // Allocate the workspace for sketches with up to max_rows rows
+    da_status init(da_int max_rows) {
+        try {
+            Q_buf.resize(max_rows * sketch_size);
+            ipiv.resize(sketch_size);
+        } catch (std::bad_alloc &) {
+            return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+        return da_status_success;
+    }
 
     // QR-normalize Y in-place using the blocked parallel da_qr + da_qr_apply.
     // After the call Y holds the explicit orthonormal Q (rows x sketch_size).
-    auto qr_normalize = [&](std::vector<T> &Y, da_int rows) -> da_status {
+    da_status qr(std::vector<T> &Y, da_int rows) {
         // Clear possible stale data from previous da_qr call
         da_std::fill(tau_blocked.begin(), tau_blocked.end(), T{0});
         da_std::fill(R_blocked.begin(), R_blocked.end(), T{0});
@@ -149,11 +143,11 @@ da_status da_random_rangefinder(da_int m, da_int n, const T *A, da_int lda, T *Q
         memcpy(Y.data(), Q_buf.data(),
                static_cast<size_t>(rows) * sketch_size * sizeof(T));
         return da_status_success;
-    };
+    }
 
     // LU-normalize Y in-place: getrf, then extract unit lower-trapezoidal L
     // and apply the row permutation (LAPACK ipiv is 1-based).
-    auto lu_normalize = [&](std::vector<T> &Y, da_int rows) -> da_status {
+    da_status lu(std::vector<T> &Y, da_int rows) {
         da_int info = 0;
         da::getrf(&rows, &sketch_size, Y.data(), &rows, ipiv.data(), &info);
         if (info < 0)
@@ -172,29 +166,66 @@ da_status da_random_rangefinder(da_int m, da_int n, const T *A, da_int lda, T *Q
             }
         }
         return da_status_success;
-    };
+    }
 
-    auto normalizer = [&](std::vector<T> &Y, da_int rows) -> da_status {
+    // Normalize Y with the strategy chosen at construction
+    da_status apply(std::vector<T> &Y, da_int rows) {
         switch (normalizer_type) {
         case power_normalizer_t::lu:
-            return lu_normalize(Y, rows);
+            return lu(Y, rows);
         case power_normalizer_t::none:
             return da_status_success;
         default: // qr
-            return qr_normalize(Y, rows);
+            return qr(Y, rows);
         }
-    };
+    }
+};
+
+// Computes an orthonormal basis Q for the range of A using a randomized sketch.
+// A: m-by-n, column-major, lda >= m.
+// Q: pre-allocated, ldq >= m, ldq*sketch_size elements; output is m-by-sketch_size.
+// q: No. of power iterations. Set to -1 auto-selects 7 iterations if sketch_size < 0.1*min(m,n), else 4.
+// seed: random seed. Set to -1 for non-deterministic.
+// is_symmetric: set true if A is symmetric.
+template <typename T>
+da_status da_random_rangefinder(da_int m, da_int n, const T *A, da_int lda, T *Q,
+                                da_int ldq, da_int sketch_size, da_int q, da_int seed,
+                                power_normalizer_t normalizer_type,
+                                da_errors::da_error_t &err, bool is_symmetric = false) {
+    da_int q_eff =
+        (q == -1) ? ((sketch_size < static_cast<da_int>(0.1 * std::min(m, n))) ? 7 : 4)
+                  : q;
+
+    std::vector<T> Omega, Y, Z;
+    try {
+        Omega.resize(n * sketch_size);
+        Y.resize(m * sketch_size);
+        Z.resize(n * sketch_size);
+    } catch (std::bad_alloc &) {
+        return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    sketch_normalizer<T> normalizer(sketch_size, normalizer_type, err);
+    da_status status = normalizer.init(std::max(m, n));
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+
+    generate_random_normal_matrix(Omega.data(), n, sketch_size, seed);
+
+    // Y = A * Omega  (initial sketch)
+    sketch_matmul(is_symmetric, CblasNoTrans, m, n, sketch_size, A, lda, Omega.data(), n,
+                  Y.data(), m);
 
     // Power iteration
     for (da_int iter = 0; iter < q_eff; ++iter) {
-        da_status status = normalizer(Y, m);
+        status = normalizer.apply(Y, m);
         if (status != da_status_success)
             return status; // LCOV_EXCL_LINE
 
         sketch_matmul(is_symmetric, CblasTrans, m, n, sketch_size, A, lda, Y.data(), m,
                       Z.data(), n);
 
-        status = normalizer(Z, n);
+        status = normalizer.apply(Z, n);
         if (status != da_status_success)
             return status; // LCOV_EXCL_LINE
 
@@ -203,7 +234,7 @@ da_status da_random_rangefinder(da_int m, da_int n, const T *A, da_int lda, T *Q
     }
 
     // Final QR of Y: always orthonormal output regardless of loop normalizer used.
-    da_status status = qr_normalize(Y, m);
+    status = normalizer.qr(Y, m);
     if (status != da_status_success)
         return status; // LCOV_EXCL_LINE
 
@@ -306,6 +337,223 @@ da_status da_random_svd(da_int m, da_int n, const T *A, da_int lda, T *U, da_int
     return da_status_success;
 }
 
+// Reads rows first_row, ..., first_row + n_rows - 1 of a matrix into the column-major
+// array block (leading dimension ldb >= n_rows). Used by the out-of-core variants below.
+template <typename T>
+using row_block_reader_t =
+    std::function<da_status(da_int first_row, da_int n_rows, T *block, da_int ldb)>;
+
+// Rank-k truncated SVD of an m-by-n matrix A that is only accessed through read_block,
+// at most block_size rows at a time, so that A never needs to be held in memory.
+// Each pass over A accumulates Z = A^T * (A * Omega) block by block; the rows of a block
+// are shared among the threads, which sum their partial products into private n-by-
+// sketch_size buffers. After q + 1 such passes, V = orth(Z) spans the same subspace as
+// the rows of B in da_random_svd. A final pass accumulates the R factor of A * V (a TSQR
+// over the row blocks) and the SVD of R gives sigma and Vt, for q + 2 passes in total.
+// Only O((block_size + n) * sketch_size) memory is used per thread and U is not formed.
+// Arguments are as for da_random_svd.
+template <typename T>
+da_status da_random_svd_blocked(da_int m, da_int n,
+                                const row_block_reader_t<T> &read_block,
+                                da_int block_size, T *sigma, T *Vt, da_int ldvt, da_int k,
+                                da_int p, da_int q, da_int seed,
+                                power_normalizer_t normalizer_type,
+                                da_errors::da_error_t &err) {
+
+    da_int sketch_size = k + std::min(p, std::min(m, n) - k);
+    da_int q_eff =
+        (q == -1) ? ((sketch_size < static_cast<da_int>(0.1 * std::min(m, n))) ? 7 : 4)
+                  : q;
+    block_size = std::min(block_size, m);
+
+    // Split the rows of each block among the threads, keeping at least min_chunk rows
+    // per thread so that the partial products remain worthwhile
+    const da_int min_chunk = 64;
+    da_int n_threads =
+        da_utils::get_n_threads_loop(std::max(block_size / min_chunk, (da_int)1));
+    da_int chunk = (block_size + n_threads - 1) / n_threads;
+
+    // Stacked [R; A_chunk * V] used by each thread in the final pass
+    da_int ldw = sketch_size + chunk;
+
+    std::vector<T> block, Omega, Z, Z_thread, Y_thread, W_thread, tau, work, R_all;
+    try {
+        block.resize(block_size * n);
+        Omega.resize(n * sketch_size);
+        Z.resize(n * sketch_size);
+        Z_thread.resize(n_threads * n * sketch_size);
+        Y_thread.resize(n_threads * chunk * sketch_size);
+        W_thread.resize(n_threads * ldw * sketch_size);
+        tau.resize(n_threads * sketch_size);
+        R_all.resize(n_threads * sketch_size * sketch_size);
+    } catch (std::bad_alloc &) {
+        return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    sketch_normalizer<T> normalizer(sketch_size, normalizer_type, err);
+    da_status status = normalizer.init(n);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+
+    // Workspace for geqrf, large enough for both the per-thread and the final reduction
+    da_int info = 0, lwork = -1, rows_max = std::max(ldw, n_threads * sketch_size);
+    T wq = T{0};
+    da::geqrf(&rows_max, &sketch_size, W_thread.data(), &rows_max, tau.data(), &wq,
+              &lwork, &info);
+    lwork = std::max(static_cast<da_int>(wq), sketch_size);
+    try {
+        work.resize(n_threads * lwork);
+    } catch (std::bad_alloc &) {
+        return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    generate_random_normal_matrix(Omega.data(), n, sketch_size, seed);
+
+    // Run one pass over A, calling process(thread, A_chunk, rows) for the chunk of each
+    // block handled by each thread. Blocks are read sequentially on the calling thread.
+    auto stream_pass = [&](auto &&process) -> da_status {
+        for (da_int first_row = 0; first_row < m; first_row += block_size) {
+            da_int n_rows = std::min(block_size, m - first_row);
+            da_status status = read_block(first_row, n_rows, block.data(), n_rows);
+            if (status != da_status_success)
+                return status;
+            da_int n_chunks = (n_rows + chunk - 1) / chunk;
+#pragma omp parallel for num_threads(n_threads) schedule(static, 1)
+            for (da_int c = 0; c < n_chunks; c++) {
+                da_int this_thread = (da_int)omp_get_thread_num();
+                da_int rows = std::min(chunk, n_rows - c * chunk);
+                process(this_thread, block.data() + c * chunk, n_rows, rows);
+            }
+        }
+        return da_status_success;
+    };
+
+    // Subspace iteration: Z = A^T * (A * Omega), normalized between passes
+    for (da_int iter = 0; iter <= q_eff; ++iter) {
+        da_std::fill(Z_thread.begin(), Z_thread.end(), T{0});
+        status = stream_pass([&](da_int t, const T *A_c, da_int lda_c, da_int rows) {
+            T *Y_t = Y_thread.data() + t * chunk * sketch_size;
+            T *Z_t = Z_thread.data() + t * n * sketch_size;
+            da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, rows,
+                                sketch_size, n, T{1}, A_c, lda_c, Omega.data(), n, T{0},
+                                Y_t, rows);
+            da_blas::cblas_gemm(CblasColMajor, CblasTrans, CblasNoTrans, n, sketch_size,
+                                rows, T{1}, A_c, lda_c, Y_t, rows, T{1}, Z_t, n);
+        });
+        if (status != da_status_success)
+            return status;
+
+        // Reduce the partial products of the threads
+        da_int z_size = n * sketch_size;
+        memcpy(Z.data(), Z_thread.data(), static_cast<size_t>(z_size) * sizeof(T));
+        for (da_int t = 1; t < n_threads; ++t) {
+            const T *Z_t = Z_thread.data() + t * z_size;
+#pragma omp simd
+            for (da_int i = 0; i < z_size; ++i)
+                Z[i] += Z_t[i];
+        }
+
+        // The basis fed to the final pass is always orthonormal
+        status = (iter < q_eff) ? normalizer.apply(Z, n) : normalizer.qr(Z, n);
+        if (status != da_status_success)
+            return status; // LCOV_EXCL_LINE
+        Omega.swap(Z);
+    }
+    const T *V = Omega.data();
+
+    // Final pass: each thread folds the rows of A * V that it sees into its own
+    // triangular factor R_t by computing the QR factorization of [R_t; A_chunk * V]
+    da_std::fill(W_thread.begin(), W_thread.end(), T{0});
+    std::vector<da_int> qr_info(n_threads, 0);
+    status = stream_pass([&](da_int t, const T *A_c, da_int lda_c, da_int rows) {
+        T *W_t = W_thread.data() + t * ldw * sketch_size;
+        da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, rows, sketch_size,
+                            n, T{1}, A_c, lda_c, V, n, T{0}, W_t + sketch_size, ldw);
+        da_int rows_w = sketch_size + rows, info_t = 0;
+        da::geqrf(&rows_w, &sketch_size, W_t, &ldw, tau.data() + t * sketch_size,
+                  work.data() + t * lwork, &lwork, &info_t);
+        if (info_t != 0)
+            qr_info[t] = info_t; // LCOV_EXCL_LINE
+        // Keep R in the leading rows and clear everything below the diagonal
+        for (da_int j = 0; j < sketch_size; ++j)
+            da_std::fill(W_t + j * ldw + j + 1, W_t + (j + 1) * ldw, T{0});
+    });
+    if (status != da_status_success)
+        return status;
+    for (da_int t = 0; t < n_threads; ++t) {
+        if (qr_info[t] != 0)
+            return da_error(&err, da_status_internal_error, // LCOV_EXCL_LINE
+                            "da_random_svd_blocked: geqrf failed (info=" +
+                                std::to_string(qr_info[t]) + ").");
+    }
+
+    // Combine the per-thread factors with one more QR factorization of the stacked Rs
+    da_int ldr = n_threads * sketch_size;
+    for (da_int t = 0; t < n_threads; ++t) {
+        for (da_int j = 0; j < sketch_size; ++j)
+            memcpy(R_all.data() + t * sketch_size + j * ldr,
+                   W_thread.data() + t * ldw * sketch_size + j * ldw,
+                   static_cast<size_t>(sketch_size) * sizeof(T));
+    }
+    da::geqrf(&ldr, &sketch_size, R_all.data(), &ldr, tau.data(), work.data(), &lwork,
+              &info);
+    if (info != 0)
+        return da_error(&err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "da_random_svd_blocked: geqrf failed (info=" +
+                            std::to_string(info) + ").");
+
+    // SVD of the small triangular factor: A * V = Q_R * R = (Q_R * U_R) * S * Vt_R
+    std::vector<T> R, U_R, Vt_R, sigma_int, work_svd;
+    std::vector<da_int> iwork;
+    try {
+        R.resize(sketch_size * sketch_size, T{0});
+        U_R.resize(sketch_size * sketch_size);
+        Vt_R.resize(sketch_size * sketch_size);
+        sigma_int.resize(sketch_size);
+        iwork.resize(8 * sketch_size);
+    } catch (std::bad_alloc &) {
+        return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    for (da_int j = 0; j < sketch_size; ++j)
+        for (da_int i = 0; i <= j; ++i)
+            R[i + j * sketch_size] = R_all[i + j * ldr];
+
+    char jobz = 'S';
+    lwork = -1;
+    da::gesdd(&jobz, &sketch_size, &sketch_size, R.data(), &sketch_size, sigma_int.data(),
+              U_R.data(), &sketch_size, Vt_R.data(), &sketch_size, &wq, &lwork,
+              iwork.data(), &info);
+    if (info != 0)
+        return da_error(&err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "da_random_svd_blocked: gesdd failed (info=" +
+                            std::to_string(info) + ").");
+    lwork = static_cast<da_int>(wq);
+    try {
+        work_svd.resize(lwork);
+    } catch (std::bad_alloc &) {
+        return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    da::gesdd(&jobz, &sketch_size, &sketch_size, R.data(), &sketch_size, sigma_int.data(),
+              U_R.data(), &sketch_size, Vt_R.data(), &sketch_size, work_svd.data(),
+              &lwork, iwork.data(), &info);
+    if (info != 0)
+        return da_error(&err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "da_random_svd_blocked: gesdd failed (info=" +
+                            std::to_string(info) + ").");
+
+    for (da_int i = 0; i < k; ++i)
+        sigma[i] = sigma_int[i];
+
+    // Vt = Vt_R[0:k, :] * V^T  (k x n)
+    da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasTrans, k, n, sketch_size, T{1},
+                        Vt_R.data(), sketch_size, V, n, T{0}, Vt, ldvt);
+
+    return da_status_success;
+}
+
 // Top-k eigendecomposition of a symmetric matrix using the randomized rangefinder.
 // A: symmetric m-by-m, column-major, lda >= m; only the upper triangle is read.
 // k: requested number of eigenvalues
@@ -0,0 +1,566 @@
+/* ************************************************************************
+ * Copyright (c) 2026 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "aoclda.h"
+#include "aoclda.hpp"
+#include "context.hpp"
+#include "da_kernel_utils.hpp"
+#include "da_utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+/* Kernel tuning profiles
+ *
+ * A profile is a small text file holding replacement rows for the kernel tuning
+ * tables (kmeans_tuning_tables.hpp, svm_tuning_tables.hpp, kf_tuning_tables.hpp):
+ *
+ *   # comment
+ *   arch zen3
+ *   kmeans.lloyd double 4:scalar 16:avx avx2
+ *
+ * Each row gives the table name, the data type and up to 4 breakpoints
+ * "threshold:isa" with increasing thresholds; the last breakpoint has no threshold
+ * and catches all remaining values of the tuning parameter.
+ */
+
+namespace {
+
+const std::array<const char *, 7> arch_names{
+    "generic", "generic_avx512", "zen2", "zen3", "zen4", "zen5", "zen6"};
+const std::array<const char *, vectorization_type::count> isa_names{"scalar", "avx",
+                                                                   "avx2", "avx512"};
+
+const char *dtype_name(da_type dtype) {
+    switch (dtype) {
+    case da_type::float_t:
+        return "float";
+    case da_type::double_t:
+        return "double";
+    case da_type::_Float16_t:
+        return "half";
+    default:
+        return "undefined";
+    }
+}
+
+bool parse_dtype(const std::string &name, da_type &dtype) {
+    for (da_type t : {da_type::float_t, da_type::double_t, da_type::_Float16_t}) {
+        if (name == dtype_name(t)) {
+            dtype = t;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse_arch(const std::string &name, dispatch_architecture &arch) {
+    for (size_t i = 0; i < arch_names.size(); i++) {
+        if (name == arch_names[i]) {
+            arch = static_cast<dispatch_architecture>(i + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse_isa(const std::string &name, vectorization_type &isa) {
+    for (size_t i = 0; i < isa_names.size(); i++) {
+        if (name == isa_names[i]) {
+            isa = static_cast<vectorization_type>(i + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Parse "threshold:isa" or, for the catch-all breakpoint, "isa"
+bool parse_breakpoint(const std::string &token, KernelSelection &sel) {
+    size_t colon = token.find(':');
+    vectorization_type isa{undefined};
+    if (colon == std::string::npos) {
+        if (!parse_isa(token, isa))
+            return false;
+        sel = KernelSelection(isa);
+        return true;
+    }
+    char *end = nullptr;
+    std::string thr = token.substr(0, colon);
+    long long value = std::strtoll(thr.c_str(), &end, 10);
+    if (thr.empty() || *end != '\0' || value <= 0 || value >= DA_INT_MAX)
+        return false;
+    if (!parse_isa(token.substr(colon + 1), isa))
+        return false;
+    sel = KernelSelection(static_cast<da_int>(value), isa);
+    return true;
+}
+
+} // namespace
+
+tuning_profile::tuning_profile() {
+    // Profile requested at startup, an unreadable or invalid file is ignored
+    const std::string filename{env_get_var<std::string>("AOCL_DA_TUNING_PROFILE", "")};
+    if (!filename.empty())
+        load(filename);
+}
+
+tuning_profile *tuning_profile::get_profile() {
+    // Use Meyer's singleton
+    static tuning_profile global_profile;
+    return &global_profile;
+}
+
+da_int tuning_profile::dtype_index(da_type dtype) {
+    switch (dtype) {
+    case da_type::float_t:
+        return 0;
+    case da_type::double_t:
+        return 1;
+    case da_type::_Float16_t:
+        return 2;
+    default:
+        return -1;
+    }
+}
+
+bool tuning_profile::find(const char *key, da_type dtype, dispatch_architecture arch,
+                          row_t &row) {
+    da_int idx = dtype_index(dtype);
+    if (idx < 0)
+        return false;
+    // While readers is non-zero no writer frees a snapshot, so the one loaded here stays
+    // valid until the row is copied
+    readers.fetch_add(1);
+    const snapshot *snap = current.load();
+    bool found = false;
+    if (snap && snap->arch == arch) {
+        auto it = snap->rows[idx].find(std::string_view(key));
+        if (it != snap->rows[idx].end()) {
+            row = it->second;
+            found = true;
+        }
+    }
+    readers.fetch_sub(1);
+    return found;
+}
+
+void tuning_profile::publish(std::unique_ptr<snapshot> snap) {
+    current.store(snap.get());
+    if (owned)
+        retired.push_back(std::move(owned));
+    owned = std::move(snap);
+    // A find() starting after this point loads the new snapshot
+    if (readers.load() == 0)
+        retired.clear();
+}
+
+void tuning_profile::set_row(const std::string &key, da_type dtype, const row_t &row) {
+    da_int idx = dtype_index(dtype);
+    if (idx < 0)
+        return;
+    std::lock_guard<std::mutex> lock(mtx);
+    auto snap = owned ? std::make_unique<snapshot>(*owned) : std::make_unique<snapshot>();
+    snap->rows[idx][key] = row;
+    publish(std::move(snap));
+}
+
+void tuning_profile::erase_row(const std::string &key, da_type dtype) {
+    da_int idx = dtype_index(dtype);
+    std::lock_guard<std::mutex> lock(mtx);
+    if (idx < 0 || !owned)
+        return;
+    auto snap = std::make_unique<snapshot>(*owned);
+    snap->rows[idx].erase(key);
+    publish(std::move(snap));
+}
+
+void tuning_profile::reset(dispatch_architecture arch) {
+    auto snap = std::make_unique<snapshot>();
+    snap->arch = arch;
+    std::lock_guard<std::mutex> lock(mtx);
+    publish(std::move(snap));
+}
+
+void tuning_profile::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    publish(nullptr);
+}
+
+std::unique_ptr<tuning_profile::snapshot> tuning_profile::copy() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return owned ? std::make_unique<snapshot>(*owned) : nullptr;
+}
+
+void tuning_profile::restore(std::unique_ptr<snapshot> snap) {
+    std::lock_guard<std::mutex> lock(mtx);
+    publish(std::move(snap));
+}
+
+da_status tuning_profile::load(const std::string &filename) {
+    std::ifstream file(filename);
+    if (!file.is_open())
+        return da_status_io_error;
+
+    // Parse everything before touching the active profile
+    auto snap = std::make_unique<snapshot>();
+    bool has_arch{false};
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+        std::istringstream tokens(line);
+        std::string first;
+        if (!(tokens >> first))
+            continue;
+        if (first == "arch") {
+            std::string name, extra;
+            if (has_arch || !(tokens >> name) || !parse_arch(name, snap->arch) ||
+                (tokens >> extra))
+                return da_status_invalid_file_data;
+            has_arch = true;
+            continue;
+        }
+        std::string dtype_str, token;
+        da_type dtype{da_type::undefined};
+        if (!(tokens >> dtype_str) || !parse_dtype(dtype_str, dtype))
+            return da_status_invalid_file_data;
+        row_t row;
+        size_t n_sel{0};
+        while (tokens >> token) {
+            // thresholds must increase and only the last breakpoint can be a catch-all
+            if (n_sel == row.size() ||
+                (n_sel > 0 && row[n_sel - 1].threshold == DA_INT_MAX) ||
+                !parse_breakpoint(token, row[n_sel]) ||
+                (n_sel > 0 && row[n_sel].threshold <= row[n_sel - 1].threshold))
+                return da_status_invalid_file_data;
+            n_sel++;
+        }
+        if (n_sel == 0 || row[n_sel - 1].threshold != DA_INT_MAX)
+            return da_status_invalid_file_data;
+        snap->rows[dtype_index(dtype)][first] = row;
+    }
+    if (!has_arch || file.bad())
+        return da_status_invalid_file_data;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    publish(std::move(snap));
+    return da_status_success;
+}
+
+da_status tuning_profile::save(const std::string &filename) {
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return da_status_io_error;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!owned)
+        return da_status_no_data;
+    file << "# AOCL-DA kernel tuning profile\n";
+    file << "arch " << arch_names[static_cast<size_t>(owned->arch) - 1] << "\n";
+    for (da_type dtype : {da_type::float_t, da_type::double_t, da_type::_Float16_t}) {
+        for (const auto &[key, row] : owned->rows[dtype_index(dtype)]) {
+            file << key << " " << dtype_name(dtype);
+            for (const auto &sel : row) {
+                if (sel.kernel == undefined)
+                    break;
+                file << " ";
+                if (sel.threshold != DA_INT_MAX)
+                    file << sel.threshold << ":";
+                file << isa_names[static_cast<size_t>(sel.kernel) - 1];
+            }
+            file << "\n";
+        }
+    }
+    file.flush();
+    return file.good() ? da_status_success : da_status_io_error;
+}
+
+namespace {
+
+using profile_row = tuning_profile::row_t;
+
+// A measured ISA has to beat the lower ones by this margin to be selected
+constexpr double tuning_tolerance{0.02};
+constexpr da_int tuning_trials{3};
+
+// Best-of-trials wall time of a benchmark run
+template <typename F> da_status time_best(F &&run, double &best) {
+    best = std::numeric_limits<double>::max();
+    for (da_int trial = 0; trial < tuning_trials; trial++) {
+        auto start = std::chrono::steady_clock::now();
+        da_status status = run();
+        auto stop = std::chrono::steady_clock::now();
+        // Hitting the iteration limit is expected with the small benchmark budgets
+        if (status != da_status_success && status != da_status_maxit)
+            return status;
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return da_status_success;
+}
+
+// Turn the winning ISA at each grid point into at most 4 breakpoints. The tables
+// select on param <= threshold unless strict, in which case param < threshold.
+profile_row compress_row(const std::vector<da_int> &grid,
+                         const std::vector<vectorization_type> &winners, bool strict) {
+    std::vector<size_t> start;
+    std::vector<vectorization_type> isa;
+    for (size_t i = 0; i < winners.size(); i++) {
+        if (i == 0 || winners[i] != winners[i - 1]) {
+            start.push_back(i);
+            isa.push_back(winners[i]);
+        }
+    }
+    auto length = [&](size_t k) {
+        return (k + 1 < start.size() ? start[k + 1] : winners.size()) - start[k];
+    };
+    while (start.size() > profile_row().size()) {
+        // Merge the shortest segment into a neighbour
+        size_t k = 0;
+        for (size_t j = 1; j < start.size(); j++)
+            k = (length(j) < length(k)) ? j : k;
+        if (k == 0) {
+            start.erase(start.begin() + 1);
+            isa.erase(isa.begin());
+        } else {
+            start.erase(start.begin() + k);
+            isa.erase(isa.begin() + k);
+        }
+        // Neighbours may now share the same ISA
+        for (size_t j = start.size() - 1; j > 0; j--) {
+            if (isa[j] == isa[j - 1]) {
+                start.erase(start.begin() + j);
+                isa.erase(isa.begin() + j);
+            }
+        }
+    }
+    profile_row row;
+    for (size_t k = 0; k < start.size(); k++) {
+        if (k + 1 == start.size()) {
+            row[k] = KernelSelection(isa[k]);
+        } else {
+            da_int threshold = strict ? grid[start[k + 1]] : grid[start[k + 1] - 1];
+            row[k] = KernelSelection(threshold, isa[k]);
+        }
+    }
+    return row;
+}
+
+// Time run(param) with each candidate ISA forced through a single catch-all profile
+// row, then store the compressed row of winners in the profile
+template <typename T, typename F>
+da_status tune_row(tuning_profile *profile, const char *key, bool strict,
+                   const std::vector<da_int> &grid, F &&run) {
+    // AVX512 kernels are only built for the AVX512 capable architectures
+    auto *ctx = context::get_context();
+    std::vector<vectorization_type> candidates{scalar, avx, avx2};
+    if (ctx->has_avx512 && (ctx->arch == generic_avx512 || ctx->arch >= zen4))
+        candidates.push_back(avx512);
+
+    std::vector<vectorization_type> winners;
+    for (da_int param : grid) {
+        vectorization_type best_isa{scalar};
+        double best_time = std::numeric_limits<double>::max();
+        for (auto isa : candidates) {
+            profile_row trial;
+            trial[0] = KernelSelection(isa);
+            profile->set_row(key, tid<T>(), trial);
+            double time;
+            da_status status = time_best([&]() { return run(param); }, time);
+            if (status != da_status_success) {
+                profile->erase_row(key, tid<T>());
+                return status;
+            }
+            if (time < best_time * (1.0 - tuning_tolerance)) {
+                best_time = time;
+                best_isa = isa;
+            }
+        }
+        winners.push_back(best_isa);
+    }
+    profile->set_row(key, tid<T>(), compress_row(grid, winners, strict));
+    return da_status_success;
+}
+
+// Deterministic benchmark data in [-1, 1)
+template <typename T> std::vector<T> bench_data(da_int size) {
+    std::vector<T> data(size);
+    uint64_t state{12345};
+    for (auto &x : data) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        x = T(2) * T((state >> 40) & 0xFFFFFF) / T(0x1000000) - T(1);
+    }
+    return data;
+}
+
+template <typename T>
+da_status kmeans_run(const std::vector<T> &A, da_int n_samples, da_int n_features,
+                     da_int n_clusters, const char *algorithm) {
+    da_handle handle = nullptr;
+    da_status status = da_handle_init<T>(&handle, da_handle_kmeans);
+    if (status == da_status_success)
+        status = da_options_set_int(handle, "n_clusters", n_clusters);
+    if (status == da_status_success)
+        status = da_options_set_string(handle, "algorithm", algorithm);
+    if (status == da_status_success)
+        status = da_options_set_string(handle, "initialization method", "random");
+    if (status == da_status_success)
+        status = da_options_set_int(handle, "max_iter", 10);
+    if (status == da_status_success)
+        status = da_options_set_int(handle, "seed", 42);
+    if (status == da_status_success)
+        status =
+            da_kmeans_set_data<T>(handle, n_samples, n_features, A.data(), n_samples);
+    if (status == da_status_success)
+        status = da_kmeans_compute<T>(handle);
+    da_handle_destroy(&handle);
+    return status;
+}
+
+template <typename T>
+da_status svm_run(const std::vector<T> &X, const std::vector<T> &y, da_int n_samples,
+                  da_int n_features, da_int max_ws_size) {
+    da_handle handle = nullptr;
+    da_status status = da_handle_init<T>(&handle, da_handle_svm);
+    if (status == da_status_success)
+        status = da_svm_select_model<T>(handle, svc);
+    if (status == da_status_success)
+        status = da_options_set_int(handle, "max_ws_size", max_ws_size);
+    if (status == da_status_success)
+        status = da_options_set_int(handle, "max_iter", 100);
+    if (status == da_status_success)
+        status = da_svm_set_data<T>(handle, n_samples, n_features, X.data(), n_samples,
+                                    y.data());
+    if (status == da_status_success)
+        status = da_svm_compute<T>(handle);
+    da_handle_destroy(&handle);
+    return status;
+}
+
+template <typename T> da_status tune_tables(tuning_profile *profile) {
+    const std::vector<da_int> small_grid{2, 4, 8, 16, 32, 64};
+    const da_int n_samples{2048}, n_features{8}, max_features{64};
+    std::vector<T> A = bench_data<T>(n_samples * max_features);
+
+    da_status status = tune_row<T>(
+        profile, "kmeans.lloyd", false, small_grid, [&](da_int n_clusters) {
+            return kmeans_run(A, n_samples, n_features, n_clusters, "lloyd");
+        });
+    if (status == da_status_success)
+        status = tune_row<T>(
+            profile, "kmeans.elkan_update", false, small_grid, [&](da_int n_clusters) {
+                return kmeans_run(A, n_samples, n_features, n_clusters, "elkan");
+            });
+    if (status == da_status_success)
+        status = tune_row<T>(profile, "kmeans.elkan_reduce", false, small_grid,
+                             [&](da_int n_feat) {
+                                 return kmeans_run(A, n_samples, n_feat, 8, "elkan");
+                             });
+
+    // Kernel functions select on the leading dimension of the column-major X
+    const std::vector<da_int> kf_grid{4, 8, 16, 32, 64, 128, 256};
+    const da_int kf_n{256}, kf_k{16}, kf_calls{10};
+    std::vector<T> D(kf_grid.back() * kf_n);
+    if (status == da_status_success)
+        status = tune_row<T>(profile, "kf", true, kf_grid, [&](da_int m) {
+            da_status kf_status = da_status_success;
+            for (da_int i = 0; i < kf_calls && kf_status == da_status_success; i++)
+                kf_status = da_rbf_kernel<T>(column_major, m, kf_n, kf_k, A.data(), m,
+                                             A.data(), kf_n, D.data(), m, T(0.5));
+            return kf_status;
+        });
+
+    // SVM working set selection is tuned on the working set size, the problem is
+    // sized so that max_ws_size is the one used
+    const std::vector<da_int> ws_grid{32, 64, 128, 256, 512, 1024};
+    std::vector<T> y(2 * ws_grid.back());
+    for (size_t i = 0; i < y.size(); i++)
+        y[i] = (A[i] + A[i + y.size()] > T(0)) ? T(1) : T(0);
+    for (const char *key : {"svm.wssi", "svm.wssj"}) {
+        if (status == da_status_success)
+            status = tune_row<T>(profile, key, true, ws_grid, [&](da_int ws) {
+                return svm_run(A, y, 2 * ws, n_features, ws);
+            });
+    }
+    return status;
+}
+
+} // namespace
+
+da_status da_tuning_profile_generate(const char *filename) {
+    if (filename == nullptr)
+        return da_status_invalid_pointer;
+
+    auto *ctx = context::get_context();
+    auto *profile = tuning_profile::get_profile();
+
+    // A profile loaded by the user is put back if no new one can be measured
+    std::unique_ptr<tuning_profile::snapshot> previous;
+    try {
+        previous = profile->copy();
+    } catch (std::bad_alloc &) {       // LCOV_EXCL_LINE
+        return da_status_memory_error; // LCOV_EXCL_LINE
+    }
+
+    // Hidden ISA overrides would mask the candidates being timed
+    auto &settings = context::get_hidden_settings();
+    std::unordered_map<std::string, std::string> saved_settings;
+    for (const char *key : {"kmeans.isa", "svm.isa", "kf.isa"}) {
+        auto it = settings.find(key);
+        if (it != settings.end()) {
+            saved_settings.insert(*it);
+            settings.erase(it);
+        }
+    }
+
+    da_status status;
+    try {
+        profile->reset(ctx->arch);
+        status = tune_tables<double>(profile);
+        if (status == da_status_success)
+            status = tune_tables<float>(profile);
+        if (status == da_status_success)
+            status = profile->save(filename);
+    } catch (std::bad_alloc &) {      // LCOV_EXCL_LINE
+        status = da_status_memory_error; // LCOV_EXCL_LINE
+    }
+    for (const auto &setting : saved_settings)
+        settings.insert(setting);
+
+    if (status != da_status_success)
+        profile->restore(std::move(previous));
+    return status;
+}
+
+da_status da_tuning_profile_load(const char *filename) {
+    auto *profile = tuning_profile::get_profile();
+    if (filename == nullptr) {
+        profile->clear();
+        return da_status_success;
+    }
+    return profile->load(filename);
+}
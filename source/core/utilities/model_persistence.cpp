@@ -455,6 +455,9 @@ template da_status serialization_buffer::insert_data_in_buffer(const char &data)
 
 template da_status serialization_buffer::serialize_data(const bool &data);
 template da_status serialization_buffer::serialize_data(const da_int &data);
+#ifndef AOCLDA_ILP64
+template da_status serialization_buffer::serialize_data(const int64_t &data);
+#endif
 template da_status serialization_buffer::serialize_data(const std::string &data);
 template da_status serialization_buffer::serialize_data(const char &data);
 template da_status serialization_buffer::serialize_data(const float &data);
@@ -488,6 +491,9 @@ template da_status serialization_buffer::serialize_data(
 // LOAD
 template da_status serialization_buffer::deserialize_data(bool &data);
 template da_status serialization_buffer::deserialize_data(da_int &data);
+#ifndef AOCLDA_ILP64
+template da_status serialization_buffer::deserialize_data(int64_t &data);
+#endif
 template da_status serialization_buffer::deserialize_data(std::string &data);
 template da_status serialization_buffer::deserialize_data(char &data);
 template da_status serialization_buffer::deserialize_data(float &data);
@@ -523,6 +529,9 @@ serialization_buffer::deserialize_data(std::vector<da_vector::da_vector<double>>
 
 template da_status serialization_buffer::dispatch_buffer_io(bool &data);
 template da_status serialization_buffer::dispatch_buffer_io(da_int &data);
+#ifndef AOCLDA_ILP64
+template da_status serialization_buffer::dispatch_buffer_io(int64_t &data);
+#endif
 template da_status serialization_buffer::dispatch_buffer_io(std::string &data);
 template da_status serialization_buffer::dispatch_buffer_io(float &data);
 template da_status serialization_buffer::dispatch_buffer_io(double &data);
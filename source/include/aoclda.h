@@ -41,6 +41,7 @@ extern "C" {
 #include "aoclda_error.h"
 #include "aoclda_handle.h"
 #include "aoclda_interpolation.h"
+#include "aoclda_kernel_approximation.h"
 #include "aoclda_kernel_functions.h"
 #include "aoclda_kmeans.h"
 #include "aoclda_linmod.h"
@@ -54,6 +55,7 @@ extern "C" {
 #include "aoclda_svm.h"
 #include "aoclda_tsne.h"
 #include "aoclda_types.h"
+#include "aoclda_umap.h"
 #include "aoclda_utils.h"
 
 #ifdef __cplusplus
@@ -105,6 +105,19 @@ da_status da_covariance_matrix(da_order order, da_int n_rows, da_int n_cols, con
 template <typename T>
 da_status da_correlation_matrix(da_order order, da_int n_rows, da_int n_cols, const T *X,
                                 da_int ldx, T *corr, da_int ldcorr);
+template <typename T>
+da_status da_moments_update(da_handle handle, da_int n_rows, da_int n_cols, const T *X,
+                            da_int ldx);
+template <typename T>
+da_status da_moments_merge(da_handle handle, da_handle handle_other);
+template <typename T>
+da_status da_quantile_sketch_update(da_handle handle, da_int n_rows, da_int n_cols,
+                                    const T *X, da_int ldx);
+template <typename T>
+da_status da_quantile_sketch_merge(da_handle handle, da_handle handle_other);
+template <typename T>
+da_status da_quantile_sketch_query(da_handle handle, da_int n_q, const T *q,
+                                   T *quantiles);
 
 /* Linear model declarations */
 template <typename T>
@@ -112,6 +125,12 @@ da_status da_linmod_select_model(da_handle handle, linmod_model mod);
 template <typename T>
 da_status da_linmod_define_features(da_handle handle, da_int n_samples, da_int n_features,
                                     const T *X, da_int ldx, const T *y);
+template <typename T>
+da_status da_linmod_define_sample_weights(da_handle handle, da_int n_samples,
+                                          const T *weights);
+template <typename T>
+da_status da_linmod_stream_features(da_handle handle, da_int n_samples, da_int n_features,
+                                    const T *X, da_int ldx, const T *y);
 template <typename T> da_status da_linmod_fit(da_handle handle);
 template <typename T>
 da_status da_linmod_fit_start(da_handle handle, da_int ncoef, const T *coefs);
@@ -119,6 +138,11 @@ template <typename T>
 da_status da_linmod_evaluate_model(da_handle handle, da_int n_samples, da_int n_features,
                                    const T *X, da_int ldx, T *predictions,
                                    const T *observations = nullptr, T *loss = nullptr);
+template <typename T>
+da_status da_linmod_evaluate_model(da_handle handle, da_inference_context ctx,
+                                   da_int n_samples, da_int n_features, const T *X,
+                                   da_int ldx, T *predictions,
+                                   const T *observations = nullptr, T *loss = nullptr);
 
 /* Datastore declarations */
 template <typename T>
@@ -140,16 +164,55 @@ da_status da_data_extract_column(da_datastore store, da_int idx, da_int dim, T *
 template <typename T>
 da_status da_data_extract_selection(da_datastore store, const char *key, da_order order,
                                     T *data, da_int lddata);
+template <typename T>
+da_status da_data_select_where(da_datastore store, const char *key, da_int col_idx,
+                               da_predicate op, da_int n_values, const T *values,
+                               da_selection_combine combine);
+da_status da_data_select_where(da_datastore store, const char *key, da_int col_idx,
+                               da_predicate op, da_int n_values, const char **values,
+                               da_selection_combine combine);
+template <typename T>
+da_status da_data_group_by(da_datastore store, const char *key, da_int n_by,
+                           const da_int *by_cols, da_int n_aggs, const da_int *agg_cols,
+                           const da_aggregation *aggs, const T *q, da_datastore result);
+template <typename T>
+da_status da_data_extract_categorical_features(da_datastore store, const char *key,
+                                               da_order order, T *data, da_int lddata,
+                                               da_int *categorical_features);
+template <typename T>
+da_status da_data_extract_one_hot(da_datastore store, const char *key, da_int col_idx,
+                                  da_order order, T *data, da_int lddata);
+template <typename T>
+da_status da_handle_set_data_from_datastore(da_handle handle, da_datastore store,
+                                            const char *key);
+template <typename T>
+da_status da_handle_set_supervised_data_from_datastore(da_handle handle,
+                                                       da_datastore store,
+                                                       const char *key,
+                                                       da_int response_col);
 
 /* PCA declarations */
 template <typename T>
 da_status da_pca_set_data(da_handle handle, da_int n_samples, da_int n_features,
                           const T *A, da_int lda);
+template <typename T>
+using da_pca_block_t =
+    std::conditional_t<std::is_same_v<T, double>, da_pca_block_t_d, da_pca_block_t_s>;
+template <typename T>
+da_status da_pca_set_data_callback(da_handle handle, da_int n_samples, da_int n_features,
+                                   da_pca_block_t<T> *read_block, void *data);
 template <typename T> da_status da_pca_compute(da_handle handle);
 template <typename T>
+da_status da_pca_partial_fit(da_handle handle, da_int n_samples, da_int n_features,
+                             const T *A, da_int lda);
+template <typename T>
 da_status da_pca_transform(da_handle handle, da_int m_samples, da_int m_features,
                            const T *X, da_int ldx, T *X_transform, da_int ldx_transform);
 template <typename T>
+da_status da_pca_transform(da_handle handle, da_inference_context ctx, da_int m_samples,
+                           da_int m_features, const T *X, da_int ldx, T *X_transform,
+                           da_int ldx_transform);
+template <typename T>
 da_status da_pca_inverse_transform(da_handle handle, da_int k_samples, da_int k_features,
                                    const T *X, da_int ldx, T *X_inv_transform,
                                    da_int ldx_inv_transform);
@@ -160,6 +223,9 @@ da_status da_kmeans_set_data(da_handle handle, da_int n_samples, da_int n_featur
                              const T *A, da_int lda);
 template <typename T>
 da_status da_kmeans_set_init_centres(da_handle handle, const T *C, da_int ldc);
+template <typename T>
+da_status da_kmeans_set_sample_weights(da_handle handle, da_int n_weights,
+                                       const T *weights);
 template <typename T> da_status da_kmeans_compute(da_handle handle);
 template <typename T>
 da_status da_kmeans_transform(da_handle handle, da_int m_samples, da_int m_features,
@@ -168,6 +234,13 @@ da_status da_kmeans_transform(da_handle handle, da_int m_samples, da_int m_featu
 template <typename T>
 da_status da_kmeans_predict(da_handle handle, da_int k_samples, da_int k_features,
                             const T *Y, da_int ldy, da_int *Y_labels);
+template <typename T>
+da_status da_kmeans_transform(da_handle handle, da_inference_context ctx,
+                              da_int m_samples, da_int m_features, const T *X, da_int ldx,
+                              T *X_transform, da_int ldx_transform);
+template <typename T>
+da_status da_kmeans_predict(da_handle handle, da_inference_context ctx, da_int k_samples,
+                            da_int k_features, const T *Y, da_int ldy, da_int *Y_labels);
 
 /* DBSCAN declarations */
 template <typename T>
@@ -182,11 +255,18 @@ da_status da_tree_set_training_data(da_handle handle, da_int n_samples, da_int n
                                     da_int n_class, const T *X, da_int ldx,
                                     const da_int *y,
                                     const da_int *categorical_features = nullptr);
+template <typename T>
+da_status da_tree_set_sample_weights(da_handle handle, da_int n_weights,
+                                     const T *weights);
 template <typename T> da_status da_tree_fit(da_handle handle);
 template <typename T>
 da_status da_tree_predict(da_handle handle, da_int n_obs, da_int n_features,
                           const T *X_test, da_int ldx_test, da_int *y_pred);
 template <typename T>
+da_status da_tree_predict(da_handle handle, da_inference_context ctx, da_int n_obs,
+                          da_int n_features, const T *X_test, da_int ldx_test,
+                          da_int *y_pred);
+template <typename T>
 da_status da_tree_predict_proba(da_handle handle, da_int n_obs, da_int n_features,
                                 const T *X_test, da_int ldx_test, T *y_pred,
                                 da_int n_class, da_int ldy);
@@ -205,6 +285,9 @@ da_status da_forest_set_training_data(da_handle handle, da_int n_samples,
                                       da_int n_features, da_int n_class, const T *X,
                                       da_int ldx, const da_int *y,
                                       const da_int *categorical_features = nullptr);
+template <typename T>
+da_status da_forest_set_sample_weights(da_handle handle, da_int n_weights,
+                                       const T *weights);
 template <typename T> da_status da_forest_fit(da_handle handle);
 template <typename T>
 da_status da_forest_predict(da_handle handle, da_int n_samples, da_int n_features,
@@ -236,6 +319,16 @@ template <typename T>
 using da_reshp_t =
     std::conditional_t<std::is_same_v<T, double>, da_reshp_t_d, da_reshp_t_s>;
 
+template <typename T>
+using da_resfun_multi_t = std::conditional_t<std::is_same_v<T, double>,
+                                             da_resfun_multi_t_d, da_resfun_multi_t_s>;
+template <typename T>
+using da_resfun_batch_t = std::conditional_t<std::is_same_v<T, double>,
+                                             da_resfun_batch_t_d, da_resfun_batch_t_s>;
+template <typename T>
+using da_resgrd_batch_t = std::conditional_t<std::is_same_v<T, double>,
+                                             da_resgrd_batch_t_d, da_resgrd_batch_t_s>;
+
 template <typename T>
 da_status da_nlls_define_residuals(da_handle handle, da_int n_coef, da_int n_res,
                                    da_resfun_t<T> *resfun, da_resgrd_t<T> *resgrd,
@@ -246,12 +339,35 @@ template <typename T>
 da_status da_nlls_define_weights(da_handle handle, da_int n_coef, T *weights);
 template <typename T>
 da_status da_nlls_fit(da_handle handle, da_int n_coef, T *coef, void *udata);
+template <typename T>
+da_status da_nlls_define_residuals_multi(da_handle handle, da_resfun_multi_t<T> *resfun);
+template <typename T>
+da_status da_nlls_define_residuals_batch(da_handle handle, da_int n_coef, da_int n_res,
+                                         da_resfun_batch_t<T> *resfun,
+                                         da_resgrd_batch_t<T> *resgrd);
+template <typename T>
+da_status da_nlls_fit_batch(da_handle handle, da_int n_problems, da_int n_coef, T *coef,
+                            da_status *problem_status, void *udata);
 
 /* Pairwise distances declarations */
 template <typename T>
 da_status da_pairwise_distances(da_order order, da_int m, da_int n, da_int k, const T *X,
                                 da_int ldx, const T *Y, da_int ldy, T *D, da_int ldd, T p,
                                 da_metric metric);
+template <typename T>
+da_status da_pairwise_distances_argmin(da_order order, da_int m, da_int n, da_int k,
+                                       const T *X, da_int ldx, const T *Y, da_int ldy,
+                                       da_int *ind, T *dist, T p, da_metric metric);
+template <typename T>
+da_status da_pairwise_distances_argkmin(da_order order, da_int m, da_int n, da_int k,
+                                        const T *X, da_int ldx, const T *Y, da_int ldy,
+                                        da_int n_neigh, da_int *ind, T *dist, T p,
+                                        da_metric metric);
+template <typename T>
+da_status da_pairwise_distances_radius_count(da_order order, da_int m, da_int n,
+                                             da_int k, const T *X, da_int ldx, const T *Y,
+                                             da_int ldy, T radius, da_int *counts, T p,
+                                             da_metric metric);
 
 /* k-NN declarations */
 template <typename T>
@@ -322,17 +438,42 @@ template <typename T>
 da_status da_sigmoid_kernel(da_order order, da_int m, da_int n, da_int k, const T *X,
                             da_int ldx, const T *Y, da_int ldy, T *D, da_int ldd, T gamma,
                             T coef0);
+template <typename T>
+da_status da_rbf_kernel_apply(da_order order, da_int m, da_int n, da_int k, const T *X,
+                              da_int ldx, const T *Y, da_int ldy, da_int n_rhs,
+                              const T *V, da_int ldv, T *U, da_int ldu, T gamma);
+template <typename T>
+da_status da_linear_kernel_apply(da_order order, da_int m, da_int n, da_int k, const T *X,
+                                 da_int ldx, const T *Y, da_int ldy, da_int n_rhs,
+                                 const T *V, da_int ldv, T *U, da_int ldu);
+template <typename T>
+da_status da_polynomial_kernel_apply(da_order order, da_int m, da_int n, da_int k,
+                                     const T *X, da_int ldx, const T *Y, da_int ldy,
+                                     da_int n_rhs, const T *V, da_int ldv, T *U,
+                                     da_int ldu, T gamma, da_int degree, T coef0);
+template <typename T>
+da_status da_sigmoid_kernel_apply(da_order order, da_int m, da_int n, da_int k,
+                                  const T *X, da_int ldx, const T *Y, da_int ldy,
+                                  da_int n_rhs, const T *V, da_int ldv, T *U, da_int ldu,
+                                  T gamma, T coef0);
 
 /* SVM declarations */
 template <typename T> da_status da_svm_select_model(da_handle handle, da_svm_model mod);
 template <typename T>
 da_status da_svm_set_data(da_handle handle, da_int n_samples, da_int n_features,
                           const T *X, da_int ldx_train, const T *y);
+template <typename T>
+da_status da_svm_set_sample_weights(da_handle handle, da_int n_weights,
+                                    const T *weights);
 template <typename T> da_status da_svm_compute(da_handle handle);
 template <typename T>
 da_status da_svm_predict(da_handle handle, da_int n_samples, da_int n_features,
                          const T *X_test, da_int ldx_test, T *predictions);
 template <typename T>
+da_status da_svm_predict(da_handle handle, da_inference_context ctx, da_int n_samples,
+                         da_int n_features, const T *X_test, da_int ldx_test,
+                         T *predictions);
+template <typename T>
 da_status da_svm_decision_function(da_handle handle, da_int n_samples, da_int n_features,
                                    const T *X_test, da_int ldx_test,
                                    da_svm_decision_function_shape shape,
@@ -407,6 +548,35 @@ da_status da_tsne_set_data(da_handle handle, da_int n_samples, da_int n_features
                            const T *X, da_int ldx);
 template <typename T>
 da_status da_tsne_set_init_embedding(da_handle handle, const T *Y, da_int ldy);
+template <typename T>
+da_status da_tsne_set_neighbors(da_handle handle, da_int n_samples, const da_int *row_ptr,
+                                const da_int *col_idx, const T *distances);
 template <typename T> da_status da_tsne_compute(da_handle handle);
+template <typename T>
+da_status da_tsne_transform(da_handle handle, da_int m_samples, da_int m_features,
+                            const T *X, da_int ldx, T *X_transform, da_int ldx_transform);
+
+/* UMAP declarations */
+template <typename T>
+da_status da_umap_set_data(da_handle handle, da_int n_samples, da_int n_features,
+                           const T *X, da_int ldx);
+template <typename T> da_status da_umap_compute(da_handle handle);
+template <typename T>
+da_status da_umap_transform(da_handle handle, da_int m_samples, da_int m_features,
+                            const T *X, da_int ldx, T *X_transform, da_int ldx_transform);
+template <typename T>
+da_status da_umap_transform(da_handle handle, da_inference_context ctx, da_int m_samples,
+                            da_int m_features, const T *X, da_int ldx, T *X_transform,
+                            da_int ldx_transform);
+
+/* Kernel approximation declarations */
+template <typename T>
+da_status da_kernel_approx_set_data(da_handle handle, da_int n_samples, da_int n_features,
+                                    const T *X, da_int ldx);
+template <typename T> da_status da_kernel_approx_compute(da_handle handle);
+template <typename T>
+da_status da_kernel_approx_transform(da_handle handle, da_int m_samples,
+                                     da_int m_features, const T *X, da_int ldx,
+                                     T *X_transform, da_int ldx_transform);
 
 #endif // AOCLDA_CPP_OVERLOADS
@@ -29,6 +29,7 @@
 #define AOCLDA_BASICSTATS
 
 #include "aoclda_error.h"
+#include "aoclda_handle.h"
 #include "aoclda_types.h"
 
 /**
@@ -474,4 +475,143 @@ da_status da_correlation_matrix_s(da_order order, da_int n_rows, da_int n_cols,
                                   const float *X, da_int ldx, float *corr, da_int ldcorr);
 /** \} */
 
+/** \{
+ * \brief Add a block of rows to a streaming moment accumulator.
+ *
+ * The rows of \p X are treated as observations and the columns as variables. The block is reduced exactly and
+ * combined with the statistics of all the rows previously added to \p handle, so that after any number of calls
+ * the accumulated means, variances, skewnesses, kurtoses and central moments are those of the full data matrix
+ * formed by stacking the blocks, as computed by \ref da_mean_s, \ref da_variance_s, \ref da_skewness_s,
+ * \ref da_kurtosis_s and \ref da_moment_s with \p axis = \ref da_axis_col.
+ *
+ * The storage order of \p X is given by the \p storage \p order option. The highest moment accumulated is set
+ * by the \p moment \p order option, which cannot be changed after the first call.
+ * Results are extracted using \ref da_handle_get_result_s "da_handle_get_result_?".
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_moments.
+ * \param[in] n_rows the number of rows in the block. Constraint: \p n_rows @f$\ge 1@f$.
+ * \param[in] n_cols the number of columns in the block. Constraint: \p n_cols @f$\ge 1@f$, and equal to the value used in previous calls.
+ * \param[in] X the \p n_rows @f$\times @f$ \p n_cols block of data.
+ * \param[in] ldx the leading dimension of \p X. Constraint: \p ldx @f$\ge@f$ \p n_rows if \p X is stored in column-major order, or \p ldx @f$\ge@f$ \p n_cols if \p X is stored in row-major order.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_handle_not_initialized - the handle was not initialized.
+ * - \ref da_status_wrong_type - the precision of the handle does not match that of the function.
+ * - \ref da_status_invalid_handle_type - the handle was not initialized with \ref da_handle_moments.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx was violated.
+ * - \ref da_status_invalid_pointer - \p X is null.
+ * - \ref da_status_invalid_array_dimension - either \p n_rows @f$< 1@f$ or \p n_cols @f$< 1@f$.
+ * - \ref da_status_invalid_input - \p n_cols differs from previous calls, or \p X contains NaNs and the \p check \p data option is set.
+ * - \ref da_status_incompatible_options - the \p moment \p order option was changed after data was added.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_moments_update_d(da_handle handle, da_int n_rows, da_int n_cols,
+                              const double *X, da_int ldx);
+da_status da_moments_update_s(da_handle handle, da_int n_rows, da_int n_cols,
+                              const float *X, da_int ldx);
+/** \} */
+
+/** \{
+ * \brief Merge two streaming moment accumulators.
+ *
+ * On exit, \p handle holds the statistics of the union of the rows added to \p handle and to \p handle_other,
+ * which is left unchanged. This allows partial results computed independently, for example on different threads
+ * or processes, to be combined.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_moments.
+ * \param[in] handle_other a \ref da_handle object of the same precision, initialized with type \ref da_handle_moments.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_handle_not_initialized - one of the handles was not initialized.
+ * - \ref da_status_wrong_type - the precision of one of the handles does not match that of the function.
+ * - \ref da_status_invalid_handle_type - one of the handles was not initialized with \ref da_handle_moments.
+ * - \ref da_status_invalid_input - the two accumulators hold different numbers of columns.
+ * - \ref da_status_incompatible_options - the two accumulators use different values of the \p moment \p order option.
+ */
+da_status da_moments_merge_d(da_handle handle, da_handle handle_other);
+da_status da_moments_merge_s(da_handle handle, da_handle handle_other);
+/** \} */
+
+/** \{
+ * \brief Add a block of rows to a streaming quantile sketch.
+ *
+ * The rows of \p X are treated as observations and the columns as variables. A separate KLL sketch
+ * (Karnin, Lang and Liberty, 2016) is maintained for each column, holding a number of items that depends only on the
+ * \p sketch \p size option and grows at most logarithmically with the number of rows added. The columns are processed in parallel.
+ *
+ * The storage order of \p X is given by the \p storage \p order option. The \p sketch \p size and \p seed options cannot be
+ * changed after the first call. Quantiles are extracted using \ref da_quantile_sketch_query_s "da_quantile_sketch_query_?".
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_quantile_sketch.
+ * \param[in] n_rows the number of rows in the block. Constraint: \p n_rows @f$\ge 1@f$.
+ * \param[in] n_cols the number of columns in the block. Constraint: \p n_cols @f$\ge 1@f$, and equal to the value used in previous calls.
+ * \param[in] X the \p n_rows @f$\times @f$ \p n_cols block of data.
+ * \param[in] ldx the leading dimension of \p X. Constraint: \p ldx @f$\ge@f$ \p n_rows if \p X is stored in column-major order, or \p ldx @f$\ge@f$ \p n_cols if \p X is stored in row-major order.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_handle_not_initialized - the handle was not initialized.
+ * - \ref da_status_wrong_type - the precision of the handle does not match that of the function.
+ * - \ref da_status_invalid_handle_type - the handle was not initialized with \ref da_handle_quantile_sketch.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx was violated.
+ * - \ref da_status_invalid_pointer - \p X is null.
+ * - \ref da_status_invalid_array_dimension - either \p n_rows @f$< 1@f$ or \p n_cols @f$< 1@f$.
+ * - \ref da_status_invalid_input - \p n_cols differs from previous calls, or \p X contains NaNs and the \p check \p data option is set.
+ * - \ref da_status_incompatible_options - the \p sketch \p size option was changed after data was added.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_quantile_sketch_update_d(da_handle handle, da_int n_rows, da_int n_cols,
+                                      const double *X, da_int ldx);
+da_status da_quantile_sketch_update_s(da_handle handle, da_int n_rows, da_int n_cols,
+                                      const float *X, da_int ldx);
+/** \} */
+
+/** \{
+ * \brief Merge two streaming quantile sketches.
+ *
+ * On exit, \p handle holds a sketch of the union of the rows added to \p handle and to \p handle_other,
+ * which is left unchanged. The rank error guarantee of the merged sketch is the same as if all the rows had been added to a single sketch.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_quantile_sketch.
+ * \param[in] handle_other a \ref da_handle object of the same precision, initialized with type \ref da_handle_quantile_sketch.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_handle_not_initialized - one of the handles was not initialized.
+ * - \ref da_status_wrong_type - the precision of one of the handles does not match that of the function.
+ * - \ref da_status_invalid_handle_type - one of the handles was not initialized with \ref da_handle_quantile_sketch.
+ * - \ref da_status_invalid_input - the two sketches hold different numbers of columns.
+ * - \ref da_status_incompatible_options - the two sketches use different values of the \p sketch \p size option.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_quantile_sketch_merge_d(da_handle handle, da_handle handle_other);
+da_status da_quantile_sketch_merge_s(da_handle handle, da_handle handle_other);
+/** \} */
+
+/** \{
+ * \brief Approximate column quantiles from a streaming quantile sketch.
+ *
+ * For each column and each requested probability @f$q@f$, returns a retained value whose rank among the @f$n@f$ rows added so far
+ * is within @f$\varepsilon n@f$ of @f$qn@f$, where @f$\varepsilon@f$ is the normalized rank error returned in the fifth entry of
+ * \ref da_rinfo. With no compaction (fewer than \p sketch \p size rows) this is the exact quantile computed by \ref da_quantile_s with \ref da_quantile_type_1.
+ * The values @f$q=0@f$ and @f$q=1@f$ always return the exact column minimum and maximum.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_quantile_sketch.
+ * \param[in] n_q the number of quantiles requested. Constraint: \p n_q @f$\ge 1@f$.
+ * \param[in] q the array of \p n_q probabilities. Constraint: @f$0 \le q_i \le 1@f$.
+ * \param[out] quantiles the \p n_q @f$\times@f$ \p n_cols array of quantiles, laid out as in \ref da_quantile_s with \p axis = \ref da_axis_col, in the order given by the \p storage \p order option.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_handle_not_initialized - the handle was not initialized.
+ * - \ref da_status_wrong_type - the precision of the handle does not match that of the function.
+ * - \ref da_status_invalid_handle_type - the handle was not initialized with \ref da_handle_quantile_sketch.
+ * - \ref da_status_invalid_pointer - \p q or \p quantiles is null.
+ * - \ref da_status_invalid_input - \p n_q @f$< 1@f$ or one of the probabilities lies outside [0, 1].
+ * - \ref da_status_no_data - no data has been added to the sketch.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_quantile_sketch_query_d(da_handle handle, da_int n_q, const double *q,
+                                     double *quantiles);
+da_status da_quantile_sketch_query_s(da_handle handle, da_int n_q, const float *q,
+                                     float *quantiles);
+/** \} */
+
 #endif
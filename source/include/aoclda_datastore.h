@@ -42,6 +42,98 @@
  */
 typedef struct _da_datastore *da_datastore;
 
+/**
+ * \brief Defines the comparison applied to the values of a column by the predicate selection functions.
+ **/
+enum da_predicate_ {
+    da_pred_equal,         ///< Select the values equal to the operand.
+    da_pred_not_equal,     ///< Select the values different from the operand.
+    da_pred_less,          ///< Select the values strictly lower than the operand.
+    da_pred_less_equal,    ///< Select the values lower than or equal to the operand.
+    da_pred_greater,       ///< Select the values strictly greater than the operand.
+    da_pred_greater_equal, ///< Select the values greater than or equal to the operand.
+    da_pred_between,       ///< Select the values between two operands, bounds included.
+    da_pred_in             ///< Select the values equal to any of the operands.
+};
+
+/** @brief Alias for the \ref da_predicate_ enum. */
+typedef enum da_predicate_ da_predicate;
+
+/**
+ * \brief Defines how the rows satisfying a predicate are combined with the rows of a selection.
+ **/
+enum da_selection_combine_ {
+    da_select_and, ///< Keep the rows of the selection that satisfy the predicate.
+    da_select_or   ///< Add the rows satisfying the predicate to the selection.
+};
+
+/** @brief Alias for the \ref da_selection_combine_ enum. */
+typedef enum da_selection_combine_ da_selection_combine;
+
+/**
+ * \brief Defines the statistic computed for each group by the group-by functions.
+ **/
+enum da_aggregation_ {
+    da_agg_count,    ///< Number of non-missing values.
+    da_agg_sum,      ///< Sum of the values.
+    da_agg_mean,     ///< Arithmetic mean of the values.
+    da_agg_variance, ///< Variance of the values, with \f$n-1\f$ degrees of freedom.
+    da_agg_min,      ///< Smallest value.
+    da_agg_max,      ///< Largest value.
+    da_agg_median,   ///< Median of the values.
+    da_agg_quantile  ///< Quantile of the values, of order given by the \p q argument.
+};
+
+/** @brief Alias for the \ref da_aggregation_ enum. */
+typedef enum da_aggregation_ da_aggregation;
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+/**
+ * @brief Schema structure of the Apache Arrow C data interface.
+ *
+ * See the <a href="https://arrow.apache.org/docs/format/CDataInterface.html">Arrow documentation</a> for a description of
+ * the fields. The definition is guarded by the @p ARROW_C_DATA_INTERFACE macro so that it can be included together with
+ * the Arrow headers.
+ */
+struct ArrowSchema {
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+    void (*release)(struct ArrowSchema *);
+    void *private_data;
+};
+
+/**
+ * @brief Array structure of the Apache Arrow C data interface.
+ *
+ * See the <a href="https://arrow.apache.org/docs/format/CDataInterface.html">Arrow documentation</a> for a description of
+ * the fields.
+ */
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+    void (*release)(struct ArrowArray *);
+    void *private_data;
+};
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
 /**
  * @brief Initialize an empty @ref da_datastore.
  *
@@ -256,6 +348,7 @@ da_status da_data_load_row_str(da_datastore store, da_int n_rows, da_int n_cols,
    :header: "Option Name", "Type", "Default", "Description", "Constraints"
 
    "integers as floats", "integer", ":math:`i=0`", "Whether or not to interpret integers as floating point numbers when using autodetection.", ":math:`0 \le i \le 1`"
+   "categorical strings", "integer", ":math:`i=0`", "Whether or not to store the string columns of CSV files read into a datastore as dictionary-encoded categorical columns.", ":math:`0 \le i \le 1`"
    "datastore precision", "string", ":math:`s=` `double`", "The precision used when reading floating point numbers using autodetection.", ":math:`s=` `double`, or `single`."
    "use header row", "integer", ":math:`i=0`", "Whether or not to interpret the first row as a header.", ":math:`0 \le i \le 1`"
    "warn for missing data", "integer", ":math:`i=0`", "If set to 0, return error if missing data is encountered; if set to 1, issue a warning and store missing data as either a NaN (for floating point data) or the maximum value of the integer type being used.", ":math:`0 \le i \le 1`"
@@ -288,6 +381,69 @@ da_status da_data_load_row_str(da_datastore store, da_int n_rows, da_int n_cols,
  */
 da_status da_data_load_from_csv(da_datastore store, const char *filename);
 
+/**
+ * @brief Load new columns into a @ref da_datastore from Apache Arrow data.
+ *
+ * The data is described by the Arrow C data interface structures @ref ArrowSchema and @ref ArrowArray. It can either be a
+ * record batch (a struct array with format <tt>"+s"</tt>), in which case each child array is added as a column, or a single
+ * array added as one column. The columns are concatenated to the right of the existing ones, as with @ref da_data_load_col_int
+ * "da_data_load_col_?", and are labeled with the names found in the schema, if any.
+ *
+ * Columns are mapped to the data store types as follows:
+ * - float64 (<tt>"g"</tt>), float32 (<tt>"f"</tt>) and uint8 (<tt>"C"</tt>) columns, and the signed integer column matching
+ *   @ref da_int (<tt>"i"</tt> or <tt>"l"</tt>), are used in place without copying the data, unless they contain null entries;
+ * - other integer columns are converted to @ref da_int and boolean columns to uint8;
+ * - utf8 strings (<tt>"u"</tt> and <tt>"U"</tt>), possibly dictionary-encoded with integer indices, are converted to string columns.
+ *
+ * Null entries, marked in the validity bitmaps, are stored with the missing value convention of the data store: NaN for
+ * floating point columns and the maximum value of the type for integer columns. Null strings are stored as empty strings.
+ *
+ * On success, the store takes ownership of @p array: its content is moved into the store, its @p release member is set to
+ * NULL and the release callback of the producer is called when the store no longer needs the data. The data must not be
+ * modified by the producer until then. @p schema is only read and remains owned by the caller.
+ * On failure, neither @p array nor the store are modified.
+ *
+ * @param[inout] store main data structure.
+ * @param[in] schema Arrow schema describing @p array.
+ * @param[inout] array Arrow array to load.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - unsupported format, released array, mismatch between @p schema and @p array or between
+ *        the number of rows of the store and of @p array. Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ * - @ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_data_load_arrow(da_datastore store, const struct ArrowSchema *schema,
+                             struct ArrowArray *array);
+
+/**
+ * @brief Load columns from a file written by @ref da_data_save into a @ref da_datastore.
+ *
+ * The columns listed in @p cols (zero-based indices of the columns in the file, in any order) are concatenated to the right of
+ * the existing ones, as with @ref da_data_load_col_int "da_data_load_col_?", with their types, labels and dictionaries. If
+ * @p n_cols is 0, all the columns of the file are loaded. Only the pages of the requested columns are read from the file.
+ *
+ * On POSIX systems the file is memory mapped: floating point, uint8 and @ref da_int columns stored without compression are
+ * used in place and their pages are only read from disk when accessed. Modifying them in the store does not modify the file.
+ *
+ * @param[inout] store main data structure.
+ * @param[in] filename the relative or absolute path to the file.
+ * @param[in] n_cols number of columns to load, or 0 to load all the columns.
+ * @param[in] cols array of size @p n_cols with the indices of the columns to load. Can be NULL if @p n_cols is 0.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - a column index is out of range or the number of rows of the file does not match the store.
+ * - @ref da_status_io_error - the file could not be opened.
+ * - @ref da_status_invalid_file_data - the file is not a data store file or is corrupted.
+ * - @ref da_status_version_mismatch - the file was written with an unsupported version of the format or byte order.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ * - @ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_data_load(da_datastore store, const char *filename, da_int n_cols,
+                       const da_int *cols);
+
 /* ************************************* selection *********************************** */
 /* *********************************************************************************** */
 /**
@@ -472,6 +628,253 @@ da_status da_data_extract_selection_uint8(da_datastore store, const char *key,
                                           da_order order, uint8_t *data, da_int lddata);
 /** \} */
 
+/** \{ */
+/**
+ * @brief Select the rows where the values of a column satisfy a predicate.
+ *
+ * The rows of column @p col_idx are compared to the operands in @p values according to @p op, and the rows satisfying
+ * the predicate are combined with the row set of the selection @p key:
+ * - with @ref da_select_and, the rows of the selection that do not satisfy the predicate are removed. If the selection does not
+ *   exist or has an empty row set, all the rows of the store are considered part of it;
+ * - with @ref da_select_or, the rows satisfying the predicate are added to the selection. If the selection does not exist or has an
+ *   empty row set, it is considered to have no rows.
+ *
+ * Predicates on several columns are thus built by calling these functions successively on the same selection.
+ * Missing values (see @ref da_data_select_non_missing) never satisfy a predicate. The column set of the selection is not modified.
+ * The column is evaluated in parallel, in chunks of rows, and the result is stored as a set of row intervals.
+ *
+ * The codes of categorical columns (see @ref da_data_load_col_categorical) can be filtered with @ref da_data_select_where_int, and their
+ * string values with @ref da_data_select_where_str.
+ *
+ * @param[inout] store main data structure.
+ * @param[in] key label of the selection.
+ * @param[in] col_idx index of the column to test. Its type must match the type of the function.
+ * @param[in] op comparison to apply, see @ref da_predicate_.
+ * @param[in] n_values number of operands in @p values: 2 for @ref da_pred_between, at least 1 for @ref da_pred_in, and 1 otherwise.
+ * For @ref da_data_select_where_str, only @ref da_pred_equal, @ref da_pred_not_equal and @ref da_pred_in are supported.
+ * @param[in] values array of size @p n_values containing the operands.
+ * @param[in] combine how to combine the result with the selection, see @ref da_selection_combine_.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful. If no rows satisfy the predicate, the selection is marked as containing no rows:
+ *   unlike an empty row set, it is not expanded to all the rows, so extracting it returns no data and further @ref da_select_and predicates
+ *   keep it empty, until rows are added to it again.
+ * - @ref da_status_invalid_input - some of the input data was not correct.
+ *        Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ * - @ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_data_select_where_int(da_datastore store, const char *key, da_int col_idx,
+                                   da_predicate op, da_int n_values, const da_int *values,
+                                   da_selection_combine combine);
+da_status da_data_select_where_real_d(da_datastore store, const char *key, da_int col_idx,
+                                      da_predicate op, da_int n_values,
+                                      const double *values, da_selection_combine combine);
+da_status da_data_select_where_real_s(da_datastore store, const char *key, da_int col_idx,
+                                      da_predicate op, da_int n_values,
+                                      const float *values, da_selection_combine combine);
+da_status da_data_select_where_uint8(da_datastore store, const char *key, da_int col_idx,
+                                     da_predicate op, da_int n_values,
+                                     const uint8_t *values, da_selection_combine combine);
+da_status da_data_select_where_str(da_datastore store, const char *key, da_int col_idx,
+                                   da_predicate op, da_int n_values, const char **values,
+                                   da_selection_combine combine);
+/** \} */
+
+/** \{ */
+/**
+ * @brief Compute statistics of floating point columns for each group of rows sharing the same key.
+ *
+ * The rows of the selection @p key (or all the rows if @p key is NULL; an empty row set is also interpreted as all the rows) are
+ * grouped on the values of the @p n_by columns @p by_cols, which must be integer, boolean (uint8) or categorical columns
+ * (see @ref da_data_load_col_categorical). Rows where any of these columns is missing are ignored.
+ * For each aggregation \f$a\f$, the statistic @p aggs[a] of the column @p agg_cols[a] is then computed for every group, ignoring the
+ * missing values (NaN) of the column; groups without any valid value get a NaN statistic (or a count of 0).
+ *
+ * The result is added as new columns to the store @p result, with one row per group in increasing lexicographic order of the keys:
+ * first the @p n_by key columns (as integer columns, or categorical columns sharing the dictionary of the original column),
+ * then one column per aggregation, of the floating point type of the function, or of integer type for @ref da_agg_count.
+ * The key columns keep the labels of the original columns and the aggregation columns are labeled after their
+ * column and statistic, for example <tt>"price_mean"</tt> or <tt>"price_q0.9"</tt>.
+ *
+ * The rows are hashed in parallel into thread-local tables that are merged at the end, and the groups are aggregated in parallel
+ * using the basic statistics functions, which rely on pairwise summation for accuracy.
+ *
+ * @param[in] store main data structure.
+ * @param[in] key label of the selection, or NULL.
+ * @param[in] n_by number of columns to group on.
+ * @param[in] by_cols array of size @p n_by containing the indices of the columns to group on.
+ * @param[in] n_aggs number of aggregations.
+ * @param[in] agg_cols array of size @p n_aggs containing the indices of the aggregated columns, of the floating point type of the function.
+ * @param[in] aggs array of size @p n_aggs containing the statistics to compute, see @ref da_aggregation_.
+ * @param[in] q array of size @p n_aggs containing the order of the quantiles, between 0 and 1, for the @ref da_agg_quantile aggregations.
+ *            Its other entries are ignored, and it can be NULL if no quantile is requested.
+ * @param[inout] result a different datastore, either empty or with as many rows as there are groups, to which the result columns are added.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - some of the input data was not correct, or there are no rows to group.
+ *        Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_store_not_initialized - one of the stores was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ * - @ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_data_group_by_real_d(da_datastore store, const char *key, da_int n_by,
+                                  const da_int *by_cols, da_int n_aggs,
+                                  const da_int *agg_cols, const da_aggregation *aggs,
+                                  const double *q, da_datastore result);
+da_status da_data_group_by_real_s(da_datastore store, const char *key, da_int n_by,
+                                  const da_int *by_cols, da_int n_aggs,
+                                  const da_int *agg_cols, const da_aggregation *aggs,
+                                  const float *q, da_datastore result);
+/** \} */
+
+/**
+ * @brief Export a selection labeled by @p key as Apache Arrow data.
+ *
+ * The selection is exported as a record batch (a struct array with format <tt>"+s"</tt>) using the Arrow C data interface,
+ * with one child array per selected column, in increasing column order, named after the column labels.
+ * If @p key is NULL, the whole store is exported. Empty row or column sets in the selection are interpreted as all the rows or
+ * columns of the store.
+ *
+ * Floating point, integer and uint8 columns are exported without copying when the selected rows are a single contiguous range
+ * stored contiguously in the store (e.g. in a column-major block); otherwise they are gathered into memory owned by the exported
+ * array. String columns are always copied into utf8 arrays. Missing values (see @ref da_data_select_non_missing) are marked
+ * as null in the validity bitmaps.
+ *
+ * The caller owns @p schema and @p array on success and must call their @p release callbacks when done.
+ *
+ * @note Arrays exported without copying reference the memory of the store: the store must not be modified or destroyed before
+ * @p array is released.
+ *
+ * @param[in] store main data structure.
+ * @param[in] key label of the selection, or NULL.
+ * @param[out] schema Arrow schema of the exported data.
+ * @param[out] array Arrow array of the exported data.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - the selection does not exist or the store is empty. Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ * - @ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_data_export_arrow(da_datastore store, const char *key,
+                               struct ArrowSchema *schema, struct ArrowArray *array);
+
+/**
+ * @brief Save a selection labeled by @p key to a binary columnar file.
+ *
+ * The selected columns are written one after the other, each split into pages of at most 65536 rows. Alongside the data,
+ * the file stores the column types and labels, the dictionaries of categorical columns and, for each page, the minimum and
+ * maximum of the non-missing values and the number of missing values. If @p key is NULL, the whole store is saved. Empty row
+ * or column sets in the selection are interpreted as all the rows or columns of the store.
+ *
+ * If @p compress is 1, pages of numerical and categorical columns are run-length encoded when it makes them smaller, which
+ * is effective for sorted or low-cardinality columns. Such pages are decoded when loaded instead of being used in place.
+ *
+ * The file uses the native byte order and can be read back with @ref da_data_load.
+ *
+ * @param[in] store main data structure.
+ * @param[in] filename the relative or absolute path to the file to create or overwrite.
+ * @param[in] key label of the selection, or NULL.
+ * @param[in] compress 1 to enable the run-length encoding of the pages, 0 otherwise.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - the selection does not exist, the store is empty or @p compress is invalid.
+ * - @ref da_status_io_error - the file could not be written.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ * - @ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_data_save(da_datastore store, const char *filename, const char *key,
+                       da_int compress);
+
+/** \{ */
+/**
+ * @brief Use the selection labeled by @p key as the data matrix of an algorithm handle.
+ *
+ * This is equivalent to extracting the selection with @ref da_data_extract_selection_real_d "da_data_extract_selection_real_?"
+ * and passing it to the data setting function of the handle (@ref da_kmeans_set_data_d "da_kmeans_set_data_?",
+ * @ref da_pca_set_data_d "da_pca_set_data_?" or @ref da_nn_set_data_d "da_nn_set_data_?"), but avoids the intermediate copy where possible:
+ * - if the selection is a contiguous part of a single block of the store, stored in the order given by the <em>storage order</em>
+ *   option of the handle, the handle uses the memory of the block directly;
+ * - otherwise, the selection is gathered once, slice by slice, into memory owned by the handle. This memory is freed
+ *   when the handle is given other data.
+ *
+ * Supervised handles also need a response, use @ref da_handle_set_supervised_data_from_datastore_d "da_handle_set_supervised_data_from_datastore_?" for them.
+ *
+ * Rows of the selection containing missing values (NaN) in any of the selected columns are skipped.
+ * Empty row or column sets in the selection are interpreted as all the rows or columns of the store.
+ *
+ * @note When the memory of the store is used directly, the store must not be modified or destroyed while the handle can still
+ * access the data, as is the case for user arrays passed to the data setting functions.
+ *
+ * @param[inout] handle a @ref da_handle initialized with type @ref da_handle_kmeans, @ref da_handle_pca or @ref da_handle_nn.
+ * @param[in] store main data structure.
+ * @param[in] key label of the selection. All its columns must be of the floating point type of the function.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - the selection does not exist, has columns of another type, or has no rows without missing values.
+ *        Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ * - @ref da_status_handle_not_initialized - the handle was not correctly initialized.
+ * - @ref da_status_invalid_handle_type - the handle type does not support this function.
+ * - @ref da_status_wrong_type - the floating point precision of the function does not match that of the handle.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ * - @ref da_status_memory_error - a memory allocation error occurred.
+ * - any error returned by the data setting function of the handle.
+ *        Use @ref da_handle_print_error_message to get more details.
+ */
+da_status da_handle_set_data_from_datastore_d(da_handle handle, da_datastore store,
+                                              const char *key);
+da_status da_handle_set_data_from_datastore_s(da_handle handle, da_datastore store,
+                                              const char *key);
+/** \} */
+
+/** \{ */
+/**
+ * @brief Use the selection labeled by @p key as the training data of a supervised algorithm handle, and the column @p response_col of the store as its response.
+ *
+ * This behaves as @ref da_handle_set_data_from_datastore_d "da_handle_set_data_from_datastore_?" for the feature matrix, which is passed
+ * together with the response to the data setting function of the handle:
+ * - @ref da_linmod_define_features_d "da_linmod_define_features_?" and @ref da_svm_set_data_d "da_svm_set_data_?": the response column can be
+ *   of the floating point type of the function or integer (including categorical codes), and is converted to floating point;
+ * - @ref da_tree_set_training_data_d "da_tree_set_training_data_?" and @ref da_forest_set_training_data_d "da_forest_set_training_data_?": the
+ *   response column must contain the class labels as integers or categorical codes. The number of classes is deduced from the labels;
+ * - @ref da_nn_set_data_d "da_nn_set_data_?": an integer or categorical response column is passed to @ref da_nn_set_labels_d "da_nn_set_labels_?",
+ *   a floating point one to @ref da_nn_set_targets_d "da_nn_set_targets_?".
+ *
+ * Rows of the selection with a missing value in the selected columns or in the response column are skipped.
+ * The response is always copied into memory owned by the handle, which is freed when the handle is given other data.
+ *
+ * @param[inout] handle a @ref da_handle initialized with type @ref da_handle_linmod, @ref da_handle_svm, @ref da_handle_decision_tree,
+ *                      @ref da_handle_decision_forest or @ref da_handle_nn.
+ * @param[in] store main data structure.
+ * @param[in] key label of the selection. All its columns must be of the floating point type of the function.
+ * @param[in] response_col index of the column of the store holding the response. It must not be one of the columns of the selection.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - the selection does not exist, has columns of another type, has no rows without missing values,
+ *        or @p response_col is invalid, has an incompatible type or is part of the selection.
+ *        Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ * - @ref da_status_handle_not_initialized - the handle was not correctly initialized.
+ * - @ref da_status_invalid_handle_type - the handle type does not support this function.
+ * - @ref da_status_wrong_type - the floating point precision of the function does not match that of the handle.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ * - @ref da_status_memory_error - a memory allocation error occurred.
+ * - any error returned by the data setting functions of the handle.
+ *        Use @ref da_handle_print_error_message to get more details.
+ */
+da_status da_handle_set_supervised_data_from_datastore_d(da_handle handle,
+                                                         da_datastore store,
+                                                         const char *key,
+                                                         da_int response_col);
+da_status da_handle_set_supervised_data_from_datastore_s(da_handle handle,
+                                                         da_datastore store,
+                                                         const char *key,
+                                                         da_int response_col);
+/** \} */
+
 /* ************************************* headings ************************************ */
 /* *********************************************************************************** */
 /**
@@ -523,6 +926,156 @@ da_status da_data_get_col_idx(da_datastore store, const char *label, da_int *col
 da_status da_data_get_col_label(da_datastore store, da_int col_idx, da_int *label_sz,
                                 char *label);
 
+/* ******************************* categorical columns ******************************* */
+/* *********************************************************************************** */
+/**
+ * @brief Add dictionary-encoded categorical columns to the store.
+ *
+ * Each column of the @p n_rows \f$\times\f$ @p n_cols string block is encoded separately: its distinct values form the dictionary
+ * of the column and are assigned integer codes \f$0, 1, \dots\f$ in order of first appearance. Only the codes and the dictionary
+ * are kept in the store, so the strings in @p block can be freed after the call. The columns are encoded in parallel.
+ *
+ * The codes of a categorical column can be extracted and modified as integer data, for example with @ref da_data_extract_column_int.
+ * Entries of @p block that are NULL are stored as missing values.
+ *
+ * @param[inout] store main data structure.
+ * @param[in] n_rows number of rows of the block.
+ * @param[in] n_cols number of columns of the block.
+ * @param[in] block array of C strings of size @p n_rows \f$\times\f$ @p n_cols.
+ * @param[in] order whether @p block is stored in row-major or column-major order.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - some of the input data was not correct.
+ *        Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ * - @ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_data_load_col_categorical(da_datastore store, da_int n_rows, da_int n_cols,
+                                       const char **block, da_order order);
+
+/**
+ * @brief Get the number of categories of a categorical column.
+ *
+ * @param[in] store main data structure.
+ * @param[in] col_idx index of a categorical column.
+ * @param[out] n_categories the size of the dictionary of column @p col_idx.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - @p col_idx is out of range or is not a categorical column.
+ *        Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ */
+da_status da_data_get_n_categories(da_datastore store, da_int col_idx,
+                                   da_int *n_categories);
+
+/**
+ * @brief Get the string value of a category from its code.
+ *
+ * On output the C string @p label will contain the value encoded by @p code in the column @p col_idx. If @p label_sz is smaller
+ * than the size of the value, the function returns @ref da_status_invalid_input and @p label_sz is set to the minimum size required.
+ *
+ * @param[in] store main data structure.
+ * @param[in] col_idx index of a categorical column.
+ * @param[in] code code of the category, between 0 and the number of categories minus 1.
+ * @param[inout] label_sz the size of the C string being provided to the function.
+ * @param[out] label if successful, contains the value of the category on output.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - some of the input data was not correct.
+ *        Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ */
+da_status da_data_get_category_label(da_datastore store, da_int col_idx, da_int code,
+                                     da_int *label_sz, char *label);
+
+/**
+ * @brief Restrict the rows of a selection to those where a categorical column takes a given value.
+ *
+ * The value is looked up once in the dictionary of the column and rows are then filtered by comparing integer codes.
+ * If the selection @p key does not exist, it is created with all the rows of the store before filtering.
+ * The column set of the selection is not modified. This is equivalent to calling @ref da_data_select_where_str with
+ * @ref da_pred_equal and @ref da_select_and.
+ *
+ * @param[inout] store main data structure.
+ * @param[in] key label of the selection.
+ * @param[in] col_idx index of a categorical column.
+ * @param[in] category value to keep. If it is not in the dictionary, no rows are kept.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - some of the input data was not correct.
+ *        Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ */
+da_status da_data_select_category(da_datastore store, const char *key, da_int col_idx,
+                                  const char *category);
+
+/** \{ */
+/**
+ * @brief Extract a selection as a feature matrix, with categorical columns encoded as integer codes.
+ *
+ * The selected columns must be categorical or of the floating point type of the function. Categorical columns are written
+ * as their codes (missing values become NaN) and @p categorical_features[j] is set to the number of categories of column \f$j\f$ of
+ * the output; it is set to 0 for the other columns. This is the layout expected by the <em>categorical features</em> input
+ * of @ref da_tree_set_training_data_d "da_tree_set_training_data_?" and @ref da_forest_set_training_data_d "da_forest_set_training_data_?".
+ * If @p key is NULL, the whole store is extracted. Empty row or column sets in the selection are interpreted as all the rows or
+ * columns of the store.
+ *
+ * @param[in] store main data structure.
+ * @param[in] key label of the selection, or NULL.
+ * @param[in] order whether @p data is to be stored in row-major or column-major order.
+ * @param[out] data array of size at least @p lddata \f$\times\f$ the number of selected columns (column-major) or rows (row-major).
+ * @param[in] lddata leading dimension of @p data.
+ * @param[out] categorical_features array of size at least the number of selected columns.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - some of the input data was not correct.
+ *        Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_invalid_leading_dimension - @p lddata is too small.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ */
+da_status da_data_extract_categorical_features_real_d(da_datastore store,
+                                                      const char *key, da_order order,
+                                                      double *data, da_int lddata,
+                                                      da_int *categorical_features);
+da_status da_data_extract_categorical_features_real_s(da_datastore store,
+                                                      const char *key, da_order order,
+                                                      float *data, da_int lddata,
+                                                      da_int *categorical_features);
+/** \} */
+
+/** \{ */
+/**
+ * @brief Extract a categorical column as a one-hot encoded block.
+ *
+ * Column \f$k\f$ of the output is 1 in the rows where column @p col_idx takes the value of code \f$k\f$ and 0 elsewhere, so
+ * the output has as many columns as there are categories (see @ref da_data_get_n_categories). Rows with a missing value are
+ * all zeros. Only the rows of the selection @p key are extracted; if @p key is NULL or the selection has an empty row set,
+ * all the rows are extracted.
+ *
+ * @param[in] store main data structure.
+ * @param[in] key label of the selection, or NULL.
+ * @param[in] col_idx index of a categorical column.
+ * @param[in] order whether @p data is to be stored in row-major or column-major order.
+ * @param[out] data array of size at least @p lddata \f$\times\f$ the number of categories (column-major) or rows (row-major).
+ * @param[in] lddata leading dimension of @p data.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - some of the input data was not correct.
+ *        Use @ref da_datastore_print_error_message to get more details.
+ * - @ref da_status_invalid_leading_dimension - @p lddata is too small.
+ * - @ref da_status_store_not_initialized - the store was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ */
+da_status da_data_extract_one_hot_real_d(da_datastore store, const char *key,
+                                         da_int col_idx, da_order order, double *data,
+                                         da_int lddata);
+da_status da_data_extract_one_hot_real_s(da_datastore store, const char *key,
+                                         da_int col_idx, da_order order, float *data,
+                                         da_int lddata);
+/** \} */
+
 /* ********************************** setters/getters ******************************** */
 /* *********************************************************************************** */
 /** \{ */
@@ -67,6 +67,31 @@ da_status da_tree_set_training_data_s(da_handle handle, da_int n_samples,
                                       const da_int *categorical_features);
 /** \} */
 
+/** \{
+ * @brief Pass optional sample weights to a \ref da_handle object initialized for a decision tree.
+ *
+ * Sample weights are used as integer frequencies: a weight of 2 counts the observation twice in the class counts used to score the splits and
+ * a weight of 0 removes it from the training set. The weights must therefore be non-negative whole numbers with a positive sum.
+ *
+ * The array is not copied and must remain valid until :ref:`da_tree_fit_? <da_tree_fit>` has been called. A subsequent call to
+ * :ref:`da_tree_set_training_data_? <da_tree_set_training_data>` removes the weights, as does calling this function with \p n_weights = 0.
+ *
+ * @param[inout] handle a @ref da_handle object, initialized with type @ref da_handle_decision_tree.
+ * @param[in] n_weights number of weights, must be equal to the number of samples passed to the handle, or 0 to remove the weights.
+ * @param[in] weights array of size \p n_weights containing the sample weights.
+ * @return @ref da_status.  The function returns:
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - @ref da_status_invalid_pointer - the @p handle has not been correctly initialized, or \p weights is NULL.
+ * - @ref da_status_no_data - :ref:`da_tree_set_training_data_? <da_tree_set_training_data>` has not been called.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using @ref da_handle_print_error_message.
+ */
+da_status da_tree_set_sample_weights_d(da_handle handle, da_int n_weights,
+                                       const double *weights);
+da_status da_tree_set_sample_weights_s(da_handle handle, da_int n_weights,
+                                       const float *weights);
+/** \} */
+
 /** \{
  * @brief Pass a data matrix and a label array to the \ref da_handle object
  * in preparation for fitting a decision forest.
@@ -97,6 +122,32 @@ da_status da_forest_set_training_data_s(da_handle handle, da_int n_samples,
                                         const da_int *categorical_features);
 /** \} */
 
+/** \{
+ * @brief Pass optional sample weights to a \ref da_handle object initialized for a decision forest.
+ *
+ * When the <em>bootstrap</em> option is set (the default), each tree draws its bootstrap samples with probabilities proportional to the weights,
+ * so any non-negative real weights with a positive sum can be used.
+ * When bootstrap is disabled, the weights are used by each tree as integer frequencies and must be whole numbers.
+ *
+ * The array is not copied and must remain valid until :ref:`da_forest_fit_? <da_forest_fit>` has been called. A subsequent call to
+ * :ref:`da_forest_set_training_data_? <da_forest_set_training_data>` removes the weights, as does calling this function with \p n_weights = 0.
+ *
+ * @param[inout] handle a @ref da_handle object, initialized with type @ref da_handle_decision_forest.
+ * @param[in] n_weights number of weights, must be equal to the number of samples passed to the handle, or 0 to remove the weights.
+ * @param[in] weights array of size \p n_weights containing the sample weights.
+ * @return @ref da_status.  The function returns:
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - @ref da_status_invalid_pointer - the @p handle has not been correctly initialized, or \p weights is NULL.
+ * - @ref da_status_no_data - :ref:`da_forest_set_training_data_? <da_forest_set_training_data>` has not been called.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using @ref da_handle_print_error_message.
+ */
+da_status da_forest_set_sample_weights_d(da_handle handle, da_int n_weights,
+                                         const double *weights);
+da_status da_forest_set_sample_weights_s(da_handle handle, da_int n_weights,
+                                         const float *weights);
+/** \} */
+
 /** \{
  * @brief Fit the decision tree defined in the @p handle.
  *
@@ -191,6 +242,31 @@ da_status da_tree_predict_s(da_handle handle, da_int n_samples, da_int n_feature
                             const float *X_test, da_int ldx_test, da_int *y_pred);
 /** \} */
 
+/** \{
+ * @brief Generate labels using fitted decision tree and an inference context.
+ *
+ * Reentrant variant of \ref da_tree_predict_s "da_tree_predict_?". The handle is only read and error information is kept
+ * in @p ctx, so several threads may call this function concurrently on the same fitted handle provided each of them
+ * passes its own \ref da_inference_context. Row-major data is read in place rather than copied.
+ *
+ * @param[in] handle a @ref da_handle object, initialized with type @ref da_handle_decision_tree and fitted with \ref da_tree_fit_s "da_tree_fit_?".
+ * @param[inout] ctx a \ref da_inference_context initialized with \ref da_inference_context_init. Errors can be printed using \ref da_inference_context_print_error_message.
+ * @param[in] n_samples see \ref da_tree_predict_s "da_tree_predict_?".
+ * @param[in] n_features see \ref da_tree_predict_s "da_tree_predict_?".
+ * @param[in] X_test see \ref da_tree_predict_s "da_tree_predict_?".
+ * @param[in] ldx_test see \ref da_tree_predict_s "da_tree_predict_?".
+ * @param[out] y_pred see \ref da_tree_predict_s "da_tree_predict_?".
+ * @return da_status. The function returns the same values as \ref da_tree_predict_s "da_tree_predict_?", and additionally:
+ * - @ref da_status_invalid_pointer - @p ctx is a null pointer.
+ */
+da_status da_tree_predict_ctx_d(da_handle handle, da_inference_context ctx,
+                                da_int n_samples, da_int n_features,
+                                const double *X_test, da_int ldx_test, da_int *y_pred);
+da_status da_tree_predict_ctx_s(da_handle handle, da_inference_context ctx,
+                                da_int n_samples, da_int n_features, const float *X_test,
+                                da_int ldx_test, da_int *y_pred);
+/** \} */
+
 /** \{
  * @brief Generate class probabilities using fitted decision tree on a new set of data @p X_test.
  *
@@ -81,6 +81,18 @@ enum da_handle_type_ {
     da_handle_tsne, ///< @rst
                     ///< the handle is to be used with functions for computing the :ref:`t-SNE <tsne_intro>`.
                     ///< @endrst
+    da_handle_moments, ///< @rst
+                       ///< the handle is to be used with the :ref:`streaming moment accumulator <moment_accumulators>` functions.
+                       ///< @endrst
+    da_handle_quantile_sketch, ///< @rst
+                               ///< the handle is to be used with the :ref:`streaming quantile sketch <quantile_sketches>` functions.
+                               ///< @endrst
+    da_handle_umap, ///< @rst
+                    ///< the handle is to be used with functions for computing the :ref:`UMAP <umap_intro>` embedding.
+                    ///< @endrst
+    da_handle_kernel_approx, ///< @rst
+                             ///< the handle is to be used with functions for computing a :ref:`kernel approximation <kernel_approx_intro>`.
+                             ///< @endrst
 };
 // clang-format on
 
@@ -216,4 +228,45 @@ da_status da_handle_load_model(da_handle *handle, const char *file_name);
  */
 da_status da_handle_print_model_versions(da_handle handle);
 
+/**
+ * @brief
+ * @rst
+ * Per-thread state for concurrent inference on a shared handle.
+ *
+ * Inference functions taking a :cpp:type:`da_inference_context` (for example :cpp:func:`da_kmeans_predict_ctx_d`) only read the
+ * trained handle: error messages and temporary arrays are stored in the context. Several threads can therefore call them on the
+ * same handle at the same time, provided each thread uses its own context and the handle is not modified (no option change,
+ * training or destruction) meanwhile. A context can be reused for any number of calls and handles.
+ * @endrst
+ */
+typedef struct _da_inference_context *da_inference_context;
+
+/**
+ * @brief Initialize a @ref da_inference_context.
+ *
+ * @param[out] ctx the inference context to initialize.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_invalid_pointer - @p ctx is a null pointer.
+ * - @ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_inference_context_init(da_inference_context *ctx);
+
+/**
+ * @brief Print error information stored in an inference context by the last call using it.
+ *
+ * @param[in] ctx the @ref da_inference_context structure.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_invalid_input - the context pointer is invalid.
+ */
+da_status da_inference_context_print_error_message(da_inference_context ctx);
+
+/**
+ * @brief Destroy a @ref da_inference_context and free its workspace.
+ *
+ * @param[inout] ctx the inference context to destroy, set to NULL on exit.
+ */
+void da_inference_context_destroy(da_inference_context *ctx);
+
 #endif
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef AOCLDA_KERNEL_APPROXIMATION
+#define AOCLDA_KERNEL_APPROXIMATION
+
+#include "aoclda_error.h"
+#include "aoclda_handle.h"
+#include "aoclda_types.h"
+
+/**
+ * \file
+ */
+
+/** \{
+ * \brief Pass a data matrix to the \ref da_handle object in preparation for fitting a kernel approximation.
+ *
+ * The data matrix is referenced, not copied, so it must remain valid until \ref da_kernel_approx_compute_s "da_kernel_approx_compute_?" has been called.
+ * @rst
+ * After calling this function you may use the option setting APIs to set :ref:`options <kernel_approx_options>`.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized using \ref da_handle_init_s "da_handle_init_?" with type \ref da_handle_kernel_approx.
+ * \param[in] n_samples the number of rows of the data matrix, \p X. Constraint: \p n_samples @f$\ge@f$ 1.
+ * \param[in] n_features the number of columns of the data matrix, \p X. Constraint: \p n_features @f$\ge@f$ 1.
+ * \param[in] X the \p n_samples @f$\times@f$ \p n_features data matrix. By default, it should be stored in column-major order, unless you have set the <em>storage order</em> option to <em>row-major</em>.
+ * \param[in] ldx the leading dimension of the data matrix. Constraint: \p ldx @f$\ge@f$ \p n_samples if \p X is stored in column-major order, or \p ldx @f$\ge@f$ \p n_features if \p X is stored in row-major order.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_handle_not_initialized - the handle has not been initialized.
+ * - \ref da_status_invalid_handle_type - the handle was not initialized with type \ref da_handle_kernel_approx.
+ * - \ref da_status_invalid_pointer - \p X is null.
+ * - \ref da_status_invalid_array_dimension - one of \p n_samples or \p n_features is invalid.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx was violated.
+ */
+da_status da_kernel_approx_set_data_d(da_handle handle, da_int n_samples,
+                                      da_int n_features, const double *X, da_int ldx);
+
+da_status da_kernel_approx_set_data_s(da_handle handle, da_int n_samples,
+                                      da_int n_features, const float *X, da_int ldx);
+/** \} */
+
+/** \{
+ * \brief Fit an explicit feature map approximating a kernel function.
+ *
+ * Fits either a Nystroem map, built from landmarks chosen among the rows of the data matrix passed using
+ * \ref da_kernel_approx_set_data_s "da_kernel_approx_set_data_?", or a random Fourier feature map for the rbf kernel.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized using \ref da_handle_init_s "da_handle_init_?" with type \ref da_handle_kernel_approx.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_handle_not_initialized - the handle has not been initialized.
+ * - \ref da_status_invalid_handle_type - the handle was not initialized with type \ref da_handle_kernel_approx.
+ * - \ref da_status_no_data - \ref da_kernel_approx_set_data_s "da_kernel_approx_set_data_?" has not been called prior to this function call.
+ * - \ref da_status_incompatible_options - random Fourier features were requested for a kernel other than rbf. This is also returned as a warning if the number of Nystroem landmarks was reduced to \p n_samples.
+ * - \ref da_status_invalid_input - \p gamma is zero and random Fourier features were requested.
+ * - \ref da_status_numerical_difficulties - the eigendecomposition of the landmark kernel matrix failed.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ *
+ * \post
+ * \parblock
+ * After successful execution, \ref da_handle_get_result_s "da_handle_get_result_?" can be queried with:
+ * - \p da_kernel_approx_components - return an array of size \p n_components @f$\times@f$ \p n_features containing the Nystroem landmarks (in the same storage order as the input data), or an array of size \p n_features @f$\times@f$ \p n_components containing the random Fourier feature weights.
+ * - \p da_kernel_approx_normalization - return an array of size \p n_components @f$\times@f$ \p n_components containing the inverse square root of the kernel matrix of the landmarks (Nystroem only).
+ * - \p da_kernel_approx_offsets - return an array of size \p n_components containing the random offsets (random Fourier features only).
+ * - \p da_kernel_approx_n_components - return the number of features produced by the map (integer query).
+ * - \p da_rinfo - return an array of size 4 containing \p n_samples, \p n_features, \p n_components and the value of \p gamma used.
+ * \endparblock
+ */
+da_status da_kernel_approx_compute_d(da_handle handle);
+
+da_status da_kernel_approx_compute_s(da_handle handle);
+/** \} */
+
+/** \{
+ * \brief Map new data to the approximate kernel feature space.
+ *
+ * Computes the features of each row of \p X, so that the inner product of the features of two rows approximates the kernel function evaluated at them.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized using \ref da_handle_init_s "da_handle_init_?"
+ *  with type \ref da_handle_kernel_approx, on which \ref da_kernel_approx_compute_s "da_kernel_approx_compute_?" has been successfully called.
+ * \param[in] m_samples the number of samples to transform. Constraint: \p m_samples @f$\ge@f$ 1.
+ * \param[in] m_features the number of features in the new data. Constraint: \p m_features must equal the number of features passed to \ref da_kernel_approx_set_data_s "da_kernel_approx_set_data_?".
+ * \param[in] X the data matrix of size \p m_samples @f$\times@f$ \p m_features, in the same storage format used to compute the map.
+ * \param[in] ldx the leading dimension of \p X. Constraint: \p ldx @f$\ge@f$ \p m_samples if \p X is stored in column-major order, or \p ldx @f$\ge@f$ \p m_features if \p X is stored in row-major order.
+ * \param[out] X_transform an array of size at least \p m_samples @f$\times@f$ \p n_components, in which the features will be stored (in the same storage format used to compute the map).
+ * \param[in] ldx_transform the leading dimension of \p X_transform. Constraint: \p ldx_transform @f$\ge@f$ \p m_samples if \p X is stored in column-major order, or \p ldx_transform @f$\ge@f$ \p n_components if \p X is stored in row-major order.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_handle_not_initialized - the handle has not been initialized.
+ * - \ref da_status_invalid_handle_type - the handle was not initialized with type \ref da_handle_kernel_approx.
+ * - \ref da_status_no_data - \ref da_kernel_approx_compute_s "da_kernel_approx_compute_?" has not been successfully called.
+ * - \ref da_status_invalid_pointer - one of the arrays is null.
+ * - \ref da_status_invalid_input - \p m_features does not match the number of features used to compute the map.
+ * - \ref da_status_invalid_leading_dimension - one of the constraints on \p ldx or \p ldx_transform was violated.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_kernel_approx_transform_d(da_handle handle, da_int m_samples,
+                                       da_int m_features, const double *X, da_int ldx,
+                                       double *X_transform, da_int ldx_transform);
+
+da_status da_kernel_approx_transform_s(da_handle handle, da_int m_samples,
+                                       da_int m_features, const float *X, da_int ldx,
+                                       float *X_transform, da_int ldx_transform);
+/** \} */
+
+#endif
@@ -195,4 +195,191 @@ da_status da_sigmoid_kernel_s(da_order order, da_int m, da_int n, da_int k,
                               float *D, da_int ldd, float gamma, float coef0);
 /** \} */
 
+/** \{
+ * @brief Apply the RBF kernel matrix of \p X and, optionally, \p Y to the matrix \p V without forming it.
+ *
+ * This function computes @f$U = K(X, Y) V@f$, where @f$K(X, Y)@f$ is the RBF kernel matrix between the rows of \p X
+ * (size \p m @f$\times@f$ \p k) and \p Y (size \p n @f$\times@f$ \p k), as computed by @ref da_rbf_kernel_s.
+ * The kernel matrix is evaluated one cache-sized tile at a time and each tile is multiplied by the matching rows of \p V straight away,
+ * so only @f$O(m \times n_{rhs})@f$ memory is used for the output, instead of the @f$O(m \times n)@f$ needed to store the kernel matrix.
+ *
+ * The RBF kernel is given by:
+ * @f[
+ * K(x, y) = \exp(-\gamma \|\mathbf{x} - \mathbf{y}\|^2).
+ * @f]
+ *
+ * @param[in] order @ref da_order enum specifying column-major or row-major layout of \p X, \p Y, \p V and \p U.
+ * @param[in] m the number of rows of matrix X. Constraint: @p m @f$\ge@f$ 1.
+ * @param[in] n the number of rows of matrix Y. Constraint: @p n @f$\ge@f$ 1.
+ * @param[in] k the number of columns of matrices X and Y. Constraint: @p k @f$\ge@f$ 1.
+ * @param[in] X the matrix of size \p m @f$\times@f$ \p k, stored in column-major order by default.
+ * @param[in] ldx the leading dimension of \p X. Constraint: \p ldx @f$\ge@f$ \p m if \p order = \p column_major, or \p ldx @f$\ge@f$ \p k if \p order = \p row_major.
+ * @param[in] Y the matrix of size \p n @f$\times@f$ \p k, or null if the kernel of \p X with itself is required, in which case \p n is ignored and taken to be \p m.
+ * @param[in] ldy the leading dimension of \p Y. Constraint: \p ldy @f$\ge@f$ \p n if \p order = \p column_major, or \p ldy @f$\ge@f$ \p k if \p order = \p row_major.
+ * @param[in] n_rhs the number of columns of \p V and \p U. Constraint: @p n_rhs @f$\ge@f$ 1.
+ * @param[in] V the matrix of size \p n @f$\times@f$ \p n_rhs that the kernel matrix is applied to.
+ * @param[in] ldv the leading dimension of \p V. Constraint: \p ldv @f$\ge@f$ \p n if \p order = \p column_major, or \p ldv @f$\ge@f$ \p n_rhs if \p order = \p row_major.
+ * @param[out] U the resulting matrix @f$K(X, Y) V@f$ of size \p m @f$\times@f$ \p n_rhs.
+ * @param[in] ldu the leading dimension of \p U. Constraint: \p ldu @f$\ge@f$ \p m if \p order = \p column_major, or \p ldu @f$\ge@f$ \p n_rhs if \p order = \p row_major.
+ * @param[in] gamma the RBF kernel scale factor. Constraint: \p gamma @f$\ge@f$ 0.
+ * @return @ref da_status
+ * - @ref da_status_success - operation completed successfully.
+ * - @ref da_status_invalid_leading_dimension - one of the constraints on \p ldx, \p ldy, \p ldv or \p ldu was violated.
+ * - @ref da_status_invalid_pointer - one of the input pointers is null.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value.
+ * - @ref da_status_invalid_array_dimension - one of the dimensions \p m, \p n, \p k or \p n_rhs is invalid.
+ * - @ref da_status_memory_error - unable to allocate memory.
+ */
+da_status da_rbf_kernel_apply_d(da_order order, da_int m, da_int n, da_int k,
+                                const double *X, da_int ldx, const double *Y, da_int ldy,
+                                da_int n_rhs, const double *V, da_int ldv, double *U,
+                                da_int ldu, double gamma);
+
+da_status da_rbf_kernel_apply_s(da_order order, da_int m, da_int n, da_int k,
+                                const float *X, da_int ldx, const float *Y, da_int ldy,
+                                da_int n_rhs, const float *V, da_int ldv, float *U,
+                                da_int ldu, float gamma);
+/** \} */
+
+/** \{
+ * @brief Apply the linear kernel matrix of \p X and, optionally, \p Y to the matrix \p V without forming it.
+ *
+ * This function computes @f$U = K(X, Y) V@f$, where @f$K(X, Y)@f$ is the linear kernel matrix between the rows of \p X
+ * (size \p m @f$\times@f$ \p k) and \p Y (size \p n @f$\times@f$ \p k), as computed by @ref da_linear_kernel_s.
+ * The kernel matrix is evaluated one cache-sized tile at a time and each tile is multiplied by the matching rows of \p V straight away,
+ * so only @f$O(m \times n_{rhs})@f$ memory is used for the output, instead of the @f$O(m \times n)@f$ needed to store the kernel matrix.
+ *
+ * The linear kernel is given by:
+ * @f[
+ * K(x, y) = x \cdot y.
+ * @f]
+ *
+ * @param[in] order @ref da_order enum specifying column-major or row-major layout of \p X, \p Y, \p V and \p U.
+ * @param[in] m the number of rows of matrix X. Constraint: @p m @f$\ge@f$ 1.
+ * @param[in] n the number of rows of matrix Y. Constraint: @p n @f$\ge@f$ 1.
+ * @param[in] k the number of columns of matrices X and Y. Constraint: @p k @f$\ge@f$ 1.
+ * @param[in] X the matrix of size \p m @f$\times@f$ \p k, stored in column-major order by default.
+ * @param[in] ldx the leading dimension of \p X. Constraint: \p ldx @f$\ge@f$ \p m if \p order = \p column_major, or \p ldx @f$\ge@f$ \p k if \p order = \p row_major.
+ * @param[in] Y the matrix of size \p n @f$\times@f$ \p k, or null if the kernel of \p X with itself is required, in which case \p n is ignored and taken to be \p m.
+ * @param[in] ldy the leading dimension of \p Y. Constraint: \p ldy @f$\ge@f$ \p n if \p order = \p column_major, or \p ldy @f$\ge@f$ \p k if \p order = \p row_major.
+ * @param[in] n_rhs the number of columns of \p V and \p U. Constraint: @p n_rhs @f$\ge@f$ 1.
+ * @param[in] V the matrix of size \p n @f$\times@f$ \p n_rhs that the kernel matrix is applied to.
+ * @param[in] ldv the leading dimension of \p V. Constraint: \p ldv @f$\ge@f$ \p n if \p order = \p column_major, or \p ldv @f$\ge@f$ \p n_rhs if \p order = \p row_major.
+ * @param[out] U the resulting matrix @f$K(X, Y) V@f$ of size \p m @f$\times@f$ \p n_rhs.
+ * @param[in] ldu the leading dimension of \p U. Constraint: \p ldu @f$\ge@f$ \p m if \p order = \p column_major, or \p ldu @f$\ge@f$ \p n_rhs if \p order = \p row_major.
+ * @return @ref da_status
+ * - @ref da_status_success - operation completed successfully.
+ * - @ref da_status_invalid_leading_dimension - one of the constraints on \p ldx, \p ldy, \p ldv or \p ldu was violated.
+ * - @ref da_status_invalid_pointer - one of the input pointers is null.
+ * - @ref da_status_invalid_array_dimension - one of the dimensions \p m, \p n, \p k or \p n_rhs is invalid.
+ * - @ref da_status_memory_error - unable to allocate memory.
+ */
+da_status da_linear_kernel_apply_d(da_order order, da_int m, da_int n, da_int k,
+                                   const double *X, da_int ldx, const double *Y,
+                                   da_int ldy, da_int n_rhs, const double *V, da_int ldv,
+                                   double *U, da_int ldu);
+
+da_status da_linear_kernel_apply_s(da_order order, da_int m, da_int n, da_int k,
+                                   const float *X, da_int ldx, const float *Y, da_int ldy,
+                                   da_int n_rhs, const float *V, da_int ldv, float *U,
+                                   da_int ldu);
+/** \} */
+
+/** \{
+ * @brief Apply the polynomial kernel matrix of \p X and, optionally, \p Y to the matrix \p V without forming it.
+ *
+ * This function computes @f$U = K(X, Y) V@f$, where @f$K(X, Y)@f$ is the polynomial kernel matrix between the rows of \p X
+ * (size \p m @f$\times@f$ \p k) and \p Y (size \p n @f$\times@f$ \p k), as computed by @ref da_polynomial_kernel_s.
+ * The kernel matrix is evaluated one cache-sized tile at a time and each tile is multiplied by the matching rows of \p V straight away,
+ * so only @f$O(m \times n_{rhs})@f$ memory is used for the output, instead of the @f$O(m \times n)@f$ needed to store the kernel matrix.
+ *
+ * The polynomial kernel is given by:
+ * @f[
+ * K(x, y) = (\gamma x \cdot y + c)^d.
+ * @f]
+ *
+ * @param[in] order @ref da_order enum specifying column-major or row-major layout of \p X, \p Y, \p V and \p U.
+ * @param[in] m the number of rows of matrix X. Constraint: @p m @f$\ge@f$ 1.
+ * @param[in] n the number of rows of matrix Y. Constraint: @p n @f$\ge@f$ 1.
+ * @param[in] k the number of columns of matrices X and Y. Constraint: @p k @f$\ge@f$ 1.
+ * @param[in] X the matrix of size \p m @f$\times@f$ \p k, stored in column-major order by default.
+ * @param[in] ldx the leading dimension of \p X. Constraint: \p ldx @f$\ge@f$ \p m if \p order = \p column_major, or \p ldx @f$\ge@f$ \p k if \p order = \p row_major.
+ * @param[in] Y the matrix of size \p n @f$\times@f$ \p k, or null if the kernel of \p X with itself is required, in which case \p n is ignored and taken to be \p m.
+ * @param[in] ldy the leading dimension of \p Y. Constraint: \p ldy @f$\ge@f$ \p n if \p order = \p column_major, or \p ldy @f$\ge@f$ \p k if \p order = \p row_major.
+ * @param[in] n_rhs the number of columns of \p V and \p U. Constraint: @p n_rhs @f$\ge@f$ 1.
+ * @param[in] V the matrix of size \p n @f$\times@f$ \p n_rhs that the kernel matrix is applied to.
+ * @param[in] ldv the leading dimension of \p V. Constraint: \p ldv @f$\ge@f$ \p n if \p order = \p column_major, or \p ldv @f$\ge@f$ \p n_rhs if \p order = \p row_major.
+ * @param[out] U the resulting matrix @f$K(X, Y) V@f$ of size \p m @f$\times@f$ \p n_rhs.
+ * @param[in] ldu the leading dimension of \p U. Constraint: \p ldu @f$\ge@f$ \p m if \p order = \p column_major, or \p ldu @f$\ge@f$ \p n_rhs if \p order = \p row_major.
+ * @param[in] gamma the scale factor used in polynomial kernel. Constraint: \p gamma @f$\ge@f$ 0.
+ * @param[in] degree the degree of the polynomial kernel.  Constraint: \p degree @f$\ge@f$ 1.
+ * @param[in] coef0 the independent term in the polynomial kernel.
+ * @return @ref da_status
+ * - @ref da_status_success - operation completed successfully.
+ * - @ref da_status_invalid_leading_dimension - one of the constraints on \p ldx, \p ldy, \p ldv or \p ldu was violated.
+ * - @ref da_status_invalid_pointer - one of the input pointers is null.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value.
+ * - @ref da_status_invalid_array_dimension - one of the dimensions \p m, \p n, \p k or \p n_rhs is invalid.
+ * - @ref da_status_memory_error - unable to allocate memory.
+ */
+da_status da_polynomial_kernel_apply_d(da_order order, da_int m, da_int n, da_int k,
+                                       const double *X, da_int ldx, const double *Y,
+                                       da_int ldy, da_int n_rhs, const double *V,
+                                       da_int ldv, double *U, da_int ldu, double gamma,
+                                       da_int degree, double coef0);
+
+da_status da_polynomial_kernel_apply_s(da_order order, da_int m, da_int n, da_int k,
+                                       const float *X, da_int ldx, const float *Y,
+                                       da_int ldy, da_int n_rhs, const float *V,
+                                       da_int ldv, float *U, da_int ldu, float gamma,
+                                       da_int degree, float coef0);
+/** \} */
+
+/** \{
+ * @brief Apply the sigmoid kernel matrix of \p X and, optionally, \p Y to the matrix \p V without forming it.
+ *
+ * This function computes @f$U = K(X, Y) V@f$, where @f$K(X, Y)@f$ is the sigmoid kernel matrix between the rows of \p X
+ * (size \p m @f$\times@f$ \p k) and \p Y (size \p n @f$\times@f$ \p k), as computed by @ref da_sigmoid_kernel_s.
+ * The kernel matrix is evaluated one cache-sized tile at a time and each tile is multiplied by the matching rows of \p V straight away,
+ * so only @f$O(m \times n_{rhs})@f$ memory is used for the output, instead of the @f$O(m \times n)@f$ needed to store the kernel matrix.
+ *
+ * The sigmoid kernel is given by:
+ * @f[
+ * K(x, y) = \tanh(\gamma x \cdot y + c).
+ * @f]
+ *
+ * @param[in] order @ref da_order enum specifying column-major or row-major layout of \p X, \p Y, \p V and \p U.
+ * @param[in] m the number of rows of matrix X. Constraint: @p m @f$\ge@f$ 1.
+ * @param[in] n the number of rows of matrix Y. Constraint: @p n @f$\ge@f$ 1.
+ * @param[in] k the number of columns of matrices X and Y. Constraint: @p k @f$\ge@f$ 1.
+ * @param[in] X the matrix of size \p m @f$\times@f$ \p k, stored in column-major order by default.
+ * @param[in] ldx the leading dimension of \p X. Constraint: \p ldx @f$\ge@f$ \p m if \p order = \p column_major, or \p ldx @f$\ge@f$ \p k if \p order = \p row_major.
+ * @param[in] Y the matrix of size \p n @f$\times@f$ \p k, or null if the kernel of \p X with itself is required, in which case \p n is ignored and taken to be \p m.
+ * @param[in] ldy the leading dimension of \p Y. Constraint: \p ldy @f$\ge@f$ \p n if \p order = \p column_major, or \p ldy @f$\ge@f$ \p k if \p order = \p row_major.
+ * @param[in] n_rhs the number of columns of \p V and \p U. Constraint: @p n_rhs @f$\ge@f$ 1.
+ * @param[in] V the matrix of size \p n @f$\times@f$ \p n_rhs that the kernel matrix is applied to.
+ * @param[in] ldv the leading dimension of \p V. Constraint: \p ldv @f$\ge@f$ \p n if \p order = \p column_major, or \p ldv @f$\ge@f$ \p n_rhs if \p order = \p row_major.
+ * @param[out] U the resulting matrix @f$K(X, Y) V@f$ of size \p m @f$\times@f$ \p n_rhs.
+ * @param[in] ldu the leading dimension of \p U. Constraint: \p ldu @f$\ge@f$ \p m if \p order = \p column_major, or \p ldu @f$\ge@f$ \p n_rhs if \p order = \p row_major.
+ * @param[in] gamma the scale factor used in sigmoid kernel. Constraint: \p gamma @f$\ge@f$ 0.
+ * @param[in] coef0 constant term in the sigmoid kernel.
+ * @return @ref da_status
+ * - @ref da_status_success - operation completed successfully.
+ * - @ref da_status_invalid_leading_dimension - one of the constraints on \p ldx, \p ldy, \p ldv or \p ldu was violated.
+ * - @ref da_status_invalid_pointer - one of the input pointers is null.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value.
+ * - @ref da_status_invalid_array_dimension - one of the dimensions \p m, \p n, \p k or \p n_rhs is invalid.
+ * - @ref da_status_memory_error - unable to allocate memory.
+ */
+da_status da_sigmoid_kernel_apply_d(da_order order, da_int m, da_int n, da_int k,
+                                    const double *X, da_int ldx, const double *Y,
+                                    da_int ldy, da_int n_rhs, const double *V, da_int ldv,
+                                    double *U, da_int ldu, double gamma, double coef0);
+
+da_status da_sigmoid_kernel_apply_s(da_order order, da_int m, da_int n, da_int k,
+                                    const float *X, da_int ldx, const float *Y,
+                                    da_int ldy, da_int n_rhs, const float *V, da_int ldv,
+                                    float *U, da_int ldu, float gamma, float coef0);
+/** \} */
+
 #endif
@@ -87,6 +87,36 @@ da_status da_kmeans_set_init_centres_d(da_handle handle, const double *C, da_int
 da_status da_kmeans_set_init_centres_s(da_handle handle, const float *C, da_int ldc);
 /** \} */
 
+/** \{
+ * \brief Pass optional sample weights to the \ref da_handle object in preparation for <i>k</i>-means clustering.
+ *
+ * The weights are copied into the handle. Each cluster centre is computed as the weighted mean of the samples assigned to it and the
+ * inertia is the weighted sum of squared distances. The initial centres are chosen without taking the weights into account.
+ *
+ * @rst
+ * Sample weights are only supported by the Lloyd and Elkan algorithms (see :ref:`options <kmeans_options>`).
+ *
+ * Note, you must call :ref:`da_kmeans_set_data_? <da_kmeans_set_data>` prior to this function. A subsequent call to
+ * :ref:`da_kmeans_set_data_? <da_kmeans_set_data>` removes the weights, as does calling this function with ``n_weights = 0``.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_kmeans.
+ * \param[in] n_weights the number of weights. Must be equal to \p n_samples, or 0 to remove the weights.
+ * \param[in] weights array of size \p n_weights containing non-negative weights with a positive sum.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_no_data - the function \ref da_kmeans_set_data_s "da_kmeans_set_data_?" has not been called.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_invalid_pointer - the handle has not been initialized, or \p weights is null.
+ * - \ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message.
+ */
+da_status da_kmeans_set_sample_weights_d(da_handle handle, da_int n_weights,
+                                         const double *weights);
+
+da_status da_kmeans_set_sample_weights_s(da_handle handle, da_int n_weights,
+                                         const float *weights);
+/** \} */
+
 /** \{
  * \brief Compute <i>k</i>-means clustering
  *
@@ -178,4 +208,58 @@ da_status da_kmeans_predict_s(da_handle handle, da_int k_samples, da_int k_featu
                               const float *Y, da_int ldy, da_int *Y_labels);
 /** \} */
 
+/** \{
+ * \brief Transform a data matrix into the cluster distance space using an inference context
+ *
+ * Reentrant variant of \ref da_kmeans_transform_s "da_kmeans_transform_?". The handle is only read, error information and
+ * temporary arrays are kept in \p ctx, so several threads may call this function concurrently on the same trained handle
+ * provided each of them passes its own \ref da_inference_context.
+ *
+ * \param[in] handle a \ref da_handle object, with *k*-means clusters previously computed via \ref da_kmeans_compute_s "da_kmeans_compute_?".
+ * \param[inout] ctx a \ref da_inference_context initialized with \ref da_inference_context_init. Errors can be printed using \ref da_inference_context_print_error_message.
+ * \param[in] m_samples see \ref da_kmeans_transform_s "da_kmeans_transform_?".
+ * \param[in] m_features see \ref da_kmeans_transform_s "da_kmeans_transform_?".
+ * \param[in] X see \ref da_kmeans_transform_s "da_kmeans_transform_?".
+ * \param[in] ldx see \ref da_kmeans_transform_s "da_kmeans_transform_?".
+ * \param[out] X_transform see \ref da_kmeans_transform_s "da_kmeans_transform_?".
+ * \param[in] ldx_transform see \ref da_kmeans_transform_s "da_kmeans_transform_?".
+ * \return \ref da_status. The function returns the same values as \ref da_kmeans_transform_s "da_kmeans_transform_?", and additionally:
+ * - \ref da_status_invalid_pointer - \p ctx is a null pointer.
+ */
+da_status da_kmeans_transform_ctx_d(da_handle handle, da_inference_context ctx,
+                                    da_int m_samples, da_int m_features, const double *X,
+                                    da_int ldx, double *X_transform,
+                                    da_int ldx_transform);
+
+da_status da_kmeans_transform_ctx_s(da_handle handle, da_inference_context ctx,
+                                    da_int m_samples, da_int m_features, const float *X,
+                                    da_int ldx, float *X_transform, da_int ldx_transform);
+/** \} */
+
+/** \{
+ * \brief Predict the cluster each sample in a data matrix belongs to using an inference context
+ *
+ * Reentrant variant of \ref da_kmeans_predict_s "da_kmeans_predict_?". The handle is only read, error information and
+ * temporary arrays are kept in \p ctx, so several threads may call this function concurrently on the same trained handle
+ * provided each of them passes its own \ref da_inference_context.
+ *
+ * \param[in] handle a \ref da_handle object, with <i>k</i>-means clusters previously computed via \ref da_kmeans_compute_s "da_kmeans_compute_?".
+ * \param[inout] ctx a \ref da_inference_context initialized with \ref da_inference_context_init. Errors can be printed using \ref da_inference_context_print_error_message.
+ * \param[in] k_samples see \ref da_kmeans_predict_s "da_kmeans_predict_?".
+ * \param[in] k_features see \ref da_kmeans_predict_s "da_kmeans_predict_?".
+ * \param[in] Y see \ref da_kmeans_predict_s "da_kmeans_predict_?".
+ * \param[in] ldy see \ref da_kmeans_predict_s "da_kmeans_predict_?".
+ * \param[out] Y_labels see \ref da_kmeans_predict_s "da_kmeans_predict_?".
+ * \return \ref da_status. The function returns the same values as \ref da_kmeans_predict_s "da_kmeans_predict_?", and additionally:
+ * - \ref da_status_invalid_pointer - \p ctx is a null pointer.
+ */
+da_status da_kmeans_predict_ctx_d(da_handle handle, da_inference_context ctx,
+                                  da_int k_samples, da_int k_features, const double *Y,
+                                  da_int ldy, da_int *Y_labels);
+
+da_status da_kmeans_predict_ctx_s(da_handle handle, da_inference_context ctx,
+                                  da_int k_samples, da_int k_features, const float *Y,
+                                  da_int ldy, da_int *Y_labels);
+/** \} */
+
 #endif
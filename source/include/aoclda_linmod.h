@@ -101,6 +101,83 @@ da_status da_linmod_define_features_s(da_handle handle, da_int n_samples,
                                       const float *y);
 /** \} */
 
+/** \{
+ * @brief Define per-sample weights for the training data of a linear model.
+ * @rst
+ * The last suffix of the function name marks the floating point precision on which the handle operates (see :ref:`precision section <da_real_prec>`).
+ *
+ * The weights act as frequency weights: a sample with weight :math:`w_i = 2` contributes to the loss as if it appeared twice in
+ * the data matrix. Internally the weights are normalized so that they sum to :math:`n_{samples}`. For the mean squared error model
+ * the intercept is recovered through weighted centering and all solvers are supported; with integer weights and the default
+ * *scaling* the fit matches the one on the data set where each row is repeated :math:`w_i` times, with or without L1 and L2
+ * regularization. For logistic regression the weights are applied directly to the log-loss and the L2 penalty is rescaled
+ * accordingly, so the same holds for the regularized logistic model.
+ *
+ * .. note::
+ *      A copy of the weights is stored in the handle. The weights are cleared by a subsequent call to
+ *      :ref:`da_linmod_define_features_? <da_linmod_define_features>`.
+ * @endrst
+ *
+ * @param[inout] handle a @ref da_handle object, initialized with type @ref da_handle_linmod.
+ * @param[in] n_samples the number of weights. It must match the number of observations passed to
+ *            \ref da_linmod_define_features_s "da_linmod_define_features_?". Optionally, if set to zero then all previously defined weights are removed.
+ * @param[in] weights vector of size @p n_samples containing non-negative weights with at least one positive entry.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - @ref da_status_invalid_pointer - the @p handle has not been correctly initialized.
+ * - @ref da_status_no_data - no training data has been defined in the @p handle.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using @ref da_handle_print_error_message.
+ */
+da_status da_linmod_define_sample_weights_d(da_handle handle, da_int n_samples,
+                                            const double *weights);
+da_status da_linmod_define_sample_weights_s(da_handle handle, da_int n_samples,
+                                            const float *weights);
+/** \} */
+
+/** \{
+ * @brief Pass a block of training data to a linear model without keeping it in memory.
+ * @rst
+ * The last suffix of the function name marks the floating point precision on which the handle operates (see :ref:`precision section <da_real_prec>`).
+ *
+ * This function supports out-of-core and streaming fits of the mean squared error model, where the full data matrix does not fit in memory.
+ * Call it repeatedly with consecutive row blocks of the data matrix and the matching entries of the response vector, then call
+ * :ref:`da_linmod_fit_? <da_linmod_fit>` as usual. The blocks do not need to have the same number of rows.
+ *
+ * Each block is centered and reduced to a small :math:`(n_{features}+1) \times (n_{features}+1)` triangular factor with a
+ * parallel tall-skinny QR factorization, and merged into the running factor together with the column means. The
+ * data can therefore be released or overwritten as soon as the function returns, and the memory used by the handle does not depend on
+ * the number of samples. The fit solves the least squares or ridge problem from these statistics, with the intercept obtained from the means.
+ *
+ * .. note::
+ *      Streaming supports the :cpp:enumerator:`linmod_model_mse` model with no regularization or L2 regularization (``alpha = 0``),
+ *      and the *scaling* options ``none`` and ``centering``. Other settings return :cpp:enumerator:`da_status_incompatible_options`
+ *      when fitting. Streamed blocks replace any data previously passed with :ref:`da_linmod_define_features_? <da_linmod_define_features>`,
+ *      and vice versa.
+ * @endrst
+ *
+ * @param[inout] handle a @ref da_handle object, initialized with type @ref da_handle_linmod.
+ * @param[in] n_samples the number of observations (rows) in the block @p X. Constraint: @p n_samples @f$\ge@f$ 1.
+ * @param[in] n_features the number of features (columns) of the block @p X. Constraint: @p n_features @f$\ge@f$ 1 and equal for all blocks.
+ * @param[in] X the @p n_samples @f$\times@f$ @p n_features block of the data matrix, stored as set by the <em>storage order</em> option.
+ * @param[in] ldx the leading dimension of the block @p X. Constraint: @p ldx @f$\ge@f$ @p n_samples if the data is stored in column-major order, or @p ldx @f$\ge@f$ @p n_features if the data is stored in row-major order.
+ * @param[in] y the block of the response vector, of size @p n_samples.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - @ref da_status_invalid_pointer - the @p handle has not been correctly initialized.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using @ref da_handle_print_error_message.
+ * - @ref da_status_invalid_leading_dimension - the constraint on @p ldx was violated.
+ * - @ref da_status_incompatible_options - the selected model is not @ref linmod_model_mse.
+ */
+da_status da_linmod_stream_features_d(da_handle handle, da_int n_samples,
+                                      da_int n_features, const double *X, da_int ldx,
+                                      const double *y);
+da_status da_linmod_stream_features_s(da_handle handle, da_int n_samples,
+                                      da_int n_features, const float *X, da_int ldx,
+                                      const float *y);
+/** \} */
+
 /** \{
  * @brief Fit the linear model defined in the @p handle.
  *
@@ -193,6 +270,36 @@ da_status da_linmod_evaluate_model_s(da_handle handle, da_int n_samples,
                                      float *loss);
 /** \} */
 
+/** \{
+ * @brief Evaluate a linear model using an inference context.
+ *
+ * Reentrant variant of \ref da_linmod_evaluate_model_s "da_linmod_evaluate_model_?". The handle is only read, error
+ * information and temporary arrays are kept in \p ctx, so several threads may evaluate the same fitted model concurrently
+ * provided each of them passes its own @ref da_inference_context.
+ *
+ * @param[in] handle a @ref da_handle object, initialized with type @ref da_handle_linmod and holding a fitted model.
+ * @param[inout] ctx a @ref da_inference_context initialized with @ref da_inference_context_init. Errors can be printed using @ref da_inference_context_print_error_message.
+ * @param[in] n_samples see \ref da_linmod_evaluate_model_s "da_linmod_evaluate_model_?".
+ * @param[in] n_features see \ref da_linmod_evaluate_model_s "da_linmod_evaluate_model_?".
+ * @param[in] X see \ref da_linmod_evaluate_model_s "da_linmod_evaluate_model_?".
+ * @param[in] ldx see \ref da_linmod_evaluate_model_s "da_linmod_evaluate_model_?".
+ * @param[out] predictions see \ref da_linmod_evaluate_model_s "da_linmod_evaluate_model_?".
+ * @param[in] observations see \ref da_linmod_evaluate_model_s "da_linmod_evaluate_model_?".
+ * @param[out] loss see \ref da_linmod_evaluate_model_s "da_linmod_evaluate_model_?".
+ * @return da_status. The function returns the same values as \ref da_linmod_evaluate_model_s "da_linmod_evaluate_model_?", and additionally:
+ * - @ref da_status_invalid_pointer - @p ctx is a null pointer.
+ */
+da_status da_linmod_evaluate_model_ctx_d(da_handle handle, da_inference_context ctx,
+                                         da_int n_samples, da_int n_features,
+                                         const double *X, da_int ldx, double *predictions,
+                                         const double *observations, double *loss);
+
+da_status da_linmod_evaluate_model_ctx_s(da_handle handle, da_inference_context ctx,
+                                         da_int n_samples, da_int n_features,
+                                         const float *X, da_int ldx, float *predictions,
+                                         const float *observations, float *loss);
+/** \} */
+
 /**
  * @brief Indices of the information vector containing metrics from optimization solvers
  *
@@ -106,6 +106,122 @@ da_status da_pairwise_distances_s(da_order order, da_int m, da_int n, da_int k,
                                   float *D, da_int ldd, float p, da_metric metric);
 /** \} */
 
+/** \{
+ * \brief For each row of an \p m by \p k matrix \p X, find its nearest row of an \p n by \p k matrix \p Y, without storing the distance matrix.
+ *
+ * The distances are computed block by block and each block is reduced as soon as it has been computed, so the memory used is independent of \p n.
+ * When \p metric = \ref da_inner_product, the row of \p Y with the largest inner product is returned instead.
+ *
+ * \param[in] order a \ref da_order enumerated type, specifying whether \p X and \p Y are stored in row-major order or column-major order.
+ * \param[in] m the number of rows of matrix \p X.
+ * \param[in] n the number of rows of matrix \p Y.
+ * \param[in] k the number of columns of matrices \p X and \p Y.
+ * \param[in] X the \p m @f$\times @f$ \p k matrix.
+ * \param[in] ldx the leading dimension of the matrix \p X. Constraint: \p ldx @f$\ge@f$ \p m if \p order = \p column_major, or \p ldx @f$\ge@f$ \p k if \p order = \p row_major.
+ * \param[in] Y the \p n @f$\times @f$ \p k matrix. If \p Y is nullptr, \p X is used instead and \p n is ignored.
+ * \param[in] ldy the leading dimension of the matrix \p Y. Constraint: \p ldy @f$\ge@f$ \p n if \p order = \p column_major, or \p ldy @f$\ge@f$ \p k if \p order = \p row_major.
+ * \param[out] ind array of size \p m. On output, \p ind[i] is the index of the row of \p Y nearest to row \p i of \p X.
+ * \param[out] dist array of size \p m. On output, the distance between row \p i of \p X and row \p ind[i] of \p Y. Can be nullptr if the distances are not needed.
+ * \param[in] p the order of the Minkowski metric. \p p is only used for Minkowski distance and will be ignored otherwise.
+ * \param[in] metric enum that specifies the metric to use to compute the distances.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_invalid_leading_dimension - one of the constraints on \p ldx or \p ldy was violated.
+ * - \ref da_status_invalid_pointer - one of the arrays \p X or \p ind is null.
+ * - \ref da_status_invalid_array_dimension - either \p m @f$< 1@f$, or \p k @f$< 1@f$, or \p n @f$< 1@f$, while \p Y is not nullptr.
+ * - \ref da_status_invalid_input - \p p @f$\le 0@f$ with \p metric = \ref da_minkowski.
+ * - \ref da_status_not_implemented - an option that is currently not implemented was set.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_pairwise_distances_argmin_d(da_order order, da_int m, da_int n, da_int k,
+                                         const double *X, da_int ldx, const double *Y,
+                                         da_int ldy, da_int *ind, double *dist, double p,
+                                         da_metric metric);
+
+da_status da_pairwise_distances_argmin_s(da_order order, da_int m, da_int n, da_int k,
+                                         const float *X, da_int ldx, const float *Y,
+                                         da_int ldy, da_int *ind, float *dist, float p,
+                                         da_metric metric);
+/** \} */
+
+/** \{
+ * \brief For each row of an \p m by \p k matrix \p X, find its \p n_neigh nearest rows of an \p n by \p k matrix \p Y, without storing the distance matrix.
+ *
+ * The distances are computed block by block and each block is reduced as soon as it has been computed, so the memory used is independent of \p n.
+ * When \p metric = \ref da_inner_product, the rows of \p Y with the largest inner products are returned instead.
+ *
+ * \param[in] order a \ref da_order enumerated type, specifying whether \p X, \p Y, \p ind and \p dist are stored in row-major order or column-major order.
+ * \param[in] m the number of rows of matrix \p X.
+ * \param[in] n the number of rows of matrix \p Y.
+ * \param[in] k the number of columns of matrices \p X and \p Y.
+ * \param[in] X the \p m @f$\times @f$ \p k matrix.
+ * \param[in] ldx the leading dimension of the matrix \p X. Constraint: \p ldx @f$\ge@f$ \p m if \p order = \p column_major, or \p ldx @f$\ge@f$ \p k if \p order = \p row_major.
+ * \param[in] Y the \p n @f$\times @f$ \p k matrix. If \p Y is nullptr, \p X is used instead and \p n is ignored.
+ * \param[in] ldy the leading dimension of the matrix \p Y. Constraint: \p ldy @f$\ge@f$ \p n if \p order = \p column_major, or \p ldy @f$\ge@f$ \p k if \p order = \p row_major.
+ * \param[in] n_neigh the number of neighbors to find for each row of \p X. Constraint: 1 @f$\le@f$ \p n_neigh @f$\le@f$ \p n.
+ * \param[out] ind the \p m @f$\times @f$ \p n_neigh matrix, with leading dimension \p m if \p order = \p column_major and \p n_neigh otherwise. On output, row \p i holds the indices of the rows of \p Y nearest to row \p i of \p X, from nearest to furthest.
+ * \param[out] dist the \p m @f$\times @f$ \p n_neigh matrix of the corresponding distances, stored like \p ind. Can be nullptr if the distances are not needed.
+ * \param[in] p the order of the Minkowski metric. \p p is only used for Minkowski distance and will be ignored otherwise.
+ * \param[in] metric enum that specifies the metric to use to compute the distances.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_invalid_leading_dimension - one of the constraints on \p ldx or \p ldy was violated.
+ * - \ref da_status_invalid_pointer - one of the arrays \p X or \p ind is null.
+ * - \ref da_status_invalid_array_dimension - either \p m @f$< 1@f$, or \p k @f$< 1@f$, or \p n @f$< 1@f$, while \p Y is not nullptr.
+ * - \ref da_status_invalid_input - \p n_neigh is out of range, or \p p @f$\le 0@f$ with \p metric = \ref da_minkowski.
+ * - \ref da_status_not_implemented - an option that is currently not implemented was set.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_pairwise_distances_argkmin_d(da_order order, da_int m, da_int n, da_int k,
+                                          const double *X, da_int ldx, const double *Y,
+                                          da_int ldy, da_int n_neigh, da_int *ind,
+                                          double *dist, double p, da_metric metric);
+
+da_status da_pairwise_distances_argkmin_s(da_order order, da_int m, da_int n, da_int k,
+                                          const float *X, da_int ldx, const float *Y,
+                                          da_int ldy, da_int n_neigh, da_int *ind,
+                                          float *dist, float p, da_metric metric);
+/** \} */
+
+/** \{
+ * \brief For each row of an \p m by \p k matrix \p X, count the rows of an \p n by \p k matrix \p Y within a given distance, without storing the distance matrix.
+ *
+ * When \p metric = \ref da_inner_product, the rows of \p Y whose inner product with the row of \p X is at least \p radius are counted instead.
+ *
+ * \param[in] order a \ref da_order enumerated type, specifying whether \p X and \p Y are stored in row-major order or column-major order.
+ * \param[in] m the number of rows of matrix \p X.
+ * \param[in] n the number of rows of matrix \p Y.
+ * \param[in] k the number of columns of matrices \p X and \p Y.
+ * \param[in] X the \p m @f$\times @f$ \p k matrix.
+ * \param[in] ldx the leading dimension of the matrix \p X. Constraint: \p ldx @f$\ge@f$ \p m if \p order = \p column_major, or \p ldx @f$\ge@f$ \p k if \p order = \p row_major.
+ * \param[in] Y the \p n @f$\times @f$ \p k matrix. If \p Y is nullptr, \p X is used instead and \p n is ignored.
+ * \param[in] ldy the leading dimension of the matrix \p Y. Constraint: \p ldy @f$\ge@f$ \p n if \p order = \p column_major, or \p ldy @f$\ge@f$ \p k if \p order = \p row_major.
+ * \param[in] radius the distance threshold. A row of \p Y is counted if its distance to the row of \p X is at most \p radius. It must be expressed in the same units as the metric, e.g. squared for \ref da_sqeuclidean.
+ * \param[out] counts array of size \p m. On output, \p counts[i] is the number of rows of \p Y within \p radius of row \p i of \p X.
+ * \param[in] p the order of the Minkowski metric. \p p is only used for Minkowski distance and will be ignored otherwise.
+ * \param[in] metric enum that specifies the metric to use to compute the distances.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_invalid_leading_dimension - one of the constraints on \p ldx or \p ldy was violated.
+ * - \ref da_status_invalid_pointer - one of the arrays \p X or \p counts is null.
+ * - \ref da_status_invalid_array_dimension - either \p m @f$< 1@f$, or \p k @f$< 1@f$, or \p n @f$< 1@f$, while \p Y is not nullptr.
+ * - \ref da_status_invalid_input - \p p @f$\le 0@f$ with \p metric = \ref da_minkowski.
+ * - \ref da_status_not_implemented - an option that is currently not implemented was set.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_pairwise_distances_radius_count_d(da_order order, da_int m, da_int n,
+                                               da_int k, const double *X, da_int ldx,
+                                               const double *Y, da_int ldy, double radius,
+                                               da_int *counts, double p,
+                                               da_metric metric);
+
+da_status da_pairwise_distances_radius_count_s(da_order order, da_int m, da_int n,
+                                               da_int k, const float *X, da_int ldx,
+                                               const float *Y, da_int ldy, float radius,
+                                               da_int *counts, float p,
+                                               da_metric metric);
+/** \} */
+
 #ifdef __cplusplus
 }
 #endif
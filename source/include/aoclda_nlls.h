@@ -62,6 +62,12 @@
  * \return flag indicating whether evaluation of the model was successful: zero to
  *         indicate success; nonzero to indicate failure, in which case the solver will
  *         terminate with \ref da_status_optimization_usrstop.
+ *
+ * \note When the Jacobian is estimated by finite-differences and the optional parameter
+ *       \p finite \p differences \p threads is not 1, this call-back is called
+ *       concurrently from several threads at different points \p x. It must then be
+ *       thread-safe: \p data may only be read, or written under the caller's own
+ *       synchronization.
  */
 typedef da_int da_resfun_t_s(da_int n_coef, da_int n_res, void *data, const float *x,
                              float *res);
@@ -191,6 +197,84 @@ typedef da_int da_reshp_t_d(da_int n_coef, da_int n_res, const double *x, const
                             double *hp, void *data);
 /** \} */
 
+/**
+ * \{
+ * \brief Nonlinear data fitting call-back. Multi-point residual function signature
+ * \details
+ * This function evaluates the residuals of the model at \p n_points points in one
+ * call. It is used, when registered, to estimate the Jacobian by finite-differences:
+ * all the perturbed points of an estimate are passed at once so that they can be
+ * evaluated with the caller's own vectorization or parallelism.
+ *
+ * \param[in] n_coef number of coefficients in the model.
+ * \param[in] n_res number of residuals declared.
+ * \param[in] n_points number of points to evaluate.
+ * \param[inout] data user data pointer; the solver does not touch this pointer and
+ *            passes it on to the call-back.
+ * \param[in] x array of size \p n_coef * \p n_points, point \p k is stored in
+ *            <tt>x[k*n_coef]</tt> to <tt>x[(k+1)*n_coef-1]</tt>.
+ * \param[out] res array of size \p n_res * \p n_points, the residuals at point \p k
+ *            are to be stored in <tt>res[k*n_res]</tt> to <tt>res[(k+1)*n_res-1]</tt>.
+ * \return zero to indicate success; nonzero to indicate failure, in which case the
+ *         solver will terminate with \ref da_status_optimization_usrstop.
+ */
+typedef da_int da_resfun_multi_t_s(da_int n_coef, da_int n_res, da_int n_points,
+                                   void *data, const float *x, float *res);
+typedef da_int da_resfun_multi_t_d(da_int n_coef, da_int n_res, da_int n_points,
+                                   void *data, const double *x, double *res);
+/** \} */
+
+/**
+ * \{
+ * \brief Batched nonlinear data fitting call-back. Residual function signature
+ * \details
+ * Same as @ref da_resfun_t_d but for the model of problem \p problem in a batch of
+ * independent fits, see @ref da_nlls_fit_batch_d.
+ * Problems in the batch are solved concurrently, so this call-back is called at the same
+ * time from several threads with different values of \p problem and must be thread-safe.
+ *
+ * \param[in] problem index of the problem in the batch, from 0 to \p n_problems - 1.
+ * \param[in] n_coef number of coefficients in the model.
+ * \param[in] n_res number of residuals declared.
+ * \param[inout] data user data pointer; the solver does not touch this pointer and
+ *            passes it on to the call-back.
+ * \param[in] x the vector of coefficients (at the current iteration) of size \p n_coef.
+ * \param[out] res residual vector of size \p n_res for the model evaluated at \p x.
+ * \return zero to indicate success; nonzero to indicate failure, in which case the solver
+ *         for this problem will terminate with \ref da_status_optimization_usrstop.
+ */
+typedef da_int da_resfun_batch_t_s(da_int problem, da_int n_coef, da_int n_res,
+                                   void *data, const float *x, float *res);
+typedef da_int da_resfun_batch_t_d(da_int problem, da_int n_coef, da_int n_res,
+                                   void *data, const double *x, double *res);
+/** \} */
+
+/**
+ * \{
+ * \brief Batched nonlinear data fitting call-back. Residual Jacobian function signature
+ * \details
+ * Same as @ref da_resgrd_t_d but for the model of problem \p problem in a batch of
+ * independent fits, see @ref da_nlls_fit_batch_d.
+ * This call-back must be thread-safe.
+ *
+ * \param[in] problem index of the problem in the batch, from 0 to \p n_problems - 1.
+ * \param[in] n_coef number of coefficients in the model.
+ * \param[in] n_res number of residuals declared.
+ * \param[inout] data user data pointer; the solver does not touch this pointer and
+ *            passes it on to the call-back.
+ * \param[in] x the vector of coefficients (at the current iteration) of size \p n_coef.
+ * \param[out] jac Jacobian matrix (\p n_res by \p n_coef) of the residual function
+ *             evaluated at \p x, stored as defined by the optional parameter
+ *             \p storage_scheme.
+ * \return zero to indicate success; nonzero to indicate failure, in which case the solver
+ *         for this problem will terminate with \ref da_status_optimization_usrstop.
+ */
+typedef da_int da_resgrd_batch_t_s(da_int problem, da_int n_coef, da_int n_res,
+                                   void *data, float const *x, float *jac);
+typedef da_int da_resgrd_batch_t_d(da_int problem, da_int n_coef, da_int n_res,
+                                   void *data, double const *x, double *jac);
+/** \} */
+
 /**
  * \{
  * \brief Nonlinear data fitting function call-backs registration.
@@ -235,6 +319,62 @@ da_status da_nlls_define_residuals_s(da_handle handle, da_int n_coef, da_int n_r
                                      da_reshes_t_s *reshes, da_reshp_t_s *reshp);
 /** \} */
 
+/**
+ * \{
+ * \brief Multi-point residual function call-back registration.
+ * \details
+ * This function registers in the nonlinear data fitting handle a call-back that
+ * evaluates the residuals of the model defined by
+ * @ref da_nlls_define_residuals_d at several points in one call. It is only used
+ * to estimate the Jacobian matrix when \p resgrd, \p reshes and \p reshp were not
+ * provided: the perturbed points of each estimate are then evaluated with a single call
+ * to \p resfun, and the optional parameter \p finite \p differences \p threads is
+ * ignored. Defining the residuals again removes this call-back.
+ *
+ * \param[inout] handle a @ref da_handle object, initialized with type @ref da_handle_nlls.
+ * \param[in] resfun function callback to evaluate the residual vectors at several
+ *             points. Set to \p NULL to remove a previously registered call-back.
+ * \return \ref da_status. The function returns:
+ *  - @ref da_status_success - the operation was successfully completed.
+ *  - @ref da_status_handle_not_initialized - handle was not initialized properly (with @ref da_handle_nlls) or has been corrupted.
+ *  - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ *  - @ref da_status_invalid_input - the residuals of the model were not defined.
+ */
+da_status da_nlls_define_residuals_multi_d(da_handle handle,
+                                           da_resfun_multi_t_d *resfun);
+da_status da_nlls_define_residuals_multi_s(da_handle handle,
+                                           da_resfun_multi_t_s *resfun);
+/** \} */
+
+/**
+ * \{
+ * \brief Batched nonlinear data fitting function call-backs registration.
+ * \details
+ * This function registers in the nonlinear data fitting handle the residual
+ * function call-backs used by @ref da_nlls_fit_batch_d to fit
+ * many independent models that share the same number of coefficients and
+ * residuals. The call-backs receive the index of the problem being evaluated.
+ *
+ * \param[inout] handle a @ref da_handle object, initialized with type @ref da_handle_nlls.
+ * \param[in] n_coef number of coefficients of each model.
+ * \param[in] n_res number of residuals of each model.
+ * \param[in] resfun function callback to provide the residual vector of a problem.
+ * \param[in] resgrd function callback to provide the Jacobian matrix of a problem. If not
+ *             available, set to \p NULL and the derivatives are estimated.
+ * \return \ref da_status. The function returns:
+ *  - @ref da_status_success - the operation was successfully completed.
+ *  - @ref da_status_handle_not_initialized - handle was not initialized properly (with @ref da_handle_nlls) or has been corrupted.
+ *  - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ *  - @ref da_status_invalid_input - one or more of the input arguments are invalid.
+ */
+da_status da_nlls_define_residuals_batch_d(da_handle handle, da_int n_coef, da_int n_res,
+                                           da_resfun_batch_t_d *resfun,
+                                           da_resgrd_batch_t_d *resgrd);
+da_status da_nlls_define_residuals_batch_s(da_handle handle, da_int n_coef, da_int n_res,
+                                           da_resfun_batch_t_s *resfun,
+                                           da_resgrd_batch_t_s *resgrd);
+/** \} */
+
 /**
  * \{
  * \brief Set bound constraints on nonlinear models.
@@ -378,6 +518,69 @@ da_status da_nlls_fit_d(da_handle handle, da_int n_coef, double *coef, void *uda
 da_status da_nlls_fit_s(da_handle handle, da_int n_coef, float *coef, void *udata);
 /** \} */
 
+/**
+ * \{
+ * \brief Fit a batch of independent nonlinear models.
+ *
+ * \details
+ * @rst
+ * This function trains :code:`n_problems` independent nonlinear models that share the
+ * number of coefficients and residuals, the optional parameters, the bound constraints
+ * and the residual weights defined in the :code:`handle`. The residuals are registered
+ * with :cpp:func:`da_nlls_define_residuals_batch_? <da_nlls_define_residuals_batch_d>`.
+ *
+ * The problems are distributed over the OpenMP threads, each one solved by its own solver
+ * instance, so the call-backs must be thread-safe. This is much faster than calling
+ * :cpp:func:`da_nlls_fit_? <da_nlls_fit_d>` in a loop when fitting many small models,
+ * such as one curve per pixel or per sensor. Output requested by the option
+ * :code:`print level` may be interleaved between problems, and derivative estimates
+ * within a problem are evaluated serially.
+ *
+ * The option :code:`nlls batch solver` chooses between the RALFit solver and a built-in
+ * Levenberg-Marquardt solver with a much lower cost per problem, which by default is used
+ * for models with at most 8 coefficients.
+ *
+ * After the fit, the information vector :cpp:enumerator:`da_result_::da_rinfo` holds
+ * the sum over the batch of the objective values, iteration and evaluation counters, and
+ * the largest gradient norms.
+ * @endrst
+ *
+ * \param[inout] handle a @ref da_handle object, initialized with type @ref da_handle_nlls.
+ * \param[in] n_problems number of problems in the batch.
+ * \param[in] n_coef number of coefficients of each model.
+ * \param[inout] coef array of size \p n_coef * \p n_problems. On entry, the coefficients
+ *            of problem \p p, from <tt>coef[p*n_coef]</tt> to <tt>coef[(p+1)*n_coef-1]</tt>,
+ *            are its initial guess. On exit, they contain its optimized coefficients unless the
+ *            solver for that problem failed with an error.
+ * \param[out] problem_status array of size \p n_problems holding the exit status of each
+ *            problem, with the same meaning as the values returned by
+ *            @ref da_nlls_fit_d. Can be \p NULL if not required.
+ * \param[inout] udata a generic pointer for the caller to pass any data objects to the
+ *                residual callbacks. This pointer is passed to the callbacks untouched.
+ *
+ * \return \ref da_status. The function returns:
+ *    - @ref da_status_success - every problem was successfully solved.
+ *    - @ref da_status_handle_not_initialized - handle was not initialized properly
+ *           (with @ref da_handle_nlls) or has been corrupted.
+ *    - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with
+ *           the @p handle initialization.
+ *    - @ref da_status_invalid_handle_type - \p handle was not initialized with \p handle_type =
+ *           @ref da_handle_nlls or \p handle is invalid.
+ *    - @ref da_status_invalid_input - one or more of the input arguments are invalid, or no
+ *           batched residuals were defined.
+ *    - @ref da_status_invalid_array_dimension - \p n_coef does not match the handle.
+ *    - @ref da_status_incompatible_options - the Levenberg-Marquardt batch solver was
+ *           requested together with cubic regularization.
+ *    - any status returned by @ref da_nlls_fit_d - the status of the first problem that did not
+ *      finish successfully. It is a warning if at least one problem returned usable
+ *      coefficients; check \p problem_status for the outcome of each problem.
+ */
+da_status da_nlls_fit_batch_d(da_handle handle, da_int n_problems, da_int n_coef,
+                              double *coef, da_status *problem_status, void *udata);
+da_status da_nlls_fit_batch_s(da_handle handle, da_int n_problems, da_int n_coef,
+                              float *coef, da_status *problem_status, void *udata);
+/** \} */
+
 /**
  * @brief Indices of the information vector containing metrics from optimization solvers
  *
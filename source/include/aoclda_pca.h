@@ -59,10 +59,63 @@ da_status da_pca_set_data_s(da_handle handle, da_int n_samples, da_int n_feature
                             const float *A, da_int lda);
 /** \} */
 
+/**
+ * \{
+ * \brief PCA call-back. Row block function signature
+ * \details
+ * This function copies rows \p first_row, ..., \p first_row + \p n_rows - 1 (zero-based) of the data matrix into \p block.
+ * It is used when the data matrix is supplied with \ref da_pca_set_data_callback_s "da_pca_set_data_callback_?", for example by reading the rows from a file or from a memory-mapped array.
+ * Each computation reads the rows in increasing order, in blocks of at most <em>block size</em> rows, a small fixed number of times.
+ *
+ * \param[in] first_row the index of the first row requested.
+ * \param[in] n_rows the number of rows requested.
+ * \param[in] n_features the number of columns of the data matrix.
+ * \param[inout] data user data pointer; the library does not touch this pointer and passes it on to the call-back.
+ * \param[out] block the \p n_rows @f$\times@f$ \p n_features array to fill, stored in the order given by the <em>storage order</em> option.
+ * \param[in] ldb the leading dimension of \p block: \p n_rows in column-major order, or \p n_features in row-major order.
+ * \return flag indicating whether the rows were read successfully: zero to indicate success; nonzero to indicate failure, in which case the computation terminates with \ref da_status_io_error.
+ */
+typedef da_int da_pca_block_t_s(da_int first_row, da_int n_rows, da_int n_features,
+                                void *data, float *block, da_int ldb);
+typedef da_int da_pca_block_t_d(da_int first_row, da_int n_rows, da_int n_features,
+                                void *data, double *block, da_int ldb);
+/** \} */
+
+/** \{
+ * \brief Pass a call-back supplying the rows of the data matrix to the \ref da_handle object, in preparation for computing the PCA of data that does not fit in memory.
+ *
+ * No data is read until \ref da_pca_compute_s "da_pca_compute_?" is called. The PCA is then computed with the randomized solver, which
+ * makes one pass over the rows to find the column statistics and <em>power iterations</em> + 2 further passes, holding at most <em>block size</em> rows in memory at a time.
+ * The products computed on each block are accumulated in parallel.
+ * Because the scores would require storing a matrix with one row per sample, the <em>store U</em> option cannot be used.
+ * @rst
+ * After calling this function you may use the option setting APIs to set :ref:`options <pca_options>`.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized using \ref da_handle_init_s "da_handle_init_?" with type \ref da_handle_pca.
+ * \param[in] n_samples the number of rows of the data matrix. Constraint: \p n_samples @f$\ge@f$ 1.
+ * \param[in] n_features the number of columns of the data matrix. Constraint: \p n_features @f$\ge@f$ 1.
+ * \param[in] read_block the call-back supplying blocks of rows of the data matrix, see \ref da_pca_block_t_s "da_pca_block_t_?".
+ * \param[inout] data user data pointer passed on to \p read_block.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_invalid_pointer - the handle has not been initialized, or \p read_block is null.
+ * - \ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message.
+ */
+da_status da_pca_set_data_callback_d(da_handle handle, da_int n_samples,
+                                     da_int n_features, da_pca_block_t_d *read_block,
+                                     void *data);
+
+da_status da_pca_set_data_callback_s(da_handle handle, da_int n_samples,
+                                     da_int n_features, da_pca_block_t_s *read_block,
+                                     void *data);
+/** \} */
+
 /** \{
  * \brief Compute PCA
  *
- * Computes a principal component analysis on the data matrix previously passed into the handle using \ref da_pca_set_data_s "da_pca_set_data_?".
+ * Computes a principal component analysis on the data matrix previously passed into the handle using \ref da_pca_set_data_s "da_pca_set_data_?" or \ref da_pca_set_data_callback_s "da_pca_set_data_callback_?".
  *
  * \param[inout] handle a \ref da_handle object, initialized using \ref da_handle_init_s "da_handle_init_?"
  *  with type \ref da_handle_pca and with data passed in via \ref da_pca_set_data_s "da_pca_set_data_?".
@@ -72,6 +125,8 @@ da_status da_pca_set_data_s(da_handle handle, da_int n_samples, da_int n_feature
  * - \ref da_status_invalid_pointer - the handle has not been initialized.
  * - \ref da_status_no_data - \ref da_pca_set_data_s "da_pca_set_data_?" has not been called prior to this function call.
  * - \ref da_status_internal_error - this can occur if your data contains undefined values.
+ * - \ref da_status_incompatible_options - the data was supplied with a call-back and either the <em>store U</em> option was set or the <em>svd solver</em> option was not \a auto or \a randomized.
+ * - \ref da_status_io_error - the row block call-back returned a nonzero value.
  *
  * \post
  * After successful execution, \ref da_handle_get_result_s "da_handle_get_result_?" can be queried with the following enums:
@@ -91,6 +146,41 @@ da_status da_pca_compute_d(da_handle handle);
 da_status da_pca_compute_s(da_handle handle);
 /** \} */
 
+/** \{
+ * \brief Update the PCA with a batch of samples
+ *
+ * Fits the PCA incrementally, one batch of samples at a time, so that the full data matrix never needs to be held in memory.
+ * The column means, the column variances and a rank-\p n_components sketch of the singular value decomposition are updated with each batch.
+ * The first call after the handle is initialized (or after \ref da_pca_set_data_s "da_pca_set_data_?" or \ref da_pca_compute_s "da_pca_compute_?") starts a new fit and reads the options; subsequent calls add further batches.
+ * The model can be queried, used to transform data, or saved at any point, and a loaded model can be updated with more batches.
+ * @rst
+ * See :ref:`Incremental PCA <pca_incremental>` for details of the algorithm and the options which are supported.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized using \ref da_handle_init_s "da_handle_init_?" with type \ref da_handle_pca.
+ * \param[in] n_samples the number of rows of the batch, \p A. Constraint: \p n_samples @f$\ge@f$ 1, and \p n_samples @f$\ge@f$ \p n_components for the first batch.
+ * \param[in] n_features the number of columns of the batch, \p A. Constraint: \p n_features @f$\ge@f$ \p n_components, and \p n_features must be the same for every batch.
+ * \param[in] A the \p n_samples @f$\times@f$ \p n_features batch. By default, it should be stored in column-major order, unless you have set the <em>storage order</em> option to <em>row-major</em>.
+ * \param[in] lda the leading dimension of the batch. Constraint: \p lda @f$\ge@f$ \p n_samples if \p A is stored in column-major order, or \p lda @f$\ge@f$ \p n_features if \p A is stored in row-major order.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_invalid_pointer - the handle has not been initialized, or \p A is null.
+ * - \ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p lda was violated.
+ * - \ref da_status_incompatible_options - the <em>PCA method</em> option was set to \a correlation or the <em>store U</em> option was set.
+ * - \ref da_status_internal_error - this can occur if your data contains undefined values.
+ *
+ * \post
+ * After successful execution, \ref da_handle_get_result_s "da_handle_get_result_?" can be queried with the same enums as after \ref da_pca_compute_s "da_pca_compute_?", except for \p da_pca_scores, \p da_pca_u and \p da_pca_column_sdevs. The first element of \p da_rinfo contains the total number of samples seen.
+ */
+da_status da_pca_partial_fit_d(da_handle handle, da_int n_samples, da_int n_features,
+                               const double *A, da_int lda);
+
+da_status da_pca_partial_fit_s(da_handle handle, da_int n_samples, da_int n_features,
+                               const float *A, da_int lda);
+/** \} */
+
 /** \{
  * \brief Transform a data matrix into new feature space
  *
@@ -122,6 +212,33 @@ da_status da_pca_transform_s(da_handle handle, da_int m_samples, da_int m_featur
                              da_int ldx_transform);
 /** \} */
 
+/** \{
+ * \brief Transform a data matrix into new feature space using an inference context
+ *
+ * Reentrant variant of \ref da_pca_transform_s "da_pca_transform_?". The handle is only read, error information and
+ * temporary arrays are kept in \p ctx, so several threads may call this function concurrently on the same computed handle
+ * provided each of them passes its own \ref da_inference_context.
+ *
+ * \param[in] handle a \ref da_handle object, with a PCA previously computed via \ref da_pca_compute_s "da_pca_compute_?".
+ * \param[inout] ctx a \ref da_inference_context initialized with \ref da_inference_context_init. Errors can be printed using \ref da_inference_context_print_error_message.
+ * \param[in] m_samples see \ref da_pca_transform_s "da_pca_transform_?".
+ * \param[in] m_features see \ref da_pca_transform_s "da_pca_transform_?".
+ * \param[in] X see \ref da_pca_transform_s "da_pca_transform_?".
+ * \param[in] ldx see \ref da_pca_transform_s "da_pca_transform_?".
+ * \param[out] X_transform see \ref da_pca_transform_s "da_pca_transform_?".
+ * \param[in] ldx_transform see \ref da_pca_transform_s "da_pca_transform_?".
+ * \return \ref da_status. The function returns the same values as \ref da_pca_transform_s "da_pca_transform_?", and additionally:
+ * - \ref da_status_invalid_pointer - \p ctx is a null pointer.
+ */
+da_status da_pca_transform_ctx_d(da_handle handle, da_inference_context ctx,
+                                 da_int m_samples, da_int m_features, const double *X,
+                                 da_int ldx, double *X_transform, da_int ldx_transform);
+
+da_status da_pca_transform_ctx_s(da_handle handle, da_inference_context ctx,
+                                 da_int m_samples, da_int m_features, const float *X,
+                                 da_int ldx, float *X_transform, da_int ldx_transform);
+/** \} */
+
 /** \{
  * \brief Transform a data matrix into the original coordinate space
  *
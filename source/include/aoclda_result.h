@@ -105,6 +105,20 @@ enum da_result_ {
     da_cubic_spline_coefficients = 901,
     // t-SNE 1001..1100
     da_tsne_embedding = 1001, ///< Low-dimensional embedding computed by <i>t</i>-SNE.
+    // Moment accumulators 1101..1200
+    da_moments_mean = 1101,     ///< Running column means.
+    da_moments_variance,        ///< Running column variances.
+    da_moments_skewness,        ///< Running column skewnesses.
+    da_moments_kurtosis,        ///< Running column kurtoses.
+    da_moments_central_moments, ///< Running column central moments of every order up to the moment order.
+    // UMAP 1201..1300
+    da_umap_embedding = 1201, ///< Low-dimensional embedding computed by UMAP.
+    // Kernel approximation 1301..1400
+    da_kernel_approx_components =
+        1301, ///< Nystroem landmarks, or weights of the random Fourier features.
+    da_kernel_approx_normalization, ///< Inverse square root of the kernel matrix of the Nystroem landmarks.
+    da_kernel_approx_offsets,      ///< Random offsets of the random Fourier features.
+    da_kernel_approx_n_components, ///< Number of features produced by the kernel approximation.
 };
 
 /** @brief Alias for the \ref da_result_ enum. */
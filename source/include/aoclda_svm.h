@@ -101,6 +101,35 @@ da_status da_svm_set_data_s(da_handle handle, da_int n_samples, da_int n_feature
                             const float *X, da_int ldx, const float *y);
 /** \} */
 
+/** \{
+ * @brief Define per-sample weights for the training data of an SVM model.
+ *
+ * Each weight scales the regularization parameter \p C of its sample, so the box constraint on the dual coefficient
+ * of sample @f$i@f$ becomes @f$0 \le \alpha_i \le w_i C@f$. A weight of zero removes the sample from the fit.
+ * Weights are supported for the C-SVC and epsilon-SVR models only.
+ *
+ * The weights are copied into the handle. They are discarded by the next call to \ref da_svm_set_data_s "da_svm_set_data_?".
+ * Call this function with @p n_weights = 0 to remove previously defined weights.
+ *
+ * @param[in,out] handle a @ref da_handle object, initialized with type @ref da_handle_svm.
+ * @param[in] n_weights the number of weights. Constraint: @p n_weights = 0 or @p n_weights = @p n_samples.
+ * @param[in] weights array of size @p n_weights containing finite, non-negative weights.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - @ref da_status_invalid_handle_type - the @p handle has not been correctly initialized.
+ * - @ref da_status_no_data - \ref da_svm_set_data_s "da_svm_set_data_?" has not been called prior to this function call.
+ * - @ref da_status_invalid_pointer - @p weights is null.
+ * - @ref da_status_invalid_input - @p n_weights is not equal to @p n_samples or one of the weights is negative or not finite.
+ *
+ * If weights are defined, \ref da_svm_compute_s "da_svm_compute_?" returns @ref da_status_incompatible_options for the nu-SVC and nu-SVR models.
+ */
+da_status da_svm_set_sample_weights_d(da_handle handle, da_int n_weights,
+                                      const double *weights);
+da_status da_svm_set_sample_weights_s(da_handle handle, da_int n_weights,
+                                      const float *weights);
+/** \} */
+
 /** \{
  * @brief Fit the SVM model defined in the @p handle.
  *
@@ -163,6 +192,32 @@ da_status da_svm_predict_s(da_handle handle, da_int n_samples, da_int n_features
                            const float *X_test, da_int ldx_test, float *predictions);
 /** \} */
 
+/** \{
+ * @brief Predict labels (or outputs) using the previously fitted SVM model and an inference context.
+ *
+ * Reentrant variant of \ref da_svm_predict_s "da_svm_predict_?". The handle is only read, error information and temporary
+ * arrays are kept in @p ctx, so several threads may call this function concurrently on the same fitted handle provided
+ * each of them passes its own \ref da_inference_context.
+ *
+ * @param[in] handle a @ref da_handle object, with type @ref da_handle_svm and a model already computed via \ref da_svm_compute_s "da_svm_compute_?".
+ * @param[inout] ctx a \ref da_inference_context initialized with \ref da_inference_context_init. Errors can be printed using \ref da_inference_context_print_error_message.
+ * @param[in] n_samples see \ref da_svm_predict_s "da_svm_predict_?".
+ * @param[in] n_features see \ref da_svm_predict_s "da_svm_predict_?".
+ * @param[in] X_test see \ref da_svm_predict_s "da_svm_predict_?".
+ * @param[in] ldx_test see \ref da_svm_predict_s "da_svm_predict_?".
+ * @param[out] predictions see \ref da_svm_predict_s "da_svm_predict_?".
+ * @return @ref da_status. The function returns the same values as \ref da_svm_predict_s "da_svm_predict_?", and additionally:
+ * - @ref da_status_invalid_pointer - @p ctx is a null pointer.
+ */
+da_status da_svm_predict_ctx_d(da_handle handle, da_inference_context ctx,
+                               da_int n_samples, da_int n_features, const double *X_test,
+                               da_int ldx_test, double *predictions);
+
+da_status da_svm_predict_ctx_s(da_handle handle, da_inference_context ctx,
+                               da_int n_samples, da_int n_features, const float *X_test,
+                               da_int ldx_test, float *predictions);
+/** \} */
+
 /** \{
  * @brief Compute the decision function for each sample in @p X_test using the SVM model.
  *
@@ -36,7 +36,9 @@
  *
  * Depending on options and layout, the data may be referenced directly or copied
  * into internal storage (for example, when normalization or a layout conversion
- * is required).
+ * is required). Data stored in row-major order with \p ldx equal to \p n_features is
+ * referenced directly and must remain valid until the last call to
+ * \ref da_tsne_transform_s "da_tsne_transform_?".
  * @rst
  * After calling this function you may use the option setting APIs to set :ref:`options <tsne_options>`.
  * @endrst
@@ -90,6 +92,44 @@ da_status da_tsne_set_init_embedding_d(da_handle handle, const double *Y, da_int
 da_status da_tsne_set_init_embedding_s(da_handle handle, const float *Y, da_int ldy);
 /** \} */
 
+/** \{
+ * \brief Supply a precomputed nearest neighbor graph for <i>t</i>-SNE.
+ *
+ * Use this API with the <em>neighbor algorithm</em> option set to <em>supplied</em> to build
+ * the affinities from your own neighbor graph instead of computing it internally. The graph
+ * is passed in compressed sparse row (CSR) form: the neighbors of sample \p i are
+ * \p col_idx[\p row_ptr[i]], ..., \p col_idx[\p row_ptr[i+1]-1], with the corresponding
+ * (unsquared) distances in \p distances. Entries referencing the sample itself are ignored
+ * and rows may contain different numbers of neighbors.
+ * \ref da_tsne_set_data_s "da_tsne_set_data_?" must be called before this function so that
+ * \p n_samples is known; calling it again discards the graph.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized using \ref da_handle_init_s "da_handle_init_?"
+ *  with type \ref da_handle_tsne, and with data already passed in via
+ *  \ref da_tsne_set_data_s "da_tsne_set_data_?".
+ * \param[in] n_samples number of rows of the graph. Constraint: must match the number of samples passed to \ref da_tsne_set_data_s "da_tsne_set_data_?".
+ * \param[in] row_ptr array of size \p n_samples + 1 of row offsets into \p col_idx and \p distances, with \p row_ptr[0] = 0 and nondecreasing values.
+ * \param[in] col_idx array of size \p row_ptr[\p n_samples] containing zero-based neighbor indices.
+ * \param[in] distances array of size \p row_ptr[\p n_samples] containing the nonnegative distances to each neighbor.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_handle_not_initialized - the handle has not been initialized.
+ * - \ref da_status_invalid_handle_type - the handle was not initialized with type \ref da_handle_tsne.
+ * - \ref da_status_no_data - \ref da_tsne_set_data_s "da_tsne_set_data_?" has not been called prior to this function call.
+ * - \ref da_status_invalid_pointer - one of \p row_ptr, \p col_idx or \p distances is null.
+ * - \ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_tsne_set_neighbors_d(da_handle handle, da_int n_samples,
+                                  const da_int *row_ptr, const da_int *col_idx,
+                                  const double *distances);
+
+da_status da_tsne_set_neighbors_s(da_handle handle, da_int n_samples,
+                                  const da_int *row_ptr, const da_int *col_idx,
+                                  const float *distances);
+/** \} */
+
 /** \{
  * \brief Compute <i>t</i>-SNE
  *
@@ -118,4 +158,43 @@ da_status da_tsne_compute_d(da_handle handle);
 da_status da_tsne_compute_s(da_handle handle);
 /** \} */
 
+/** \{
+ * \brief Embed new data using a computed <i>t</i>-SNE model.
+ *
+ * Places new samples in the embedding computed by \ref da_tsne_compute_s "da_tsne_compute_?" without changing it.
+ * For each new sample, conditional probabilities are computed over its nearest neighbors in the original data
+ * using the same perplexity, and its coordinates alone are then optimized against the fixed embedding, with the
+ * repulsive forces approximated by a Barnes-Hut tree. Samples are placed independently and in parallel.
+ * The nearest neighbor index over the original data is built on the first call and reused by later calls until the model is
+ * recomputed. It references the data matrix passed to \ref da_tsne_set_data_s "da_tsne_set_data_?" whenever that matrix was not
+ * copied, so the matrix must remain valid and unchanged until the last call to this function.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized using \ref da_handle_init_s "da_handle_init_?"
+ *  with type \ref da_handle_tsne, on which \ref da_tsne_compute_s "da_tsne_compute_?" has been successfully called.
+ * \param[in] m_samples the number of new samples to embed. Constraint: \p m_samples @f$\ge@f$ 1.
+ * \param[in] m_features the number of features in the new data. Constraint: \p m_features must equal the number of features passed to \ref da_tsne_set_data_s "da_tsne_set_data_?".
+ * \param[in] X the new data matrix of size \p m_samples @f$\times@f$ \p m_features, in the same storage format used to compute the model.
+ * \param[in] ldx the leading dimension of \p X. Constraint: \p ldx @f$\ge@f$ \p m_samples if \p X is stored in column-major order, or \p ldx @f$\ge@f$ \p m_features if \p X is stored in row-major order.
+ * \param[out] X_transform an array of size at least \p m_samples @f$\times@f$ \p n_components, in which the embedding of the new data will be stored (in the same storage format used to compute the model).
+ * \param[in] ldx_transform the leading dimension of \p X_transform. Constraint: \p ldx_transform @f$\ge@f$ \p m_samples if \p X is stored in column-major order, or \p ldx_transform @f$\ge@f$ \p n_components if \p X is stored in row-major order.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_handle_not_initialized - the handle has not been initialized.
+ * - \ref da_status_invalid_handle_type - the handle was not initialized with type \ref da_handle_tsne.
+ * - \ref da_status_no_data - \ref da_tsne_compute_s "da_tsne_compute_?" has not been successfully called.
+ * - \ref da_status_invalid_pointer - one of the arrays is null.
+ * - \ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message.
+ * - \ref da_status_invalid_leading_dimension - one of the constraints on \p ldx or \p ldx_transform was violated.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_tsne_transform_d(da_handle handle, da_int m_samples, da_int m_features,
+                              const double *X, da_int ldx, double *X_transform,
+                              da_int ldx_transform);
+
+da_status da_tsne_transform_s(da_handle handle, da_int m_samples, da_int m_features,
+                              const float *X, da_int ldx, float *X_transform,
+                              da_int ldx_transform);
+/** \} */
+
 #endif
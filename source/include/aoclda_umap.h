@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef AOCLDA_UMAP
+#define AOCLDA_UMAP
+
+#include "aoclda_error.h"
+#include "aoclda_handle.h"
+#include "aoclda_types.h"
+
+/**
+ * \file
+ */
+
+/** \{
+ * \brief Pass a data matrix to the \ref da_handle object in preparation for computing a UMAP embedding.
+ *
+ * Depending on the layout, the data may be referenced directly or copied into internal storage.
+ * @rst
+ * After calling this function you may use the option setting APIs to set :ref:`options <umap_options>`.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized using \ref da_handle_init_s "da_handle_init_?" with type \ref da_handle_umap.
+ * \param[in] n_samples the number of rows of the data matrix, \p X. Constraint: \p n_samples @f$\ge@f$ 2.
+ * \param[in] n_features the number of columns of the data matrix, \p X. Constraint: \p n_features @f$\ge@f$ 1.
+ * \param[in] X the \p n_samples @f$\times@f$ \p n_features data matrix. By default, it should be stored in column-major order, unless you have set the <em>storage order</em> option to <em>row-major</em>.
+ * \param[in] ldx the leading dimension of the data matrix. Constraint: \p ldx @f$\ge@f$ \p n_samples if \p X is stored in column-major order, or \p ldx @f$\ge@f$ \p n_features if \p X is stored in row-major order.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_handle_not_initialized - the handle has not been initialized.
+ * - \ref da_status_invalid_handle_type - the handle was not initialized with type \ref da_handle_umap.
+ * - \ref da_status_invalid_pointer - \p X is null.
+ * - \ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message.
+ * - \ref da_status_invalid_array_dimension - \p n_samples is less than 2 or \p n_features is less than 1.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx was violated.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_umap_set_data_d(da_handle handle, da_int n_samples, da_int n_features,
+                             const double *X, da_int ldx);
+
+da_status da_umap_set_data_s(da_handle handle, da_int n_samples, da_int n_features,
+                             const float *X, da_int ldx);
+/** \} */
+
+/** \{
+ * \brief Compute a UMAP embedding.
+ *
+ * Builds the fuzzy neighbor graph of the data matrix previously passed into the handle using
+ * \ref da_umap_set_data_s "da_umap_set_data_?" and optimizes a low-dimensional embedding of it.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized using \ref da_handle_init_s "da_handle_init_?" with type \ref da_handle_umap.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_handle_not_initialized - the handle has not been initialized.
+ * - \ref da_status_invalid_handle_type - the handle was not initialized with type \ref da_handle_umap.
+ * - \ref da_status_no_data - \ref da_umap_set_data_s "da_umap_set_data_?" has not been called prior to this function call.
+ * - \ref da_status_incompatible_options - \p n_components is not smaller than \p n_samples, or PCA initialization was requested with \p n_components larger than \p n_features.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ *
+ * \post
+ * \parblock
+ * After successful execution, \ref da_handle_get_result_s "da_handle_get_result_?" can be queried with:
+ * - \p da_umap_embedding - return an array of size \p n_samples @f$\times@f$ \p n_components containing the low-dimensional embedding, in the same storage order as the input data.
+ * - \p da_rinfo - return an array of size 6 containing \p n_samples, \p n_features, \p n_components, the number of epochs and the fitted curve parameters \p a and \p b.
+ * \endparblock
+ */
+da_status da_umap_compute_d(da_handle handle);
+
+da_status da_umap_compute_s(da_handle handle);
+/** \} */
+
+/** \{
+ * \brief Embed new data using a computed UMAP model.
+ *
+ * Places new samples in the embedding computed by \ref da_umap_compute_s "da_umap_compute_?" without changing it.
+ * Each new sample is connected to its nearest neighbors in the original data, initialized at the weighted mean of
+ * their positions and then optimized against the fixed embedding. The neighbors are searched in the index built by
+ * \ref da_umap_compute_s "da_umap_compute_?" (or when the model is loaded), so repeated calls do not rebuild it.
+ * Unless the model was loaded from a file, the data matrix passed to \ref da_umap_set_data_s "da_umap_set_data_?" must still be valid when this function is called.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized using \ref da_handle_init_s "da_handle_init_?"
+ *  with type \ref da_handle_umap, on which \ref da_umap_compute_s "da_umap_compute_?" has been successfully called.
+ * \param[in] m_samples the number of new samples to embed. Constraint: \p m_samples @f$\ge@f$ 1.
+ * \param[in] m_features the number of features in the new data. Constraint: \p m_features must equal the number of features passed to \ref da_umap_set_data_s "da_umap_set_data_?".
+ * \param[in] X the new data matrix of size \p m_samples @f$\times@f$ \p m_features, in the same storage format used to compute the model.
+ * \param[in] ldx the leading dimension of \p X. Constraint: \p ldx @f$\ge@f$ \p m_samples if \p X is stored in column-major order, or \p ldx @f$\ge@f$ \p m_features if \p X is stored in row-major order.
+ * \param[out] X_transform an array of size at least \p m_samples @f$\times@f$ \p n_components, in which the embedding of the new data will be stored (in the same storage format used to compute the model).
+ * \param[in] ldx_transform the leading dimension of \p X_transform. Constraint: \p ldx_transform @f$\ge@f$ \p m_samples if \p X is stored in column-major order, or \p ldx_transform @f$\ge@f$ \p n_components if \p X is stored in row-major order.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_handle_not_initialized - the handle has not been initialized.
+ * - \ref da_status_invalid_handle_type - the handle was not initialized with type \ref da_handle_umap.
+ * - \ref da_status_no_data - \ref da_umap_compute_s "da_umap_compute_?" has not been successfully called.
+ * - \ref da_status_invalid_pointer - one of the arrays is null.
+ * - \ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message.
+ * - \ref da_status_invalid_leading_dimension - one of the constraints on \p ldx or \p ldx_transform was violated.
+ * - \ref da_status_memory_error - a memory allocation error occurred.
+ */
+da_status da_umap_transform_d(da_handle handle, da_int m_samples, da_int m_features,
+                              const double *X, da_int ldx, double *X_transform,
+                              da_int ldx_transform);
+
+da_status da_umap_transform_s(da_handle handle, da_int m_samples, da_int m_features,
+                              const float *X, da_int ldx, float *X_transform,
+                              da_int ldx_transform);
+/** \} */
+
+/** \{
+ * \brief Embed new data using a computed UMAP model and an inference context
+ *
+ * Reentrant variant of \ref da_umap_transform_s "da_umap_transform_?". The handle is only read, error information and
+ * temporary arrays are kept in \p ctx, so several threads may call this function concurrently on the same computed handle
+ * provided each of them passes its own \ref da_inference_context.
+ *
+ * \param[in] handle a \ref da_handle object, on which \ref da_umap_compute_s "da_umap_compute_?" has been successfully called.
+ * \param[inout] ctx a \ref da_inference_context initialized with \ref da_inference_context_init. Errors can be printed using \ref da_inference_context_print_error_message.
+ * \param[in] m_samples see \ref da_umap_transform_s "da_umap_transform_?".
+ * \param[in] m_features see \ref da_umap_transform_s "da_umap_transform_?".
+ * \param[in] X see \ref da_umap_transform_s "da_umap_transform_?".
+ * \param[in] ldx see \ref da_umap_transform_s "da_umap_transform_?".
+ * \param[out] X_transform see \ref da_umap_transform_s "da_umap_transform_?".
+ * \param[in] ldx_transform see \ref da_umap_transform_s "da_umap_transform_?".
+ * \return \ref da_status. The function returns the same values as \ref da_umap_transform_s "da_umap_transform_?", and additionally:
+ * - \ref da_status_invalid_pointer - \p ctx is a null pointer.
+ */
+da_status da_umap_transform_ctx_d(da_handle handle, da_inference_context ctx,
+                                  da_int m_samples, da_int m_features, const double *X,
+                                  da_int ldx, double *X_transform, da_int ldx_transform);
+
+da_status da_umap_transform_ctx_s(da_handle handle, da_inference_context ctx,
+                                  da_int m_samples, da_int m_features, const float *X,
+                                  da_int ldx, float *X_transform, da_int ldx_transform);
+/** \} */
+
+#endif
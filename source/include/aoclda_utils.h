@@ -212,6 +212,36 @@ da_status da_get_shuffled_indices_d(da_int m, da_int seed, da_int train_size,
  */
 da_status da_print_model_metadata(const char *filename);
 
+/**
+ * \brief Measure the kernel tuning tables on this machine and write a tuning profile.
+ *
+ * Times the vectorized kernels of k-means, the kernel functions and SVM for each candidate instruction set over a range of problem sizes, and records the fastest choice in the tuning profile file \p filename. The profile is also made active for the rest of the run.
+ * The profile can be loaded in later runs with \ref da_tuning_profile_load or by setting the environment variable \c AOCL_DA_TUNING_PROFILE to its path.
+ *
+ * The measurement takes a few seconds and must not run concurrently with other calls to the library.
+ *
+ * \param[in] filename path of the tuning profile to write.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_invalid_pointer - \p filename was \p null.
+ * - \ref da_status_io_error - the file could not be written.
+ * - \ref da_status_memory_error - memory allocation failed.
+ */
+da_status da_tuning_profile_generate(const char *filename);
+
+/**
+ * \brief Load a kernel tuning profile.
+ *
+ * Replaces the kernel selection thresholds compiled into the library with those stored in the tuning profile \p filename, as written by \ref da_tuning_profile_generate. The profile is only used while the architecture it was measured on is selected.
+ *
+ * \param[in] filename path of the tuning profile to load. If \p null, the active profile is discarded and the compiled tables are used.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_io_error - the file could not be opened.
+ * - \ref da_status_invalid_file_data - the file is not a valid tuning profile; the active profile is unchanged.
+ */
+da_status da_tuning_profile_load(const char *filename);
+
 /**
  * @brief returns a char* array describing the da_int integer used by the library
  *
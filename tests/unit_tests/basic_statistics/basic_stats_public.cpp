@@ -35,6 +35,8 @@
 #include <list>
 
 #include "correlation_and_covariance_tests.hpp"
+#include "moment_accumulator_tests.hpp"
 #include "moment_statistics_tests.hpp"
 #include "order_statistics_tests.hpp"
+#include "quantile_sketch_tests.hpp"
 #include "statistics_utilities_tests.hpp"
\ No newline at end of file
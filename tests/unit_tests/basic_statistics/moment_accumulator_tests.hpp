@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "../utest_utils.hpp"
+#include "aoclda.h"
+#include "aoclda.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename T> class MomentAccumulatorTest : public testing::Test {
+  public:
+    using List = std::list<T>;
+    static T shared_;
+    T value_;
+};
+
+// Column-major n x p data with a large offset, so that catastrophic cancellation would
+// show up in a naive sum-of-powers implementation
+template <typename T> std::vector<T> accumulator_data(da_int n, da_int p) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 3.0);
+    std::vector<T> x(n * p);
+    for (da_int j = 0; j < p; j++)
+        for (da_int i = 0; i < n; i++)
+            x[i + j * n] = (T)(1000.0 * (j + 1) + std::pow(dist(gen), j + 1));
+    return x;
+}
+
+// Feed rows [row_start, row_end) of the column-major matrix x to the accumulator in blocks
+template <typename T>
+void accumulate_rows(da_handle handle, da_order order, da_int n, da_int p,
+                     const std::vector<T> &x, da_int row_start, da_int row_end,
+                     da_int block) {
+    EXPECT_EQ(da_options_set_string(handle, "storage order",
+                                    order == column_major ? "column-major" : "row-major"),
+              da_status_success);
+    for (da_int r = row_start; r < row_end; r += block) {
+        da_int nb = std::min(block, row_end - r);
+        std::vector<T> xb;
+        da_int ldx;
+        if (order == column_major) {
+            // Pad the leading dimension to exercise ldx > n_rows
+            ldx = nb + 1;
+            xb.resize(ldx * p);
+            for (da_int j = 0; j < p; j++)
+                for (da_int i = 0; i < nb; i++)
+                    xb[i + j * ldx] = x[r + i + j * n];
+        } else {
+            ldx = p;
+            xb.resize(nb * p);
+            for (da_int i = 0; i < nb; i++)
+                for (da_int j = 0; j < p; j++)
+                    xb[i * p + j] = x[r + i + j * n];
+        }
+        EXPECT_EQ(da_moments_update(handle, nb, p, xb.data(), ldx), da_status_success);
+    }
+}
+
+template <typename T>
+void expect_rel_near(da_int n, const T *expected, const T *actual, T tol,
+                     const std::string &name) {
+    for (da_int j = 0; j < n; j++)
+        EXPECT_NEAR(expected[j], actual[j], tol * std::max((T)1, std::abs(expected[j])))
+            << name << ", j = " << j;
+}
+
+template <typename T>
+void check_accumulated_moments(da_handle handle, da_int n, da_int p,
+                               const std::vector<T> &x, da_order order) {
+    const da_int k_max = 5;
+    T tol = std::is_same_v<T, float> ? (T)1.0e-2 : (T)1.0e-9;
+
+    std::vector<T> mean(p), var(p), var_b(p), skew(p), kurt(p), mom(p);
+    ASSERT_EQ(da_variance(column_major, da_axis_col, n, p, x.data(), n, 0, mean.data(),
+                          var.data()),
+              da_status_success);
+    ASSERT_EQ(da_skewness(column_major, da_axis_col, n, p, x.data(), n, mean.data(),
+                          var_b.data(), skew.data()),
+              da_status_success);
+    ASSERT_EQ(da_kurtosis(column_major, da_axis_col, n, p, x.data(), n, mean.data(),
+                          var_b.data(), kurt.data()),
+              da_status_success);
+
+    da_int dim = p;
+    std::vector<T> res(p * k_max);
+    EXPECT_EQ(da_handle_get_result(handle, da_moments_mean, &dim, res.data()),
+              da_status_success);
+    expect_rel_near(p, mean.data(), res.data(), tol, "mean");
+    EXPECT_EQ(da_handle_get_result(handle, da_moments_variance, &dim, res.data()),
+              da_status_success);
+    expect_rel_near(p, var.data(), res.data(), tol, "variance");
+    EXPECT_EQ(da_handle_get_result(handle, da_moments_skewness, &dim, res.data()),
+              da_status_success);
+    expect_rel_near(p, skew.data(), res.data(), tol, "skewness");
+    EXPECT_EQ(da_handle_get_result(handle, da_moments_kurtosis, &dim, res.data()),
+              da_status_success);
+    expect_rel_near(p, kurt.data(), res.data(), tol, "kurtosis");
+
+    // Biased variance
+    EXPECT_EQ(da_options_set_string(handle, "degrees of freedom", "biased"),
+              da_status_success);
+    EXPECT_EQ(da_handle_get_result(handle, da_moments_variance, &dim, res.data()),
+              da_status_success);
+    expect_rel_near(p, var_b.data(), res.data(), tol, "biased variance");
+    EXPECT_EQ(da_options_set_string(handle, "degrees of freedom", "unbiased"),
+              da_status_success);
+
+    // Central moments of every order, returned in the storage order of the handle
+    dim = p * k_max;
+    EXPECT_EQ(da_handle_get_result(handle, da_moments_central_moments, &dim, res.data()),
+              da_status_success);
+    std::vector<T> res_k(p);
+    for (da_int k = 1; k <= k_max; k++) {
+        for (da_int j = 0; j < p; j++)
+            res_k[j] =
+                order == column_major ? res[j + (k - 1) * p] : res[j * k_max + k - 1];
+        if (k == 1) {
+            EXPECT_THAT(res_k, testing::Each(testing::Eq((T)0)));
+            continue;
+        }
+        ASSERT_EQ(da_moment(column_major, da_axis_col, n, p, x.data(), n, k, 1,
+                            mean.data(), mom.data()),
+                  da_status_success);
+        expect_rel_near(p, mom.data(), res_k.data(), tol, "moment " + std::to_string(k));
+    }
+
+    std::vector<T> rinfo(3);
+    dim = 3;
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, rinfo.data()),
+              da_status_success);
+    EXPECT_EQ(rinfo[0], (T)n);
+    EXPECT_EQ(rinfo[1], (T)p);
+    EXPECT_EQ(rinfo[2], (T)k_max);
+}
+
+using MomentAccumulatorTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(MomentAccumulatorTest, MomentAccumulatorTypes);
+
+TYPED_TEST(MomentAccumulatorTest, BlockUpdates) {
+    const da_int n = 103, p = 4;
+    std::vector<TypeParam> x = accumulator_data<TypeParam>(n, p);
+
+    for (da_order order : {column_major, row_major}) {
+        for (da_int block : {1, 7, 50, n}) {
+            da_handle handle = nullptr;
+            ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_moments),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_int(handle, "moment order", 5), da_status_success);
+            accumulate_rows(handle, order, n, p, x, 0, n, block);
+            check_accumulated_moments(handle, n, p, x, order);
+            da_handle_destroy(&handle);
+        }
+    }
+}
+
+TYPED_TEST(MomentAccumulatorTest, MergeAndPersistence) {
+    const da_int n = 103, p = 4;
+    std::vector<TypeParam> x = accumulator_data<TypeParam>(n, p);
+
+    // Two accumulators fed disjoint sets of rows, then merged
+    da_handle handle = nullptr, handle_other = nullptr, handle_empty = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_moments), da_status_success);
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle_other, da_handle_moments),
+              da_status_success);
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle_empty, da_handle_moments),
+              da_status_success);
+    for (da_handle h : {handle, handle_other, handle_empty})
+        EXPECT_EQ(da_options_set_int(h, "moment order", 5), da_status_success);
+    accumulate_rows(handle, column_major, n, p, x, 0, 31, 10);
+    accumulate_rows(handle_other, row_major, n, p, x, 31, n, 19);
+    EXPECT_EQ(da_moments_merge<TypeParam>(handle, handle_other), da_status_success);
+    check_accumulated_moments(handle, n, p, x, column_major);
+
+    // Merging into an empty accumulator copies the state
+    EXPECT_EQ(da_moments_merge<TypeParam>(handle_empty, handle), da_status_success);
+    check_accumulated_moments(handle_empty, n, p, x, column_major);
+
+    // Save and restore, then check the state is unchanged
+    std::string model_file = "moment_accumulator_test.bin";
+    EXPECT_EQ(da_handle_save_model(handle, model_file.c_str()), da_status_success);
+    da_handle handle_loaded = nullptr;
+    EXPECT_EQ(da_handle_load_model(&handle_loaded, model_file.c_str()),
+              da_status_success);
+    std::remove(model_file.c_str());
+    check_accumulated_moments(handle_loaded, n, p, x, column_major);
+
+    // Accumulation can be resumed after loading
+    std::vector<TypeParam> x2(2 * n * p);
+    for (da_int j = 0; j < p; j++)
+        for (da_int i = 0; i < n; i++)
+            x2[i + j * 2 * n] = x2[n + i + j * 2 * n] = x[i + j * n];
+    accumulate_rows(handle_loaded, column_major, 2 * n, p, x2, n, 2 * n, 60);
+    check_accumulated_moments(handle_loaded, 2 * n, p, x2, column_major);
+
+    da_handle_destroy(&handle);
+    da_handle_destroy(&handle_other);
+    da_handle_destroy(&handle_empty);
+    da_handle_destroy(&handle_loaded);
+}
+
+TYPED_TEST(MomentAccumulatorTest, ErrorExits) {
+    using T = TypeParam;
+    std::vector<T> x{1, 2, 3, 4, 5, 6};
+    da_int dim = 2;
+    std::vector<T> res(8);
+
+    da_handle handle = nullptr, handle_other = nullptr, handle_wrong = nullptr;
+    EXPECT_EQ(da_moments_update(handle, 3, 2, x.data(), 3),
+              da_status_handle_not_initialized);
+    ASSERT_EQ(da_handle_init<T>(&handle, da_handle_moments), da_status_success);
+    ASSERT_EQ(da_handle_init<T>(&handle_other, da_handle_moments), da_status_success);
+    ASSERT_EQ(da_handle_init<T>(&handle_wrong, da_handle_pca), da_status_success);
+
+    // Results before any data
+    EXPECT_EQ(da_handle_get_result(handle, da_moments_mean, &dim, res.data()),
+              da_status_no_data);
+
+    // Invalid arguments
+    EXPECT_EQ(da_moments_update(handle_wrong, 3, 2, x.data(), 3),
+              da_status_invalid_handle_type);
+    EXPECT_EQ(da_moments_update(handle, 0, 2, x.data(), 3),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(da_moments_update(handle, 3, 2, x.data(), 2),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_moments_update<T>(handle, 3, 2, nullptr, 3), da_status_invalid_pointer);
+
+    // Order 3 accumulators cannot report kurtosis
+    EXPECT_EQ(da_options_set_int(handle, "moment order", 3), da_status_success);
+    EXPECT_EQ(da_moments_update(handle, 3, 2, x.data(), 3), da_status_success);
+    EXPECT_EQ(da_handle_get_result(handle, da_moments_kurtosis, &dim, res.data()),
+              da_status_unknown_query);
+    EXPECT_EQ(da_handle_get_result(handle, da_moments_skewness, &dim, res.data()),
+              da_status_success);
+    dim = 1;
+    EXPECT_EQ(da_handle_get_result(handle, da_moments_mean, &dim, res.data()),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, 2);
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_scores, &dim, res.data()),
+              da_status_unknown_query);
+
+    // Inconsistent subsequent calls
+    EXPECT_EQ(da_moments_update(handle, 2, 3, x.data(), 2), da_status_invalid_input);
+    EXPECT_EQ(da_options_set_int(handle, "moment order", 4), da_status_success);
+    EXPECT_EQ(da_moments_update(handle, 3, 2, x.data(), 3),
+              da_status_incompatible_options);
+
+    // Merging incompatible accumulators
+    EXPECT_EQ(da_moments_merge<T>(handle, handle_wrong), da_status_invalid_handle_type);
+    EXPECT_EQ(da_moments_update(handle_other, 3, 2, x.data(), 3), da_status_success);
+    EXPECT_EQ(da_moments_merge<T>(handle, handle_other), da_status_incompatible_options);
+    da_handle_destroy(&handle_other);
+    ASSERT_EQ(da_handle_init<T>(&handle_other, da_handle_moments), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle_other, "moment order", 3), da_status_success);
+    EXPECT_EQ(da_moments_update(handle_other, 2, 3, x.data(), 2), da_status_success);
+    EXPECT_EQ(da_moments_merge<T>(handle, handle_other), da_status_invalid_input);
+
+    da_handle_destroy(&handle);
+    da_handle_destroy(&handle_other);
+    da_handle_destroy(&handle_wrong);
+}
@@ -1262,4 +1262,37 @@ TYPED_TEST(OrderStatisticsTest, NumericalStabilityQuantiles) {
                           result.data(), da_quantile_type_2),
               da_status_success);
     EXPECT_EQ(result[0], (TypeParam)1.0);
-}
\ No newline at end of file
+}
+
+TYPED_TEST(OrderStatisticsTest, ParallelColumnsMatchSingleColumn) {
+    // Large enough for the statistics to be computed in parallel
+    da_int n = 3001, p = 9;
+    std::vector<TypeParam> x(n * p);
+    for (da_int i = 0; i < n * p; i++)
+        x[i] = (TypeParam)((i * 7919) % 10007) / (TypeParam)10007;
+    std::vector<TypeParam> q = {(TypeParam)0.0, (TypeParam)0.1, (TypeParam)0.5,
+                                (TypeParam)0.37, (TypeParam)0.9, (TypeParam)1.0};
+    da_int n_q = (da_int)q.size();
+
+    for (da_quantile_type qtype : {da_quantile_type_1, da_quantile_type_7}) {
+        std::vector<TypeParam> quants(n_q * p), quants_row(n_q * n), single(n_q);
+        EXPECT_EQ(da_quantile(column_major, da_axis_col, n, p, x.data(), n, q.data(),
+                              n_q, quants.data(), qtype),
+                  da_status_success);
+        for (da_int j = 0; j < p; j++) {
+            EXPECT_EQ(da_quantile(column_major, da_axis_col, n, 1, x.data() + j * n, n,
+                                  q.data(), n_q, single.data(), qtype),
+                      da_status_success);
+            for (da_int iq = 0; iq < n_q; iq++)
+                EXPECT_EQ(single[iq], quants[j * n_q + iq]);
+        }
+
+        // Same data seen as row-major p x n, quantiles by row
+        EXPECT_EQ(da_quantile(row_major, da_axis_row, p, n, x.data(), n, q.data(), n_q,
+                              quants_row.data(), qtype),
+                  da_status_success);
+        for (da_int j = 0; j < p; j++)
+            for (da_int iq = 0; iq < n_q; iq++)
+                EXPECT_EQ(quants_row[iq * p + j], quants[j * n_q + iq]);
+    }
+}
@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "../utest_utils.hpp"
+#include "aoclda.h"
+#include "aoclda.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename T> class QuantileSketchTest : public testing::Test {
+  public:
+    using List = std::list<T>;
+    static T shared_;
+    T value_;
+};
+
+// Column-major n x p data; each column has a different distribution
+template <typename T> std::vector<T> sketch_data(da_int n, da_int p, da_int seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::vector<T> x(n * p);
+    for (da_int j = 0; j < p; j++)
+        for (da_int i = 0; i < n; i++) {
+            double z = normal(gen);
+            x[i + j * n] = (T)(j % 2 == 0 ? z * (j + 1) : std::exp(z));
+        }
+    return x;
+}
+
+template <typename T>
+void sketch_rows(da_handle handle, da_int n, da_int p, const std::vector<T> &x,
+                 da_int row_start, da_int row_end, da_int block) {
+    for (da_int r = row_start; r < row_end; r += block) {
+        da_int nb = std::min(block, row_end - r);
+        std::vector<T> xb(nb * p);
+        for (da_int j = 0; j < p; j++)
+            for (da_int i = 0; i < nb; i++)
+                xb[i + j * nb] = x[r + i + j * n];
+        EXPECT_EQ(da_quantile_sketch_update(handle, nb, p, xb.data(), nb),
+                  da_status_success);
+    }
+}
+
+// Check that the rank of each returned quantile is within the advertised error
+template <typename T>
+void check_sketch_ranks(da_handle handle, da_int n, da_int p, const std::vector<T> &x) {
+    std::vector<T> q;
+    for (da_int i = 0; i <= 100; i++)
+        q.push_back((T)i / (T)100);
+    da_int n_q = (da_int)q.size();
+    std::vector<T> quants(n_q * p);
+    ASSERT_EQ(da_quantile_sketch_query(handle, n_q, q.data(), quants.data()),
+              da_status_success);
+
+    da_int dim = 5;
+    std::vector<T> rinfo(dim);
+    ASSERT_EQ(da_handle_get_result(handle, da_rinfo, &dim, rinfo.data()),
+              da_status_success);
+    EXPECT_EQ(rinfo[0], (T)n);
+    EXPECT_EQ(rinfo[1], (T)p);
+    // The bound holds with high probability for each quantile; allow some slack since
+    // many quantiles are checked at once
+    T eps = 2 * rinfo[4];
+    // Bounded memory: far fewer items are kept than were added
+    EXPECT_LT(rinfo[3], (T)(4 * rinfo[2] + 64));
+
+    for (da_int j = 0; j < p; j++) {
+        std::vector<T> col(x.begin() + j * n, x.begin() + (j + 1) * n);
+        std::sort(col.begin(), col.end());
+        EXPECT_EQ(quants[j * n_q], col[0]);
+        EXPECT_EQ(quants[j * n_q + n_q - 1], col[n - 1]);
+        for (da_int iq = 1; iq < n_q - 1; iq++) {
+            T val = quants[j * n_q + iq];
+            // Range of ranks occupied by the returned value
+            double lo = (double)(std::lower_bound(col.begin(), col.end(), val) -
+                                 col.begin()) /
+                        n;
+            double hi = (double)(std::upper_bound(col.begin(), col.end(), val) -
+                                 col.begin()) /
+                        n;
+            EXPECT_GE((double)q[iq], lo - eps) << "column " << j << ", q = " << q[iq];
+            EXPECT_LE((double)q[iq], hi + eps) << "column " << j << ", q = " << q[iq];
+        }
+    }
+}
+
+using QuantileSketchTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(QuantileSketchTest, QuantileSketchTypes);
+
+TYPED_TEST(QuantileSketchTest, ExactForSmallStreams) {
+    // With fewer rows than the sketch size nothing is compacted and the result is the
+    // exact inverse of the empirical distribution function
+    da_int n = 150, p = 3;
+    std::vector<TypeParam> x = sketch_data<TypeParam>(n, p, 7);
+    std::vector<TypeParam> q = {(TypeParam)0.0,  (TypeParam)0.05, (TypeParam)0.25,
+                                (TypeParam)0.5,  (TypeParam)0.33, (TypeParam)0.9,
+                                (TypeParam)0.99, (TypeParam)1.0};
+    da_int n_q = (da_int)q.size();
+    std::vector<TypeParam> expected(n_q * p), quants(n_q * p), quants_row(n_q * p);
+    EXPECT_EQ(da_quantile(column_major, da_axis_col, n, p, x.data(), n, q.data(), n_q,
+                          expected.data(), da_quantile_type_1),
+              da_status_success);
+
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_quantile_sketch),
+              da_status_success);
+    sketch_rows(handle, n, p, x, 0, n, 40);
+    EXPECT_EQ(da_quantile_sketch_query(handle, n_q, q.data(), quants.data()),
+              da_status_success);
+    EXPECT_ARR_NEAR(n_q * p, expected.data(), quants.data(), 0);
+
+    // Row-major output
+    EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+              da_status_success);
+    EXPECT_EQ(da_quantile_sketch_query(handle, n_q, q.data(), quants_row.data()),
+              da_status_success);
+    for (da_int j = 0; j < p; j++)
+        for (da_int iq = 0; iq < n_q; iq++)
+            EXPECT_EQ(quants_row[iq * p + j], expected[j * n_q + iq]);
+
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(QuantileSketchTest, RankErrorBound) {
+    da_int n = 20000, p = 3;
+    std::vector<TypeParam> x = sketch_data<TypeParam>(n, p, 11);
+
+    for (da_int block : {1000, 20000}) {
+        da_handle handle = nullptr;
+        ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_quantile_sketch),
+                  da_status_success);
+        sketch_rows(handle, n, p, x, 0, n, block);
+        check_sketch_ranks(handle, n, p, x);
+        da_handle_destroy(&handle);
+    }
+}
+
+TYPED_TEST(QuantileSketchTest, MergeAndPersistence) {
+    da_int n = 12000, p = 2;
+    std::vector<TypeParam> x = sketch_data<TypeParam>(n, p, 3);
+
+    da_handle handle = nullptr, handle_other = nullptr, handle_empty = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_quantile_sketch),
+              da_status_success);
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle_other, da_handle_quantile_sketch),
+              da_status_success);
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle_empty, da_handle_quantile_sketch),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(handle_other, "seed", 5), da_status_success);
+    sketch_rows(handle, n, p, x, 0, 5000, 700);
+    sketch_rows(handle_other, n, p, x, 5000, n, 3000);
+    EXPECT_EQ(da_quantile_sketch_merge<TypeParam>(handle, handle_other),
+              da_status_success);
+    check_sketch_ranks(handle, n, p, x);
+
+    EXPECT_EQ(da_quantile_sketch_merge<TypeParam>(handle_empty, handle),
+              da_status_success);
+    check_sketch_ranks(handle_empty, n, p, x);
+
+    // A restored sketch answers queries identically
+    std::vector<TypeParam> q = {(TypeParam)0.1, (TypeParam)0.5, (TypeParam)0.75};
+    std::vector<TypeParam> quants(3 * p), quants_loaded(3 * p);
+    EXPECT_EQ(da_quantile_sketch_query(handle, 3, q.data(), quants.data()),
+              da_status_success);
+    std::string model_file = "quantile_sketch_test.bin";
+    EXPECT_EQ(da_handle_save_model(handle, model_file.c_str()), da_status_success);
+    da_handle handle_loaded = nullptr;
+    EXPECT_EQ(da_handle_load_model(&handle_loaded, model_file.c_str()),
+              da_status_success);
+    std::remove(model_file.c_str());
+    EXPECT_EQ(da_quantile_sketch_query(handle_loaded, 3, q.data(), quants_loaded.data()),
+              da_status_success);
+    EXPECT_ARR_NEAR(3 * p, quants.data(), quants_loaded.data(), 0);
+
+    // Sketching can be resumed after loading
+    std::vector<TypeParam> x2(2 * n * p);
+    for (da_int j = 0; j < p; j++)
+        for (da_int i = 0; i < n; i++)
+            x2[i + j * 2 * n] = x2[n + i + j * 2 * n] = x[i + j * n];
+    sketch_rows(handle_loaded, 2 * n, p, x2, n, 2 * n, 4000);
+    check_sketch_ranks(handle_loaded, 2 * n, p, x2);
+
+    da_handle_destroy(&handle);
+    da_handle_destroy(&handle_other);
+    da_handle_destroy(&handle_empty);
+    da_handle_destroy(&handle_loaded);
+}
+
+TYPED_TEST(QuantileSketchTest, ErrorExits) {
+    using T = TypeParam;
+    std::vector<T> x{1, 2, 3, 4, 5, 6};
+    std::vector<T> q{(T)0.5, (T)1.5};
+    std::vector<T> quants(4);
+
+    da_handle handle = nullptr, handle_other = nullptr, handle_wrong = nullptr;
+    EXPECT_EQ(da_quantile_sketch_update(handle, 3, 2, x.data(), 3),
+              da_status_handle_not_initialized);
+    ASSERT_EQ(da_handle_init<T>(&handle, da_handle_quantile_sketch), da_status_success);
+    ASSERT_EQ(da_handle_init<T>(&handle_other, da_handle_quantile_sketch),
+              da_status_success);
+    ASSERT_EQ(da_handle_init<T>(&handle_wrong, da_handle_pca), da_status_success);
+
+    EXPECT_EQ(da_quantile_sketch_query(handle, 1, q.data(), quants.data()),
+              da_status_no_data);
+    EXPECT_EQ(da_quantile_sketch_update(handle_wrong, 3, 2, x.data(), 3),
+              da_status_invalid_handle_type);
+    EXPECT_EQ(da_quantile_sketch_update(handle, 3, 0, x.data(), 3),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(da_quantile_sketch_update(handle, 3, 2, x.data(), 1),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_quantile_sketch_update<T>(handle, 3, 2, nullptr, 3),
+              da_status_invalid_pointer);
+
+    EXPECT_EQ(da_quantile_sketch_update(handle, 3, 2, x.data(), 3), da_status_success);
+    EXPECT_EQ(da_quantile_sketch_query(handle, 2, q.data(), quants.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_quantile_sketch_query(handle, 0, q.data(), quants.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_quantile_sketch_query<T>(handle, 1, q.data(), nullptr),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_quantile_sketch_update(handle, 2, 3, x.data(), 2),
+              da_status_invalid_input);
+    EXPECT_EQ(da_options_set_int(handle, "sketch size", 100), da_status_success);
+    EXPECT_EQ(da_quantile_sketch_update(handle, 3, 2, x.data(), 3),
+              da_status_incompatible_options);
+
+    EXPECT_EQ(da_quantile_sketch_merge<T>(handle, handle_wrong),
+              da_status_invalid_handle_type);
+    EXPECT_EQ(da_quantile_sketch_update(handle_other, 2, 3, x.data(), 2),
+              da_status_success);
+    EXPECT_EQ(da_quantile_sketch_merge<T>(handle, handle_other), da_status_invalid_input);
+    da_handle_destroy(&handle_other);
+    ASSERT_EQ(da_handle_init<T>(&handle_other, da_handle_quantile_sketch),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(handle_other, "sketch size", 100), da_status_success);
+    EXPECT_EQ(da_quantile_sketch_update(handle_other, 3, 2, x.data(), 3),
+              da_status_success);
+    EXPECT_EQ(da_quantile_sketch_merge<T>(handle, handle_other),
+              da_status_incompatible_options);
+
+    da_int dim = 1;
+    std::vector<T> rinfo(5);
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, rinfo.data()),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, 5);
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_scores, &dim, rinfo.data()),
+              da_status_unknown_query);
+
+    da_handle_destroy(&handle);
+    da_handle_destroy(&handle_other);
+    da_handle_destroy(&handle_wrong);
+}
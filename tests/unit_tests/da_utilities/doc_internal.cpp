@@ -62,6 +62,10 @@ const static std::map<da_handle_type, std::string> htypes{
     {da_handle_approx_nn, "Approximate Nearest Neighbors"},
     {da_handle_interpolation, "Interpolation"},
     {da_handle_kernel_pca, "Kernel Principal Component Analysis"},
+    {da_handle_moments, "Streaming Moment Accumulators"},
+    {da_handle_quantile_sketch, "Streaming Quantile Sketches"},
+    {da_handle_umap, "UMAP"},
+    {da_handle_kernel_approx, "Kernel Approximation"},
 };
 
 void options_print(da_handle_type htype) {
@@ -23,8 +23,12 @@
 
 #include "../utest_utils.hpp"
 #include "aoclda.h"
+#include "da_kernel_utils.hpp"
+#include "kmeans/kmeans_tuning_tables.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -225,6 +229,102 @@ TEST(UtilitiesTest, ContextHiddenSettings) {
     EXPECT_EQ(da_debug_get("NonExisting!", 100, charans), da_status_option_not_found);
 }
 
+// Tuning profiles replace rows of the kernel tuning tables for the running arch
+TEST(UtilitiesTest, TuningProfile) {
+    char arch[64]{""};
+    char ns[64]{""};
+    da_int len{64};
+    EXPECT_EQ(0, da_test::da_setenv("AOCL_DA_ARCH", "", 1));
+    ASSERT_EQ(da_status_success, da_get_arch_info(&len, arch, ns));
+    std::string other_arch = (std::string(arch) == "zen2") ? "zen3" : "zen2";
+
+    const std::string filename{"tuning_profile_test.txt"};
+    auto write_profile = [&](const std::string &contents) {
+        std::ofstream file(filename);
+        file << contents;
+    };
+    const char *no_override{nullptr};
+    auto lloyd = [&](da_int n_clusters) {
+        return Oracle<KernelSelection>(da_kmeans::lloyd_tuning, tid<double>(), n_clusters,
+                                       no_override, "kmeans.lloyd");
+    };
+    const vectorization_type table_isa = Oracle<KernelSelection>(
+        da_kmeans::lloyd_tuning, tid<double>(), da_int(8), no_override);
+
+    write_profile("# test profile\narch "s + arch +
+                  "\nkmeans.lloyd double 4:scalar avx  # trailing comment\n");
+    EXPECT_EQ(da_tuning_profile_load(filename.c_str()), da_status_success);
+    EXPECT_EQ(lloyd(2), vectorization_type::scalar);
+    EXPECT_EQ(lloyd(4), vectorization_type::scalar);
+    EXPECT_EQ(lloyd(8), vectorization_type::avx);
+    // Rows not in the profile still come from the compiled table
+    EXPECT_EQ((Oracle<KernelSelection>(da_kmeans::lloyd_tuning, tid<float>(), da_int(8),
+                                       no_override, "kmeans.lloyd")),
+              (Oracle<KernelSelection>(da_kmeans::lloyd_tuning, tid<float>(), da_int(8),
+                                       no_override)));
+    // Hidden settings override still takes precedence
+    EXPECT_EQ(da_debug_set("kmeans.isa", "scalar"), da_status_success);
+    EXPECT_EQ((Oracle<KernelSelection>(da_kmeans::lloyd_tuning, tid<double>(), da_int(8),
+                                       "kmeans.isa", "kmeans.lloyd")),
+              vectorization_type::scalar);
+    EXPECT_EQ(da_debug_set("kmeans.isa", ""), da_status_success);
+
+    // Invalid profiles are rejected and leave the active profile untouched
+    std::vector<std::string> invalid{
+        "kmeans.lloyd double avx\n",
+        "arch not_an_arch\nkmeans.lloyd double avx\n",
+        "arch "s + arch + "\nkmeans.lloyd quad avx\n",
+        "arch "s + arch + "\nkmeans.lloyd double 4:avx\n",
+        "arch "s + arch + "\nkmeans.lloyd double 8:avx 4:scalar avx2\n",
+        "arch "s + arch + "\nkmeans.lloyd double avx 4:scalar\n",
+        "arch "s + arch + "\nkmeans.lloyd double 0:avx avx2\n",
+        "arch "s + arch + "\nkmeans.lloyd double 2:avx 4:avx 8:avx 16:avx avx\n",
+        "arch "s + arch + "\nkmeans.lloyd double 4:sse avx\n",
+        "arch "s + arch + "\narch "s + arch + "\n"};
+    for (auto &contents : invalid) {
+        write_profile(contents);
+        EXPECT_EQ(da_tuning_profile_load(filename.c_str()), da_status_invalid_file_data)
+            << contents;
+        EXPECT_EQ(lloyd(8), vectorization_type::avx);
+    }
+    EXPECT_EQ(da_tuning_profile_load("no_such_tuning_profile.txt"), da_status_io_error);
+    EXPECT_EQ(lloyd(8), vectorization_type::avx);
+
+    // Profiles measured on another arch are ignored
+    write_profile("arch "s + other_arch + "\nkmeans.lloyd double avx\n");
+    EXPECT_EQ(da_tuning_profile_load(filename.c_str()), da_status_success);
+    EXPECT_EQ(lloyd(8), table_isa);
+
+    // A profile that cannot be saved is discarded and the loaded one is kept
+    write_profile("arch "s + arch + "\nkmeans.lloyd double 4:scalar avx\n");
+    EXPECT_EQ(da_tuning_profile_load(filename.c_str()), da_status_success);
+    EXPECT_EQ(da_tuning_profile_generate("no_such_dir/tuning_profile_test.txt"),
+              da_status_io_error);
+    EXPECT_EQ(lloyd(2), vectorization_type::scalar);
+    EXPECT_EQ(lloyd(8), vectorization_type::avx);
+
+    // Discard the profile
+    EXPECT_EQ(da_tuning_profile_load(nullptr), da_status_success);
+    EXPECT_EQ(lloyd(8), table_isa);
+
+    // Measure a profile on this machine, it is active and can be reloaded
+    EXPECT_EQ(da_tuning_profile_generate(nullptr), da_status_invalid_pointer);
+    ASSERT_EQ(da_tuning_profile_generate(filename.c_str()), da_status_success);
+    std::ifstream file(filename);
+    std::string line, contents;
+    while (std::getline(file, line))
+        contents += line + "\n";
+    file.close();
+    EXPECT_THAT(contents, testing::HasSubstr("arch "s + arch + "\n"));
+    for (const char *key : {"kmeans.lloyd double", "kmeans.elkan_update float",
+                            "kmeans.elkan_reduce double", "kf float", "svm.wssi double",
+                            "svm.wssj float"})
+        EXPECT_THAT(contents, testing::HasSubstr(key));
+    EXPECT_EQ(da_tuning_profile_load(filename.c_str()), da_status_success);
+    EXPECT_EQ(da_tuning_profile_load(nullptr), da_status_success);
+    std::remove(filename.c_str());
+}
+
 TEST(UtilitiesTest, intInfo) {
     std::string int_lib = INT_LIB;
     std::string expected_int_str;
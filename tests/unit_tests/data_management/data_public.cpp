@@ -29,6 +29,9 @@
 #include "aoclda.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 #include <limits>
 #include <string>
@@ -936,3 +939,1061 @@ TEST(dataStore, loadExtractCStrMultiColBlocks) {
 
     da_datastore_destroy(&store);
 }
+
+static void pca_variance_from_store(da_datastore store, const char *key,
+                                    std::vector<double> &variance) {
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_pca), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", 2), da_status_success);
+    EXPECT_EQ(da_handle_set_data_from_datastore_d(handle, store, key), da_status_success);
+    EXPECT_EQ(da_pca_compute_d(handle), da_status_success);
+    da_int dim = 2;
+    variance.resize(dim);
+    EXPECT_EQ(da_handle_get_result_d(handle, da_pca_variance, &dim, variance.data()),
+              da_status_success);
+    da_handle_destroy(&handle);
+}
+
+static void pca_variance_from_array(da_int n_rows, da_int n_cols, double *A,
+                                    std::vector<double> &variance) {
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_pca), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", 2), da_status_success);
+    EXPECT_EQ(da_pca_set_data_d(handle, n_rows, n_cols, A, n_rows), da_status_success);
+    EXPECT_EQ(da_pca_compute_d(handle), da_status_success);
+    da_int dim = 2;
+    variance.resize(dim);
+    EXPECT_EQ(da_handle_get_result_d(handle, da_pca_variance, &dim, variance.data()),
+              da_status_success);
+    da_handle_destroy(&handle);
+}
+
+TEST(dataStore, setHandleDataFromSelection) {
+    da_datastore store = nullptr;
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+
+    // 8 x 3 column major block, not copied into the store
+    da_int m = 8, n = 3;
+    std::vector<double> A = {1.0, 2.5, 0.3, 4.1, 5.2, 1.7, 7.3, 2.2,
+                             0.4, 1.9, 3.3, 2.8, 6.1, 0.7, 4.4, 5.5,
+                             3.2, 0.1, 2.6, 1.5, 4.9, 3.8, 0.6, 2.9};
+    EXPECT_EQ(da_data_load_col_real_d(store, m, n, A.data(), column_major, 0),
+              da_status_success);
+
+    // Contiguous slice: the handle reads the datastore block in place
+    EXPECT_EQ(da_data_select_slice(store, "slice", 1, 6, 0, 2), da_status_success);
+    std::vector<double> ref(6 * 3), var, var_ref;
+    EXPECT_EQ(da_data_extract_selection_real_d(store, "slice", column_major, ref.data(),
+                                               6),
+              da_status_success);
+    pca_variance_from_store(store, "slice", var);
+    pca_variance_from_array(6, 3, ref.data(), var_ref);
+    EXPECT_ARR_NEAR(2, var, var_ref, 1.0e-10);
+
+    // Non-contiguous rows with a missing value: gathered, missing row skipped
+    EXPECT_EQ(da_data_set_element_real_d(store, 6, 1,
+                                         std::numeric_limits<double>::quiet_NaN()),
+              da_status_success);
+    EXPECT_EQ(da_data_select_rows(store, "gather", 0, 2), da_status_success);
+    EXPECT_EQ(da_data_select_rows(store, "gather", 5, 7), da_status_success);
+    std::vector<double> gathered;
+    for (da_int j = 0; j < n; j++)
+        for (da_int i : {0, 1, 2, 5, 7})
+            gathered.push_back(A[j * m + i]);
+    pca_variance_from_store(store, "gather", var);
+    pca_variance_from_array(5, 3, gathered.data(), var_ref);
+    EXPECT_ARR_NEAR(2, var, var_ref, 1.0e-10);
+
+    // Error exits
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_pca), da_status_success);
+    EXPECT_EQ(da_handle_set_data_from_datastore_d(handle, nullptr, "slice"),
+              da_status_store_not_initialized);
+    EXPECT_EQ(da_handle_set_data_from_datastore_d(nullptr, store, "slice"),
+              da_status_handle_not_initialized);
+    EXPECT_EQ(da_handle_set_data_from_datastore_d(handle, store, "no such key"),
+              da_status_invalid_input);
+    EXPECT_EQ(da_handle_set_data_from_datastore_s(handle, store, "slice"),
+              da_status_wrong_type);
+    da_handle_destroy(&handle);
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_linmod), da_status_success);
+    EXPECT_EQ(da_handle_set_data_from_datastore_d(handle, store, "slice"),
+              da_status_invalid_handle_type);
+    da_handle_destroy(&handle);
+
+    // Selections containing non floating point columns are rejected
+    std::vector<da_int> I(8, 1);
+    EXPECT_EQ(da_data_load_col_int(store, m, 1, I.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "mixed", 2, 3), da_status_success);
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_pca), da_status_success);
+    EXPECT_EQ(da_handle_set_data_from_datastore_d(handle, store, "mixed"),
+              da_status_invalid_input);
+    da_handle_destroy(&handle);
+
+    da_datastore_destroy(&store);
+}
+
+static void linmod_coef(da_handle handle, std::vector<double> &coef) {
+    EXPECT_EQ(da_linmod_fit_d(handle), da_status_success);
+    da_int nc = 3;
+    coef.resize(nc);
+    EXPECT_EQ(da_handle_get_result_d(handle, da_linmod_coef, &nc, coef.data()),
+              da_status_success);
+}
+
+TEST(dataStore, setSupervisedHandleDataFromSelection) {
+    da_datastore store = nullptr;
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+
+    // Two features, a real response and integer class labels
+    da_int m = 8;
+    std::vector<double> X = {1.0, 2.5, 0.3, 4.1, 5.2, 1.7, 7.3, 2.2,
+                             0.4, 1.9, 3.3, 2.8, 6.1, 0.7, 4.4, 5.5};
+    std::vector<double> y = {1.2, 3.1, -1.4, 4.0, 3.3, 3.0, 7.1, -0.2};
+    std::vector<da_int> labels = {0, 1, 0, 1, 0, 1, 1, 0};
+    EXPECT_EQ(da_data_load_col_real_d(store, m, 2, X.data(), column_major, 0),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_int(store, m, 1, labels.data(), column_major, 0),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_real_d(store, m, 1, y.data(), column_major, 0),
+              da_status_success);
+    // A missing response removes row 4, rows 0 to 6 are selected
+    EXPECT_EQ(da_data_set_element_real_d(store, 4, 3,
+                                         std::numeric_limits<double>::quiet_NaN()),
+              da_status_success);
+    EXPECT_EQ(da_data_select_slice(store, "train", 0, 6, 0, 1), da_status_success);
+    std::vector<double> X_ref, y_ref;
+    for (da_int j = 0; j < 2; j++)
+        for (da_int i : {0, 1, 2, 3, 5, 6})
+            X_ref.push_back(X[j * m + i]);
+    for (da_int i : {0, 1, 2, 3, 5, 6})
+        y_ref.push_back(y[i]);
+
+    // Linear model with the real response
+    da_handle handle = nullptr, handle_ref = nullptr;
+    std::vector<double> coef, coef_ref;
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_linmod), da_status_success);
+    EXPECT_EQ(da_linmod_select_model_d(handle, linmod_model_mse), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "intercept", 1), da_status_success);
+    EXPECT_EQ(da_handle_set_supervised_data_from_datastore_d(handle, store, "train", 3),
+              da_status_success);
+    linmod_coef(handle, coef);
+    EXPECT_EQ(da_handle_init_d(&handle_ref, da_handle_linmod), da_status_success);
+    EXPECT_EQ(da_linmod_select_model_d(handle_ref, linmod_model_mse), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle_ref, "intercept", 1), da_status_success);
+    EXPECT_EQ(
+        da_linmod_define_features_d(handle_ref, 6, 2, X_ref.data(), 6, y_ref.data()),
+        da_status_success);
+    linmod_coef(handle_ref, coef_ref);
+    EXPECT_ARR_NEAR(3, coef, coef_ref, 1.0e-10);
+    // Data given by the user replaces the copy of the store
+    EXPECT_EQ(da_linmod_define_features_d(handle, 6, 2, X_ref.data(), 6, y_ref.data()),
+              da_status_success);
+    linmod_coef(handle, coef);
+    EXPECT_ARR_NEAR(3, coef, coef_ref, 1.0e-10);
+    da_handle_destroy(&handle);
+    da_handle_destroy(&handle_ref);
+
+    // Decision tree with the integer labels, the missing response does not matter
+    std::vector<da_int> pred(m), pred_ref(m);
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_decision_tree), da_status_success);
+    EXPECT_EQ(da_handle_set_supervised_data_from_datastore_d(handle, store, "train", 2),
+              da_status_success);
+    EXPECT_EQ(da_tree_fit_d(handle), da_status_success);
+    EXPECT_EQ(da_tree_predict_d(handle, m, 2, X.data(), m, pred.data()),
+              da_status_success);
+    EXPECT_EQ(da_handle_init_d(&handle_ref, da_handle_decision_tree), da_status_success);
+    EXPECT_EQ(da_tree_set_training_data_d(handle_ref, 7, 2, 0, X.data(), m, labels.data(),
+                                          nullptr),
+              da_status_success);
+    EXPECT_EQ(da_tree_fit_d(handle_ref), da_status_success);
+    EXPECT_EQ(da_tree_predict_d(handle_ref, m, 2, X.data(), m, pred_ref.data()),
+              da_status_success);
+    EXPECT_ARR_EQ(m, pred, pred_ref, 1, 1, 0, 0);
+    // Trees need integer labels
+    EXPECT_EQ(da_handle_set_supervised_data_from_datastore_d(handle, store, "train", 3),
+              da_status_invalid_input);
+    da_handle_destroy(&handle);
+    da_handle_destroy(&handle_ref);
+
+    // Nearest neighbors regression, the handle owns the gathered copy of the features
+    // even when a later call is rejected
+    std::vector<double> y_pred(m), y_pred_ref(m);
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_nn), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "number of neighbors", 2), da_status_success);
+    EXPECT_EQ(da_handle_set_supervised_data_from_datastore_d(handle, store, "train", 3),
+              da_status_success);
+    EXPECT_EQ(da_handle_set_supervised_data_from_datastore_d(handle, store, "train", 1),
+              da_status_invalid_input);
+    EXPECT_EQ(da_nn_regressor_predict_d(handle, m, 2, X.data(), m, y_pred.data(),
+                                        knn_search_mode),
+              da_status_success);
+    EXPECT_EQ(da_handle_init_d(&handle_ref, da_handle_nn), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle_ref, "number of neighbors", 2),
+              da_status_success);
+    EXPECT_EQ(da_nn_set_data_d(handle_ref, 6, 2, X_ref.data(), 6), da_status_success);
+    EXPECT_EQ(da_nn_set_targets_d(handle_ref, 6, y_ref.data()), da_status_success);
+    EXPECT_EQ(da_nn_regressor_predict_d(handle_ref, m, 2, X.data(), m, y_pred_ref.data(),
+                                        knn_search_mode),
+              da_status_success);
+    EXPECT_ARR_NEAR(m, y_pred, y_pred_ref, 1.0e-10);
+    da_handle_destroy(&handle);
+    da_handle_destroy(&handle_ref);
+
+    // Error exits
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_svm), da_status_success);
+    EXPECT_EQ(da_handle_set_data_from_datastore_d(handle, store, "train"),
+              da_status_invalid_handle_type);
+    EXPECT_EQ(da_handle_set_supervised_data_from_datastore_d(handle, store, "train", -1),
+              da_status_invalid_input);
+    EXPECT_EQ(da_handle_set_supervised_data_from_datastore_d(handle, store, "train", 1),
+              da_status_invalid_input);
+    EXPECT_EQ(da_handle_set_supervised_data_from_datastore_d(handle, store, "train", 4),
+              da_status_invalid_input);
+    da_handle_destroy(&handle);
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_pca), da_status_success);
+    EXPECT_EQ(da_handle_set_supervised_data_from_datastore_d(handle, store, "train", 3),
+              da_status_invalid_handle_type);
+    da_handle_destroy(&handle);
+
+    da_datastore_destroy(&store);
+}
+
+static da_int arrow_release_count = 0;
+static void arrow_test_release(ArrowArray *array) {
+    arrow_release_count++;
+    array->release = nullptr;
+}
+static void arrow_test_child_release(ArrowArray *array) { array->release = nullptr; }
+
+TEST(dataStore, arrowImportExport) {
+    da_datastore store = nullptr;
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+    arrow_release_count = 0;
+
+    // Record batch with 4 rows: float64 (offset 1), float32 with a null,
+    // int64, utf8 with a null and dictionary-encoded utf8
+    std::vector<double> dcol = {-1.0, 1.0, 2.0, 3.0, 4.0};
+    std::vector<float> fcol = {1.5f, 2.5f, 3.5f, 4.5f};
+    std::vector<int64_t> lcol = {10, 20, 30, 40};
+    std::vector<int32_t> soff = {0, 1, 3, 3, 7}, idx = {1, 0, 1, 2}, doff = {0, 1, 2, 3};
+    uint8_t fvalid = 0xD, svalid = 0xB;
+    const char *schars = "abbdddd", *dchars = "xyz";
+    const void *dbuf[2] = {nullptr, dcol.data()}, *fbuf[2] = {&fvalid, fcol.data()},
+               *lbuf[2] = {nullptr, lcol.data()},
+               *sbuf[3] = {&svalid, soff.data(), schars},
+               *ibuf[2] = {nullptr, idx.data()},
+               *dictbuf[3] = {nullptr, doff.data(), dchars};
+    ArrowArray dict = {3, 0, 0, 3, 0, dictbuf, nullptr, nullptr, arrow_test_child_release,
+                       nullptr};
+    ArrowArray children[5] = {
+        {4, 0, 1, 2, 0, dbuf, nullptr, nullptr, arrow_test_child_release, nullptr},
+        {4, 1, 0, 2, 0, fbuf, nullptr, nullptr, arrow_test_child_release, nullptr},
+        {4, 0, 0, 2, 0, lbuf, nullptr, nullptr, arrow_test_child_release, nullptr},
+        {4, 1, 0, 3, 0, sbuf, nullptr, nullptr, arrow_test_child_release, nullptr},
+        {4, 0, 0, 2, 0, ibuf, nullptr, &dict, arrow_test_child_release, nullptr}};
+    ArrowArray *children_ptr[5] = {&children[0], &children[1], &children[2], &children[3],
+                                   &children[4]};
+    const void *batch_buf[1] = {nullptr};
+    ArrowArray batch = {4,       0,       0, 1, 5, batch_buf, children_ptr,
+                        nullptr, arrow_test_release, nullptr};
+
+    ArrowSchema dict_schema = {"u",     "",      nullptr, 0,      0,
+                               nullptr, nullptr, nullptr, nullptr};
+    ArrowSchema col_schemas[5] = {
+        {"g", "d", nullptr, 0, 0, nullptr, nullptr, nullptr, nullptr},
+        {"f", "f", nullptr, 2, 0, nullptr, nullptr, nullptr, nullptr},
+        {"l", "l", nullptr, 0, 0, nullptr, nullptr, nullptr, nullptr},
+        {"u", "s", nullptr, 2, 0, nullptr, nullptr, nullptr, nullptr},
+        {"i", "cat", nullptr, 0, 0, nullptr, &dict_schema, nullptr, nullptr}};
+    ArrowSchema *col_schemas_ptr[5] = {&col_schemas[0], &col_schemas[1], &col_schemas[2],
+                                       &col_schemas[3], &col_schemas[4]};
+    ArrowSchema batch_schema = {"+s", "", nullptr, 0, 5, col_schemas_ptr,
+                                nullptr,  nullptr, nullptr};
+
+    EXPECT_EQ(da_data_load_arrow(store, &batch_schema, &batch), da_status_success);
+    // The float64 column is used in place: the store keeps the array alive
+    EXPECT_EQ(batch.release, nullptr);
+    EXPECT_EQ(arrow_release_count, 0);
+
+    da_int n_rows = 4, n_cols;
+    EXPECT_EQ(da_data_get_n_cols(store, &n_cols), da_status_success);
+    EXPECT_EQ(n_cols, 5);
+    std::vector<double> dext(4);
+    EXPECT_EQ(da_data_extract_column_real_d(store, 0, n_rows, dext.data()),
+              da_status_success);
+    std::vector<double> dexp = {1.0, 2.0, 3.0, 4.0};
+    EXPECT_ARR_EQ(4, dext, dexp, 1, 1, 0, 0);
+    std::vector<float> fext(4);
+    EXPECT_EQ(da_data_extract_column_real_s(store, 1, n_rows, fext.data()),
+              da_status_success);
+    EXPECT_EQ(fext[0], 1.5f);
+    EXPECT_TRUE(std::isnan(fext[1]));
+    EXPECT_EQ(fext[3], 4.5f);
+    std::vector<da_int> lext(4), lexp = {10, 20, 30, 40};
+    EXPECT_EQ(da_data_extract_column_int(store, 2, n_rows, lext.data()),
+              da_status_success);
+    EXPECT_ARR_EQ(4, lext, lexp, 1, 1, 0, 0);
+    char *sext[4];
+    EXPECT_EQ(da_data_extract_column_str(store, 3, n_rows, sext), da_status_success);
+    EXPECT_STREQ(sext[0], "a");
+    EXPECT_STREQ(sext[1], "bb");
+    EXPECT_STREQ(sext[2], "");
+    EXPECT_STREQ(sext[3], "dddd");
+    // The dictionary-encoded column is categorical: its codes are the Arrow indices
+    std::vector<da_int> cext(4), cexp = {1, 0, 1, 2};
+    EXPECT_EQ(da_data_extract_column_int(store, 4, n_rows, cext.data()),
+              da_status_success);
+    EXPECT_EQ(cext, cexp);
+    da_int n_cat;
+    EXPECT_EQ(da_data_get_n_categories(store, 4, &n_cat), da_status_success);
+    EXPECT_EQ(n_cat, 3);
+    char label[4];
+    da_int label_sz = 4;
+    EXPECT_EQ(da_data_get_category_label(store, 4, 2, &label_sz, label),
+              da_status_success);
+    EXPECT_STREQ(label, "z");
+    da_int col_idx;
+    EXPECT_EQ(da_data_get_col_idx(store, "cat", &col_idx), da_status_success);
+    EXPECT_EQ(col_idx, 4);
+
+    // Export the numerical columns of rows 1 to 3: contiguous, no copy
+    EXPECT_EQ(da_data_select_slice(store, "sel", 1, 3, 0, 2), da_status_success);
+    ArrowSchema out_schema;
+    ArrowArray out;
+    EXPECT_EQ(da_data_export_arrow(store, "sel", &out_schema, &out), da_status_success);
+    EXPECT_STREQ(out_schema.format, "+s");
+    ASSERT_EQ(out.n_children, 3);
+    EXPECT_EQ(out.length, 3);
+    EXPECT_STREQ(out_schema.children[0]->format, "g");
+    EXPECT_STREQ(out_schema.children[0]->name, "d");
+    EXPECT_EQ(out.children[0]->buffers[1], (const void *)&dcol[2]);
+    EXPECT_EQ(out.children[1]->null_count, 1);
+    const uint8_t *validity = static_cast<const uint8_t *>(out.children[1]->buffers[0]);
+    EXPECT_EQ(validity[0] & 0x7, 0x6);
+    EXPECT_STREQ(out_schema.children[2]->format, sizeof(da_int) == 8 ? "l" : "i");
+    const da_int *lout = static_cast<const da_int *>(out.children[2]->buffers[1]);
+    EXPECT_EQ(lout[0], 20);
+    EXPECT_EQ(lout[2], 40);
+    out.release(&out);
+    out_schema.release(&out_schema);
+    EXPECT_EQ(out.release, nullptr);
+
+    // Export non-contiguous rows of the whole store: gathered, strings as utf8
+    EXPECT_EQ(da_data_select_rows(store, "gather", 0, 0), da_status_success);
+    EXPECT_EQ(da_data_select_rows(store, "gather", 2, 3), da_status_success);
+    EXPECT_EQ(da_data_export_arrow(store, "gather", &out_schema, &out),
+              da_status_success);
+    ASSERT_EQ(out.n_children, 5);
+    const double *dout = static_cast<const double *>(out.children[0]->buffers[1]);
+    EXPECT_EQ(dout[0], 1.0);
+    EXPECT_EQ(dout[1], 3.0);
+    EXPECT_EQ(dout[2], 4.0);
+    EXPECT_STREQ(out_schema.children[3]->format, "u");
+    const int32_t *offsets = static_cast<const int32_t *>(out.children[3]->buffers[1]);
+    const char *chars = static_cast<const char *>(out.children[3]->buffers[2]);
+    EXPECT_EQ(std::string(chars + offsets[2], offsets[3] - offsets[2]), "dddd");
+    EXPECT_EQ(std::string(chars + offsets[0], offsets[1] - offsets[0]), "a");
+    out.release(&out);
+    out_schema.release(&out_schema);
+
+    // Round trip of the categorical column: exported dictionary-encoded and imported
+    // back as a categorical column
+    EXPECT_EQ(da_data_select_columns(store, "catsel", 4, 4), da_status_success);
+    EXPECT_EQ(da_data_export_arrow(store, "catsel", &out_schema, &out),
+              da_status_success);
+    ASSERT_EQ(out.n_children, 1);
+    EXPECT_NE(out_schema.children[0]->dictionary, nullptr);
+    da_datastore store2 = nullptr;
+    EXPECT_EQ(da_datastore_init(&store2), da_status_success);
+    EXPECT_EQ(da_data_load_arrow(store2, &out_schema, &out), da_status_success);
+    EXPECT_EQ(da_data_get_n_categories(store2, 0, &n_cat), da_status_success);
+    EXPECT_EQ(n_cat, 3);
+    EXPECT_EQ(da_data_extract_column_int(store2, 0, n_rows, cext.data()),
+              da_status_success);
+    EXPECT_EQ(cext, cexp);
+    EXPECT_EQ(da_data_extract_column_str(store2, 0, n_rows, sext),
+              da_status_invalid_input);
+    da_datastore_destroy(&store2);
+    if (out.release != nullptr)
+        out.release(&out);
+    if (out_schema.release != nullptr)
+        out_schema.release(&out_schema);
+
+    // Error exits
+    EXPECT_EQ(da_data_export_arrow(store, "no such key", &out_schema, &out),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_export_arrow(nullptr, nullptr, &out_schema, &out),
+              da_status_store_not_initialized);
+    EXPECT_EQ(da_data_load_arrow(nullptr, &batch_schema, &batch),
+              da_status_store_not_initialized);
+    EXPECT_EQ(da_data_load_arrow(store, &batch_schema, &batch), da_status_invalid_input);
+    std::vector<int16_t> scol = {1, 2, 3};
+    const void *s16buf[2] = {nullptr, scol.data()};
+    ArrowArray s16 = {3,       0,       0, 2, 0, s16buf, nullptr,
+                      nullptr, arrow_test_release, nullptr};
+    ArrowSchema s16_schema = {"s", "", nullptr, 0, 0, nullptr, nullptr, nullptr, nullptr};
+    EXPECT_EQ(da_data_load_arrow(store, &s16_schema, &s16), da_status_invalid_input);
+    EXPECT_NE(s16.release, nullptr);
+    ArrowSchema date_schema = {"tdD",   "",      nullptr, 0,      0,
+                               nullptr, nullptr, nullptr, nullptr};
+    s16.length = 4;
+    scol.push_back(4);
+    s16buf[1] = scol.data();
+    EXPECT_EQ(da_data_load_arrow(store, &date_schema, &s16), da_status_invalid_input);
+
+    // Converted columns do not keep the array alive
+    EXPECT_EQ(da_data_load_arrow(store, &s16_schema, &s16), da_status_success);
+    EXPECT_EQ(arrow_release_count, 1);
+    EXPECT_EQ(da_data_extract_column_int(store, 5, n_rows, lext.data()),
+              da_status_success);
+    EXPECT_EQ(lext[3], 4);
+
+    da_datastore_destroy(&store);
+    EXPECT_EQ(arrow_release_count, 2);
+}
+
+TEST(dataStore, categoricalColumns) {
+    da_datastore store = nullptr;
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+
+    // 5 rows: one categorical column, then a real column and a second categorical
+    // column with a missing entry
+    const char *colors[5] = {"red", "blue", "red", "green", "blue"};
+    std::vector<double> x = {0.5, 1.5, 2.5, 3.5, 4.5};
+    const char *sizes[5] = {"S", "L", nullptr, "S", "S"};
+    da_int n_rows = 5;
+    EXPECT_EQ(da_data_load_col_categorical(store, n_rows, 1, colors, column_major),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_real_d(store, n_rows, 1, x.data(), column_major, 0),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_categorical(store, n_rows, 1, sizes, column_major),
+              da_status_success);
+
+    // Codes are numbered by first appearance and read as integer data
+    std::vector<da_int> codes(n_rows), exp_codes = {0, 1, 0, 2, 1};
+    EXPECT_EQ(da_data_extract_column_int(store, 0, n_rows, codes.data()),
+              da_status_success);
+    EXPECT_EQ(codes, exp_codes);
+    da_int n_cat;
+    EXPECT_EQ(da_data_get_n_categories(store, 0, &n_cat), da_status_success);
+    EXPECT_EQ(n_cat, 3);
+    EXPECT_EQ(da_data_get_n_categories(store, 2, &n_cat), da_status_success);
+    EXPECT_EQ(n_cat, 2);
+    char label[8];
+    da_int label_sz = 8;
+    EXPECT_EQ(da_data_get_category_label(store, 0, 2, &label_sz, label),
+              da_status_success);
+    EXPECT_STREQ(label, "green");
+    label_sz = 3;
+    EXPECT_EQ(da_data_get_category_label(store, 0, 2, &label_sz, label),
+              da_status_invalid_input);
+    EXPECT_EQ(label_sz, 6);
+    da_int code;
+    EXPECT_EQ(da_data_get_element_int(store, 2, 2, &code), da_status_success);
+    EXPECT_EQ(code, std::numeric_limits<da_int>::max());
+    EXPECT_EQ(da_data_set_element_int(store, 0, 0, 5), da_status_invalid_input);
+    EXPECT_EQ(da_data_set_element_int(store, 0, 0, 1), da_status_success);
+    EXPECT_EQ(da_data_set_element_int(store, 0, 0, 0), da_status_success);
+
+    // Filter on the codes and extract the rows of the real column
+    EXPECT_EQ(da_data_select_category(store, "blue", 0, "blue"), da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "blue", 1, 1), da_status_success);
+    std::vector<double> xsel(2), exp_xsel = {1.5, 4.5};
+    EXPECT_EQ(da_data_extract_selection_real_d(store, "blue", column_major, xsel.data(),
+                                               2),
+              da_status_success);
+    EXPECT_EQ(xsel, exp_xsel);
+    EXPECT_EQ(da_data_select_category(store, "none", 0, "purple"), da_status_success);
+    EXPECT_EQ(da_data_select_category(store, "S", 2, "S"), da_status_success);
+    EXPECT_EQ(da_data_select_category(store, "S", 0, "red"), da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "S", 1, 1), da_status_success);
+    EXPECT_EQ(da_data_extract_selection_real_d(store, "S", column_major, xsel.data(), 2),
+              da_status_success);
+    EXPECT_EQ(xsel[0], 0.5);
+
+    // Feature matrix for the decision trees
+    std::vector<double> X(3 * n_rows);
+    std::vector<da_int> cat_feat(3), exp_cat_feat = {3, 0, 2};
+    EXPECT_EQ(da_data_extract_categorical_features_real_d(
+                  store, nullptr, column_major, X.data(), n_rows, cat_feat.data()),
+              da_status_success);
+    EXPECT_EQ(cat_feat, exp_cat_feat);
+    EXPECT_EQ(X[3], 2.0);
+    EXPECT_EQ(X[n_rows + 3], 3.5);
+    EXPECT_EQ(X[2 * n_rows + 1], 1.0);
+    EXPECT_TRUE(std::isnan(X[2 * n_rows + 2]));
+    std::vector<float> Xs(3 * n_rows);
+    EXPECT_EQ(da_data_extract_categorical_features_real_s(
+                  store, nullptr, column_major, Xs.data(), n_rows, cat_feat.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_extract_categorical_features_real_d(
+                  store, nullptr, column_major, X.data(), 2, cat_feat.data()),
+              da_status_invalid_leading_dimension);
+
+    // One-hot encoding of the selected rows, in row-major order
+    std::vector<double> oh(2 * 3), exp_oh = {0, 1, 0, 0, 1, 0};
+    EXPECT_EQ(da_data_extract_one_hot_real_d(store, "blue", 0, row_major, oh.data(), 3),
+              da_status_success);
+    EXPECT_EQ(oh, exp_oh);
+    std::vector<float> ohs(n_rows * 2), exp_ohs = {1, 0, 0, 1, 1, 0, 1, 0, 0, 0};
+    EXPECT_EQ(da_data_extract_one_hot_real_s(store, nullptr, 2, column_major, ohs.data(),
+                                             n_rows),
+              da_status_success);
+    EXPECT_EQ(ohs, exp_ohs);
+
+    // Categorical columns are exported to Arrow as dictionary-encoded utf8
+    ArrowSchema schema;
+    ArrowArray array;
+    EXPECT_EQ(da_data_export_arrow(store, nullptr, &schema, &array), da_status_success);
+    ASSERT_EQ(array.n_children, 3);
+    ASSERT_NE(array.children[2]->dictionary, nullptr);
+    EXPECT_EQ(array.children[1]->dictionary, nullptr);
+    EXPECT_STREQ(schema.children[2]->dictionary->format, "u");
+    EXPECT_EQ(array.children[2]->dictionary->length, 2);
+    EXPECT_EQ(array.children[2]->null_count, 1);
+    const char *dict_chars =
+        static_cast<const char *>(array.children[0]->dictionary->buffers[2]);
+    EXPECT_EQ(std::string(dict_chars, 12), "redbluegreen");
+    schema.release(&schema);
+    array.release(&array);
+
+    // Error exits
+    EXPECT_EQ(da_data_get_n_categories(store, 1, &n_cat), da_status_invalid_input);
+    EXPECT_EQ(da_data_get_n_categories(store, 3, &n_cat), da_status_invalid_input);
+    EXPECT_EQ(da_data_extract_one_hot_real_d(store, nullptr, 1, row_major, oh.data(), 3),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_category(store, "blue", 1, "blue"), da_status_invalid_input);
+    EXPECT_EQ(da_data_load_col_categorical(store, 2, 1, colors, column_major),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_load_col_categorical(store, n_rows, 1, nullptr, column_major),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_get_n_categories(nullptr, 0, &n_cat),
+              da_status_store_not_initialized);
+    da_datastore_destroy(&store);
+
+    // String columns of a CSV file stored as categorical columns
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+    char filepath[256] = DATA_DIR;
+    strcat(filepath, "csv_data/csv_test_auto.csv");
+    EXPECT_EQ(da_datastore_options_set_int(store, "categorical strings", 1),
+              da_status_success);
+    EXPECT_EQ(da_datastore_options_set_int(store, "skip initial space", 1),
+              da_status_success);
+    EXPECT_EQ(da_datastore_options_set_int(store, "use header row", 1),
+              da_status_success);
+    EXPECT_EQ(da_data_load_from_csv(store, filepath), da_status_success);
+    da_int col_idx;
+    EXPECT_EQ(da_data_get_col_idx(store, "g", &col_idx), da_status_success);
+    EXPECT_EQ(da_data_get_n_categories(store, col_idx, &n_cat), da_status_success);
+    EXPECT_EQ(n_cat, 4);
+    label_sz = 8;
+    EXPECT_EQ(da_data_get_category_label(store, col_idx, 1, &label_sz, label),
+              da_status_success);
+    EXPECT_STREQ(label, "goodbye");
+    EXPECT_EQ(da_data_get_n_categories(store, 0, &n_cat), da_status_invalid_input);
+    da_datastore_destroy(&store);
+}
+
+TEST(dataStore, selectWhere) {
+    da_datastore store = nullptr;
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+
+    // Column 0: integers i % 100 over several chunks of rows, column 1: doubles i / 10
+    // with a missing value, columns 2-3: row-major block, column 4: categorical
+    da_int n_rows = 40000;
+    std::vector<da_int> icol(n_rows);
+    std::vector<double> dcol(n_rows), rm(2 * n_rows);
+    std::vector<const char *> ccol(n_rows);
+    const char *labels[3] = {"a", "b", "c"};
+    for (da_int i = 0; i < n_rows; i++) {
+        icol[i] = i % 100;
+        dcol[i] = (double)i / 10.0;
+        rm[2 * i] = (double)(i % 7);
+        rm[2 * i + 1] = -1.0;
+        ccol[i] = labels[i % 3];
+    }
+    dcol[5] = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_EQ(da_data_load_col_int(store, n_rows, 1, icol.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_real_d(store, n_rows, 1, dcol.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_real_d(store, n_rows, 2, rm.data(), row_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_categorical(store, n_rows, 1, ccol.data(), column_major),
+              da_status_success);
+
+    // AND of a range on column 0 and a comparison on column 1: 0 <= i%100 <= 4, i < 250
+    std::vector<da_int> range = {0, 4};
+    double bound = 25.0;
+    EXPECT_EQ(da_data_select_where_int(store, "sel", 0, da_pred_between, 2, range.data(),
+                                       da_select_and),
+              da_status_success);
+    EXPECT_EQ(da_data_select_where_real_d(store, "sel", 1, da_pred_less, 1, &bound,
+                                          da_select_and),
+              da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "sel", 1, 1), da_status_success);
+    std::vector<double> out(n_rows);
+    std::vector<double> exp_out = {0.0, 0.1, 0.2, 0.3, 0.4, 10.0, 10.1, 10.2, 10.3,
+                                   10.4, 20.0, 20.1, 20.2, 20.3, 20.4};
+    EXPECT_EQ(da_data_extract_selection_real_d(store, "sel", column_major, out.data(),
+                                               n_rows),
+              da_status_success);
+    out.resize(exp_out.size());
+    EXPECT_EQ(out, exp_out);
+
+    // OR on a strided column and on the categorical codes, then NOT EQUAL in an AND:
+    // rows with i % 7 == 3 or i % 3 == 1, except those with i % 100 == 10
+    double three = 3.0;
+    da_int one = 1, ten = 10;
+    EXPECT_EQ(da_data_select_where_real_d(store, "or", 2, da_pred_equal, 1, &three,
+                                          da_select_or),
+              da_status_success);
+    EXPECT_EQ(da_data_select_where_int(store, "or", 4, da_pred_equal, 1, &one,
+                                       da_select_or),
+              da_status_success);
+    EXPECT_EQ(da_data_select_where_int(store, "or", 0, da_pred_not_equal, 1, &ten,
+                                       da_select_and),
+              da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "or", 0, 0), da_status_success);
+    da_int n_exp = 0;
+    for (da_int i = 0; i < n_rows; i++)
+        n_exp += ((i % 7 == 3) || (i % 3 == 1)) && (i % 100 != 10);
+    std::vector<da_int> iout(n_rows, -1);
+    EXPECT_EQ(da_data_extract_selection_int(store, "or", column_major, iout.data(),
+                                            n_rows),
+              da_status_success);
+    EXPECT_EQ(n_rows - std::count(iout.begin(), iout.end(), -1), n_exp);
+
+    // IN-sets, with more than 16 values, and string values on the categorical column
+    std::vector<da_int> in_set(20);
+    for (da_int k = 0; k < 20; k++)
+        in_set[k] = 99 - 2 * k;
+    EXPECT_EQ(da_data_select_where_int(store, "in", 0, da_pred_in, 20, in_set.data(),
+                                       da_select_and),
+              da_status_success);
+    const char *cat_in[2] = {"c", "z"};
+    EXPECT_EQ(da_data_select_where_str(store, "in", 4, da_pred_in, 2, cat_in,
+                                       da_select_and),
+              da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "in", 0, 0), da_status_success);
+    n_exp = 0;
+    for (da_int i = 0; i < n_rows; i++)
+        n_exp += (i % 100 >= 61) && (i % 2 == 1) && (i % 3 == 2);
+    std::fill(iout.begin(), iout.end(), -1);
+    EXPECT_EQ(da_data_extract_selection_int(store, "in", column_major, iout.data(),
+                                            n_rows),
+              da_status_success);
+    EXPECT_EQ(n_rows - std::count(iout.begin(), iout.end(), -1), n_exp);
+    EXPECT_EQ(iout[0], 65);
+    const char *cat_eq = "b";
+    EXPECT_EQ(da_data_select_where_str(store, "in", 4, da_pred_not_equal, 1, &cat_eq,
+                                       da_select_and),
+              da_status_success);
+    std::fill(iout.begin(), iout.end(), -1);
+    EXPECT_EQ(da_data_extract_selection_int(store, "in", column_major, iout.data(),
+                                            n_rows),
+              da_status_success);
+    EXPECT_EQ(n_rows - std::count(iout.begin(), iout.end(), -1), n_exp);
+
+    // Missing values never match, even for NOT EQUAL
+    EXPECT_EQ(da_data_select_where_real_d(store, "ne", 1, da_pred_not_equal, 1, &bound,
+                                          da_select_and),
+              da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "ne", 1, 1), da_status_success);
+    out.assign(n_rows, -1.0);
+    EXPECT_EQ(da_data_extract_selection_real_d(store, "ne", column_major, out.data(),
+                                               n_rows),
+              da_status_success);
+    EXPECT_EQ(std::count(out.begin(), out.end(), -1.0), 2);
+
+    // A predicate matching no rows leaves an empty selection instead of all the rows
+    da_int hundred = 100;
+    EXPECT_EQ(da_data_select_where_int(store, "none", 0, da_pred_equal, 1, &hundred,
+                                       da_select_and),
+              da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "none", 0, 0), da_status_success);
+    std::fill(iout.begin(), iout.end(), -1);
+    EXPECT_EQ(da_data_extract_selection_int(store, "none", column_major, iout.data(),
+                                            n_rows),
+              da_status_success);
+    EXPECT_EQ(std::count(iout.begin(), iout.end(), -1), n_rows);
+    EXPECT_EQ(da_data_select_where_int(store, "none", 0, da_pred_not_equal, 1, &hundred,
+                                       da_select_and),
+              da_status_success);
+    EXPECT_EQ(da_data_extract_selection_int(store, "none", column_major, iout.data(),
+                                            n_rows),
+              da_status_success);
+    EXPECT_EQ(std::count(iout.begin(), iout.end(), -1), n_rows);
+    const char *cat_none = "z";
+    EXPECT_EQ(da_data_select_category(store, "none_cat", 4, cat_none),
+              da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "none_cat", 0, 0), da_status_success);
+    EXPECT_EQ(da_data_extract_selection_int(store, "none_cat", column_major,
+                                            iout.data(), n_rows),
+              da_status_success);
+    EXPECT_EQ(std::count(iout.begin(), iout.end(), -1), n_rows);
+    // Rows can be added back with an OR
+    EXPECT_EQ(da_data_select_where_int(store, "none", 0, da_pred_equal, 1, &ten,
+                                       da_select_or),
+              da_status_success);
+    EXPECT_EQ(da_data_extract_selection_int(store, "none", column_major, iout.data(),
+                                            n_rows),
+              da_status_success);
+    EXPECT_EQ(n_rows - std::count(iout.begin(), iout.end(), -1), n_rows / 100);
+    EXPECT_EQ(iout[0], 10);
+
+    // Error exits
+    EXPECT_EQ(da_data_select_where_real_d(store, "err", 0, da_pred_equal, 1, &bound,
+                                          da_select_and),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_int(store, "err", 0, da_pred_between, 1, &one,
+                                       da_select_and),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_int(store, "err", 0, da_pred_in, 0, &one,
+                                       da_select_and),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_int(store, "err", 5, da_pred_equal, 1, &one,
+                                       da_select_and),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_int(store, "err", 0, (da_predicate)42, 1, &one,
+                                       da_select_and),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_int(store, "err", 0, da_pred_equal, 1, &one,
+                                       (da_selection_combine)3),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_int(store, "err", 0, da_pred_equal, 1, nullptr,
+                                       da_select_and),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_str(store, "err", 4, da_pred_less, 1, &cat_eq,
+                                       da_select_and),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_str(store, "err", 0, da_pred_equal, 1, &cat_eq,
+                                       da_select_and),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_int(nullptr, "err", 0, da_pred_equal, 1, &one,
+                                       da_select_and),
+              da_status_store_not_initialized);
+    da_datastore_destroy(&store);
+
+    // Uint8 and single precision columns split into several row blocks
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+    std::vector<uint8_t> flags = {1, 0, 1, 1};
+    std::vector<float> fvals = {1.0f, 2.0f, 3.0f, 4.0f};
+    EXPECT_EQ(da_data_load_col_uint8(store, 2, 1, flags.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_real_s(store, 2, 1, fvals.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_load_row_uint8(store, 2, 1, &flags[2], column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_load_row_real_s(store, 2, 1, &fvals[2], column_major, 1),
+              da_status_success);
+    uint8_t true_val = 1;
+    float fbound = 2.5f;
+    EXPECT_EQ(da_data_select_where_uint8(store, "flags", 0, da_pred_equal, 1, &true_val,
+                                         da_select_and),
+              da_status_success);
+    EXPECT_EQ(da_data_select_where_real_s(store, "flags", 1, da_pred_greater_equal, 1,
+                                          &fbound, da_select_and),
+              da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "flags", 1, 1), da_status_success);
+    std::vector<float> fout(2), exp_fout = {3.0f, 4.0f};
+    EXPECT_EQ(da_data_extract_selection_real_s(store, "flags", column_major, fout.data(),
+                                               2),
+              da_status_success);
+    EXPECT_EQ(fout, exp_fout);
+    da_datastore_destroy(&store);
+}
+
+TEST(dataStore, groupBy) {
+    da_datastore store = nullptr, result = nullptr;
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+    EXPECT_EQ(da_datastore_init(&result), da_status_success);
+
+    // Integer key with a missing value, categorical key and a double column with a NaN
+    da_int n_rows = 7, imiss = std::numeric_limits<da_int>::max();
+    std::vector<da_int> g = {1, 0, 1, 2, 0, 1, imiss};
+    const char *c[7] = {"x", "y", "x", "x", "y", "y", "x"};
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> v = {1.0, 2.0, nan, 4.0, 5.0, 6.0, 7.0};
+    EXPECT_EQ(da_data_load_col_int(store, n_rows, 1, g.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_categorical(store, n_rows, 1, c, column_major),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_real_d(store, n_rows, 1, v.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_label_column(store, "g", 0), da_status_success);
+    EXPECT_EQ(da_data_label_column(store, "v", 2), da_status_success);
+
+    // Group on the integer column
+    da_int by = 0;
+    std::vector<da_int> agg_cols = {2, 2, 2, 2, 2, 2, 2, 2};
+    std::vector<da_aggregation> aggs = {da_agg_count, da_agg_sum,    da_agg_mean,
+                                        da_agg_variance, da_agg_min, da_agg_max,
+                                        da_agg_median,   da_agg_quantile};
+    std::vector<double> q(8, 0.0);
+    q[7] = 1.0;
+    EXPECT_EQ(da_data_group_by_real_d(store, nullptr, 1, &by, 8, agg_cols.data(),
+                                      aggs.data(), q.data(), result),
+              da_status_success);
+    da_int n_groups, n_res_cols;
+    EXPECT_EQ(da_data_get_n_rows(result, &n_groups), da_status_success);
+    EXPECT_EQ(da_data_get_n_cols(result, &n_res_cols), da_status_success);
+    EXPECT_EQ(n_groups, 3);
+    EXPECT_EQ(n_res_cols, 9);
+    std::vector<da_int> ires(3), exp_keys = {0, 1, 2}, exp_counts = {2, 2, 1};
+    EXPECT_EQ(da_data_extract_column_int(result, 0, 3, ires.data()), da_status_success);
+    EXPECT_EQ(ires, exp_keys);
+    EXPECT_EQ(da_data_extract_column_int(result, 1, 3, ires.data()), da_status_success);
+    EXPECT_EQ(ires, exp_counts);
+    std::vector<std::vector<double>> exp_stats = {{7.0, 7.0, 4.0},  {3.5, 3.5, 4.0},
+                                                  {4.5, 12.5, 0.0}, {2.0, 1.0, 4.0},
+                                                  {5.0, 6.0, 4.0},  {3.5, 3.5, 4.0},
+                                                  {5.0, 6.0, 4.0}};
+    std::vector<double> dres(3);
+    for (da_int a = 0; a < 7; a++) {
+        EXPECT_EQ(da_data_extract_column_real_d(result, a + 2, 3, dres.data()),
+                  da_status_success);
+        for (da_int k = 0; k < 3; k++)
+            EXPECT_NEAR(dres[k], exp_stats[a][k], 1.0e-12);
+    }
+    da_int col_idx;
+    EXPECT_EQ(da_data_get_col_idx(result, "g", &col_idx), da_status_success);
+    EXPECT_EQ(col_idx, 0);
+    EXPECT_EQ(da_data_get_col_idx(result, "v_variance", &col_idx), da_status_success);
+    EXPECT_EQ(col_idx, 4);
+    EXPECT_EQ(da_data_get_col_idx(result, "v_q1", &col_idx), da_status_success);
+    EXPECT_EQ(col_idx, 8);
+    da_datastore_destroy(&result);
+
+    // Group on both keys over a selection of rows: the categorical key is kept
+    std::vector<da_int> by2 = {1, 0};
+    EXPECT_EQ(da_data_select_rows(store, "sel", 0, 5), da_status_success);
+    EXPECT_EQ(da_datastore_init(&result), da_status_success);
+    EXPECT_EQ(da_data_group_by_real_d(store, "sel", 2, by2.data(), 1, agg_cols.data(),
+                                      aggs.data(), nullptr, result),
+              da_status_success);
+    EXPECT_EQ(da_data_get_n_rows(result, &n_groups), da_status_success);
+    EXPECT_EQ(n_groups, 4);
+    std::vector<da_int> codes(4), exp_codes = {0, 0, 1, 1}, exp_g = {1, 2, 0, 1};
+    exp_counts = {1, 1, 2, 1};
+    EXPECT_EQ(da_data_extract_column_int(result, 0, 4, codes.data()), da_status_success);
+    EXPECT_EQ(codes, exp_codes);
+    EXPECT_EQ(da_data_extract_column_int(result, 1, 4, codes.data()), da_status_success);
+    EXPECT_EQ(codes, exp_g);
+    EXPECT_EQ(da_data_extract_column_int(result, 2, 4, codes.data()), da_status_success);
+    EXPECT_EQ(codes, exp_counts);
+    char label[8];
+    da_int label_sz = 8;
+    EXPECT_EQ(da_data_get_category_label(result, 0, 1, &label_sz, label),
+              da_status_success);
+    EXPECT_STREQ(label, "y");
+
+    // Error exits
+    da_int bad_col = 2;
+    EXPECT_EQ(da_data_group_by_real_d(store, nullptr, 1, &bad_col, 1, agg_cols.data(),
+                                      aggs.data(), nullptr, result),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_group_by_real_d(store, nullptr, 1, &by, 1, &by, aggs.data(),
+                                      nullptr, result),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_group_by_real_d(store, nullptr, 1, &by, 1, agg_cols.data(),
+                                      &aggs[7], nullptr, result),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_group_by_real_s(store, nullptr, 1, &by, 1, agg_cols.data(),
+                                      aggs.data(), nullptr, result),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_group_by_real_d(store, nullptr, 0, &by, 1, agg_cols.data(),
+                                      aggs.data(), nullptr, result),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_group_by_real_d(store, "none", 1, &by, 1, agg_cols.data(),
+                                      aggs.data(), nullptr, result),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_group_by_real_d(store, nullptr, 1, &by, 1, agg_cols.data(),
+                                      aggs.data(), nullptr, store),
+              da_status_invalid_input);
+    // The result already has 4 rows
+    EXPECT_EQ(da_data_group_by_real_d(store, nullptr, 1, &by, 1, agg_cols.data(),
+                                      aggs.data(), nullptr, result),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_group_by_real_d(nullptr, nullptr, 1, &by, 1, agg_cols.data(),
+                                      aggs.data(), nullptr, result),
+              da_status_store_not_initialized);
+    da_datastore_destroy(&result);
+    da_datastore_destroy(&store);
+
+    // Larger single precision problem, hashed by several threads when available
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+    EXPECT_EQ(da_datastore_init(&result), da_status_success);
+    n_rows = 50000;
+    std::vector<da_int> keys(n_rows);
+    std::vector<float> x(n_rows);
+    for (da_int i = 0; i < n_rows; i++) {
+        keys[i] = (i * 7) % 5;
+        x[i] = (float)(i % 5);
+    }
+    EXPECT_EQ(da_data_load_col_int(store, n_rows, 1, keys.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_real_s(store, n_rows, 1, x.data(), column_major, 1),
+              da_status_success);
+    da_int agg_col = 1;
+    da_aggregation mean_agg = da_agg_mean;
+    EXPECT_EQ(da_data_group_by_real_s(store, nullptr, 1, &by, 1, &agg_col, &mean_agg,
+                                      nullptr, result),
+              da_status_success);
+    EXPECT_EQ(da_data_get_n_rows(result, &n_groups), da_status_success);
+    EXPECT_EQ(n_groups, 5);
+    // Key k holds the rows i with 7i = k mod 5, i.e. i = 3k mod 5
+    std::vector<float> fres(5);
+    EXPECT_EQ(da_data_extract_column_real_s(result, 1, 5, fres.data()),
+              da_status_success);
+    for (da_int k = 0; k < 5; k++)
+        EXPECT_FLOAT_EQ(fres[k], (float)((3 * k) % 5));
+    da_datastore_destroy(&result);
+    da_datastore_destroy(&store);
+}
+
+TEST(dataStore, saveLoad) {
+    da_datastore store = nullptr, loaded = nullptr;
+    std::string filename = "datastore_save_load.dacf";
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+
+    // Two pages per column, the integer column is sorted and compresses well
+    da_int n_rows = 100000;
+    std::vector<double> x(n_rows);
+    std::vector<da_int> k(n_rows);
+    std::vector<float> y(n_rows);
+    for (da_int i = 0; i < n_rows; i++) {
+        x[i] = 0.5 * i;
+        k[i] = i / 1000;
+        y[i] = (float)(i % 7);
+    }
+    x[3] = std::numeric_limits<double>::quiet_NaN();
+    k[5] = std::numeric_limits<da_int>::max();
+    EXPECT_EQ(da_data_load_col_real_d(store, n_rows, 1, x.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_int(store, n_rows, 1, k.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_real_s(store, n_rows, 1, y.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_label_column(store, "x", 0), da_status_success);
+    EXPECT_EQ(da_data_label_column(store, "k", 1), da_status_success);
+
+    std::vector<double> xres(n_rows);
+    std::vector<da_int> kres(n_rows);
+    std::vector<float> yres(n_rows);
+    for (da_int compress = 0; compress <= 1; compress++) {
+        EXPECT_EQ(da_data_save(store, filename.c_str(), nullptr, compress),
+                  da_status_success);
+        EXPECT_EQ(da_datastore_init(&loaded), da_status_success);
+        EXPECT_EQ(da_data_load(loaded, filename.c_str(), 0, nullptr), da_status_success);
+        da_int dim;
+        EXPECT_EQ(da_data_get_n_rows(loaded, &dim), da_status_success);
+        EXPECT_EQ(dim, n_rows);
+        EXPECT_EQ(da_data_get_n_cols(loaded, &dim), da_status_success);
+        EXPECT_EQ(dim, 3);
+        EXPECT_EQ(da_data_extract_column_real_d(loaded, 0, n_rows, xres.data()),
+                  da_status_success);
+        EXPECT_EQ(da_data_extract_column_int(loaded, 1, n_rows, kres.data()),
+                  da_status_success);
+        EXPECT_EQ(da_data_extract_column_real_s(loaded, 2, n_rows, yres.data()),
+                  da_status_success);
+        EXPECT_TRUE(std::isnan(xres[3]));
+        xres[3] = x[3] = 0.0;
+        EXPECT_EQ(xres, x);
+        x[3] = std::numeric_limits<double>::quiet_NaN();
+        EXPECT_EQ(kres, k);
+        EXPECT_EQ(yres, y);
+        da_int idx;
+        EXPECT_EQ(da_data_get_col_idx(loaded, "k", &idx), da_status_success);
+        EXPECT_EQ(idx, 1);
+
+        // Columns used in place can be modified without changing the file
+        EXPECT_EQ(da_data_set_element_real_d(loaded, 0, 0, -1.0), da_status_success);
+        da_datastore_destroy(&loaded);
+    }
+
+    // Column projection, in the requested order
+    EXPECT_EQ(da_datastore_init(&loaded), da_status_success);
+    std::vector<da_int> cols = {2, 0};
+    EXPECT_EQ(da_data_load(loaded, filename.c_str(), 2, cols.data()), da_status_success);
+    da_int n_cols;
+    EXPECT_EQ(da_data_get_n_cols(loaded, &n_cols), da_status_success);
+    EXPECT_EQ(n_cols, 2);
+    EXPECT_EQ(da_data_extract_column_real_s(loaded, 0, n_rows, yres.data()),
+              da_status_success);
+    EXPECT_EQ(yres, y);
+    double elem;
+    EXPECT_EQ(da_data_get_element_real_d(loaded, 0, 1, &elem), da_status_success);
+    EXPECT_EQ(elem, 0.0);
+    da_int idx;
+    EXPECT_EQ(da_data_get_col_idx(loaded, "x", &idx), da_status_success);
+    EXPECT_EQ(idx, 1);
+
+    // Errors
+    cols[0] = 3;
+    EXPECT_EQ(da_data_load(loaded, filename.c_str(), 1, cols.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_load(loaded, filename.c_str(), 1, nullptr),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_load(loaded, "no_such_file.dacf", 0, nullptr), da_status_io_error);
+    EXPECT_EQ(da_data_save(store, filename.c_str(), nullptr, 2), da_status_invalid_input);
+    EXPECT_EQ(da_data_save(store, filename.c_str(), "none", 0), da_status_invalid_input);
+    EXPECT_EQ(da_data_save(nullptr, filename.c_str(), nullptr, 0),
+              da_status_store_not_initialized);
+    EXPECT_EQ(da_data_load(nullptr, filename.c_str(), 0, nullptr),
+              da_status_store_not_initialized);
+    da_datastore_destroy(&loaded);
+    da_datastore_destroy(&store);
+
+    // Selection of a small store with categorical, string and uint8 columns
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+    n_rows = 5;
+    const char *colors[5] = {"red", "blue", "red", "green", "blue"};
+    const char *names[5] = {"a", "bb", "", "dddd", "e"};
+    std::vector<uint8_t> flags = {1, 0, 0, 1, 1};
+    EXPECT_EQ(da_data_load_col_categorical(store, n_rows, 1, colors, column_major),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_str(store, n_rows, 1, names, column_major),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_uint8(store, n_rows, 1, flags.data(), column_major, 1),
+              da_status_success);
+    EXPECT_EQ(da_data_select_rows(store, "sel", 1, 3), da_status_success);
+    EXPECT_EQ(da_data_save(store, filename.c_str(), "sel", 1), da_status_success);
+
+    // The number of rows must match the store being loaded into
+    EXPECT_EQ(da_data_load(store, filename.c_str(), 0, nullptr), da_status_invalid_input);
+    EXPECT_EQ(da_datastore_init(&loaded), da_status_success);
+    EXPECT_EQ(da_data_load(loaded, filename.c_str(), 0, nullptr), da_status_success);
+    std::vector<da_int> codes(3), exp_codes = {1, 0, 2};
+    EXPECT_EQ(da_data_extract_column_int(loaded, 0, 3, codes.data()), da_status_success);
+    EXPECT_EQ(codes, exp_codes);
+    char label[8];
+    da_int label_sz = 8;
+    EXPECT_EQ(da_data_get_category_label(loaded, 0, 2, &label_sz, label),
+              da_status_success);
+    EXPECT_STREQ(label, "green");
+    std::vector<char *> strs(3);
+    EXPECT_EQ(da_data_extract_column_str(loaded, 1, 3, strs.data()), da_status_success);
+    EXPECT_STREQ(strs[0], "bb");
+    EXPECT_STREQ(strs[1], "");
+    EXPECT_STREQ(strs[2], "dddd");
+    std::vector<uint8_t> flags_res(3), exp_flags = {0, 0, 1};
+    EXPECT_EQ(da_data_extract_column_uint8(loaded, 2, 3, flags_res.data()),
+              da_status_success);
+    EXPECT_EQ(flags_res, exp_flags);
+    da_datastore_destroy(&loaded);
+    da_datastore_destroy(&store);
+
+    // Files that are not data store files
+    FILE *fp = fopen(filename.c_str(), "wb");
+    ASSERT_NE(fp, nullptr);
+    fputs("not a data store file, but long enough for the header", fp);
+    fclose(fp);
+    EXPECT_EQ(da_datastore_init(&loaded), da_status_success);
+    EXPECT_EQ(da_data_load(loaded, filename.c_str(), 0, nullptr),
+              da_status_invalid_file_data);
+    da_datastore_destroy(&loaded);
+    std::remove(filename.c_str());
+}
@@ -250,3 +250,26 @@ TEST(intervalSet, erase) {
     EXPECT_EQ(it->lower, 25);
     EXPECT_EQ(it->upper, 30);
 }
+
+TEST(intervalSet, append) {
+    interval_set iset;
+
+    // iset = [2, 4]; [6, 9]
+    EXPECT_EQ(iset.append({2, 4}), da_status_success);
+    EXPECT_EQ(iset.append({6, 7}), da_status_success);
+    EXPECT_EQ(iset.append({8, 9}), da_status_success);
+    auto it = iset.begin();
+    EXPECT_EQ(it->lower, 2);
+    EXPECT_EQ(it->upper, 4);
+    it++;
+    EXPECT_EQ(it->lower, 6);
+    EXPECT_EQ(it->upper, 9);
+    it++;
+    EXPECT_EQ(it, iset.end());
+
+    // Intervals before the end of the set or with wrong bounds are rejected
+    EXPECT_EQ(iset.append({9, 12}), da_status_invalid_input);
+    EXPECT_EQ(iset.append({0, 1}), da_status_invalid_input);
+    EXPECT_EQ(iset.append({15, 12}), da_status_invalid_input);
+    EXPECT_EQ(iset.find(5), iset.end());
+}
@@ -610,6 +610,65 @@ TEST_P(decision_forest_positive, Single) {
 INSTANTIATE_TEST_SUITE_P(decision_forest_pos_suite, decision_forest_positive,
                          testing::ValuesIn(forest_param_pos));
 
+TYPED_TEST(decision_forest_test, sample_weights) {
+    using T = TypeParam;
+    // The second half of the data set has flipped labels but zero weight: the bootstrap
+    // samples never contain it and the forest should fit the first half exactly
+    da_int n_half = 50, n_samples = 100, n_features = 2, n_class = 2;
+    std::vector<T> X(n_samples * n_features), weights(n_samples);
+    std::vector<da_int> y(n_samples);
+    for (da_int i = 0; i < n_samples; i++) {
+        da_int ih = i % n_half;
+        X[i] = (T)ih;
+        X[n_samples + i] = (T)((3 * ih) % 7);
+        y[i] = ih < n_half / 2 ? 0 : 1;
+        weights[i] = (T)0.5 + (T)(ih % 3);
+        if (i >= n_half) {
+            y[i] = 1 - y[i];
+            weights[i] = (T)0;
+        }
+    }
+
+    da_handle forest_handle = nullptr;
+    EXPECT_EQ(da_handle_init<T>(&forest_handle, da_handle_decision_forest),
+              da_status_success);
+    EXPECT_EQ(da_options_set(forest_handle, "seed", (da_int)13), da_status_success);
+    EXPECT_EQ(da_options_set(forest_handle, "number of trees", (da_int)20),
+              da_status_success);
+    EXPECT_EQ(da_forest_set_training_data(forest_handle, n_samples, n_features, n_class,
+                                          X.data(), n_samples, y.data()),
+              da_status_success);
+    EXPECT_EQ(da_forest_set_sample_weights(forest_handle, n_samples, weights.data()),
+              da_status_success);
+    EXPECT_EQ(da_forest_fit<T>(forest_handle), da_status_success);
+    T accuracy;
+    EXPECT_EQ(da_forest_score(forest_handle, n_half, n_features, X.data(), n_samples,
+                              y.data(), &accuracy),
+              da_status_success);
+    EXPECT_NEAR(accuracy, (T)1.0, (T)1.0e-5);
+
+    // Without bootstrap, the weights are frequencies and must be whole numbers
+    EXPECT_EQ(da_options_set(forest_handle, "bootstrap", "no"), da_status_success);
+    EXPECT_EQ(da_forest_fit<T>(forest_handle), da_status_invalid_input);
+    for (da_int i = 0; i < n_samples; i++)
+        weights[i] = std::round(weights[i]);
+    EXPECT_EQ(da_forest_fit<T>(forest_handle), da_status_success);
+    EXPECT_EQ(da_forest_score(forest_handle, n_half, n_features, X.data(), n_samples,
+                              y.data(), &accuracy),
+              da_status_success);
+    EXPECT_NEAR(accuracy, (T)1.0, (T)1.0e-5);
+
+    // Invalid weights
+    weights[3] = -(T)1.0;
+    EXPECT_EQ(da_forest_set_sample_weights(forest_handle, n_samples, weights.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_forest_set_sample_weights(forest_handle, n_half, weights.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_forest_set_sample_weights<T>(forest_handle, n_samples, nullptr),
+              da_status_invalid_pointer);
+    da_handle_destroy(&forest_handle);
+}
+
 TEST(decision_forest, row_major) {
 
     // Get the training data
@@ -513,6 +513,169 @@ TYPED_TEST(decision_tree_public_test, invalid_input) {
     da_handle_destroy(&tree_handle);
 }
 
+TYPED_TEST(decision_tree_public_test, sample_weights) {
+    using T = TypeParam;
+    // Integer sample weights must give the same tree as replicating the rows
+    da_int n_samples = 40, n_features = 3, n_class = 3;
+    std::vector<T> X(n_samples * n_features);
+    std::vector<da_int> y(n_samples);
+    std::vector<T> weights(n_samples);
+    for (da_int i = 0; i < n_samples; i++) {
+        for (da_int j = 0; j < n_features; j++)
+            X[j * n_samples + i] = (T)((7 * i + 3 * j * j + 1) % 11);
+        y[i] = (i * i + 2 * i) % n_class;
+        weights[i] = (T)(i % 4);
+    }
+    da_int n_rep = 0;
+    for (da_int i = 0; i < n_samples; i++)
+        n_rep += (da_int)weights[i];
+    std::vector<T> X_rep(n_rep * n_features);
+    std::vector<da_int> y_rep(n_rep);
+    da_int k = 0;
+    for (da_int i = 0; i < n_samples; i++) {
+        for (da_int r = 0; r < (da_int)weights[i]; r++, k++) {
+            for (da_int j = 0; j < n_features; j++)
+                X_rep[j * n_rep + k] = X[j * n_samples + i];
+            y_rep[k] = y[i];
+        }
+    }
+
+    for (std::string hist : {"no", "yes"}) {
+        std::vector<T> proba(n_samples * n_class), proba_rep(n_samples * n_class);
+        da_handle tree_handle = nullptr, tree_handle_rep = nullptr;
+        EXPECT_EQ(da_handle_init<T>(&tree_handle, da_handle_decision_tree),
+                  da_status_success);
+        EXPECT_EQ(da_handle_init<T>(&tree_handle_rep, da_handle_decision_tree),
+                  da_status_success);
+        for (da_handle h : {tree_handle, tree_handle_rep}) {
+            EXPECT_EQ(da_options_set(h, "histogram", hist.c_str()), da_status_success);
+            EXPECT_EQ(da_options_set(h, "node minimum samples", (da_int)1),
+                      da_status_success);
+            EXPECT_EQ(da_options_set(h, "seed", (da_int)42), da_status_success);
+        }
+        EXPECT_EQ(da_tree_set_training_data(tree_handle, n_samples, n_features, n_class,
+                                            X.data(), n_samples, y.data()),
+                  da_status_success);
+        EXPECT_EQ(da_tree_set_sample_weights(tree_handle, n_samples, weights.data()),
+                  da_status_success);
+        EXPECT_EQ(da_tree_fit<T>(tree_handle), da_status_success);
+        EXPECT_EQ(da_tree_set_training_data(tree_handle_rep, n_rep, n_features, n_class,
+                                            X_rep.data(), n_rep, y_rep.data()),
+                  da_status_success);
+        EXPECT_EQ(da_tree_fit<T>(tree_handle_rep), da_status_success);
+
+        EXPECT_EQ(da_tree_predict_proba(tree_handle, n_samples, n_features, X.data(),
+                                        n_samples, proba.data(), n_class, n_samples),
+                  da_status_success);
+        EXPECT_EQ(da_tree_predict_proba(tree_handle_rep, n_samples, n_features, X.data(),
+                                        n_samples, proba_rep.data(), n_class, n_samples),
+                  da_status_success);
+        EXPECT_ARR_NEAR(n_samples * n_class, proba, proba_rep, (T)1.0e-5);
+
+        // Removing the weights gives back the unweighted tree
+        EXPECT_EQ(da_tree_set_sample_weights<T>(tree_handle, 0, nullptr),
+                  da_status_success);
+        EXPECT_EQ(da_tree_fit<T>(tree_handle), da_status_success);
+        da_int rinfo_dim = 100;
+        std::vector<T> rinfo(rinfo_dim);
+        EXPECT_EQ(da_handle_get_result(tree_handle, da_result::da_rinfo, &rinfo_dim,
+                                       rinfo.data()),
+                  da_status_success);
+        EXPECT_NEAR(rinfo[2], (T)n_samples, (T)1.0e-10);
+
+        da_handle_destroy(&tree_handle);
+        da_handle_destroy(&tree_handle_rep);
+    }
+}
+
+TYPED_TEST(decision_tree_public_test, sample_weights_invalid) {
+    using T = TypeParam;
+    std::vector<T> X{0.0, 1.0, 0.0, 2.0};
+    std::vector<da_int> y{0, 1};
+    std::vector<T> weights{1.0, 2.0};
+    da_int n_samples = 2, n_features = 2;
+
+    da_handle tree_handle = nullptr;
+    EXPECT_EQ(da_handle_init<T>(&tree_handle, da_handle_decision_tree),
+              da_status_success);
+    EXPECT_EQ(da_tree_set_sample_weights(tree_handle, n_samples, weights.data()),
+              da_status_no_data);
+    EXPECT_EQ(da_tree_set_training_data(tree_handle, n_samples, n_features, 0, X.data(),
+                                        n_samples, y.data()),
+              da_status_success);
+    EXPECT_EQ(da_tree_set_sample_weights(tree_handle, 1, weights.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_tree_set_sample_weights<T>(tree_handle, n_samples, nullptr),
+              da_status_invalid_pointer);
+    weights[0] = -1.0;
+    EXPECT_EQ(da_tree_set_sample_weights(tree_handle, n_samples, weights.data()),
+              da_status_invalid_input);
+    weights[0] = 0.5;
+    EXPECT_EQ(da_tree_set_sample_weights(tree_handle, n_samples, weights.data()),
+              da_status_invalid_input);
+    weights[0] = 0.0;
+    weights[1] = 0.0;
+    EXPECT_EQ(da_tree_set_sample_weights(tree_handle, n_samples, weights.data()),
+              da_status_invalid_input);
+    da_handle_destroy(&tree_handle);
+}
+
+TYPED_TEST(decision_tree_public_test, concurrent_inference) {
+    // Several threads share one trained handle, each with its own inference context;
+    // the results must match the serial handle-based calls
+    da_int n = 60, p = 3;
+    std::vector<TypeParam> X(n * p);
+    std::vector<da_int> y(n);
+    for (da_int i = 0; i < n * p; i++)
+        X[i] = (TypeParam)(((i * 104729) % 389) / 97.0 - 2.0);
+    for (da_int i = 0; i < n; i++)
+        y[i] = X[i] + X[n + i] > 0 ? 1 : 0;
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_decision_tree),
+              da_status_success);
+    EXPECT_EQ(da_tree_set_training_data(handle, n, p, 0, X.data(), n, y.data()),
+              da_status_success);
+    ASSERT_EQ(da_tree_fit<TypeParam>(handle), da_status_success);
+
+    const da_int n_chunks = 16, chunk = 23, n_total = n_chunks * chunk;
+    std::vector<TypeParam> Y(n_total * p);
+    for (da_int i = 0; i < (da_int)Y.size(); i++)
+        Y[i] = (TypeParam)(((i * 7919) % 613) / 153.0 - 2.0);
+
+    std::vector<da_int> pred_ref(n_total);
+    for (da_int c = 0; c < n_chunks; c++)
+        EXPECT_EQ(da_tree_predict(handle, chunk, p, &Y[c * chunk], n_total,
+                                  &pred_ref[c * chunk]),
+                  da_status_success);
+
+    std::vector<da_int> pred(n_total, -1);
+    std::vector<da_status> status(n_chunks, da_status_internal_error);
+#pragma omp parallel for schedule(dynamic)
+    for (da_int c = 0; c < n_chunks; c++) {
+        da_inference_context ctx = nullptr;
+        if (da_inference_context_init(&ctx) != da_status_success)
+            continue;
+        status[c] = da_tree_predict(handle, ctx, chunk, p, &Y[c * chunk], n_total,
+                                    &pred[c * chunk]);
+        da_inference_context_destroy(&ctx);
+    }
+    for (da_int c = 0; c < n_chunks; c++)
+        EXPECT_EQ(status[c], da_status_success);
+    EXPECT_ARR_EQ(n_total, pred, pred_ref, 1, 1, 0, 0);
+
+    // Errors are reported in the context rather than in the handle
+    da_inference_context ctx = nullptr;
+    ASSERT_EQ(da_inference_context_init(&ctx), da_status_success);
+    EXPECT_EQ(da_tree_predict(handle, ctx, chunk, p + 1, Y.data(), n_total, pred.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_inference_context_print_error_message(ctx), da_status_success);
+    EXPECT_EQ(da_tree_predict(handle, (da_inference_context) nullptr, chunk, p, Y.data(),
+                              n_total, pred.data()),
+              da_status_invalid_pointer);
+    da_inference_context_destroy(&ctx);
+    da_handle_destroy(&handle);
+}
+
 TEST(decision_tree, incorrect_handle_precision) {
 
     da_handle handle_d = nullptr;
@@ -545,6 +708,15 @@ TEST(decision_tree, incorrect_handle_precision) {
     EXPECT_EQ(da_tree_predict_d(handle_s, n_samples, n_features, X_d.data(), n_samples,
                                 y.data()),
               da_status_wrong_type);
+    da_inference_context ctx = nullptr;
+    EXPECT_EQ(da_inference_context_init(&ctx), da_status_success);
+    EXPECT_EQ(da_tree_predict_ctx_s(handle_d, ctx, n_samples, n_features, X_s.data(),
+                                    n_samples, y.data()),
+              da_status_wrong_type);
+    EXPECT_EQ(da_tree_predict_ctx_d(handle_s, ctx, n_samples, n_features, X_d.data(),
+                                    n_samples, y.data()),
+              da_status_wrong_type);
+    da_inference_context_destroy(&ctx);
 
     EXPECT_EQ(da_tree_score_s(handle_d, n_samples, n_features, X_s.data(), n_samples,
                               y.data(), &accuracy_s),
@@ -713,6 +713,136 @@ TYPED_TEST(KernelPCATest, RandomizedSolver) {
     }
 }
 
+template <typename T>
+void fit_kernel_pca(const KernelPCAParamType<T> &param, const char *solver, da_int nc,
+                    std::vector<T> &evals, std::vector<T> &evecs,
+                    std::vector<T> &scores) {
+    da_int n = param.n;
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init<T>(&handle, da_handle_kernel_pca), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "storage order", param.order.c_str()),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "kernel", param.kernel.c_str()),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "eigensolver", solver), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", nc), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_landmarks", n), da_status_success);
+    EXPECT_EQ(da_options_set(handle, "gamma", param.gamma), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "degree", param.degree), da_status_success);
+    EXPECT_EQ(da_options_set(handle, "coef0", param.coef0), da_status_success);
+    EXPECT_EQ(da_kernel_pca_set_data(handle, n, param.p, param.A.data(), param.lda),
+              da_status_success);
+    EXPECT_EQ(da_kernel_pca_compute<T>(handle), da_status_success);
+
+    da_int size_evals = nc, size_evecs = n * nc;
+    evals.resize(size_evals);
+    evecs.resize(size_evecs);
+    scores.resize(size_evecs);
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_pca_eigenvalues, &size_evals,
+                                   evals.data()),
+              da_status_success);
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_pca_eigenvectors, &size_evecs,
+                                   evecs.data()),
+              da_status_success);
+    da_int ldt = (param.order == "column-major") ? n : nc;
+    EXPECT_EQ(da_kernel_pca_transform(handle, n, param.p, param.A.data(), param.lda,
+                                      scores.data(), ldt),
+              da_status_success);
+    da_handle_destroy(&handle);
+}
+
+template <typename T>
+void check_approximate_vs_syevd(const KernelPCAParamType<T> &param) {
+    // With every sample as a landmark the Nystroem approximation of the kernel is exact
+    std::cout << "ApproximateSolver test: " << param.test_name << std::endl;
+    da_int nc = 2;
+    std::vector<T> ref_evals, ref_evecs, ref_scores, evals, evecs, scores;
+    fit_kernel_pca(param, "syevd", nc, ref_evals, ref_evecs, ref_scores);
+    fit_kernel_pca(param, "approximate", nc, evals, evecs, scores);
+
+    T tol = std::is_same_v<T, double> ? 1e-6 : 2e-2;
+    EXPECT_ARR_NEAR(nc, ref_evals.data(), evals.data(), tol * ref_evals[0]);
+
+    // Compare absolute values as the sign of each component is arbitrary
+    for (auto *v : {&ref_evecs, &evecs})
+        for (T &x : *v)
+            x = std::abs(x);
+    EXPECT_ARR_NEAR(param.n * nc, ref_evecs.data(), evecs.data(), tol);
+
+    T smax = 0;
+    for (auto *v : {&ref_scores, &scores})
+        for (T &x : *v) {
+            x = std::abs(x);
+            smax = std::max(smax, x);
+        }
+    EXPECT_ARR_NEAR(param.n * nc, ref_scores.data(), scores.data(), tol * smax);
+}
+
+TYPED_TEST(KernelPCATest, ApproximateSolver) {
+    std::vector<KernelPCAParamType<TypeParam>> params;
+    add_linear_tall(params);
+    add_linear_wide(params);
+    add_rbf_tall(params);
+    add_rbf_wide(params);
+    add_poly_tall(params);
+    add_poly_wide(params);
+
+    for (const KernelPCAParamType<TypeParam> &param : params) {
+        check_approximate_vs_syevd(param);
+    }
+}
+
+TYPED_TEST(KernelPCATest, ApproximateSolverErrors) {
+    std::vector<KernelPCAParamType<TypeParam>> params;
+    add_rbf_tall(params);
+    const KernelPCAParamType<TypeParam> &param = params[0];
+    da_int n = param.n;
+
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kernel_pca),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "storage order", param.order.c_str()),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "eigensolver", "approximate"),
+              da_status_success);
+    EXPECT_EQ(da_kernel_pca_set_data(handle, n, param.p, param.A.data(), param.lda),
+              da_status_success);
+
+    EXPECT_EQ(da_options_set_string(handle, "fit inverse transform", "yes"),
+              da_status_success);
+    EXPECT_EQ(da_kernel_pca_compute<TypeParam>(handle), da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_string(handle, "fit inverse transform", "no"),
+              da_status_success);
+
+    // No more components than landmarks can be found
+    da_int n_landmarks = std::max(n / 2, (da_int)1);
+    EXPECT_EQ(da_options_set_string(handle, "kernel", "rbf"), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "landmark sampling", "kmeans"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_landmarks", n_landmarks), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", n_landmarks + 1),
+              da_status_success);
+    EXPECT_EQ(da_kernel_pca_compute<TypeParam>(handle), da_status_incompatible_options);
+    da_int nc = 0, dim = 1;
+    EXPECT_EQ(da_handle_get_result_int(handle, da_kernel_pca_n_components, &dim, &nc),
+              da_status_success);
+    EXPECT_LE(nc, n_landmarks);
+    da_handle_destroy(&handle);
+
+    // A precomputed kernel cannot be approximated
+    std::vector<TypeParam> K(n * n, 0);
+    for (da_int i = 0; i < n; i++)
+        K[i + i * n] = 1;
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kernel_pca),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "eigensolver", "approximate"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "kernel", "precomputed"), da_status_success);
+    EXPECT_EQ(da_kernel_pca_set_data(handle, n, n, K.data(), n), da_status_success);
+    EXPECT_EQ(da_kernel_pca_compute<TypeParam>(handle), da_status_invalid_input);
+    da_handle_destroy(&handle);
+}
+
 template <typename T> void test_functionality(const KernelPCAParamType<T> &param) {
     std::cout << "Functionality test: " << param.test_name << std::endl;
 
@@ -1007,6 +1007,522 @@ TYPED_TEST(PCATest, RandomizedSolver) {
     }
 }
 
+template <typename T>
+void fit_pca_incremental(da_handle handle, da_int n, da_int p, const std::vector<T> &A,
+                         da_int lda, bool row_major, const std::vector<da_int> &batches) {
+    da_int first = 0;
+    for (da_int m : batches) {
+        const T *batch = row_major ? &A[first * lda] : &A[first];
+        EXPECT_EQ(da_pca_partial_fit(handle, m, p, batch, lda), da_status_success);
+        first += m;
+    }
+    EXPECT_EQ(first, n);
+}
+
+TYPED_TEST(PCATest, IncrementalMatchesFull) {
+    // Fitting all the components batch by batch should reproduce the full PCA
+    da_int n = 40, p = 6;
+    std::mt19937 gen(17);
+    std::normal_distribution<TypeParam> dist(0.0, 1.0);
+    std::vector<TypeParam> A(n * p);
+    for (da_int j = 0; j < p; j++)
+        for (da_int i = 0; i < n; i++)
+            A[i + n * j] = (TypeParam)(j + 1) * dist(gen) + (TypeParam)(3 * j);
+    std::vector<TypeParam> A_row(n * p);
+    for (da_int j = 0; j < p; j++)
+        for (da_int i = 0; i < n; i++)
+            A_row[i * p + j] = A[i + n * j];
+    std::vector<da_int> batches = {13, 13, 14};
+    TypeParam tol = 1e4 * std::numeric_limits<TypeParam>::epsilon();
+
+    for (std::string method : {"covariance", "svd"}) {
+        for (da_int whiten : {0, 1}) {
+            da_handle handle = nullptr;
+            EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_pca),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_int(handle, "n_components", p), da_status_success);
+            EXPECT_EQ(da_options_set_string(handle, "PCA method", method.c_str()),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_int(handle, "whiten", whiten), da_status_success);
+            EXPECT_EQ(da_options_set_string(handle, "svd solver", "gesdd"),
+                      da_status_success);
+            EXPECT_EQ(da_pca_set_data(handle, n, p, A.data(), n), da_status_success);
+            EXPECT_EQ(da_pca_compute<TypeParam>(handle), da_status_success);
+
+            std::vector<TypeParam> ref_sigma(p), ref_variance(p), ref_vt(p * p),
+                ref_X(n * p), ref_rinfo(3);
+            TypeParam ref_total_variance;
+            da_int dim = p, dim_vt = p * p, dim_one = 1, dim_rinfo = 3;
+            EXPECT_EQ(da_handle_get_result(handle, da_pca_sigma, &dim, ref_sigma.data()),
+                      da_status_success);
+            EXPECT_EQ(
+                da_handle_get_result(handle, da_pca_variance, &dim, ref_variance.data()),
+                da_status_success);
+            EXPECT_EQ(da_handle_get_result(handle, da_pca_vt, &dim_vt, ref_vt.data()),
+                      da_status_success);
+            EXPECT_EQ(da_handle_get_result(handle, da_pca_total_variance, &dim_one,
+                                           &ref_total_variance),
+                      da_status_success);
+            EXPECT_EQ(da_pca_transform(handle, n, p, A.data(), n, ref_X.data(), n),
+                      da_status_success);
+            da_handle_destroy(&handle);
+
+            for (bool row_major : {false, true}) {
+                EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_pca),
+                          da_status_success);
+                EXPECT_EQ(da_options_set_int(handle, "n_components", p),
+                          da_status_success);
+                EXPECT_EQ(da_options_set_string(handle, "PCA method", method.c_str()),
+                          da_status_success);
+                EXPECT_EQ(da_options_set_int(handle, "whiten", whiten),
+                          da_status_success);
+                if (row_major) {
+                    EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+                              da_status_success);
+                }
+                fit_pca_incremental(handle, n, p, row_major ? A_row : A,
+                                    row_major ? p : n, row_major, batches);
+
+                std::vector<TypeParam> sigma(p), variance(p), vt(p * p), X(n * p),
+                    rinfo(3);
+                TypeParam total_variance;
+                EXPECT_EQ(
+                    da_handle_get_result(handle, da_rinfo, &dim_rinfo, rinfo.data()),
+                    da_status_success);
+                EXPECT_EQ(rinfo[0], (TypeParam)n);
+                EXPECT_EQ(rinfo[2], (TypeParam)p);
+                EXPECT_EQ(da_handle_get_result(handle, da_pca_sigma, &dim, sigma.data()),
+                          da_status_success);
+                EXPECT_EQ(
+                    da_handle_get_result(handle, da_pca_variance, &dim, variance.data()),
+                    da_status_success);
+                EXPECT_EQ(da_handle_get_result(handle, da_pca_vt, &dim_vt, vt.data()),
+                          da_status_success);
+                EXPECT_EQ(da_handle_get_result(handle, da_pca_total_variance, &dim_one,
+                                               &total_variance),
+                          da_status_success);
+                EXPECT_NEAR(total_variance, ref_total_variance,
+                            tol * ref_total_variance);
+                EXPECT_ARR_NEAR(p, ref_sigma.data(), sigma.data(), tol * ref_sigma[0]);
+                EXPECT_ARR_NEAR(p, ref_variance.data(), variance.data(),
+                                tol * ref_variance[0]);
+
+                // The components (and transformed data) agree up to sign
+                if (row_major) {
+                    EXPECT_EQ(
+                        da_pca_transform(handle, n, p, A_row.data(), p, X.data(), p),
+                        da_status_success);
+                    std::vector<TypeParam> X_col(n * p);
+                    for (da_int j = 0; j < p; j++)
+                        for (da_int i = 0; i < n; i++)
+                            X_col[i + n * j] = X[i * p + j];
+                    X = X_col;
+                    std::vector<TypeParam> vt_col(p * p);
+                    for (da_int j = 0; j < p; j++)
+                        for (da_int i = 0; i < p; i++)
+                            vt_col[i + p * j] = vt[i * p + j];
+                    vt = vt_col;
+                } else {
+                    EXPECT_EQ(da_pca_transform(handle, n, p, A.data(), n, X.data(), n),
+                              da_status_success);
+                }
+                for (da_int i = 0; i < p * p; i++)
+                    EXPECT_NEAR(std::abs(vt[i]), std::abs(ref_vt[i]), tol);
+                TypeParam xmax = 0;
+                for (da_int i = 0; i < n * p; i++)
+                    xmax = std::max(xmax, std::abs(ref_X[i]));
+                for (da_int i = 0; i < n * p; i++)
+                    EXPECT_NEAR(std::abs(X[i]), std::abs(ref_X[i]), tol * xmax);
+
+                da_handle_destroy(&handle);
+            }
+        }
+    }
+}
+
+TYPED_TEST(PCATest, IncrementalLowRank) {
+    // Data lying on a two-dimensional affine subspace is captured exactly by two
+    // components, whatever the batch sizes
+    da_int n = 30, p = 5, k = 2;
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<TypeParam> dist(-1.0, 1.0);
+    std::vector<TypeParam> basis(k * p), A(n * p);
+    for (auto &b : basis)
+        b = dist(gen);
+    for (da_int i = 0; i < n; i++) {
+        TypeParam c0 = 4 * dist(gen), c1 = dist(gen);
+        for (da_int j = 0; j < p; j++)
+            A[i + n * j] = c0 * basis[j] + c1 * basis[p + j] + (TypeParam)j;
+    }
+
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_pca), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", k), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "svd solver", "gesdd"), da_status_success);
+    EXPECT_EQ(da_pca_set_data(handle, n, p, A.data(), n), da_status_success);
+    EXPECT_EQ(da_pca_compute<TypeParam>(handle), da_status_success);
+    std::vector<TypeParam> ref_sigma(k), ref_means(p), ref_X(n * k);
+    da_int dim_k = k, dim_p = p;
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_sigma, &dim_k, ref_sigma.data()),
+              da_status_success);
+    EXPECT_EQ(
+        da_handle_get_result(handle, da_pca_column_means, &dim_p, ref_means.data()),
+        da_status_success);
+    EXPECT_EQ(da_pca_transform(handle, n, p, A.data(), n, ref_X.data(), n),
+              da_status_success);
+    da_handle_destroy(&handle);
+
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_pca), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", k), da_status_success);
+    fit_pca_incremental(handle, n, p, A, n, false, {2, 7, 1, 20});
+    std::vector<TypeParam> sigma(k), means(p), X(n * k), A_inv(n * p);
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_sigma, &dim_k, sigma.data()),
+              da_status_success);
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_column_means, &dim_p, means.data()),
+              da_status_success);
+    EXPECT_EQ(da_pca_transform(handle, n, p, A.data(), n, X.data(), n),
+              da_status_success);
+    EXPECT_EQ(da_pca_inverse_transform(handle, n, k, X.data(), n, A_inv.data(), n),
+              da_status_success);
+
+    // Scores are not available from an incremental fit
+    std::vector<TypeParam> scores(n * k);
+    da_int dim_scores = n * k;
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_scores, &dim_scores, scores.data()),
+              da_status_invalid_option);
+    da_handle_destroy(&handle);
+
+    TypeParam tol = 1e3 * std::numeric_limits<TypeParam>::epsilon();
+    EXPECT_ARR_NEAR(k, ref_sigma.data(), sigma.data(), tol * ref_sigma[0]);
+    EXPECT_ARR_NEAR(p, ref_means.data(), means.data(), tol * p);
+    for (da_int i = 0; i < n * k; i++)
+        EXPECT_NEAR(std::abs(X[i]), std::abs(ref_X[i]), tol * ref_sigma[0]);
+    EXPECT_ARR_NEAR(n * p, A.data(), A_inv.data(), tol * 10 * p);
+}
+
+TYPED_TEST(PCATest, IncrementalErrors) {
+    da_int n = 4, p = 3;
+    std::vector<TypeParam> A = {1.0, 2.0, 4.0, 3.0, 2.0, 1.0,
+                                0.0, 5.0, 1.0, 1.0, 2.0, 3.0};
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_pca), da_status_success);
+
+    // The first batch must contain at least n_components samples
+    EXPECT_EQ(da_options_set_int(handle, "n_components", 3), da_status_success);
+    EXPECT_EQ(da_pca_partial_fit(handle, 2, p, A.data(), n), da_status_invalid_input);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", 2), da_status_success);
+
+    // Correlation and store U need the full data matrix
+    EXPECT_EQ(da_options_set_string(handle, "PCA method", "correlation"),
+              da_status_success);
+    EXPECT_EQ(da_pca_partial_fit(handle, n, p, A.data(), n),
+              da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_string(handle, "PCA method", "covariance"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "store U", 1), da_status_success);
+    EXPECT_EQ(da_pca_partial_fit(handle, n, p, A.data(), n),
+              da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_int(handle, "store U", 0), da_status_success);
+
+    // Later batches must have the same number of features
+    EXPECT_EQ(da_pca_partial_fit(handle, n, p, A.data(), n), da_status_success);
+    EXPECT_EQ(da_pca_partial_fit(handle, n, p - 1, A.data(), n), da_status_invalid_input);
+    EXPECT_EQ(da_pca_partial_fit(handle, 1, p, A.data(), n), da_status_success);
+    EXPECT_EQ(da_pca_partial_fit(handle, n, p, A.data(), n - 1),
+              da_status_invalid_leading_dimension);
+
+    da_int dim = 3;
+    std::vector<TypeParam> rinfo(3);
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, rinfo.data()),
+              da_status_success);
+    EXPECT_EQ(rinfo[0], (TypeParam)(n + 1));
+
+    // Setting data starts again from scratch
+    EXPECT_EQ(da_pca_set_data(handle, n, p, A.data(), n), da_status_success);
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, rinfo.data()),
+              da_status_no_data);
+    EXPECT_EQ(da_pca_partial_fit(handle, n, p, A.data(), n), da_status_success);
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, rinfo.data()),
+              da_status_success);
+    EXPECT_EQ(rinfo[0], (TypeParam)n);
+
+    da_handle_destroy(&handle);
+}
+
+// Row block call-back reading from a column-major matrix held in memory
+template <typename T> struct block_source {
+    const std::vector<T> *A = nullptr;
+    da_int n = 0;
+    bool row_major = false;
+    da_int n_calls = 0, max_rows = 0, fail_at_call = -1;
+};
+
+template <typename T>
+da_int read_rows(da_int first_row, da_int n_rows, da_int n_features, void *data,
+                 T *block, da_int ldb) {
+    block_source<T> *src = static_cast<block_source<T> *>(data);
+    if (src->n_calls++ == src->fail_at_call)
+        return 1;
+    src->max_rows = std::max(src->max_rows, n_rows);
+    for (da_int j = 0; j < n_features; j++) {
+        for (da_int i = 0; i < n_rows; i++) {
+            T a = (*src->A)[first_row + i + src->n * j];
+            if (src->row_major)
+                block[i * ldb + j] = a;
+            else
+                block[i + ldb * j] = a;
+        }
+    }
+    return 0;
+}
+
+template <typename T>
+void check_streamed_vs_gesdd(const std::vector<T> &A, da_int n, da_int p, da_int k,
+                             const std::string &method, da_int n_oversamples) {
+    T tol = 1e4 * std::numeric_limits<T>::epsilon();
+    da_int dim_k = k, dim_vt = k * p, dim_p = p, dim_one = 1;
+
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init<T>(&handle, da_handle_pca), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", k), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "PCA method", method.c_str()),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "svd solver", "gesdd"), da_status_success);
+    EXPECT_EQ(da_pca_set_data(handle, n, p, A.data(), n), da_status_success);
+    EXPECT_EQ(da_pca_compute<T>(handle), da_status_success);
+    std::vector<T> ref_sigma(k), ref_vt(k * p), ref_means(p), ref_X(n * k);
+    T ref_total_variance;
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_sigma, &dim_k, ref_sigma.data()),
+              da_status_success);
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_vt, &dim_vt, ref_vt.data()),
+              da_status_success);
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_total_variance, &dim_one,
+                                   &ref_total_variance),
+              da_status_success);
+    if (method != "svd") {
+        EXPECT_EQ(da_handle_get_result(handle, da_pca_column_means, &dim_p,
+                                       ref_means.data()),
+                  da_status_success);
+    }
+    EXPECT_EQ(da_pca_transform(handle, n, p, A.data(), n, ref_X.data(), n),
+              da_status_success);
+    da_handle_destroy(&handle);
+
+    for (bool row_major : {false, true}) {
+        da_int block_size = 37, q = 2;
+        block_source<T> src;
+        src.A = &A;
+        src.n = n;
+        src.row_major = row_major;
+        EXPECT_EQ(da_handle_init<T>(&handle, da_handle_pca), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "n_components", k), da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "PCA method", method.c_str()),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "block size", block_size),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "power iterations", q), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "n_oversamples", n_oversamples),
+                  da_status_success);
+        if (row_major) {
+            EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+                      da_status_success);
+        }
+        EXPECT_EQ(da_pca_set_data_callback<T>(handle, n, p, read_rows<T>, &src),
+                  da_status_success);
+        EXPECT_EQ(src.n_calls, 0);
+        EXPECT_EQ(da_pca_compute<T>(handle), da_status_success);
+
+        // One pass for the statistics, q + 1 for the range finder and one for the SVD
+        da_int n_blocks = (n + block_size - 1) / block_size;
+        EXPECT_EQ(src.n_calls, (q + 3) * n_blocks);
+        EXPECT_EQ(src.max_rows, block_size);
+
+        std::vector<T> sigma(k), vt(k * p), means(p), X(n * k);
+        T total_variance;
+        EXPECT_EQ(da_handle_get_result(handle, da_pca_sigma, &dim_k, sigma.data()),
+                  da_status_success);
+        EXPECT_EQ(da_handle_get_result(handle, da_pca_vt, &dim_vt, vt.data()),
+                  da_status_success);
+        EXPECT_EQ(da_handle_get_result(handle, da_pca_total_variance, &dim_one,
+                                       &total_variance),
+                  da_status_success);
+        EXPECT_NEAR(total_variance, ref_total_variance, tol * ref_total_variance);
+        EXPECT_ARR_NEAR(k, ref_sigma.data(), sigma.data(), tol * ref_sigma[0]);
+        if (method != "svd") {
+            EXPECT_EQ(
+                da_handle_get_result(handle, da_pca_column_means, &dim_p, means.data()),
+                da_status_success);
+            EXPECT_ARR_NEAR(p, ref_means.data(), means.data(), tol * p);
+        }
+
+        // The components (and transformed data) agree up to sign
+        std::vector<T> A_in = A;
+        da_int lda = n, ldx = n;
+        if (row_major) {
+            for (da_int j = 0; j < p; j++)
+                for (da_int i = 0; i < n; i++)
+                    A_in[i * p + j] = A[i + n * j];
+            lda = p;
+            ldx = k;
+        }
+        EXPECT_EQ(da_pca_transform(handle, n, p, A_in.data(), lda, X.data(), ldx),
+                  da_status_success);
+        for (da_int i = 0; i < k; i++) {
+            for (da_int j = 0; j < p; j++) {
+                T v = row_major ? vt[i * p + j] : vt[i + k * j];
+                EXPECT_NEAR(std::abs(v), std::abs(ref_vt[i + k * j]), tol);
+            }
+            for (da_int r = 0; r < n; r++) {
+                T x = row_major ? X[r * k + i] : X[r + n * i];
+                EXPECT_NEAR(std::abs(x), std::abs(ref_X[r + n * i]), tol * ref_sigma[0]);
+            }
+        }
+
+        // Scores need the full matrix U
+        std::vector<T> scores(n * k);
+        da_int dim_scores = n * k;
+        EXPECT_EQ(
+            da_handle_get_result(handle, da_pca_scores, &dim_scores, scores.data()),
+            da_status_invalid_option);
+        da_handle_destroy(&handle);
+    }
+}
+
+TYPED_TEST(PCATest, StreamedMatchesFull) {
+    da_int n = 500, p = 8;
+    std::mt19937 gen(29);
+    std::normal_distribution<TypeParam> dist(0.0, 1.0);
+    std::vector<TypeParam> A(n * p);
+    for (da_int j = 0; j < p; j++)
+        for (da_int i = 0; i < n; i++)
+            A[i + n * j] = (TypeParam)(p - j) * dist(gen) + (TypeParam)(2 * j);
+
+    // With n_oversamples large enough the sketch spans every column, so the randomized
+    // solution is exact
+    for (std::string method : {"covariance", "correlation", "svd"})
+        check_streamed_vs_gesdd(A, n, p, 3, method, 10);
+}
+
+TYPED_TEST(PCATest, StreamedLowRank) {
+    // Data lying on a three-dimensional affine subspace is captured exactly by a sketch
+    // with fewer columns than features
+    da_int n = 300, p = 30, k = 3;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<TypeParam> dist(-1.0, 1.0);
+    std::vector<TypeParam> basis(k * p), A(n * p);
+    for (auto &b : basis)
+        b = dist(gen);
+    for (da_int i = 0; i < n; i++) {
+        TypeParam c[3] = {9 * dist(gen), 3 * dist(gen), dist(gen)};
+        for (da_int j = 0; j < p; j++) {
+            A[i + n * j] = (TypeParam)j;
+            for (da_int l = 0; l < k; l++)
+                A[i + n * j] += c[l] * basis[l * p + j];
+        }
+    }
+    check_streamed_vs_gesdd(A, n, p, k, "covariance", 2);
+}
+
+TYPED_TEST(PCATest, StreamedErrors) {
+    da_int n = 100, p = 4;
+    std::vector<TypeParam> A(n * p);
+    for (da_int i = 0; i < n * p; i++)
+        A[i] = (TypeParam)((i * 7) % 11);
+    block_source<TypeParam> src;
+    src.A = &A;
+    src.n = n;
+    da_pca_block_t<TypeParam> *cb = read_rows<TypeParam>;
+
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_pca), da_status_success);
+    EXPECT_EQ(da_pca_set_data_callback<TypeParam>(handle, n, p, nullptr, &src),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_pca_compute<TypeParam>(handle), da_status_no_data);
+    EXPECT_EQ(da_pca_set_data_callback<TypeParam>(handle, 0, p, cb, &src),
+              da_status_invalid_input);
+    EXPECT_EQ(da_pca_set_data_callback<TypeParam>(handle, n, 0, cb, &src),
+              da_status_invalid_input);
+    EXPECT_EQ(da_pca_set_data_callback<TypeParam>(handle, n, p, cb, &src),
+              da_status_success);
+
+    // Only the randomized solver can stream the data, and U cannot be stored
+    EXPECT_EQ(da_options_set_string(handle, "svd solver", "gesdd"), da_status_success);
+    EXPECT_EQ(da_pca_compute<TypeParam>(handle), da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_string(handle, "svd solver", "randomized"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "store U", 1), da_status_success);
+    EXPECT_EQ(da_pca_compute<TypeParam>(handle), da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_int(handle, "store U", 0), da_status_success);
+
+    // A failure in the call-back stops the computation
+    EXPECT_EQ(da_options_set_int(handle, "block size", 10), da_status_success);
+    src.fail_at_call = 13;
+    EXPECT_EQ(da_pca_compute<TypeParam>(handle), da_status_io_error);
+    src.fail_at_call = -1;
+    EXPECT_EQ(da_pca_compute<TypeParam>(handle), da_status_success);
+
+    // Passing an array again uses the in-memory solvers
+    EXPECT_EQ(da_pca_set_data(handle, n, p, A.data(), n), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "svd solver", "gesdd"), da_status_success);
+    EXPECT_EQ(da_pca_compute<TypeParam>(handle), da_status_success);
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(PCATest, ConcurrentInference) {
+    // Several threads share one trained handle, each with its own inference context;
+    // the results must match the serial handle-based calls
+    da_int n = 40, p = 4, n_components = 2;
+    std::vector<TypeParam> A(n * p);
+    for (da_int i = 0; i < n * p; i++)
+        A[i] = (TypeParam)(((i * 104729) % 389) / 97.0 - 2.0);
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_pca), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", n_components),
+              da_status_success);
+    EXPECT_EQ(da_pca_set_data(handle, n, p, A.data(), n), da_status_success);
+    ASSERT_EQ(da_pca_compute<TypeParam>(handle), da_status_success);
+
+    const da_int n_chunks = 16, chunk = 23, n_total = n_chunks * chunk;
+    std::vector<TypeParam> Y(n_total * p);
+    for (da_int i = 0; i < (da_int)Y.size(); i++)
+        Y[i] = (TypeParam)(((i * 7919) % 613) / 153.0 - 2.0);
+
+    std::vector<TypeParam> trans_ref(n_total * n_components);
+    for (da_int c = 0; c < n_chunks; c++)
+        EXPECT_EQ(da_pca_transform(handle, chunk, p, &Y[c * chunk], n_total,
+                                   &trans_ref[c * chunk], n_total),
+                  da_status_success);
+
+    std::vector<TypeParam> trans(n_total * n_components, (TypeParam)-1);
+    std::vector<da_status> status(n_chunks, da_status_internal_error);
+#pragma omp parallel for schedule(dynamic)
+    for (da_int c = 0; c < n_chunks; c++) {
+        da_inference_context ctx = nullptr;
+        if (da_inference_context_init(&ctx) != da_status_success)
+            continue;
+        status[c] = da_pca_transform(handle, ctx, chunk, p, &Y[c * chunk], n_total,
+                                     &trans[c * chunk], n_total);
+        da_inference_context_destroy(&ctx);
+    }
+    for (da_int c = 0; c < n_chunks; c++)
+        EXPECT_EQ(status[c], da_status_success);
+    EXPECT_ARR_NEAR(n_total * n_components, trans, trans_ref,
+                    100 * std::numeric_limits<TypeParam>::epsilon());
+
+    // Errors are reported in the context rather than in the handle
+    da_inference_context ctx = nullptr;
+    ASSERT_EQ(da_inference_context_init(&ctx), da_status_success);
+    EXPECT_EQ(da_pca_transform(handle, ctx, chunk, p + 1, Y.data(), n_total, trans.data(),
+                               n_total),
+              da_status_invalid_input);
+    EXPECT_EQ(da_inference_context_print_error_message(ctx), da_status_success);
+    EXPECT_EQ(da_pca_transform(handle, (da_inference_context) nullptr, chunk, p,
+                               Y.data(), n_total, trans.data(), n_total),
+              da_status_invalid_pointer);
+    da_inference_context_destroy(&ctx);
+    da_handle_destroy(&handle);
+}
+
 TEST(PCATest, IncorrectHandlePrecision) {
 
     da_handle handle_d = nullptr;
@@ -1024,6 +1540,9 @@ TEST(PCATest, IncorrectHandlePrecision) {
     EXPECT_EQ(da_pca_compute_d(handle_s), da_status_wrong_type);
     EXPECT_EQ(da_pca_compute_s(handle_d), da_status_wrong_type);
 
+    EXPECT_EQ(da_pca_partial_fit_d(handle_s, 1, 1, &Ad, 1), da_status_wrong_type);
+    EXPECT_EQ(da_pca_partial_fit_s(handle_d, 1, 1, &As, 1), da_status_wrong_type);
+
     EXPECT_EQ(da_pca_transform_d(handle_s, 1, 1, &Ad, 1, &Ad, 1), da_status_wrong_type);
     EXPECT_EQ(da_pca_transform_s(handle_d, 1, 1, &As, 1, &As, 1), da_status_wrong_type);
 
@@ -1032,6 +1551,14 @@ TEST(PCATest, IncorrectHandlePrecision) {
     EXPECT_EQ(da_pca_inverse_transform_s(handle_d, 1, 1, &As, 1, &As, 1),
               da_status_wrong_type);
 
+    da_inference_context ctx = nullptr;
+    EXPECT_EQ(da_inference_context_init(&ctx), da_status_success);
+    EXPECT_EQ(da_pca_transform_ctx_d(handle_s, ctx, 1, 1, &Ad, 1, &Ad, 1),
+              da_status_wrong_type);
+    EXPECT_EQ(da_pca_transform_ctx_s(handle_d, ctx, 1, 1, &As, 1, &As, 1),
+              da_status_wrong_type);
+    da_inference_context_destroy(&ctx);
+
     da_handle_destroy(&handle_d);
     da_handle_destroy(&handle_s);
 }
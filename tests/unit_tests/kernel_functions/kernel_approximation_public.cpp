@@ -0,0 +1,384 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "../utest_utils.hpp"
+#include "aoclda.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename T> class KernelApproxTest : public testing::Test {};
+
+using FloatTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(KernelApproxTest, FloatTypes);
+
+// n x p matrix with entries uniform in [lo, hi], stored row-major
+template <typename T>
+std::vector<T> random_matrix(da_int n, da_int p, T lo, T hi, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<T> dist(lo, hi);
+    std::vector<T> A(n * p);
+    for (T &a : A)
+        a = dist(gen);
+    return A;
+}
+
+template <typename T>
+std::vector<T> to_col_major(const std::vector<T> &A, da_int n, da_int p) {
+    std::vector<T> B(n * p);
+    for (da_int i = 0; i < n; i++)
+        for (da_int j = 0; j < p; j++)
+            B[i + j * n] = A[i * p + j];
+    return B;
+}
+
+// Row-major m x n matrix of inner products between the rows of Z1 (m x k) and Z2 (n x k)
+template <typename T>
+std::vector<T> inner_products(const std::vector<T> &Z1, da_int m, const std::vector<T> &Z2,
+                              da_int n, da_int k, bool row_major) {
+    std::vector<T> G(m * n, 0);
+    for (da_int i = 0; i < m; i++)
+        for (da_int j = 0; j < n; j++)
+            for (da_int l = 0; l < k; l++) {
+                T a = row_major ? Z1[i * k + l] : Z1[i + l * m];
+                T b = row_major ? Z2[j * k + l] : Z2[j + l * n];
+                G[i * n + j] += a * b;
+            }
+    return G;
+}
+
+template <typename T>
+void fit_and_transform(da_handle handle, bool row_major, da_int n, da_int p,
+                       const std::vector<T> &X_rm, da_int m, const std::vector<T> &Y_rm,
+                       da_int nc, std::vector<T> &Z_X, std::vector<T> &Z_Y) {
+    std::vector<T> X = row_major ? X_rm : to_col_major(X_rm, n, p);
+    std::vector<T> Y = row_major ? Y_rm : to_col_major(Y_rm, m, p);
+    EXPECT_EQ(da_options_set_string(handle, "storage order",
+                                    row_major ? "row-major" : "column-major"),
+              da_status_success);
+    EXPECT_EQ(da_kernel_approx_set_data(handle, n, p, X.data(), row_major ? p : n),
+              da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<T>(handle), da_status_success);
+    Z_X.assign(n * nc, 0);
+    Z_Y.assign(m * nc, 0);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n, p, X.data(), row_major ? p : n,
+                                         Z_X.data(), row_major ? nc : n),
+              da_status_success);
+    EXPECT_EQ(da_kernel_approx_transform(handle, m, p, Y.data(), row_major ? p : m,
+                                         Z_Y.data(), row_major ? nc : m),
+              da_status_success);
+}
+
+TYPED_TEST(KernelApproxTest, NystroemAllLandmarksIsExact) {
+    // With every sample as a landmark, the Nystroem features reproduce the kernel
+    const da_int n = 15, p = 4, m = 5;
+    std::vector<TypeParam> X = random_matrix<TypeParam>(n, p, -1, 1, 11);
+    std::vector<TypeParam> Y = random_matrix<TypeParam>(m, p, -1, 1, 12);
+    TypeParam gamma = 1, coef0 = 1;
+    da_int degree = 3;
+    TypeParam rtol = std::is_same_v<TypeParam, double> ? 1e-7 : 5e-3;
+
+    for (std::string kernel : {"rbf", "linear", "poly"}) {
+        std::vector<TypeParam> K(n * n), K_YX(m * n);
+        if (kernel == "rbf") {
+            da_rbf_kernel(row_major, n, n, p, X.data(), p, X.data(), p, K.data(), n,
+                          gamma);
+            da_rbf_kernel(row_major, m, n, p, Y.data(), p, X.data(), p, K_YX.data(), n,
+                          gamma);
+        } else if (kernel == "linear") {
+            da_linear_kernel(row_major, n, n, p, X.data(), p, X.data(), p, K.data(), n);
+            da_linear_kernel(row_major, m, n, p, Y.data(), p, X.data(), p, K_YX.data(),
+                             n);
+        } else {
+            da_polynomial_kernel(row_major, n, n, p, X.data(), p, X.data(), p, K.data(),
+                                 n, gamma, degree, coef0);
+            da_polynomial_kernel(row_major, m, n, p, Y.data(), p, X.data(), p,
+                                 K_YX.data(), n, gamma, degree, coef0);
+        }
+        TypeParam kmax = 0;
+        for (TypeParam k : K)
+            kmax = std::max(kmax, std::abs(k));
+
+        for (bool rm : {false, true}) {
+            da_handle handle = nullptr;
+            ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kernel_approx),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_string(handle, "kernel", kernel.c_str()),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_int(handle, "n_components", n), da_status_success);
+            EXPECT_EQ(da_options_set(handle, "gamma", gamma), da_status_success);
+            EXPECT_EQ(da_options_set(handle, "coef0", coef0), da_status_success);
+            EXPECT_EQ(da_options_set_int(handle, "degree", degree), da_status_success);
+
+            std::vector<TypeParam> Z_X, Z_Y;
+            fit_and_transform(handle, rm, n, p, X, m, Y, n, Z_X, Z_Y);
+            std::vector<TypeParam> G = inner_products(Z_X, n, Z_X, n, n, rm);
+            std::vector<TypeParam> G_YX = inner_products(Z_Y, m, Z_X, n, n, rm);
+            EXPECT_ARR_NEAR(n * n, G.data(), K.data(), rtol * kmax);
+            EXPECT_ARR_NEAR(m * n, G_YX.data(), K_YX.data(), rtol * kmax);
+
+            da_int nc = 0, dim = 1;
+            EXPECT_EQ(
+                da_handle_get_result_int(handle, da_kernel_approx_n_components, &dim, &nc),
+                da_status_success);
+            EXPECT_EQ(nc, n);
+            dim = n * n;
+            std::vector<TypeParam> normalization(dim);
+            EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_normalization, &dim,
+                                           normalization.data()),
+                      da_status_success);
+            da_handle_destroy(&handle);
+        }
+    }
+}
+
+TYPED_TEST(KernelApproxTest, NystroemKmeansLandmarks) {
+    // Three well separated clusters are summarized well by a few k-means landmarks
+    const da_int n = 60, p = 3, nc = 12;
+    std::vector<TypeParam> X = random_matrix<TypeParam>(n, p, -0.5, 0.5, 3);
+    for (da_int i = 0; i < n; i++)
+        X[i * p + i % p] += 4;
+
+    std::vector<TypeParam> K(n * n);
+    TypeParam gamma = 1.0 / p;
+    da_rbf_kernel(row_major, n, n, p, X.data(), p, X.data(), p, K.data(), n, gamma);
+
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kernel_approx),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "landmark sampling", "kmeans"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", nc), da_status_success);
+    std::vector<TypeParam> Z_X, Z_Y;
+    fit_and_transform(handle, true, n, p, X, 1, X, nc, Z_X, Z_Y);
+
+    std::vector<TypeParam> G = inner_products(Z_X, n, Z_X, n, nc, true);
+    TypeParam err = 0, norm = 0;
+    for (da_int i = 0; i < n * n; i++) {
+        err += (G[i] - K[i]) * (G[i] - K[i]);
+        norm += K[i] * K[i];
+    }
+    EXPECT_LT(std::sqrt(err / norm), (TypeParam)0.05);
+
+    da_int dim = 4;
+    std::vector<TypeParam> rinfo(dim);
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, rinfo.data()),
+              da_status_success);
+    EXPECT_EQ(rinfo[0], (TypeParam)n);
+    EXPECT_EQ(rinfo[1], (TypeParam)p);
+    EXPECT_EQ(rinfo[2], (TypeParam)nc);
+    EXPECT_NEAR(rinfo[3], gamma, 10 * std::numeric_limits<TypeParam>::epsilon());
+
+    dim = 0;
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_components, &dim, G.data()),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, nc * p);
+    std::vector<TypeParam> landmarks(dim);
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_components, &dim,
+                                   landmarks.data()),
+              da_status_success);
+    // Every cluster is represented among the landmarks
+    std::vector<da_int> count(p, 0);
+    for (da_int i = 0; i < nc; i++) {
+        da_int c =
+            std::max_element(&landmarks[i * p], &landmarks[i * p] + p) - &landmarks[i * p];
+        count[c]++;
+    }
+    for (da_int c = 0; c < p; c++)
+        EXPECT_GT(count[c], 0);
+
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(KernelApproxTest, RandomFourierFeatures) {
+    const da_int n = 10, p = 3, nc = 4000;
+    std::vector<TypeParam> X = random_matrix<TypeParam>(n, p, -1, 1, 5);
+    std::vector<TypeParam> Y = random_matrix<TypeParam>(2, p, -1, 1, 6);
+    TypeParam gamma = 0.5;
+    std::vector<TypeParam> K(n * n), K_YX(2 * n);
+    da_rbf_kernel(row_major, n, n, p, X.data(), p, X.data(), p, K.data(), n, gamma);
+    da_rbf_kernel(row_major, 2, n, p, Y.data(), p, X.data(), p, K_YX.data(), n, gamma);
+
+    for (bool rm : {false, true}) {
+        da_handle handle = nullptr;
+        ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kernel_approx),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "method", "rff"), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "n_components", nc), da_status_success);
+        EXPECT_EQ(da_options_set(handle, "gamma", gamma), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "seed", 42), da_status_success);
+
+        std::vector<TypeParam> Z_X, Z_Y;
+        fit_and_transform(handle, rm, n, p, X, 2, Y, nc, Z_X, Z_Y);
+        std::vector<TypeParam> G = inner_products(Z_X, n, Z_X, n, nc, rm);
+        std::vector<TypeParam> G_YX = inner_products(Z_Y, 2, Z_X, n, nc, rm);
+        EXPECT_ARR_NEAR(n * n, G.data(), K.data(), (TypeParam)0.1);
+        EXPECT_ARR_NEAR(2 * n, G_YX.data(), K_YX.data(), (TypeParam)0.1);
+
+        da_int dim = nc;
+        std::vector<TypeParam> offsets(dim);
+        EXPECT_EQ(
+            da_handle_get_result(handle, da_kernel_approx_offsets, &dim, offsets.data()),
+            da_status_success);
+        for (TypeParam b : offsets) {
+            EXPECT_GE(b, (TypeParam)0);
+            EXPECT_LT(b, (TypeParam)6.2832);
+        }
+        dim = n * n;
+        EXPECT_EQ(
+            da_handle_get_result(handle, da_kernel_approx_normalization, &dim, G.data()),
+            da_status_unknown_query);
+        da_handle_destroy(&handle);
+    }
+}
+
+TYPED_TEST(KernelApproxTest, SaveLoad) {
+    const da_int n = 20, p = 3, m = 4, nc = 8;
+    std::vector<TypeParam> X = random_matrix<TypeParam>(n, p, -1, 1, 21);
+    std::vector<TypeParam> Y = random_matrix<TypeParam>(m, p, -1, 1, 22);
+
+    for (std::string method : {"nystroem", "rff"}) {
+        da_handle handle = nullptr;
+        ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kernel_approx),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "method", method.c_str()),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "n_components", nc), da_status_success);
+        std::vector<TypeParam> Z_X, Z_Y;
+        fit_and_transform(handle, false, n, p, X, m, Y, nc, Z_X, Z_Y);
+
+        std::string model_file = "kernel_approx_test.bin";
+        EXPECT_EQ(da_handle_save_model(handle, model_file.c_str()), da_status_success);
+        da_handle handle_loaded = nullptr;
+        EXPECT_EQ(da_handle_load_model(&handle_loaded, model_file.c_str()),
+                  da_status_success);
+        std::remove(model_file.c_str());
+
+        std::vector<TypeParam> Y_cm = to_col_major(Y, m, p), Z_loaded(m * nc);
+        EXPECT_EQ(da_kernel_approx_transform(handle_loaded, m, p, Y_cm.data(), m,
+                                             Z_loaded.data(), m),
+                  da_status_success);
+        std::vector<TypeParam> Z_ref(m * nc);
+        EXPECT_EQ(da_kernel_approx_transform(handle, m, p, Y_cm.data(), m, Z_ref.data(),
+                                             m),
+                  da_status_success);
+        EXPECT_ARR_NEAR(m * nc, Z_loaded.data(), Z_ref.data(), (TypeParam)0);
+
+        da_handle_destroy(&handle);
+        da_handle_destroy(&handle_loaded);
+    }
+}
+
+TYPED_TEST(KernelApproxTest, ErrorExits) {
+    const da_int n = 6, p = 2;
+    std::vector<TypeParam> X = random_matrix<TypeParam>(n, p, -1, 1, 1);
+    std::vector<TypeParam> Z(n * n);
+    da_handle handle = nullptr;
+
+    EXPECT_EQ(da_kernel_approx_set_data(handle, n, p, X.data(), n),
+              da_status_handle_not_initialized);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle),
+              da_status_handle_not_initialized);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n, p, X.data(), n, Z.data(), n),
+              da_status_handle_not_initialized);
+
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_pca), da_status_success);
+    EXPECT_EQ(da_kernel_approx_set_data(handle, n, p, X.data(), n),
+              da_status_invalid_handle_type);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle), da_status_invalid_handle_type);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n, p, X.data(), n, Z.data(), n),
+              da_status_invalid_handle_type);
+    da_handle_destroy(&handle);
+
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kernel_approx),
+              da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle), da_status_no_data);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n, p, X.data(), n, Z.data(), n),
+              da_status_no_data);
+    da_int dim = n * n;
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_components, &dim, Z.data()),
+              da_status_no_data);
+    EXPECT_EQ(da_kernel_approx_set_data(handle, n, p, X.data(), n - 1),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_kernel_approx_set_data(handle, n, p, (TypeParam *)nullptr, n),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_kernel_approx_set_data(handle, n, p, X.data(), n), da_status_success);
+
+    // Random Fourier features are only defined for the rbf kernel
+    EXPECT_EQ(da_options_set_string(handle, "method", "rff"), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "kernel", "poly"), da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle),
+              da_status_incompatible_options);
+
+    // More landmarks than samples are reduced with a warning
+    EXPECT_EQ(da_options_set_string(handle, "method", "nystroem"), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", n + 3), da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle),
+              da_status_incompatible_options);
+    da_int nc = 0;
+    dim = 1;
+    EXPECT_EQ(da_handle_get_result_int(handle, da_kernel_approx_n_components, &dim, &nc),
+              da_status_success);
+    EXPECT_EQ(nc, n);
+
+    EXPECT_EQ(da_kernel_approx_transform(handle, n, p + 1, X.data(), n, Z.data(), n),
+              da_status_invalid_input);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n, p, X.data(), n, Z.data(), n - 1),
+              da_status_invalid_leading_dimension);
+    dim = n * n;
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_offsets, &dim, Z.data()),
+              da_status_unknown_query);
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_scores, &dim, Z.data()),
+              da_status_unknown_query);
+    da_handle_destroy(&handle);
+}
+
+TEST(KernelApproxTestPrecision, IncorrectHandlePrecision) {
+    double Xd[4] = {1, 2, 3, 4}, Zd[4];
+    float Xs[4] = {1, 2, 3, 4}, Zs[4];
+    da_handle handle_d = nullptr, handle_s = nullptr;
+    EXPECT_EQ(da_handle_init<double>(&handle_d, da_handle_kernel_approx),
+              da_status_success);
+    EXPECT_EQ(da_handle_init<float>(&handle_s, da_handle_kernel_approx),
+              da_status_success);
+
+    EXPECT_EQ(da_kernel_approx_set_data(handle_d, 2, 2, Xs, 2), da_status_wrong_type);
+    EXPECT_EQ(da_kernel_approx_set_data(handle_s, 2, 2, Xd, 2), da_status_wrong_type);
+    EXPECT_EQ(da_kernel_approx_compute<float>(handle_d), da_status_wrong_type);
+    EXPECT_EQ(da_kernel_approx_compute<double>(handle_s), da_status_wrong_type);
+    EXPECT_EQ(da_kernel_approx_transform(handle_d, 2, 2, Xs, 2, Zs, 2),
+              da_status_wrong_type);
+    EXPECT_EQ(da_kernel_approx_transform(handle_s, 2, 2, Xd, 2, Zd, 2),
+              da_status_wrong_type);
+
+    da_handle_destroy(&handle_d);
+    da_handle_destroy(&handle_s);
+}
@@ -33,6 +33,8 @@
 #include <iostream>
 #include <limits>
 #include <list>
+#include <random>
+#include <type_traits>
 
 // taken from  "da_kernel_utils.hpp"
 enum vectorization_type : da_int {
@@ -1202,4 +1204,177 @@ TYPED_TEST(KernelFunctionTest, IllegalArgsKernelFunction) {
     EXPECT_EQ(da_sigmoid_kernel(column_major, m, n, p, x.data(), ldx, dummy_y, ldy,
                                 invalid_d, ldd, gamma, coef0),
               da_status_invalid_pointer);
-}
\ No newline at end of file
+}
+template <typename T>
+void check_kernel_apply(da_order order, da_int m, da_int n, da_int k, da_int n_rhs,
+                        bool with_y) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    // Pad the leading dimensions to exercise the strided paths
+    da_int ldx = (order == column_major) ? m + 3 : k + 2;
+    da_int ldy = (order == column_major) ? n + 1 : k + 1;
+    da_int n_y = with_y ? n : m;
+    da_int ldv = (order == column_major) ? n_y + 2 : n_rhs + 1;
+    da_int ldu = (order == column_major) ? m + 1 : n_rhs + 2;
+    da_int ldd = (order == column_major) ? m : n_y;
+    std::vector<T> x((order == column_major) ? ldx * k : ldx * m);
+    std::vector<T> y((order == column_major) ? ldy * k : ldy * n);
+    std::vector<T> v((order == column_major) ? ldv * n_rhs : ldv * n_y);
+    for (auto &e : x)
+        e = (T)dist(gen);
+    for (auto &e : y)
+        e = (T)dist(gen);
+    for (auto &e : v)
+        e = (T)(dist(gen) - 0.5);
+    const T *y_ptr = with_y ? y.data() : nullptr;
+    T gamma = 0.5, coef0 = 1.0;
+    da_int degree = 3;
+
+    auto idx = [order](da_int i, da_int j, da_int ld) {
+        return (order == column_major) ? i + j * ld : i * ld + j;
+    };
+    std::vector<T> D(m * n_y), U_ref(m * n_rhs), U(m * n_rhs);
+    T tol = std::is_same_v<T, float> ? (T)1.0e-4 : (T)1.0e-10;
+    for (const std::string kernel : {"rbf", "linear", "polynomial", "sigmoid"}) {
+        std::vector<T> u_work((order == column_major) ? ldu * n_rhs : ldu * m, (T)-7.0);
+        da_status status_D, status_U;
+        if (kernel == "rbf") {
+            status_D = da_rbf_kernel(order, m, n, k, x.data(), ldx, y_ptr, ldy, D.data(),
+                                     ldd, gamma);
+            status_U = da_rbf_kernel_apply(order, m, n, k, x.data(), ldx, y_ptr, ldy,
+                                           n_rhs, v.data(), ldv, u_work.data(), ldu,
+                                           gamma);
+        } else if (kernel == "linear") {
+            status_D = da_linear_kernel(order, m, n, k, x.data(), ldx, y_ptr, ldy,
+                                        D.data(), ldd);
+            status_U = da_linear_kernel_apply(order, m, n, k, x.data(), ldx, y_ptr, ldy,
+                                              n_rhs, v.data(), ldv, u_work.data(), ldu);
+        } else if (kernel == "polynomial") {
+            status_D = da_polynomial_kernel(order, m, n, k, x.data(), ldx, y_ptr, ldy,
+                                            D.data(), ldd, gamma, degree, coef0);
+            status_U = da_polynomial_kernel_apply(order, m, n, k, x.data(), ldx, y_ptr,
+                                                  ldy, n_rhs, v.data(), ldv,
+                                                  u_work.data(), ldu, gamma, degree,
+                                                  coef0);
+        } else {
+            status_D = da_sigmoid_kernel(order, m, n, k, x.data(), ldx, y_ptr, ldy,
+                                         D.data(), ldd, gamma, coef0);
+            status_U = da_sigmoid_kernel_apply(order, m, n, k, x.data(), ldx, y_ptr, ldy,
+                                               n_rhs, v.data(), ldv, u_work.data(), ldu,
+                                               gamma, coef0);
+        }
+        ASSERT_EQ(status_D, da_status_success) << kernel;
+        ASSERT_EQ(status_U, da_status_success) << kernel;
+        // Reference: explicit kernel matrix times V
+        for (da_int i = 0; i < m; i++) {
+            for (da_int r = 0; r < n_rhs; r++) {
+                double sum = 0.0;
+                for (da_int j = 0; j < n_y; j++)
+                    sum += (double)D[idx(i, j, ldd)] * (double)v[idx(j, r, ldv)];
+                U_ref[i * n_rhs + r] = (T)sum;
+                U[i * n_rhs + r] = u_work[idx(i, r, ldu)];
+            }
+        }
+        for (da_int i = 0; i < m * n_rhs; i++) {
+            EXPECT_NEAR(U[i], U_ref[i], tol * (1 + std::abs(U_ref[i])))
+                << kernel << " entry " << i;
+        }
+        // Padding of U must be left untouched
+        if (order == column_major) {
+            for (da_int r = 0; r < n_rhs; r++)
+                EXPECT_EQ(u_work[m + r * ldu], (T)-7.0);
+        } else {
+            for (da_int i = 0; i < m; i++)
+                EXPECT_EQ(u_work[n_rhs + i * ldu], (T)-7.0);
+        }
+    }
+}
+
+TYPED_TEST(KernelFunctionTest, KernelApply) {
+    std::unordered_map<std::string, vectorization_type> isa_list;
+    isa_list = {{"scalar", vectorization_type::scalar},
+                {"avx2", vectorization_type::avx2},
+                {"avx512", vectorization_type::avx512}};
+    for (auto &isa : isa_list) {
+        EXPECT_EQ(da_debug_set("kf.isa", (isa.first).c_str()), da_status_success);
+        for (da_order order : {column_major, row_major}) {
+            // Several tiles in both directions, with remainders
+            check_kernel_apply<TypeParam>(order, 300, 270, 4, 3, true);
+            check_kernel_apply<TypeParam>(order, 300, 270, 4, 1, false);
+            // A single block of X with several blocks of Y split across threads
+            check_kernel_apply<TypeParam>(order, 20, 800, 3, 2, false);
+            // Single tile smaller than a SIMD vector
+            check_kernel_apply<TypeParam>(order, 5, 3, 2, 2, true);
+            check_kernel_apply<TypeParam>(order, 1, 1, 1, 1, false);
+        }
+    }
+}
+
+TYPED_TEST(KernelFunctionTest, IllegalArgsKernelApply) {
+    std::vector<double> x_d{0.27, 0.58, 0.67, 0.52, 0.93, 0.13, 0.09, 0.32, 0.72};
+    std::vector<TypeParam> x = convert_vector<double, TypeParam>(x_d);
+    std::vector<double> y_d{0.29, 0.02, 0.18, 0.83, 0.59, 0.0};
+    std::vector<TypeParam> y = convert_vector<double, TypeParam>(y_d);
+    da_int m = 3, n = 2, p = 3, ldx = 3, ldy = 2, n_rhs = 2, ldv = 2, ldu = 3;
+    TypeParam gamma = 0.5, coef0 = 2;
+    da_int degree = 2;
+    std::vector<TypeParam> v(n * n_rhs, 1), u(m * n_rhs, 0);
+    TypeParam *null_ptr = nullptr;
+
+    EXPECT_EQ(da_rbf_kernel_apply(column_major, m, n, p, x.data(), ldx, y.data(), ldy,
+                                  n_rhs, v.data(), ldv, u.data(), ldu, gamma),
+              da_status_success);
+    EXPECT_EQ(da_polynomial_kernel_apply(column_major, m, n, p, x.data(), ldx, y.data(),
+                                         ldy, n_rhs, v.data(), ldv, u.data(), ldu, gamma,
+                                         degree, coef0),
+              da_status_success);
+    // Illegal kernel parameters
+    EXPECT_EQ(da_rbf_kernel_apply(column_major, m, n, p, x.data(), ldx, y.data(), ldy,
+                                  n_rhs, v.data(), ldv, u.data(), ldu, -gamma),
+              da_status_invalid_input);
+    EXPECT_EQ(da_polynomial_kernel_apply(column_major, m, n, p, x.data(), ldx, y.data(),
+                                         ldy, n_rhs, v.data(), ldv, u.data(), ldu, gamma,
+                                         0, coef0),
+              da_status_invalid_input);
+    EXPECT_EQ(da_sigmoid_kernel_apply(column_major, m, n, p, x.data(), ldx, y.data(),
+                                      ldy, n_rhs, v.data(), ldv, u.data(), ldu, -gamma,
+                                      coef0),
+              da_status_invalid_input);
+    // Illegal dimensions
+    EXPECT_EQ(da_linear_kernel_apply(column_major, 0, n, p, x.data(), ldx, y.data(), ldy,
+                                     n_rhs, v.data(), ldv, u.data(), ldu),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(da_linear_kernel_apply(column_major, m, n, p, x.data(), ldx, y.data(), ldy,
+                                     0, v.data(), ldv, u.data(), ldu),
+              da_status_invalid_array_dimension);
+    // Illegal leading dimensions
+    EXPECT_EQ(da_linear_kernel_apply(column_major, m, n, p, x.data(), 2, y.data(), ldy,
+                                     n_rhs, v.data(), ldv, u.data(), ldu),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_linear_kernel_apply(column_major, m, n, p, x.data(), ldx, y.data(), ldy,
+                                     n_rhs, v.data(), 1, u.data(), ldu),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_linear_kernel_apply(column_major, m, n, p, x.data(), ldx, y.data(), ldy,
+                                     n_rhs, v.data(), ldv, u.data(), 2),
+              da_status_invalid_leading_dimension);
+    // With Y null, V must have m rows
+    EXPECT_EQ(da_linear_kernel_apply(column_major, m, n, p, x.data(), ldx, null_ptr, ldy,
+                                     n_rhs, v.data(), ldv, u.data(), ldu),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_linear_kernel_apply(row_major, m, n, p, x.data(), p, y.data(), p, n_rhs,
+                                     v.data(), 1, u.data(), n_rhs),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_linear_kernel_apply(row_major, m, n, p, x.data(), p, y.data(), p, n_rhs,
+                                     v.data(), n_rhs, u.data(), 1),
+              da_status_invalid_leading_dimension);
+    // Null pointers
+    EXPECT_EQ(da_linear_kernel_apply(column_major, m, n, p, null_ptr, ldx, y.data(), ldy,
+                                     n_rhs, v.data(), ldv, u.data(), ldu),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_linear_kernel_apply(column_major, m, n, p, x.data(), ldx, y.data(), ldy,
+                                     n_rhs, null_ptr, ldv, u.data(), ldu),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_linear_kernel_apply(column_major, m, n, p, x.data(), ldx, y.data(), ldy,
+                                     n_rhs, v.data(), ldv, null_ptr, ldu),
+              da_status_invalid_pointer);
+}
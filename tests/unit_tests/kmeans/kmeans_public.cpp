@@ -687,6 +687,87 @@ TYPED_TEST(KMeansTest, BadHandleTests) {
     da_handle_destroy(&handle);
 }
 
+TYPED_TEST(KMeansTest, ConcurrentInference) {
+    // Several threads share one trained handle, each with its own inference context;
+    // the results must match the serial handle-based calls
+    KMeansParamType<TypeParam> param;
+    Get3ClustersBaseData(param);
+
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kmeans), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_clusters", param.n_clusters),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "seed", param.seed), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "algorithm", "lloyd"), da_status_success);
+    EXPECT_EQ(da_kmeans_set_data(handle, param.n_samples, param.n_features,
+                                 param.A.data(), param.lda),
+              da_status_success);
+    ASSERT_EQ(da_kmeans_compute<TypeParam>(handle), da_status_success);
+
+    const da_int n_clusters = param.n_clusters, n_features = param.n_features;
+    const da_int n_chunks = 16, chunk = 37, n_total = n_chunks * chunk;
+    std::vector<TypeParam> Y(n_total * n_features);
+    for (da_int i = 0; i < (da_int)Y.size(); i++)
+        Y[i] = (TypeParam)(((i * 7919) % 613) / 153.0 - 2.0);
+
+    std::vector<da_int> labels_ref(n_total);
+    std::vector<TypeParam> trans_ref(n_total * n_clusters);
+    for (da_int c = 0; c < n_chunks; c++) {
+        const TypeParam *Yc = &Y[c * chunk];
+        EXPECT_EQ(da_kmeans_predict(handle, chunk, n_features, Yc, n_total,
+                                    &labels_ref[c * chunk]),
+                  da_status_success);
+        EXPECT_EQ(da_kmeans_transform(handle, chunk, n_features, Yc, n_total,
+                                      &trans_ref[c * chunk], n_total),
+                  da_status_success);
+    }
+
+    std::vector<da_int> labels(n_total, -1);
+    std::vector<TypeParam> trans(n_total * n_clusters, (TypeParam)-1);
+    std::vector<da_status> status(2 * n_chunks, da_status_internal_error);
+#pragma omp parallel for schedule(dynamic)
+    for (da_int c = 0; c < n_chunks; c++) {
+        da_inference_context ctx = nullptr;
+        if (da_inference_context_init(&ctx) != da_status_success)
+            continue;
+        const TypeParam *Yc = &Y[c * chunk];
+        status[2 * c] = da_kmeans_predict(handle, ctx, chunk, n_features, Yc, n_total,
+                                          &labels[c * chunk]);
+        status[2 * c + 1] = da_kmeans_transform(handle, ctx, chunk, n_features, Yc,
+                                                n_total, &trans[c * chunk], n_total);
+        da_inference_context_destroy(&ctx);
+    }
+    for (da_int c = 0; c < 2 * n_chunks; c++)
+        EXPECT_EQ(status[c], da_status_success);
+    EXPECT_ARR_EQ(n_total, labels, labels_ref, 1, 1, 0, 0);
+    EXPECT_ARR_NEAR(n_total * n_clusters, trans, trans_ref,
+                    100 * std::numeric_limits<TypeParam>::epsilon());
+
+    // Errors are reported in the context rather than in the handle
+    da_inference_context ctx = nullptr;
+    ASSERT_EQ(da_inference_context_init(&ctx), da_status_success);
+    EXPECT_EQ(da_kmeans_predict(handle, ctx, chunk, n_features + 1, Y.data(), n_total,
+                                labels.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_inference_context_print_error_message(ctx), da_status_success);
+    EXPECT_EQ(da_kmeans_predict(handle, (da_inference_context) nullptr, chunk,
+                                n_features, Y.data(), n_total, labels.data()),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_kmeans_transform((da_handle) nullptr, ctx, chunk, n_features,
+                                  Y.data(), n_total, trans.data(), n_total),
+              da_status_handle_not_initialized);
+    da_handle_destroy(&handle);
+
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_linmod), da_status_success);
+    EXPECT_EQ(da_kmeans_predict(handle, ctx, chunk, n_features, Y.data(), n_total,
+                                labels.data()),
+              da_status_invalid_handle_type);
+    da_handle_destroy(&handle);
+    da_inference_context_destroy(&ctx);
+    EXPECT_EQ(ctx, nullptr);
+    EXPECT_EQ(da_inference_context_init(nullptr), da_status_invalid_pointer);
+}
+
 TEST(KMeansTest, IncorrectHandlePrecision) {
     da_handle handle_d = nullptr;
     da_handle handle_s = nullptr;
@@ -715,6 +796,14 @@ TEST(KMeansTest, IncorrectHandlePrecision) {
     EXPECT_EQ(da_kmeans_predict_d(handle_s, 1, 1, &Ad, 1, &labels), da_status_wrong_type);
     EXPECT_EQ(da_kmeans_predict_s(handle_d, 1, 1, &As, 1, &labels), da_status_wrong_type);
 
+    da_inference_context ctx = nullptr;
+    EXPECT_EQ(da_inference_context_init(&ctx), da_status_success);
+    EXPECT_EQ(da_kmeans_predict_ctx_d(handle_s, ctx, 1, 1, &Ad, 1, &labels),
+              da_status_wrong_type);
+    EXPECT_EQ(da_kmeans_transform_ctx_s(handle_d, ctx, 1, 1, &As, 1, &As, 1),
+              da_status_wrong_type);
+    da_inference_context_destroy(&ctx);
+
     da_handle_destroy(&handle_d);
     da_handle_destroy(&handle_s);
 }
@@ -1334,3 +1423,136 @@ TYPED_TEST(KMeansTest, MaxIter1LabelsConsistentWithPredict) {
 
     da_handle_destroy(&handle);
 }
+
+TYPED_TEST(KMeansTest, SampleWeightsMatchReplicatedRows) {
+    using T = TypeParam;
+    // Integer sample weights must give the same clustering as replicating the rows
+    std::vector<T> A{1.0, 1.1, 0.5,  0.49, -2.0, -2.0, 0.53, 0.9,  1.2, -1.8,
+                     1.0, 1.2, -2.0, -1.9, 0.5,  0.51, -2.1, 0.95, 0.8, 0.6};
+    std::vector<T> weights{1.0, 3.0, 2.0, 1.0, 0.0, 2.0, 1.0, 4.0, 1.0, 2.0};
+    std::vector<T> C{1.0, 0.5, -2.0, 1.0, 0.5, -2.0};
+    da_int n_samples = 10, n_features = 2, n_clusters = 3;
+
+    da_int n_rep = 0;
+    for (auto w : weights)
+        n_rep += (da_int)w;
+    std::vector<T> A_rep(n_rep * n_features);
+    da_int k = 0;
+    for (da_int i = 0; i < n_samples; i++) {
+        for (da_int r = 0; r < (da_int)weights[i]; r++, k++) {
+            for (da_int j = 0; j < n_features; j++)
+                A_rep[k + j * n_rep] = A[i + j * n_samples];
+        }
+    }
+
+    for (std::string algorithm : {"lloyd", "elkan"}) {
+        std::vector<T> centres(n_clusters * n_features);
+        std::vector<T> centres_rep(n_clusters * n_features);
+        std::vector<T> rinfo(6), rinfo_rep(6);
+        da_int cdim = n_clusters * n_features, rdim = 6;
+        for (bool weighted : {true, false}) {
+            da_handle handle = nullptr;
+            EXPECT_EQ(da_handle_init<T>(&handle, da_handle_kmeans), da_status_success);
+            EXPECT_EQ(da_options_set_int(handle, "n_clusters", n_clusters),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_string(handle, "algorithm", algorithm.c_str()),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_string(handle, "initialization method", "supplied"),
+                      da_status_success);
+            if (weighted) {
+                EXPECT_EQ(da_kmeans_set_data(handle, n_samples, n_features, A.data(),
+                                             n_samples),
+                          da_status_success);
+                EXPECT_EQ(da_kmeans_set_sample_weights(handle, n_samples, weights.data()),
+                          da_status_success);
+            } else {
+                EXPECT_EQ(
+                    da_kmeans_set_data(handle, n_rep, n_features, A_rep.data(), n_rep),
+                    da_status_success);
+            }
+            EXPECT_EQ(da_kmeans_set_init_centres(handle, C.data(), n_clusters),
+                      da_status_success);
+            EXPECT_EQ(da_kmeans_compute<T>(handle), da_status_success);
+            EXPECT_EQ(da_handle_get_result(handle, da_kmeans_cluster_centres, &cdim,
+                                           weighted ? centres.data()
+                                                    : centres_rep.data()),
+                      da_status_success);
+            EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &rdim,
+                                           weighted ? rinfo.data() : rinfo_rep.data()),
+                      da_status_success);
+            da_handle_destroy(&handle);
+        }
+        T tol = std::is_same_v<T, float> ? (T)1.0e-4 : (T)1.0e-10;
+        EXPECT_ARR_NEAR(n_clusters * n_features, centres, centres_rep, tol);
+        EXPECT_NEAR(rinfo[4], rinfo_rep[4], tol);
+    }
+}
+
+TYPED_TEST(KMeansTest, SampleWeightsZeroWeightCluster) {
+    using T = TypeParam;
+    // A cluster whose members all have zero weight is empty and must keep its centre
+    std::vector<T> A{1.0, 1.1, 0.9, -2.0, -2.1, 5.0, 1.0, 0.9, 1.1, -2.0, -1.9, 5.0};
+    std::vector<T> weights{1.0, 2.0, 1.0, 1.0, 3.0, 0.0};
+    std::vector<T> C{1.0, -2.0, 5.0, 1.0, -2.0, 5.0};
+    da_int n_samples = 6, n_features = 2, n_clusters = 3;
+
+    for (std::string algorithm : {"lloyd", "elkan"}) {
+        std::vector<T> centres(n_clusters * n_features);
+        da_int cdim = n_clusters * n_features;
+        da_handle handle = nullptr;
+        EXPECT_EQ(da_handle_init<T>(&handle, da_handle_kmeans), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "n_clusters", n_clusters),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "algorithm", algorithm.c_str()),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "initialization method", "supplied"),
+                  da_status_success);
+        EXPECT_EQ(da_kmeans_set_data(handle, n_samples, n_features, A.data(), n_samples),
+                  da_status_success);
+        EXPECT_EQ(da_kmeans_set_sample_weights(handle, n_samples, weights.data()),
+                  da_status_success);
+        EXPECT_EQ(da_kmeans_set_init_centres(handle, C.data(), n_clusters),
+                  da_status_success);
+        EXPECT_EQ(da_kmeans_compute<T>(handle), da_status_success);
+        EXPECT_EQ(da_handle_get_result(handle, da_kmeans_cluster_centres, &cdim,
+                                       centres.data()),
+                  da_status_success);
+        // Centres are returned column-major: the third cluster is untouched
+        EXPECT_EQ(centres[2], (T)5.0);
+        EXPECT_EQ(centres[5], (T)5.0);
+        T tol = std::is_same_v<T, float> ? (T)1.0e-5 : (T)1.0e-12;
+        EXPECT_NEAR(centres[0], (T)1.025, tol);
+        EXPECT_NEAR(centres[3], (T)0.975, tol);
+        da_handle_destroy(&handle);
+    }
+}
+
+TYPED_TEST(KMeansTest, SampleWeightsErrorExits) {
+    using T = TypeParam;
+    std::vector<T> A{1.0, 2.0, 3.0, 4.0, 1.0, 2.0, 3.0, 4.0};
+    std::vector<T> weights{1.0, 1.0, 1.0, 1.0};
+    da_int n_samples = 4, n_features = 2;
+
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init<T>(&handle, da_handle_kmeans), da_status_success);
+    EXPECT_EQ(da_kmeans_set_sample_weights(handle, n_samples, weights.data()),
+              da_status_no_data);
+    EXPECT_EQ(da_kmeans_set_data(handle, n_samples, n_features, A.data(), n_samples),
+              da_status_success);
+    EXPECT_EQ(da_kmeans_set_sample_weights(handle, 3, weights.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_kmeans_set_sample_weights<T>(handle, n_samples, nullptr),
+              da_status_invalid_pointer);
+    weights[1] = -1.0;
+    EXPECT_EQ(da_kmeans_set_sample_weights(handle, n_samples, weights.data()),
+              da_status_invalid_input);
+    weights[1] = 1.0;
+    EXPECT_EQ(da_kmeans_set_sample_weights(handle, n_samples, weights.data()),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "algorithm", "macqueen"), da_status_success);
+    EXPECT_EQ(da_kmeans_compute<T>(handle), da_status_incompatible_options);
+    // Removing the weights allows MacQueen again
+    EXPECT_EQ(da_kmeans_set_sample_weights<T>(handle, 0, nullptr), da_status_success);
+    EXPECT_EQ(da_kmeans_compute<T>(handle), da_status_success);
+    da_handle_destroy(&handle);
+}
@@ -213,3 +213,52 @@ TEST(linmod_internal, eval_feature_matrix) {
         EXPECT_ARR_EQ(n + 1, vt, vt_exp, 1, 1, 0, 0);
     }
 }
+
+template <typename T> void check_softmax_kernels(bool weighted) {
+    using namespace TEST_ARCH;
+    // nsamples is not a multiple of the SIMD width to exercise the remainder loop
+    const da_int nsamples = 37, nclass = 5;
+    std::vector<T> Z(nsamples * nclass), y(nsamples), w(nsamples);
+    for (da_int i = 0; i < nsamples; i++) {
+        y[i] = T(i % nclass);
+        w[i] = T(1) + T(0.1) * T(i);
+        for (da_int k = 0; k < nclass; k++)
+            Z[i + k * nsamples] = T(3) * std::sin(T(1.3) * T(i) + T(0.7) * T(k));
+    }
+    const T *wp = weighted ? w.data() : nullptr;
+
+    // Reference values
+    std::vector<T> R(nsamples * nclass);
+    T loss_exp{0};
+    for (da_int i = 0; i < nsamples; i++) {
+        T zmax = Z[i];
+        for (da_int k = 1; k < nclass; k++)
+            zmax = std::max(zmax, Z[i + k * nsamples]);
+        T zsum{0};
+        for (da_int k = 0; k < nclass; k++)
+            zsum += std::exp(Z[i + k * nsamples] - zmax);
+        T wi = weighted ? w[i] : T(1);
+        loss_exp += wi * (zmax + std::log(zsum) - Z[i + (da_int)y[i] * nsamples]);
+        for (da_int k = 0; k < nclass; k++) {
+            T ind = (da_int)y[i] == k ? T(1) : T(0);
+            T pk = std::exp(Z[i + k * nsamples] - zmax) / zsum;
+            R[i + k * nsamples] = wi * (pk - ind);
+        }
+    }
+
+    std::vector<T> maxexp(nsamples), sumexp(nsamples);
+    T loss = da_linmod::softmax_logloss(nsamples, nclass, Z.data(), nsamples, y.data(),
+                                        wp, maxexp.data(), sumexp.data());
+    const T tol = std::is_same_v<T, double> ? T(1e-12) : T(1e-5);
+    EXPECT_NEAR(loss, loss_exp, tol * loss_exp);
+    da_linmod::softmax_residual(nsamples, nclass, Z.data(), nsamples, y.data(), wp,
+                                maxexp.data(), sumexp.data());
+    EXPECT_ARR_NEAR(nsamples * nclass, Z, R, tol);
+}
+
+TEST(linmod_internal, softmaxKernels) {
+    for (bool weighted : {false, true}) {
+        check_softmax_kernels<double>(weighted);
+        check_softmax_kernels<float>(weighted);
+    }
+}
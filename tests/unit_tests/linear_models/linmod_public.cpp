@@ -30,6 +30,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include <cstring>
+#include <limits>
 
 namespace {
 
@@ -181,6 +182,412 @@ TYPED_TEST(linmod_public_test, MixedPrecisionIterativeRefinement) {
     }
 }
 
+/* Weighted fits with integer weights must match the unweighted fit on the data set
+ * where each row is replicated as many times as its weight. */
+TYPED_TEST(linmod_public_test, SampleWeightsMatchReplicatedRows) {
+    using T = TypeParam;
+    const da_int nsamples = 7, nfeat = 2;
+    std::vector<T> X{1, 2, 3, 4, 5, 6, 7, 2, 1, 4, 3, 6, 5, 9};
+    std::vector<T> y{1.5, 2.1, 2.9, 4.2, 4.8, 6.5, 7.1};
+    std::vector<T> w{1, 2, 0, 3, 1, 1, 2};
+
+    // Replicated (column-major) problem
+    std::vector<T> Xr, yr;
+    for (da_int j = 0; j < nfeat; j++)
+        for (da_int i = 0; i < nsamples; i++)
+            for (da_int r = 0; r < (da_int)w[i]; r++)
+                Xr.push_back(X[j * nsamples + i]);
+    for (da_int i = 0; i < nsamples; i++)
+        for (da_int r = 0; r < (da_int)w[i]; r++)
+            yr.push_back(y[i]);
+    const da_int nrep = (da_int)yr.size();
+
+    std::vector<std::string> solvers{"cholesky", "svd", "qr", "coord", "cg"};
+#ifndef NO_FORTRAN
+    solvers.push_back("lbfgs");
+#endif
+    const T tol = std::is_same_v<T, double> ? T(1e-5) : T(5e-2);
+    for (auto &solver : solvers) {
+        for (da_int intercept : {0, 1}) {
+            for (auto [lambda, alpha] : {std::pair<T, T>{0, 0}, {0.5, 0}, {0.2, 1}}) {
+                if (solver == "qr" && lambda != T(0))
+                    continue;
+                // Only coordinate descent handles the 1-norm penalty
+                if (solver != "coord" && alpha != T(0))
+                    continue;
+                da_int ncoef = nfeat + intercept;
+                std::vector<T> coef_w(ncoef), coef_r(ncoef);
+                for (da_int pass = 0; pass < 2; pass++) {
+                    da_handle handle = nullptr;
+                    ASSERT_EQ(da_handle_init<T>(&handle, da_handle_linmod),
+                              da_status_success);
+                    EXPECT_EQ(da_linmod_select_model<T>(handle, linmod_model_mse),
+                              da_status_success);
+                    EXPECT_EQ(da_options_set(handle, "optim method", solver.c_str()),
+                              da_status_success);
+                    EXPECT_EQ(da_options_set(handle, "intercept", intercept),
+                              da_status_success);
+                    EXPECT_EQ(da_options_set(handle, "lambda", lambda),
+                              da_status_success);
+                    EXPECT_EQ(da_options_set(handle, "alpha", alpha), da_status_success);
+                    // L-BFGS-B stops short on the uncentered replicated problem with an
+                    // intercept, so let it fit the intercept by centering as well
+                    if (solver == "lbfgs" && intercept)
+                        EXPECT_EQ(da_options_set(handle, "scaling", "centering"),
+                                  da_status_success);
+                    EXPECT_EQ(da_options_set(handle, "optim convergence tol", T(1e-7)),
+                              da_status_success);
+                    EXPECT_EQ(da_options_set(handle, "optim dual gap tol", T(1e-7)),
+                              da_status_success);
+                    if (pass == 0) {
+                        EXPECT_EQ(da_linmod_define_features(handle, nsamples, nfeat,
+                                                            X.data(), nsamples, y.data()),
+                                  da_status_success);
+                        EXPECT_EQ(da_linmod_define_sample_weights(handle, nsamples,
+                                                                  w.data()),
+                                  da_status_success);
+                    } else {
+                        EXPECT_EQ(da_linmod_define_features(handle, nrep, nfeat,
+                                                            Xr.data(), nrep, yr.data()),
+                                  da_status_success);
+                    }
+                    EXPECT_EQ(da_linmod_fit<T>(handle), da_status_success)
+                        << solver << " intercept=" << intercept;
+                    da_int nc = ncoef;
+                    T *coef = pass == 0 ? coef_w.data() : coef_r.data();
+                    EXPECT_EQ(da_handle_get_result(handle, da_result::da_linmod_coef,
+                                                   &nc, coef),
+                              da_status_success);
+                    da_handle_destroy(&handle);
+                }
+                EXPECT_ARR_NEAR(ncoef, coef_w, coef_r, tol)
+                    << "solver=" << solver << " intercept=" << intercept
+                    << " lambda=" << lambda << " alpha=" << alpha;
+            }
+        }
+    }
+}
+
+#ifndef NO_FORTRAN
+TYPED_TEST(linmod_public_test, SampleWeightsLogistic) {
+    using T = TypeParam;
+    const da_int nsamples = 8, nfeat = 2;
+    std::vector<T> X{1, 2, 3, 4, 5, 6, 7, 8, 2, 1, 4, 3, 6, 5, 9, 7};
+    std::vector<T> y{0, 0, 1, 0, 1, 1, 0, 1};
+    std::vector<T> w{1, 2, 1, 3, 1, 2, 1, 1};
+    std::vector<T> Xr, yr;
+    for (da_int j = 0; j < nfeat; j++)
+        for (da_int i = 0; i < nsamples; i++)
+            for (da_int r = 0; r < (da_int)w[i]; r++)
+                Xr.push_back(X[j * nsamples + i]);
+    for (da_int i = 0; i < nsamples; i++)
+        for (da_int r = 0; r < (da_int)w[i]; r++)
+            yr.push_back(y[i]);
+    const da_int nrep = (da_int)yr.size();
+    const da_int ncoef = nfeat + 1;
+    std::vector<T> coef_w(ncoef), coef_r(ncoef);
+    const T tol = std::is_same_v<T, double> ? T(1e-3) : T(5e-2);
+
+    for (T lambda : {T(0), T(0.5)}) {
+        for (da_int pass = 0; pass < 2; pass++) {
+            da_handle handle = nullptr;
+            ASSERT_EQ(da_handle_init<T>(&handle, da_handle_linmod), da_status_success);
+            EXPECT_EQ(da_linmod_select_model<T>(handle, linmod_model_logistic),
+                      da_status_success);
+            EXPECT_EQ(da_options_set(handle, "intercept", (da_int)1), da_status_success);
+            EXPECT_EQ(da_options_set(handle, "lambda", lambda), da_status_success);
+            EXPECT_EQ(da_options_set(handle, "optim convergence tol", T(1e-8)),
+                      da_status_success);
+            if (pass == 0) {
+                EXPECT_EQ(da_linmod_define_features(handle, nsamples, nfeat, X.data(),
+                                                    nsamples, y.data()),
+                          da_status_success);
+                EXPECT_EQ(da_linmod_define_sample_weights(handle, nsamples, w.data()),
+                          da_status_success);
+            } else {
+                EXPECT_EQ(da_linmod_define_features(handle, nrep, nfeat, Xr.data(), nrep,
+                                                    yr.data()),
+                          da_status_success);
+            }
+            EXPECT_EQ(da_linmod_fit<T>(handle), da_status_success);
+            da_int nc = ncoef;
+            T *coef = pass == 0 ? coef_w.data() : coef_r.data();
+            EXPECT_EQ(da_handle_get_result(handle, da_result::da_linmod_coef, &nc, coef),
+                      da_status_success);
+            da_handle_destroy(&handle);
+        }
+        EXPECT_ARR_NEAR(ncoef, coef_w, coef_r, tol) << "lambda=" << lambda;
+    }
+}
+#endif
+
+TYPED_TEST(linmod_public_test, ConcurrentEvaluate) {
+    // Evaluate one fitted model from several threads, each with its own inference
+    // context, and compare with the handle-based evaluation
+    using T = TypeParam;
+    const da_int nsamples = 7, nfeat = 2;
+    std::vector<T> X{1, 2, 3, 4, 5, 6, 7, 2, 1, 4, 3, 6, 5, 9};
+    std::vector<T> y{1.5, 2.1, 2.9, 4.2, 4.8, 6.5, 7.1};
+
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<T>(&handle, da_handle_linmod), da_status_success);
+    EXPECT_EQ(da_linmod_select_model<T>(handle, linmod_model_mse), da_status_success);
+    EXPECT_EQ(da_options_set(handle, "intercept", (da_int)1), da_status_success);
+    EXPECT_EQ(da_options_set(handle, "optim method", "cholesky"), da_status_success);
+    EXPECT_EQ(da_linmod_define_features(handle, nsamples, nfeat, X.data(), nsamples,
+                                        y.data()),
+              da_status_success);
+    ASSERT_EQ(da_linmod_fit<T>(handle), da_status_success);
+
+    const da_int n_chunks = 12, chunk = 25, n_total = n_chunks * chunk;
+    std::vector<T> Xe(n_total * nfeat), ye(n_total);
+    for (da_int i = 0; i < n_total * nfeat; i++)
+        Xe[i] = T((i * 37) % 101) / T(10);
+    for (da_int i = 0; i < n_total; i++)
+        ye[i] = T(i % 13);
+
+    std::vector<T> pred_ref(n_total), loss_ref(n_chunks);
+    for (da_int c = 0; c < n_chunks; c++)
+        EXPECT_EQ(da_linmod_evaluate_model(handle, chunk, nfeat, &Xe[c * chunk], n_total,
+                                           &pred_ref[c * chunk], &ye[c * chunk],
+                                           &loss_ref[c]),
+                  da_status_success);
+
+    std::vector<T> pred(n_total, T(-1)), loss(n_chunks, T(-1));
+    std::vector<da_status> status(n_chunks, da_status_internal_error);
+#pragma omp parallel for schedule(dynamic)
+    for (da_int c = 0; c < n_chunks; c++) {
+        da_inference_context ctx = nullptr;
+        if (da_inference_context_init(&ctx) != da_status_success)
+            continue;
+        status[c] = da_linmod_evaluate_model(handle, ctx, chunk, nfeat, &Xe[c * chunk],
+                                             n_total, &pred[c * chunk], &ye[c * chunk],
+                                             &loss[c]);
+        da_inference_context_destroy(&ctx);
+    }
+    for (da_int c = 0; c < n_chunks; c++)
+        EXPECT_EQ(status[c], da_status_success);
+    EXPECT_ARR_NEAR(n_total, pred, pred_ref, 0);
+    EXPECT_ARR_NEAR(n_chunks, loss, loss_ref, 0);
+
+    // Errors go to the context
+    da_inference_context ctx = nullptr;
+    ASSERT_EQ(da_inference_context_init(&ctx), da_status_success);
+    EXPECT_EQ(da_linmod_evaluate_model(handle, ctx, chunk, nfeat + 1, Xe.data(), n_total,
+                                       pred.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_linmod_evaluate_model(handle, ctx, chunk, nfeat, Xe.data(), n_total,
+                                       pred.data(), ye.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_linmod_evaluate_model(handle, (da_inference_context) nullptr, chunk,
+                                       nfeat, Xe.data(), n_total, pred.data()),
+              da_status_invalid_pointer);
+    da_handle_destroy(&handle);
+    da_inference_context_destroy(&ctx);
+}
+
+#ifndef NO_FORTRAN
+TYPED_TEST(linmod_public_test, ConcurrentEvaluateMultinomial) {
+    // Multinomial logistic evaluation uses the context workspace for its scores
+    using T = TypeParam;
+    const da_int nsamples = 9, nfeat = 2;
+    std::vector<T> X{1, 1.2, 0.8, 5, 5.1, 4.9, 1, 1.1, 0.9, 1, 0.9, 1.1, 1, 1.2, 0.8,
+                     5, 5.2, 4.8};
+    std::vector<T> y{0, 0, 0, 1, 1, 1, 2, 2, 2};
+    const T tol = 10 * std::numeric_limits<T>::epsilon();
+
+    for (const char *constraint : {"rsc", "ssc"}) {
+        da_handle handle = nullptr;
+        ASSERT_EQ(da_handle_init<T>(&handle, da_handle_linmod), da_status_success);
+        EXPECT_EQ(da_linmod_select_model<T>(handle, linmod_model_logistic),
+                  da_status_success);
+        EXPECT_EQ(da_options_set(handle, "intercept", (da_int)1), da_status_success);
+        EXPECT_EQ(da_options_set(handle, "logistic constraint", constraint),
+                  da_status_success);
+        EXPECT_EQ(da_linmod_define_features(handle, nsamples, nfeat, X.data(), nsamples,
+                                            y.data()),
+                  da_status_success);
+        ASSERT_EQ(da_linmod_fit<T>(handle), da_status_success);
+
+        std::vector<T> pred_ref(nsamples);
+        EXPECT_EQ(da_linmod_evaluate_model(handle, nsamples, nfeat, X.data(), nsamples,
+                                           pred_ref.data()),
+                  da_status_success);
+
+        const da_int n_threads = 8;
+        std::vector<T> pred(n_threads * nsamples, T(-1));
+        std::vector<da_status> status(n_threads, da_status_internal_error);
+#pragma omp parallel for
+        for (da_int t = 0; t < n_threads; t++) {
+            da_inference_context ctx = nullptr;
+            if (da_inference_context_init(&ctx) != da_status_success)
+                continue;
+            // Reuse the context so its workspace is recycled between calls
+            for (da_int rep = 0; rep < 3; rep++)
+                status[t] =
+                    da_linmod_evaluate_model(handle, ctx, nsamples, nfeat, X.data(),
+                                             nsamples, &pred[t * nsamples]);
+            da_inference_context_destroy(&ctx);
+        }
+        for (da_int t = 0; t < n_threads; t++) {
+            EXPECT_EQ(status[t], da_status_success);
+            for (da_int i = 0; i < nsamples; i++)
+                EXPECT_NEAR(pred[t * nsamples + i], pred_ref[i], tol);
+        }
+        da_handle_destroy(&handle);
+    }
+}
+#endif
+
+TEST(linmod, sampleWeightsInvalidInput) {
+    const da_int m = 5, n = 2;
+    double Ad[10] = {1, 2, 3, 4, 5, 1, 3, 5, 1, 1};
+    double bd[5] = {1, 1, 1, 1, 1};
+    double wd[5] = {1, 1, 1, 1, 1};
+    double wzero[5] = {0, 0, 0, 0, 0};
+    double wneg[5] = {1, -1, 1, 1, 1};
+    float ws[5] = {1, 1, 1, 1, 1};
+
+    da_handle handle_d = nullptr;
+    EXPECT_EQ(da_linmod_define_sample_weights_d(handle_d, m, wd),
+              da_status_handle_not_initialized);
+    EXPECT_EQ(da_handle_init_d(&handle_d, da_handle_linmod), da_status_success);
+    EXPECT_EQ(da_linmod_select_model_d(handle_d, linmod_model_mse), da_status_success);
+    // No data yet
+    EXPECT_EQ(da_linmod_define_sample_weights_d(handle_d, m, wd), da_status_no_data);
+    EXPECT_EQ(da_linmod_define_features_d(handle_d, m, n, Ad, m, bd), da_status_success);
+    EXPECT_EQ(da_linmod_define_sample_weights_s(handle_d, m, ws), da_status_wrong_type);
+    EXPECT_EQ(da_linmod_define_sample_weights_d(handle_d, m - 1, wd),
+              da_status_invalid_input);
+    EXPECT_EQ(da_linmod_define_sample_weights_d(handle_d, m, nullptr),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_linmod_define_sample_weights_d(handle_d, m, wzero),
+              da_status_invalid_input);
+    EXPECT_EQ(da_linmod_define_sample_weights_d(handle_d, m, wneg),
+              da_status_invalid_input);
+    EXPECT_EQ(da_linmod_define_sample_weights_d(handle_d, m, wd), da_status_success);
+    // Remove the weights
+    EXPECT_EQ(da_linmod_define_sample_weights_d(handle_d, 0, nullptr), da_status_success);
+    EXPECT_EQ(da_linmod_fit_d(handle_d), da_status_success);
+
+    da_handle_destroy(&handle_d);
+}
+
+TYPED_TEST(linmod_public_test, StreamFeatures) {
+    // Streaming the data in row blocks must give the same model as the in-memory fit
+    using T = TypeParam;
+    const da_int nsamples = 60, nfeat = 3;
+    std::vector<T> X(nsamples * nfeat), y(nsamples);
+    for (da_int i = 0; i < nsamples; i++) {
+        for (da_int j = 0; j < nfeat; j++)
+            X[i + j * nsamples] = std::sin(T(i * (j + 1))) + T(j);
+        y[i] = T(2) + X[i] - T(0.5) * X[i + nsamples] + T(0.25) * X[i + 2 * nsamples] +
+               T(0.1) * std::cos(T(i));
+    }
+    // Blocks shorter and taller than the triangular factor
+    std::vector<da_int> blocks{2, 5, 40, 13};
+    const T tol = std::is_same_v<T, double> ? T(1e-10) : T(1e-4);
+
+    for (std::string order : {"column-major", "row-major"}) {
+        std::vector<T> Xo(X);
+        if (order == "row-major")
+            for (da_int i = 0; i < nsamples; i++)
+                for (da_int j = 0; j < nfeat; j++)
+                    Xo[i * nfeat + j] = X[i + j * nsamples];
+        for (da_int intercept : {0, 1}) {
+            for (T lambda : {T(0), T(0.5)}) {
+                da_int ncoef = nfeat + intercept;
+                std::vector<T> coef_m(ncoef), coef_s(ncoef);
+                std::vector<T> pred_m(nsamples), pred_s(nsamples);
+                for (da_int pass = 0; pass < 2; pass++) {
+                    da_handle handle = nullptr;
+                    ASSERT_EQ(da_handle_init<T>(&handle, da_handle_linmod),
+                              da_status_success);
+                    EXPECT_EQ(da_linmod_select_model<T>(handle, linmod_model_mse),
+                              da_status_success);
+                    EXPECT_EQ(da_options_set(handle, "optim method", "cholesky"),
+                              da_status_success);
+                    EXPECT_EQ(da_options_set(handle, "storage order", order.c_str()),
+                              da_status_success);
+                    EXPECT_EQ(da_options_set(handle, "intercept", intercept),
+                              da_status_success);
+                    EXPECT_EQ(da_options_set(handle, "lambda", lambda),
+                              da_status_success);
+                    da_int ld = order == "row-major" ? nfeat : nsamples;
+                    if (pass == 0) {
+                        EXPECT_EQ(da_linmod_define_features(handle, nsamples, nfeat,
+                                                            Xo.data(), ld, y.data()),
+                                  da_status_success);
+                    } else {
+                        da_int row = 0;
+                        for (da_int nb : blocks) {
+                            const T *Xb = order == "row-major" ? &Xo[row * nfeat]
+                                                               : &Xo[row];
+                            EXPECT_EQ(da_linmod_stream_features(handle, nb, nfeat, Xb,
+                                                                ld, &y[row]),
+                                      da_status_success);
+                            row += nb;
+                        }
+                    }
+                    EXPECT_EQ(da_linmod_fit<T>(handle), da_status_success);
+                    da_int nc = ncoef;
+                    T *coef = pass == 0 ? coef_m.data() : coef_s.data();
+                    EXPECT_EQ(da_handle_get_result(handle, da_result::da_linmod_coef,
+                                                   &nc, coef),
+                              da_status_success);
+                    T *pred = pass == 0 ? pred_m.data() : pred_s.data();
+                    EXPECT_EQ(da_linmod_evaluate_model(handle, nsamples, nfeat,
+                                                       Xo.data(), ld, pred),
+                              da_status_success);
+                    da_handle_destroy(&handle);
+                }
+                EXPECT_ARR_NEAR(ncoef, coef_m, coef_s, tol)
+                    << order << " intercept=" << intercept << " lambda=" << lambda;
+                EXPECT_ARR_NEAR(nsamples, pred_m, pred_s, tol);
+            }
+        }
+    }
+}
+
+TEST(linmod, streamFeaturesInvalidInput) {
+    const da_int m = 5, n = 2;
+    double Ad[10] = {1, 2, 3, 4, 5, 1, 3, 5, 1, 1};
+    double bd[5] = {1, 2, 1, 3, 1};
+    float As[10] = {1, 2, 3, 4, 5, 1, 3, 5, 1, 1};
+    float bs[5] = {1, 2, 1, 3, 1};
+
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_linmod_stream_features_d(handle, m, n, Ad, m, bd),
+              da_status_handle_not_initialized);
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_linmod), da_status_success);
+    EXPECT_EQ(da_linmod_stream_features_s(handle, m, n, As, m, bs), da_status_wrong_type);
+    EXPECT_EQ(da_linmod_select_model_d(handle, linmod_model_logistic), da_status_success);
+    EXPECT_EQ(da_linmod_stream_features_d(handle, m, n, Ad, m, bd),
+              da_status_incompatible_options);
+    EXPECT_EQ(da_linmod_select_model_d(handle, linmod_model_mse), da_status_success);
+    EXPECT_EQ(da_linmod_stream_features_d(handle, 0, n, Ad, m, bd),
+              da_status_invalid_input);
+    EXPECT_EQ(da_linmod_stream_features_d(handle, m, n, Ad, m - 1, bd),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_linmod_stream_features_d(handle, m, n, nullptr, m, bd),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_linmod_fit_d(handle), da_status_no_data);
+    EXPECT_EQ(da_linmod_stream_features_d(handle, m, n, Ad, m, bd), da_status_success);
+    // All blocks must have the same number of features
+    EXPECT_EQ(da_linmod_stream_features_d(handle, m, n - 1, Ad, m, bd),
+              da_status_invalid_input);
+    EXPECT_EQ(da_options_set(handle, "lambda", 1.0), da_status_success);
+    EXPECT_EQ(da_options_set(handle, "alpha", 0.5), da_status_success);
+    EXPECT_EQ(da_linmod_fit_d(handle), da_status_incompatible_options);
+    EXPECT_EQ(da_options_set(handle, "alpha", 0.0), da_status_success);
+    EXPECT_EQ(da_options_set(handle, "scaling", "standardize"), da_status_success);
+    EXPECT_EQ(da_linmod_fit_d(handle), da_status_incompatible_options);
+    EXPECT_EQ(da_options_set(handle, "scaling", "centering"), da_status_success);
+    EXPECT_EQ(da_linmod_fit_d(handle), da_status_success);
+
+    da_handle_destroy(&handle);
+}
+
 TEST(linmod, mixedPrecisionErrors) {
     // problem data
     da_int n = 4;
@@ -846,3 +846,191 @@ TYPED_TEST(PairwiseDistanceTest, ErrorExits) {
               da_status_invalid_leading_dimension)
         << ErrorExits_print("ldd");
 }
+
+// Compare the pairwise distance reductions against the full distance matrix
+template <typename T>
+void check_pairwise_reductions(da_order order, da_int m, da_int n, da_int k,
+                               da_metric metric, bool with_y) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<T> dist_gen(-1.0, 1.0);
+    if (!with_y)
+        n = m;
+    da_int ldx = (order == column_major) ? m + 2 : k + 1;
+    da_int ldy = (order == column_major) ? n + 3 : k + 2;
+    da_int x_size = (order == column_major) ? ldx * k : ldx * m;
+    da_int y_size = (order == column_major) ? ldy * k : ldy * n;
+    std::vector<T> X(x_size), Y(y_size);
+    for (auto &x : X)
+        x = dist_gen(gen);
+    for (auto &y : Y)
+        y = dist_gen(gen);
+    const T *Y_ptr = with_y ? Y.data() : nullptr;
+    da_int ldy_ref = with_y ? ldy : ldx;
+    T p = 1.5;
+    T tol = std::sqrt(std::numeric_limits<T>::epsilon()) * 10;
+    std::string name = "m = " + std::to_string(m) + ", n = " + std::to_string(n) +
+                       ", metric = " + std::to_string(metric) +
+                       ", order = " + std::to_string(order);
+
+    // Reference distances, stored row by row
+    da_int ldd = (order == column_major) ? m : n;
+    std::vector<T> D(m * n);
+    ASSERT_EQ(da_pairwise_distances<T>(order, m, n, k, X.data(), ldx, Y_ptr, ldy_ref,
+                                       D.data(), ldd, p, metric),
+              da_status_success);
+    auto D_ij = [&](da_int i, da_int j) {
+        T d = (order == column_major) ? D[i + j * m] : D[i * n + j];
+        if (metric == da_sqeuclidean_gemm)
+            d = std::max(d, (T)0);
+        return d;
+    };
+    bool largest = (metric == da_inner_product);
+
+    da_int n_neigh = std::min(n, (da_int)5);
+    std::vector<da_int> ind(m * n_neigh);
+    std::vector<T> dist(m * n_neigh);
+    ASSERT_EQ(da_pairwise_distances_argkmin<T>(order, m, n, k, X.data(), ldx, Y_ptr,
+                                               ldy_ref, n_neigh, ind.data(), dist.data(),
+                                               p, metric),
+              da_status_success)
+        << name;
+    std::vector<da_int> ind1(m);
+    std::vector<T> dist1(m);
+    ASSERT_EQ(da_pairwise_distances_argmin<T>(order, m, n, k, X.data(), ldx, Y_ptr,
+                                              ldy_ref, ind1.data(), dist1.data(), p,
+                                              metric),
+              da_status_success)
+        << name;
+    // The argmin can also be computed without the distances
+    std::vector<da_int> ind1_nodist(m);
+    ASSERT_EQ(da_pairwise_distances_argmin<T>(order, m, n, k, X.data(), ldx, Y_ptr,
+                                              ldy_ref, ind1_nodist.data(), nullptr, p,
+                                              metric),
+              da_status_success)
+        << name;
+
+    // Pick a radius between two distances from the first row so that no distance is
+    // close to it
+    std::vector<T> row0(n);
+    for (da_int j = 0; j < n; j++)
+        row0[j] = D_ij(0, j);
+    std::sort(row0.begin(), row0.end());
+    T radius = (n > 1) ? (row0[(n - 1) / 2] + row0[(n - 1) / 2 + 1]) / 2 : row0[0] + 1;
+    std::vector<da_int> counts(m);
+    ASSERT_EQ(da_pairwise_distances_radius_count<T>(order, m, n, k, X.data(), ldx, Y_ptr,
+                                                    ldy_ref, radius, counts.data(), p,
+                                                    metric),
+              da_status_success)
+        << name;
+
+    std::vector<T> row(n);
+    for (da_int i = 0; i < m; i++) {
+        for (da_int j = 0; j < n; j++)
+            row[j] = D_ij(i, j);
+        if (largest)
+            std::sort(row.begin(), row.end(), std::greater<T>());
+        else
+            std::sort(row.begin(), row.end());
+        for (da_int r = 0; r < n_neigh; r++) {
+            da_int idx = (order == column_major) ? i + r * m : i * n_neigh + r;
+            ASSERT_GE(ind[idx], 0) << name;
+            ASSERT_LT(ind[idx], n) << name;
+            // The distances are sorted and are those of the returned indices
+            EXPECT_NEAR(dist[idx], row[r], tol) << name << ", i = " << i;
+            EXPECT_NEAR(dist[idx], D_ij(i, ind[idx]), tol) << name << ", i = " << i;
+        }
+        EXPECT_NEAR(dist1[i], row[0], tol) << name << ", i = " << i;
+        EXPECT_NEAR(D_ij(i, ind1[i]), row[0], tol) << name << ", i = " << i;
+        EXPECT_EQ(ind1[i], ind1_nodist[i]) << name << ", i = " << i;
+
+        da_int count_ref = 0;
+        for (da_int j = 0; j < n; j++)
+            count_ref += largest ? (D_ij(i, j) >= radius) : (D_ij(i, j) <= radius);
+        if (i == 0)
+            EXPECT_EQ(counts[i], count_ref) << name;
+        else
+            EXPECT_NEAR(counts[i], count_ref, 1) << name << ", i = " << i;
+    }
+}
+
+TYPED_TEST(PairwiseDistanceTest, Reductions) {
+    for (auto &[metric_name, metric] : MetricExactResultsType) {
+        for (auto order : {column_major, row_major}) {
+            check_pairwise_reductions<TypeParam>(order, 30, 17, 4, metric, true);
+            check_pairwise_reductions<TypeParam>(order, 25, 0, 3, metric, false);
+            check_pairwise_reductions<TypeParam>(order, 1, 1, 2, metric, true);
+            check_pairwise_reductions<TypeParam>(order, 3, 2, 1, metric, true);
+        }
+    }
+    // Several blocks of X and Y
+    for (auto order : {column_major, row_major}) {
+        check_pairwise_reductions<TypeParam>(order, 600, 1100, 6, da_euclidean, true);
+        check_pairwise_reductions<TypeParam>(order, 530, 0, 5, da_sqeuclidean_gemm,
+                                             false);
+        check_pairwise_reductions<TypeParam>(order, 300, 700, 3, da_inner_product, true);
+    }
+}
+
+TYPED_TEST(PairwiseDistanceTest, ReductionsErrorExits) {
+    std::vector<TypeParam> X(4, 1.0), Y(4, 1.0), dist(4);
+    std::vector<da_int> ind(4), counts(4);
+    TypeParam p = 2.0, radius = 1.0;
+    da_metric metric = da_euclidean;
+    EXPECT_EQ(da_pairwise_distances_argkmin<TypeParam>(column_major, 0, 2, 2, X.data(), 2,
+                                                       Y.data(), 2, 1, ind.data(),
+                                                       dist.data(), p, metric),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(da_pairwise_distances_argkmin<TypeParam>(column_major, 2, 2, 0, X.data(), 2,
+                                                       Y.data(), 2, 1, ind.data(),
+                                                       dist.data(), p, metric),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(da_pairwise_distances_argkmin<TypeParam>(column_major, 2, 0, 2, X.data(), 2,
+                                                       Y.data(), 2, 1, ind.data(),
+                                                       dist.data(), p, metric),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(da_pairwise_distances_argkmin<TypeParam>(column_major, 2, 2, 2, X.data(), 1,
+                                                       Y.data(), 2, 1, ind.data(),
+                                                       dist.data(), p, metric),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_pairwise_distances_argkmin<TypeParam>(row_major, 2, 2, 2, X.data(), 2,
+                                                       Y.data(), 1, 1, ind.data(),
+                                                       dist.data(), p, metric),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_pairwise_distances_argkmin<TypeParam>(column_major, 2, 2, 2, nullptr, 2,
+                                                       Y.data(), 2, 1, ind.data(),
+                                                       dist.data(), p, metric),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_pairwise_distances_argkmin<TypeParam>(column_major, 2, 2, 2, X.data(), 2,
+                                                       Y.data(), 2, 1, nullptr,
+                                                       dist.data(), p, metric),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_pairwise_distances_argkmin<TypeParam>(column_major, 2, 2, 2, X.data(), 2,
+                                                       Y.data(), 2, 0, ind.data(),
+                                                       dist.data(), p, metric),
+              da_status_invalid_input);
+    EXPECT_EQ(da_pairwise_distances_argkmin<TypeParam>(column_major, 2, 2, 2, X.data(), 2,
+                                                       Y.data(), 2, 3, ind.data(),
+                                                       dist.data(), p, metric),
+              da_status_invalid_input);
+    EXPECT_EQ(da_pairwise_distances_argkmin<TypeParam>(column_major, 2, 2, 2, X.data(), 2,
+                                                       Y.data(), 2, 1, ind.data(),
+                                                       dist.data(), 0.0, da_minkowski),
+              da_status_invalid_input);
+    EXPECT_EQ(da_pairwise_distances_argkmin<TypeParam>(
+                  column_major, 2, 2, 2, X.data(), 2, Y.data(), 2, 1, ind.data(),
+                  dist.data(), p, (da_metric)100),
+              da_status_not_implemented);
+    EXPECT_EQ(da_pairwise_distances_argmin<TypeParam>(column_major, 2, 2, 2, X.data(), 2,
+                                                      Y.data(), 2, nullptr, dist.data(),
+                                                      p, metric),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_pairwise_distances_radius_count<TypeParam>(column_major, 2, 2, 2,
+                                                            X.data(), 1, Y.data(), 2,
+                                                            radius, counts.data(), p,
+                                                            metric),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_pairwise_distances_radius_count<TypeParam>(column_major, 2, 2, 2,
+                                                            X.data(), 2, Y.data(), 2,
+                                                            radius, nullptr, p, metric),
+              da_status_invalid_pointer);
+}
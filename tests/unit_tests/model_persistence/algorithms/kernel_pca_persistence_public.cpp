@@ -35,7 +35,10 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <limits>
 #include <string>
 #include <vector>
@@ -317,3 +320,27 @@ TEST_F(KernelPCASerializationErrorTest, ComputeAfterLoadSucceeds) {
     EXPECT_EQ(da_kernel_pca_compute_d(handle_load), da_status_success);
     da_handle_destroy(&handle_load);
 }
+
+TEST_F(KernelPCASerializationErrorTest, OldLayoutFails) {
+    // Models saved before the solver and Nystroem state were serialized (version 50301)
+    // have a different layout and must be rejected rather than misread
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init_d(&handle, da_handle_kernel_pca), da_status_success);
+    std::vector<double> X = {1.0, 2.0, 3.0, 2.0, 3.0, 4.0, 3.0, 4.0, 5.0};
+    ASSERT_EQ(da_kernel_pca_set_data_d(handle, 3, 3, X.data(), 3), da_status_success);
+    ASSERT_EQ(da_kernel_pca_compute_d(handle), da_status_success);
+    ASSERT_EQ(da_handle_save_model(handle, model_file.c_str()), da_status_success);
+    da_handle_destroy(&handle);
+
+    // The serialization version follows the header keyword and the da_int size
+    std::fstream fs(model_file, std::ios::in | std::ios::out | std::ios::binary);
+    ASSERT_TRUE(fs.good());
+    int64_t old_version = 50301;
+    fs.seekp(2 * sizeof(int64_t) + std::strlen("AOCLDA_STORED_MODEL"));
+    fs.write(reinterpret_cast<const char *>(&old_version), sizeof(old_version));
+    fs.close();
+
+    EXPECT_EQ(da_handle_load_model(&handle, model_file.c_str()),
+              da_status_version_mismatch);
+    da_handle_destroy(&handle);
+}
@@ -33,7 +33,10 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <limits>
 #include <string>
 #include <vector>
@@ -342,4 +345,68 @@ TEST_F(PCASerializationErrorTest, PrintModelMetadataFromFile) {
     EXPECT_NE(output.find("Header keyword:"), std::string::npos);
     EXPECT_NE(output.find("Serialization version:"), std::string::npos);
     EXPECT_NE(output.find("Saved AOCL-DA build version:"), std::string::npos);
-}
\ No newline at end of file
+}
+
+TEST_F(PCASerializationErrorTest, IncrementalFitResumesAfterLoad) {
+    // An incremental fit saved part way through and continued after loading should give
+    // the same model as an uninterrupted fit
+    da_int n = 6, p = 5;
+    std::vector<double> A = {2.0, 2.0, 3.0, 4.0, 4.0, 3.0, 2.0, 5.0, 2.0, 8.0,
+                             3.0, 2.0, 3.0, 4.0, 4.0, 3.0, 2.0, 1.0, 2.0, 8.0,
+                             4.0, 6.0, 9.0, 5.0, 4.0, 3.0, 1.0, 4.0, 2.0, 2.0};
+    da_int n_components = 2, dim = n_components * p;
+
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init_d(&handle, da_handle_pca), da_status_success);
+    ASSERT_EQ(da_options_set_int(handle, "n_components", n_components),
+              da_status_success);
+    ASSERT_EQ(da_pca_partial_fit_d(handle, 3, p, A.data(), n), da_status_success);
+    ASSERT_EQ(da_handle_save_model(handle, model_file.c_str()), da_status_success);
+    ASSERT_EQ(da_pca_partial_fit_d(handle, 3, p, &A[3], n), da_status_success);
+    std::vector<double> vt_ref(dim), means_ref(p), vt(dim), means(p);
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_vt, &dim, vt_ref.data()),
+              da_status_success);
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_column_means, &p, means_ref.data()),
+              da_status_success);
+    da_handle_destroy(&handle);
+
+    ASSERT_EQ(da_handle_load_model(&handle, model_file.c_str()), da_status_success);
+    ASSERT_EQ(da_pca_partial_fit_d(handle, 3, p, &A[3], n), da_status_success);
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_vt, &dim, vt.data()),
+              da_status_success);
+    EXPECT_EQ(da_handle_get_result(handle, da_pca_column_means, &p, means.data()),
+              da_status_success);
+    da_int dim_rinfo = 3;
+    std::vector<double> rinfo(3);
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim_rinfo, rinfo.data()),
+              da_status_success);
+    EXPECT_EQ(rinfo[0], (double)n);
+    da_handle_destroy(&handle);
+
+    EXPECT_ARR_EQ(dim, vt_ref.data(), vt.data(), 1, 1, 0, 0);
+    EXPECT_ARR_EQ(p, means_ref.data(), means.data(), 1, 1, 0, 0);
+}
+
+TEST_F(PCASerializationErrorTest, OldLayoutFails) {
+    // Models saved before the incremental fit state was serialized (version 50301) have
+    // a different layout and must be rejected rather than misread
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init_d(&handle, da_handle_pca), da_status_success);
+    std::vector<double> X = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    ASSERT_EQ(da_pca_set_data_d(handle, 3, 2, X.data(), 3), da_status_success);
+    ASSERT_EQ(da_pca_compute_d(handle), da_status_success);
+    ASSERT_EQ(da_handle_save_model(handle, model_file.c_str()), da_status_success);
+    da_handle_destroy(&handle);
+
+    // The serialization version follows the header keyword and the da_int size
+    std::fstream fs(model_file, std::ios::in | std::ios::out | std::ios::binary);
+    ASSERT_TRUE(fs.good());
+    int64_t old_version = 50301;
+    fs.seekp(2 * sizeof(int64_t) + std::strlen("AOCLDA_STORED_MODEL"));
+    fs.write(reinterpret_cast<const char *>(&old_version), sizeof(old_version));
+    fs.close();
+
+    EXPECT_EQ(da_handle_load_model(&handle, model_file.c_str()),
+              da_status_version_mismatch);
+    da_handle_destroy(&handle);
+}
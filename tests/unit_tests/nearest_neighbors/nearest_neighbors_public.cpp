@@ -28,6 +28,7 @@
 #include <iostream>
 #include <limits>
 #include <list>
+#include <random>
 #include <stdio.h>
 #include <string.h>
 
@@ -1357,6 +1358,188 @@ TYPED_TEST(NearestNeighborsTest, IncompatibleMetrics) {
     da_handle_destroy(&nn_handle);
 }
 
+// Reduced precision storage of the training data is only available with brute force
+TYPED_TEST(NearestNeighborsTest, StoragePrecisionIncompatibleOptions) {
+    NearestNeighborsParamType<TypeParam> param;
+    da_handle nn_handle = nullptr;
+    std::vector<TypeParam> X_train(param.n_samples * param.n_features, TypeParam(1));
+    std::vector<TypeParam> X_test(param.n_queries * param.n_features, TypeParam(1));
+    std::vector<da_int> ind(param.n_queries);
+
+    EXPECT_EQ(da_handle_init<TypeParam>(&nn_handle, da_handle_nn), da_status_success);
+    EXPECT_EQ(da_options_set_string(nn_handle, "algorithm", "kd tree"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(nn_handle, "storage precision", "half"),
+              da_status_success);
+    EXPECT_EQ(da_nn_set_data(nn_handle, param.n_samples, param.n_features, X_train.data(),
+                             param.ldx_train),
+              da_status_incompatible_options);
+
+    // Requesting it after the tree has been built
+    EXPECT_EQ(da_options_set_string(nn_handle, "storage precision", "working"),
+              da_status_success);
+    EXPECT_EQ(da_nn_set_data(nn_handle, param.n_samples, param.n_features, X_train.data(),
+                             param.ldx_train),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(nn_handle, "storage precision", "int8"),
+              da_status_success);
+    EXPECT_EQ(da_nn_kneighbors(nn_handle, param.n_queries, param.n_features,
+                               X_test.data(), param.ldx_test, ind.data(),
+                               (TypeParam *)nullptr, 1, 0),
+              da_status_incompatible_options);
+    da_handle_destroy(&nn_handle);
+
+    // Training data outside the range of half precision
+    X_train[0] = TypeParam(1.0e5);
+    EXPECT_EQ(da_handle_init<TypeParam>(&nn_handle, da_handle_nn), da_status_success);
+    EXPECT_EQ(da_options_set_string(nn_handle, "algorithm", "brute"), da_status_success);
+    EXPECT_EQ(da_options_set_string(nn_handle, "storage precision", "half"),
+              da_status_success);
+    EXPECT_EQ(da_nn_set_data(nn_handle, param.n_samples, param.n_features, X_train.data(),
+                             param.ldx_train),
+              da_status_success);
+    EXPECT_EQ(da_nn_kneighbors(nn_handle, param.n_queries, param.n_features,
+                               X_test.data(), param.ldx_test, ind.data(),
+                               (TypeParam *)nullptr, 1, 0),
+              da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_string(nn_handle, "storage precision", "bfloat16"),
+              da_status_success);
+    EXPECT_EQ(da_nn_kneighbors(nn_handle, param.n_queries, param.n_features,
+                               X_test.data(), param.ldx_test, ind.data(),
+                               (TypeParam *)nullptr, 1, 0),
+              da_status_success);
+    da_handle_destroy(&nn_handle);
+}
+
+// k-nearest neighbors with the training data stored in reduced precision, with and
+// without re-ranking in working precision
+TYPED_TEST(NearestNeighborsTest, StoragePrecisionKNN) {
+    da_int n_samples = 600, n_features = 8, n_queries = 40, k = 5;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<TypeParam> dist_gen(-1.0, 1.0);
+    std::vector<TypeParam> X_train(n_samples * n_features);
+    std::vector<TypeParam> X_test(n_queries * n_features);
+    for (auto &x : X_train)
+        x = dist_gen(gen);
+    for (auto &x : X_test)
+        x = dist_gen(gen);
+
+    auto run_knn = [&](std::string metric, std::string precision, da_int rerank,
+                       std::vector<da_int> &ind, std::vector<TypeParam> &dist) {
+        da_handle nn_handle = nullptr;
+        ind.resize(n_queries * k);
+        dist.resize(n_queries * k);
+        EXPECT_EQ(da_handle_init<TypeParam>(&nn_handle, da_handle_nn), da_status_success);
+        EXPECT_EQ(da_options_set_string(nn_handle, "metric", metric.c_str()),
+                  da_status_success);
+        EXPECT_EQ(
+            da_options_set_string(nn_handle, "storage precision", precision.c_str()),
+            da_status_success);
+        EXPECT_EQ(da_options_set_int(nn_handle, "rerank factor", rerank),
+                  da_status_success);
+        EXPECT_EQ(da_nn_set_data(nn_handle, n_samples, n_features, X_train.data(),
+                                 n_samples),
+                  da_status_success);
+        EXPECT_EQ(da_nn_kneighbors(nn_handle, n_queries, n_features, X_test.data(),
+                                   n_queries, ind.data(), dist.data(), k, 1),
+                  da_status_success);
+        da_handle_destroy(&nn_handle);
+    };
+
+    std::vector<da_int> ind_ref, ind;
+    std::vector<TypeParam> dist_ref, dist;
+    for (std::string metric : {"euclidean", "sqeuclidean_gemm", "manhattan",
+                               "inner product"}) {
+        run_knn(metric, "working", 2, ind_ref, dist_ref);
+        for (std::string precision : {"half", "bfloat16", "int8"}) {
+            std::string name = metric + ", " + precision;
+            // Re-ranking recovers the working precision results
+            run_knn(metric, precision, 4, ind, dist);
+            EXPECT_ARR_NEAR(n_queries * k, dist.data(), dist_ref.data(),
+                            100 * std::numeric_limits<TypeParam>::epsilon())
+                << name;
+            EXPECT_ARR_EQ(n_queries * k, ind.data(), ind_ref.data(), 1, 1, 0, 0) << name;
+            // Without re-ranking only approximate distances are returned
+            run_knn(metric, precision, 0, ind, dist);
+            EXPECT_ARR_NEAR(n_queries * k, dist.data(), dist_ref.data(), 0.1) << name;
+        }
+    }
+}
+
+// Without re-ranking the handle's copy of row-major training data is released once the
+// reduced precision copy is built; options that need it again are rejected
+TYPED_TEST(NearestNeighborsTest, StoragePrecisionReleaseWorkingCopy) {
+    da_int n_samples = 200, n_features = 4, n_queries = 10, k = 3;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<TypeParam> dist_gen(-1.0, 1.0);
+    std::vector<TypeParam> X_train(n_samples * n_features);
+    std::vector<TypeParam> X_test(n_queries * n_features);
+    for (auto &x : X_train)
+        x = dist_gen(gen);
+    for (auto &x : X_test)
+        x = dist_gen(gen);
+    std::vector<da_int> ind_ref(n_queries * k), ind(n_queries * k);
+    std::vector<TypeParam> dist_ref(n_queries * k), dist(n_queries * k);
+
+    da_handle nn_handle = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&nn_handle, da_handle_nn), da_status_success);
+    EXPECT_EQ(da_options_set_string(nn_handle, "storage order", "row-major"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(nn_handle, "storage precision", "half"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(nn_handle, "rerank factor", 0), da_status_success);
+    EXPECT_EQ(da_nn_set_data(nn_handle, n_samples, n_features, X_train.data(),
+                             n_features),
+              da_status_success);
+    EXPECT_EQ(da_nn_kneighbors(nn_handle, n_queries, n_features, X_test.data(),
+                               n_features, ind_ref.data(), dist_ref.data(), k, 1),
+              da_status_success);
+    // Later queries only read the reduced precision copy
+    EXPECT_EQ(da_nn_kneighbors(nn_handle, n_queries, n_features, X_test.data(),
+                               n_features, ind.data(), dist.data(), k, 1),
+              da_status_success);
+    EXPECT_ARR_EQ(n_queries * k, ind.data(), ind_ref.data(), 1, 1, 0, 0);
+    EXPECT_ARR_EQ(n_queries * k, dist.data(), dist_ref.data(), 1, 1, 0, 0);
+
+    // Saving the model stores the expanded reduced precision data
+    std::string model_file = "nn_release_working_copy.model";
+    EXPECT_EQ(da_handle_save_model(nn_handle, model_file.c_str()), da_status_success);
+    da_handle loaded_handle = nullptr;
+    EXPECT_EQ(da_handle_load_model(&loaded_handle, model_file.c_str()),
+              da_status_success);
+    std::remove(model_file.c_str());
+    EXPECT_EQ(da_nn_kneighbors(loaded_handle, n_queries, n_features, X_test.data(),
+                               n_features, ind.data(), dist.data(), k, 1),
+              da_status_success);
+    EXPECT_ARR_EQ(n_queries * k, ind.data(), ind_ref.data(), 1, 1, 0, 0);
+    EXPECT_ARR_EQ(n_queries * k, dist.data(), dist_ref.data(), 1, 1, 0, 0);
+    da_handle_destroy(&loaded_handle);
+
+    // Re-ranking, working precision storage and radius neighbors need the released copy
+    EXPECT_EQ(da_options_set_int(nn_handle, "rerank factor", 2), da_status_success);
+    EXPECT_EQ(da_nn_kneighbors(nn_handle, n_queries, n_features, X_test.data(),
+                               n_features, ind.data(), dist.data(), k, 1),
+              da_status_no_data);
+    EXPECT_EQ(da_options_set_int(nn_handle, "rerank factor", 0), da_status_success);
+    EXPECT_EQ(da_options_set_string(nn_handle, "storage precision", "working"),
+              da_status_success);
+    EXPECT_EQ(da_nn_kneighbors(nn_handle, n_queries, n_features, X_test.data(),
+                               n_features, ind.data(), dist.data(), k, 1),
+              da_status_no_data);
+    EXPECT_EQ(da_nn_radius_neighbors(nn_handle, n_queries, n_features, X_test.data(),
+                                     n_features, TypeParam(0.5), 0, 0),
+              da_status_no_data);
+
+    // Setting the data again restores them
+    EXPECT_EQ(da_nn_set_data(nn_handle, n_samples, n_features, X_train.data(),
+                             n_features),
+              da_status_success);
+    EXPECT_EQ(da_nn_kneighbors(nn_handle, n_queries, n_features, X_test.data(),
+                               n_features, ind.data(), dist.data(), k, 1),
+              da_status_success);
+    da_handle_destroy(&nn_handle);
+}
+
 // Verify that inner product is incompatible with radius neighbors and
 // weights="distance".
 TYPED_TEST(NearestNeighborsTest, InnerProductIncompatibleCombinations) {
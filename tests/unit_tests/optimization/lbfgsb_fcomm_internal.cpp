@@ -91,6 +91,7 @@ int main(void) {
     const std::vector<double> xref(2, 1.0);
     da_errors::da_error_t err(da_errors::action_t::DA_RECORD);
     const da_int mon[2] = {10, 1};
+    da_optim::da_optimization<double> *pfd = nullptr;
 
     da_optim::da_optimization<double> *pd =
         new da_optim::da_optimization<double>(status, err);
@@ -160,6 +161,40 @@ int main(void) {
         }
     }
 
+    // Same problem without the gradient call-back: it is estimated by finite-differences
+    // with the perturbed points evaluated concurrently
+    if (exit_status != 0)
+        goto abort;
+    exit_status = 1;
+    status = da_status_internal_error;
+    pfd = new da_optim::da_optimization<double>(status, err);
+    if (status != da_status_success)
+        goto abort;
+    status = da_status_internal_error;
+    if (pfd->add_vars(n) != da_status_success)
+        goto abort;
+    if (pfd->add_bound_cons(l, u) != da_status_success)
+        goto abort;
+    if (pfd->add_objfun(objfun) != da_status_success)
+        goto abort;
+    if (pfd->opts.set("Print Level", (da_int)0) != da_status_success)
+        goto abort;
+    if (pfd->opts.set("LBfgSB Iteration Limit", (da_int)1000) != da_status_success)
+        goto abort;
+    if (pfd->opts.set("Finite Differences Threads", (da_int)2) != da_status_success)
+        goto abort;
+    x.assign(n, 0.0);
+    status = pfd->solve(x, (void *)params);
+    if (status == da_status_success || status == da_status_numerical_difficulties ||
+        status == da_status_maxit) {
+        if (std::fabs(x[0] - xref[0]) <= 1.0e-3 && std::fabs(x[1] - xref[1]) <= 1.0e-3) {
+            std::cout << "Solution found with finite-differences: " << x[0] << ", "
+                      << x[1] << std::endl;
+            status = da_status_success;
+            exit_status = 0;
+        }
+    }
+
 abort:
     if (status != da_status_success)
         std::cout << "status: " << status << std::endl;
@@ -168,6 +203,10 @@ abort:
         // delete data
         delete pd;
     }
+    if (pfd) {
+        (*pfd).err->print();
+        delete pfd;
+    }
 
     return exit_status;
 }
@@ -31,6 +31,7 @@
 #include "aoclda_cpp_overloads.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <atomic>
 #include <iostream>
 #include <math.h>
 #include <type_traits>
@@ -488,6 +489,77 @@ template <typename T> void driver(void) {
 
 } // namespace template_lm_example_c
 
+namespace template_nlls_batch {
+/* Problem p fits y = x1 exp(x2 t) to noise-free data generated with
+ * x1 = 1 + p/20 and x2 = 0.2 + p/200
+ */
+template <typename T> struct params_type {
+    da_int m;
+    const T *t;
+    const T *y; // m * n_problems observations, problem-major
+    da_int fail; // problem whose residual function fails
+    da_int *nevalf; // per problem residual evaluations
+};
+
+template <typename T> T exact_coef(da_int p, da_int j) {
+    return j == 0 ? T(1) + T(p) / T(20) : T(0.2) + T(p) / T(200);
+}
+
+template <typename T>
+da_int eval_r(da_int p, [[maybe_unused]] da_int n, da_int m, void *params, T const *x,
+              T *r) {
+    params_type<T> *d = (params_type<T> *)params;
+    if (p == d->fail)
+        return 1;
+    d->nevalf[p]++;
+    for (da_int i = 0; i < m; i++)
+        r[i] = x[0] * exp(x[1] * d->t[i]) - d->y[p * m + i];
+    return 0;
+}
+
+template <typename T>
+da_int eval_J([[maybe_unused]] da_int p, [[maybe_unused]] da_int n, da_int m,
+              void *params, T const *x, T *J) {
+    params_type<T> *d = (params_type<T> *)params;
+    for (da_int i = 0; i < m; i++) {
+        J[0 * m + i] = exp(x[1] * d->t[i]);
+        J[1 * m + i] = d->t[i] * x[0] * exp(x[1] * d->t[i]);
+    }
+    return 0;
+}
+} // namespace template_nlls_batch
+
+namespace template_nlls_fd {
+/* Thread-safe residuals of y = x1 exp(x2 t), used to estimate the Jacobian
+ * concurrently or with the multi-point call-back
+ */
+template <typename T> struct params_type {
+    const T *t;
+    const T *y;
+    std::atomic<da_int> nevalf{0}; // single point evaluations
+    std::atomic<da_int> nmulti{0}; // multi-point calls
+};
+
+template <typename T>
+da_int eval_r([[maybe_unused]] da_int n, da_int m, void *params, T const *x, T *r) {
+    params_type<T> *d = (params_type<T> *)params;
+    d->nevalf++;
+    for (da_int i = 0; i < m; i++)
+        r[i] = x[0] * exp(x[1] * d->t[i]) - d->y[i];
+    return 0;
+}
+
+template <typename T>
+da_int eval_r_multi(da_int n, da_int m, da_int n_points, void *params, T const *x,
+                    T *r) {
+    params_type<T> *d = (params_type<T> *)params;
+    d->nmulti++;
+    for (da_int k = 0; k < n_points; k++)
+        eval_r<T>(n, m, params, &x[k * n], &r[k * m]);
+    return 0;
+}
+} // namespace template_nlls_fd
+
 namespace double_nlls_example_box_fortran {
 struct udata_t {
     const double *t;
@@ -405,6 +405,245 @@ TEST(nlls, solverCheckMaxTime) {
     da_handle_destroy(&handle);
 }
 
+template <typename T> void batch_driver(bool use_jacobian, const char *solver) {
+    using namespace template_nlls_batch;
+    const da_int n_problems{64}, n{2}, m{8};
+    std::vector<T> t(m), y(m * n_problems), x(n * n_problems, T(0));
+    std::vector<da_int> nevalf(n_problems, 0);
+    std::vector<da_status> problem_status(n_problems, da_status_internal_error);
+    for (da_int i = 0; i < m; i++)
+        t[i] = T(0.25) * T(i);
+    for (da_int p = 0; p < n_problems; p++) {
+        for (da_int i = 0; i < m; i++)
+            y[p * m + i] = exact_coef<T>(p, 0) * exp(exact_coef<T>(p, 1) * t[i]);
+        x[p * n] = T(1);
+    }
+    params_type<T> params{m, t.data(), y.data(), -1, nevalf.data()};
+    const T tol = std::is_same_v<T, double> ? T(1.0e-4) : T(1.0e-2);
+
+    da_handle handle{nullptr};
+    EXPECT_EQ(da_handle_init<T>(&handle, da_handle_type::da_handle_nlls),
+              da_status_success);
+    EXPECT_EQ(da_nlls_define_residuals_batch<T>(handle, n, m, eval_r<T>,
+                                                use_jacobian ? eval_J<T> : nullptr),
+              da_status_success);
+    EXPECT_EQ(da_options_set(handle, "ralfit iteration limit", da_int(200)),
+              da_status_success);
+    EXPECT_EQ(da_options_set(handle, "nlls batch solver", solver), da_status_success);
+    EXPECT_EQ(da_nlls_fit_batch(handle, n_problems, n, x.data(), problem_status.data(),
+                                &params),
+              da_status_success);
+    for (da_int p = 0; p < n_problems; p++) {
+        EXPECT_EQ(problem_status[p], da_status_success);
+        EXPECT_GT(nevalf[p], 0);
+        EXPECT_NEAR(x[p * n], exact_coef<T>(p, 0), tol);
+        EXPECT_NEAR(x[p * n + 1], exact_coef<T>(p, 1), tol);
+    }
+
+    // Counters are accumulated over the batch
+    da_int tr_dim = 1, tr_val = -1;
+    EXPECT_EQ(da_handle_get_result(handle, da_result::da_trained, &tr_dim, &tr_val),
+              da_status_success);
+    EXPECT_EQ(tr_val, 1);
+    std::vector<T> info(100);
+    da_int size = info.size();
+    EXPECT_EQ(da_handle_get_result(handle, da_result::da_rinfo, &size, info.data()),
+              da_status_success);
+    EXPECT_GE(info[da_optim_info_t::info_nevalf], T(n_problems));
+    EXPECT_GE(info[da_optim_info_t::info_iter], T(n_problems));
+
+    // A failing problem does not stop the others
+    params.fail = 5;
+    for (da_int p = 0; p < n_problems; p++) {
+        x[p * n] = T(1);
+        x[p * n + 1] = T(0);
+    }
+    EXPECT_EQ(da_nlls_fit_batch(handle, n_problems, n, x.data(), problem_status.data(),
+                                &params),
+              da_status_operation_failed);
+    for (da_int p = 0; p < n_problems; p++) {
+        if (p == params.fail) {
+            EXPECT_EQ(problem_status[p], da_status_operation_failed);
+            continue;
+        }
+        EXPECT_EQ(problem_status[p], da_status_success);
+        EXPECT_NEAR(x[p * n], exact_coef<T>(p, 0), tol);
+    }
+    // problem_status is optional
+    EXPECT_EQ(da_nlls_fit_batch(handle, n_problems, n, x.data(), nullptr, &params),
+              da_status_operation_failed);
+    da_handle_destroy(&handle);
+}
+
+TEST(nlls, batchFit) {
+    for (const char *solver : {"ralfit", "levenberg-marquardt"}) {
+        batch_driver<double>(true, solver);
+        batch_driver<double>(false, solver);
+        batch_driver<float>(true, solver);
+    }
+}
+
+TEST(nlls, batchIfaceChecks) {
+    using namespace template_nlls_batch;
+    using T = double;
+    da_int n{2}, m{8}, nevalf[2]{0, 0};
+    T x[4]{1.0, 0.0, 1.0, 0.0}, t[8]{0}, y[16]{0};
+    params_type<T> params{m, t, y, -1, nevalf};
+    da_handle handle{nullptr};
+    EXPECT_EQ(da_nlls_fit_batch(handle, 2, n, x, nullptr, &params),
+              da_status_handle_not_initialized);
+    EXPECT_EQ(da_handle_init<T>(&handle, da_handle_type::da_handle_nlls),
+              da_status_success);
+    // No batched residuals defined yet
+    EXPECT_EQ(da_nlls_fit_batch(handle, 2, n, x, nullptr, &params),
+              da_status_invalid_input);
+    EXPECT_EQ(da_nlls_define_residuals_batch<T>(handle, n, m, nullptr, eval_J<T>),
+              da_status_invalid_input);
+    EXPECT_EQ(da_nlls_define_residuals_batch<T>(handle, n, m, eval_r<T>, eval_J<T>),
+              da_status_success);
+    // Only batched residuals defined
+    EXPECT_EQ(da_nlls_fit(handle, n, x, &params), da_status_invalid_input);
+    EXPECT_EQ(da_nlls_fit_batch(handle, 0, n, x, nullptr, &params),
+              da_status_invalid_input);
+    EXPECT_EQ(da_nlls_fit_batch(handle, 2, n + 1, x, nullptr, &params),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(da_nlls_fit_batch<T>(handle, 2, n, nullptr, nullptr, &params),
+              da_status_invalid_pointer);
+    float xs[4]{0};
+    EXPECT_EQ(da_nlls_fit_batch(handle, 2, n, xs, nullptr, &params),
+              da_status_wrong_type);
+    // The built-in solver only handles quadratic regularization
+    EXPECT_EQ(da_options_set(handle, "regularization term", T(1)), da_status_success);
+    EXPECT_EQ(da_options_set(handle, "regularization power", "cubic"), da_status_success);
+    EXPECT_EQ(da_options_set(handle, "nlls batch solver", "lm"), da_status_success);
+    EXPECT_EQ(da_nlls_fit_batch(handle, 2, n, x, nullptr, &params),
+              da_status_incompatible_options);
+    da_handle_destroy(&handle);
+}
+
+TEST(nlls, batchFitBoundsWeights) {
+    // Both batch solvers must agree on a problem with active bounds and weights
+    using namespace template_nlls_batch;
+    using T = double;
+    const da_int n_problems{16}, n{2}, m{8};
+    std::vector<T> t(m), y(m * n_problems), w(m), lower{0.0, 0.0}, upper{1.2, 1.0};
+    std::vector<da_int> nevalf(n_problems, 0);
+    for (da_int i = 0; i < m; i++) {
+        t[i] = T(0.25) * T(i);
+        w[i] = T(1) + T(i % 3);
+    }
+    for (da_int p = 0; p < n_problems; p++)
+        for (da_int i = 0; i < m; i++)
+            y[p * m + i] = exact_coef<T>(p, 0) * exp(exact_coef<T>(p, 1) * t[i]) +
+                           T(0.01) * T((i * 7 + p) % 5 - 2);
+    params_type<T> params{m, t.data(), y.data(), -1, nevalf.data()};
+
+    std::vector<std::vector<T>> coef;
+    for (const char *solver : {"ralfit", "levenberg-marquardt"}) {
+        std::vector<T> x(n * n_problems, T(0.5));
+        da_handle handle{nullptr};
+        EXPECT_EQ(da_handle_init<T>(&handle, da_handle_type::da_handle_nlls),
+                  da_status_success);
+        EXPECT_EQ(da_nlls_define_residuals_batch<T>(handle, n, m, eval_r<T>, eval_J<T>),
+                  da_status_success);
+        EXPECT_EQ(da_nlls_define_bounds(handle, n, lower.data(), upper.data()),
+                  da_status_success);
+        EXPECT_EQ(da_nlls_define_weights(handle, m, w.data()), da_status_success);
+        EXPECT_EQ(da_options_set(handle, "ralfit iteration limit", da_int(200)),
+                  da_status_success);
+        EXPECT_EQ(da_options_set(handle, "nlls batch solver", solver), da_status_success);
+        EXPECT_EQ(da_nlls_fit_batch(handle, n_problems, n, x.data(), nullptr, &params),
+                  da_status_success)
+            << solver;
+        coef.push_back(x);
+        da_handle_destroy(&handle);
+    }
+    for (da_int k = 0; k < n * n_problems; k++) {
+        EXPECT_NEAR(coef[0][k], coef[1][k], 1.0e-5);
+        EXPECT_LE(coef[1][k], upper[k % n]);
+    }
+    // The upper bound on the first coefficient is active for the last problems
+    EXPECT_DOUBLE_EQ(coef[1][(n_problems - 1) * n], upper[0]);
+}
+
+TEST(nlls, parallelFiniteDifferences) {
+    using namespace template_nlls_fd;
+    using T = double;
+    const da_int n{2}, m{5};
+    const T t[m]{1.0, 2.0, 4.0, 5.0, 8.0};
+    const T y[m]{3.0, 4.0, 6.0, 11.0, 20.0};
+    T blx[n]{0.0, 0.0}, bux[n]{3.0, 10.0};
+    T x_serial[n]{0.0, 0.0};
+
+    // RALFit's serial estimate, then all threads, 3 threads and the multi-point call-back
+    for (da_int mode = 0; mode < 4; mode++) {
+        params_type<T> params{t, y};
+        T x[n]{1.0, 0.15};
+        da_handle handle{nullptr};
+        EXPECT_EQ(da_handle_init<T>(&handle, da_handle_type::da_handle_nlls),
+                  da_status_success);
+        EXPECT_EQ(da_nlls_define_residuals<T>(handle, n, m, eval_r<T>, nullptr, nullptr,
+                                              nullptr),
+                  da_status_success);
+        EXPECT_EQ(da_nlls_define_bounds(handle, n, blx, bux), da_status_success);
+        EXPECT_EQ(da_options_set(handle, "ralfit iteration limit", da_int(200)),
+                  da_status_success);
+        EXPECT_EQ(da_options_set(handle, "finite differences step", T(1.0e-6)),
+                  da_status_success);
+        if (mode == 1) {
+            EXPECT_EQ(da_options_set(handle, "finite differences threads", da_int(0)),
+                      da_status_success);
+        }
+        if (mode == 2) {
+            EXPECT_EQ(da_options_set(handle, "finite differences threads", da_int(3)),
+                      da_status_success);
+        }
+        if (mode == 3) {
+            EXPECT_EQ(da_nlls_define_residuals_multi<T>(handle, eval_r_multi<T>),
+                      da_status_success);
+        }
+        EXPECT_EQ(da_nlls_fit(handle, n, x, &params), da_status_success);
+
+        std::vector<T> info(100);
+        da_int size = info.size();
+        EXPECT_EQ(da_handle_get_result(handle, da_result::da_rinfo, &size, info.data()),
+                  da_status_success);
+        EXPECT_GT(info[da_optim_info_t::info_nevalfd], T(3));
+        EXPECT_EQ(info[da_optim_info_t::info_nevalf], T(params.nevalf));
+        EXPECT_EQ(params.nmulti > 0, mode == 3);
+        if (mode == 0) {
+            EXPECT_NEAR(x[0], 2.541046, 1.0e-2);
+            EXPECT_NEAR(x[1], 0.2595048, 1.0e-2);
+            x_serial[0] = x[0];
+            x_serial[1] = x[1];
+        } else {
+            EXPECT_NEAR(x[0], x_serial[0], 1.0e-5);
+            EXPECT_NEAR(x[1], x_serial[1], 1.0e-5);
+        }
+        da_handle_destroy(&handle);
+    }
+
+    // The multi-point call-back requires the residuals and is dropped when they change
+    params_type<T> params{t, y};
+    T x[n]{1.0, 0.15};
+    da_handle handle{nullptr};
+    EXPECT_EQ(da_handle_init<T>(&handle, da_handle_type::da_handle_nlls),
+              da_status_success);
+    EXPECT_EQ(da_nlls_define_residuals_multi<T>(handle, eval_r_multi<T>),
+              da_status_invalid_input);
+    EXPECT_EQ(da_nlls_define_residuals<T>(handle, n, m, eval_r<T>, nullptr, nullptr,
+                                          nullptr),
+              da_status_success);
+    EXPECT_EQ(da_nlls_define_residuals_multi<T>(handle, eval_r_multi<T>),
+              da_status_success);
+    EXPECT_EQ(da_nlls_define_residuals<T>(handle, n, m, eval_r<T>, nullptr, nullptr,
+                                          nullptr),
+              da_status_success);
+    EXPECT_EQ(da_nlls_fit(handle, n, x, &params), da_status_success);
+    EXPECT_EQ(params.nmulti, 0);
+    da_handle_destroy(&handle);
+}
+
 TEST(nlls, wrongType) {
     using namespace template_nlls_example_box_c;
     da_handle handle{nullptr};
@@ -113,6 +113,7 @@ TYPED_TEST(svm_internal_test, local_smo) {
             svc_obj.y = data.y.data();
             svc_obj.wssi_vec_type = isa.second;
             svc_obj.wssj_vec_type = isa.second;
+            svc_obj.local_bound.resize(data.n); // sized by compute() otherwise
 
             svc_obj.initialisation(data.n, gradient, response, alpha, cache);
 
@@ -1160,6 +1160,133 @@ TYPED_TEST(svm_public_test, mixed_precision_svr) {
     da_handle_destroy(&refined);
 }
 
+TYPED_TEST(svm_public_test, sample_weights) {
+    // Three classes in 2D, column-major
+    // clang-format off
+    std::vector<TypeParam> X = {0.0, 0.5, 1.0, 0.2, 4.0, 4.5, 5.0, 4.2,
+                                0.0, 0.5, 1.0, 0.3, 0.0, 0.4, 0.1, 0.8,
+                                0.0, 0.4, 0.1, 0.7, 4.0, 4.5, 4.1, 4.8};
+    // clang-format on
+    std::vector<TypeParam> y = {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2};
+    da_int n = 12, p = 2, n_test = 3, n_dec = 3;
+    std::vector<TypeParam> X_test = {0.3, 4.1, 0.6, 0.2, 0.3, 4.4};
+    const TypeParam tol = 100 * std::sqrt(std::numeric_limits<TypeParam>::epsilon());
+
+    auto fit = [&](da_int n_rows, const TypeParam *X_fit, const TypeParam *y_fit,
+                   TypeParam C, const TypeParam *w, std::vector<TypeParam> &dec) {
+        da_handle handle = nullptr;
+        ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_svm), da_status_success);
+        ASSERT_EQ(da_options_set(handle, "kernel", "linear"), da_status_success);
+        ASSERT_EQ(da_options_set(handle, "C", C), da_status_success);
+        ASSERT_EQ(da_svm_select_model<TypeParam>(handle, svc), da_status_success);
+        ASSERT_EQ(da_svm_set_data(handle, n_rows, p, X_fit, n_rows, y_fit),
+                  da_status_success);
+        if (w != nullptr)
+            ASSERT_EQ(da_svm_set_sample_weights(handle, n_rows, w), da_status_success);
+        ASSERT_EQ(da_svm_compute<TypeParam>(handle), da_status_success);
+        dec.resize(n_test * n_dec);
+        ASSERT_EQ(da_svm_decision_function(handle, n_test, p, X_test.data(), n_test, ovo,
+                                           dec.data(), n_test),
+                  da_status_success);
+        da_handle_destroy(&handle);
+    };
+
+    // Uniform weights are equivalent to scaling C
+    std::vector<TypeParam> w(n, 2.0), dec_w, dec_ref;
+    fit(n, X.data(), y.data(), (TypeParam)0.5, w.data(), dec_w);
+    fit(n, X.data(), y.data(), (TypeParam)1.0, nullptr, dec_ref);
+    EXPECT_ARR_NEAR(n_test * n_dec, dec_w, dec_ref, tol);
+
+    // A zero weight is equivalent to removing the row
+    std::fill(w.begin(), w.end(), (TypeParam)1.0);
+    w[9] = 0.0;
+    std::vector<TypeParam> X_red, y_red;
+    for (da_int j = 0; j < p; j++)
+        for (da_int i = 0; i < n; i++)
+            if (i != 9)
+                X_red.push_back(X[i + j * n]);
+    for (da_int i = 0; i < n; i++)
+        if (i != 9)
+            y_red.push_back(y[i]);
+    fit(n, X.data(), y.data(), (TypeParam)1.0, w.data(), dec_w);
+    fit(n - 1, X_red.data(), y_red.data(), (TypeParam)1.0, nullptr, dec_ref);
+    EXPECT_ARR_NEAR(n_test * n_dec, dec_w, dec_ref, tol);
+
+    // Error exits
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_svm), da_status_success);
+    ASSERT_EQ(da_svm_select_model<TypeParam>(handle, nusvc), da_status_success);
+    EXPECT_EQ(da_svm_set_sample_weights(handle, n, w.data()), da_status_no_data);
+    ASSERT_EQ(da_svm_set_data(handle, n, p, X.data(), n, y.data()), da_status_success);
+    EXPECT_EQ(da_svm_set_sample_weights(handle, n - 1, w.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_svm_set_sample_weights<TypeParam>(handle, n, nullptr),
+              da_status_invalid_pointer);
+    w[0] = -1.0;
+    EXPECT_EQ(da_svm_set_sample_weights(handle, n, w.data()), da_status_invalid_input);
+    w[0] = 1.0;
+    ASSERT_EQ(da_svm_set_sample_weights(handle, n, w.data()), da_status_success);
+    EXPECT_EQ(da_svm_compute<TypeParam>(handle), da_status_incompatible_options);
+    ASSERT_EQ(da_svm_set_sample_weights<TypeParam>(handle, 0, nullptr),
+              da_status_success);
+    EXPECT_EQ(da_svm_compute<TypeParam>(handle), da_status_success);
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(svm_public_test, concurrent_inference) {
+    // Several threads share one trained handle, each with its own inference context;
+    // the results must match the serial handle-based calls
+    da_int n = 60, p = 3;
+    std::vector<TypeParam> X(n * p), y(n);
+    for (da_int i = 0; i < n * p; i++)
+        X[i] = (TypeParam)(((i * 104729) % 389) / 97.0 - 2.0);
+    for (da_int i = 0; i < n; i++)
+        y[i] = X[i] + X[n + i] > 0 ? (TypeParam)1 : (TypeParam)0;
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_svm), da_status_success);
+    EXPECT_EQ(da_svm_select_model<TypeParam>(handle, svc), da_status_success);
+    EXPECT_EQ(da_svm_set_data(handle, n, p, X.data(), n, y.data()), da_status_success);
+    ASSERT_EQ(da_svm_compute<TypeParam>(handle), da_status_success);
+
+    const da_int n_chunks = 16, chunk = 23, n_total = n_chunks * chunk;
+    std::vector<TypeParam> Y(n_total * p);
+    for (da_int i = 0; i < (da_int)Y.size(); i++)
+        Y[i] = (TypeParam)(((i * 7919) % 613) / 153.0 - 2.0);
+
+    std::vector<TypeParam> pred_ref(n_total);
+    for (da_int c = 0; c < n_chunks; c++)
+        EXPECT_EQ(da_svm_predict(handle, chunk, p, &Y[c * chunk], n_total,
+                                 &pred_ref[c * chunk]),
+                  da_status_success);
+
+    std::vector<TypeParam> pred(n_total, (TypeParam)-1);
+    std::vector<da_status> status(n_chunks, da_status_internal_error);
+#pragma omp parallel for schedule(dynamic)
+    for (da_int c = 0; c < n_chunks; c++) {
+        da_inference_context ctx = nullptr;
+        if (da_inference_context_init(&ctx) != da_status_success)
+            continue;
+        status[c] = da_svm_predict(handle, ctx, chunk, p, &Y[c * chunk], n_total,
+                                   &pred[c * chunk]);
+        da_inference_context_destroy(&ctx);
+    }
+    for (da_int c = 0; c < n_chunks; c++)
+        EXPECT_EQ(status[c], da_status_success);
+    EXPECT_ARR_NEAR(n_total, pred, pred_ref, (TypeParam)0);
+
+    // Errors are reported in the context rather than in the handle
+    da_inference_context ctx = nullptr;
+    ASSERT_EQ(da_inference_context_init(&ctx), da_status_success);
+    EXPECT_EQ(da_svm_predict(handle, ctx, chunk, p + 1, Y.data(), n_total, pred.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_inference_context_print_error_message(ctx), da_status_success);
+    EXPECT_EQ(da_svm_predict(handle, (da_inference_context) nullptr, chunk, p, Y.data(),
+                             n_total, pred.data()),
+              da_status_invalid_pointer);
+    da_inference_context_destroy(&ctx);
+    da_handle_destroy(&handle);
+}
+
 TEST(svm_public_test, incorrect_handle_precision) {
 
     da_handle handle_d = nullptr;
@@ -1193,6 +1320,15 @@ TEST(svm_public_test, incorrect_handle_precision) {
     EXPECT_EQ(da_svm_predict_d(handle_s, n_samples, n_features, X_d.data(), n_samples,
                                y_d.data()),
               da_status_wrong_type);
+    da_inference_context ctx = nullptr;
+    EXPECT_EQ(da_inference_context_init(&ctx), da_status_success);
+    EXPECT_EQ(da_svm_predict_ctx_s(handle_d, ctx, n_samples, n_features, X_s.data(),
+                                   n_samples, y_s.data()),
+              da_status_wrong_type);
+    EXPECT_EQ(da_svm_predict_ctx_d(handle_s, ctx, n_samples, n_features, X_d.data(),
+                                   n_samples, y_d.data()),
+              da_status_wrong_type);
+    da_inference_context_destroy(&ctx);
 
     EXPECT_EQ(da_svm_decision_function_s(handle_d, n_samples, n_features, X_s.data(),
                                          n_samples, ovr, y_s.data(), n_samples),
@@ -33,7 +33,9 @@
 #include <cmath>
 #include <limits>
 #include <list>
+#include <memory>
 #include <numeric>
+#include <random>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -622,6 +624,73 @@ TYPED_TEST(tsne_internal_test, BarnesHutExtremeCoordinates) {
     EXPECT_NEAR(std::abs(rep[0 * dim + 1]), std::abs(rep[0 * dim + 0]), f_tol);
 }
 
+
+// =============================================================================
+// FFT-accelerated interpolation repulsive forces
+// =============================================================================
+
+// The interpolated forces and normalization must match the exact sums
+TYPED_TEST(tsne_internal_test, FFTInterpolationMatchesExact) {
+    const da_int n = 300;
+    std::vector<TypeParam> pts(2 * n);
+    std::mt19937 gen(42);
+    std::normal_distribution<double> normal(0.0, 4.0);
+    for (auto &p : pts)
+        p = (TypeParam)normal(gen);
+    std::vector<TypeParam> work(n);
+
+    auto check = [&](auto grid, auto tree, const char *label) {
+        constexpr da_int dim = decltype(grid)::element_type::N_CHARGES - 1;
+        tree->build();
+        std::vector<TypeParam> rep_exact(n * dim), rep_fft(n * dim);
+        TypeParam sq_exact = 0, sq_fft = 0;
+        da_tsne::compute_repulsive_forces(*tree, n, rep_exact.data(), sq_exact, work);
+        grid->build();
+        EXPECT_EQ(grid->n_nodes, grid->n_boxes * 3);
+        EXPECT_GE(grid->fft_len, 2 * grid->n_nodes);
+        da_tsne::compute_repulsive_forces(*grid, n, rep_fft.data(), sq_fft, work);
+
+        TypeParam max_force = 0, max_err = 0;
+        for (da_int i = 0; i < n * dim; ++i) {
+            max_force = std::max(max_force, std::abs(rep_exact[i]));
+            max_err = std::max(max_err, std::abs(rep_fft[i] - rep_exact[i]));
+        }
+        EXPECT_LE(max_err, TypeParam(0.03) * max_force) << label;
+        EXPECT_NEAR(sq_fft, sq_exact, TypeParam(1e-3) * sq_exact) << label;
+    };
+
+    check(std::make_unique<da_tsne::FFTInterpolationGrid<TypeParam, 1>>(pts.data(), n),
+          std::make_unique<da_tsne::BarnesHutTree<TypeParam, 1>>(pts.data(), n,
+                                                                 TypeParam(0), 1),
+          "1D");
+    check(std::make_unique<da_tsne::FFTInterpolationGrid<TypeParam, 2>>(pts.data(), n),
+          std::make_unique<da_tsne::BarnesHutTree<TypeParam, 2>>(pts.data(), n,
+                                                                 TypeParam(0), 1),
+          "2D");
+}
+
+// Empty and collapsed embeddings fall back to a unit box and sum_q = 1
+TYPED_TEST(tsne_internal_test, FFTInterpolationDegenerate) {
+    constexpr da_int dim = 2;
+    std::vector<TypeParam> pts = {1, 1, 1, 1};
+    std::vector<TypeParam> work;
+    TypeParam sum_q = 0;
+
+    da_tsne::FFTInterpolationGrid<TypeParam, dim> empty(pts.data(), 0, 3, 4);
+    empty.build();
+    da_tsne::compute_repulsive_forces(empty, 0, static_cast<TypeParam *>(nullptr), sum_q,
+                                      work);
+    EXPECT_EQ(sum_q, TypeParam(1));
+
+    // Two coincident points: no net force and q_01 = q_10 = 1
+    da_tsne::FFTInterpolationGrid<TypeParam, dim> grid(pts.data(), 2, 3, 16);
+    grid.build();
+    std::vector<TypeParam> rep(2 * dim);
+    da_tsne::compute_repulsive_forces(grid, 2, rep.data(), sum_q, work);
+    for (auto f : rep)
+        EXPECT_NEAR(f, TypeParam(0), TypeParam(1e-4));
+    EXPECT_NEAR(sum_q, TypeParam(2), TypeParam(1e-3));
+}
 // =============================================================================
 // compute_row_probabilities tests
 // =============================================================================
@@ -1354,4 +1423,98 @@ TYPED_TEST(tsne_internal_test, AffinitiesTwoPoint) {
     ASSERT_EQ(row_ptr.size(), (size_t)(n_samples + 1));
     // Each point has exactly 1 neighbor => 2 directed entries
     EXPECT_EQ((da_int)vals.size(), 2);
-}
\ No newline at end of file
+}
+// Trailing self-references pad rows with fewer neighbors and must not appear in P.
+// Row 0 lists a single neighbor, so P[0][1] and P[1][0] carry all of its mass.
+TYPED_TEST(tsne_internal_test, AffinitiesFromNeighborsPadded) {
+    const da_int n = 3, k = 2;
+    std::vector<da_int> nbr = {1, 0, 0, 2, 1, 0};
+    std::vector<TypeParam> sq_dist = {1, 0, 1, 4, 4, 9};
+
+    da_errors::da_error_t err(da_errors::action_t::DA_RECORD);
+    std::vector<da_int> row_ptr, col_idx;
+    std::vector<TypeParam> vals;
+    ASSERT_EQ(da_tsne::affinities_from_neighbors(TypeParam(1.5), n, k, nbr.data(),
+                                                 sq_dist.data(), &err, row_ptr, col_idx,
+                                                 vals),
+              da_status_success);
+
+    ASSERT_EQ(row_ptr.size(), (size_t)(n + 1));
+    for (da_int i = 0; i < n; ++i)
+        for (da_int idx = row_ptr[i]; idx < row_ptr[i + 1]; ++idx)
+            EXPECT_NE(col_idx[idx], i) << "Self-reference in row " << i;
+    TypeParam total = std::accumulate(vals.begin(), vals.end(), TypeParam(0));
+    EXPECT_NEAR(total, TypeParam(1), TypeParam(1e-5));
+    ASSERT_EQ(row_ptr[1] - row_ptr[0], 2);
+    EXPECT_EQ(col_idx[row_ptr[0]], 1);
+    EXPECT_GT(vals[row_ptr[0]], vals[row_ptr[0] + 1]);
+}
+
+// With one list probed out of one, the inverted file index is an exhaustive search and
+// must reproduce the exact k-nearest-neighbor affinities.
+TYPED_TEST(tsne_internal_test, AffinitiesIVFSingleList) {
+    const da_int n = 60, n_features = 3;
+    std::vector<TypeParam> data(n * n_features);
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> unif(0.0, 1.0);
+    for (auto &x : data)
+        x = (TypeParam)unif(gen);
+
+    da_errors::da_error_t err(da_errors::action_t::DA_RECORD);
+    std::vector<da_int> row_ptr, col_idx, row_ptr_ivf, col_idx_ivf;
+    std::vector<TypeParam> vals, vals_ivf;
+    ASSERT_EQ(da_tsne::compute_affinities(TypeParam(5), false, n, n_features, data.data(),
+                                          &err, row_ptr, col_idx, vals),
+              da_status_success);
+    ASSERT_EQ(da_tsne::compute_affinities(TypeParam(5), false, n, n_features, data.data(),
+                                          &err, row_ptr_ivf, col_idx_ivf, vals_ivf, 1, 1,
+                                          0),
+              da_status_success);
+
+    EXPECT_EQ(row_ptr, row_ptr_ivf);
+    EXPECT_EQ(col_idx, col_idx_ivf);
+    ASSERT_EQ(vals.size(), vals_ivf.size());
+    for (size_t i = 0; i < vals.size(); ++i)
+        EXPECT_NEAR(vals[i], vals_ivf[i], TypeParam(1e-4) * vals[i] + TypeParam(1e-7));
+}
+
+// Repulsion on external query points, exact (theta = 0) and approximate, against
+// brute-force sums over all tree points.
+TYPED_TEST(tsne_internal_test, BarnesHutQueryMatchesBruteForce) {
+    constexpr int8_t D = 2;
+    const da_int n = 200;
+    std::vector<TypeParam> pts(D * n);
+    std::mt19937 gen(3);
+    std::normal_distribution<double> normal(0.0, 5.0);
+    for (auto &p : pts)
+        p = (TypeParam)normal(gen);
+    const TypeParam queries[3][D] = {{0, 0}, {2.5, -1}, {30, 30}};
+
+    for (TypeParam theta : {TypeParam(0), TypeParam(0.5)}) {
+        da_tsne::BarnesHutTree<TypeParam, D> tree(pts.data(), n, theta);
+        tree.build();
+        int32_t node_stack[da_tsne::BarnesHutTree<TypeParam, D>::STACK_SIZE];
+        int32_t depth_stack[da_tsne::BarnesHutTree<TypeParam, D>::STACK_SIZE];
+        for (const auto &q : queries) {
+            double f_ref[D] = {}, sq_ref = 0;
+            for (da_int j = 0; j < n; ++j) {
+                double delta[D], dist2 = 0;
+                for (da_int d = 0; d < D; ++d) {
+                    delta[d] = (double)q[d] - (double)pts[j * D + d];
+                    dist2 += delta[d] * delta[d];
+                }
+                const double w = 1.0 / (1.0 + dist2);
+                sq_ref += w;
+                for (da_int d = 0; d < D; ++d)
+                    f_ref[d] += w * w * delta[d];
+            }
+            TypeParam f[D], sq;
+            tree.compute_repulsive_query(q, f, sq, node_stack, depth_stack);
+            const double tol = theta == TypeParam(0) ? 1e-4 : 0.05;
+            EXPECT_NEAR(sq, sq_ref, tol * sq_ref);
+            const double f_norm = std::hypot(f_ref[0], f_ref[1]);
+            for (da_int d = 0; d < D; ++d)
+                EXPECT_NEAR(f[d], f_ref[d], tol * f_norm + 1e-6);
+        }
+    }
+}
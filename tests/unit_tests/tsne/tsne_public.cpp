@@ -1028,6 +1028,285 @@ TEST(TSNEMixedPrecision, FloatIllegalOption) {
 // Positive tests - Quality comparison against target solution
 // =============================================================================
 
+// The FFT-interpolated gradient should reach the same quality as Barnes-Hut
+TYPED_TEST(tsne_public_test, FFTGradientMethod) {
+    std::string data_file = std::string(DATA_DIR) + "/tsne_data/iris_data.csv";
+    std::vector<TypeParam> X;
+    da_int n_samples, n_features;
+    ASSERT_TRUE(da_test::read_csv_data(data_file, X, n_samples, n_features, row_major));
+
+    for (da_int n_components : {1, 2}) {
+        TypeParam kl[2];
+        for (const char *method : {"barnes-hut", "fft"}) {
+            da_handle handle = nullptr;
+            ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_tsne),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_int(handle, "n_components", n_components),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_int(handle, "max_iter", 500), da_status_success);
+            EXPECT_EQ(da_options_set_string(handle, "gradient method", method),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_int(handle, "fft min intervals", 10),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+                      da_status_success);
+            EXPECT_EQ(da_tsne_set_data(handle, n_samples, n_features, X.data(),
+                                       n_features),
+                      da_status_success);
+            EXPECT_EQ(da_tsne_compute<TypeParam>(handle), da_status_success);
+
+            da_int info_dim = 6;
+            TypeParam rinfo[6];
+            EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &info_dim, rinfo),
+                      da_status_success);
+            const bool fft = std::string(method) == "fft";
+            kl[fft] = rinfo[4];
+
+            da_int emb_dim = n_samples * n_components;
+            std::vector<TypeParam> emb(emb_dim);
+            EXPECT_EQ(
+                da_handle_get_result(handle, da_tsne_embedding, &emb_dim, emb.data()),
+                da_status_success);
+            EXPECT_TRUE(tsne_metrics::check_embedding_finite(emb.data(), n_samples,
+                                                             n_components));
+            if (fft) {
+                TypeParam trust = tsne_metrics::compute_trustworthiness(
+                    X.data(), emb.data(), n_samples, n_features, n_components, 10);
+                EXPECT_GE(trust, TypeParam(0.95)) << "n_components=" << n_components;
+            }
+            da_handle_destroy(&handle);
+        }
+        // FFT must not be worse than Barnes-Hut (it is often better in 1D)
+        EXPECT_LE(kl[1], kl[0] + TypeParam(0.1)) << "n_components=" << n_components;
+    }
+
+    // Only 1-2D embeddings are supported
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_tsne), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", 3), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "gradient method", "fft"), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+              da_status_success);
+    EXPECT_EQ(da_tsne_set_data(handle, n_samples, n_features, X.data(), n_features),
+              da_status_success);
+    EXPECT_EQ(da_tsne_compute<TypeParam>(handle), da_status_incompatible_options);
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(tsne_public_test, NeighborAlgorithms) {
+    std::string data_file = std::string(DATA_DIR) + "/tsne_data/iris_data.csv";
+    std::vector<TypeParam> X;
+    da_int n_samples, n_features;
+    ASSERT_TRUE(da_test::read_csv_data(data_file, X, n_samples, n_features, row_major));
+
+    // Brute force neighbor graph in CSR form with the same k as the internal search,
+    // including a self-loop on each row which must be ignored
+    const da_int k = 91;
+    std::vector<da_int> row_ptr(n_samples + 1, 0), col_idx;
+    std::vector<TypeParam> distances;
+    for (da_int i = 0; i < n_samples; ++i) {
+        std::vector<std::pair<TypeParam, da_int>> d(n_samples);
+        for (da_int j = 0; j < n_samples; ++j) {
+            TypeParam s = 0;
+            for (da_int f = 0; f < n_features; ++f) {
+                TypeParam diff = X[i * n_features + f] - X[j * n_features + f];
+                s += diff * diff;
+            }
+            d[j] = {j == i ? TypeParam(-1) : s, j};
+        }
+        std::sort(d.begin(), d.end());
+        for (da_int t = 0; t <= k; ++t) {
+            col_idx.push_back(d[t].second);
+            distances.push_back(std::sqrt(std::max(d[t].first, TypeParam(0))));
+        }
+        row_ptr[i + 1] = (da_int)col_idx.size();
+    }
+
+    TypeParam kl[3];
+    const char *methods[3] = {"exact", "ivfflat", "supplied"};
+    for (da_int m = 0; m < 3; ++m) {
+        da_handle handle = nullptr;
+        ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_tsne), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "max_iter", 500), da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "neighbor algorithm", methods[m]),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "n_list", 4), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "n_probe", 2), da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+                  da_status_success);
+        EXPECT_EQ(da_tsne_set_data(handle, n_samples, n_features, X.data(), n_features),
+                  da_status_success);
+        if (m == 2) {
+            EXPECT_EQ(da_tsne_set_neighbors(handle, n_samples, row_ptr.data(),
+                                            col_idx.data(), distances.data()),
+                      da_status_success);
+        }
+        EXPECT_EQ(da_tsne_compute<TypeParam>(handle), da_status_success);
+
+        da_int info_dim = 6;
+        TypeParam rinfo[6];
+        EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &info_dim, rinfo),
+                  da_status_success);
+        kl[m] = rinfo[4];
+
+        da_int emb_dim = n_samples * 2;
+        std::vector<TypeParam> emb(emb_dim);
+        EXPECT_EQ(da_handle_get_result(handle, da_tsne_embedding, &emb_dim, emb.data()),
+                  da_status_success);
+        TypeParam trust = tsne_metrics::compute_trustworthiness(
+            X.data(), emb.data(), n_samples, n_features, 2, 10);
+        EXPECT_GE(trust, TypeParam(0.95)) << methods[m];
+        da_handle_destroy(&handle);
+    }
+    EXPECT_NEAR(kl[1], kl[0], TypeParam(0.1));
+    EXPECT_NEAR(kl[2], kl[0], TypeParam(0.05));
+
+    // The exact affinities of theta = 0 cannot use the inverted file index
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_tsne), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "neighbor algorithm", "ivfflat"),
+              da_status_success);
+    EXPECT_EQ(da_options_set(handle, "theta", TypeParam(0)), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+              da_status_success);
+    EXPECT_EQ(da_tsne_set_data(handle, n_samples, n_features, X.data(), n_features),
+              da_status_success);
+    EXPECT_EQ(da_tsne_compute<TypeParam>(handle), da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_string(handle, "gradient method", "fft"), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "max_iter", 250), da_status_success);
+    EXPECT_EQ(da_tsne_compute<TypeParam>(handle), da_status_success);
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(tsne_public_test, SetNeighborsErrors) {
+    const da_int n_samples = 5, n_features = 2;
+    std::vector<TypeParam> X = {0, 0, 1, 0, 0, 1, 1, 1, 2, 2};
+    std::vector<da_int> row_ptr = {0, 1, 2, 3, 4, 5}, col_idx = {1, 0, 3, 2, 3};
+    std::vector<TypeParam> distances = {1, 1, 1, 1, 1};
+
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_tsne), da_status_success);
+    EXPECT_EQ(da_tsne_set_neighbors(handle, n_samples, row_ptr.data(), col_idx.data(),
+                                    distances.data()),
+              da_status_no_data);
+    EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+              da_status_success);
+    EXPECT_EQ(da_options_set(handle, "perplexity", TypeParam(1)), da_status_success);
+    EXPECT_EQ(da_tsne_set_data(handle, n_samples, n_features, X.data(), n_features),
+              da_status_success);
+
+    // Supplied neighbor algorithm without a graph
+    EXPECT_EQ(da_options_set_string(handle, "neighbor algorithm", "supplied"),
+              da_status_success);
+    EXPECT_EQ(da_tsne_compute<TypeParam>(handle), da_status_no_data);
+
+    EXPECT_EQ(da_tsne_set_neighbors(handle, n_samples - 1, row_ptr.data(), col_idx.data(),
+                                    distances.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(da_tsne_set_neighbors(handle, n_samples, row_ptr.data(), nullptr,
+                                    distances.data()),
+              da_status_invalid_pointer);
+    col_idx[2] = n_samples;
+    EXPECT_EQ(da_tsne_set_neighbors(handle, n_samples, row_ptr.data(), col_idx.data(),
+                                    distances.data()),
+              da_status_invalid_input);
+    col_idx[2] = 3;
+    distances[1] = -1;
+    EXPECT_EQ(da_tsne_set_neighbors(handle, n_samples, row_ptr.data(), col_idx.data(),
+                                    distances.data()),
+              da_status_invalid_input);
+    distances[1] = 1;
+    row_ptr[2] = 0;
+    EXPECT_EQ(da_tsne_set_neighbors(handle, n_samples, row_ptr.data(), col_idx.data(),
+                                    distances.data()),
+              da_status_invalid_input);
+    row_ptr[2] = 2;
+    std::vector<da_int> self_only = {0, 1, 2, 3, 4};
+    EXPECT_EQ(da_tsne_set_neighbors(handle, n_samples, row_ptr.data(), self_only.data(),
+                                    distances.data()),
+              da_status_invalid_input);
+
+    EXPECT_EQ(da_tsne_set_neighbors(handle, n_samples, row_ptr.data(), col_idx.data(),
+                                    distances.data()),
+              da_status_success);
+    EXPECT_EQ(da_tsne_compute<TypeParam>(handle), da_status_success);
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(tsne_public_test, TransformNewData) {
+    std::string data_file = std::string(DATA_DIR) + "/tsne_data/iris_data.csv";
+    std::vector<TypeParam> X;
+    da_int n_samples, n_features;
+    ASSERT_TRUE(da_test::read_csv_data(data_file, X, n_samples, n_features, row_major));
+
+    // Fit on the even rows and place the odd rows
+    const da_int n_fit = (n_samples + 1) / 2, n_new = n_samples / 2, n_components = 2;
+    std::vector<TypeParam> X_fit, X_new;
+    for (da_int i = 0; i < n_samples; ++i) {
+        std::vector<TypeParam> &dest = (i % 2 == 0) ? X_fit : X_new;
+        dest.insert(dest.end(), X.begin() + i * n_features,
+                    X.begin() + (i + 1) * n_features);
+    }
+
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_tsne), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "max_iter", 500), da_status_success);
+    EXPECT_EQ(da_tsne_set_data(handle, n_fit, n_features, X_fit.data(), n_features),
+              da_status_success);
+
+    std::vector<TypeParam> Y_new(n_new * n_components);
+    EXPECT_EQ(da_tsne_transform(handle, n_new, n_features, X_new.data(), n_features,
+                                Y_new.data(), n_components),
+              da_status_no_data);
+    EXPECT_EQ(da_tsne_compute<TypeParam>(handle), da_status_success);
+
+    da_int emb_dim = n_fit * n_components;
+    std::vector<TypeParam> Y_fit(emb_dim);
+    EXPECT_EQ(da_handle_get_result(handle, da_tsne_embedding, &emb_dim, Y_fit.data()),
+              da_status_success);
+
+    EXPECT_EQ(da_tsne_transform(handle, n_new, n_features, X_new.data(), n_features,
+                                Y_new.data(), n_components),
+              da_status_success);
+    EXPECT_TRUE(tsne_metrics::check_embedding_finite(Y_new.data(), n_new, n_components));
+
+    // The new points preserve their own neighborhoods and those of the whole data set
+    TypeParam trust = tsne_metrics::compute_trustworthiness(
+        X_new.data(), Y_new.data(), n_new, n_features, n_components, 5);
+    EXPECT_GE(trust, TypeParam(0.9));
+    std::vector<TypeParam> X_all(X_fit), Y_all(Y_fit);
+    X_all.insert(X_all.end(), X_new.begin(), X_new.end());
+    Y_all.insert(Y_all.end(), Y_new.begin(), Y_new.end());
+    trust = tsne_metrics::compute_trustworthiness(X_all.data(), Y_all.data(), n_samples,
+                                                  n_features, n_components, 10);
+    EXPECT_GE(trust, TypeParam(0.9));
+
+    // Samples are placed independently, so a subset gives the same coordinates
+    std::vector<TypeParam> Y_sub(2 * n_components);
+    EXPECT_EQ(da_tsne_transform(handle, 2, n_features, X_new.data() + 10 * n_features,
+                                n_features, Y_sub.data(), n_components),
+              da_status_success);
+    for (da_int j = 0; j < 2 * n_components; ++j)
+        EXPECT_NEAR(Y_sub[j], Y_new[10 * n_components + j], TypeParam(1e-4));
+
+    // Illegal arguments
+    EXPECT_EQ(da_tsne_transform(handle, n_new, n_features - 1, X_new.data(), n_features,
+                                Y_new.data(), n_components),
+              da_status_invalid_input);
+    EXPECT_EQ(da_tsne_transform(handle, n_new, n_features, X_new.data(), n_features - 1,
+                                Y_new.data(), n_components),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_tsne_transform(handle, n_new, n_features, X_new.data(), n_features,
+                                Y_new.data(), n_components - 1),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_tsne_transform(handle, n_new, n_features, X_new.data(), n_features,
+                                (TypeParam *)nullptr, n_components),
+              da_status_invalid_pointer);
+    da_handle_destroy(&handle);
+}
+
 typedef struct tsne_param_t {
     std::string test_name; // Name of the ctest test
     std::string data_name; // Name of the dataset file
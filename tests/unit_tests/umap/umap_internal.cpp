@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "../utest_utils.hpp"
+#include "umap/umap.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace TEST_ARCH;
+
+template <typename T> class umap_internal_test : public testing::Test {};
+
+using FloatTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(umap_internal_test, FloatTypes);
+
+TYPED_TEST(umap_internal_test, FindABParams) {
+    // Reference values of the curve fit for the default spread and min_dist
+    TypeParam a, b;
+    da_umap::find_ab_params((TypeParam)1, (TypeParam)0.1, a, b);
+    EXPECT_NEAR(a, (TypeParam)1.577, (TypeParam)1e-2);
+    EXPECT_NEAR(b, (TypeParam)0.895, (TypeParam)1e-2);
+
+    // A larger min_dist flattens the curve near the origin
+    TypeParam a2, b2;
+    da_umap::find_ab_params((TypeParam)1, (TypeParam)0.5, a2, b2);
+    EXPECT_LT(a2, a);
+    EXPECT_GT(b2, b);
+}
+
+TYPED_TEST(umap_internal_test, SmoothKnnRow) {
+    const da_int k = 5;
+    std::vector<TypeParam> dist = {1, 2, 3, 4, 5}, w(k);
+    const TypeParam target = std::log2((TypeParam)(k + 1));
+
+    // With rho, the nearest neighbor has full membership
+    da_umap::smooth_knn_row(dist.data(), k, target, true, (TypeParam)3, w.data());
+    EXPECT_EQ(w[0], (TypeParam)1);
+    TypeParam sum = 0;
+    for (da_int j = 0; j < k; ++j) {
+        sum += w[j];
+        if (j > 0) {
+            EXPECT_LT(w[j], w[j - 1]);
+        }
+    }
+    EXPECT_NEAR(sum, target, (TypeParam)1e-3);
+
+    // Without rho, the strengths decay from zero distance
+    da_umap::smooth_knn_row(dist.data(), k, target, false, (TypeParam)3, w.data());
+    sum = 0;
+    for (da_int j = 0; j < k; ++j)
+        sum += w[j];
+    EXPECT_LT(w[0], (TypeParam)1);
+    EXPECT_NEAR(sum, target, (TypeParam)1e-3);
+
+    // Padding entries have zero membership
+    dist[4] = std::numeric_limits<TypeParam>::infinity();
+    da_umap::smooth_knn_row(dist.data(), k, target, true, (TypeParam)3, w.data());
+    EXPECT_EQ(w[4], (TypeParam)0);
+}
+
+TYPED_TEST(umap_internal_test, FuzzyUnion) {
+    // Directed 2-nearest neighbor graph with a self-reference in row 1 and a padded
+    // entry in row 2, which must both be dropped
+    const da_int n = 4, k = 2;
+    std::vector<da_int> ind = {1, 2, 0, 1, 3, -1, 2, 0};
+    std::vector<TypeParam> w = {(TypeParam)0.5, (TypeParam)0.25, (TypeParam)0.5,
+                                (TypeParam)1,   (TypeParam)1,    (TypeParam)0,
+                                (TypeParam)0.75, (TypeParam)0.2};
+    std::vector<da_int> row_ptr, col_idx;
+    std::vector<TypeParam> values;
+    ASSERT_EQ(da_umap::fuzzy_union_to_csr(n, k, ind.data(), w.data(), row_ptr, col_idx,
+                                          values),
+              da_status_success);
+
+    // (0, 1) and (2, 3) are reciprocal and combine as w + w' - w * w'
+    std::vector<da_int> row_ptr_exp = {0, 3, 4, 6, 8};
+    std::vector<da_int> col_idx_exp = {1, 2, 3, 0, 0, 3, 0, 2};
+    std::vector<TypeParam> values_exp = {
+        (TypeParam)0.75, (TypeParam)0.25, (TypeParam)0.2, (TypeParam)0.75,
+        (TypeParam)0.25, (TypeParam)1,    (TypeParam)0.2, (TypeParam)1};
+    ASSERT_EQ(row_ptr, row_ptr_exp);
+    EXPECT_EQ(col_idx, col_idx_exp);
+    EXPECT_ARR_NEAR((da_int)values.size(), values.data(), values_exp.data(),
+                    (TypeParam)1e-6);
+}
+
+TYPED_TEST(umap_internal_test, OptimizeLayoutAttracts) {
+    // Two connected points move closer while a point without edges stays in place
+    const da_int d = 2, n = 3;
+    std::vector<TypeParam> emb = {0, 0, 5, 0, 0, 1};
+    std::vector<da_int> head = {0, 1}, tail = {1, 0};
+    std::vector<TypeParam> w = {1, 1};
+    TypeParam a, b;
+    da_umap::find_ab_params((TypeParam)1, (TypeParam)0.1, a, b);
+    da_umap::optimize_layout(d, 2, head.data(), tail.data(), w.data(), emb.data(),
+                             emb.data(), n, 50, a, b, (TypeParam)1, (TypeParam)1, 0,
+                             true, 42);
+    TypeParam dist01 = std::hypot(emb[0] - emb[2], emb[1] - emb[3]);
+    EXPECT_LT(dist01, (TypeParam)1);
+    EXPECT_EQ(emb[4], (TypeParam)0);
+    EXPECT_EQ(emb[5], (TypeParam)1);
+
+    // The same seed gives the same layout
+    std::vector<TypeParam> emb1 = {0, 0, 5, 0, 0, 1}, emb2 = emb1;
+    da_umap::optimize_layout(d, 2, head.data(), tail.data(), w.data(), emb1.data(),
+                             emb1.data(), n, 50, a, b, (TypeParam)1, (TypeParam)1, 5,
+                             true, 7);
+    da_umap::optimize_layout(d, 2, head.data(), tail.data(), w.data(), emb2.data(),
+                             emb2.data(), n, 50, a, b, (TypeParam)1, (TypeParam)1, 5,
+                             true, 7);
+    EXPECT_ARR_NEAR((da_int)emb1.size(), emb1.data(), emb2.data(), (TypeParam)0);
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2026 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "../utest_utils.hpp"
+#include "../tsne/tsne_utils.hpp"
+#include "aoclda.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+template <typename T> class umap_public_test : public testing::Test {};
+
+using FloatTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(umap_public_test, FloatTypes);
+
+template <typename T>
+void umap_fit(da_handle handle, std::vector<T> &X, da_int n_samples, da_int n_features,
+              std::vector<T> &embedding) {
+    EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "seed", 42), da_status_success);
+    EXPECT_EQ(da_umap_set_data(handle, n_samples, n_features, X.data(), n_features),
+              da_status_success);
+    EXPECT_EQ(da_umap_compute<T>(handle), da_status_success);
+    da_int dim = 2 * n_samples;
+    embedding.resize(dim);
+    EXPECT_EQ(da_handle_get_result(handle, da_umap_embedding, &dim, embedding.data()),
+              da_status_success);
+}
+
+TYPED_TEST(umap_public_test, IrisEmbedding) {
+    std::string data_file = std::string(DATA_DIR) + "/tsne_data/iris_data.csv";
+    std::vector<TypeParam> X;
+    da_int n_samples, n_features;
+    ASSERT_TRUE(da_test::read_csv_data(data_file, X, n_samples, n_features, row_major));
+
+    const char *inits[2] = {"pca", "random"};
+    const char *methods[2] = {"exact", "ivfflat"};
+    for (da_int m = 0; m < 2; ++m) {
+        da_handle handle = nullptr;
+        ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_umap), da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "init", inits[m]), da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "neighbor algorithm", methods[m]),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "n_list", 4), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "n_probe", 2), da_status_success);
+        std::vector<TypeParam> emb;
+        umap_fit(handle, X, n_samples, n_features, emb);
+
+        da_int info_dim = 6;
+        TypeParam rinfo[6];
+        EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &info_dim, rinfo),
+                  da_status_success);
+        EXPECT_EQ(rinfo[0], (TypeParam)n_samples);
+        EXPECT_EQ(rinfo[1], (TypeParam)n_features);
+        EXPECT_EQ(rinfo[2], (TypeParam)2);
+        EXPECT_EQ(rinfo[3], (TypeParam)500);
+        EXPECT_NEAR(rinfo[4], (TypeParam)1.577, (TypeParam)1e-2);
+        EXPECT_NEAR(rinfo[5], (TypeParam)0.895, (TypeParam)1e-2);
+
+        TypeParam trust = tsne_metrics::compute_trustworthiness(
+            X.data(), emb.data(), n_samples, n_features, 2, 10);
+        EXPECT_GE(trust, (TypeParam)0.95) << inits[m] << " " << methods[m];
+        da_handle_destroy(&handle);
+    }
+}
+
+TYPED_TEST(umap_public_test, ColumnMajorMatchesRowMajor) {
+    std::string data_file = std::string(DATA_DIR) + "/tsne_data/iris_data.csv";
+    std::vector<TypeParam> X;
+    da_int n_samples, n_features;
+    ASSERT_TRUE(da_test::read_csv_data(data_file, X, n_samples, n_features, row_major));
+    // With 100 samples the graph has fewer edges than one block of the gradient descent,
+    // so the embedding does not depend on the thread timing and can be compared
+    n_samples = std::min(n_samples, (da_int)100);
+
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_umap), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_epochs", 100), da_status_success);
+    std::vector<TypeParam> emb;
+    umap_fit(handle, X, n_samples, n_features, emb);
+    da_handle_destroy(&handle);
+
+    std::vector<TypeParam> X_cm(n_samples * n_features);
+    for (da_int i = 0; i < n_samples; ++i)
+        for (da_int j = 0; j < n_features; ++j)
+            X_cm[j * n_samples + i] = X[i * n_features + j];
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_umap), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_epochs", 100), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "seed", 42), da_status_success);
+    EXPECT_EQ(da_umap_set_data(handle, n_samples, n_features, X_cm.data(), n_samples),
+              da_status_success);
+    EXPECT_EQ(da_umap_compute<TypeParam>(handle), da_status_success);
+    da_int dim = 2 * n_samples;
+    std::vector<TypeParam> emb_cm(dim), emb_rm(dim);
+    EXPECT_EQ(da_handle_get_result(handle, da_umap_embedding, &dim, emb_cm.data()),
+              da_status_success);
+    for (da_int i = 0; i < n_samples; ++i)
+        for (da_int j = 0; j < 2; ++j)
+            emb_rm[i * 2 + j] = emb_cm[j * n_samples + i];
+    EXPECT_ARR_NEAR(dim, emb_rm.data(), emb.data(), (TypeParam)1e-4);
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(umap_public_test, TransformAndPersistence) {
+    std::string data_file = std::string(DATA_DIR) + "/tsne_data/iris_data.csv";
+    std::vector<TypeParam> X;
+    da_int n_samples, n_features;
+    ASSERT_TRUE(da_test::read_csv_data(data_file, X, n_samples, n_features, row_major));
+
+    // Fit on the even samples and place the odd ones
+    da_int n_train = (n_samples + 1) / 2, n_new = n_samples / 2;
+    std::vector<TypeParam> X_train, X_new;
+    for (da_int i = 0; i < n_samples; ++i) {
+        auto &dst = i % 2 == 0 ? X_train : X_new;
+        dst.insert(dst.end(), X.begin() + i * n_features,
+                   X.begin() + (i + 1) * n_features);
+    }
+
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_umap), da_status_success);
+    std::vector<TypeParam> emb;
+    umap_fit(handle, X_train, n_train, n_features, emb);
+
+    std::vector<TypeParam> Y_new(2 * n_new);
+    EXPECT_EQ(da_umap_transform(handle, n_new, n_features, X_new.data(), n_features,
+                                Y_new.data(), 2),
+              da_status_success);
+
+    std::vector<TypeParam> X_all(X_train), Y_all(emb);
+    X_all.insert(X_all.end(), X_new.begin(), X_new.end());
+    Y_all.insert(Y_all.end(), Y_new.begin(), Y_new.end());
+    TypeParam trust = tsne_metrics::compute_trustworthiness(
+        X_all.data(), Y_all.data(), n_samples, n_features, 2, 10);
+    EXPECT_GE(trust, (TypeParam)0.9);
+
+    // A restored model gives the same embedding and transform
+    std::string model_file = "umap_test.bin";
+    EXPECT_EQ(da_handle_save_model(handle, model_file.c_str()), da_status_success);
+    da_handle handle_loaded = nullptr;
+    EXPECT_EQ(da_handle_load_model(&handle_loaded, model_file.c_str()),
+              da_status_success);
+    std::remove(model_file.c_str());
+
+    da_int dim = 2 * n_train;
+    std::vector<TypeParam> emb_loaded(dim), Y_loaded(2 * n_new);
+    EXPECT_EQ(da_handle_get_result(handle_loaded, da_umap_embedding, &dim,
+                                   emb_loaded.data()),
+              da_status_success);
+    EXPECT_ARR_NEAR(dim, emb_loaded.data(), emb.data(), (TypeParam)0);
+    EXPECT_EQ(da_umap_transform(handle_loaded, n_new, n_features, X_new.data(),
+                                n_features, Y_loaded.data(), 2),
+              da_status_success);
+    // The n_new * n_neighbors edges of the new samples fit in a single block of the
+    // gradient descent, so the transform does not depend on the thread timing
+    ASSERT_LE(n_new * 15, 4096);
+    EXPECT_ARR_NEAR(2 * n_new, Y_loaded.data(), Y_new.data(), (TypeParam)1e-4);
+
+    da_handle_destroy(&handle);
+    da_handle_destroy(&handle_loaded);
+}
+
+TYPED_TEST(umap_public_test, InvalidInputs) {
+    const da_int n_samples = 6, n_features = 2;
+    std::vector<TypeParam> X = {0, 0, 1, 0, 0, 1, 5, 5, 6, 5, 5, 6};
+    TypeParam Y[12];
+
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_umap), da_status_success);
+    EXPECT_EQ(da_umap_compute<TypeParam>(handle), da_status_no_data);
+    EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+              da_status_success);
+    EXPECT_EQ(da_umap_set_data(handle, 1, n_features, X.data(), n_features),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(da_umap_set_data(handle, n_samples, n_features, X.data(), 1),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_umap_set_data(handle, n_samples, n_features, (TypeParam *)nullptr,
+                               n_features),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_umap_set_data(handle, n_samples, n_features, X.data(), n_features),
+              da_status_success);
+    EXPECT_EQ(da_umap_transform(handle, 2, n_features, X.data(), n_features, Y, 2),
+              da_status_no_data);
+    da_int dim = 12;
+    EXPECT_EQ(da_handle_get_result(handle, da_umap_embedding, &dim, Y),
+              da_status_no_data);
+
+    // PCA initialization cannot produce more components than features
+    EXPECT_EQ(da_options_set_int(handle, "n_components", 3), da_status_success);
+    EXPECT_EQ(da_umap_compute<TypeParam>(handle), da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_string(handle, "init", "random"), da_status_success);
+    EXPECT_EQ(da_umap_compute<TypeParam>(handle), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", 6), da_status_success);
+    EXPECT_EQ(da_umap_compute<TypeParam>(handle), da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_int(handle, "n_components", 2), da_status_success);
+    EXPECT_EQ(da_umap_compute<TypeParam>(handle), da_status_success);
+
+    EXPECT_EQ(da_umap_transform(handle, 2, 3, X.data(), 3, Y, 2),
+              da_status_invalid_input);
+    EXPECT_EQ(da_umap_transform(handle, 2, n_features, X.data(), n_features, Y, 1),
+              da_status_invalid_leading_dimension);
+    dim = 4;
+    EXPECT_EQ(da_handle_get_result(handle, da_umap_embedding, &dim, Y),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, 12);
+    EXPECT_EQ(da_handle_get_result(handle, da_tsne_embedding, &dim, Y),
+              da_status_unknown_query);
+    da_handle_destroy(&handle);
+
+    // Wrong handle type and precision
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_tsne), da_status_success);
+    EXPECT_EQ(da_umap_set_data(handle, n_samples, n_features, X.data(), n_features),
+              da_status_invalid_handle_type);
+    EXPECT_EQ(da_umap_compute<TypeParam>(handle), da_status_invalid_handle_type);
+    da_handle_destroy(&handle);
+    EXPECT_EQ(da_umap_compute<TypeParam>(handle), da_status_handle_not_initialized);
+}
+
+TYPED_TEST(umap_public_test, ConcurrentInference) {
+    // Several threads share one trained handle, each with its own inference context;
+    // the results must match the serial handle-based calls
+    std::string data_file = std::string(DATA_DIR) + "/tsne_data/iris_data.csv";
+    std::vector<TypeParam> X;
+    da_int n_samples, n_features;
+    ASSERT_TRUE(da_test::read_csv_data(data_file, X, n_samples, n_features, row_major));
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_umap), da_status_success);
+    std::vector<TypeParam> emb;
+    umap_fit(handle, X, n_samples, n_features, emb);
+
+    // Each chunk's n_neighbors edges fit in a single block of the gradient descent, so
+    // the transform does not depend on the thread timing
+    const da_int n_chunks = 6, chunk = 25, n_comp = 2;
+    ASSERT_LE(chunk * 15, 4096);
+    ASSERT_LE(n_chunks * chunk, n_samples);
+    std::vector<TypeParam> Y_ref(n_chunks * chunk * n_comp);
+    for (da_int c = 0; c < n_chunks; c++)
+        EXPECT_EQ(da_umap_transform(handle, chunk, n_features,
+                                    &X[c * chunk * n_features], n_features,
+                                    &Y_ref[c * chunk * n_comp], n_comp),
+                  da_status_success);
+
+    std::vector<TypeParam> Y(n_chunks * chunk * n_comp, (TypeParam)-1);
+    std::vector<da_status> status(n_chunks, da_status_internal_error);
+#pragma omp parallel for schedule(dynamic)
+    for (da_int c = 0; c < n_chunks; c++) {
+        da_inference_context ctx = nullptr;
+        if (da_inference_context_init(&ctx) != da_status_success)
+            continue;
+        status[c] = da_umap_transform(handle, ctx, chunk, n_features,
+                                      &X[c * chunk * n_features], n_features,
+                                      &Y[c * chunk * n_comp], n_comp);
+        da_inference_context_destroy(&ctx);
+    }
+    for (da_int c = 0; c < n_chunks; c++)
+        EXPECT_EQ(status[c], da_status_success);
+    EXPECT_ARR_NEAR(n_chunks * chunk * n_comp, Y.data(), Y_ref.data(), (TypeParam)1e-4);
+
+    // Errors are reported in the context rather than in the handle
+    da_inference_context ctx = nullptr;
+    ASSERT_EQ(da_inference_context_init(&ctx), da_status_success);
+    EXPECT_EQ(da_umap_transform(handle, ctx, chunk, n_features + 1, X.data(),
+                                n_features + 1, Y.data(), n_comp),
+              da_status_invalid_input);
+    EXPECT_EQ(da_inference_context_print_error_message(ctx), da_status_success);
+    EXPECT_EQ(da_umap_transform(handle, (da_inference_context) nullptr, chunk,
+                                n_features, X.data(), n_features, Y.data(), n_comp),
+              da_status_invalid_pointer);
+    da_inference_context_destroy(&ctx);
+    da_handle_destroy(&handle);
+}
+
+TEST(UMAPPublic, IncorrectHandlePrecision) {
+    double X_d[6] = {1, 2, 3, 4, 5, 6};
+    float X_s[6] = {1, 2, 3, 4, 5, 6};
+
+    da_handle handle_d = nullptr;
+    EXPECT_EQ(da_handle_init_d(&handle_d, da_handle_umap), da_status_success);
+    EXPECT_EQ(da_umap_set_data_s(handle_d, 3, 2, X_s, 3), da_status_wrong_type);
+    EXPECT_EQ(da_umap_compute_s(handle_d), da_status_wrong_type);
+    da_inference_context ctx = nullptr;
+    EXPECT_EQ(da_inference_context_init(&ctx), da_status_success);
+    EXPECT_EQ(da_umap_transform_ctx_s(handle_d, ctx, 3, 2, X_s, 3, X_s, 3),
+              da_status_wrong_type);
+    da_inference_context_destroy(&ctx);
+    da_handle_destroy(&handle_d);
+
+    da_handle handle_s = nullptr;
+    EXPECT_EQ(da_handle_init_s(&handle_s, da_handle_umap), da_status_success);
+    EXPECT_EQ(da_umap_set_data_d(handle_s, 3, 2, X_d, 3), da_status_wrong_type);
+    EXPECT_EQ(da_umap_compute_d(handle_s), da_status_wrong_type);
+    da_handle_destroy(&handle_s);
+}